@@ -76,6 +76,7 @@ static int interceptor_start(struct interceptorActivator *act, celix_bundle_cont
 
     celix_properties_t *secondProps = celix_properties_create();
     celix_properties_setLong(secondProps, CELIX_FRAMEWORK_SERVICE_RANKING, 20);
+    celix_properties_setBool(secondProps, CELIX_RSA_REMOTE_INTERCEPTOR_USES_METADATA, false);
 
     celix_service_registration_options_t secondOpts = CELIX_EMPTY_SERVICE_REGISTRATION_OPTIONS;
     secondOpts.svc = secondInterceptorSvc;
@@ -59,11 +59,16 @@ typedef struct rsa_dfi_exception_test_service {
     static bool clientInterceptorPreProxyCallRetval=true;
     static bool svcInterceptorPreExportCallRetval=true;
 
-    static void setupFm(bool useCurlShare) {
+    static void setupFm(bool useCurlShare, bool logCalls = false) {
         //server
         celix_properties_t *serverProps = nullptr;
         ASSERT_EQ(CELIX_SUCCESS, celix_properties_load("server.properties", 0, &serverProps));
         ASSERT_TRUE(serverProps != nullptr);
+        if (logCalls) {
+            celix_properties_setBool(serverProps, "RSA_LOG_CALLS", true);
+            celix_properties_set(serverProps, "RSA_LOG_CALLS_FILE", "server_calls.log");
+            celix_properties_setLong(serverProps, "RSA_LOG_CALLS_MAX_PAYLOAD_SIZE", 8);
+        }
         serverFramework = celix_frameworkFactory_createFramework(serverProps);
         ASSERT_TRUE(serverFramework != nullptr);
         serverContext = celix_framework_getFrameworkContext(serverFramework);
@@ -74,6 +79,10 @@ typedef struct rsa_dfi_exception_test_service {
         ASSERT_EQ(CELIX_SUCCESS, celix_properties_load("client.properties", 0, &clientProperties));
         celix_properties_setBool(clientProperties, "RSA_DFI_USE_CURL_SHARE_HANDLE", useCurlShare);
         ASSERT_TRUE(clientProperties != nullptr);
+        if (logCalls) {
+            celix_properties_setBool(clientProperties, "RSA_LOG_CALLS", true);
+            celix_properties_set(clientProperties, "RSA_LOG_CALLS_FILE", "client_calls.log");
+        }
         clientFramework = celix_frameworkFactory_createFramework(clientProperties);
         ASSERT_TRUE(clientFramework != nullptr);
         clientContext = celix_framework_getFrameworkContext(clientFramework);
@@ -406,6 +415,37 @@ TEST_F(RsaDfiClientServerExceptionTests,TestExceptionService) {
     testExceptionService();
 }
 
+static std::string readCallsLog(const char* file) {
+    std::string content{};
+    FILE* f = fopen(file, "r");
+    EXPECT_TRUE(f != nullptr);
+    if (f != nullptr) {
+        char buf[512];
+        size_t len;
+        while ((len = fread(buf, 1, sizeof(buf), f)) > 0) {
+            content.append(buf, len);
+        }
+        fclose(f);
+    }
+    return content;
+}
+
+TEST(RsaDfiClientServerCallsLogTests, TestRemoteCallsAreLogged) {
+    setupFm(false, true);
+    test(testCalculator);
+    teardownFm(); //note the buffered calls are written when the RSA is stopped
+
+    std::string clientLog = readCallsLog("client_calls.log");
+    EXPECT_NE(std::string::npos, clientLog.find("REMOTE CALL NR 0\n")) << clientLog;
+    EXPECT_NE(std::string::npos, clientLog.find("\treturn_code=0\n")) << clientLog;
+
+    //the server logs truncated payloads
+    std::string serverLog = readCallsLog("server_calls.log");
+    EXPECT_NE(std::string::npos, serverLog.find("REMOTE CALL 0\n")) << serverLog;
+    EXPECT_NE(std::string::npos, serverLog.find("\trequest_payload={\"m\":\"")) << serverLog;
+    EXPECT_NE(std::string::npos, serverLog.find("...\n\trequest_response=")) << serverLog;
+}
+
 
 class RsaDfiDynamicIpServerTestSuite : public ::testing::Test {
 public:
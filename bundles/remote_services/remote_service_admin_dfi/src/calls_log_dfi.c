@@ -0,0 +1,245 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "calls_log_dfi.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "celix_stdlib_cleanup.h"
+#include "celix_threads.h"
+#include "remote_service_admin_dfi_constants.h"
+
+struct calls_log {
+    celix_log_helper_t *logHelper;
+    FILE *file;
+    long sampleRate;
+    size_t maxPayloadSize;
+    size_t bufferSize;
+    size_t importCallCount; //atomically updated
+    size_t exportCallCount; //atomically updated
+
+    celix_thread_mutex_t mutex; //protects buffer, bufferLen, droppedCount and running
+    celix_thread_cond_t cond;
+    char *buffer; //formatted records, not yet written
+    size_t bufferLen;
+    size_t droppedCount;
+    bool running;
+
+    celix_thread_t writerThread;
+    char *writeBuffer; //owned by the writer thread
+};
+
+static void* callsLog_writerThread(void *data);
+
+celix_status_t callsLog_create(celix_bundle_context_t *ctx, celix_log_helper_t *logHelper, calls_log_t **out) {
+    celix_autofree calls_log_t *callsLog = calloc(1, sizeof(*callsLog));
+    if (callsLog == NULL) {
+        return CELIX_ENOMEM;
+    }
+    callsLog->logHelper = logHelper;
+    callsLog->sampleRate = celix_bundleContext_getPropertyAsLong(ctx, RSA_LOG_CALLS_SAMPLE_RATE_KEY, RSA_LOG_CALLS_SAMPLE_RATE_DEFAULT);
+    if (callsLog->sampleRate < 1) {
+        celix_logHelper_warning(logHelper, "Invalid %s %ld, logging all calls.", RSA_LOG_CALLS_SAMPLE_RATE_KEY, callsLog->sampleRate);
+        callsLog->sampleRate = 1;
+    }
+    long maxPayloadSize = celix_bundleContext_getPropertyAsLong(ctx, RSA_LOG_CALLS_MAX_PAYLOAD_SIZE_KEY, RSA_LOG_CALLS_MAX_PAYLOAD_SIZE_DEFAULT);
+    callsLog->maxPayloadSize = maxPayloadSize > 0 ? (size_t)maxPayloadSize : 0;
+    long bufferSize = celix_bundleContext_getPropertyAsLong(ctx, RSA_LOG_CALLS_BUFFER_SIZE_KEY, RSA_LOG_CALLS_BUFFER_SIZE_DEFAULT);
+    if (bufferSize <= 0) {
+        celix_logHelper_warning(logHelper, "Invalid %s %ld, using %d.", RSA_LOG_CALLS_BUFFER_SIZE_KEY, bufferSize, RSA_LOG_CALLS_BUFFER_SIZE_DEFAULT);
+        bufferSize = RSA_LOG_CALLS_BUFFER_SIZE_DEFAULT;
+    }
+    callsLog->bufferSize = (size_t)bufferSize;
+
+    celix_autofree char *buffer = callsLog->buffer = malloc(callsLog->bufferSize);
+    celix_autofree char *writeBuffer = callsLog->writeBuffer = malloc(callsLog->bufferSize);
+    if (buffer == NULL || writeBuffer == NULL) {
+        celix_logHelper_error(logHelper, "Error allocating calls log buffers.");
+        return CELIX_ENOMEM;
+    }
+
+    celix_status_t status = celixThreadMutex_create(&callsLog->mutex, NULL);
+    if (status != CELIX_SUCCESS) {
+        celix_logHelper_error(logHelper, "Error creating calls log mutex. %d.", status);
+        return status;
+    }
+    celix_autoptr(celix_thread_mutex_t) mutex = &callsLog->mutex;
+    status = celixThreadCondition_init(&callsLog->cond, NULL);
+    if (status != CELIX_SUCCESS) {
+        celix_logHelper_error(logHelper, "Error creating calls log condition. %d.", status);
+        return status;
+    }
+    celix_autoptr(celix_thread_cond_t) cond = &callsLog->cond;
+
+    const char *f = celix_bundleContext_getProperty(ctx, RSA_LOG_CALLS_FILE_KEY, RSA_LOG_CALLS_FILE_DEFAULT);
+    if (strncmp(f, "stdout", strlen("stdout")) == 0) {
+        callsLog->file = stdout;
+    } else {
+        callsLog->file = fopen(f, "w");
+        if (callsLog->file == NULL) {
+            status = CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, errno);
+            celix_logHelper_warning(logHelper, "Error opening file '%s' for logging calls. %s", f, strerror(errno));
+            return status;
+        }
+    }
+
+    callsLog->running = true;
+    status = celixThread_create(&callsLog->writerThread, NULL, callsLog_writerThread, callsLog);
+    if (status != CELIX_SUCCESS) {
+        celix_logHelper_error(logHelper, "Error creating calls log writer thread. %d.", status);
+        if (callsLog->file != stdout) {
+            fclose(callsLog->file);
+        }
+        return status;
+    }
+    celixThread_setName(&callsLog->writerThread, "RsaCallsLog");
+
+    celix_steal_ptr(cond);
+    celix_steal_ptr(mutex);
+    celix_steal_ptr(buffer);
+    celix_steal_ptr(writeBuffer);
+    *out = celix_steal_ptr(callsLog);
+    return CELIX_SUCCESS;
+}
+
+void callsLog_destroy(calls_log_t *callsLog) {
+    if (callsLog != NULL) {
+        celixThreadMutex_lock(&callsLog->mutex);
+        callsLog->running = false;
+        celixThreadCondition_signal(&callsLog->cond);
+        celixThreadMutex_unlock(&callsLog->mutex);
+        celixThread_join(callsLog->writerThread, NULL);
+
+        if (callsLog->file != stdout) {
+            fclose(callsLog->file);
+        }
+        celixThreadCondition_destroy(&callsLog->cond);
+        celixThreadMutex_destroy(&callsLog->mutex);
+        free(callsLog->writeBuffer);
+        free(callsLog->buffer);
+        free(callsLog);
+    }
+}
+
+static void* callsLog_writerThread(void *data) {
+    calls_log_t *callsLog = data;
+    celixThreadMutex_lock(&callsLog->mutex);
+    while (true) {
+        while (callsLog->running && callsLog->bufferLen == 0 && callsLog->droppedCount == 0) {
+            celixThreadCondition_wait(&callsLog->cond, &callsLog->mutex);
+        }
+        if (callsLog->bufferLen == 0 && callsLog->droppedCount == 0) {
+            break;
+        }
+        char *records = callsLog->buffer;
+        size_t len = callsLog->bufferLen;
+        size_t dropped = callsLog->droppedCount;
+        callsLog->buffer = callsLog->writeBuffer;
+        callsLog->bufferLen = 0;
+        callsLog->droppedCount = 0;
+        callsLog->writeBuffer = records;
+        celixThreadMutex_unlock(&callsLog->mutex);
+
+        fwrite(records, 1, len, callsLog->file);
+        if (dropped > 0) {
+            fprintf(callsLog->file, "DROPPED %zu REMOTE CALL RECORDS\n", dropped);
+        }
+        fflush(callsLog->file);
+
+        celixThreadMutex_lock(&callsLog->mutex);
+    }
+    celixThreadMutex_unlock(&callsLog->mutex);
+    return NULL;
+}
+
+/**
+ * Returns the call nr if the call is sampled, -1 otherwise.
+ */
+static long callsLog_sample(calls_log_t *callsLog, size_t *callCount) {
+    size_t callNr = __atomic_fetch_add(callCount, 1, __ATOMIC_RELAXED);
+    return callNr % (size_t)callsLog->sampleRate == 0 ? (long)callNr : -1;
+}
+
+/**
+ * Returns the number of bytes of a payload to log, and the suffix marking a truncated payload.
+ */
+static int callsLog_payloadLength(calls_log_t *callsLog, const char *payload, const char **suffix) {
+    size_t len = strlen(payload);
+    *suffix = "";
+    if (callsLog->maxPayloadSize > 0 && len > callsLog->maxPayloadSize) {
+        len = callsLog->maxPayloadSize;
+        *suffix = "...";
+    }
+    return len > INT_MAX ? INT_MAX : (int)len;
+}
+
+static void callsLog_append(calls_log_t *callsLog, const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+static void callsLog_append(calls_log_t *callsLog, const char *format, ...) {
+    celixThreadMutex_lock(&callsLog->mutex);
+    size_t available = callsLog->bufferSize - callsLog->bufferLen;
+    va_list args;
+    va_start(args, format);
+    int len = vsnprintf(callsLog->buffer + callsLog->bufferLen, available, format, args);
+    va_end(args);
+    if (len >= 0 && (size_t)len < available) {
+        callsLog->bufferLen += (size_t)len;
+    } else {
+        callsLog->droppedCount += 1;
+    }
+    celixThreadCondition_signal(&callsLog->cond);
+    celixThreadMutex_unlock(&callsLog->mutex);
+}
+
+void callsLog_logImportCall(calls_log_t *callsLog, const char *url, const char *svcName, const char *payload, int status, const char *reply) {
+    if (callsLog == NULL) {
+        return;
+    }
+    long callNr = callsLog_sample(callsLog, &callsLog->importCallCount);
+    if (callNr >= 0) {
+        const char *payloadSuffix;
+        const char *replySuffix;
+        reply = reply == NULL ? "null" : reply;
+        int payloadLen = callsLog_payloadLength(callsLog, payload, &payloadSuffix);
+        int replyLen = callsLog_payloadLength(callsLog, reply, &replySuffix);
+        callsLog_append(callsLog, "REMOTE CALL NR %li\n\turl=%s\n\tservice=%s\n\tpayload=%.*s%s\n\treturn_code=%i\n\treply=%.*s%s\n",
+                        callNr, url, svcName, payloadLen, payload, payloadSuffix, status, replyLen, reply, replySuffix);
+    }
+}
+
+void callsLog_logExportCall(calls_log_t *callsLog, const char *svcName, const char *svcId, const char *payload, const char *response, int status) {
+    if (callsLog == NULL) {
+        return;
+    }
+    long callNr = callsLog_sample(callsLog, &callsLog->exportCallCount);
+    if (callNr >= 0) {
+        const char *payloadSuffix;
+        const char *responseSuffix;
+        response = response == NULL ? "(null)" : response;
+        int payloadLen = callsLog_payloadLength(callsLog, payload, &payloadSuffix);
+        int responseLen = callsLog_payloadLength(callsLog, response, &responseSuffix);
+        callsLog_append(callsLog, "REMOTE CALL %li\n\tservice=%s\n\tservice_id=%s\n\trequest_payload=%.*s%s\n\trequest_response=%.*s%s\n\tstatus=%i\n",
+                        callNr, svcName, svcId, payloadLen, payload, payloadSuffix, responseLen, response, responseSuffix, status);
+    }
+}
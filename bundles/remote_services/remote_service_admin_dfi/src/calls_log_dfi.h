@@ -0,0 +1,59 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef CELIX_CALLS_LOG_DFI_H
+#define CELIX_CALLS_LOG_DFI_H
+
+#include "celix_bundle_context.h"
+#include "celix_cleanup.h"
+#include "celix_errno.h"
+#include "celix_log_helper.h"
+
+/**
+ * @brief Log of the remote calls of the RSA DFI (see RSA_LOG_CALLS).
+ *
+ * Calls are sampled and formatted on the calling thread into an in-memory buffer; a background thread writes the
+ * buffered records to the log file. Records that do not fit in the buffer are dropped, so logging never blocks a
+ * remote call on file I/O.
+ */
+typedef struct calls_log calls_log_t;
+
+/**
+ * @brief Creates a calls log, configured by the RSA_LOG_CALLS_* properties of the bundle context.
+ */
+celix_status_t callsLog_create(celix_bundle_context_t *ctx, celix_log_helper_t *logHelper, calls_log_t **callsLog);
+
+/**
+ * @brief Writes the buffered records and destroys the calls log.
+ */
+void callsLog_destroy(calls_log_t *callsLog);
+
+CELIX_DEFINE_AUTOPTR_CLEANUP_FUNC(calls_log_t, callsLog_destroy)
+
+/**
+ * @brief Logs a remote call of an imported service, if the call is sampled. callsLog can be NULL.
+ */
+void callsLog_logImportCall(calls_log_t *callsLog, const char *url, const char *svcName, const char *payload, int status, const char *reply);
+
+/**
+ * @brief Logs a remote call of an exported service, if the call is sampled. callsLog can be NULL.
+ */
+void callsLog_logExportCall(calls_log_t *callsLog, const char *svcName, const char *svcId, const char *payload, const char *response, int status);
+
+#endif //CELIX_CALLS_LOG_DFI_H
@@ -58,14 +58,13 @@ struct export_registration {
 
     remote_interceptors_handler_t *interceptorsHandler;
 
-    FILE *logFile;
+    calls_log_t *callsLog;
 };
 
-static celix_status_t exportRegistration_findAndParseInterfaceDescriptor(celix_log_helper_t *helper, celix_bundle_context_t * const context, celix_bundle_t * const bundle, char const * const name, dyn_interface_type **out);
 static void exportRegistration_addServ(void *data, void *service);
 static void exportRegistration_removeServ(void *data, void *service);
 
-celix_status_t exportRegistration_create(celix_log_helper_t *helper, service_reference_pt reference, endpoint_description_t *endpoint, celix_bundle_context_t *context, FILE *logFile, export_registration_t **out) {
+celix_status_t exportRegistration_create(celix_log_helper_t *helper, service_reference_pt reference, endpoint_description_t *endpoint, celix_bundle_context_t *context, calls_log_t *callsLog, export_registration_t **out) {
     celix_status_t status = CELIX_SUCCESS;
 
     const char *servId = NULL;
@@ -89,7 +88,7 @@ celix_status_t exportRegistration_create(celix_log_helper_t *helper, service_ref
         reg->exportReference.endpoint = endpoint;
         reg->exportReference.reference = reference;
         reg->closed = false;
-        reg->logFile = logFile;
+        reg->callsLog = callsLog;
         reg->servId = strndup(servId, 1024);
         reg->trackerId = -1L;
         reg->active = true;
@@ -107,7 +106,7 @@ celix_status_t exportRegistration_create(celix_log_helper_t *helper, service_ref
     CELIX_DO_IF(status, serviceReference_getBundle(reference, &bundle));
 
     if (status == CELIX_SUCCESS) {
-        status = exportRegistration_findAndParseInterfaceDescriptor(helper, context, bundle, exports, &reg->intf);
+        status = dfi_acquireInterfaceDescriptor(helper, context, bundle, exports, &reg->intf);
     }
 
     if (status == CELIX_SUCCESS) {
@@ -170,7 +169,7 @@ celix_status_t exportRegistration_call(export_registration_t *export, char *data
             if (cont) {
                 celixThreadMutex_lock(&export->mutex);
                 if (export->active && export->service != NULL) {
-                    int rc = jsonRpc_call(export->intf, export->service, data, &response);
+                    int rc = jsonRpc_callWithJson(export->intf, export->service, js_request, &response);
                     status = (rc != 0) ? CELIX_SERVICE_EXCEPTION : CELIX_SUCCESS;
                     if (rc != 0) {
                         celix_logHelper_logTssErrors(export->helper, CELIX_LOG_LEVEL_ERROR);
@@ -190,13 +189,7 @@ celix_status_t exportRegistration_call(export_registration_t *export, char *data
             *responseOut = response;
 
             //printf("calling for '%s'\n");
-            if (export->logFile != NULL) {
-                static int callCount = 0;
-                const char *name = dynInterface_getName(export->intf);
-                fprintf(export->logFile, "REMOTE CALL %i\n\tservice=%s\n\tservice_id=%s\n\trequest_payload=%s\n\trequest_response=%s\n\tstatus=%i\n", callCount, name, export->servId, data, response, status);
-                fflush(export->logFile);
-                callCount += 1;
-            }
+            callsLog_logExportCall(export->callsLog, dynInterface_getName(export->intf), export->servId, data, response, status);
         }
     } else {
         status = CELIX_ILLEGAL_ARGUMENT;
@@ -207,31 +200,12 @@ celix_status_t exportRegistration_call(export_registration_t *export, char *data
     return status;
 }
 
-static celix_status_t exportRegistration_findAndParseInterfaceDescriptor(celix_log_helper_t *helper, celix_bundle_context_t * const context, celix_bundle_t * const bundle, char const * const name, dyn_interface_type **out) {
-    FILE* descriptor = NULL;
-
-    celix_status_t status = dfi_findDescriptor(context, bundle, name, &descriptor);
-    if (status == CELIX_SUCCESS && descriptor != NULL) {
-        int rc = dynInterface_parse(descriptor, out);
-        fclose(descriptor);
-        if (rc != 0) {
-            celix_logHelper_logTssErrors(helper, CELIX_LOG_LEVEL_WARNING);
-            celix_logHelper_warning(helper, "RSA_DFI: Error parsing service descriptor for \"%s\", return code is %d.", name, rc);
-            status = CELIX_BUNDLE_EXCEPTION;
-        }
-        return status;
-    }
-
-    celix_logHelper_log(helper, CELIX_LOG_LEVEL_WARNING, "RSA: Error finding service descriptor for '%s'", name);
-    return CELIX_BUNDLE_EXCEPTION;
-}
-
 static void exportRegistration_destroyCallback(void* data) {
     export_registration_t* reg = data;
     if (reg->intf != NULL) {
         dyn_interface_type *intf = reg->intf;
         reg->intf = NULL;
-        dynInterface_destroy(intf);
+        dfi_releaseInterfaceDescriptor(intf);
     }
 
     if (reg->exportReference.endpoint != NULL) {
@@ -24,8 +24,9 @@
 #include "export_registration.h"
 #include "celix_log_helper.h"
 #include "endpoint_description.h"
+#include "calls_log_dfi.h"
 
-celix_status_t exportRegistration_create(celix_log_helper_t *helper, service_reference_pt reference, endpoint_description_t *endpoint, celix_bundle_context_t *context, FILE *logFile, export_registration_t **registration);
+celix_status_t exportRegistration_create(celix_log_helper_t *helper, service_reference_pt reference, endpoint_description_t *endpoint, celix_bundle_context_t *context, calls_log_t *callsLog, export_registration_t **registration);
 void exportRegistration_destroy(export_registration_t *registration);
 
 celix_status_t exportRegistration_start(export_registration_t *registration);
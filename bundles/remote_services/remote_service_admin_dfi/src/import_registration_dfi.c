@@ -37,6 +37,7 @@
 
 struct import_registration {
     celix_bundle_context_t *context;
+    celix_log_helper_t *helper;
     endpoint_description_t * endpoint; //TODO owner? -> free when destroyed
     const char *classObject; //NOTE owned by endpoint
     celix_version_t* version;
@@ -52,7 +53,7 @@ struct import_registration {
 
     remote_interceptors_handler_t *interceptorsHandler;
 
-    FILE *logFile;
+    calls_log_t *callsLog;
 };
 
 struct service_proxy {
@@ -61,8 +62,6 @@ struct service_proxy {
     size_t count;
 };
 
-static celix_status_t importRegistration_findAndParseInterfaceDescriptor(celix_bundle_context_t * const context, celix_bundle_t * const bundle, char const * const name, dyn_interface_type **out);
-
 static celix_status_t importRegistration_createProxy(import_registration_t *import, celix_bundle_t *bundle,
                                               struct service_proxy **proxy);
 static void importRegistration_proxyFunc(void *userData, void *args[], void *returnVal);
@@ -74,17 +73,19 @@ static void* importRegistration_getService(void *handle, const celix_bundle_t *r
 void importRegistration_ungetService(void *handle, const celix_bundle_t *requestingBundle, const celix_properties_t *svcProperties);
 
 celix_status_t importRegistration_create(
+        celix_log_helper_t *helper,
         celix_bundle_context_t *context,
         endpoint_description_t *endpoint,
         const char *classObject,
         const char* serviceVersion,
         send_func_type sendFn,
         void* sendFnHandle,
-        FILE *logFile,
+        calls_log_t *callsLog,
         import_registration_t **out) {
     celix_status_t status = CELIX_SUCCESS;
     import_registration_t *reg = calloc(1, sizeof(*reg));
     reg->context = context;
+    reg->helper = helper;
     reg->endpoint = endpoint;
     reg->classObject = classObject;
     reg->send = sendFn;
@@ -103,7 +104,7 @@ celix_status_t importRegistration_create(
     reg->factory.handle = reg;
     reg->factory.getService = importRegistration_getService;
     reg->factory.ungetService = importRegistration_ungetService;
-    reg->logFile = logFile;
+    reg->callsLog = callsLog;
 
 
     if (status == CELIX_SUCCESS) {
@@ -218,27 +219,9 @@ void importRegistration_ungetService(void *handle, const celix_bundle_t *request
     pthread_mutex_unlock(&import->proxiesMutex);
 }
 
-static celix_status_t importRegistration_findAndParseInterfaceDescriptor(celix_bundle_context_t * const context, celix_bundle_t * const bundle, char const * const name, dyn_interface_type **out) {
-    celix_status_t status = CELIX_SUCCESS;
-    FILE* descriptor = NULL;
-    status = dfi_findDescriptor(context, bundle, name, &descriptor);
-    if (status == CELIX_SUCCESS && descriptor != NULL) {
-        int rc = dynInterface_parse(descriptor, out);
-        fclose(descriptor);
-        if (rc != 0) {
-            fprintf(stderr, "RSA_DFI: Cannot parse dfi descriptor for '%s'", name);
-            status = CELIX_BUNDLE_EXCEPTION;
-        }
-        return status;
-    }
-
-    fprintf(stdout, "RSA: Cannot find/open any valid descriptor files for '%s'", name);
-    return CELIX_BUNDLE_EXCEPTION;
-}
-
 static celix_status_t importRegistration_createProxy(import_registration_t *import, celix_bundle_t *bundle, struct service_proxy **out) {
     dyn_interface_type* intf = NULL;
-    celix_status_t  status = importRegistration_findAndParseInterfaceDescriptor(import->context, bundle, import->classObject, &intf);
+    celix_status_t  status = dfi_acquireInterfaceDescriptor(import->helper, import->context, bundle, import->classObject, &intf);
 
     if (status != CELIX_SUCCESS) {
         return status;
@@ -256,7 +239,7 @@ static celix_status_t importRegistration_createProxy(import_registration_t *impo
         pVerString = import->version != NULL ? celix_version_toString(import->version) : NULL;
         printf("Service version mismatch: consumer has %s, provider has %s. NOT creating proxy.\n",
                cVerString,pVerString != NULL ? pVerString : "NA");
-        dynInterface_destroy(intf);
+        dfi_releaseInterfaceDescriptor(intf);
         status = CELIX_SERVICE_EXCEPTION;
     }
 
@@ -264,6 +247,7 @@ static celix_status_t importRegistration_createProxy(import_registration_t *impo
     if (status == CELIX_SUCCESS) {
         proxy = calloc(1, sizeof(*proxy));
         if (proxy == NULL) {
+            dfi_releaseInterfaceDescriptor(intf);
             status = CELIX_ENOMEM;
         }
     }
@@ -286,14 +270,13 @@ static celix_status_t importRegistration_createProxy(import_registration_t *impo
         void (*fn)(void) = NULL;
         int index = 0;
         TAILQ_FOREACH(entry, list, entries) {
-            int rc = dynFunction_createClosure(entry->dynFunc, importRegistration_proxyFunc, entry, &fn);
-            serv[index + 1] = fn;
-            index += 1;
-
-            if (rc != 0) {
-                status = CELIX_BUNDLE_EXCEPTION;
+            //the closures are shared by all proxies of the cached interface descriptor
+            status = dfi_getMethodClosure(entry, importRegistration_proxyFunc, &fn);
+            if (status != CELIX_SUCCESS) {
                 break;
             }
+            serv[index + 1] = fn;
+            index += 1;
         }
     }
 
@@ -301,7 +284,7 @@ static celix_status_t importRegistration_createProxy(import_registration_t *impo
         *out = proxy;
     } else if (proxy != NULL) {
         if (proxy->intf != NULL) {
-            dynInterface_destroy(proxy->intf);
+            dfi_releaseInterfaceDescriptor(proxy->intf);
             proxy->intf = NULL;
         }
         free(proxy->service);
@@ -364,15 +347,8 @@ static void importRegistration_proxyFunc(void *userData, void *args[], void *ret
             celix_properties_destroy(metadata);
         }
 
-        if (import->logFile != NULL) {
-            static int callCount = 0;
-            const char *url = importRegistration_getUrl(import);
-            const char *svcName = importRegistration_getServiceName(import);
-            fprintf(import->logFile, "REMOTE CALL NR %i\n\turl=%s\n\tservice=%s\n\tpayload=%s\n\treturn_code=%i\n\treply=%s\n",
-                                       callCount, url, svcName, invokeRequest, status, reply == NULL ? "null" : reply);
-            fflush(import->logFile);
-            callCount += 1;
-        }
+        callsLog_logImportCall(import->callsLog, importRegistration_getUrl(import), importRegistration_getServiceName(import),
+                               invokeRequest, status, reply);
         free(invokeRequest); //Allocated by json_dumps in jsonRpc_prepareInvokeRequest
         free(reply); //Allocated by json_dumps in remoteServiceAdmin_send through curl call
     }
@@ -386,7 +362,7 @@ static void importRegistration_proxyFunc(void *userData, void *args[], void *ret
 static void importRegistration_destroyProxy(struct service_proxy *proxy) {
     if (proxy != NULL) {
         if (proxy->intf != NULL) {
-            dynInterface_destroy(proxy->intf);
+            dfi_releaseInterfaceDescriptor(proxy->intf);
         }
         if (proxy->service != NULL) {
             free(proxy->service);
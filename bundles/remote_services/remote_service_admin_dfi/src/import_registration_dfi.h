@@ -23,19 +23,21 @@
 #include "import_registration.h"
 #include "dfi_utils.h"
 #include "endpoint_description.h"
+#include "calls_log_dfi.h"
 
 #include <celix_errno.h>
 
 typedef celix_status_t (*send_func_type)(void *handle, endpoint_description_t *endpointDescription, char *request, celix_properties_t *metadata, char **reply);
 
 celix_status_t importRegistration_create(
+        celix_log_helper_t *helper,
         celix_bundle_context_t *context,
         endpoint_description_t *description,
         const char *classObject,
         const char* serviceVersion,
         send_func_type sendFn,
         void* sendFnHandle,
-        FILE *logFile,
+        calls_log_t *callsLog,
         import_registration_t **import);
 void importRegistration_destroy(import_registration_t *import);
 
@@ -39,6 +39,7 @@
 
 #include "import_registration_dfi.h"
 #include "export_registration_dfi.h"
+#include "calls_log_dfi.h"
 #include "remote_service_admin_dfi.h"
 #include "json_rpc.h"
 
@@ -105,7 +106,7 @@ struct remote_service_admin {
 
     struct mg_context *ctx;
 
-    FILE *logFile;
+    calls_log_t *callsLog;
 
     bool curlShareEnabled;
     void *curlShare;
@@ -301,15 +302,8 @@ celix_status_t remoteServiceAdmin_create(celix_bundle_context_t *context, remote
 
     bool logCalls = celix_bundleContext_getPropertyAsBool(context, RSA_LOG_CALLS_KEY, RSA_LOG_CALLS_DEFAULT);
     if (logCalls) {
-        const char *f = celix_bundleContext_getProperty(context, RSA_LOG_CALLS_FILE_KEY, RSA_LOG_CALLS_FILE_DEFAULT);
-        if (strncmp(f, "stdout", strlen("stdout")) == 0) {
-            (*admin)->logFile = stdout;
-        } else {
-            (*admin)->logFile = fopen(f, "w");
-            if ( (*admin)->logFile == NULL) {
-                celix_logHelper_log((*admin)->loghelper, CELIX_LOG_LEVEL_WARNING, "Error opening file '%s' for logging calls. %s", f, strerror(errno));
-            }
-        }
+        //note calls are not logged if the calls log cannot be created
+        (void)callsLog_create(context, (*admin)->loghelper, &(*admin)->callsLog);
     }
 
     return status;
@@ -321,9 +315,7 @@ celix_status_t remoteServiceAdmin_destroy(remote_service_admin_t **admin) {
 
     celix_bundleContext_waitForEvents((*admin)->context);
 
-    if ( (*admin)->logFile != NULL && (*admin)->logFile != stdout) {
-        fclose((*admin)->logFile);
-    }
+    callsLog_destroy((*admin)->callsLog);
     free((*admin)->discoveryInterface);
     free((*admin)->ip);
     free((*admin)->port);
@@ -654,7 +646,7 @@ celix_status_t remoteServiceAdmin_exportService(remote_service_admin_t *admin, c
             export_registration_t *registration = NULL;
 
             remoteServiceAdmin_createEndpointDescription(admin, reference, properties, (char *) interface, &endpoint);
-            status = exportRegistration_create(admin->loghelper, reference, endpoint, admin->context, admin->logFile,
+            status = exportRegistration_create(admin->loghelper, reference, endpoint, admin->context, admin->callsLog,
                                                &registration);
             if (status == CELIX_SUCCESS) {
                 status = exportRegistration_start(registration);
@@ -912,9 +904,9 @@ celix_status_t remoteServiceAdmin_importService(remote_service_admin_t *admin, e
                       objectClass);
 
         if (objectClass != NULL) {
-            status = importRegistration_create(admin->context, endpointDescription, objectClass, serviceVersion,
+            status = importRegistration_create(admin->loghelper, admin->context, endpointDescription, objectClass, serviceVersion,
                                                (send_func_type )remoteServiceAdmin_send, admin,
-                                               admin->logFile,
+                                               admin->callsLog,
                                                &import);
         }
 
@@ -33,6 +33,34 @@
 #define RSA_LOG_CALLS_FILE_KEY          "RSA_LOG_CALLS_FILE"
 #define RSA_LOG_CALLS_FILE_DEFAULT      "stdout"
 
+/**
+ * @brief Remote Service Admin DFI environment property (named "RSA_LOG_CALLS_SAMPLE_RATE") which specifies that only
+ * one out of every RSA_LOG_CALLS_SAMPLE_RATE calls is logged, if RSA_LOG_CALLS is enabled.
+ *
+ * The property is of the type long and the default is 1 (all calls are logged).
+ */
+#define RSA_LOG_CALLS_SAMPLE_RATE_KEY           "RSA_LOG_CALLS_SAMPLE_RATE"
+#define RSA_LOG_CALLS_SAMPLE_RATE_DEFAULT       1
+
+/**
+ * @brief Remote Service Admin DFI environment property (named "RSA_LOG_CALLS_MAX_PAYLOAD_SIZE") which specifies the
+ * max number of bytes logged of a request payload or reply. Longer payloads are truncated.
+ *
+ * The property is of the type long and the default is 4096. 0 means the payloads are not truncated.
+ */
+#define RSA_LOG_CALLS_MAX_PAYLOAD_SIZE_KEY      "RSA_LOG_CALLS_MAX_PAYLOAD_SIZE"
+#define RSA_LOG_CALLS_MAX_PAYLOAD_SIZE_DEFAULT  4096
+
+/**
+ * @brief Remote Service Admin DFI environment property (named "RSA_LOG_CALLS_BUFFER_SIZE") which specifies the
+ * size in bytes of the buffer for call records not yet written to RSA_LOG_CALLS_FILE.
+ * Records which do not fit in the buffer are dropped, and the number of dropped records is logged.
+ *
+ * The property is of the type long and the default is 1048576 (1MiB).
+ */
+#define RSA_LOG_CALLS_BUFFER_SIZE_KEY           "RSA_LOG_CALLS_BUFFER_SIZE"
+#define RSA_LOG_CALLS_BUFFER_SIZE_DEFAULT       1048576
+
 #define RSA_DFI_CONFIGURATION_TYPE      "org.amdatu.remote.admin.http"
 #define RSA_DFI_ENDPOINT_URL            "org.amdatu.remote.admin.http.url"
 
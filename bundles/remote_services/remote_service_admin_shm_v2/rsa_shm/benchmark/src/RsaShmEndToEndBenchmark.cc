@@ -0,0 +1,242 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "celix_bundle_context.h"
+#include "celix_constants.h"
+#include "celix_framework.h"
+#include "celix_framework_factory.h"
+#include "celix_properties.h"
+#include "remote_constants.h"
+#include "remote_service_admin.h"
+#include "RsaShmTestService.h"
+
+/**
+ * The rsa shm end-to-end benchmark: calls of the calculator service of the rsa shm tests, exported by a server
+ * framework and imported by a client framework in the same process. Both frameworks run the rsa shm and the json rpc
+ * bundles, so a call passes the json rpc proxy, the rsa shm client and server and the json rpc endpoint.
+ *
+ * The sum method of the calculator is called with state.range(0) doubles, from state.threads() threads at a time.
+ * Besides the throughput (items_per_second), the p50, p99 and p999 latencies of the calls are reported in microseconds.
+ * Use --benchmark_out=<file> --benchmark_out_format=json to keep the results, e.g. to track regressions.
+ */
+class RsaShmEndToEndBenchmark {
+public:
+    RsaShmEndToEndBenchmark() {
+        serverFw = createFramework(".rsa_shm_end_to_end_benchmark_server_cache");
+        clientFw = createFramework(".rsa_shm_end_to_end_benchmark_client_cache");
+        serverCtx = celix_framework_getFrameworkContext(serverFw.get());
+        clientCtx = celix_framework_getFrameworkContext(clientFw.get());
+
+        static rsa_shm_calc_service_t calcService{
+                .handle = nullptr,
+                .add = add,
+                .sum = sum,
+        };
+        auto* props = celix_properties_create();
+        celix_properties_set(props, CELIX_RSA_SERVICE_EXPORTED_INTERFACES, RSA_SHM_CALCULATOR_SERVICE);
+        celix_properties_set(props, CELIX_FRAMEWORK_SERVICE_VERSION, RSA_SHM_CALCULATOR_SERVICE_VERSION);
+        celix_properties_set(props, CELIX_RSA_SERVICE_EXPORTED_CONFIGS,
+                             RSA_SHM_CALCULATOR_CONFIGURATION_TYPE ",celix.remote.admin.rpc_type.json");
+        calcSvcId = celix_bundleContext_registerService(serverCtx, &calcService, RSA_SHM_CALCULATOR_SERVICE, props);
+        ok = calcSvcId >= 0 && exportService() && importService() && waitForProxy();
+    }
+
+    ~RsaShmEndToEndBenchmark() {
+        if (importReg != nullptr) {
+            useRsa(clientCtx, [this](remote_service_admin_service_t* rsa) {
+                rsa->importRegistration_close(rsa->admin, importReg);
+            });
+        }
+        if (exportedRegs != nullptr) {
+            useRsa(serverCtx, [this](remote_service_admin_service_t* rsa) {
+                for (int i = 0; i < celix_arrayList_size(exportedRegs); ++i) {
+                    auto* reg = static_cast<export_registration_t*>(celix_arrayList_get(exportedRegs, i));
+                    rsa->exportRegistration_close(rsa->admin, reg);
+                }
+            });
+            celix_arrayList_destroy(exportedRegs);
+        }
+        if (calcSvcId >= 0) {
+            celix_bundleContext_unregisterService(serverCtx, calcSvcId);
+        }
+    }
+
+    bool call(const struct rsa_shm_calc_sequence& values, double expected) const {
+        double result = 0.0;
+        return calc->sum(calc->handle, values, &result) == CELIX_SUCCESS && result == expected;
+    }
+
+    bool ok{false};
+
+private:
+    static std::shared_ptr<celix_framework_t> createFramework(const char* cacheDir) {
+        auto* props = celix_properties_create();
+        celix_properties_set(props, CELIX_FRAMEWORK_CLEAN_CACHE_DIR_ON_CREATE, "true");
+        celix_properties_set(props, CELIX_FRAMEWORK_CACHE_DIR, cacheDir);
+        celix_properties_set(props, "CELIX_FRAMEWORK_EXTENDER_PATH", RESOURCES_DIR);
+        celix_properties_set(props, "CELIX_LOGGING_DEFAULT_ACTIVE_LOG_LEVEL", "error");
+        std::shared_ptr<celix_framework_t> fw{celix_frameworkFactory_createFramework(props),
+                                              [](auto* f) { celix_frameworkFactory_destroyFramework(f); }};
+        auto* ctx = celix_framework_getFrameworkContext(fw.get());
+        celix_bundleContext_installBundle(ctx, RSA_SHM_BUNDLE, true);
+        celix_bundleContext_installBundle(ctx, RSA_JSON_RPC_BUNDLE, true);
+        return fw;
+    }
+
+    template<typename F>
+    static bool useRsa(celix_bundle_context_t* ctx, F&& fn) {
+        celix_service_use_options_t opts{};
+        opts.filter.serviceName = CELIX_RSA_REMOTE_SERVICE_ADMIN;
+        opts.waitTimeoutInSeconds = 30;
+        opts.callbackHandle = &fn;
+        opts.use = [](void* handle, void* svc) {
+            auto* f = static_cast<std::remove_reference_t<F>*>(handle);
+            (*f)(static_cast<remote_service_admin_service_t*>(svc));
+        };
+        return celix_bundleContext_useServiceWithOptions(ctx, &opts);
+    }
+
+    bool exportService() {
+        useRsa(serverCtx, [this](remote_service_admin_service_t* rsa) {
+            auto svcId = std::to_string(calcSvcId);
+            if (rsa->exportService(rsa->admin, svcId.data(), nullptr, &exportedRegs) != CELIX_SUCCESS ||
+                celix_arrayList_size(exportedRegs) == 0) {
+                return;
+            }
+            auto* reg = static_cast<export_registration_t*>(celix_arrayList_get(exportedRegs, 0));
+            export_reference_t* ref = nullptr;
+            if (rsa->exportRegistration_getExportReference(reg, &ref) == CELIX_SUCCESS) {
+                rsa->exportReference_getExportedEndpoint(ref, &endpoint);
+                free(ref);
+            }
+        });
+        return endpoint != nullptr;
+    }
+
+    bool importService() {
+        useRsa(clientCtx, [this](remote_service_admin_service_t* rsa) {
+            if (rsa->importService(rsa->admin, endpoint, &importReg) != CELIX_SUCCESS) {
+                importReg = nullptr;
+            }
+        });
+        return importReg != nullptr;
+    }
+
+    //The proxy is used without a service reference, it stays registered until the import registration is closed.
+    bool waitForProxy() {
+        celix_service_use_options_t opts{};
+        opts.filter.serviceName = RSA_SHM_CALCULATOR_SERVICE;
+        opts.waitTimeoutInSeconds = 30;
+        opts.callbackHandle = this;
+        opts.use = [](void* handle, void* svc) {
+            static_cast<RsaShmEndToEndBenchmark*>(handle)->calc = static_cast<rsa_shm_calc_service_t*>(svc);
+        };
+        return celix_bundleContext_useServiceWithOptions(clientCtx, &opts);
+    }
+
+    static int add(void* /*handle*/, double a, double b, double* result) {
+        *result = a + b;
+        return CELIX_SUCCESS;
+    }
+
+    static int sum(void* /*handle*/, struct rsa_shm_calc_sequence values, double* result) {
+        double total = 0.0;
+        for (uint32_t i = 0; i < values.len; ++i) {
+            total += values.buf[i];
+        }
+        *result = total;
+        return CELIX_SUCCESS;
+    }
+
+    std::shared_ptr<celix_framework_t> serverFw{};
+    std::shared_ptr<celix_framework_t> clientFw{};
+    celix_bundle_context_t* serverCtx{nullptr};
+    celix_bundle_context_t* clientCtx{nullptr};
+    long calcSvcId{-1};
+    celix_array_list_t* exportedRegs{nullptr};
+    endpoint_description_t* endpoint{nullptr};
+    import_registration_t* importReg{nullptr};
+    rsa_shm_calc_service_t* calc{nullptr};
+};
+
+static double RsaShmEndToEndBenchmark_percentile(std::vector<double>& latencies, double percentile) {
+    auto n = (size_t)(percentile * (double)(latencies.size() - 1));
+    std::nth_element(latencies.begin(), latencies.begin() + (long)n, latencies.end());
+    return latencies[n];
+}
+
+static void RsaShmEndToEndBenchmark_call(benchmark::State& state) {
+    //shared by the benchmark threads, created and destroyed by the first one
+    static std::unique_ptr<RsaShmEndToEndBenchmark> e2e{};
+    //the call latencies in microseconds per benchmark thread
+    static std::vector<std::vector<double>> latencies{};
+    if (state.thread_index() == 0) {
+        e2e = std::make_unique<RsaShmEndToEndBenchmark>();
+        latencies.assign(state.threads(), {});
+        for (auto& l : latencies) {
+            l.reserve(state.max_iterations);
+        }
+    }
+    std::vector<double> values(state.range(0));
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = (double)i;
+    }
+    struct rsa_shm_calc_sequence seq = {.cap = (uint32_t)values.size(), .len = (uint32_t)values.size(),
+                                        .buf = values.data()};
+    double expected = (double)values.size() * (double)(values.size() - 1) / 2;
+    for (auto _ : state) {
+        auto start = std::chrono::steady_clock::now();
+        if (!e2e->ok || !e2e->call(seq, expected)) {
+            state.SkipWithError("Cannot call remote service");
+            break;
+        }
+        auto end = std::chrono::steady_clock::now();
+        latencies[state.thread_index()].push_back(std::chrono::duration<double, std::micro>(end - start).count());
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * (int64_t)(values.size() * sizeof(double)));
+    if (state.thread_index() == 0) {
+        //All threads have finished their calls, the loop ends for all threads at the same time.
+        std::vector<double> all{};
+        for (auto& l : latencies) {
+            all.insert(all.end(), l.begin(), l.end());
+        }
+        if (!all.empty()) {
+            state.counters["p50_us"] = RsaShmEndToEndBenchmark_percentile(all, 0.50);
+            state.counters["p99_us"] = RsaShmEndToEndBenchmark_percentile(all, 0.99);
+            state.counters["p999_us"] = RsaShmEndToEndBenchmark_percentile(all, 0.999);
+        }
+        latencies.clear();
+        e2e.reset();
+    }
+}
+
+//Args: number of doubles passed to the remote service
+BENCHMARK(RsaShmEndToEndBenchmark_call)->Name("RsaShmEndToEndBenchmark")
+        ->UseRealTime()->Unit(benchmark::kMicrosecond)->ThreadRange(1, 8)
+        ->Arg(1)->Arg(64)->Arg(1024)->Arg(16 * 1024);
@@ -0,0 +1,184 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <sys/resource.h>
+
+#include "celix_constants.h"
+#include "celix_framework.h"
+#include "celix_framework_factory.h"
+#include "celix_log_helper.h"
+#include "celix_properties.h"
+#include "rsa_shm_client.h"
+#include "rsa_shm_constants.h"
+#include "rsa_shm_server.h"
+
+/**
+ * The rsa shm transport benchmark: remote calls from a rsa shm client to a rsa shm server echoing the request,
+ * with requests passed using the request ring (state.range(0) is the ring capacity) or, for a ring capacity of 0,
+ * using the datagram socket.
+ *
+ * The latency benchmarks do a single call at a time, the throughput benchmarks do calls from multiple threads.
+ * The reply benchmarks do calls with a small request and a reply of state.range(1) bytes, with replies passed using
+ * the reply pool (state.range(0) is the reply pool size) or, for a reply pool size of 0, in chunks. They count
+ * the voluntary context switches per call.
+ * The metadata benchmarks do calls with the metadata that the json rpc proxies add to every call.
+ */
+class RsaShmTransportBenchmark {
+public:
+    explicit RsaShmTransportBenchmark(long ringCapacity, long replyPoolSize = RSA_SHM_REPLY_POOL_SIZE_DEFAULT,
+                                      size_t replySize = 0) : replySize{replySize} {
+        auto* props = celix_properties_create();
+        celix_properties_set(props, CELIX_FRAMEWORK_CLEAN_CACHE_DIR_ON_CREATE, "true");
+        celix_properties_set(props, CELIX_FRAMEWORK_CACHE_DIR, ".rsa_shm_transport_benchmark_cache");
+        celix_properties_set(props, "CELIX_LOGGING_DEFAULT_ACTIVE_LOG_LEVEL", "error");
+        celix_properties_setLong(props, RSA_SHM_REQUEST_RING_CAPACITY_KEY, ringCapacity);
+        celix_properties_setLong(props, RSA_SHM_REPLY_POOL_SIZE_KEY, replyPoolSize);
+        fw = std::shared_ptr<celix_framework_t>{celix_frameworkFactory_createFramework(props),
+                                                [](auto* f) { celix_frameworkFactory_destroyFramework(f); }};
+        auto* ctx = celix_framework_getFrameworkContext(fw.get());
+        logHelper = std::shared_ptr<celix_log_helper_t>{celix_logHelper_create(ctx, "RsaShmTransportBenchmark"),
+                                                        [](auto* l) { celix_logHelper_destroy(l); }};
+        if (rsaShmServer_create(ctx, serverName, logHelper.get(), echo, this, &server) != CELIX_SUCCESS ||
+            rsaShmClientManager_create(ctx, logHelper.get(), &clientManager) != CELIX_SUCCESS ||
+            rsaShmClientManager_createOrAttachClient(clientManager, serverName, serviceId) != CELIX_SUCCESS) {
+            ok = false;
+        }
+    }
+
+    ~RsaShmTransportBenchmark() {
+        if (clientManager != nullptr) {
+            rsaShmClientManager_destroyOrDetachClient(clientManager, serverName, serviceId);
+            rsaShmClientManager_destroy(clientManager);
+        }
+        if (server != nullptr) {
+            rsaShmServer_destroy(server);
+        }
+    }
+
+    bool call(const std::string& payload, celix_properties_t* metadata = nullptr) {
+        struct iovec request = {.iov_base = (void*)payload.data(), .iov_len = payload.size()};
+        struct iovec response = {.iov_base = nullptr, .iov_len = 0};
+        auto status = rsaShmClientManager_sendMsgTo(clientManager, serverName, serviceId, metadata, &request, &response);
+        free(response.iov_base);
+        return status == CELIX_SUCCESS && response.iov_len == (replySize == 0 ? payload.size() : replySize);
+    }
+
+    bool ok{true};
+
+private:
+    //Echoes the request, or replies replySize bytes if replySize is not 0
+    static celix_status_t echo(void* handle, rsa_shm_server_t* /*server*/, celix_properties_t* /*metadata*/,
+                               const struct iovec* request, struct iovec* response) {
+        auto* self = static_cast<RsaShmTransportBenchmark*>(handle);
+        size_t size = self->replySize == 0 ? request->iov_len : self->replySize;
+        response->iov_base = malloc(size);
+        if (response->iov_base == nullptr) {
+            return CELIX_ENOMEM;
+        }
+        memcpy(response->iov_base, request->iov_base, std::min(size, request->iov_len));
+        response->iov_len = size;
+        return CELIX_SUCCESS;
+    }
+
+    static constexpr const char* serverName = "rsa_shm_transport_benchmark";
+    static constexpr long serviceId = 1;
+    const size_t replySize;
+    std::shared_ptr<celix_framework_t> fw{};
+    std::shared_ptr<celix_log_helper_t> logHelper{};
+    rsa_shm_server_t* server{nullptr};
+    rsa_shm_client_manager_t* clientManager{nullptr};
+};
+
+static void RsaShmTransportBenchmark_call(benchmark::State& state) {
+    //shared by the benchmark threads, created and destroyed by the first one
+    static std::unique_ptr<RsaShmTransportBenchmark> transport{};
+    if (state.thread_index() == 0) {
+        transport = std::make_unique<RsaShmTransportBenchmark>(state.range(0));
+    }
+    std::string payload(state.range(1), 'x');
+    for (auto _ : state) {
+        if (!transport->ok || !transport->call(payload)) {
+            state.SkipWithError("Cannot call remote service");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * (int64_t)payload.size());
+    if (state.thread_index() == 0) {
+        transport.reset();
+    }
+}
+
+//Args: ring capacity (0: datagram socket), payload size
+BENCHMARK(RsaShmTransportBenchmark_call)->Name("RsaShmTransportBenchmark_latency")
+        ->UseRealTime()->Unit(benchmark::kMicrosecond)
+        ->Args({0, 16})->Args({64, 16})->Args({0, 4096})->Args({64, 4096});
+BENCHMARK(RsaShmTransportBenchmark_call)->Name("RsaShmTransportBenchmark_throughput")
+        ->UseRealTime()->Unit(benchmark::kMicrosecond)->ThreadRange(2, 8)
+        ->Args({0, 16})->Args({64, 16})->Args({0, 4096})->Args({64, 4096});
+
+static void RsaShmTransportBenchmark_metadata(benchmark::State& state) {
+    RsaShmTransportBenchmark transport{state.range(0)};
+    std::string payload(16, 'x');
+    for (auto _ : state) {
+        //Like a json rpc proxy, every call creates its metadata
+        celix_autoptr(celix_properties_t) metadata = celix_properties_create();
+        celix_properties_setLong(metadata, "SerialProtocolId", 1);
+        if (!transport.ok || !transport.call(payload, metadata)) {
+            state.SkipWithError("Cannot call remote service");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+//Args: ring capacity (0: datagram socket)
+BENCHMARK(RsaShmTransportBenchmark_metadata)->Name("RsaShmTransportBenchmark_metadata")
+        ->UseRealTime()->Unit(benchmark::kMicrosecond)->Arg(0)->Arg(64);
+
+static void RsaShmTransportBenchmark_reply(benchmark::State& state) {
+    RsaShmTransportBenchmark transport{RSA_SHM_REQUEST_RING_CAPACITY_DEFAULT, state.range(0), (size_t)state.range(1)};
+    std::string payload(16, 'x');
+    struct rusage before{};
+    getrusage(RUSAGE_SELF, &before);
+    for (auto _ : state) {
+        if (!transport.ok || !transport.call(payload)) {
+            state.SkipWithError("Cannot call remote service");
+            break;
+        }
+    }
+    struct rusage after{};
+    getrusage(RUSAGE_SELF, &after);
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * state.range(1));
+    state.counters["ctxSwitchesPerCall"] = benchmark::Counter((double)(after.ru_nvcsw - before.ru_nvcsw),
+                                                              benchmark::Counter::kAvgIterations);
+}
+
+//Args: reply pool size (0: replies in chunks), reply size. Chunked replies of more than 1MB take too long.
+BENCHMARK(RsaShmTransportBenchmark_reply)->Name("RsaShmTransportBenchmark_reply")
+        ->UseRealTime()->Unit(benchmark::kMicrosecond)
+        ->ArgsProduct({{0}, benchmark::CreateRange(1024, 1024 * 1024, 16)})
+        ->ArgsProduct({{64 * 1024 * 1024}, benchmark::CreateRange(1024, 16 * 1024 * 1024, 16)});
@@ -0,0 +1,105 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include <thpool.h>
+#include "rsa_shm_worker_pool.h"
+
+/**
+ * The rsa shm worker pool benchmark: many tiny jobs submitted by one or more threads to a thpool (as used by the rsa
+ * shm server before) and to a rsa_shm_worker_pool_t, both with 5 threads like the rsa shm server.
+ * Every benchmark thread submits state.range(0) jobs per iteration and waits until they are done. If state.range(1) is
+ * set, it is the maximum number of concurrent jobs per key of the worker pool, and every benchmark thread uses its own key.
+ */
+static constexpr int NR_OF_WORKERS = 5;
+
+static void RsaShmWorkerPoolBenchmark_countJob(void* data) {
+    static_cast<std::atomic<long>*>(data)->fetch_add(1, std::memory_order_release);
+}
+
+static void RsaShmWorkerPoolBenchmark_waitForJobs(const std::atomic<long>& jobsDone, long nrOfJobs) {
+    while (jobsDone.load(std::memory_order_acquire) < nrOfJobs) {
+        std::this_thread::yield();
+    }
+}
+
+static void RsaShmWorkerPoolBenchmark_thpool(benchmark::State& state) {
+    //shared by the benchmark threads, created and destroyed by the first one
+    static std::shared_ptr<thpool_> pool{};
+    if (state.thread_index() == 0) {
+        pool = std::shared_ptr<thpool_>{thpool_init(NR_OF_WORKERS), [](auto* p) { thpool_destroy(p); }};
+    }
+    std::atomic<long> jobsDone{0};
+    long nrOfJobs = 0;
+    for (auto _ : state) {
+        for (long i = 0; i < state.range(0); ++i) {
+            if (pool == nullptr || thpool_add_work(pool.get(), RsaShmWorkerPoolBenchmark_countJob, &jobsDone) != 0) {
+                state.SkipWithError("Cannot submit job");
+                break;
+            }
+            ++nrOfJobs;
+        }
+        RsaShmWorkerPoolBenchmark_waitForJobs(jobsDone, nrOfJobs);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    if (state.thread_index() == 0) {
+        pool.reset();
+    }
+}
+
+static void RsaShmWorkerPoolBenchmark_workerPool(benchmark::State& state) {
+    //shared by the benchmark threads, created and destroyed by the first one
+    static std::shared_ptr<rsa_shm_worker_pool_t> pool{};
+    if (state.thread_index() == 0) {
+        rsa_shm_worker_pool_t* p = nullptr;
+        (void)rsaShmWorkerPool_create(NR_OF_WORKERS, (unsigned int)state.range(1), &p);
+        pool = std::shared_ptr<rsa_shm_worker_pool_t>{p, [](auto* p) { rsaShmWorkerPool_destroy(p); }};
+    }
+    std::atomic<long> jobsDone{0};
+    long nrOfJobs = 0;
+    for (auto _ : state) {
+        for (long i = 0; i < state.range(0); ++i) {
+            long key = state.range(1) == 0 ? -1 : state.thread_index();
+            if (pool == nullptr || rsaShmWorkerPool_submit(pool.get(), key, RsaShmWorkerPoolBenchmark_countJob,
+                                                           &jobsDone) != CELIX_SUCCESS) {
+                state.SkipWithError("Cannot submit job");
+                break;
+            }
+            ++nrOfJobs;
+        }
+        RsaShmWorkerPoolBenchmark_waitForJobs(jobsDone, nrOfJobs);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    if (state.thread_index() == 0) {
+        pool.reset();
+    }
+}
+
+//Args: number of jobs per iteration
+BENCHMARK(RsaShmWorkerPoolBenchmark_thpool)->Name("RsaShmWorkerPoolBenchmark_thpool")
+        ->UseRealTime()->Unit(benchmark::kMicrosecond)->ThreadRange(1, 4)
+        ->Arg(1)->Arg(1000);
+//Args: number of jobs per iteration, maximum number of concurrent jobs per key (0: jobs without key)
+BENCHMARK(RsaShmWorkerPoolBenchmark_workerPool)->Name("RsaShmWorkerPoolBenchmark_workerPool")
+        ->UseRealTime()->Unit(benchmark::kMicrosecond)->ThreadRange(1, 4)
+        ->Args({1, 0})->Args({1000, 0})->Args({1000, 2});
@@ -18,9 +18,12 @@
  */
 #include "rsa_shm_server.h"
 #include "rsa_shm_client.h"
+#include "rsa_shm_worker_pool.h"
 #include "shm_pool.h"
 #include "shm_cache.h"
 #include "rsa_shm_constants.h"
+#include "rsa_shm_msg.h"
+#include "remote_constants.h"
 #include "celix_log_helper.h"
 #include "celix_framework.h"
 #include "celix_bundle_context.h"
@@ -36,10 +39,12 @@
 #include "stdio_ei.h"
 #include "pthread_ei.h"
 #include "celix_properties_ei.h"
-#include "thpool_ei.h"
 #include "celix_errno.h"
 #include <errno.h>
 #include <unistd.h>
+#include <string>
+#include <thread>
+#include <vector>
 #include <gtest/gtest.h>
 
 class RsaShmClientServerUnitTestSuite : public ::testing::Test {
@@ -62,6 +67,7 @@ public:
         //reset error injection
         celix_ei_expect_celix_longHashMap_create(nullptr, 0, nullptr);
         celix_ei_expect_shmPool_malloc(nullptr, 0, nullptr);
+        celix_ei_expect_shmPool_mallocPair(nullptr, 0, nullptr);
         celix_ei_expect_malloc(nullptr, 0, nullptr);
         celix_ei_expect_celixThreadMutex_create(nullptr, 0, 0);
         celix_ei_expect_celixThread_create(nullptr, 0, 0);
@@ -79,8 +85,6 @@ public:
         celix_ei_expect_pthread_condattr_setpshared(nullptr, 1, 0);
         celix_ei_expect_pthread_cond_init(nullptr, 1, 0);
         celix_ei_expect_pthread_cond_timedwait(nullptr, 1, 0);
-        celix_ei_expect_thpool_init(nullptr, 0, nullptr);
-        celix_ei_expect_thpool_add_work(nullptr, 0, 0);
         celix_ei_expect_celix_properties_saveToStream(nullptr, 0, CELIX_SUCCESS);
     }
 
@@ -141,6 +145,156 @@ TEST_F(RsaShmClientServerUnitTestSuite, SendMsg) {
     rsaShmServer_destroy(server);
 }
 
+TEST_F(RsaShmClientServerUnitTestSuite, SendMsgConcurrently) {
+    rsa_shm_server_t *server = nullptr;
+    auto status = rsaShmServer_create(ctx.get(), "shm_test_server", logHelper.get(), ReceiveMsgCallback, nullptr, &server);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    EXPECT_NE(nullptr, server);
+
+    rsa_shm_client_manager_t *clientManager = nullptr;
+    status = rsaShmClientManager_create(ctx.get(), logHelper.get(), &clientManager);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    EXPECT_NE(nullptr, clientManager);
+
+    long serverId = 100;//dummy id
+    status = rsaShmClientManager_createOrAttachClient(clientManager, "shm_test_server", serverId);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+
+    //requests are sent using the request ring, and using the socket if the ring is full
+    std::vector<std::thread> threads{};
+    for (int i = 0; i < 8; ++i) {
+        threads.emplace_back([clientManager, serverId]() {
+            for (int j = 0; j < 100; ++j) {
+                struct iovec request = {.iov_base = (void*)"request", .iov_len = strlen("request")};
+                struct iovec response = {.iov_base = nullptr, .iov_len = 0};
+                auto ret = rsaShmClientManager_sendMsgTo(clientManager, "shm_test_server", serverId, nullptr, &request, &response);
+                EXPECT_EQ(CELIX_SUCCESS, ret);
+                EXPECT_STREQ("reply", (char*)response.iov_base);
+                free(response.iov_base);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    rsaShmClientManager_destroyOrDetachClient(clientManager, "shm_test_server", serverId);
+
+    rsaShmClientManager_destroy(clientManager);
+
+    rsaShmServer_destroy(server);
+}
+
+TEST_F(RsaShmClientServerUnitTestSuite, SendMsgWithRequestRingDisabled) {
+    auto* props = celix_properties_create();
+    celix_properties_set(props, CELIX_FRAMEWORK_CLEAN_CACHE_DIR_ON_CREATE, "true");
+    celix_properties_set(props, CELIX_FRAMEWORK_CACHE_DIR, ".rsa_shm_client_server_no_ring_test_cache");
+    celix_properties_setLong(props, RSA_SHM_REQUEST_RING_CAPACITY_KEY, 0);
+    auto* noRingFw = celix_frameworkFactory_createFramework(props);
+    ASSERT_NE(nullptr, noRingFw);
+    auto* noRingCtx = celix_framework_getFrameworkContext(noRingFw);
+
+    rsa_shm_server_t *server = nullptr;
+    auto status = rsaShmServer_create(ctx.get(), "shm_test_server", logHelper.get(), ReceiveMsgCallback, nullptr, &server);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    EXPECT_NE(nullptr, server);
+
+    rsa_shm_client_manager_t *clientManager = nullptr;
+    status = rsaShmClientManager_create(noRingCtx, logHelper.get(), &clientManager);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    EXPECT_NE(nullptr, clientManager);
+
+    long serverId = 100;//dummy id
+    status = rsaShmClientManager_createOrAttachClient(clientManager, "shm_test_server", serverId);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+
+    struct iovec request = {.iov_base = (void*)"request", .iov_len = strlen("request")};
+    struct iovec response = {.iov_base = nullptr, .iov_len = 0};
+    status = rsaShmClientManager_sendMsgTo(clientManager, "shm_test_server", serverId, nullptr, &request, &response);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    EXPECT_STREQ("reply", (char*)response.iov_base);
+    free(response.iov_base);
+
+    rsaShmClientManager_destroyOrDetachClient(clientManager, "shm_test_server", serverId);
+
+    rsaShmClientManager_destroy(clientManager);
+
+    rsaShmServer_destroy(server);
+
+    celix_frameworkFactory_destroyFramework(noRingFw);
+}
+
+TEST_F(RsaShmClientServerUnitTestSuite, FailedToAllocateRequestRing) {
+    rsa_shm_server_t *server = nullptr;
+    auto status = rsaShmServer_create(ctx.get(), "shm_test_server", logHelper.get(), ReceiveMsgCallback, nullptr, &server);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    EXPECT_NE(nullptr, server);
+
+    rsa_shm_client_manager_t *clientManager = nullptr;
+    status = rsaShmClientManager_create(ctx.get(), logHelper.get(), &clientManager);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    EXPECT_NE(nullptr, clientManager);
+
+    long serverId = 100;//dummy id
+    celix_ei_expect_shmPool_malloc((void*)&rsaShmClientManager_createOrAttachClient, 2, nullptr);
+    status = rsaShmClientManager_createOrAttachClient(clientManager, "shm_test_server", serverId);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+
+    //requests are sent using the socket
+    struct iovec request = {.iov_base = (void*)"request", .iov_len = strlen("request")};
+    struct iovec response = {.iov_base = nullptr, .iov_len = 0};
+    status = rsaShmClientManager_sendMsgTo(clientManager, "shm_test_server", serverId, nullptr, &request, &response);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    EXPECT_STREQ("reply", (char*)response.iov_base);
+    free(response.iov_base);
+
+    rsaShmClientManager_destroyOrDetachClient(clientManager, "shm_test_server", serverId);
+
+    rsaShmClientManager_destroy(clientManager);
+
+    rsaShmServer_destroy(server);
+}
+
+TEST_F(RsaShmClientServerUnitTestSuite, SendMsgAfterServerRestart) {
+    rsa_shm_server_t *server = nullptr;
+    auto status = rsaShmServer_create(ctx.get(), "shm_test_server", logHelper.get(), ReceiveMsgCallback, nullptr, &server);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    EXPECT_NE(nullptr, server);
+
+    rsa_shm_client_manager_t *clientManager = nullptr;
+    status = rsaShmClientManager_create(ctx.get(), logHelper.get(), &clientManager);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    EXPECT_NE(nullptr, clientManager);
+
+    long serverId = 100;//dummy id
+    status = rsaShmClientManager_createOrAttachClient(clientManager, "shm_test_server", serverId);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+
+    struct iovec request = {.iov_base = (void*)"request", .iov_len = strlen("request")};
+    struct iovec response = {.iov_base = nullptr, .iov_len = 0};
+    status = rsaShmClientManager_sendMsgTo(clientManager, "shm_test_server", serverId, nullptr, &request, &response);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    free(response.iov_base);
+
+    //the server closes the request ring of the client
+    rsaShmServer_destroy(server);
+    status = rsaShmServer_create(ctx.get(), "shm_test_server", logHelper.get(), ReceiveMsgCallback, nullptr, &server);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+
+    //requests are sent using the socket
+    response = {.iov_base = nullptr, .iov_len = 0};
+    status = rsaShmClientManager_sendMsgTo(clientManager, "shm_test_server", serverId, nullptr, &request, &response);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    EXPECT_STREQ("reply", (char*)response.iov_base);
+    free(response.iov_base);
+
+    rsaShmClientManager_destroyOrDetachClient(clientManager, "shm_test_server", serverId);
+
+    rsaShmClientManager_destroy(clientManager);
+
+    rsaShmServer_destroy(server);
+}
+
 TEST_F(RsaShmClientServerUnitTestSuite, SendMsgErrorEncodePropertiesTest) {
     //Given a rsa shm server
     rsa_shm_server_t *server = nullptr;
@@ -160,7 +314,7 @@ TEST_F(RsaShmClientServerUnitTestSuite, SendMsgErrorEncodePropertiesTest) {
     EXPECT_EQ(CELIX_SUCCESS, status);
 
     //When an error is prepared for saveToStream
-    celix_ei_expect_celix_properties_saveToStream((void*)rsaShmClientManager_sendMsgTo, 0, ENOMEM);
+    celix_ei_expect_celix_properties_saveToStream((void*)rsaShmClientManager_sendMsgTo, 1, ENOMEM);
 
     //And a message is sent
     celix_autoptr(celix_properties_t) metadata = celix_properties_create();
@@ -179,6 +333,126 @@ TEST_F(RsaShmClientServerUnitTestSuite, SendMsgErrorEncodePropertiesTest) {
     rsaShmServer_destroy(server);
 }
 
+static long receivedMetadataServiceId = -1;
+static std::string receivedMetadataCustomValue{};
+static celix_status_t ReceiveMsgCallbackCheckingMetadata(void *handle, rsa_shm_server_t *server, celix_properties_t *metadata, const struct iovec *request, struct iovec *response) {
+    receivedMetadataServiceId = celix_properties_getAsLong(metadata, CELIX_RSA_ENDPOINT_SERVICE_ID, -1);
+    receivedMetadataCustomValue = celix_properties_get(metadata, "CustomKey", "");
+    return ReceiveMsgCallback(handle, server, metadata, request, response);
+}
+
+TEST_F(RsaShmClientServerUnitTestSuite, SendMsgReusesEncodedMetadata) {
+    rsa_shm_server_t *server = nullptr;
+    auto status = rsaShmServer_create(ctx.get(), "shm_test_server", logHelper.get(), ReceiveMsgCallbackCheckingMetadata, nullptr, &server);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+
+    rsa_shm_client_manager_t *clientManager = nullptr;
+    status = rsaShmClientManager_create(ctx.get(), logHelper.get(), &clientManager);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+
+    long serverId = 100;//dummy id
+    status = rsaShmClientManager_createOrAttachClient(clientManager, "shm_test_server", serverId);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+
+    auto sendMsg = [&](const celix_properties_t* metadata) {
+        struct iovec request = {.iov_base = (void*)"request", .iov_len = strlen("request")};
+        struct iovec response = {.iov_base = nullptr, .iov_len = 0};
+        auto ret = rsaShmClientManager_sendMsgTo(clientManager, "shm_test_server", serverId,
+                                                 (celix_properties_t*)metadata, &request, &response);
+        free(response.iov_base);
+        return ret;
+    };
+
+    //The first message encodes the metadata, including the service id
+    celix_autoptr(celix_properties_t) metadata = celix_properties_create();
+    celix_properties_set(metadata, "CustomKey", "test");
+    EXPECT_EQ(CELIX_SUCCESS, sendMsg(metadata));
+    EXPECT_EQ(serverId, receivedMetadataServiceId);
+    EXPECT_EQ("test", receivedMetadataCustomValue);
+
+    //Equal metadata is not encoded again
+    celix_ei_expect_celix_properties_saveToStream((void*)rsaShmClientManager_sendMsgTo, 1, ENOMEM);
+    celix_autoptr(celix_properties_t) equalMetadata = celix_properties_copy(metadata);
+    receivedMetadataServiceId = -1;
+    EXPECT_EQ(CELIX_SUCCESS, sendMsg(equalMetadata));
+    EXPECT_EQ(serverId, receivedMetadataServiceId);
+    EXPECT_EQ("test", receivedMetadataCustomValue);
+
+    //Changed metadata is encoded again
+    celix_properties_set(metadata, "CustomKey", "changed");
+    EXPECT_EQ(ENOMEM, sendMsg(metadata));
+    EXPECT_EQ(CELIX_SUCCESS, sendMsg(metadata));
+    EXPECT_EQ("changed", receivedMetadataCustomValue);
+
+    //Empty metadata only contains the service id
+    receivedMetadataServiceId = -1;
+    EXPECT_EQ(CELIX_SUCCESS, sendMsg(nullptr));
+    EXPECT_EQ(serverId, receivedMetadataServiceId);
+    EXPECT_EQ("", receivedMetadataCustomValue);
+    celix_ei_expect_celix_properties_saveToStream((void*)rsaShmClientManager_sendMsgTo, 1, ENOMEM);
+    celix_autoptr(celix_properties_t) emptyMetadata = celix_properties_create();
+    EXPECT_EQ(CELIX_SUCCESS, sendMsg(emptyMetadata));
+
+    rsaShmClientManager_destroyOrDetachClient(clientManager, "shm_test_server", serverId);
+    rsaShmClientManager_destroy(clientManager);
+    rsaShmServer_destroy(server);
+}
+
+static uintptr_t receivedRequestAddress = 0;
+static std::string receivedRequest{};
+static celix_status_t ReceiveMsgCallbackCheckingRequest(void *handle, rsa_shm_server_t *server, celix_properties_t *metadata, const struct iovec *request, struct iovec *response) {
+    receivedRequestAddress = (uintptr_t)request->iov_base;
+    receivedRequest.assign((const char*)request->iov_base, request->iov_len);
+    return ReceiveMsgCallback(handle, server, metadata, request, response);
+}
+
+TEST_F(RsaShmClientServerUnitTestSuite, SendMsgWithAlignedRequest) {
+    rsa_shm_server_t *server = nullptr;
+    auto status = rsaShmServer_create(ctx.get(), "shm_test_server", logHelper.get(), ReceiveMsgCallbackCheckingRequest, nullptr, &server);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+
+    rsa_shm_client_manager_t *clientManager = nullptr;
+    status = rsaShmClientManager_create(ctx.get(), logHelper.get(), &clientManager);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+
+    long serverId = 100;//dummy id
+    status = rsaShmClientManager_createOrAttachClient(clientManager, "shm_test_server", serverId);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+
+    //The request follows the metadata, which is padded independent of its length
+    for (std::string value : {"a", "ab", "abc", "abcd", "abcde", "abcdef", "abcdefg", "abcdefgh"}) {
+        celix_autoptr(celix_properties_t) metadata = celix_properties_create();
+        celix_properties_set(metadata, "CustomKey", value.c_str());
+        struct iovec request = {.iov_base = (void*)"request", .iov_len = strlen("request")};
+        struct iovec response = {.iov_base = nullptr, .iov_len = 0};
+        receivedRequestAddress = 0;
+        status = rsaShmClientManager_sendMsgTo(clientManager, "shm_test_server", serverId, metadata, &request, &response);
+        EXPECT_EQ(CELIX_SUCCESS, status);
+        free(response.iov_base);
+        EXPECT_NE(0, receivedRequestAddress);
+        EXPECT_EQ(0, receivedRequestAddress % RSA_SHM_MSG_REQUEST_ALIGNMENT);
+        EXPECT_EQ("request", receivedRequest);
+    }
+
+    rsaShmClientManager_destroyOrDetachClient(clientManager, "shm_test_server", serverId);
+    rsaShmClientManager_destroy(clientManager);
+    rsaShmServer_destroy(server);
+}
+
+TEST_F(RsaShmClientServerUnitTestSuite, GetStatsWithInvalidParams) {
+    rsa_shm_client_manager_t *clientManager = nullptr;
+    auto status = rsaShmClientManager_create(ctx.get(), logHelper.get(), &clientManager);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+
+    rsa_shm_client_stats_t stats{};
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, rsaShmClientManager_getStats(nullptr, &stats));
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, rsaShmClientManager_getStats(clientManager, nullptr));
+    EXPECT_EQ(CELIX_SUCCESS, rsaShmClientManager_getStats(clientManager, &stats));
+    EXPECT_EQ(0, stats.responses);
+
+    rsaShmClientManager_destroy(clientManager);
+}
+
 TEST_F(RsaShmClientServerUnitTestSuite, SendMsgWithNoServer) {
     rsa_shm_client_manager_t *clientManager = nullptr;
     auto status = rsaShmClientManager_create(ctx.get(), logHelper.get(), &clientManager);
@@ -259,7 +533,14 @@ TEST_F(RsaShmClientServerUnitTestSuite, CreateRsaShmClientManagerWithENOMEM) {
 
 TEST_F(RsaShmClientServerUnitTestSuite, FailedToCreateShmPool) {
     rsa_shm_client_manager_t *clientManager = nullptr;
-    celix_ei_expect_malloc((void*)&shmPool_create, 0, nullptr);
+    celix_ei_expect_malloc((void*)&shmPool_createWithOptions, 0, nullptr);
+    auto status = rsaShmClientManager_create(ctx.get(), logHelper.get(), &clientManager);
+    EXPECT_EQ(CELIX_ENOMEM, status);
+}
+
+TEST_F(RsaShmClientServerUnitTestSuite, FailedToCreateReplyShmCache) {
+    rsa_shm_client_manager_t *clientManager = nullptr;
+    celix_ei_expect_malloc((void*)&shmCache_create, 0, nullptr);
     auto status = rsaShmClientManager_create(ctx.get(), logHelper.get(), &clientManager);
     EXPECT_EQ(CELIX_ENOMEM, status);
 }
@@ -527,7 +808,7 @@ TEST_F(RsaShmClientServerUnitTestSuite, FailedToOpenMemorystreamForMatadata) {
     status = rsaShmClientManager_createOrAttachClient(clientManager, "shm_test_server", serverId);
     EXPECT_EQ(CELIX_SUCCESS, status);
 
-    celix_ei_expect_open_memstream((void*)&rsaShmClientManager_sendMsgTo, 0, nullptr);
+    celix_ei_expect_open_memstream((void*)&rsaShmClientManager_sendMsgTo, 1, nullptr);
     celix_properties_t *metadata = celix_properties_create();
     celix_properties_set(metadata, "CustomKey", "test");
     struct iovec request = {.iov_base = (void*)"request", .iov_len = strlen("request")};
@@ -565,10 +846,6 @@ TEST_F(RsaShmClientServerUnitTestSuite, FailedToCreateMsgControl) {
     struct iovec request = {.iov_base = (void*)"request", .iov_len = strlen("request")};
     struct iovec response = {.iov_base = nullptr, .iov_len = 0};
 
-    celix_ei_expect_shmPool_malloc((void*)&rsaShmClientManager_sendMsgTo, 1, nullptr);
-    status = rsaShmClientManager_sendMsgTo(clientManager, "shm_test_server", serverId, nullptr, &request, &response);
-    EXPECT_EQ(CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, ENOMEM), status);
-
     celix_ei_expect_pthread_mutexattr_init((void*)&rsaShmClientManager_sendMsgTo, 1, ENOMEM);
     status = rsaShmClientManager_sendMsgTo(clientManager, "shm_test_server", serverId, nullptr, &request, &response);
     EXPECT_EQ(CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, ENOMEM), status);
@@ -620,7 +897,7 @@ TEST_F(RsaShmClientServerUnitTestSuite, FailedToCreateMsgBody) {
     struct iovec request = {.iov_base = (void*)"request", .iov_len = strlen("request")};
     struct iovec response = {.iov_base = nullptr, .iov_len = 0};
 
-    celix_ei_expect_shmPool_malloc((void*)&rsaShmClientManager_sendMsgTo, 1, nullptr);
+    celix_ei_expect_shmPool_mallocPair((void*)&rsaShmClientManager_sendMsgTo, 0, nullptr);
     status = rsaShmClientManager_sendMsgTo(clientManager, "shm_test_server", serverId, nullptr, &request, &response);
     EXPECT_EQ(CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, ENOMEM), status);
 
@@ -699,6 +976,117 @@ TEST_F(RsaShmClientServerUnitTestSuite, SendMsgWithBigResponse) {
     status = rsaShmClientManager_sendMsgTo(clientManager, "shm_test_server", serverId, nullptr, &request, &response);
     EXPECT_EQ(CELIX_SUCCESS, status);
     EXPECT_NE(nullptr, (char*)response.iov_base);
+    EXPECT_EQ(2*ESTIMATED_MSG_RESPONSE_SIZE_DEFAULT, response.iov_len);
+    free(response.iov_base);
+
+    rsa_shm_client_stats_t stats{};
+    EXPECT_EQ(CELIX_SUCCESS, rsaShmClientManager_getStats(clientManager, &stats));
+    EXPECT_EQ(1, stats.responses);
+    EXPECT_EQ(1, stats.replyBlockResponses);
+    EXPECT_EQ(0, stats.chunkedResponses);
+
+    //the consumed reply block is released while the server is idle, it does not wait for the next big response
+    for (int i = 0; i < 3000 && rsaShmServer_getNrOfReplyBlocks(server) != 0; ++i) {
+        usleep(1000);
+    }
+    EXPECT_EQ(0, rsaShmServer_getNrOfReplyBlocks(server));
+
+    //the next request has room for the response, so it does not need the reply shm of the server
+    response = {.iov_base = nullptr, .iov_len = 0};
+    status = rsaShmClientManager_sendMsgTo(clientManager, "shm_test_server", serverId, nullptr, &request, &response);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    EXPECT_EQ(2*ESTIMATED_MSG_RESPONSE_SIZE_DEFAULT, response.iov_len);
+    free(response.iov_base);
+    EXPECT_EQ(CELIX_SUCCESS, rsaShmClientManager_getStats(clientManager, &stats));
+    EXPECT_EQ(2, stats.responses);
+    EXPECT_EQ(1, stats.replyBlockResponses);
+    EXPECT_EQ(0, stats.chunkedResponses);
+
+    rsaShmClientManager_destroyOrDetachClient(clientManager, "shm_test_server", serverId);
+
+    rsaShmClientManager_destroy(clientManager);
+
+    rsaShmServer_destroy(server);
+}
+
+TEST_F(RsaShmClientServerUnitTestSuite, SendMsgWithBigResponseInChunks) {
+    auto* props = celix_properties_create();
+    celix_properties_set(props, CELIX_FRAMEWORK_CLEAN_CACHE_DIR_ON_CREATE, "true");
+    celix_properties_set(props, CELIX_FRAMEWORK_CACHE_DIR, ".rsa_shm_client_server_no_reply_pool_test_cache");
+    celix_properties_setLong(props, RSA_SHM_REPLY_POOL_SIZE_KEY, 0);
+    auto* noReplyPoolFw = celix_frameworkFactory_createFramework(props);
+    ASSERT_NE(nullptr, noReplyPoolFw);
+    auto* noReplyPoolCtx = celix_framework_getFrameworkContext(noReplyPoolFw);
+
+    //the server has no reply pool, so the big response is passed in chunks
+    rsa_shm_server_t *server = nullptr;
+    auto status = rsaShmServer_create(noReplyPoolCtx, "shm_test_server", logHelper.get(), ReceiveMsgCallbackWithBigResponse, nullptr, &server);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    EXPECT_NE(nullptr, server);
+
+    rsa_shm_client_manager_t *clientManager = nullptr;
+    status = rsaShmClientManager_create(ctx.get(), logHelper.get(), &clientManager);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    EXPECT_NE(nullptr, clientManager);
+
+    long serverId = 100;//dummy id
+    status = rsaShmClientManager_createOrAttachClient(clientManager, "shm_test_server", serverId);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+
+    struct iovec request = {.iov_base = (void*)"request", .iov_len = strlen("request")};
+    struct iovec response = {.iov_base = nullptr, .iov_len = 0};
+    status = rsaShmClientManager_sendMsgTo(clientManager, "shm_test_server", serverId, nullptr, &request, &response);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    EXPECT_EQ(2*ESTIMATED_MSG_RESPONSE_SIZE_DEFAULT, response.iov_len);
+    free(response.iov_base);
+    rsa_shm_client_stats_t stats{};
+    EXPECT_EQ(CELIX_SUCCESS, rsaShmClientManager_getStats(clientManager, &stats));
+    EXPECT_EQ(1, stats.responses);
+    EXPECT_EQ(0, stats.replyBlockResponses);
+    EXPECT_EQ(1, stats.chunkedResponses);
+
+    //the next requests have room for the response, so it is passed in a single exchange
+    for (int i = 0; i < 3; ++i) {
+        response = {.iov_base = nullptr, .iov_len = 0};
+        status = rsaShmClientManager_sendMsgTo(clientManager, "shm_test_server", serverId, nullptr, &request, &response);
+        EXPECT_EQ(CELIX_SUCCESS, status);
+        EXPECT_EQ(2*ESTIMATED_MSG_RESPONSE_SIZE_DEFAULT, response.iov_len);
+        free(response.iov_base);
+    }
+    EXPECT_EQ(CELIX_SUCCESS, rsaShmClientManager_getStats(clientManager, &stats));
+    EXPECT_EQ(4, stats.responses);
+    EXPECT_EQ(1, stats.chunkedResponses);
+
+    rsaShmClientManager_destroyOrDetachClient(clientManager, "shm_test_server", serverId);
+
+    rsaShmClientManager_destroy(clientManager);
+
+    rsaShmServer_destroy(server);
+
+    celix_frameworkFactory_destroyFramework(noReplyPoolFw);
+}
+
+TEST_F(RsaShmClientServerUnitTestSuite, SendMsgWithBigRequest) {
+    rsa_shm_server_t *server = nullptr;
+    auto status = rsaShmServer_create(ctx.get(), "shm_test_server", logHelper.get(), ReceiveMsgCallback, nullptr, &server);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    EXPECT_NE(nullptr, server);
+
+    rsa_shm_client_manager_t *clientManager = nullptr;
+    status = rsaShmClientManager_create(ctx.get(), logHelper.get(), &clientManager);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    EXPECT_NE(nullptr, clientManager);
+
+    long serverId = 100;//dummy id
+    status = rsaShmClientManager_createOrAttachClient(clientManager, "shm_test_server", serverId);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+
+    //the request does not fit in the shared memory pool, so the pool grows
+    std::vector<char> bigRequest(4*RSA_SHM_MEMORY_POOL_SIZE_DEFAULT, 'a');
+    struct iovec request = {.iov_base = bigRequest.data(), .iov_len = bigRequest.size()};
+    struct iovec response = {.iov_base = nullptr, .iov_len = 0};
+    status = rsaShmClientManager_sendMsgTo(clientManager, "shm_test_server", serverId, nullptr, &request, &response);
+    EXPECT_EQ(CELIX_SUCCESS, status);
     free(response.iov_base);
 
     rsaShmClientManager_destroyOrDetachClient(clientManager, "shm_test_server", serverId);
@@ -785,11 +1173,11 @@ TEST_F(RsaShmClientServerUnitTestSuite, ShmServerFailedToCreateShmCache) {
     EXPECT_EQ(CELIX_ENOMEM, status);
 }
 
-TEST_F(RsaShmClientServerUnitTestSuite, ShmServerFailedToCreateThpool) {
-    celix_ei_expect_thpool_init((void*)&rsaShmServer_create, 0, nullptr);
+TEST_F(RsaShmClientServerUnitTestSuite, ShmServerFailedToCreateWorkerPool) {
+    celix_ei_expect_calloc((void*)&rsaShmWorkerPool_create, 0, nullptr);
     rsa_shm_server_t *server = nullptr;
     auto status = rsaShmServer_create(ctx.get(), "shm_test_server", logHelper.get(), ReceiveMsgCallbackWithBigResponse, nullptr, &server);
-    EXPECT_EQ(CELIX_ILLEGAL_STATE, status);
+    EXPECT_EQ(CELIX_ENOMEM, status);
 }
 
 TEST_F(RsaShmClientServerUnitTestSuite, ShmServerFailedToCreateReceiveThread) {
@@ -799,7 +1187,7 @@ TEST_F(RsaShmClientServerUnitTestSuite, ShmServerFailedToCreateReceiveThread) {
     EXPECT_EQ(CELIX_ENOMEM, status);
 }
 
-TEST_F(RsaShmClientServerUnitTestSuite, ShmServerFailedToAddWorkToThpool) {
+TEST_F(RsaShmClientServerUnitTestSuite, ShmServerFailedToSubmitWork) {
     rsa_shm_server_t *server = nullptr;
     auto status = rsaShmServer_create(ctx.get(), "shm_test_server", logHelper.get(), ReceiveMsgCallback, nullptr, &server);
     EXPECT_EQ(CELIX_SUCCESS, status);
@@ -815,7 +1203,7 @@ TEST_F(RsaShmClientServerUnitTestSuite, ShmServerFailedToAddWorkToThpool) {
     EXPECT_EQ(CELIX_SUCCESS, status);
 
 
-    celix_ei_expect_thpool_add_work(CELIX_EI_UNKNOWN_CALLER, 0, -1);
+    celix_ei_expect_malloc((void*)&rsaShmWorkerPool_submit, 0, nullptr);
     struct iovec request = {.iov_base = (void*)"request", .iov_len = strlen("request")};
     struct iovec response = {.iov_base = nullptr, .iov_len = 0};
     status = rsaShmClientManager_sendMsgTo(clientManager, "shm_test_server", serverId, nullptr, &request, &response);
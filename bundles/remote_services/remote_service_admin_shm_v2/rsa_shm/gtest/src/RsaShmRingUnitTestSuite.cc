@@ -0,0 +1,121 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include "rsa_shm_ring.h"
+#include <cstdlib>
+#include <cstring>
+#include <gtest/gtest.h>
+
+class RsaShmRingUnitTestSuite : public ::testing::Test {
+public:
+    RsaShmRingUnitTestSuite() = default;
+
+    ~RsaShmRingUnitTestSuite() override {
+        free(mem);
+    }
+
+    rsa_shm_ring_t *CreateRing(uint32_t capacity) {
+        memorySize = rsaShmRing_memorySize(capacity);
+        EXPECT_EQ(0, posix_memalign(&mem, RSA_SHM_RING_ALIGNMENT, memorySize));
+        return rsaShmRing_init(mem, capacity);
+    }
+
+    static rsa_shm_msg_t CreateMsg(int shmId) {
+        rsa_shm_msg_t msg{};
+        msg.size = sizeof(msg);
+        msg.shmId = shmId;
+        msg.msgType = RSA_SHM_MSG_REQUEST;
+        msg.serviceId = -1;
+        return msg;
+    }
+
+    void *mem{nullptr};
+    size_t memorySize{0};
+};
+
+TEST_F(RsaShmRingUnitTestSuite, PushAndPop) {
+    auto ring = CreateRing(4);
+    uint32_t capacity = 0;
+    ASSERT_TRUE(rsaShmRing_isValid(ring, memorySize, &capacity));
+    EXPECT_EQ(4u, capacity);
+    EXPECT_TRUE(rsaShmRing_attachConsumer(ring));
+    EXPECT_FALSE(rsaShmRing_attachConsumer(ring));
+
+    rsa_shm_msg_t msg{};
+    EXPECT_FALSE(rsaShmRing_pop(ring, capacity, &msg));
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 4; ++i) {
+            auto pushed = CreateMsg(i);
+            EXPECT_TRUE(rsaShmRing_push(ring, 4, &pushed));
+        }
+        auto full = CreateMsg(4);
+        EXPECT_FALSE(rsaShmRing_push(ring, 4, &full));
+        for (int i = 0; i < 4; ++i) {
+            EXPECT_TRUE(rsaShmRing_pop(ring, capacity, &msg));
+            EXPECT_EQ(i, msg.shmId);
+        }
+        EXPECT_FALSE(rsaShmRing_pop(ring, capacity, &msg));
+    }
+
+    rsaShmRing_close(ring);
+    auto closed = CreateMsg(0);
+    EXPECT_FALSE(rsaShmRing_push(ring, 4, &closed));
+    rsaShmRing_detachConsumer(ring);
+    EXPECT_TRUE(rsaShmRing_waitForConsumerDetached(ring, 0));
+}
+
+TEST_F(RsaShmRingUnitTestSuite, InvalidRing) {
+    auto ring = CreateRing(4);
+    uint32_t capacity = 0;
+    EXPECT_FALSE(rsaShmRing_isValid(nullptr, memorySize, &capacity));
+    EXPECT_FALSE(rsaShmRing_isValid(ring, memorySize - 1, &capacity));
+    EXPECT_FALSE(rsaShmRing_isValid(ring, rsaShmRing_memorySize(8), &capacity));
+    EXPECT_EQ(0u, capacity);
+}
+
+TEST_F(RsaShmRingUnitTestSuite, CapacityCorruptedAfterAttach) {
+    auto ring = CreateRing(4);
+    uint32_t capacity = 0;
+    ASSERT_TRUE(rsaShmRing_isValid(ring, memorySize, &capacity));
+    ASSERT_TRUE(rsaShmRing_attachConsumer(ring));
+    rsa_shm_msg_t msg{};
+    for (int i = 0; i < 4; ++i) {
+        auto pushed = CreateMsg(i);
+        EXPECT_TRUE(rsaShmRing_push(ring, 4, &pushed));
+        EXPECT_TRUE(rsaShmRing_pop(ring, capacity, &msg));
+    }
+
+    //The peer overwrites the shared capacity, which follows the size field of the ring
+    uint32_t corruptedCapacity = RSA_SHM_RING_MAX_CAPACITY;
+    memcpy(static_cast<char*>(mem) + sizeof(size_t), &corruptedCapacity, sizeof(corruptedCapacity));
+
+    //The consumer keeps using the validated capacity, so it stays within the ring memory
+    for (int i = 0; i < 4; ++i) {
+        auto pushed = CreateMsg(i);
+        EXPECT_TRUE(rsaShmRing_push(ring, 4, &pushed));
+    }
+    rsa_shm_spin_t spin;
+    rsaShmSpin_init(&spin);
+    rsaShmRing_waitForMsg(ring, capacity, &spin, 0);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(rsaShmRing_pop(ring, capacity, &msg));
+        EXPECT_EQ(i, msg.shmId);
+    }
+    EXPECT_FALSE(rsaShmRing_pop(ring, capacity, &msg));
+    rsaShmRing_detachConsumer(ring);
+}
@@ -19,6 +19,7 @@
 
 #ifndef CELIX_RSASHMTESTSERVICE_H
 #define CELIX_RSASHMTESTSERVICE_H
+#include <stdint.h>
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -29,16 +30,27 @@ extern "C" {
 
 typedef struct rsa_shm_calc_service rsa_shm_calc_service_t;
 
+/*
+ * A sequence of doubles, the C type of the descriptor type [D.
+ */
+struct rsa_shm_calc_sequence {
+    uint32_t cap;
+    uint32_t len;
+    double *buf;
+};
+
 /*
  * The calculator service definition corresponds to the following Java interface:
  *
  * interface Calculator {
  *      double add(double a, double b);
+ *      double sum(double[] values);
  * }
  */
 struct rsa_shm_calc_service {
     void *handle;
     int (*add)(void *handle, double a, double b, double *result);
+    int (*sum)(void *handle, struct rsa_shm_calc_sequence values, double *result);
 };
 
 #ifdef __cplusplus
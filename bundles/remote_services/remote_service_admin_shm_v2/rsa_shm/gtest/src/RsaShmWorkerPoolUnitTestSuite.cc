@@ -0,0 +1,257 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include "rsa_shm_worker_pool.h"
+#include "malloc_ei.h"
+#include "celix_threads_ei.h"
+#include "celix_long_hash_map_ei.h"
+#include "celix_errno.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include <gtest/gtest.h>
+
+class RsaShmWorkerPoolUnitTestSuite : public ::testing::Test {
+public:
+    RsaShmWorkerPoolUnitTestSuite() = default;
+
+    ~RsaShmWorkerPoolUnitTestSuite() override {
+        //reset error injection
+        celix_ei_expect_calloc(nullptr, 0, nullptr);
+        celix_ei_expect_malloc(nullptr, 0, nullptr);
+        celix_ei_expect_celixThreadMutex_create(nullptr, 0, 0);
+        celix_ei_expect_celixThreadCondition_init(nullptr, 0, 0);
+        celix_ei_expect_celixThread_create(nullptr, 0, 0);
+        celix_ei_expect_celix_longHashMap_create(nullptr, 0, nullptr);
+        celix_ei_expect_celix_longHashMap_put(nullptr, 0, 0);
+    }
+};
+
+struct KeyedJobsCounter {
+    std::atomic<int> running{0};
+    std::atomic<int> maxRunning{0};
+    std::atomic<int> finished{0};
+};
+
+static void CountJob(void *data) {
+    auto *counter = static_cast<std::atomic<int>*>(data);
+    (*counter)++;
+}
+
+static void CountKeyedJob(void *data) {
+    auto *counter = static_cast<KeyedJobsCounter*>(data);
+    int running = ++counter->running;
+    int maxRunning = counter->maxRunning.load();
+    while (running > maxRunning && !counter->maxRunning.compare_exchange_weak(maxRunning, running)) {
+    }
+    usleep(1000);
+    counter->running--;
+    counter->finished++;
+}
+
+TEST_F(RsaShmWorkerPoolUnitTestSuite, CreateWithInvalidParams) {
+    rsa_shm_worker_pool_t *pool = nullptr;
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, rsaShmWorkerPool_create(0, 0, &pool));
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, rsaShmWorkerPool_create(RSA_SHM_WORKER_POOL_MAX_WORKERS + 1, 0, &pool));
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, rsaShmWorkerPool_create(1, 0, nullptr));
+    EXPECT_EQ(nullptr, pool);
+}
+
+TEST_F(RsaShmWorkerPoolUnitTestSuite, SubmitWithInvalidParams) {
+    rsa_shm_worker_pool_t *pool = nullptr;
+    ASSERT_EQ(CELIX_SUCCESS, rsaShmWorkerPool_create(1, 0, &pool));
+    std::atomic<int> counter{0};
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, rsaShmWorkerPool_submit(nullptr, -1, CountJob, &counter));
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, rsaShmWorkerPool_submit(pool, -1, nullptr, &counter));
+    rsaShmWorkerPool_destroy(pool);
+    EXPECT_EQ(0, counter);
+}
+
+TEST_F(RsaShmWorkerPoolUnitTestSuite, RunJobsOfMultipleSubmitters) {
+    rsa_shm_worker_pool_t *pool = nullptr;
+    ASSERT_EQ(CELIX_SUCCESS, rsaShmWorkerPool_create(4, 0, &pool));
+    std::atomic<int> counter{0};
+    std::vector<std::thread> submitters;
+    for (int i = 0; i < 4; ++i) {
+        submitters.emplace_back([pool, &counter]() {
+            for (int j = 0; j < 10000; ++j) {
+                EXPECT_EQ(CELIX_SUCCESS, rsaShmWorkerPool_submit(pool, -1, CountJob, &counter));
+            }
+        });
+    }
+    for (auto &submitter : submitters) {
+        submitter.join();
+    }
+    //destroy finishes the submitted jobs
+    rsaShmWorkerPool_destroy(pool);
+    EXPECT_EQ(40000, counter);
+}
+
+TEST_F(RsaShmWorkerPoolUnitTestSuite, RunJobsAfterWorkersWereIdle) {
+    rsa_shm_worker_pool_t *pool = nullptr;
+    ASSERT_EQ(CELIX_SUCCESS, rsaShmWorkerPool_create(2, 0, &pool));
+    std::atomic<int> counter{0};
+    for (int i = 1; i <= 10; ++i) {
+        EXPECT_EQ(CELIX_SUCCESS, rsaShmWorkerPool_submit(pool, -1, CountJob, &counter));
+        //a sleeping worker is woken up for a single job
+        for (int j = 0; j < 1000 && counter < i; ++j) {
+            usleep(1000);
+        }
+        EXPECT_EQ(i, counter);
+    }
+    rsaShmWorkerPool_destroy(pool);
+}
+
+TEST_F(RsaShmWorkerPoolUnitTestSuite, SubmitWhileDestroying) {
+    rsa_shm_worker_pool_t *pool = nullptr;
+    ASSERT_EQ(CELIX_SUCCESS, rsaShmWorkerPool_create(1, 0, &pool));
+    struct SubmittingJobData {
+        rsa_shm_worker_pool_t *pool;
+        std::atomic<int> counter{0};
+        celix_status_t status{CELIX_SUCCESS};
+    } data;
+    data.pool = pool;
+    EXPECT_EQ(CELIX_SUCCESS, rsaShmWorkerPool_submit(pool, -1, [](void *d) {
+        auto *data = static_cast<SubmittingJobData*>(d);
+        usleep(100000);//the pool is destroyed in the meantime
+        data->status = rsaShmWorkerPool_submit(data->pool, -1, CountJob, &data->counter);
+    }, &data));
+    rsaShmWorkerPool_destroy(pool);
+    EXPECT_EQ(CELIX_ILLEGAL_STATE, data.status);
+    EXPECT_EQ(0, data.counter);
+}
+
+TEST_F(RsaShmWorkerPoolUnitTestSuite, LimitConcurrentJobsPerKey) {
+    rsa_shm_worker_pool_t *pool = nullptr;
+    ASSERT_EQ(CELIX_SUCCESS, rsaShmWorkerPool_create(4, 2, &pool));
+    KeyedJobsCounter key1Counter;
+    KeyedJobsCounter unlimitedCounter;
+    for (int i = 0; i < 50; ++i) {
+        EXPECT_EQ(CELIX_SUCCESS, rsaShmWorkerPool_submit(pool, 1, CountKeyedJob, &key1Counter));
+        EXPECT_EQ(CELIX_SUCCESS, rsaShmWorkerPool_submit(pool, -1, CountKeyedJob, &unlimitedCounter));
+    }
+    rsaShmWorkerPool_destroy(pool);
+    EXPECT_EQ(50, key1Counter.finished);
+    EXPECT_LE(key1Counter.maxRunning, 2);
+    EXPECT_EQ(50, unlimitedCounter.finished);
+}
+
+TEST_F(RsaShmWorkerPoolUnitTestSuite, JobsOfKeyAreNotQueuedBehindJobsOfOtherKey) {
+    rsa_shm_worker_pool_t *pool = nullptr;
+    ASSERT_EQ(CELIX_SUCCESS, rsaShmWorkerPool_create(2, 1, &pool));
+    KeyedJobsCounter key1Counter;
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(CELIX_SUCCESS, rsaShmWorkerPool_submit(pool, 1, CountKeyedJob, &key1Counter));
+    }
+    //key 1 occupies a single worker, so the job of key 2 runs on the other worker
+    std::atomic<int> key2Counter{0};
+    EXPECT_EQ(CELIX_SUCCESS, rsaShmWorkerPool_submit(pool, 2, CountJob, &key2Counter));
+    for (int i = 0; i < 1000 && key2Counter == 0; ++i) {
+        usleep(1000);
+    }
+    EXPECT_EQ(1, key2Counter);
+    EXPECT_LT(key1Counter.finished, 100);
+    rsaShmWorkerPool_destroy(pool);
+    EXPECT_EQ(100, key1Counter.finished);
+    EXPECT_EQ(1, key1Counter.maxRunning);
+}
+
+TEST_F(RsaShmWorkerPoolUnitTestSuite, FailedToAllocatePool) {
+    rsa_shm_worker_pool_t *pool = nullptr;
+    celix_ei_expect_calloc((void*)&rsaShmWorkerPool_create, 0, nullptr);
+    EXPECT_EQ(CELIX_ENOMEM, rsaShmWorkerPool_create(2, 0, &pool));
+    EXPECT_EQ(nullptr, pool);
+}
+
+TEST_F(RsaShmWorkerPoolUnitTestSuite, FailedToCreatePoolMutex) {
+    rsa_shm_worker_pool_t *pool = nullptr;
+    celix_ei_expect_celixThreadMutex_create((void*)&rsaShmWorkerPool_create, 0, CELIX_ENOMEM);
+    EXPECT_EQ(CELIX_ENOMEM, rsaShmWorkerPool_create(2, 0, &pool));
+    EXPECT_EQ(nullptr, pool);
+}
+
+TEST_F(RsaShmWorkerPoolUnitTestSuite, FailedToCreatePoolCondition) {
+    rsa_shm_worker_pool_t *pool = nullptr;
+    celix_ei_expect_celixThreadCondition_init((void*)&rsaShmWorkerPool_create, 0, CELIX_ENOMEM);
+    EXPECT_EQ(CELIX_ENOMEM, rsaShmWorkerPool_create(2, 0, &pool));
+    EXPECT_EQ(nullptr, pool);
+}
+
+TEST_F(RsaShmWorkerPoolUnitTestSuite, FailedToCreateKeyEntries) {
+    rsa_shm_worker_pool_t *pool = nullptr;
+    celix_ei_expect_celix_longHashMap_create((void*)&rsaShmWorkerPool_create, 0, nullptr);
+    EXPECT_EQ(CELIX_ENOMEM, rsaShmWorkerPool_create(2, 0, &pool));
+    EXPECT_EQ(nullptr, pool);
+}
+
+TEST_F(RsaShmWorkerPoolUnitTestSuite, FailedToAllocateWorker) {
+    rsa_shm_worker_pool_t *pool = nullptr;
+    celix_ei_expect_calloc((void*)&rsaShmWorkerPool_create, 1, nullptr, 2);
+    EXPECT_EQ(CELIX_ENOMEM, rsaShmWorkerPool_create(2, 0, &pool));
+    EXPECT_EQ(nullptr, pool);
+}
+
+TEST_F(RsaShmWorkerPoolUnitTestSuite, FailedToCreateWorkerMutex) {
+    rsa_shm_worker_pool_t *pool = nullptr;
+    celix_ei_expect_celixThreadMutex_create((void*)&rsaShmWorkerPool_create, 1, CELIX_ENOMEM, 2);
+    EXPECT_EQ(CELIX_ENOMEM, rsaShmWorkerPool_create(2, 0, &pool));
+    EXPECT_EQ(nullptr, pool);
+}
+
+TEST_F(RsaShmWorkerPoolUnitTestSuite, FailedToCreateWorkerCondition) {
+    rsa_shm_worker_pool_t *pool = nullptr;
+    celix_ei_expect_celixThreadCondition_init((void*)&rsaShmWorkerPool_create, 1, CELIX_ENOMEM, 2);
+    EXPECT_EQ(CELIX_ENOMEM, rsaShmWorkerPool_create(2, 0, &pool));
+    EXPECT_EQ(nullptr, pool);
+}
+
+TEST_F(RsaShmWorkerPoolUnitTestSuite, FailedToCreateWorkerThread) {
+    rsa_shm_worker_pool_t *pool = nullptr;
+    //the first worker is started already, and must be stopped
+    celix_ei_expect_celixThread_create((void*)&rsaShmWorkerPool_create, 1, CELIX_ENOMEM, 2);
+    EXPECT_EQ(CELIX_ENOMEM, rsaShmWorkerPool_create(2, 0, &pool));
+    EXPECT_EQ(nullptr, pool);
+}
+
+TEST_F(RsaShmWorkerPoolUnitTestSuite, FailedToAllocateJob) {
+    rsa_shm_worker_pool_t *pool = nullptr;
+    ASSERT_EQ(CELIX_SUCCESS, rsaShmWorkerPool_create(1, 1, &pool));
+    std::atomic<int> counter{0};
+    celix_ei_expect_malloc((void*)&rsaShmWorkerPool_submit, 0, nullptr);
+    EXPECT_EQ(CELIX_ENOMEM, rsaShmWorkerPool_submit(pool, -1, CountJob, &counter));
+    rsaShmWorkerPool_destroy(pool);
+    EXPECT_EQ(0, counter);
+}
+
+TEST_F(RsaShmWorkerPoolUnitTestSuite, FailedToAllocateKeyEntry) {
+    rsa_shm_worker_pool_t *pool = nullptr;
+    ASSERT_EQ(CELIX_SUCCESS, rsaShmWorkerPool_create(1, 1, &pool));
+    std::atomic<int> counter{0};
+    celix_ei_expect_calloc((void*)&rsaShmWorkerPool_submit, 1, nullptr);
+    EXPECT_EQ(CELIX_ENOMEM, rsaShmWorkerPool_submit(pool, 1, CountJob, &counter));
+
+    celix_ei_expect_celix_longHashMap_put((void*)&rsaShmWorkerPool_submit, 1, CELIX_ENOMEM);
+    EXPECT_EQ(CELIX_ENOMEM, rsaShmWorkerPool_submit(pool, 1, CountJob, &counter));
+
+    //jobs without key are not limited
+    celix_ei_expect_calloc((void*)&rsaShmWorkerPool_submit, 1, nullptr);
+    EXPECT_EQ(CELIX_SUCCESS, rsaShmWorkerPool_submit(pool, -1, CountJob, &counter));
+    rsaShmWorkerPool_destroy(pool);
+    EXPECT_EQ(1, counter);
+}
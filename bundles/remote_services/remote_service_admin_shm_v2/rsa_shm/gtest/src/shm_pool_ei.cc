@@ -26,4 +26,11 @@ void* __wrap_shmPool_malloc(struct shm_pool* pool, size_t size) {
     return __real_shmPool_malloc(pool, size);
 }
 
+void* __real_shmPool_mallocPair(struct shm_pool* pool, size_t size, size_t pairedSize, void** paired);
+CELIX_EI_DEFINE(shmPool_mallocPair, void*)
+void* __wrap_shmPool_mallocPair(struct shm_pool* pool, size_t size, size_t pairedSize, void** paired) {
+    CELIX_EI_IMPL(shmPool_mallocPair);
+    return __real_shmPool_mallocPair(pool, size, pairedSize, paired);
+}
+
 }
@@ -26,6 +26,8 @@ extern "C" {
 
 CELIX_EI_DECLARE(shmPool_malloc, void*);
 
+CELIX_EI_DECLARE(shmPool_mallocPair, void*);
+
 #ifdef __cplusplus
 }
 #endif
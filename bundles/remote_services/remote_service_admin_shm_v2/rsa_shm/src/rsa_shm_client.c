@@ -19,9 +19,12 @@
 
 #include "rsa_shm_client.h"
 #include "rsa_shm_msg.h"
+#include "rsa_shm_ring.h"
 #include "rsa_shm_constants.h"
+#include "remote_constants.h"
 #include "celix_log_helper.h"
 #include "shm_pool.h"
+#include "shm_cache.h"
 #include "celix_long_hash_map.h"
 #include "celix_stdlib_cleanup.h"
 #include "celix_string_hash_map.h"
@@ -39,13 +42,21 @@
 #include <string.h>
 #include <errno.h>
 
+//The time to wait for the server to stop using the request ring, when the client is destroyed
+#define RSA_SHM_REQUEST_RING_DETACH_TIMEOUT_IN_MS 1000
+//The number of recent response sizes of a service, from which the size of its responses is estimated
+#define RSA_SHM_RESPONSE_SIZE_HISTORY 32
+//The percentile of the recent response sizes of a service, that is used as the estimated size of its responses
+#define RSA_SHM_RESPONSE_SIZE_PERCENTILE 90
 
 struct rsa_shm_client_manager {
     celix_bundle_context_t *ctx;
     celix_log_helper_t *logHelper;
     long msgTimeOutInSec;
     long maxConcurrentNum;
+    uint32_t requestRingCapacity;//0 if request rings are not used
     shm_pool_t *shmPool;
+    shm_cache_t *replyCache;//Attaches the shared memory of servers, in which servers place large replies
     celix_thread_mutex_t clientsMutex;
     celix_string_hash_map_t *clients;// Key: peer server name; value: client instance
     celix_thread_mutex_t exceptionMsgListMutex;
@@ -53,13 +64,33 @@ struct rsa_shm_client_manager {
     celix_array_list_t *exceptionMsgList;
     celix_thread_t msgExceptionHandlerThread;
     bool threadActive;
+    //The response statistics, updated atomically
+    size_t responses;
+    size_t replyBlockResponses;
+    size_t chunkedResponses;
 };
 
+/**
+ * The encoded metadata of a service, shared by the calls that use it.
+ * It is immutable, except for its reference count.
+ */
+typedef struct rsa_shm_encoded_metadata {
+    unsigned int refCnt;
+    celix_properties_t *metadata;//The metadata that is encoded, NULL if it is empty
+    char *encoded;//The metadata with the service id, encoded including the terminating null byte ('\0')
+    size_t encodedSize;
+} rsa_shm_encoded_metadata_t;
+
 struct service_diagnostic_info {
     unsigned int refCnt;
     int concurrentInvocations;
     int failures;
     struct timespec lastInvokedTime;
+    rsa_shm_encoded_metadata_t *lastEncodedMetadata;//Reused by the calls of the service as long as the metadata does not change
+    size_t responseSizes[RSA_SHM_RESPONSE_SIZE_HISTORY];//The sizes of the recent responses, used as a ring buffer
+    unsigned int nrOfResponseSizes;
+    unsigned int nextResponseSize;//The index in responseSizes of the next response size
+    size_t estimatedResponseSize;//The room for a response in the shared memory of a request
 };
 
 typedef struct rsa_shm_client {
@@ -70,6 +101,9 @@ typedef struct rsa_shm_client {
     char *peerServerName;
     int cfd;
     struct sockaddr_un serverAddr;
+    void *requestRingMem;
+    rsa_shm_ring_t *requestRing;//NULL if requests are sent using the socket only
+    rsa_shm_spin_t replySpin;
 }rsa_shm_client_t;
 
 typedef struct rsa_shm_exception_msg {
@@ -85,7 +119,7 @@ typedef struct rsa_shm_msg_control_alloc {
 } rsa_shm_msg_control_alloc_t;
 
 static celix_status_t rsaShmClientManager_createMsgControl(rsa_shm_client_manager_t *clientManager,
-        rsa_shm_msg_control_alloc_t* alloc);
+        void *msgCtrlMem, rsa_shm_msg_control_alloc_t* alloc);
 static void rsaShmClientManager_destroyMsgControl(rsa_shm_msg_control_alloc_t* alloc);
 
 CELIX_DEFINE_AUTO_CLEANUP_CLEAR_FUNC(rsa_shm_msg_control_alloc_t, rsaShmClientManager_destroyMsgControl)
@@ -100,16 +134,34 @@ static void rsaShmClientManager_ungetClient(rsa_shm_client_t *client);
 
 CELIX_DEFINE_AUTOPTR_CLEANUP_FUNC(rsa_shm_client_t, rsaShmClientManager_ungetClient)
 
+static void rsaShmClientManager_logPoolStats(rsa_shm_client_manager_t *clientManager, celix_log_level_e level);
 static void rsaShmClientManager_markSvcCallFailed(rsa_shm_client_manager_t *clientManager,
         const char *peerServerName, long serviceId);
 static void rsaShmClientManager_markSvcCallFinished(rsa_shm_client_manager_t *clientManager,
         const char *peerServerName, long serviceId);
 static celix_status_t rsaShmClientManager_receiveResponse(rsa_shm_client_manager_t *clientManager,
-        rsa_shm_msg_control_t *msgCtrl, char *msgBuffer, size_t bufSize,
+        rsa_shm_msg_control_t *msgCtrl, char *msgBuffer, size_t bufSize, rsa_shm_spin_t *replySpin,
         struct iovec *response, bool *replied);
+static celix_status_t rsaShmClientManager_consumeReplyBlock(rsa_shm_client_manager_t *clientManager,
+        rsa_shm_msg_control_t *msgCtrl, char **reply);
+static void rsaShmClient_setupRequestRing(rsa_shm_client_t *client);
+static void rsaShmClient_teardownRequestRing(rsa_shm_client_t *client);
 static void rsaShmClient_destroyOrDetachSvcDiagInfo(rsa_shm_client_t *client, long serviceId);
+static rsa_shm_encoded_metadata_t *rsaShmClient_getEncodedMetadata(rsa_shm_client_t *client, long serviceId,
+        const celix_properties_t *metadata);
+static celix_status_t rsaShmClientManager_encodeMetadata(rsa_shm_client_manager_t *clientManager, long serviceId,
+        const celix_properties_t *metadata, rsa_shm_encoded_metadata_t **encodedMetadataOut);
+static void rsaShmClient_setEncodedMetadata(rsa_shm_client_t *client, long serviceId,
+        rsa_shm_encoded_metadata_t *encodedMetadata);
+static void rsaShmClient_releaseEncodedMetadata(rsa_shm_encoded_metadata_t *encodedMetadata);
+
+CELIX_DEFINE_AUTOPTR_CLEANUP_FUNC(rsa_shm_encoded_metadata_t, rsaShmClient_releaseEncodedMetadata)
 static void rsaShmClient_createOrAttachSvcDiagInfo(rsa_shm_client_t *client, long serviceId);
 static bool rsaShmClient_shouldBreakInvocation(rsa_shm_client_t *client, long serviceId);
+static size_t rsaShmClient_getEstimatedResponseSize(rsa_shm_client_t *client, long serviceId);
+static void rsaShmClient_addResponseSize(rsa_shm_client_t *client, long serviceId, size_t responseSize);
+static void rsaShmClientManager_addResponse(rsa_shm_client_manager_t *clientManager, rsa_shm_client_t *client,
+        long serviceId, const rsa_shm_msg_control_t *msgCtrl, size_t msgBodySize, size_t responseSize);
 
 celix_status_t rsaShmClientManager_create(celix_bundle_context_t *ctx,
         celix_log_helper_t *loghelper, rsa_shm_client_manager_t **clientManagerOut) {
@@ -124,16 +176,38 @@ celix_status_t rsaShmClientManager_create(celix_bundle_context_t *ctx,
 
     clientManager->ctx = ctx;
     clientManager->logHelper = loghelper;
+    clientManager->responses = 0;
+    clientManager->replyBlockResponses = 0;
+    clientManager->chunkedResponses = 0;
     clientManager->maxConcurrentNum = celix_bundleContext_getPropertyAsLong(ctx,
             RSA_SHM_MAX_CONCURRENT_INVOCATIONS_KEY, RSA_SHM_MAX_CONCURRENT_INVOCATIONS_DEFAULT);
     clientManager->msgTimeOutInSec = celix_bundleContext_getPropertyAsLong(ctx,
             RSA_SHM_MSG_TIMEOUT_KEY, RSA_SHM_MSG_TIMEOUT_DEFAULT_IN_S);
+    long requestRingCapacity = celix_bundleContext_getPropertyAsLong(ctx, RSA_SHM_REQUEST_RING_CAPACITY_KEY,
+            RSA_SHM_REQUEST_RING_CAPACITY_DEFAULT);
+    if (requestRingCapacity > RSA_SHM_RING_MAX_CAPACITY) {
+        requestRingCapacity = RSA_SHM_RING_MAX_CAPACITY;
+    }
+    //The ring capacity is rounded up to a power of two. 0 or less disables request rings.
+    clientManager->requestRingCapacity = 0;
+    if (requestRingCapacity > 0) {
+        clientManager->requestRingCapacity = 1;
+        while (clientManager->requestRingCapacity < requestRingCapacity) {
+            clientManager->requestRingCapacity <<= 1;
+        }
+    }
 
-    long shmPoolSize = celix_bundleContext_getPropertyAsLong(ctx, RSA_SHM_MEMORY_POOL_SIZE_KEY,
-            RSA_SHM_MEMORY_POOL_SIZE_DEFAULT);
+    shm_pool_options_t shmPoolOptions = {
+            .size = celix_bundleContext_getPropertyAsLong(ctx, RSA_SHM_MEMORY_POOL_SIZE_KEY,
+                    RSA_SHM_MEMORY_POOL_SIZE_DEFAULT),
+            .maxSize = celix_bundleContext_getPropertyAsLong(ctx, RSA_SHM_MEMORY_POOL_MAX_SIZE_KEY,
+                    RSA_SHM_MEMORY_POOL_MAX_SIZE_DEFAULT),
+            .hugePages = celix_bundleContext_getPropertyAsBool(ctx, RSA_SHM_MEMORY_POOL_HUGE_PAGES_KEY,
+                    RSA_SHM_MEMORY_POOL_HUGE_PAGES_DEFAULT),
+    };
 
     celix_autoptr(shm_pool_t) shmPool = NULL;
-    status = shmPool_create(shmPoolSize, &shmPool);
+    status = shmPool_createWithOptions(&shmPoolOptions, &shmPool);
     if (status != CELIX_SUCCESS) {
         celix_logHelper_logTssErrors(loghelper, CELIX_LOG_LEVEL_ERROR);
         celix_logHelper_error(loghelper, "RsaShmClient: Error Creating shared memory shmPool.");
@@ -141,6 +215,15 @@ celix_status_t rsaShmClientManager_create(celix_bundle_context_t *ctx,
     }
     clientManager->shmPool = shmPool;
 
+    celix_autoptr(shm_cache_t) replyCache = NULL;
+    status = shmCache_create(false, &replyCache);
+    if (status != CELIX_SUCCESS) {
+        celix_logHelper_logTssErrors(loghelper, CELIX_LOG_LEVEL_ERROR);
+        celix_logHelper_error(loghelper, "RsaShmClient: Error creating reply shm cache.");
+        return status;
+    }
+    clientManager->replyCache = replyCache;
+
     status = celixThreadMutex_create(&clientManager->clientsMutex, NULL);
     if (status != CELIX_SUCCESS) {
         celix_logHelper_error(loghelper, "RsaShmClient: Error creating clients mutex.");
@@ -179,6 +262,7 @@ celix_status_t rsaShmClientManager_create(celix_bundle_context_t *ctx,
     celix_steal_ptr(exceptionMsgListMutex);
     celix_steal_ptr(clients);
     celix_steal_ptr(clientsMutex);
+    celix_steal_ptr(replyCache);
     celix_steal_ptr(shmPool);
     *clientManagerOut = celix_steal_ptr(clientManager);
     return CELIX_SUCCESS;
@@ -204,11 +288,36 @@ void rsaShmClientManager_destroy(rsa_shm_client_manager_t *clientManager) {
     assert(celix_stringHashMap_size(clientManager->clients) == 0);
     celix_stringHashMap_destroy(clientManager->clients);
     (void)celixThreadMutex_destroy(&clientManager->clientsMutex);
+    shmCache_destroy(clientManager->replyCache);
+    rsaShmClientManager_logPoolStats(clientManager, CELIX_LOG_LEVEL_DEBUG);
+    celix_logHelper_debug(clientManager->logHelper,
+            "RsaShmClient: %zu responses, %zu passed in reply shm of servers, %zu passed in chunks.",
+            clientManager->responses, clientManager->replyBlockResponses, clientManager->chunkedResponses);
     shmPool_destroy(clientManager->shmPool);
     free(clientManager);
     return;
 }
 
+static void rsaShmClientManager_logPoolStats(rsa_shm_client_manager_t *clientManager, celix_log_level_e level) {
+    shm_pool_stats_t stats;
+    if (shmPool_getStats(clientManager->shmPool, &stats) == CELIX_SUCCESS) {
+        celix_logHelper_log(clientManager->logHelper, level,
+                "RsaShmClient: Shm pool size %zu of max %zu bytes in %u segments(%u of huge pages), used %zu bytes, "
+                "peak used %zu bytes, %zu failed allocations.", stats.size, stats.maxSize, stats.segments,
+                stats.hugePageSegments, stats.usedSize, stats.peakUsedSize, stats.failedAllocations);
+    }
+}
+
+celix_status_t rsaShmClientManager_getStats(rsa_shm_client_manager_t *clientManager, rsa_shm_client_stats_t *stats) {
+    if (clientManager == NULL || stats == NULL) {
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    stats->responses = __atomic_load_n(&clientManager->responses, __ATOMIC_RELAXED);
+    stats->replyBlockResponses = __atomic_load_n(&clientManager->replyBlockResponses, __ATOMIC_RELAXED);
+    stats->chunkedResponses = __atomic_load_n(&clientManager->chunkedResponses, __ATOMIC_RELAXED);
+    return CELIX_SUCCESS;
+}
+
 
 celix_status_t rsaShmClientManager_createOrAttachClient(rsa_shm_client_manager_t *clientManager,
         const char *peerServerName, long serviceId) {
@@ -252,14 +361,12 @@ void rsaShmClientManager_destroyOrDetachClient(rsa_shm_client_manager_t *clientM
 celix_status_t rsaShmClientManager_sendMsgTo(rsa_shm_client_manager_t *clientManager,
         const char *peerServerName, long serviceId, celix_properties_t *metadata,
         const struct iovec *request, struct iovec *response) {
-    celix_status_t status = CELIX_SUCCESS;
     if (clientManager == NULL || peerServerName == NULL || strlen(peerServerName) >= MAX_RSA_SHM_SERVER_NAME_SIZE
             || request == NULL || request->iov_base == NULL || request->iov_len == 0
             || response == NULL) {
         return CELIX_ILLEGAL_ARGUMENT;
     }
-    size_t metadataStringSize = 0;
-    FILE *fp = NULL;
+    celix_status_t status = CELIX_SUCCESS;
     rsa_shm_msg_control_t *msgCtrl = NULL;
 
     celix_autoptr(rsa_shm_client_t) client = rsaShmClientManager_getClient(clientManager, peerServerName);
@@ -272,58 +379,55 @@ celix_status_t rsaShmClientManager_sendMsgTo(rsa_shm_client_manager_t *clientMan
         return CELIX_ILLEGAL_STATE;
     }
 
-    celix_autofree char* metadataString = NULL;
-    fp = open_memstream(&metadataString, &metadataStringSize);
-    if (fp == NULL) {
-        celix_logHelper_error(clientManager->logHelper, "RsaShmClient: Error opening metadata memory. %d.", errno);
-        return CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, errno);
-    }
-    if (metadata != NULL) {
-        status = celix_properties_saveToStream(metadata, fp, 0);
+    celix_autoptr(rsa_shm_encoded_metadata_t) encodedMetadata = rsaShmClient_getEncodedMetadata(client, serviceId, metadata);
+    if (encodedMetadata == NULL) {
+        status = rsaShmClientManager_encodeMetadata(clientManager, serviceId, metadata, &encodedMetadata);
         if (status != CELIX_SUCCESS) {
-            fclose(fp);
-            celix_logHelper_error(
-                clientManager->logHelper, "RsaShmClient: Error encoding metadata to memory stream. %d.", status);
-            celix_logHelper_logTssErrors(clientManager->logHelper, CELIX_LOG_LEVEL_ERROR);
             return status;
         }
+        rsaShmClient_setEncodedMetadata(client, serviceId, encodedMetadata);
     }
-    fclose(fp);
-    // make the metadata include the terminating null byte ('\0')
-    size_t metadataSize = (metadataStringSize == 0) ? 0 : metadataStringSize +1;
-    size_t msgBodySize = MAX((metadataSize + request->iov_len), ESTIMATED_MSG_RESPONSE_SIZE_DEFAULT);
+    size_t metadataSize = (encodedMetadata->encodedSize + RSA_SHM_MSG_REQUEST_ALIGNMENT - 1)
+            / RSA_SHM_MSG_REQUEST_ALIGNMENT * RSA_SHM_MSG_REQUEST_ALIGNMENT;
+    //The response reuses the message body, so that it normally fits in it as well
+    size_t msgBodySize = MAX((metadataSize + request->iov_len), rsaShmClient_getEstimatedResponseSize(client, serviceId));
 
+    //The message control and body are passed using a single shared memory id, so they must be in the same segment.
+    void *msgCtrlMem = NULL;
+    celix_auto(celix_shm_pool_alloc_guard_t) msgBodyAlloc = celix_shmPoolAllocGuard_init(
+        shmPool_mallocPair(clientManager->shmPool, msgBodySize, sizeof(rsa_shm_msg_control_t), &msgCtrlMem),
+        clientManager->shmPool);
+    char *msgBody = (char *)msgBodyAlloc.ptr;
+    if (msgBody == NULL) {
+        rsaShmClientManager_logPoolStats(clientManager, CELIX_LOG_LEVEL_ERROR);
+        celix_logHelper_error(clientManager->logHelper, "RsaShmClient: Error allocing msg buffer.");
+        return CELIX_ENOMEM;
+    }
     celix_auto(rsa_shm_msg_control_alloc_t) msgCtrlAlloc = {
             .ctrl = NULL,
             .clientManager = clientManager,
     };
-    status = rsaShmClientManager_createMsgControl(clientManager, &msgCtrlAlloc);
+    status = rsaShmClientManager_createMsgControl(clientManager, msgCtrlMem, &msgCtrlAlloc);
     if (status != CELIX_SUCCESS) {
         celix_logHelper_error(clientManager->logHelper, "RsaShmClient: Error creating msg control. %d.", status);
         return status;
     }
     msgCtrl = (rsa_shm_msg_control_t*)msgCtrlAlloc.ctrl;
-    celix_auto(celix_shm_pool_alloc_guard_t) msgBodyAlloc =
-        celix_shmPoolAllocGuard_init(shmPool_malloc(clientManager->shmPool, msgBodySize), clientManager->shmPool);
-    char *msgBody = (char *)msgBodyAlloc.ptr;
-    if (msgBody == NULL) {
-        celix_logHelper_error(clientManager->logHelper, "RsaShmClient: Error allocing msg buffer.");
-        return CELIX_ENOMEM;
-    }
-    if (metadataSize != 0) {
-        memcpy(msgBody, metadataString, metadataSize);
-    }
+    memcpy(msgBody, encodedMetadata->encoded, encodedMetadata->encodedSize);
+    memset(msgBody + encodedMetadata->encodedSize, 0, metadataSize - encodedMetadata->encodedSize);
     memcpy(msgBody + metadataSize, request->iov_base,request->iov_len);
 
     rsa_shm_msg_t msgInfo = {
             .size = sizeof(rsa_shm_msg_t),
-            .shmId = shmPool_getShmId(clientManager->shmPool),
+            .shmId = shmPool_getMemoryShmId(clientManager->shmPool, msgBody),
             .ctrlDataOffset = shmPool_getMemoryOffset(clientManager->shmPool, msgCtrl),
             .ctrlDataSize = sizeof(rsa_shm_msg_control_t),
             .msgBodyOffset = shmPool_getMemoryOffset(clientManager->shmPool, msgBody),
             .msgBodyTotalSize = msgBodySize,
             .metadataSize = metadataSize,
             .requestSize = request->iov_len,
+            .msgType = RSA_SHM_MSG_REQUEST,
+            .serviceId = serviceId,
     };
     //LCOV_EXCL_START
     if (msgInfo.shmId < 0 || msgInfo.ctrlDataOffset < 0 || msgInfo.msgBodyOffset < 0) {
@@ -332,7 +436,9 @@ celix_status_t rsaShmClientManager_sendMsgTo(rsa_shm_client_manager_t *clientMan
         return CELIX_ILLEGAL_ARGUMENT;
     }
     //LCOV_EXCL_STOP
-    while(1) {
+    bool sentByRing = client->requestRing != NULL && rsaShmRing_isConsumerAttached(client->requestRing)
+            && rsaShmRing_push(client->requestRing, client->manager->requestRingCapacity, &msgInfo);
+    while (!sentByRing) {
         if (sendto(client->cfd, &msgInfo, sizeof(msgInfo), 0, (struct sockaddr *) &client->serverAddr,
                    sizeof(struct sockaddr_un)) == sizeof(msgInfo)) {
             break;
@@ -348,10 +454,17 @@ celix_status_t rsaShmClientManager_sendMsgTo(rsa_shm_client_manager_t *clientMan
 
     bool replied = false;
     status = rsaShmClientManager_receiveResponse(clientManager, msgCtrl, msgBody,
-            msgBodySize, response, &replied);
-    if (status != CELIX_SUCCESS) {
+            msgBodySize, &client->replySpin, response, &replied);
+    if (status == CELIX_SUCCESS) {
+        rsaShmClientManager_addResponse(clientManager, client, serviceId, msgCtrl, msgBodySize, response->iov_len);
+    } else {
         celix_logHelper_error(clientManager->logHelper, "RsaShmClient: Error receiving response. %d.", status);
         rsaShmClientManager_markSvcCallFailed(clientManager, peerServerName, serviceId);
+        if (sentByRing && status == CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, ETIMEDOUT)) {
+            //The server may hang or be gone without noticing. Later requests are sent using the socket.
+            celix_logHelper_warning(clientManager->logHelper, "RsaShmClient: Closing request ring of %s.", peerServerName);
+            rsaShmRing_close(client->requestRing);
+        }
     }
 
     if (replied) {
@@ -430,6 +543,8 @@ static celix_status_t rsaShmClientManager_createClient(rsa_shm_client_manager_t
     client->cfd = celix_steal_fd(&cfd);
     client->peerServerName = celix_steal_ptr(peerServerNameCopy);
     client->svcDiagInfo = celix_steal_ptr(svcDiagInfo);
+    rsaShmSpin_init(&client->replySpin);
+    rsaShmClient_setupRequestRing(client);
     celix_steal_ptr(diagInfoMutex);
     *clientOut = celix_steal_ptr(client);
 
@@ -437,6 +552,7 @@ static celix_status_t rsaShmClientManager_createClient(rsa_shm_client_manager_t
 }
 
 static void rsaShmClientManager_destroyClient(rsa_shm_client_t *client) {
+    rsaShmClient_teardownRequestRing(client);
     close(client->cfd);
     free(client->peerServerName);
     /* Service diagnostics information have been destroyed by rsaShmClientManager_destroyOrDetachClient.
@@ -448,6 +564,62 @@ static void rsaShmClientManager_destroyClient(rsa_shm_client_t *client) {
     free(client);
 }
 
+static void rsaShmClient_setupRequestRing(rsa_shm_client_t *client) {
+    rsa_shm_client_manager_t *clientManager = client->manager;
+    client->requestRingMem = NULL;
+    client->requestRing = NULL;
+    if (clientManager->requestRingCapacity == 0) {
+        return;
+    }
+    size_t ringSize = rsaShmRing_memorySize(clientManager->requestRingCapacity);
+    celix_auto(celix_shm_pool_alloc_guard_t) ringAlloc = celix_shmPoolAllocGuard_init(
+            shmPool_malloc(clientManager->shmPool, ringSize + RSA_SHM_RING_ALIGNMENT - 1), clientManager->shmPool);
+    if (ringAlloc.ptr == NULL) {
+        celix_logHelper_warning(clientManager->logHelper,
+                "RsaShmClient: Error allocating request ring. Requests to %s are sent using the socket.", client->peerServerName);
+        return;
+    }
+    uintptr_t ringAddr = ((uintptr_t)ringAlloc.ptr + RSA_SHM_RING_ALIGNMENT - 1) & ~(uintptr_t)(RSA_SHM_RING_ALIGNMENT - 1);
+    rsa_shm_ring_t *ring = rsaShmRing_init((void *)ringAddr, clientManager->requestRingCapacity);
+
+    rsa_shm_msg_t msgInfo = {
+            .size = sizeof(rsa_shm_msg_t),
+            .shmId = shmPool_getMemoryShmId(clientManager->shmPool, ring),
+            .ctrlDataOffset = shmPool_getMemoryOffset(clientManager->shmPool, ring),
+            .ctrlDataSize = ringSize,
+            .msgBodyOffset = -1,//no message body, which also makes servers not supporting request rings reject the message
+            .msgBodyTotalSize = 0,
+            .metadataSize = 0,
+            .requestSize = 0,
+            .msgType = RSA_SHM_MSG_RING_ATTACH,
+            .serviceId = -1,
+    };
+    if (sendto(client->cfd, &msgInfo, sizeof(msgInfo), 0, (struct sockaddr *) &client->serverAddr,
+               sizeof(struct sockaddr_un)) != sizeof(msgInfo)) {
+        //The server did not receive the ring, so it can be freed.
+        celix_logHelper_warning(clientManager->logHelper,
+                "RsaShmClient: Error sending request ring. Requests to %s are sent using the socket. %d.", client->peerServerName, errno);
+        return;
+    }
+    client->requestRing = ring;
+    client->requestRingMem = celix_steal_ptr(ringAlloc.ptr);
+    return;
+}
+
+static void rsaShmClient_teardownRequestRing(rsa_shm_client_t *client) {
+    if (client->requestRing == NULL) {
+        return;
+    }
+    rsaShmRing_close(client->requestRing);
+    if (rsaShmRing_waitForConsumerDetached(client->requestRing, RSA_SHM_REQUEST_RING_DETACH_TIMEOUT_IN_MS)) {
+        shmPool_free(client->manager->shmPool, client->requestRingMem);
+    } else {
+        //The server may still attach or use the ring, so the ring memory is left to the shared memory pool, which is released when the client manager is destroyed.
+        celix_logHelper_warning(client->manager->logHelper, "RsaShmClient: Request ring of %s is not detached.", client->peerServerName);
+    }
+    return;
+}
+
 static rsa_shm_client_t * rsaShmClientManager_getClient(rsa_shm_client_manager_t *clientManager,
         const char *peerServerName) {
     celix_auto(celix_mutex_lock_guard_t) locker = celixMutexLockGuard_init(&clientManager->clientsMutex);
@@ -499,20 +671,18 @@ static void rsaShmClientManager_markSvcCallFinished(rsa_shm_client_manager_t *cl
 }
 
 static celix_status_t rsaShmClientManager_createMsgControl(rsa_shm_client_manager_t *clientManager,
-                                                           rsa_shm_msg_control_alloc_t* alloc) {
+                                                           void *msgCtrlMem, rsa_shm_msg_control_alloc_t* alloc) {
     assert(clientManager != NULL);
     assert(alloc != NULL);
     int retVal = 0;
     alloc->clientManager = clientManager;
-    celix_auto(celix_shm_pool_alloc_guard_t) allocRes = celix_shmPoolAllocGuard_init(
-        shmPool_malloc(clientManager->shmPool, sizeof(rsa_shm_msg_control_t)), clientManager->shmPool);
+    celix_auto(celix_shm_pool_alloc_guard_t) allocRes = celix_shmPoolAllocGuard_init(msgCtrlMem, clientManager->shmPool);
     rsa_shm_msg_control_t *msgCtrl = (rsa_shm_msg_control_t *)allocRes.ptr;
-    if (msgCtrl == NULL) {
-        return ENOMEM;
-    }
     msgCtrl->size = sizeof(rsa_shm_msg_control_t);
     msgCtrl->msgState = REQUESTING;
     msgCtrl->actualReplyedSize = 0;
+    msgCtrl->replyShmId = -1;
+    msgCtrl->replyOffset = -1;
     celix_auto(celix_thread_mutexattr_t) mattr;
     if ((retVal = pthread_mutexattr_init(&mattr)) != 0) {
         return retVal;
@@ -565,6 +735,11 @@ static bool rsaShmClientManager_handleMsgState(rsa_shm_client_manager_t *clientM
             signal = true;
             break;
         case REPLIED:
+            //The reply is not used anymore
+            (void)rsaShmClientManager_consumeReplyBlock(clientManager, ctrl, NULL);
+            removed = true;
+            rsaShmClientManager_markSvcCallFinished(clientManager, msgEntry->peerServerName, msgEntry->serviceId);
+            break;
         case ABEND:
             removed = true;
             rsaShmClientManager_markSvcCallFinished(clientManager, msgEntry->peerServerName, msgEntry->serviceId);
@@ -627,7 +802,7 @@ static void *rsaShmClientManager_exceptionMsgHandlerThread(void *data) {
 }
 
 static celix_status_t rsaShmClientManager_receiveResponse(rsa_shm_client_manager_t *clientManager,
-        rsa_shm_msg_control_t *msgCtrl, char *msgBuffer, size_t bufSize,
+        rsa_shm_msg_control_t *msgCtrl, char *msgBuffer, size_t bufSize, rsa_shm_spin_t *replySpin,
         struct iovec *response, bool *replied) {
     celix_status_t status = CELIX_SUCCESS;
     char *reply = NULL;
@@ -637,6 +812,16 @@ static celix_status_t rsaShmClientManager_receiveResponse(rsa_shm_client_manager
     timeout.tv_sec += clientManager->msgTimeOutInSec;
     bool isStreamingReply = false;
     *replied = false;
+
+    //Small calls are often replied while spinning, and then neither side needs a system call to sleep or to wake up.
+    unsigned int maxSpins = rsaShmSpin_begin(replySpin);
+    unsigned int spins = 0;
+    while (spins < maxSpins && __atomic_load_n(&msgCtrl->msgState, __ATOMIC_ACQUIRE) == REQUESTING) {
+        rsaShmSpin_pause();
+        spins++;
+    }
+    rsaShmSpin_end(replySpin, spins, spins < maxSpins);
+
     do {
         isStreamingReply = false;
         celix_auto(celix_mutex_lock_guard_t) locker = celixMutexLockGuard_init(&msgCtrl->lock);
@@ -645,7 +830,11 @@ static celix_status_t rsaShmClientManager_receiveResponse(rsa_shm_client_manager
             waitRet = pthread_cond_timedwait(&msgCtrl->signal, &msgCtrl->lock, &timeout);
         }
 
-        if (waitRet == 0 && msgCtrl->msgState != ABEND) {// Message State is REPLYING or REPLIED
+        if (waitRet == 0 && msgCtrl->msgState == REPLIED && msgCtrl->replyShmId >= 0) {
+            //The reply is placed in the shared memory of the server
+            replySize = msgCtrl->actualReplyedSize;
+            status = rsaShmClientManager_consumeReplyBlock(clientManager, msgCtrl, &reply);
+        } else if (waitRet == 0 && msgCtrl->msgState != ABEND) {// Message State is REPLYING or REPLIED
             if (msgCtrl->actualReplyedSize != 0 && msgCtrl->actualReplyedSize <= bufSize) {
                 reply = realloc(reply, replySize + msgCtrl->actualReplyedSize);
                 assert(reply != NULL);
@@ -684,6 +873,29 @@ static celix_status_t rsaShmClientManager_receiveResponse(rsa_shm_client_manager
     return status;
 }
 
+static celix_status_t rsaShmClientManager_consumeReplyBlock(rsa_shm_client_manager_t *clientManager,
+        rsa_shm_msg_control_t *msgCtrl, char **reply) {
+    if (msgCtrl->replyShmId < 0) {
+        return CELIX_SUCCESS;
+    }
+    rsa_shm_reply_block_t *replyBlock = shmCache_getMemoryPtr(clientManager->replyCache, msgCtrl->replyShmId,
+            msgCtrl->replyOffset);
+    if (replyBlock == NULL) {
+        celix_logHelper_logTssErrors(clientManager->logHelper, CELIX_LOG_LEVEL_ERROR);
+        celix_logHelper_error(clientManager->logHelper, "RsaShmClient: Error attaching reply shm %d.", msgCtrl->replyShmId);
+        return CELIX_ILLEGAL_STATE;
+    }
+    if (reply != NULL) {
+        *reply = malloc(msgCtrl->actualReplyedSize);
+        assert(*reply != NULL);
+        memcpy(*reply, replyBlock->data, msgCtrl->actualReplyedSize);
+    }
+    //Let the server release the reply block
+    __atomic_store_n(&replyBlock->consumed, 1, __ATOMIC_RELEASE);
+    shmCache_releaseMemoryPtr(clientManager->replyCache, replyBlock);
+    return CELIX_SUCCESS;
+}
+
 static void rsaShmClient_createOrAttachSvcDiagInfo(rsa_shm_client_t *client, long serviceId) {
     celix_auto(celix_mutex_lock_guard_t) locker = celixMutexLockGuard_init(&client->diagInfoMutex);
     struct service_diagnostic_info *svcDiagInfo =
@@ -694,6 +906,7 @@ static void rsaShmClient_createOrAttachSvcDiagInfo(rsa_shm_client_t *client, lon
         svcDiagInfo->refCnt = 0;
         svcDiagInfo->concurrentInvocations = 0;
         svcDiagInfo->failures = 0;
+        svcDiagInfo->estimatedResponseSize = ESTIMATED_MSG_RESPONSE_SIZE_DEFAULT;
         celix_longHashMap_put(client->svcDiagInfo, serviceId, svcDiagInfo);
     }
     svcDiagInfo->refCnt ++;
@@ -706,11 +919,115 @@ static void rsaShmClient_destroyOrDetachSvcDiagInfo(rsa_shm_client_t *client, lo
             (struct service_diagnostic_info *) celix_longHashMap_get(client->svcDiagInfo, serviceId);
     if (--svcDiagInfo->refCnt == 0) {
         (void)celix_longHashMap_remove(client->svcDiagInfo, serviceId);
+        if (svcDiagInfo->lastEncodedMetadata != NULL) {
+            rsaShmClient_releaseEncodedMetadata(svcDiagInfo->lastEncodedMetadata);
+        }
         free(svcDiagInfo);
     }
     return;
 }
 
+static bool rsaShmClient_isMetadataEmpty(const celix_properties_t *metadata) {
+    return metadata == NULL || celix_properties_size(metadata) == 0;
+}
+
+static bool rsaShmClient_isMetadataEqual(const celix_properties_t *metadata1, const celix_properties_t *metadata2) {
+    if (rsaShmClient_isMetadataEmpty(metadata1) || rsaShmClient_isMetadataEmpty(metadata2)) {
+        return rsaShmClient_isMetadataEmpty(metadata1) && rsaShmClient_isMetadataEmpty(metadata2);
+    }
+    return celix_properties_equals(metadata1, metadata2);
+}
+
+static rsa_shm_encoded_metadata_t *rsaShmClient_getEncodedMetadata(rsa_shm_client_t *client, long serviceId,
+        const celix_properties_t *metadata) {
+    celix_auto(celix_mutex_lock_guard_t) locker = celixMutexLockGuard_init(&client->diagInfoMutex);
+    struct service_diagnostic_info *svcDiagInfo =
+            (struct service_diagnostic_info *) celix_longHashMap_get(client->svcDiagInfo, serviceId);
+    if (svcDiagInfo == NULL || svcDiagInfo->lastEncodedMetadata == NULL
+            || !rsaShmClient_isMetadataEqual(svcDiagInfo->lastEncodedMetadata->metadata, metadata)) {
+        return NULL;
+    }
+    __atomic_add_fetch(&svcDiagInfo->lastEncodedMetadata->refCnt, 1, __ATOMIC_RELAXED);
+    return svcDiagInfo->lastEncodedMetadata;
+}
+
+static void rsaShmClient_setEncodedMetadata(rsa_shm_client_t *client, long serviceId,
+        rsa_shm_encoded_metadata_t *encodedMetadata) {
+    celix_auto(celix_mutex_lock_guard_t) locker = celixMutexLockGuard_init(&client->diagInfoMutex);
+    struct service_diagnostic_info *svcDiagInfo =
+            (struct service_diagnostic_info *) celix_longHashMap_get(client->svcDiagInfo, serviceId);
+    if (svcDiagInfo != NULL) {
+        if (svcDiagInfo->lastEncodedMetadata != NULL) {
+            rsaShmClient_releaseEncodedMetadata(svcDiagInfo->lastEncodedMetadata);
+        }
+        __atomic_add_fetch(&encodedMetadata->refCnt, 1, __ATOMIC_RELAXED);
+        svcDiagInfo->lastEncodedMetadata = encodedMetadata;
+    }
+    return;
+}
+
+static celix_status_t rsaShmClientManager_encodeMetadata(rsa_shm_client_manager_t *clientManager, long serviceId,
+        const celix_properties_t *metadata, rsa_shm_encoded_metadata_t **encodedMetadataOut) {
+    celix_status_t status = CELIX_SUCCESS;
+    celix_autofree rsa_shm_encoded_metadata_t *encodedMetadata = calloc(1, sizeof(*encodedMetadata));
+    if (encodedMetadata == NULL) {
+        celix_logHelper_error(clientManager->logHelper, "RsaShmClient: Error allocating encoded metadata.");
+        return CELIX_ENOMEM;
+    }
+    celix_autoptr(celix_properties_t) copiedMetadata = NULL;
+    if (!rsaShmClient_isMetadataEmpty(metadata)) {
+        copiedMetadata = celix_properties_copy(metadata);
+        if (copiedMetadata == NULL) {
+            celix_logHelper_logTssErrors(clientManager->logHelper, CELIX_LOG_LEVEL_ERROR);
+            celix_logHelper_error(clientManager->logHelper, "RsaShmClient: Error copying metadata.");
+            return CELIX_ENOMEM;
+        }
+    }
+    //The service id is also sent as metadata, for servers that do not get it from the message info.
+    celix_autoptr(celix_properties_t) sentMetadata =
+            (copiedMetadata != NULL) ? celix_properties_copy(copiedMetadata) : celix_properties_create();
+    if (sentMetadata == NULL
+            || celix_properties_setLong(sentMetadata, CELIX_RSA_ENDPOINT_SERVICE_ID, serviceId) != CELIX_SUCCESS) {
+        celix_logHelper_logTssErrors(clientManager->logHelper, CELIX_LOG_LEVEL_ERROR);
+        celix_logHelper_error(clientManager->logHelper, "RsaShmClient: Error creating metadata with service id.");
+        return CELIX_ENOMEM;
+    }
+
+    size_t encodedLen = 0;
+    celix_autofree char* encoded = NULL;
+    FILE *fp = open_memstream(&encoded, &encodedLen);
+    if (fp == NULL) {
+        celix_logHelper_error(clientManager->logHelper, "RsaShmClient: Error opening metadata memory. %d.", errno);
+        return CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, errno);
+    }
+    status = celix_properties_saveToStream(sentMetadata, fp, 0);
+    if (status != CELIX_SUCCESS) {
+        fclose(fp);
+        celix_logHelper_error(
+            clientManager->logHelper, "RsaShmClient: Error encoding metadata to memory stream. %d.", status);
+        celix_logHelper_logTssErrors(clientManager->logHelper, CELIX_LOG_LEVEL_ERROR);
+        return status;
+    }
+    fclose(fp);
+
+    encodedMetadata->refCnt = 1;
+    encodedMetadata->metadata = celix_steal_ptr(copiedMetadata);
+    // make the metadata include the terminating null byte ('\0')
+    encodedMetadata->encodedSize = encodedLen + 1;
+    encodedMetadata->encoded = celix_steal_ptr(encoded);
+    *encodedMetadataOut = celix_steal_ptr(encodedMetadata);
+    return CELIX_SUCCESS;
+}
+
+static void rsaShmClient_releaseEncodedMetadata(rsa_shm_encoded_metadata_t *encodedMetadata) {
+    if (__atomic_sub_fetch(&encodedMetadata->refCnt, 1, __ATOMIC_ACQ_REL) == 0) {
+        celix_properties_destroy(encodedMetadata->metadata);
+        free(encodedMetadata->encoded);
+        free(encodedMetadata);
+    }
+    return;
+}
+
 static bool rsaShmClient_shouldBreakInvocation(rsa_shm_client_t *client, long serviceId) {
     bool breaked = false;
     rsa_shm_client_manager_t *clientManager = client->manager;
@@ -747,3 +1064,51 @@ static bool rsaShmClient_shouldBreakInvocation(rsa_shm_client_t *client, long se
     }while (false);
     return breaked;
 };
+
+static size_t rsaShmClient_getEstimatedResponseSize(rsa_shm_client_t *client, long serviceId) {
+    celix_auto(celix_mutex_lock_guard_t) locker = celixMutexLockGuard_init(&client->diagInfoMutex);
+    struct service_diagnostic_info *svcDiagInfo =
+            (struct service_diagnostic_info *) celix_longHashMap_get(client->svcDiagInfo, serviceId);
+    return svcDiagInfo != NULL ? svcDiagInfo->estimatedResponseSize : ESTIMATED_MSG_RESPONSE_SIZE_DEFAULT;
+}
+
+static int rsaShmClient_compareSizes(const void *a, const void *b) {
+    size_t size1 = *(const size_t *)a;
+    size_t size2 = *(const size_t *)b;
+    return (size1 > size2) - (size1 < size2);
+}
+
+static void rsaShmClient_addResponseSize(rsa_shm_client_t *client, long serviceId, size_t responseSize) {
+    celix_auto(celix_mutex_lock_guard_t) locker = celixMutexLockGuard_init(&client->diagInfoMutex);
+    struct service_diagnostic_info *svcDiagInfo =
+            (struct service_diagnostic_info *) celix_longHashMap_get(client->svcDiagInfo, serviceId);
+    if (svcDiagInfo == NULL) {
+        return;
+    }
+    svcDiagInfo->responseSizes[svcDiagInfo->nextResponseSize] = responseSize;
+    svcDiagInfo->nextResponseSize = (svcDiagInfo->nextResponseSize + 1) % RSA_SHM_RESPONSE_SIZE_HISTORY;
+    if (svcDiagInfo->nrOfResponseSizes < RSA_SHM_RESPONSE_SIZE_HISTORY) {
+        svcDiagInfo->nrOfResponseSizes++;
+    }
+    //The estimate covers most recent responses, without letting a single large response size all requests.
+    size_t sizes[RSA_SHM_RESPONSE_SIZE_HISTORY];
+    unsigned int nrOfSizes = svcDiagInfo->nrOfResponseSizes;
+    memcpy(sizes, svcDiagInfo->responseSizes, nrOfSizes * sizeof(sizes[0]));
+    qsort(sizes, nrOfSizes, sizeof(sizes[0]), rsaShmClient_compareSizes);
+    size_t estimatedSize = sizes[(nrOfSizes * RSA_SHM_RESPONSE_SIZE_PERCENTILE + 99) / 100 - 1];
+    svcDiagInfo->estimatedResponseSize =
+            MIN(MAX(estimatedSize, ESTIMATED_MSG_RESPONSE_SIZE_DEFAULT), ESTIMATED_MSG_RESPONSE_SIZE_MAX);
+    return;
+}
+
+static void rsaShmClientManager_addResponse(rsa_shm_client_manager_t *clientManager, rsa_shm_client_t *client,
+        long serviceId, const rsa_shm_msg_control_t *msgCtrl, size_t msgBodySize, size_t responseSize) {
+    __atomic_add_fetch(&clientManager->responses, 1, __ATOMIC_RELAXED);
+    if (msgCtrl->replyShmId >= 0) {
+        __atomic_add_fetch(&clientManager->replyBlockResponses, 1, __ATOMIC_RELAXED);
+    } else if (responseSize > msgBodySize) {
+        __atomic_add_fetch(&clientManager->chunkedResponses, 1, __ATOMIC_RELAXED);
+    }
+    rsaShmClient_addResponseSize(client, serviceId, responseSize);
+    return;
+}
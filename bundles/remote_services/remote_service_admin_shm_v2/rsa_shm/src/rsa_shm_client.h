@@ -34,6 +34,15 @@ extern "C" {
 
 typedef struct rsa_shm_client_manager rsa_shm_client_manager_t;
 
+/**
+ * @brief The statistics of the responses received by a client manager
+ */
+typedef struct rsa_shm_client_stats {
+    size_t responses;//The number of received responses
+    size_t replyBlockResponses;//The number of responses passed in the reply shared memory of the server
+    size_t chunkedResponses;//The number of responses passed in chunks, which takes an exchange per chunk
+} rsa_shm_client_stats_t;
+
 celix_status_t rsaShmClientManager_create(celix_bundle_context_t *ctx,
         celix_log_helper_t *loghelper, rsa_shm_client_manager_t **clientManagerOut);
 
@@ -51,6 +60,19 @@ celix_status_t rsaShmClientManager_sendMsgTo(rsa_shm_client_manager_t *clientMan
         const char *peerServerName, long serviceId, celix_properties_t *metadata,
         const struct iovec *request, struct iovec *response);
 
+/**
+ * @brief Get the statistics of the responses received by a client manager.
+ *
+ * A response that does not fit in the shared memory of its request is passed in the reply shared memory of the
+ * server, or in chunks. The shared memory of a request has room for the responses of the service that the recent
+ * responses suggest, so normally only responses that are larger than usual do not fit.
+ *
+ * @param[in] clientManager The client manager.
+ * @param[out] stats The statistics.
+ * @return @see celix_errno.h
+ */
+celix_status_t rsaShmClientManager_getStats(rsa_shm_client_manager_t *clientManager, rsa_shm_client_stats_t *stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -49,6 +49,57 @@ extern "C" {
  */
 #define RSA_SHM_MEMORY_POOL_SIZE_DEFAULT (1024*256)
 
+/**
+ * @brief A property of RsaShm bundle that indicates the maximum size of the shared memory pool.
+ * If a message does not fit in the shared memory pool, the pool grows with a new shared memory segment,
+ * until the maximum size is reached. If the value is not greater than RSA_SHM_MEMORY_POOL_SIZE_KEY, the pool does not grow.
+ *
+ */
+#define RSA_SHM_MEMORY_POOL_MAX_SIZE_KEY "CELIX_RSA_SHM_POOL_MAX_SIZE"
+/**
+ * @brief The default maximum size of the shared memory pool.
+ *
+ */
+#define RSA_SHM_MEMORY_POOL_MAX_SIZE_DEFAULT (1024*1024*32)
+
+/**
+ * @brief A property of RsaShm bundle that indicates whether the shared memory pools are backed by huge pages,
+ * which reduces TLB misses when passing large messages. If no huge pages are available, normal pages are used.
+ *
+ */
+#define RSA_SHM_MEMORY_POOL_HUGE_PAGES_KEY "CELIX_RSA_SHM_POOL_HUGE_PAGES"
+/**
+ * @brief The default value of RSA_SHM_MEMORY_POOL_HUGE_PAGES_KEY.
+ *
+ */
+#define RSA_SHM_MEMORY_POOL_HUGE_PAGES_DEFAULT false
+
+/**
+ * @brief A property of RsaShm bundle that indicates the size of the shared memory pool of a server, in which replies
+ * that do not fit in the message body are placed. The client then reads such a reply at once, instead of in chunks.
+ * If the value is 0, or if a reply does not fit in the pool, the reply is passed in chunks.
+ *
+ */
+#define RSA_SHM_REPLY_POOL_SIZE_KEY "CELIX_RSA_SHM_REPLY_POOL_SIZE"
+/**
+ * @brief The default size of the reply shared memory pool.
+ *
+ */
+#define RSA_SHM_REPLY_POOL_SIZE_DEFAULT (1024*1024*4)
+
+/**
+ * @brief A property of RsaShm bundle that indicates the maximum number of requests for the same exported service that
+ * a server handles concurrently. Further requests for that service are queued, so that they do not occupy all request
+ * handling threads. If the value is 0, the number is not limited.
+ *
+ */
+#define RSA_SHM_SERVER_MAX_CONCURRENT_REQUESTS_PER_SERVICE_KEY "CELIX_RSA_SHM_SERVER_MAX_CONCURRENT_REQUESTS_PER_SERVICE"
+/**
+ * @brief The default maximum number of concurrently handled requests for the same exported service.
+ *
+ */
+#define RSA_SHM_SERVER_MAX_CONCURRENT_REQUESTS_PER_SERVICE_DEFAULT 0
+
 /**
  * @brief A property of RsaShm bundle that indicates the timeout of remote service invocation.
  *
@@ -73,6 +124,21 @@ extern "C" {
  */
 #define RSA_SHM_MAX_CONCURRENT_INVOCATIONS_DEFAULT 32
 
+/**
+ * @brief A property of RsaShm bundle that indicates the capacity of the request ring, which is shared between a client
+ * and a server. Requests are passed using the ring instead of the unix domain socket, so that small calls do not need any
+ * system call if both sides are busy. The value is rounded up to a power of two, and its maximum is 4096.
+ * If the value is 0, or if the ring is full, requests are sent using the unix domain socket.
+ *
+ */
+#define RSA_SHM_REQUEST_RING_CAPACITY_KEY "CELIX_RSA_SHM_REQUEST_RING_CAPACITY"
+
+/**
+ * @brief The default capacity of the request ring.
+ *
+ */
+#define RSA_SHM_REQUEST_RING_CAPACITY_DEFAULT 64
+
 /**
  * @brief The maximum failures of service invocation.
  * If there are more invocation failures than this value, the service invocation will fail for the next 'RSA_SHM_MAX_SVC_BREAKED_TIME_IN_S' seconds
@@ -88,9 +154,18 @@ extern "C" {
 /**
  * @brief Estimated remote service response default size
  *
+ * The shared memory of a request has room for a response of at least this size. Once a service has responded, the
+ * room is estimated from the sizes of its recent responses.
  */
 #define ESTIMATED_MSG_RESPONSE_SIZE_DEFAULT 512
 
+/**
+ * @brief The maximum estimated remote service response size
+ *
+ * Larger responses are passed in the reply shared memory of the server, or in chunks.
+ */
+#define ESTIMATED_MSG_RESPONSE_SIZE_MAX (1024*64)
+
 /**
  * @brief Default RPC type used by shared memory RSA
  *
@@ -246,10 +246,9 @@ celix_status_t rsaShm_send(rsa_shm_t *admin, const endpoint_description_t *endpo
         celix_logHelper_error(admin->logHelper,"RSA shm server name of %s is invalid.", endpoint->serviceName);
         return CELIX_SERVICE_EXCEPTION;
     }
-    celix_autoptr(celix_properties_t) newMetadata = celix_properties_copy(metadata);
-    celix_properties_setLong(newMetadata, CELIX_RSA_ENDPOINT_SERVICE_ID, endpoint->serviceId);
+    //The client manager adds the service id to the metadata
     status = rsaShmClientManager_sendMsgTo(admin->shmClientManager, shmServerName,
-            (long)endpoint->serviceId, newMetadata, request, response);
+            (long)endpoint->serviceId, metadata, request, response);
 
     return status;
 }
@@ -25,8 +25,15 @@ extern "C" {
 #endif
 #include <pthread.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <sys/types.h>
 
+/**
+ * The alignment of the request in the message body. The metadata is padded with '\0' bytes up to it, so that
+ * the server can use the items of sequences in the request in place.
+ */
+#define RSA_SHM_MSG_REQUEST_ALIGNMENT 8
+
 typedef enum {
     REQUESTING = 0,
     REPLYING = 1,
@@ -35,14 +42,30 @@ typedef enum {
     REQ_CANCELLED = 4,
 }rsa_shm_msg_state;
 
+typedef enum {
+    RSA_SHM_MSG_REQUEST = 0,
+    RSA_SHM_MSG_RING_ATTACH = 1,//Control data is a rsa_shm_ring_t, which the server should consume requests from
+}rsa_shm_msg_type;
+
 typedef struct rsa_shm_msg_control {
     size_t size;//The size of ‘struct rsa_shm_msg_control‘.It is used to extend 'struct rsa_shm_msg_control' in the future.
     rsa_shm_msg_state msgState;
     pthread_mutex_t lock;
     pthread_cond_t signal;
     size_t actualReplyedSize;
+    int replyShmId;//The shared memory id of a reply placed by the server, or -1 if the reply is in the message body
+    ssize_t replyOffset;//The offset of the rsa_shm_reply_block_t of a reply placed by the server
 }rsa_shm_msg_control_t;
 
+/**
+ * A reply that does not fit in the message body is placed in the shared memory of the server,
+ * so that the client can read it at once.
+ */
+typedef struct rsa_shm_reply_block {
+    uint64_t consumed;//Set by the client when it does not use the reply anymore, after which the server can release it
+    char data[];
+}rsa_shm_reply_block_t;
+
 typedef struct rsa_shm_msg {
     size_t size;//The size of ‘struct rsa_shm_msg‘.It is used to extend 'struct rsa_shm_msg' in the future.
     int shmId;
@@ -50,8 +73,10 @@ typedef struct rsa_shm_msg {
     size_t ctrlDataSize;
     ssize_t msgBodyOffset;//Message body includes metadata, request and reserve space
     size_t msgBodyTotalSize;//equal metadataSize + requestSize + reserve space size
-    size_t metadataSize;
+    size_t metadataSize;//Including the padding up to RSA_SHM_MSG_REQUEST_ALIGNMENT
     size_t requestSize;
+    rsa_shm_msg_type msgType;//Only valid if 'size' includes it, otherwise the message is a RSA_SHM_MSG_REQUEST
+    long serviceId;//The id of the invoked service, or -1. Only valid if 'size' includes it
 }rsa_shm_msg_t;
 
 #ifdef __cplusplus
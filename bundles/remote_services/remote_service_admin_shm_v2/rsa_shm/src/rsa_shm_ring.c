@@ -0,0 +1,252 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "rsa_shm_ring.h"
+#include "celix_utils.h"
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <limits.h>
+#include <string.h>
+#include <time.h>
+#include <assert.h>
+
+#define RSA_SHM_SPIN_MAX_ITERATIONS 2000
+#define RSA_SHM_SPIN_MIN_ITERATIONS 16
+//Every RSA_SHM_SPIN_PROBE_INTERVAL waits spin up to the maximum, so that a spin limit that became too low can recover.
+#define RSA_SHM_SPIN_PROBE_INTERVAL 32
+
+typedef enum {
+    RSA_SHM_RING_UNATTACHED = 0,
+    RSA_SHM_RING_ATTACHED = 1,
+    RSA_SHM_RING_DETACHED = 2,
+} rsa_shm_ring_consumer_state;
+
+typedef struct rsa_shm_ring_cell {
+    uint32_t sequence;
+    rsa_shm_msg_t msg;
+} rsa_shm_ring_cell_t;
+
+/*
+ * The ring is a bounded multi-producer queue, in which each cell has a sequence number telling whether it can be
+ * written (sequence == enqueue position) or read (sequence == dequeue position + 1).
+ * Producers claim a cell with a CAS on enqueuePos, consumer positions are only touched by the single consumer.
+ * The enqueue and dequeue positions live on separate cache lines, because they are written by different processes.
+ *
+ * Note the ring lives in shared memory, so it must not contain pointers.
+ */
+struct rsa_shm_ring {
+    size_t size;//The size of 'struct rsa_shm_ring'. It is used to extend 'struct rsa_shm_ring' in the future.
+    uint32_t capacity;
+    uint32_t consumerState;//rsa_shm_ring_consumer_state, also used as futex word to wait for the consumer detaching
+    uint32_t closed;
+    uint32_t consumerWaiting;
+    uint32_t wakeupSeq;//futex word the consumer sleeps on
+    uint32_t enqueuePos __attribute__((aligned(RSA_SHM_RING_ALIGNMENT)));
+    uint32_t dequeuePos __attribute__((aligned(RSA_SHM_RING_ALIGNMENT)));
+    rsa_shm_ring_cell_t cells[] __attribute__((aligned(RSA_SHM_RING_ALIGNMENT)));
+};
+
+static int rsaShmRing_futexWait(uint32_t *addr, uint32_t expected, int timeoutInMs) {
+    struct timespec timeout = {.tv_sec = timeoutInMs / 1000, .tv_nsec = (timeoutInMs % 1000) * 1000000L};
+    //No FUTEX_PRIVATE_FLAG, because the futex word is shared with another process.
+    return (int)syscall(SYS_futex, addr, FUTEX_WAIT, expected, &timeout, NULL, 0);
+}
+
+static void rsaShmRing_futexWake(uint32_t *addr, int count) {
+    (void)syscall(SYS_futex, addr, FUTEX_WAKE, count, NULL, NULL, 0);
+}
+
+size_t rsaShmRing_memorySize(uint32_t capacity) {
+    return sizeof(rsa_shm_ring_t) + capacity * sizeof(rsa_shm_ring_cell_t);
+}
+
+rsa_shm_ring_t *rsaShmRing_init(void *mem, uint32_t capacity) {
+    assert(capacity > 0 && capacity <= RSA_SHM_RING_MAX_CAPACITY && (capacity & (capacity - 1)) == 0);
+    assert(((uintptr_t)mem % RSA_SHM_RING_ALIGNMENT) == 0);
+    rsa_shm_ring_t *ring = mem;
+    memset(ring, 0, sizeof(*ring));
+    ring->size = sizeof(*ring);
+    ring->capacity = capacity;
+    ring->consumerState = RSA_SHM_RING_UNATTACHED;
+    for (uint32_t i = 0; i < capacity; ++i) {
+        ring->cells[i].sequence = i;
+    }
+    return ring;
+}
+
+bool rsaShmRing_isValid(const rsa_shm_ring_t *ring, size_t memorySize, uint32_t *capacity) {
+    if (ring == NULL || ((uintptr_t)ring % RSA_SHM_RING_ALIGNMENT) != 0 || memorySize < sizeof(*ring)
+            || ring->size != sizeof(*ring)) {
+        return false;
+    }
+    //Read once, the peer can change the shared capacity at any time
+    uint32_t ringCapacity = __atomic_load_n(&ring->capacity, __ATOMIC_RELAXED);
+    if (ringCapacity == 0 || ringCapacity > RSA_SHM_RING_MAX_CAPACITY || (ringCapacity & (ringCapacity - 1)) != 0
+            || rsaShmRing_memorySize(ringCapacity) != memorySize) {
+        return false;
+    }
+    *capacity = ringCapacity;
+    return true;
+}
+
+bool rsaShmRing_push(rsa_shm_ring_t *ring, uint32_t capacity, const rsa_shm_msg_t *msg) {
+    uint32_t mask = capacity - 1;
+    uint32_t pos = __atomic_load_n(&ring->enqueuePos, __ATOMIC_RELAXED);
+    rsa_shm_ring_cell_t *cell = NULL;
+    while (true) {
+        if (__atomic_load_n(&ring->closed, __ATOMIC_ACQUIRE)) {
+            return false;
+        }
+        cell = &ring->cells[pos & mask];
+        uint32_t seq = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+        int32_t diff = (int32_t)(seq - pos);
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&ring->enqueuePos, &pos, pos + 1, true,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false;//full
+        } else {
+            pos = __atomic_load_n(&ring->enqueuePos, __ATOMIC_RELAXED);
+        }
+    }
+    cell->msg = *msg;
+    //Publishing the cell and checking consumerWaiting must be sequentially consistent,
+    //pairing with the consumer announcing it is waiting and then checking the cell.
+    __atomic_store_n(&cell->sequence, pos + 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&ring->consumerWaiting, __ATOMIC_SEQ_CST)) {
+        __atomic_add_fetch(&ring->wakeupSeq, 1, __ATOMIC_SEQ_CST);
+        rsaShmRing_futexWake(&ring->wakeupSeq, 1);
+    }
+    return true;
+}
+
+static bool rsaShmRing_isEmpty(rsa_shm_ring_t *ring, uint32_t capacity) {
+    uint32_t pos = ring->dequeuePos;
+    rsa_shm_ring_cell_t *cell = &ring->cells[pos & (capacity - 1)];
+    return (int32_t)(__atomic_load_n(&cell->sequence, __ATOMIC_SEQ_CST) - (pos + 1)) < 0;
+}
+
+bool rsaShmRing_pop(rsa_shm_ring_t *ring, uint32_t capacity, rsa_shm_msg_t *msg) {
+    uint32_t pos = ring->dequeuePos;
+    rsa_shm_ring_cell_t *cell = &ring->cells[pos & (capacity - 1)];
+    uint32_t seq = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+    if ((int32_t)(seq - (pos + 1)) < 0) {
+        return false;
+    }
+    *msg = cell->msg;
+    __atomic_store_n(&cell->sequence, pos + capacity, __ATOMIC_RELEASE);
+    ring->dequeuePos = pos + 1;
+    return true;
+}
+
+void rsaShmRing_waitForMsg(rsa_shm_ring_t *ring, uint32_t capacity, rsa_shm_spin_t *spin, int timeoutInMs) {
+    unsigned int maxSpins = rsaShmSpin_begin(spin);
+    unsigned int spins = 0;
+    while (spins < maxSpins) {
+        if (!rsaShmRing_isEmpty(ring, capacity) || rsaShmRing_isClosed(ring)) {
+            rsaShmSpin_end(spin, spins, true);
+            return;
+        }
+        rsaShmSpin_pause();
+        spins++;
+    }
+    rsaShmSpin_end(spin, spins, false);
+
+    uint32_t seq = __atomic_load_n(&ring->wakeupSeq, __ATOMIC_SEQ_CST);
+    __atomic_store_n(&ring->consumerWaiting, 1, __ATOMIC_SEQ_CST);
+    if (rsaShmRing_isEmpty(ring, capacity) && !rsaShmRing_isClosed(ring)) {
+        //Spurious wakeups, EAGAIN and timeouts are all fine, the caller checks the ring again.
+        (void)rsaShmRing_futexWait(&ring->wakeupSeq, seq, timeoutInMs);
+    }
+    __atomic_store_n(&ring->consumerWaiting, 0, __ATOMIC_SEQ_CST);
+}
+
+void rsaShmRing_close(rsa_shm_ring_t *ring) {
+    __atomic_store_n(&ring->closed, 1, __ATOMIC_SEQ_CST);
+    __atomic_add_fetch(&ring->wakeupSeq, 1, __ATOMIC_SEQ_CST);
+    rsaShmRing_futexWake(&ring->wakeupSeq, INT_MAX);
+}
+
+bool rsaShmRing_isClosed(rsa_shm_ring_t *ring) {
+    return __atomic_load_n(&ring->closed, __ATOMIC_SEQ_CST) != 0;
+}
+
+bool rsaShmRing_attachConsumer(rsa_shm_ring_t *ring) {
+    uint32_t expected = RSA_SHM_RING_UNATTACHED;
+    return __atomic_compare_exchange_n(&ring->consumerState, &expected, RSA_SHM_RING_ATTACHED, false,
+                                       __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+
+void rsaShmRing_detachConsumer(rsa_shm_ring_t *ring) {
+    __atomic_store_n(&ring->consumerState, RSA_SHM_RING_DETACHED, __ATOMIC_RELEASE);
+    rsaShmRing_futexWake(&ring->consumerState, INT_MAX);
+}
+
+bool rsaShmRing_isConsumerAttached(rsa_shm_ring_t *ring) {
+    return __atomic_load_n(&ring->consumerState, __ATOMIC_ACQUIRE) == RSA_SHM_RING_ATTACHED;
+}
+
+bool rsaShmRing_waitForConsumerDetached(rsa_shm_ring_t *ring, int timeoutInMs) {
+    struct timespec start = celix_gettime(CLOCK_MONOTONIC);
+    uint32_t state;
+    while ((state = __atomic_load_n(&ring->consumerState, __ATOMIC_ACQUIRE)) != RSA_SHM_RING_DETACHED) {
+        int remainingInMs = timeoutInMs - (int)(celix_elapsedtime(CLOCK_MONOTONIC, start) * 1000);
+        if (remainingInMs <= 0) {
+            return false;
+        }
+        (void)rsaShmRing_futexWait(&ring->consumerState, state, remainingInMs);
+    }
+    return true;
+}
+
+void rsaShmSpin_init(rsa_shm_spin_t *spin) {
+    spin->maxLimit = sysconf(_SC_NPROCESSORS_ONLN) > 1 ? RSA_SHM_SPIN_MAX_ITERATIONS : 0;
+    spin->limit = spin->maxLimit / 4;
+    spin->waits = 0;
+}
+
+unsigned int rsaShmSpin_begin(rsa_shm_spin_t *spin) {
+    unsigned int waits = __atomic_add_fetch(&spin->waits, 1, __ATOMIC_RELAXED);
+    if (waits % RSA_SHM_SPIN_PROBE_INTERVAL == 0) {
+        return spin->maxLimit;
+    }
+    return __atomic_load_n(&spin->limit, __ATOMIC_RELAXED);
+}
+
+void rsaShmSpin_end(rsa_shm_spin_t *spin, unsigned int spins, bool succeeded) {
+    if (spin->maxLimit == 0) {
+        return;
+    }
+    int limit = (int)__atomic_load_n(&spin->limit, __ATOMIC_RELAXED);
+    if (succeeded) {
+        int target = (int)spins * 2 + RSA_SHM_SPIN_MIN_ITERATIONS;
+        limit += (target - limit) / 8;
+    } else {
+        limit -= limit / 8;
+    }
+    if (limit < RSA_SHM_SPIN_MIN_ITERATIONS) {
+        limit = RSA_SHM_SPIN_MIN_ITERATIONS;
+    } else if (limit > (int)spin->maxLimit) {
+        limit = (int)spin->maxLimit;
+    }
+    __atomic_store_n(&spin->limit, (unsigned int)limit, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,176 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef _RSA_SHM_RING_H_
+#define _RSA_SHM_RING_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include "rsa_shm_msg.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief The alignment of the shared memory of a rsa_shm_ring_t
+ */
+#define RSA_SHM_RING_ALIGNMENT 64
+
+/**
+ * @brief The maximum capacity of a rsa_shm_ring_t
+ */
+#define RSA_SHM_RING_MAX_CAPACITY 4096
+
+/**
+ * @brief A bounded request ring in shared memory.
+ *
+ * The ring passes rsa_shm_msg_t requests from the threads of a rsa shm client to a single consumer thread of a rsa shm
+ * server, without any system call if the consumer is busy or spinning. Producers never block: if the ring is full or
+ * closed, the request should be sent using the datagram socket instead.
+ *
+ * The ring memory is writable by both peers, so the functions accessing the cells take the capacity as known by the
+ * caller: the capacity the producer initialized the ring with, or the capacity the consumer validated when attaching.
+ */
+typedef struct rsa_shm_ring rsa_shm_ring_t;
+
+/**
+ * @brief Adaptive spin state, used to spin before sleeping in the kernel.
+ *
+ * The spin limit follows the number of spins that were needed to see the awaited change,
+ * so that waits that are normally short are served without sleeping and long waits do not burn CPU.
+ */
+typedef struct rsa_shm_spin {
+    unsigned int limit;//current spin limit
+    unsigned int maxLimit;//0 on single cpu systems
+    unsigned int waits;
+} rsa_shm_spin_t;
+
+/**
+ * @brief Get the shared memory size needed for a ring with the given capacity.
+ */
+size_t rsaShmRing_memorySize(uint32_t capacity);
+
+/**
+ * @brief Initialize a ring in shared memory.
+ *
+ * @param[in] mem Shared memory of rsaShmRing_memorySize(capacity) bytes, aligned on RSA_SHM_RING_ALIGNMENT.
+ * @param[in] capacity The ring capacity, a power of two not greater than RSA_SHM_RING_MAX_CAPACITY.
+ * @return The initialized ring.
+ */
+rsa_shm_ring_t *rsaShmRing_init(void *mem, uint32_t capacity);
+
+/**
+ * @brief Check whether shared memory, received from a peer, contains a valid ring.
+ *
+ * @param[in] ring The ring.
+ * @param[in] memorySize The shared memory size of the ring announced by the peer.
+ * @param[out] capacity The validated ring capacity, which must be used to access the ring afterwards.
+ */
+bool rsaShmRing_isValid(const rsa_shm_ring_t *ring, size_t memorySize, uint32_t *capacity);
+
+/**
+ * @brief Push a request and wake up the consumer if it is sleeping. Can be called by multiple threads.
+ *
+ * @return true if the request is pushed, false if the ring is full or closed.
+ */
+bool rsaShmRing_push(rsa_shm_ring_t *ring, uint32_t capacity, const rsa_shm_msg_t *msg);
+
+/**
+ * @brief Pop a request. Must only be called by the consumer thread.
+ *
+ * @return true if a request is popped, false if the ring is empty.
+ */
+bool rsaShmRing_pop(rsa_shm_ring_t *ring, uint32_t capacity, rsa_shm_msg_t *msg);
+
+/**
+ * @brief Wait, spinning first, until the ring is not empty, the ring is closed or the timeout expires.
+ * Must only be called by the consumer thread.
+ */
+void rsaShmRing_waitForMsg(rsa_shm_ring_t *ring, uint32_t capacity, rsa_shm_spin_t *spin, int timeoutInMs);
+
+/**
+ * @brief Close the ring: new requests are rejected and the consumer is woken up.
+ * Can be called by both the producer and the consumer side.
+ */
+void rsaShmRing_close(rsa_shm_ring_t *ring);
+
+/**
+ * @brief Check whether the ring is closed.
+ */
+bool rsaShmRing_isClosed(rsa_shm_ring_t *ring);
+
+/**
+ * @brief Attach the consumer to the ring. A ring can only be attached once.
+ *
+ * @return true if the consumer is attached.
+ */
+bool rsaShmRing_attachConsumer(rsa_shm_ring_t *ring);
+
+/**
+ * @brief Detach the consumer from the ring. After this call the consumer does not touch the ring anymore.
+ */
+void rsaShmRing_detachConsumer(rsa_shm_ring_t *ring);
+
+/**
+ * @brief Check whether a consumer is attached to the ring.
+ */
+bool rsaShmRing_isConsumerAttached(rsa_shm_ring_t *ring);
+
+/**
+ * @brief Wait until the consumer is detached from the ring.
+ *
+ * @return true if the consumer has been attached and is detached now, i.e. if the ring memory can be released.
+ */
+bool rsaShmRing_waitForConsumerDetached(rsa_shm_ring_t *ring, int timeoutInMs);
+
+/**
+ * @brief Initialize adaptive spin state.
+ */
+void rsaShmSpin_init(rsa_shm_spin_t *spin);
+
+/**
+ * @brief Start a wait, returning the maximum number of spins for this wait.
+ */
+unsigned int rsaShmSpin_begin(rsa_shm_spin_t *spin);
+
+/**
+ * @brief End a wait, adapting the spin limit.
+ *
+ * @param[in] spins The number of spins done.
+ * @param[in] succeeded Whether the awaited change was seen while spinning.
+ */
+void rsaShmSpin_end(rsa_shm_spin_t *spin, unsigned int spins, bool succeeded);
+
+/**
+ * @brief Hint the cpu that the calling thread is spinning.
+ */
+static inline void rsaShmSpin_pause(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RSA_SHM_RING_H_ */
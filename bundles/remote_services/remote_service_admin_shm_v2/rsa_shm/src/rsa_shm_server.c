@@ -18,14 +18,16 @@
  */
 #include "rsa_shm_server.h"
 #include "rsa_shm_msg.h"
+#include "rsa_shm_ring.h"
+#include "rsa_shm_worker_pool.h"
 #include "rsa_shm_constants.h"
 #include "shm_cache.h"
+#include "shm_pool.h"
 #include "celix_log_helper.h"
 #include "celix_stdlib_cleanup.h"
 #include "celix_build_assert.h"
 #include "celix_api.h"
 #include "celix_unistd_cleanup.h"
-#include <thpool.h>
 #include <sys/un.h>
 #include <sys/socket.h>
 #include <sys/types.h>
@@ -40,9 +42,8 @@
 #include <errno.h>
 
 #define MAX_RSA_SHM_SERVER_HANDLE_MSG_THREADS_NUM 5
-
-// move to thpool.h once it is reused in other places
-CELIX_DEFINE_AUTO_CLEANUP_FREE_FUNC(threadpool, thpool_destroy, NULL)
+//The consumer wakes up periodically, even if nobody wakes it up, e.g. because the client died.
+#define RSA_SHM_RING_CONSUMER_WAIT_TIMEOUT_IN_MS 1000
 
 struct rsa_shm_server {
     celix_bundle_context_t *ctx;
@@ -50,17 +51,39 @@ struct rsa_shm_server {
     celix_log_helper_t *loghelper;
     int sfd;
     shm_cache_t *shmCache;
-    threadpool threadPool;
+    rsa_shm_worker_pool_t *workerPool;
     celix_thread_t revMsgThread;
     bool revMsgThreadActive;
     rsaShmServer_receiveMsgCB revCB;
     void *revCBHandle;
     long msgTimeOutInSec;
+    celix_thread_mutex_t ringConsumersMutex;//protects ringConsumers
+    celix_array_list_t *ringConsumers;//Element: rsa_shm_ring_consumer_t *
+    shm_pool_t *replyPool;//NULL if replies are only passed in chunks
+    celix_thread_mutex_t replyBlocksMutex;//protects replyBlocks
+    celix_array_list_t *replyBlocks;//Element: rsa_shm_server_reply_block_t *, the reply blocks in use by clients
+    size_t nrOfReplyBlocks;//The size of replyBlocks, can be read without holding replyBlocksMutex (atomically)
 };
 
-struct rsa_shm_server_thpool_work_data {
+typedef struct rsa_shm_server_reply_block {
+    rsa_shm_reply_block_t *block;
+    int clientShmId;
+} rsa_shm_server_reply_block_t;
+
+typedef struct rsa_shm_ring_consumer {
+    rsa_shm_server_t *server;
+    rsa_shm_ring_t *ring;
+    uint32_t capacity;//validated when attaching, never read again from the shared ring
+    int shmId;
+    celix_thread_t thread;
+    bool peerClosed;
+    bool finished;
+} rsa_shm_ring_consumer_t;
+
+struct rsa_shm_server_work_data {
     rsa_shm_server_t *server;
     rsa_shm_msg_control_t *msgCtrl;
+    int shmId;
     void *msgBody;
     size_t msgBodyTotalSize;
     size_t metadataSize;
@@ -68,6 +91,10 @@ struct rsa_shm_server_thpool_work_data {
 };
 
 static void *rsaShmServer_receiveMsgThread(void *data);
+static void rsaShmServer_shmPeerClosed(void *handle, shm_cache_t *shmCache, int shmId);
+static void rsaShmServer_stopRingConsumers(rsa_shm_server_t *server);
+static void rsaShmServer_releaseReplyBlocks(rsa_shm_server_t *server, int clientShmId);
+static void rsaShmServer_releaseConsumedReplyBlocks(rsa_shm_server_t *server);
 
 celix_status_t rsaShmServer_create(celix_bundle_context_t *ctx, const char *name, celix_log_helper_t *loghelper,
         rsaShmServer_receiveMsgCB receiveCB, void *revHandle, rsa_shm_server_t **shmServerOut) {
@@ -115,12 +142,58 @@ celix_status_t rsaShmServer_create(celix_bundle_context_t *ctx, const char *name
     }
     server->shmCache = shmCache;
 
-    server->threadPool = thpool_init(MAX_RSA_SHM_SERVER_HANDLE_MSG_THREADS_NUM);
-    if (server->threadPool == NULL) {
-        celix_logHelper_error(loghelper, "RsaShmServer: create thread pool err.");
-        return CELIX_ILLEGAL_STATE;
+    status = celixThreadMutex_create(&server->ringConsumersMutex, NULL);
+    if (status != CELIX_SUCCESS) {
+        celix_logHelper_error(loghelper, "RsaShmServer: create ring consumers mutex err.");
+        return status;
+    }
+    celix_autoptr(celix_thread_mutex_t) ringConsumersMutex = &server->ringConsumersMutex;
+    celix_autoptr(celix_array_list_t) ringConsumers = server->ringConsumers = celix_arrayList_create();
+    if (ringConsumers == NULL) {
+        celix_logHelper_error(loghelper, "RsaShmServer: create ring consumers list err.");
+        return CELIX_ENOMEM;
+    }
+
+    celix_autoptr(shm_pool_t) replyPool = NULL;
+    long replyPoolSize = celix_bundleContext_getPropertyAsLong(ctx, RSA_SHM_REPLY_POOL_SIZE_KEY,
+            RSA_SHM_REPLY_POOL_SIZE_DEFAULT);
+    shm_pool_options_t replyPoolOptions = {
+            .size = replyPoolSize,
+            .maxSize = replyPoolSize,
+            .hugePages = celix_bundleContext_getPropertyAsBool(ctx, RSA_SHM_MEMORY_POOL_HUGE_PAGES_KEY,
+                    RSA_SHM_MEMORY_POOL_HUGE_PAGES_DEFAULT),
+    };
+    if (replyPoolSize > 0 && shmPool_createWithOptions(&replyPoolOptions, &replyPool) != CELIX_SUCCESS) {
+        celix_logHelper_logTssErrors(loghelper, CELIX_LOG_LEVEL_WARNING);
+        celix_logHelper_warning(loghelper, "RsaShmServer: create reply shm pool err. Replies are passed in chunks.");
     }
-    celix_auto(threadpool) thpool = server->threadPool;
+    server->replyPool = replyPool;
+    status = celixThreadMutex_create(&server->replyBlocksMutex, NULL);
+    if (status != CELIX_SUCCESS) {
+        celix_logHelper_error(loghelper, "RsaShmServer: create reply blocks mutex err.");
+        return status;
+    }
+    celix_autoptr(celix_thread_mutex_t) replyBlocksMutex = &server->replyBlocksMutex;
+    celix_autoptr(celix_array_list_t) replyBlocks = server->replyBlocks = celix_arrayList_create();
+    if (replyBlocks == NULL) {
+        celix_logHelper_error(loghelper, "RsaShmServer: create reply blocks list err.");
+        return CELIX_ENOMEM;
+    }
+    shmCache_setShmPeerClosedCB(shmCache, rsaShmServer_shmPeerClosed, server);
+
+    long maxConcurrentRequestsPerService = celix_bundleContext_getPropertyAsLong(ctx,
+            RSA_SHM_SERVER_MAX_CONCURRENT_REQUESTS_PER_SERVICE_KEY, RSA_SHM_SERVER_MAX_CONCURRENT_REQUESTS_PER_SERVICE_DEFAULT);
+    if (maxConcurrentRequestsPerService < 0) {
+        maxConcurrentRequestsPerService = 0;
+    }
+    celix_autoptr(rsa_shm_worker_pool_t) workerPool = NULL;
+    status = rsaShmWorkerPool_create(MAX_RSA_SHM_SERVER_HANDLE_MSG_THREADS_NUM,
+            (unsigned int)maxConcurrentRequestsPerService, &workerPool);
+    if (status != CELIX_SUCCESS) {
+        celix_logHelper_error(loghelper, "RsaShmServer: create worker pool err.");
+        return status;
+    }
+    server->workerPool = workerPool;
     server->revCB = receiveCB;
     server->revCBHandle = revHandle;
     server->revMsgThreadActive = true;
@@ -129,7 +202,12 @@ celix_status_t rsaShmServer_create(celix_bundle_context_t *ctx, const char *name
         celix_logHelper_error(loghelper, "RsaShmServer: create receive msg thread err.");
         return status;
     }
-    celix_steal_ptr(thpool);
+    celix_steal_ptr(workerPool);
+    celix_steal_ptr(replyBlocks);
+    celix_steal_ptr(replyBlocksMutex);
+    celix_steal_ptr(replyPool);
+    celix_steal_ptr(ringConsumers);
+    celix_steal_ptr(ringConsumersMutex);
     celix_steal_ptr(shmCache);
     celix_steal_fd(&sfd);
     celix_steal_ptr(serverName);
@@ -142,9 +220,18 @@ void rsaShmServer_destroy(rsa_shm_server_t *server) {
         server->revMsgThreadActive = false;
         shutdown(server->sfd,SHUT_RD);
         celixThread_join(server->revMsgThread, NULL);
-        thpool_wait(server->threadPool);
-        thpool_destroy(server->threadPool);
+        rsaShmServer_stopRingConsumers(server);
+        rsaShmWorkerPool_destroy(server->workerPool);
         shmCache_destroy(server->shmCache);
+        celix_arrayList_destroy(server->ringConsumers);
+        (void)celixThreadMutex_destroy(&server->ringConsumersMutex);
+        //Clients that still read a reply keep the shared memory attached, so the reply pool can be destroyed.
+        for (int i = 0; i < celix_arrayList_size(server->replyBlocks); ++i) {
+            free(celix_arrayList_get(server->replyBlocks, i));
+        }
+        celix_arrayList_destroy(server->replyBlocks);
+        (void)celixThreadMutex_destroy(&server->replyBlocksMutex);
+        shmPool_destroy(server->replyPool);
         close(server->sfd);
         free(server->name);
         free(server);
@@ -158,7 +245,7 @@ static void rsaShmServer_terminateMsgHandling(rsa_shm_msg_control_t *ctrl) {
 
     // weakup client, terminate current interaction
     pthread_mutex_lock(&ctrl->lock);
-    ctrl->msgState = ABEND;
+    __atomic_store_n(&ctrl->msgState, ABEND, __ATOMIC_RELEASE);
     //Signaling the condition variable first, and then unlocking the mutex, because client will free ctrl when msgState is ABEND.
     pthread_cond_signal(&ctrl->signal);
     pthread_mutex_unlock(&ctrl->lock);
@@ -166,13 +253,83 @@ static void rsaShmServer_terminateMsgHandling(rsa_shm_msg_control_t *ctrl) {
     return;
 }
 
+static rsa_shm_reply_block_t *rsaShmServer_createReplyBlock(rsa_shm_server_t *server,
+        const rsa_shm_msg_control_t *msgCtrl, int clientShmId, const struct iovec *reply) {
+    if (server->replyPool == NULL
+            || msgCtrl->size < offsetof(rsa_shm_msg_control_t, replyOffset) + sizeof(msgCtrl->replyOffset)) {
+        return NULL;//The reply is passed in chunks
+    }
+    rsa_shm_server_reply_block_t *entry = (rsa_shm_server_reply_block_t *)malloc(sizeof(*entry));
+    if (entry == NULL) {
+        return NULL;
+    }
+    celixThreadMutex_lock(&server->replyBlocksMutex);
+    rsaShmServer_releaseReplyBlocks(server, -1);
+    rsa_shm_reply_block_t *block = shmPool_malloc(server->replyPool, sizeof(rsa_shm_reply_block_t) + reply->iov_len);
+    celixThreadMutex_unlock(&server->replyBlocksMutex);
+    if (block == NULL) {
+        celix_logHelper_debug(server->loghelper, "RsaShmServer: No reply shm for %zu bytes, the reply is passed in chunks.", reply->iov_len);
+        free(entry);
+        return NULL;
+    }
+    //The block is filled before it is tracked, so that it cannot be released while it is filled.
+    block->consumed = 0;
+    memcpy(block->data, reply->iov_base, reply->iov_len);
+    entry->block = block;
+    entry->clientShmId = clientShmId;
+    celixThreadMutex_lock(&server->replyBlocksMutex);
+    celix_status_t status = celix_arrayList_add(server->replyBlocks, entry);
+    if (status != CELIX_SUCCESS) {
+        shmPool_free(server->replyPool, block);
+    }
+    __atomic_store_n(&server->nrOfReplyBlocks, celix_arrayList_size(server->replyBlocks), __ATOMIC_RELAXED);
+    celixThreadMutex_unlock(&server->replyBlocksMutex);
+    if (status != CELIX_SUCCESS) {
+        free(entry);
+        return NULL;
+    }
+    return block;
+}
+
+static void rsaShmServer_releaseReplyBlocks(rsa_shm_server_t *server, int clientShmId) {
+    //Called with replyBlocksMutex locked. Releases the consumed blocks, and the blocks of the given client which is gone.
+    for (int i = celix_arrayList_size(server->replyBlocks) - 1; i >= 0; --i) {
+        rsa_shm_server_reply_block_t *entry = celix_arrayList_get(server->replyBlocks, i);
+        if (entry->clientShmId == clientShmId || __atomic_load_n(&entry->block->consumed, __ATOMIC_ACQUIRE) != 0) {
+            celix_arrayList_removeAt(server->replyBlocks, i);
+            shmPool_free(server->replyPool, entry->block);
+            free(entry);
+        }
+    }
+    __atomic_store_n(&server->nrOfReplyBlocks, celix_arrayList_size(server->replyBlocks), __ATOMIC_RELAXED);
+}
+
+static void rsaShmServer_releaseConsumedReplyBlocks(rsa_shm_server_t *server) {
+    //Cheap enough to be called for every request: nothing is locked if no reply blocks are in use, and the thread
+    //holding replyBlocksMutex (if any) is already releasing them.
+    if (__atomic_load_n(&server->nrOfReplyBlocks, __ATOMIC_RELAXED) == 0
+            || celixThreadMutex_tryLock(&server->replyBlocksMutex) != CELIX_SUCCESS) {
+        return;
+    }
+    rsaShmServer_releaseReplyBlocks(server, -1);
+    celixThreadMutex_unlock(&server->replyBlocksMutex);
+}
+
+size_t rsaShmServer_getNrOfReplyBlocks(rsa_shm_server_t *server) {
+    return server != NULL ? __atomic_load_n(&server->nrOfReplyBlocks, __ATOMIC_RELAXED) : 0;
+}
+
 static void rsaShmServer_msgHandlingWork(void *data) {
     assert(data != NULL);
     int status = CELIX_SUCCESS;
-    struct rsa_shm_server_thpool_work_data *workData = data;
+    struct rsa_shm_server_work_data *workData = data;
     rsa_shm_server_t *server = workData->server;
     assert(server != NULL);
 
+    //The reply blocks of previous requests are released as soon as possible, so that the reply pool is not
+    //kept full by replies that are already consumed.
+    rsaShmServer_releaseConsumedReplyBlocks(server);
+
     rsa_shm_msg_control_t *msgCtrl = (rsa_shm_msg_control_t *)workData->msgCtrl;
     char *msgBuffer = (char*)workData->msgBody;
     const char *metaDataString = msgBuffer;
@@ -195,6 +352,11 @@ static void rsaShmServer_msgHandlingWork(void *data) {
         goto call_receive_cb_failed;
     }
 
+    rsa_shm_reply_block_t *replyBlock = NULL;
+    if (reply.iov_len > workData->msgBodyTotalSize) {
+        replyBlock = rsaShmServer_createReplyBlock(server, msgCtrl, workData->shmId, &reply);
+    }
+
     char *src = reply.iov_base;
     size_t srcSize = reply.iov_len;
     int waitRet = 0;
@@ -203,8 +365,19 @@ static void rsaShmServer_msgHandlingWork(void *data) {
         if (msgCtrl->msgState == REQ_CANCELLED || waitRet != 0) {
             pthread_mutex_unlock(&msgCtrl->lock);
             celix_logHelper_error(server->loghelper, "RsaShmServer: Client cancelled the request, or timeout. %d.", waitRet);
+            if (replyBlock != NULL) {
+                __atomic_store_n(&replyBlock->consumed, 1, __ATOMIC_RELEASE);
+            }
             goto reply_err;
         }
+        if (replyBlock != NULL) {
+            msgCtrl->replyShmId = shmPool_getMemoryShmId(server->replyPool, replyBlock);
+            msgCtrl->replyOffset = shmPool_getMemoryOffset(server->replyPool, replyBlock);
+            msgCtrl->actualReplyedSize = reply.iov_len;
+            __atomic_store_n(&msgCtrl->msgState, REPLIED, __ATOMIC_RELEASE);
+            pthread_cond_signal(&msgCtrl->signal);
+            break;
+        }
         size_t destSize = workData->msgBodyTotalSize;
         char *dest = msgBuffer;
         size_t bytes = MIN(srcSize, destSize);
@@ -212,14 +385,15 @@ static void rsaShmServer_msgHandlingWork(void *data) {
         src += bytes;
         srcSize -= bytes;
         if (srcSize == 0) {
-            msgCtrl->msgState = REPLIED;
             msgCtrl->actualReplyedSize = bytes;
+            //The client may spin on msgState without holding the lock
+            __atomic_store_n(&msgCtrl->msgState, REPLIED, __ATOMIC_RELEASE);
             //Signaling the condition variable first, and then unlocking the mutex, because client will free ctrl when msgState is REPLIED.
             pthread_cond_signal(&msgCtrl->signal);
             break;
         } else {
-            msgCtrl->msgState = REPLYING;
             msgCtrl->actualReplyedSize = bytes;
+            __atomic_store_n(&msgCtrl->msgState, REPLYING, __ATOMIC_RELEASE);
             pthread_cond_signal(&msgCtrl->signal);
 
             struct timespec timeout = celix_gettime(CLOCK_MONOTONIC);
@@ -261,7 +435,7 @@ static bool rsaShmServer_msgInvalid(rsa_shm_server_t *server, const rsa_shm_msg_
     CELIX_BUILD_ASSERT(offsetof(rsa_shm_msg_t, size) == 0);
     if (msgInfo->size < (offsetof(rsa_shm_msg_t, requestSize) + sizeof(msgInfo->requestSize))
             || msgInfo->shmId < 0 || msgInfo->ctrlDataOffset < 0 || msgInfo->msgBodyOffset < 0
-            || msgInfo->ctrlDataSize != sizeof(rsa_shm_msg_control_t)) {
+            || msgInfo->ctrlDataSize < offsetof(rsa_shm_msg_control_t, actualReplyedSize) + sizeof(size_t)) {
         celix_logHelper_error(server->loghelper, "RsaShmServer: Shm msg info invalid. Msg info:%d, %zd, %zd, %zu.",
                 msgInfo->shmId, msgInfo->ctrlDataOffset, msgInfo->msgBodyOffset, msgInfo->ctrlDataSize);
         return true;
@@ -283,6 +457,214 @@ static bool rsaShmServer_msgCtrlInvalid(rsa_shm_server_t *server, const rsa_shm_
     return false;
 }
 
+static long rsaShmServer_getServiceId(const rsa_shm_msg_t *msgInfo, ssize_t revBytes) {
+    size_t serviceIdEnd = offsetof(rsa_shm_msg_t, serviceId) + sizeof(msgInfo->serviceId);
+    if (revBytes < serviceIdEnd || msgInfo->size < serviceIdEnd) {
+        return -1;//message of a client not passing the service id, whose requests are not limited per service
+    }
+    return msgInfo->serviceId;
+}
+
+static void rsaShmServer_handleRequest(rsa_shm_server_t *server, const rsa_shm_msg_t *msgInfo, long serviceId) {
+    if (rsaShmServer_msgInvalid(server, msgInfo)) {
+        celix_logHelper_error(server->loghelper,"RsaShmServer: Shm message info is invalid. It maybe cause memory leak!");
+        return;
+    }
+    rsa_shm_msg_control_t *msgCtrl = shmCache_getMemoryPtr(server->shmCache,
+            msgInfo->shmId, msgInfo->ctrlDataOffset);
+    if (rsaShmServer_msgCtrlInvalid(server, msgCtrl)) {
+        celix_logHelper_logTssErrors(server->loghelper, CELIX_LOG_LEVEL_ERROR);
+        celix_logHelper_error(server->loghelper, "RsaShmServer: Get msg ctrl cache failed. It maybe cause memory leak!");
+        return;
+    }
+    char *msgBody = shmCache_getMemoryPtr(server->shmCache, msgInfo->shmId,
+            msgInfo->msgBodyOffset);
+    if (msgBody == NULL) {
+        celix_logHelper_error(server->loghelper,"RsaShmServer: Get msg data buffer cache failed.");
+        rsaShmServer_terminateMsgHandling(msgCtrl);
+        shmCache_releaseMemoryPtr(server->shmCache, msgCtrl);
+        return;
+    }
+    struct rsa_shm_server_work_data *workData = ( struct rsa_shm_server_work_data *)malloc(sizeof(*workData));
+    assert(workData != NULL);
+    workData->server = server;
+    workData->msgCtrl = msgCtrl;
+    workData->shmId = msgInfo->shmId;
+    workData->msgBody = msgBody;
+    workData->msgBodyTotalSize = msgInfo->msgBodyTotalSize;
+    workData->metadataSize = msgInfo->metadataSize;
+    workData->requestSize = msgInfo->requestSize;
+    celix_status_t status = rsaShmWorkerPool_submit(server->workerPool, serviceId, rsaShmServer_msgHandlingWork, workData);
+    if (status != CELIX_SUCCESS) {
+        celix_logHelper_error(server->loghelper, "RsaShmServer: Failed to submit msg handling work, error code is %d.", status);
+        rsaShmServer_terminateMsgHandling(msgCtrl);
+        shmCache_releaseMemoryPtr(server->shmCache, msgBody);
+        shmCache_releaseMemoryPtr(server->shmCache, msgCtrl);
+        free(workData);
+    }
+    return;
+}
+
+static void *rsaShmServer_ringConsumerThread(void *data) {
+    rsa_shm_ring_consumer_t *consumer = data;
+    assert(consumer != NULL);
+    rsa_shm_server_t *server = consumer->server;
+    rsa_shm_ring_t *ring = consumer->ring;
+    rsa_shm_spin_t spin;
+    rsaShmSpin_init(&spin);
+    rsa_shm_msg_t msgInfo;
+
+    //After the ring is closed, requests that are still in the ring are handled, unless the client is gone.
+    while (!__atomic_load_n(&consumer->peerClosed, __ATOMIC_ACQUIRE)) {
+        if (rsaShmRing_pop(ring, consumer->capacity, &msgInfo)) {
+            if (msgInfo.msgType != RSA_SHM_MSG_REQUEST) {
+                celix_logHelper_error(server->loghelper, "RsaShmServer: Unexpected msg type %d in request ring.", msgInfo.msgType);
+                continue;
+            }
+            rsaShmServer_handleRequest(server, &msgInfo, rsaShmServer_getServiceId(&msgInfo, sizeof(msgInfo)));
+        } else if (rsaShmRing_isClosed(ring)) {
+            break;
+        } else {
+            //The client consumes a reply block after the request is handled, so it is released when the ring is idle
+            rsaShmServer_releaseConsumedReplyBlocks(server);
+            rsaShmRing_waitForMsg(ring, consumer->capacity, &spin, RSA_SHM_RING_CONSUMER_WAIT_TIMEOUT_IN_MS);
+        }
+    }
+
+    rsaShmRing_detachConsumer(ring);
+    //The ring is released by the joiner of the consumer, so the ring stays valid as long as the consumer is listed.
+    __atomic_store_n(&consumer->finished, true, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+static void rsaShmServer_destroyRingConsumer(rsa_shm_server_t *server, rsa_shm_ring_consumer_t *consumer) {
+    celixThread_join(consumer->thread, NULL);
+    shmCache_releaseMemoryPtr(server->shmCache, consumer->ring);
+    free(consumer);
+}
+
+static void rsaShmServer_joinFinishedRingConsumers(rsa_shm_server_t *server) {
+    rsa_shm_ring_consumer_t *finishedConsumer = NULL;
+    do {
+        finishedConsumer = NULL;
+        celixThreadMutex_lock(&server->ringConsumersMutex);
+        for (int i = celix_arrayList_size(server->ringConsumers) - 1; i >= 0; --i) {
+            rsa_shm_ring_consumer_t *consumer = celix_arrayList_get(server->ringConsumers, i);
+            if (__atomic_load_n(&consumer->finished, __ATOMIC_ACQUIRE)) {
+                celix_arrayList_removeAt(server->ringConsumers, i);
+                finishedConsumer = consumer;
+                break;
+            }
+        }
+        celixThreadMutex_unlock(&server->ringConsumersMutex);
+        //Released without holding the lock, because rsaShmServer_shmPeerClosed takes it while holding the shm cache lock.
+        if (finishedConsumer != NULL) {
+            rsaShmServer_destroyRingConsumer(server, finishedConsumer);
+        }
+    } while (finishedConsumer != NULL);
+}
+
+static void rsaShmServer_attachRing(rsa_shm_server_t *server, const rsa_shm_msg_t *msgInfo) {
+    //Join the consumers of rings that are closed in the meantime
+    rsaShmServer_joinFinishedRingConsumers(server);
+
+    rsa_shm_ring_t *ring = shmCache_getMemoryPtr(server->shmCache, msgInfo->shmId, msgInfo->ctrlDataOffset);
+    if (ring == NULL) {
+        celix_logHelper_logTssErrors(server->loghelper, CELIX_LOG_LEVEL_ERROR);
+        celix_logHelper_error(server->loghelper, "RsaShmServer: Get request ring failed.");
+        return;
+    }
+    uint32_t capacity = 0;
+    if (!rsaShmRing_isValid(ring, msgInfo->ctrlDataSize, &capacity) || !rsaShmRing_attachConsumer(ring)) {
+        celix_logHelper_error(server->loghelper, "RsaShmServer: Request ring is invalid or already attached.");
+        shmCache_releaseMemoryPtr(server->shmCache, ring);
+        return;
+    }
+    rsa_shm_ring_consumer_t *consumer = (rsa_shm_ring_consumer_t *)calloc(1, sizeof(*consumer));
+    if (consumer == NULL) {
+        celix_logHelper_error(server->loghelper, "RsaShmServer: Failed to allocate request ring consumer.");
+        goto consumer_err;
+    }
+    consumer->server = server;
+    consumer->ring = ring;
+    consumer->capacity = capacity;
+    consumer->shmId = msgInfo->shmId;
+    celixThreadMutex_lock(&server->ringConsumersMutex);
+    celix_status_t status = celix_arrayList_add(server->ringConsumers, consumer);
+    if (status == CELIX_SUCCESS) {
+        status = celixThread_create(&consumer->thread, NULL, rsaShmServer_ringConsumerThread, consumer);
+        if (status != CELIX_SUCCESS) {
+            celix_arrayList_remove(server->ringConsumers, consumer);
+        }
+    }
+    celixThreadMutex_unlock(&server->ringConsumersMutex);
+    if (status != CELIX_SUCCESS) {
+        celix_logHelper_error(server->loghelper, "RsaShmServer: Failed to create request ring consumer. %d.", status);
+        free(consumer);
+        goto consumer_err;
+    }
+    celixThread_setName(&consumer->thread, "RsaShmRing");
+    return;
+
+consumer_err:
+    //The client falls back to sending requests using the socket
+    rsaShmRing_detachConsumer(ring);
+    shmCache_releaseMemoryPtr(server->shmCache, ring);
+    return;
+}
+
+static void rsaShmServer_stopRingConsumers(rsa_shm_server_t *server) {
+    //The receive thread is stopped, so consumers are not added or removed concurrently.
+    int size = celix_arrayList_size(server->ringConsumers);
+    celixThreadMutex_lock(&server->ringConsumersMutex);
+    for (int i = 0; i < size; ++i) {
+        rsa_shm_ring_consumer_t *consumer = celix_arrayList_get(server->ringConsumers, i);
+        rsaShmRing_close(consumer->ring);
+    }
+    celixThreadMutex_unlock(&server->ringConsumersMutex);
+    //Join and release without holding the lock, because rsaShmServer_shmPeerClosed takes it while holding the shm
+    //cache lock, which exiting consumers need. rsaShmServer_shmPeerClosed skips the finished consumers.
+    for (int i = 0; i < size; ++i) {
+        rsa_shm_ring_consumer_t *consumer = celix_arrayList_get(server->ringConsumers, i);
+        celixThread_join(consumer->thread, NULL);
+        shmCache_releaseMemoryPtr(server->shmCache, consumer->ring);
+    }
+    celixThreadMutex_lock(&server->ringConsumersMutex);
+    for (int i = 0; i < size; ++i) {
+        free(celix_arrayList_get(server->ringConsumers, i));
+    }
+    celix_arrayList_clear(server->ringConsumers);
+    celixThreadMutex_unlock(&server->ringConsumersMutex);
+}
+
+static void rsaShmServer_shmPeerClosed(void *handle, shm_cache_t *shmCache, int shmId) {
+    (void)shmCache;//unused
+    rsa_shm_server_t *server = handle;
+    celixThreadMutex_lock(&server->replyBlocksMutex);
+    rsaShmServer_releaseReplyBlocks(server, shmId);
+    celixThreadMutex_unlock(&server->replyBlocksMutex);
+
+    //The client is gone, so its requests do not need to be handled anymore.
+    celix_auto(celix_mutex_lock_guard_t) locker = celixMutexLockGuard_init(&server->ringConsumersMutex);
+    int size = celix_arrayList_size(server->ringConsumers);
+    for (int i = 0; i < size; ++i) {
+        rsa_shm_ring_consumer_t *consumer = celix_arrayList_get(server->ringConsumers, i);
+        if (consumer->shmId == shmId && !__atomic_load_n(&consumer->peerClosed, __ATOMIC_ACQUIRE)
+                && !__atomic_load_n(&consumer->finished, __ATOMIC_ACQUIRE)) {
+            __atomic_store_n(&consumer->peerClosed, true, __ATOMIC_RELEASE);
+            rsaShmRing_close(consumer->ring);
+        }
+    }
+}
+
+static rsa_shm_msg_type rsaShmServer_getMsgType(const rsa_shm_msg_t *msgInfo, ssize_t revBytes) {
+    size_t msgTypeEnd = offsetof(rsa_shm_msg_t, msgType) + sizeof(msgInfo->msgType);
+    if (revBytes < msgTypeEnd || msgInfo->size < msgTypeEnd) {
+        return RSA_SHM_MSG_REQUEST;//message of a client not supporting request rings
+    }
+    return msgInfo->msgType;
+}
+
 static void *rsaShmServer_receiveMsgThread(void *data) {
     rsa_shm_server_t *server = data;
     assert(server != NULL);
@@ -299,41 +681,20 @@ static void *rsaShmServer_receiveMsgThread(void *data) {
             celix_logHelper_error(server->loghelper, "RsaShmServer: recv msg err(%d).", errno);
             continue;
         }
-        if (revBytes <= sizeof(msgInfo.size) || rsaShmServer_msgInvalid(server, &msgInfo)) {
+        if (revBytes <= sizeof(msgInfo.size)) {
             celix_logHelper_error(server->loghelper,"RsaShmServer: Shm message info is invalid. It maybe cause memory leak!");
             continue;
         }
-        rsa_shm_msg_control_t *msgCtrl = shmCache_getMemoryPtr(server->shmCache,
-                msgInfo.shmId, msgInfo.ctrlDataOffset);
-        if (rsaShmServer_msgCtrlInvalid(server, msgCtrl)) {
-            celix_logHelper_logTssErrors(server->loghelper, CELIX_LOG_LEVEL_ERROR);
-            celix_logHelper_error(server->loghelper, "RsaShmServer: Get msg ctrl cache failed. It maybe cause memory leak!");
-            continue;
-        }
-        char *msgBody = shmCache_getMemoryPtr(server->shmCache, msgInfo.shmId,
-                msgInfo.msgBodyOffset);
-        if (msgBody == NULL) {
-            celix_logHelper_error(server->loghelper,"RsaShmServer: Get msg data buffer cache failed.");
-            rsaShmServer_terminateMsgHandling(msgCtrl);
-            shmCache_releaseMemoryPtr(server->shmCache, msgCtrl);
-            continue;
-        }
-        struct rsa_shm_server_thpool_work_data *workData = ( struct rsa_shm_server_thpool_work_data *)malloc(sizeof(*workData));
-        assert(workData != NULL);
-        workData->server = server;
-        workData->msgCtrl = msgCtrl;
-        workData->msgBody = msgBody;
-        workData->msgBodyTotalSize = msgInfo.msgBodyTotalSize;
-        workData->metadataSize = msgInfo.metadataSize;
-        workData->requestSize = msgInfo.requestSize;
-        int retVal = thpool_add_work(server->threadPool, (void *)rsaShmServer_msgHandlingWork, (void*)workData);
-        if (retVal != 0) {
-            celix_logHelper_error(server->loghelper, "RsaShmServer: maybe pool thread is full, error code is %d.", retVal);
-            rsaShmServer_terminateMsgHandling(msgCtrl);
-            shmCache_releaseMemoryPtr(server->shmCache, msgBody);
-            shmCache_releaseMemoryPtr(server->shmCache, msgCtrl);
-            free(workData);
-            continue;
+        switch (rsaShmServer_getMsgType(&msgInfo, revBytes)) {
+            case RSA_SHM_MSG_REQUEST:
+                rsaShmServer_handleRequest(server, &msgInfo, rsaShmServer_getServiceId(&msgInfo, revBytes));
+                break;
+            case RSA_SHM_MSG_RING_ATTACH:
+                rsaShmServer_attachRing(server, &msgInfo);
+                break;
+            default:
+                celix_logHelper_error(server->loghelper, "RsaShmServer: Unknown msg type %d.", msgInfo.msgType);
+                break;
         }
     }
 
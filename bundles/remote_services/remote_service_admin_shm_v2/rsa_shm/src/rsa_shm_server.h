@@ -38,6 +38,12 @@ celix_status_t rsaShmServer_create(celix_bundle_context_t *ctx, const char *name
 
 void rsaShmServer_destroy(rsa_shm_server_t *server);
 
+/**
+ * @brief Get the number of reply blocks that are in use. A reply block holds a reply that does not fit in the
+ * shared memory of its request, until the client has consumed it.
+ */
+size_t rsaShmServer_getNrOfReplyBlocks(rsa_shm_server_t *server);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,426 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "rsa_shm_worker_pool.h"
+#include "celix_threads.h"
+#include "celix_long_hash_map.h"
+#include "celix_stdlib_cleanup.h"
+#include <sched.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <assert.h>
+
+typedef struct rsa_shm_worker_pool_job {
+    rsa_shm_worker_pool_job_fn fn;
+    void *data;
+    long key;
+    bool keyLimited;
+    struct rsa_shm_worker_pool_job *next;
+} rsa_shm_worker_pool_job_t;
+
+typedef struct rsa_shm_worker_pool_job_queue {
+    rsa_shm_worker_pool_job_t *head;
+    rsa_shm_worker_pool_job_t *tail;
+    size_t size;//Also read without lock, to skip empty queues
+} rsa_shm_worker_pool_job_queue_t;
+
+typedef struct rsa_shm_worker {
+    rsa_shm_worker_pool_t *pool;
+    unsigned int index;
+    celix_thread_t thread;
+    celix_thread_mutex_t mutex;//protects jobs and idle
+    celix_thread_cond_t wakeUp;
+    rsa_shm_worker_pool_job_queue_t jobs;
+    bool idle;
+} rsa_shm_worker_t;
+
+typedef struct rsa_shm_worker_pool_key_entry {
+    unsigned int runningJobs;
+    rsa_shm_worker_pool_job_queue_t waitingJobs;
+} rsa_shm_worker_pool_key_entry_t;
+
+/*
+ * A submitted job is appended to the queue of a single worker. Workers take jobs from the head of their own queue
+ * and, if it is empty, from the head of the queues of other workers, so jobs are started in submission order as much
+ * as possible.
+ *
+ * A worker without jobs sets its bit in idleWorkers before it looks for jobs a last time and goes to sleep,
+ * while a submitter checks idleWorkers after it queued a job. The bit is cleared by whoever wakes the worker up, so
+ * other submitters do not try to wake it up again. Both use sequentially consistent operations,
+ * so either the worker finds the job or the submitter finds the idle worker and wakes it up.
+ */
+struct rsa_shm_worker_pool {
+    rsa_shm_worker_t *workers[RSA_SHM_WORKER_POOL_MAX_WORKERS];
+    unsigned int nrOfWorkers;
+    unsigned int maxConcurrentJobsPerKey;
+    uint64_t idleWorkers;//bit mask of the idle workers
+    unsigned int nextWorker;
+    size_t pendingJobs;//The submitted jobs that are not finished, and the submit calls in progress
+    bool stopping;//No jobs can be submitted anymore
+    bool workersStopping;
+    celix_thread_mutex_t mutex;//protects keyEntries and is used to wait for jobsDone
+    celix_thread_cond_t jobsDone;
+    celix_long_hash_map_t *keyEntries;//key: job key, value: rsa_shm_worker_pool_key_entry_t *
+};
+
+static void *rsaShmWorkerPool_workerThread(void *data);
+
+static void rsaShmWorkerPool_pushJob(rsa_shm_worker_pool_job_queue_t *queue, rsa_shm_worker_pool_job_t *job) {
+    job->next = NULL;
+    if (queue->tail != NULL) {
+        queue->tail->next = job;
+    } else {
+        queue->head = job;
+    }
+    queue->tail = job;
+    __atomic_store_n(&queue->size, queue->size + 1, __ATOMIC_RELAXED);
+}
+
+static rsa_shm_worker_pool_job_t *rsaShmWorkerPool_popJob(rsa_shm_worker_pool_job_queue_t *queue) {
+    rsa_shm_worker_pool_job_t *job = queue->head;
+    if (job != NULL) {
+        queue->head = job->next;
+        if (queue->head == NULL) {
+            queue->tail = NULL;
+        }
+        __atomic_store_n(&queue->size, queue->size - 1, __ATOMIC_RELAXED);
+    }
+    return job;
+}
+
+static celix_status_t rsaShmWorkerPool_startWorker(rsa_shm_worker_pool_t *pool, unsigned int index) {
+    celix_autofree rsa_shm_worker_t *worker = (rsa_shm_worker_t *)calloc(1, sizeof(*worker));
+    if (worker == NULL) {
+        return CELIX_ENOMEM;
+    }
+    worker->pool = pool;
+    worker->index = index;
+    celix_status_t status = celixThreadMutex_create(&worker->mutex, NULL);
+    if (status != CELIX_SUCCESS) {
+        return status;
+    }
+    celix_autoptr(celix_thread_mutex_t) mutex = &worker->mutex;
+    status = celixThreadCondition_init(&worker->wakeUp, NULL);
+    if (status != CELIX_SUCCESS) {
+        return status;
+    }
+    celix_autoptr(celix_thread_cond_t) wakeUp = &worker->wakeUp;
+    pool->workers[index] = worker;
+    status = celixThread_create(&worker->thread, NULL, rsaShmWorkerPool_workerThread, worker);
+    if (status != CELIX_SUCCESS) {
+        pool->workers[index] = NULL;
+        return status;
+    }
+    celixThread_setName(&worker->thread, "RsaShmWorker");
+    //Workers that are already running steal from the new worker from now on
+    __atomic_store_n(&pool->nrOfWorkers, index + 1, __ATOMIC_RELEASE);
+    celix_steal_ptr(wakeUp);
+    celix_steal_ptr(mutex);
+    celix_steal_ptr(worker);
+    return CELIX_SUCCESS;
+}
+
+static void rsaShmWorkerPool_stopWorkers(rsa_shm_worker_pool_t *pool) {
+    __atomic_store_n(&pool->workersStopping, true, __ATOMIC_SEQ_CST);
+    for (unsigned int i = 0; i < pool->nrOfWorkers; ++i) {
+        rsa_shm_worker_t *worker = pool->workers[i];
+        celixThreadMutex_lock(&worker->mutex);
+        celixThreadCondition_signal(&worker->wakeUp);
+        celixThreadMutex_unlock(&worker->mutex);
+    }
+    for (unsigned int i = 0; i < pool->nrOfWorkers; ++i) {
+        celixThread_join(pool->workers[i]->thread, NULL);
+    }
+    //Workers look into the queues of each other, so they are released after all of them are stopped
+    for (unsigned int i = 0; i < pool->nrOfWorkers; ++i) {
+        rsa_shm_worker_t *worker = pool->workers[i];
+        assert(worker->jobs.head == NULL);
+        (void)celixThreadCondition_destroy(&worker->wakeUp);
+        (void)celixThreadMutex_destroy(&worker->mutex);
+        free(worker);
+        pool->workers[i] = NULL;
+    }
+    pool->nrOfWorkers = 0;
+}
+
+celix_status_t rsaShmWorkerPool_create(unsigned int nrOfWorkers, unsigned int maxConcurrentJobsPerKey,
+        rsa_shm_worker_pool_t **poolOut) {
+    if (nrOfWorkers == 0 || nrOfWorkers > RSA_SHM_WORKER_POOL_MAX_WORKERS || poolOut == NULL) {
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    celix_autofree rsa_shm_worker_pool_t *pool = (rsa_shm_worker_pool_t *)calloc(1, sizeof(*pool));
+    if (pool == NULL) {
+        return CELIX_ENOMEM;
+    }
+    pool->maxConcurrentJobsPerKey = maxConcurrentJobsPerKey;
+    celix_status_t status = celixThreadMutex_create(&pool->mutex, NULL);
+    if (status != CELIX_SUCCESS) {
+        return status;
+    }
+    celix_autoptr(celix_thread_mutex_t) mutex = &pool->mutex;
+    status = celixThreadCondition_init(&pool->jobsDone, NULL);
+    if (status != CELIX_SUCCESS) {
+        return status;
+    }
+    celix_autoptr(celix_thread_cond_t) jobsDone = &pool->jobsDone;
+    celix_autoptr(celix_long_hash_map_t) keyEntries = pool->keyEntries = celix_longHashMap_create();
+    if (keyEntries == NULL) {
+        return CELIX_ENOMEM;
+    }
+    for (unsigned int i = 0; i < nrOfWorkers; ++i) {
+        status = rsaShmWorkerPool_startWorker(pool, i);
+        if (status != CELIX_SUCCESS) {
+            rsaShmWorkerPool_stopWorkers(pool);
+            return status;
+        }
+    }
+    celix_steal_ptr(keyEntries);
+    celix_steal_ptr(jobsDone);
+    celix_steal_ptr(mutex);
+    *poolOut = celix_steal_ptr(pool);
+    return CELIX_SUCCESS;
+}
+
+static void rsaShmWorkerPool_jobsDone(rsa_shm_worker_pool_t *pool, size_t nrOfJobs) {
+    if (__atomic_sub_fetch(&pool->pendingJobs, nrOfJobs, __ATOMIC_SEQ_CST) == 0
+            && __atomic_load_n(&pool->stopping, __ATOMIC_SEQ_CST)) {
+        celixThreadMutex_lock(&pool->mutex);
+        celixThreadCondition_broadcast(&pool->jobsDone);
+        celixThreadMutex_unlock(&pool->mutex);
+    }
+}
+
+void rsaShmWorkerPool_destroy(rsa_shm_worker_pool_t *pool) {
+    if (pool != NULL) {
+        //Submitters increase pendingJobs before they check stopping, so no job is submitted after the wait.
+        __atomic_store_n(&pool->stopping, true, __ATOMIC_SEQ_CST);
+        celixThreadMutex_lock(&pool->mutex);
+        while (__atomic_load_n(&pool->pendingJobs, __ATOMIC_SEQ_CST) > 0) {
+            celixThreadCondition_wait(&pool->jobsDone, &pool->mutex);
+        }
+        celixThreadMutex_unlock(&pool->mutex);
+        rsaShmWorkerPool_stopWorkers(pool);
+        assert(celix_longHashMap_size(pool->keyEntries) == 0);
+        celix_longHashMap_destroy(pool->keyEntries);
+        (void)celixThreadCondition_destroy(&pool->jobsDone);
+        (void)celixThreadMutex_destroy(&pool->mutex);
+        free(pool);
+    }
+}
+
+//Called with the mutex of the worker locked
+static void rsaShmWorkerPool_setIdleLocked(rsa_shm_worker_t *worker, bool idle) {
+    uint64_t mask = (uint64_t)1 << worker->index;
+    worker->idle = idle;
+    if (idle) {
+        __atomic_or_fetch(&worker->pool->idleWorkers, mask, __ATOMIC_SEQ_CST);
+    } else {
+        __atomic_and_fetch(&worker->pool->idleWorkers, ~mask, __ATOMIC_SEQ_CST);
+    }
+}
+
+static bool rsaShmWorkerPool_wakeUpWorker(rsa_shm_worker_t *worker) {
+    bool wokenUp = false;
+    celixThreadMutex_lock(&worker->mutex);
+    if (worker->idle) {
+        rsaShmWorkerPool_setIdleLocked(worker, false);
+        wokenUp = true;
+    }
+    celixThreadMutex_unlock(&worker->mutex);
+    if (wokenUp) {
+        celixThreadCondition_signal(&worker->wakeUp);
+    }
+    return wokenUp;
+}
+
+static void rsaShmWorkerPool_dispatchJob(rsa_shm_worker_pool_t *pool, rsa_shm_worker_pool_job_t *job) {
+    uint64_t idleWorkers = __atomic_load_n(&pool->idleWorkers, __ATOMIC_SEQ_CST);
+    unsigned int index = idleWorkers != 0 ? (unsigned int)__builtin_ctzll(idleWorkers)
+            : __atomic_fetch_add(&pool->nextWorker, 1, __ATOMIC_RELAXED) % pool->nrOfWorkers;
+    rsa_shm_worker_t *worker = pool->workers[index];
+    celixThreadMutex_lock(&worker->mutex);
+    rsaShmWorkerPool_pushJob(&worker->jobs, job);
+    bool wokenUp = worker->idle;
+    if (wokenUp) {
+        rsaShmWorkerPool_setIdleLocked(worker, false);
+    }
+    celixThreadMutex_unlock(&worker->mutex);
+    if (wokenUp) {
+        //Signaled without the lock, so the worker does not wake up only to wait for the lock
+        celixThreadCondition_signal(&worker->wakeUp);
+    } else {
+        //The worker is busy, let an idle worker steal the job.
+        //A read-modify-write orders the read after the queued job, like the update of idleWorkers by a worker.
+        idleWorkers = __atomic_fetch_or(&pool->idleWorkers, 0, __ATOMIC_SEQ_CST);
+        while (idleWorkers != 0) {
+            index = (unsigned int)__builtin_ctzll(idleWorkers);
+            if (rsaShmWorkerPool_wakeUpWorker(pool->workers[index])) {
+                break;
+            }
+            idleWorkers &= ~((uint64_t)1 << index);
+        }
+    }
+}
+
+static celix_status_t rsaShmWorkerPool_admitKeyLimitedJob(rsa_shm_worker_pool_t *pool, rsa_shm_worker_pool_job_t *job,
+        bool *admitted) {
+    celix_auto(celix_mutex_lock_guard_t) locker = celixMutexLockGuard_init(&pool->mutex);
+    rsa_shm_worker_pool_key_entry_t *entry = celix_longHashMap_get(pool->keyEntries, job->key);
+    if (entry == NULL) {
+        celix_autofree rsa_shm_worker_pool_key_entry_t *newEntry = calloc(1, sizeof(*newEntry));
+        if (newEntry == NULL) {
+            return CELIX_ENOMEM;
+        }
+        celix_status_t status = celix_longHashMap_put(pool->keyEntries, job->key, newEntry);
+        if (status != CELIX_SUCCESS) {
+            return status;
+        }
+        entry = celix_steal_ptr(newEntry);
+    }
+    *admitted = entry->runningJobs < pool->maxConcurrentJobsPerKey;
+    if (*admitted) {
+        entry->runningJobs++;
+    } else {
+        rsaShmWorkerPool_pushJob(&entry->waitingJobs, job);
+    }
+    return CELIX_SUCCESS;
+}
+
+static rsa_shm_worker_pool_job_t *rsaShmWorkerPool_finishKeyLimitedJob(rsa_shm_worker_pool_t *pool, long key) {
+    celix_auto(celix_mutex_lock_guard_t) locker = celixMutexLockGuard_init(&pool->mutex);
+    rsa_shm_worker_pool_key_entry_t *entry = celix_longHashMap_get(pool->keyEntries, key);
+    assert(entry != NULL && entry->runningJobs > 0);
+    //The next job of the key takes over the place of the finished job
+    rsa_shm_worker_pool_job_t *next = rsaShmWorkerPool_popJob(&entry->waitingJobs);
+    if (next == NULL && --entry->runningJobs == 0) {
+        (void)celix_longHashMap_remove(pool->keyEntries, key);
+        free(entry);
+    }
+    return next;
+}
+
+celix_status_t rsaShmWorkerPool_submit(rsa_shm_worker_pool_t *pool, long key, rsa_shm_worker_pool_job_fn fn,
+        void *data) {
+    if (pool == NULL || fn == NULL) {
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    //The submit call is pending as well, so that the workers are not stopped before it has woken up a worker
+    __atomic_add_fetch(&pool->pendingJobs, 2, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&pool->stopping, __ATOMIC_SEQ_CST)) {
+        rsaShmWorkerPool_jobsDone(pool, 2);
+        return CELIX_ILLEGAL_STATE;
+    }
+    rsa_shm_worker_pool_job_t *job = (rsa_shm_worker_pool_job_t *)malloc(sizeof(*job));
+    if (job == NULL) {
+        rsaShmWorkerPool_jobsDone(pool, 2);
+        return CELIX_ENOMEM;
+    }
+    job->fn = fn;
+    job->data = data;
+    job->key = key;
+    job->keyLimited = key >= 0 && pool->maxConcurrentJobsPerKey > 0;
+    if (job->keyLimited) {
+        bool admitted = false;
+        celix_status_t status = rsaShmWorkerPool_admitKeyLimitedJob(pool, job, &admitted);
+        if (status != CELIX_SUCCESS) {
+            free(job);
+            rsaShmWorkerPool_jobsDone(pool, 2);
+            return status;
+        }
+        if (!admitted) {
+            rsaShmWorkerPool_jobsDone(pool, 1);
+            return CELIX_SUCCESS;
+        }
+    }
+    rsaShmWorkerPool_dispatchJob(pool, job);
+    rsaShmWorkerPool_jobsDone(pool, 1);
+    return CELIX_SUCCESS;
+}
+
+static rsa_shm_worker_pool_job_t *rsaShmWorkerPool_takeJob(rsa_shm_worker_pool_t *pool, rsa_shm_worker_t *worker) {
+    unsigned int nrOfWorkers = __atomic_load_n(&pool->nrOfWorkers, __ATOMIC_ACQUIRE);
+    for (unsigned int i = 0; i < nrOfWorkers; ++i) {
+        rsa_shm_worker_t *victim = pool->workers[(worker->index + i) % nrOfWorkers];
+        if (__atomic_load_n(&victim->jobs.size, __ATOMIC_SEQ_CST) == 0) {
+            continue;
+        }
+        celixThreadMutex_lock(&victim->mutex);
+        rsa_shm_worker_pool_job_t *job = rsaShmWorkerPool_popJob(&victim->jobs);
+        celixThreadMutex_unlock(&victim->mutex);
+        if (job != NULL) {
+            return job;
+        }
+    }
+    return NULL;
+}
+
+static rsa_shm_worker_pool_job_t *rsaShmWorkerPool_waitForJob(rsa_shm_worker_pool_t *pool, rsa_shm_worker_t *worker) {
+    //Let runnable threads, e.g. submitters, go first, because sleeping and being woken up again costs much more
+    sched_yield();
+    rsa_shm_worker_pool_job_t *job = rsaShmWorkerPool_takeJob(pool, worker);
+    while (job == NULL) {
+        celixThreadMutex_lock(&worker->mutex);
+        rsaShmWorkerPool_setIdleLocked(worker, true);
+        celixThreadMutex_unlock(&worker->mutex);
+        //Jobs submitted before the worker became idle did not wake it up
+        job = rsaShmWorkerPool_takeJob(pool, worker);
+        celixThreadMutex_lock(&worker->mutex);
+        while (job == NULL && worker->idle && !__atomic_load_n(&pool->workersStopping, __ATOMIC_SEQ_CST)) {
+            celixThreadCondition_wait(&worker->wakeUp, &worker->mutex);
+        }
+        if (worker->idle) {
+            rsaShmWorkerPool_setIdleLocked(worker, false);
+        }
+        celixThreadMutex_unlock(&worker->mutex);
+        if (job == NULL) {
+            job = rsaShmWorkerPool_takeJob(pool, worker);
+        }
+        if (job == NULL && __atomic_load_n(&pool->workersStopping, __ATOMIC_SEQ_CST)) {
+            break;
+        }
+    }
+    return job;
+}
+
+static void *rsaShmWorkerPool_workerThread(void *data) {
+    rsa_shm_worker_t *worker = data;
+    assert(worker != NULL);
+    rsa_shm_worker_pool_t *pool = worker->pool;
+    while (true) {
+        rsa_shm_worker_pool_job_t *job = rsaShmWorkerPool_takeJob(pool, worker);
+        if (job == NULL) {
+            job = rsaShmWorkerPool_waitForJob(pool, worker);
+            if (job == NULL) {
+                break;
+            }
+        }
+        job->fn(job->data);
+        if (job->keyLimited) {
+            rsa_shm_worker_pool_job_t *next = rsaShmWorkerPool_finishKeyLimitedJob(pool, job->key);
+            if (next != NULL) {
+                //Queued behind the jobs of other keys, which are submitted in the meantime
+                rsaShmWorkerPool_dispatchJob(pool, next);
+            }
+        }
+        free(job);
+        rsaShmWorkerPool_jobsDone(pool, 1);
+    }
+    return NULL;
+}
@@ -0,0 +1,87 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef _RSA_SHM_WORKER_POOL_H_
+#define _RSA_SHM_WORKER_POOL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include "celix_errno.h"
+#include "celix_cleanup.h"
+
+/**
+ * @brief The maximum number of workers of a rsa_shm_worker_pool_t
+ */
+#define RSA_SHM_WORKER_POOL_MAX_WORKERS 64
+
+/**
+ * @brief A pool of worker threads with a job queue per worker.
+ *
+ * A job is queued at an idle worker if there is one, otherwise at the next worker in turn. Workers that run out of
+ * jobs steal jobs from the queues of other workers, so submitting a job only takes the lock of a single worker queue
+ * and only wakes up a single worker.
+ *
+ * Jobs can be submitted with a key, e.g. a service id. If the pool has a limit of concurrent jobs per key, jobs of a
+ * key exceeding the limit are queued until a job with the same key finishes. So a key with many jobs cannot occupy
+ * all workers, and the jobs of other keys are not queued behind them.
+ */
+typedef struct rsa_shm_worker_pool rsa_shm_worker_pool_t;
+
+/**
+ * @brief A job of a rsa_shm_worker_pool_t.
+ */
+typedef void (*rsa_shm_worker_pool_job_fn)(void *data);
+
+/**
+ * @brief Create a worker pool.
+ *
+ * @param[in] nrOfWorkers The number of worker threads, at most RSA_SHM_WORKER_POOL_MAX_WORKERS.
+ * @param[in] maxConcurrentJobsPerKey The maximum number of concurrent jobs with the same key. 0 means no limit.
+ * @param[out] pool The created pool.
+ * @return @see celix_errno.h
+ */
+celix_status_t rsaShmWorkerPool_create(unsigned int nrOfWorkers, unsigned int maxConcurrentJobsPerKey,
+        rsa_shm_worker_pool_t **pool);
+
+/**
+ * @brief Destroy a worker pool. The submitted jobs are finished first.
+ * No jobs can be submitted while the pool is destroyed.
+ */
+void rsaShmWorkerPool_destroy(rsa_shm_worker_pool_t *pool);
+
+CELIX_DEFINE_AUTOPTR_CLEANUP_FUNC(rsa_shm_worker_pool_t, rsaShmWorkerPool_destroy)
+
+/**
+ * @brief Submit a job.
+ *
+ * @param[in] pool The pool.
+ * @param[in] key The key of the job, used to limit the concurrent jobs with the same key. A negative key is not limited.
+ * @param[in] fn The job function.
+ * @param[in] data The job data, passed to the job function.
+ * @return CELIX_SUCCESS if the job is submitted, CELIX_ILLEGAL_STATE if the pool is destroyed.
+ */
+celix_status_t rsaShmWorkerPool_submit(rsa_shm_worker_pool_t *pool, long key, rsa_shm_worker_pool_job_fn fn,
+        void *data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RSA_SHM_WORKER_POOL_H_ */
@@ -21,8 +21,14 @@
 #include "shm_pool.h"
 #include "malloc_ei.h"
 #include "celix_threads_ei.h"
+#include "eventfd_ei.h"
+#include "socket_ei.h"
 #include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
 #include <string.h>
+#include <sys/shm.h>
 
 class ShmCacheTestSuite : public ::testing::Test {
 public:
@@ -34,7 +40,8 @@ public:
         celix_ei_expect_malloc(nullptr, 0, nullptr);
         celix_ei_expect_celixThreadMutex_create(nullptr, 0, 0);
         celix_ei_expect_celixThread_create(nullptr, 0, 0);
-        celix_ei_expect_celixThreadCondition_init(nullptr, 0, 0);
+        celix_ei_expect_eventfd(nullptr, 0, 0);
+        celix_ei_expect_socket(nullptr, 0, 0);
     }
 protected:
     static void SetUpTestSuite() {
@@ -59,9 +66,25 @@ shm_pool_t* ShmCacheTestSuite::shmPool = nullptr;
 int ShmCacheTestSuite::shmId = -1;
 
 static void shmPeerClosedCallback(void *handle, shm_cache_t *shmCache, int shmId) {
-    (void)handle;
     EXPECT_TRUE(shmCache != nullptr);
     EXPECT_LE(0, shmId);
+    if (handle != nullptr) {
+        static_cast<std::atomic<int>*>(handle)->store(shmId);
+    }
+}
+
+template<typename Pred>
+static bool waitFor(Pred pred) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+    while (!pred() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    return pred();
+}
+
+static bool shmRemoved(int shmId) {
+    struct shmid_ds shmInfo{};
+    return shmctl(shmId, IPC_STAT, &shmInfo) == -1;
 }
 
 TEST_F(ShmCacheTestSuite, CreateDestroyShmCache) {
@@ -102,9 +125,9 @@ TEST_F(ShmCacheTestSuite, CreateShmCacheFailed2) {
 
 TEST_F(ShmCacheTestSuite, CreateShmCacheFailed3) {
     shm_cache_t *shmCache = nullptr;
-    celix_ei_expect_celixThreadCondition_init((void *)&shmCache_create, 0, CELIX_ENOMEM);
+    celix_ei_expect_eventfd((void *)&shmCache_create, 0, -1);
     celix_status_t status = shmCache_create(false, &shmCache);
-    EXPECT_EQ(CELIX_ENOMEM, status);
+    EXPECT_EQ(CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, ENOMEM), status);
 }
 
 TEST_F(ShmCacheTestSuite, CreateShmCacheFailed4) {
@@ -190,6 +213,28 @@ TEST_F(ShmCacheTestSuite, GetMemoryPtrFailedDueToInvalidArgument) {
     shmCache_destroy(shmCache);
 }
 
+TEST_F(ShmCacheTestSuite, GetMemoryPtrFailedToCreateLivenessSocket) {
+    shm_cache_t *shmCache = nullptr;
+    celix_status_t status = shmCache_create(false, &shmCache);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+
+    void *mem = shmPool_malloc(shmPool, 128);
+    EXPECT_TRUE(mem != nullptr);
+    ssize_t memOffset = shmPool_getMemoryOffset(shmPool, mem);
+    EXPECT_LT(0, memOffset);
+
+    celix_ei_expect_socket((void *)&shmCache_getMemoryPtr, 2, -1);
+    void *addr = shmCache_getMemoryPtr(shmCache, shmId, memOffset);
+    EXPECT_TRUE(addr == nullptr);
+
+    addr = shmCache_getMemoryPtr(shmCache, shmId, memOffset);
+    EXPECT_TRUE(addr != nullptr);
+    shmCache_releaseMemoryPtr(shmCache, addr);
+
+    shmPool_free(shmPool, mem);
+    shmCache_destroy(shmCache);
+}
+
 TEST_F(ShmCacheTestSuite, EvictInactiveShmCacheBlock) {
     shm_pool_t *shmPool = nullptr;
     celix_status_t status = shmPool_create(8192, &shmPool);
@@ -216,7 +261,8 @@ TEST_F(ShmCacheTestSuite, EvictInactiveShmCacheBlock) {
     shmPool_free(shmPool, mem);
     shmPool_destroy(shmPool);
 
-    sleep(5);//wait for shm heart beat check
+    //The unused block is detached as soon as the shm pool is destroyed, which removes the shared memory
+    EXPECT_TRUE(waitFor([shmId]{ return shmRemoved(shmId); }));
 
     shmCache_destroy(shmCache);
 }
@@ -233,7 +279,8 @@ TEST_F(ShmCacheTestSuite, PreEvictInactiveShmCacheBlock) {
     status = shmCache_create(false, &shmCache);
     EXPECT_EQ(CELIX_SUCCESS, status);
     EXPECT_TRUE(shmCache != nullptr);
-    shmCache_setShmPeerClosedCB(shmCache, shmPeerClosedCallback, nullptr);
+    std::atomic<int> closedShmId{-1};
+    shmCache_setShmPeerClosedCB(shmCache, shmPeerClosedCallback, &closedShmId);
 
     void *mem = shmPool_malloc(shmPool, 128);
     EXPECT_TRUE(mem != nullptr);
@@ -247,11 +294,37 @@ TEST_F(ShmCacheTestSuite, PreEvictInactiveShmCacheBlock) {
     shmPool_free(shmPool, mem);
     shmPool_destroy(shmPool);
 
-    sleep(5);//wait for shm heart beat check
+    //The peer closed callback is called as soon as the shm pool is destroyed
+    EXPECT_TRUE(waitFor([&closedShmId]{ return closedShmId.load() != -1; }));
+    EXPECT_EQ(shmId, closedShmId.load());
+    EXPECT_FALSE(shmRemoved(shmId));
 
     shmCache_releaseMemoryPtr(shmCache, addr);//Release after shmPool destroyed
+    EXPECT_TRUE(shmRemoved(shmId));
+
+    shmCache_destroy(shmCache);
+}
+
+TEST_F(ShmCacheTestSuite, ShmCacheBlockWithoutLivenessSocket) {
+    int shmId = shmget(IPC_PRIVATE, 8192, SHM_R | SHM_W);
+    EXPECT_LE(0, shmId);//shared memory that is not created by a shm pool
+
+    shm_cache_t *shmCache = nullptr;
+    celix_status_t status = shmCache_create(false, &shmCache);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    std::atomic<int> closedShmId{-1};
+    shmCache_setShmPeerClosedCB(shmCache, shmPeerClosedCallback, &closedShmId);
+
+    void *addr = shmCache_getMemoryPtr(shmCache, shmId, 128);
+    EXPECT_TRUE(addr != nullptr);
+
+    //Without a liveness socket to connect to, the creator is handled as gone
+    EXPECT_TRUE(waitFor([&closedShmId]{ return closedShmId.load() != -1; }));
+    EXPECT_EQ(shmId, closedShmId.load());
 
+    shmCache_releaseMemoryPtr(shmCache, addr);
     shmCache_destroy(shmCache);
+    (void)shmctl(shmId, IPC_RMID, nullptr);
 }
 
 
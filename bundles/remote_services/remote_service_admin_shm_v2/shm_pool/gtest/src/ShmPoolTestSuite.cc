@@ -21,6 +21,7 @@
 #include "malloc_ei.h"
 #include "celix_threads_ei.h"
 #include "sys_shm_ei.h"
+#include "socket_ei.h"
 #include "celix_errno.h"
 #include <gtest/gtest.h>
 
@@ -34,7 +35,8 @@ public:
         celix_ei_expect_malloc(nullptr, 0, nullptr);
         celix_ei_expect_celixThreadMutex_create(nullptr, 0, 0);
         celix_ei_expect_celixThread_create(nullptr, 0, 0);
-        celix_ei_expect_celixThreadCondition_init(nullptr, 0, 0);
+        celix_ei_expect_socket(nullptr, 0, 0);
+        celix_ei_expect_bind(nullptr, 0, 0);
         celix_ei_expect_shmget(nullptr, 0, 0);
         celix_ei_expect_shmat(nullptr, 0, nullptr);
     }
@@ -61,48 +63,46 @@ TEST_F(ShmPoolTestSuite, CreationFailedDueToInvalidArgument) {
 
 TEST_F(ShmPoolTestSuite, CreateShmPoolFailed1) {
     shm_pool_t *shmPool = nullptr;
-    celix_ei_expect_malloc((void *)&shmPool_create, 0, nullptr);
+    celix_ei_expect_malloc((void *)&shmPool_createWithOptions, 0, nullptr);
     celix_status_t status = shmPool_create(10240, &shmPool);
     EXPECT_EQ(CELIX_ENOMEM, status);
 }
 
 TEST_F(ShmPoolTestSuite, CreateShmPoolFailed2) {
     shm_pool_t *shmPool = nullptr;
-    celix_ei_expect_celixThreadMutex_create((void *)&shmPool_create, 0, CELIX_ENOMEM);
+    celix_ei_expect_celixThreadMutex_create((void *)&shmPool_createWithOptions, 0, CELIX_ENOMEM);
     celix_status_t status = shmPool_create(10240, &shmPool);
     EXPECT_EQ(CELIX_ENOMEM, status);
 }
 
 TEST_F(ShmPoolTestSuite, CreateShmPoolFailed3) {
     shm_pool_t *shmPool = nullptr;
-    celix_ei_expect_shmget((void *)&shmPool_create, 0, -1);
-    errno = EACCES;
+    celix_ei_expect_shmget((void *)&shmPool_createWithOptions, 1, -1);
     celix_status_t status = shmPool_create(10240, &shmPool);
-    EXPECT_EQ(CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO,errno), status);
-    errno = 0;
+    EXPECT_EQ(CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO,EACCES), status);
+    EXPECT_EQ(nullptr, shmPool);
 }
 
 TEST_F(ShmPoolTestSuite, CreateShmPoolFailed4) {
     shm_pool_t *shmPool = nullptr;
-    celix_ei_expect_shmat((void *)&shmPool_create, 0, nullptr);
-    errno = ENOMEM;
+    celix_ei_expect_shmat((void *)&shmPool_createWithOptions, 1, nullptr);
     celix_status_t status = shmPool_create(10240, &shmPool);
-    EXPECT_EQ(CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO,errno), status);
-    errno = 0;
+    EXPECT_EQ(CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO,ENOMEM), status);
+    EXPECT_EQ(nullptr, shmPool);
 }
 
 TEST_F(ShmPoolTestSuite, CreateShmPoolFailed5) {
     shm_pool_t *shmPool = nullptr;
-    celix_ei_expect_celixThreadCondition_init((void *)&shmPool_create, 0, CELIX_ENOMEM);
+    celix_ei_expect_socket((void *)&shmPool_createWithOptions, 2, -1);
     celix_status_t status = shmPool_create(10240, &shmPool);
-    EXPECT_EQ(CELIX_ENOMEM, status);
+    EXPECT_EQ(CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO,ENOMEM), status);
 }
 
 TEST_F(ShmPoolTestSuite, CreateShmPoolFailed6) {
     shm_pool_t *shmPool = nullptr;
-    celix_ei_expect_celixThread_create((void *)&shmPool_create, 0, CELIX_BUNDLE_EXCEPTION);
+    celix_ei_expect_bind((void *)&shmPool_createWithOptions, 2, -1);
     celix_status_t status = shmPool_create(10240, &shmPool);
-    EXPECT_EQ(CELIX_BUNDLE_EXCEPTION, status);
+    EXPECT_EQ(CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO,EACCES), status);
 }
 
 TEST_F(ShmPoolTestSuite, DestroyForNullPool) {
@@ -160,3 +160,189 @@ TEST_F(ShmPoolTestSuite, FreeNullPtr) {
     shmPool_destroy(shmPool);
 }
 
+TEST_F(ShmPoolTestSuite, CreateShmPoolWithInvalidOptions) {
+    shm_pool_t *shmPool = nullptr;
+    celix_status_t status = shmPool_createWithOptions(nullptr, &shmPool);
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, status);
+    EXPECT_TRUE(shmPool == nullptr);
+
+    shm_pool_options_t options = {.size = 1, .maxSize = 1024*1024, .hugePages = false};
+    status = shmPool_createWithOptions(&options, &shmPool);
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, status);
+    EXPECT_TRUE(shmPool == nullptr);
+}
+
+TEST_F(ShmPoolTestSuite, GrowShmPool) {
+    shm_pool_t *shmPool = nullptr;
+    shm_pool_options_t options = {.size = 8192, .maxSize = 1024*1024, .hugePages = false};
+    celix_status_t status = shmPool_createWithOptions(&options, &shmPool);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+
+    void *addr1 = shmPool_malloc(shmPool, 128);
+    EXPECT_TRUE(addr1 != nullptr);
+    EXPECT_EQ(shmPool_getShmId(shmPool), shmPool_getMemoryShmId(shmPool, addr1));
+
+    //does not fit in the first segment
+    void *addr2 = shmPool_malloc(shmPool, 64*1024);
+    EXPECT_TRUE(addr2 != nullptr);
+    EXPECT_LE(0, shmPool_getMemoryShmId(shmPool, addr2));
+    EXPECT_NE(shmPool_getMemoryShmId(shmPool, addr1), shmPool_getMemoryShmId(shmPool, addr2));
+    EXPECT_LT(0, shmPool_getMemoryOffset(shmPool, addr2));
+
+    shm_pool_stats_t stats;
+    status = shmPool_getStats(shmPool, &stats);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    EXPECT_EQ(2, stats.segments);
+    EXPECT_LE(8192 + 64*1024, stats.size);
+    EXPECT_GE(1024*1024, stats.size);
+    EXPECT_EQ(1024*1024, stats.maxSize);
+    EXPECT_LE(128 + 64*1024, stats.usedSize);
+    EXPECT_EQ(stats.usedSize, stats.peakUsedSize);
+    EXPECT_EQ(0, stats.failedAllocations);
+
+    shmPool_free(shmPool, addr2);
+    shmPool_free(shmPool, addr1);
+    status = shmPool_getStats(shmPool, &stats);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    EXPECT_EQ(0, stats.usedSize);
+    EXPECT_LE(128 + 64*1024, stats.peakUsedSize);
+
+    shmPool_destroy(shmPool);
+}
+
+TEST_F(ShmPoolTestSuite, GrowShmPoolUpToMaxSize) {
+    shm_pool_t *shmPool = nullptr;
+    shm_pool_options_t options = {.size = 8192, .maxSize = 64*1024, .hugePages = false};
+    celix_status_t status = shmPool_createWithOptions(&options, &shmPool);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+
+    void *addr = shmPool_malloc(shmPool, 64*1024);
+    EXPECT_TRUE(addr == nullptr);
+
+    shm_pool_stats_t stats;
+    status = shmPool_getStats(shmPool, &stats);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    EXPECT_EQ(1, stats.segments);
+    EXPECT_EQ(1, stats.failedAllocations);
+
+    shmPool_destroy(shmPool);
+}
+
+TEST_F(ShmPoolTestSuite, FailedToGrowShmPool) {
+    shm_pool_t *shmPool = nullptr;
+    shm_pool_options_t options = {.size = 8192, .maxSize = 1024*1024, .hugePages = false};
+    celix_status_t status = shmPool_createWithOptions(&options, &shmPool);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+
+    celix_ei_expect_shmget((void *)&shmPool_malloc, 2, -1);
+    void *addr = shmPool_malloc(shmPool, 64*1024);
+    EXPECT_TRUE(addr == nullptr);
+
+    shm_pool_stats_t stats;
+    status = shmPool_getStats(shmPool, &stats);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    EXPECT_EQ(1, stats.segments);
+    EXPECT_EQ(1, stats.failedAllocations);
+
+    shmPool_destroy(shmPool);
+}
+
+TEST_F(ShmPoolTestSuite, MallocPairOfMemory) {
+    shm_pool_t *shmPool = nullptr;
+    shm_pool_options_t options = {.size = 8192, .maxSize = 1024*1024, .hugePages = false};
+    celix_status_t status = shmPool_createWithOptions(&options, &shmPool);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+
+    void *paired = nullptr;
+    void *addr = shmPool_mallocPair(shmPool, 64*1024, 128, &paired);
+    EXPECT_TRUE(addr != nullptr);
+    EXPECT_TRUE(paired != nullptr);
+    EXPECT_EQ(shmPool_getMemoryShmId(shmPool, addr), shmPool_getMemoryShmId(shmPool, paired));
+
+    //exceeds the maximum size of the pool
+    void *paired2 = nullptr;
+    EXPECT_TRUE(shmPool_mallocPair(shmPool, 1024*1024, 128, &paired2) == nullptr);
+    EXPECT_TRUE(paired2 == nullptr);
+
+    EXPECT_TRUE(shmPool_mallocPair(shmPool, 128, 128, nullptr) == nullptr);
+    EXPECT_TRUE(shmPool_mallocPair(nullptr, 128, 128, &paired2) == nullptr);
+
+    shmPool_free(shmPool, paired);
+    shmPool_free(shmPool, addr);
+    shmPool_destroy(shmPool);
+}
+
+TEST_F(ShmPoolTestSuite, MallocPairOfMemoryWhenFirstBlockFillsSegment) {
+    //Find the largest block of a (fixed size) segment, which leaves no room for the paired block in that segment
+    shm_pool_t *fixedPool = nullptr;
+    celix_status_t status = shmPool_create(8192, &fixedPool);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    size_t size = 8192;
+    void *addr = nullptr;
+    while (addr == nullptr && size > 0) {
+        size -= 8;
+        addr = shmPool_malloc(fixedPool, size);
+    }
+    ASSERT_TRUE(addr != nullptr);
+    EXPECT_TRUE(shmPool_malloc(fixedPool, 128) == nullptr);
+    shmPool_free(fixedPool, addr);
+    shmPool_destroy(fixedPool);
+
+    shm_pool_t *shmPool = nullptr;
+    shm_pool_options_t options = {.size = 8192, .maxSize = 1024*1024, .hugePages = false};
+    status = shmPool_createWithOptions(&options, &shmPool);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+
+    //both blocks are allocated in a new segment
+    void *paired = nullptr;
+    addr = shmPool_mallocPair(shmPool, size, 128, &paired);
+    EXPECT_TRUE(addr != nullptr);
+    EXPECT_TRUE(paired != nullptr);
+    EXPECT_EQ(shmPool_getMemoryShmId(shmPool, addr), shmPool_getMemoryShmId(shmPool, paired));
+    EXPECT_NE(shmPool_getShmId(shmPool), shmPool_getMemoryShmId(shmPool, addr));
+
+    shm_pool_stats_t stats;
+    status = shmPool_getStats(shmPool, &stats);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    EXPECT_EQ(2, stats.segments);
+    EXPECT_EQ(0, stats.failedAllocations);
+
+    shmPool_free(shmPool, paired);
+    shmPool_free(shmPool, addr);
+    shmPool_destroy(shmPool);
+}
+
+TEST_F(ShmPoolTestSuite, CreateShmPoolWithHugePages) {
+    shm_pool_t *shmPool = nullptr;
+    shm_pool_options_t options = {.size = 8192, .maxSize = 8192, .hugePages = true};
+    celix_status_t status = shmPool_createWithOptions(&options, &shmPool);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+
+    //If no huge pages are available, normal pages are used
+    shm_pool_stats_t stats;
+    status = shmPool_getStats(shmPool, &stats);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    EXPECT_EQ(1, stats.segments);
+    EXPECT_GE(1, stats.hugePageSegments);
+    void *addr = shmPool_malloc(shmPool, 128);
+    EXPECT_TRUE(addr != nullptr);
+    shmPool_free(shmPool, addr);
+
+    shmPool_destroy(shmPool);
+}
+
+TEST_F(ShmPoolTestSuite, GetMemoryShmIdAndStatsWithInvalidParams) {
+    EXPECT_EQ(-1, shmPool_getMemoryShmId(nullptr, nullptr));
+    shm_pool_stats_t stats;
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, shmPool_getStats(nullptr, &stats));
+
+    shm_pool_t *shmPool = nullptr;
+    celix_status_t status = shmPool_create(8192, &shmPool);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    EXPECT_EQ(-1, shmPool_getMemoryShmId(shmPool, nullptr));
+    int notInPool = 0;
+    EXPECT_EQ(-1, shmPool_getMemoryShmId(shmPool, &notInPool));
+    EXPECT_EQ(-1, shmPool_getMemoryOffset(shmPool, &notInPool));
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, shmPool_getStats(shmPool, nullptr));
+    shmPool_destroy(shmPool);
+}
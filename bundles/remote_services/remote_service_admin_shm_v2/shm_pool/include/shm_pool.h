@@ -25,11 +25,34 @@ extern "C" {
 #endif
 #include "celix_errno.h"
 #include "celix_cleanup.h"
+#include <stdbool.h>
 #include <stddef.h>
 #include <sys/types.h>
 
 typedef struct shm_pool shm_pool_t;
 
+/**
+ * @brief The options of a shared memory pool
+ */
+typedef struct shm_pool_options {
+    size_t size;//The size of the first shared memory segment, it should be greater than or equal to 8192
+    size_t maxSize;//The maximum total size of the shared memory segments. If it is not greater than size, the pool does not grow.
+    bool hugePages;//Whether to back the segments by huge pages. If no huge pages are available, normal pages are used.
+} shm_pool_options_t;
+
+/**
+ * @brief The usage statistics of a shared memory pool
+ */
+typedef struct shm_pool_stats {
+    size_t size;//The total size of the shared memory segments
+    size_t maxSize;//The maximum total size of the shared memory segments
+    unsigned int segments;//The number of shared memory segments
+    unsigned int hugePageSegments;//The number of shared memory segments backed by huge pages
+    size_t usedSize;//The size of the allocated memory, including the allocator overhead
+    size_t peakUsedSize;//The peak of usedSize
+    size_t failedAllocations;//The number of allocations that failed
+} shm_pool_stats_t;
+
 
 /**
  * @brief Create a shared memory pool
@@ -43,7 +66,21 @@ typedef struct shm_pool shm_pool_t;
 celix_status_t shmPool_create(size_t size, shm_pool_t **pool);
 
 /**
- * @brief Get the shared memory id of shared memory pool
+ * @brief Create a shared memory pool, which adds shared memory segments on demand, up to options->maxSize.
+ *
+ * Each segment has its own shared memory id. Use shmPool_getMemoryShmId and shmPool_getMemoryOffset to
+ * pass the location of allocated memory to another process.
+ *
+ * In case of an error, an error message is added to celix_err.
+ *
+ * @param[in] options The pool options
+ * @param[out] pool The shared memory pool instance
+ * @return @see celix_errno.h
+ */
+celix_status_t shmPool_createWithOptions(const shm_pool_options_t *options, shm_pool_t **pool);
+
+/**
+ * @brief Get the shared memory id of the first shared memory segment of shared memory pool
  *
  * @param[in] pool The shared memory pool instance
  * @return Shared memory id/-1
@@ -68,6 +105,19 @@ CELIX_DEFINE_AUTOPTR_CLEANUP_FUNC(shm_pool_t, shmPool_destroy)
  */
 void *shmPool_malloc(shm_pool_t *pool, size_t size);
 
+/**
+ * @brief Allocate two blocks of memory in the same shared memory segment, so that both can be referred to by
+ * the shared memory id of the segment. The pool grows if no segment has room for both blocks.
+ * The blocks are freed separately.
+ *
+ * @param[in] pool The shared memory pool instance
+ * @param[in] size Allocating memory size
+ * @param[in] pairedSize Allocating memory size of the paired block
+ * @param[out] paired The shared memory address of the paired block/NULL
+ * @return Shared memory address/NULL
+ */
+void *shmPool_mallocPair(shm_pool_t *pool, size_t size, size_t pairedSize, void **paired);
+
 /**
  * @brief Free shared memory
  *
@@ -81,10 +131,28 @@ void shmPool_free(shm_pool_t *pool, void *ptr);
  *
  * @param[in] pool The shared memory pool instance
  * @param[in] ptr Shared memory address
- * @return Shared memory offset
+ * @return Shared memory offset/-1
  */
 ssize_t shmPool_getMemoryOffset(shm_pool_t *pool, void *ptr);
 
+/**
+ * @brief Get the id of the shared memory segment that contains the memory
+ *
+ * @param[in] pool The shared memory pool instance
+ * @param[in] ptr Shared memory address
+ * @return Shared memory id/-1
+ */
+int shmPool_getMemoryShmId(shm_pool_t *pool, void *ptr);
+
+/**
+ * @brief Get the usage statistics of shared memory pool
+ *
+ * @param[in] pool The shared memory pool instance
+ * @param[out] stats The usage statistics
+ * @return @see celix_errno.h
+ */
+celix_status_t shmPool_getStats(shm_pool_t *pool, shm_pool_stats_t *stats);
+
 /**
  * @brief Scoped guard for shared memory pool allocation.
  */
@@ -20,31 +20,44 @@
 #include <shm_cache.h>
 #include <shm_pool_private.h>
 #include <celix_errno.h>
-#include <celix_array_list.h>
 #include <celix_long_hash_map.h>
 #include <celix_threads.h>
 #include "celix_err.h"
 #include "celix_stdlib_cleanup.h"
+#include "celix_unistd_cleanup.h"
 #include <stdlib.h>
+#include <stdint.h>
 #include <assert.h>
+#include <errno.h>
+#include <unistd.h>
+#include <poll.h>
 #include <sys/shm.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+#define SHM_CACHE_WATCHER_STOP_EVENT UINT64_MAX
+#define SHM_CACHE_WATCHER_MAX_EVENTS 16
 
 typedef struct shm_cache_block {
     int shmId;
     void *shmStartAddr;
     struct shm_pool_shared_info *sharedInfo;
-    uint64_t lastHeartbeatCnt;
+    int livenessFd;//Connection to the liveness socket of the shared memory creator, hung up when the creator is gone
+    bool peerClosed;
     unsigned int refCnt;
     size_t maxOffset;
 }shm_cache_block_t;
 
 struct shm_cache{
     bool shmRdOnly;
+    int epollFd;//Watches the liveness connections of the blocks
+    int eventFd;//Wakes up the watcher thread to stop it
     celix_thread_mutex_t mutex;// projects below
     celix_long_hash_map_t *shmCacheBlocks;
     celix_thread_t shmWatcherThread;
     bool watcherActive;
-    celix_thread_cond_t watcherStopped;
     shmCache_shmPeerClosedCB shmPeerClosedCB;
     void *closedCbHandle;
 };
@@ -74,12 +87,31 @@ celix_status_t shmCache_create(bool shmRdOnly, shm_cache_t **shmCache) {
     celix_autoptr(celix_long_hash_map_t) shmCacheBlocks = cache->shmCacheBlocks = celix_longHashMap_create();
     assert(cache->shmCacheBlocks != NULL);
 
-    status = celixThreadCondition_init(&cache->watcherStopped, NULL);
-    if (status != CELIX_SUCCESS) {
-        celix_err_pushf("Shm cache: Error creating stoped condition for cache watcher. %d.\n", status);
+    cache->eventFd = eventfd(0, EFD_CLOEXEC);
+    if (cache->eventFd == -1) {
+        status = CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, errno);
+        celix_err_pushf("Shm cache: Error creating event fd for cache watcher. %d.\n", errno);
+        return status;
+    }
+    celix_auto(celix_fd_t) eventFd = cache->eventFd;
+    cache->epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (cache->epollFd == -1) {
+        // LCOV_EXCL_START
+        status = CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, errno);
+        celix_err_pushf("Shm cache: Error creating epoll fd for cache watcher. %d.\n", errno);
+        return status;
+        // LCOV_EXCL_STOP
+    }
+    celix_auto(celix_fd_t) epollFd = cache->epollFd;
+    struct epoll_event event = {.events = EPOLLIN, .data.u64 = SHM_CACHE_WATCHER_STOP_EVENT};
+    if (epoll_ctl(cache->epollFd, EPOLL_CTL_ADD, cache->eventFd, &event) == -1) {
+        // LCOV_EXCL_START
+        status = CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO, errno);
+        celix_err_pushf("Shm cache: Error watching event fd. %d.\n", errno);
         return status;
+        // LCOV_EXCL_STOP
     }
-    celix_autoptr(celix_thread_cond_t) watcherStopped = &cache->watcherStopped;
+
     cache->watcherActive = true;
     status = celixThread_create(&cache->shmWatcherThread, NULL,
             shmCache_WatcherThread, cache);
@@ -88,7 +120,8 @@ celix_status_t shmCache_create(bool shmRdOnly, shm_cache_t **shmCache) {
         return status;
     }
 
-    celix_steal_ptr(watcherStopped);
+    celix_steal_fd(&epollFd);
+    celix_steal_fd(&eventFd);
     celix_steal_ptr(shmCacheBlocks);
     celix_steal_ptr(mutex);
     *shmCache = celix_steal_ptr(cache);
@@ -106,6 +139,30 @@ void shmCache_setShmPeerClosedCB(shm_cache_t *shmCache, shmCache_shmPeerClosedCB
     return ;
 }
 
+static int shmCache_connectLiveness(shm_cache_t *shmCache, int shmId, const struct shm_pool_shared_info *sharedInfo) {
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+    if (fd == -1) {
+        celix_err_pushf("Shm cache: Error creating liveness socket for shmid %d. %d.\n", shmId, errno);
+        return -1;
+    }
+    if (sharedInfo->size >= offsetof(struct shm_pool_shared_info, livenessSocketName) + sizeof(sharedInfo->livenessSocketName)) {
+        struct sockaddr_un addr;
+        socklen_t addrLen = shmPool_livenessSocketAddress(sharedInfo->livenessSocketName, &addr);
+        //If the connection fails, the creator is gone (or unknown). The socket is not connected then, and is reported as
+        //hung up by epoll, so the block is handled as any other block whose creator is gone.
+        (void)connect(fd, (struct sockaddr *)&addr, addrLen);
+    }
+    struct epoll_event event = {.events = EPOLLRDHUP, .data.u64 = (uint64_t)shmId};
+    if (epoll_ctl(shmCache->epollFd, EPOLL_CTL_ADD, fd, &event) == -1) {
+        // LCOV_EXCL_START
+        celix_err_pushf("Shm cache: Error watching liveness socket for shmid %d. %d.\n", shmId, errno);
+        (void)close(fd);
+        return -1;
+        // LCOV_EXCL_STOP
+    }
+    return fd;
+}
+
 static shm_cache_block_t * shmCache_createBlock(shm_cache_t *shmCache, int shmId) {
     shm_cache_block_t *shmBlock = NULL;
     void *shmStartAddr = NULL;
@@ -114,23 +171,31 @@ static shm_cache_block_t * shmCache_createBlock(shm_cache_t *shmCache, int shmId
     } else {
         shmStartAddr = shmat(shmId, NULL, 0);
     }
-    if (shmStartAddr != (void*)-1) {
-        shmBlock = (shm_cache_block_t *)malloc(sizeof(shm_cache_block_t));
-        assert(shmBlock != NULL);
-        shmBlock->shmId = shmId;
-        shmBlock->shmStartAddr = shmStartAddr;
-        shmBlock->sharedInfo = (struct shm_pool_shared_info *)shmStartAddr;
-        shmBlock->lastHeartbeatCnt = 0;
-        shmBlock->refCnt = 1;
-        shmBlock->maxOffset = 0;
-    } else {
+    if (shmStartAddr == (void*)-1) {
         celix_err_pushf("Shm cache: Error attaching shared memory for shmid %d. %d.\n", shmId, errno);
+        return NULL;
+    }
+    struct shm_pool_shared_info *sharedInfo = (struct shm_pool_shared_info *)shmStartAddr;
+    int livenessFd = shmCache_connectLiveness(shmCache, shmId, sharedInfo);
+    if (livenessFd == -1) {
+        shmdt(shmStartAddr);
+        return NULL;
     }
+    shmBlock = (shm_cache_block_t *)malloc(sizeof(shm_cache_block_t));
+    assert(shmBlock != NULL);
+    shmBlock->shmId = shmId;
+    shmBlock->shmStartAddr = shmStartAddr;
+    shmBlock->sharedInfo = sharedInfo;
+    shmBlock->livenessFd = livenessFd;
+    shmBlock->peerClosed = false;
+    shmBlock->refCnt = 1;
+    shmBlock->maxOffset = 0;
     return shmBlock;
 }
 
 static void shmCache_destroyBlock(shm_cache_t *shmCache, shm_cache_block_t *shmBlock) {
     (void)shmCache;//unused
+    close(shmBlock->livenessFd);//also removes it from the epoll set
     shmdt(shmBlock->shmStartAddr);
     free(shmBlock);
     return ;
@@ -164,6 +229,7 @@ void * shmCache_getMemoryPtr(shm_cache_t *shmCache, int shmId, ssize_t memoryOff
 void shmCache_releaseMemoryPtr(shm_cache_t *shmCache, void *ptr) {
     if (shmCache != NULL && ptr != NULL) {
         celixThreadMutex_lock(&shmCache->mutex);
+        shm_cache_block_t *evictedBlock = NULL;
         CELIX_LONG_HASH_MAP_ITERATE(shmCache->shmCacheBlocks, iter) {
             shm_cache_block_t *shmBlock = (shm_cache_block_t *)iter.value.ptrValue;
             if (shmBlock->shmStartAddr <= ptr && ptr <= shmBlock->shmStartAddr + shmBlock->maxOffset ) {
@@ -172,9 +238,17 @@ void shmCache_releaseMemoryPtr(shm_cache_t *shmCache, void *ptr) {
                 } else {
                     assert(0);//should never happen
                 }
+                if (shmBlock->refCnt == 0 && shmBlock->peerClosed) {
+                    evictedBlock = shmBlock;
+                }
                 break;
             }
         }
+        // Close the shared memory cache block whose creator is gone, once it is not used anymore.
+        if (evictedBlock != NULL) {
+            celix_longHashMap_remove(shmCache->shmCacheBlocks, evictedBlock->shmId);
+            shmCache_destroyBlock(shmCache, evictedBlock);
+        }
         celixThreadMutex_unlock(&shmCache->mutex);
     }
     return;
@@ -185,77 +259,69 @@ void shmCache_destroy(shm_cache_t *shmCache) {
         celixThreadMutex_lock(&shmCache->mutex);
         shmCache->watcherActive = false;
         celixThreadMutex_unlock(&shmCache->mutex);
-        celixThreadCondition_signal(&shmCache->watcherStopped);
+        (void)eventfd_write(shmCache->eventFd, 1);
         celixThread_join(shmCache->shmWatcherThread, NULL);
-        celixThreadCondition_destroy(&shmCache->watcherStopped);
         CELIX_LONG_HASH_MAP_ITERATE(shmCache->shmCacheBlocks, iter) {
             shm_cache_block_t *shmBlock = (shm_cache_block_t *)iter.value.ptrValue;
             assert(shmBlock->refCnt == 0);//should be 0, otherwise memory leak
             shmCache_destroyBlock(shmCache, shmBlock);
         }
         celix_longHashMap_destroy(shmCache->shmCacheBlocks);
+        close(shmCache->epollFd);
+        close(shmCache->eventFd);
         celixThreadMutex_destroy(&shmCache->mutex);
         free(shmCache);
     }
     return ;
 }
 
+static void shmCache_handlePeerClosed(shm_cache_t *shmCache, int shmId) {
+    shm_cache_block_t *shmBlock = celix_longHashMap_get(shmCache->shmCacheBlocks, shmId);
+    if (shmBlock == NULL || shmBlock->peerClosed) {
+        return;
+    }
+    //The event may belong to an evicted block whose shmid has been reused, so check that the connection is hung up.
+    struct pollfd pfd = {.fd = shmBlock->livenessFd, .events = POLLRDHUP, .revents = 0};
+    if (poll(&pfd, 1, 0) != 1 || (pfd.revents & (POLLHUP | POLLRDHUP | POLLERR)) == 0) {
+        return;
+    }
+    (void)epoll_ctl(shmCache->epollFd, EPOLL_CTL_DEL, shmBlock->livenessFd, NULL);
+    shmBlock->peerClosed = true;
+    if (shmBlock->refCnt == 0) {
+        // Close the shared memory cache block right away if it is not used.
+        celix_longHashMap_remove(shmCache->shmCacheBlocks, shmId);
+        shmCache_destroyBlock(shmCache, shmBlock);
+    } else if (shmCache->shmPeerClosedCB != NULL) {
+        //The block is closed when it is released, see shmCache_releaseMemoryPtr
+        shmCache->shmPeerClosedCB(shmCache->closedCbHandle, shmCache, shmId);
+    }
+}
+
 static void * shmCache_WatcherThread(void *data) {
     shm_cache_t *shmCache = (shm_cache_t *)data;
     assert(shmCache !=  NULL);
+    struct epoll_event events[SHM_CACHE_WATCHER_MAX_EVENTS];
     bool active = true;
-    celix_array_list_t *preEvictedBlocks = celix_arrayList_create();
-    celix_array_list_t *evictedBlocks = celix_arrayList_create();
-    assert(preEvictedBlocks != NULL);
     while (active) {
-        celixThreadMutex_lock(&shmCache->mutex);
-        int waitRet = 0;
-        while (shmCache->watcherActive && waitRet != ETIMEDOUT) {
-            // pthread_cond_timedwait shall not return an error code of [EINTR]，refer https://man7.org/linux/man-pages/man3/pthread_cond_timedwait.3p.html
-            waitRet = celixThreadCondition_timedwaitRelative(&shmCache->watcherStopped, &shmCache->mutex, 2 * SHM_HEART_BEAT_UPDATE_INTERVAL_IN_S, 0);
-        }
-        active = shmCache->watcherActive;
-        if (waitRet != ETIMEDOUT) {
-            celixThreadMutex_unlock(&shmCache->mutex);
-            continue;
-        }
-
-        CELIX_LONG_HASH_MAP_ITERATE(shmCache->shmCacheBlocks, iter) {
-            shm_cache_block_t *shmBlock = (shm_cache_block_t *)iter.value.ptrValue;
-            if (shmBlock->sharedInfo->heartbeatCnt == shmBlock->lastHeartbeatCnt) {
-                if (shmBlock->refCnt == 0) {
-                    celix_arrayList_add(evictedBlocks, shmBlock);
-                } else {
-                    celix_arrayList_add(preEvictedBlocks, shmBlock);
-                }
-            } else {
-                shmBlock->lastHeartbeatCnt = shmBlock->sharedInfo->heartbeatCnt;
+        int nfds = epoll_wait(shmCache->epollFd, events, SHM_CACHE_WATCHER_MAX_EVENTS, -1);
+        if (nfds == -1) {
+            // LCOV_EXCL_START
+            if (errno != EINTR) {
+                celix_err_pushf("Shm cache: Error waiting for liveness events. %d.\n", errno);
+                break;
             }
+            continue;
+            // LCOV_EXCL_STOP
         }
-
-        // Close shared memory cache blocks that them are inactive.
-        size_t size = celix_arrayList_size(evictedBlocks);
-        for (int i = 0; i < size; ++i) {
-            shm_cache_block_t *shmBlock = celix_arrayList_get(evictedBlocks, i);
-            celix_longHashMap_remove(shmCache->shmCacheBlocks, shmBlock->shmId);
-            shmCache_destroyBlock(shmCache, shmBlock);
-        }
-        celix_arrayList_clear(evictedBlocks);
-
-        size = celix_arrayList_size(preEvictedBlocks);
-        for (int i = 0; i < size; ++i) {
-            shm_cache_block_t *shmBlock = celix_arrayList_get(preEvictedBlocks, i);
-            if (shmCache->shmPeerClosedCB != NULL) {
-                shmCache->shmPeerClosedCB(shmCache->closedCbHandle, shmCache, shmBlock->shmId);
+        celixThreadMutex_lock(&shmCache->mutex);
+        active = shmCache->watcherActive;
+        for (int i = 0; i < nfds && active; ++i) {
+            if (events[i].data.u64 != SHM_CACHE_WATCHER_STOP_EVENT) {
+                shmCache_handlePeerClosed(shmCache, (int)events[i].data.u64);
             }
         }
-        celix_arrayList_clear(preEvictedBlocks);
-
         celixThreadMutex_unlock(&shmCache->mutex);
     }
 
-    celix_arrayList_destroy(evictedBlocks);
-    celix_arrayList_destroy(preEvictedBlocks);
-
     return NULL;
-}
\ No newline at end of file
+}
@@ -26,99 +26,190 @@
 #include <stdbool.h>
 #include <sys/ipc.h>
 #include <sys/shm.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <stdio.h>
 #include <errno.h>
 #include <assert.h>
 
+//The maximum number of shared memory segments of a pool. As each segment is at least as large as all previous ones
+//together (unless the maximum pool size is reached), this allows a pool to grow a lot.
+#define SHM_POOL_MAX_SEGMENTS 16
 
-struct shm_pool{
-    celix_thread_mutex_t mutex;// projects below
+//Segments backed by huge pages are rounded up to a multiple of the (default) huge page size.
+#define SHM_POOL_HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+typedef struct shm_pool_segment {
     int shmId;
     void *shmStartAddr;
+    size_t size;
     struct shm_pool_shared_info *sharedInfo;
-    celix_thread_t shmHeartbeatThread;
-    bool heartbeatThreadActive;
-    celix_thread_cond_t heartbeatThreadStoped;
     tlsf_t allocator;
-};
+    bool hugePages;
+    int livenessFd;//The liveness socket, which hangs up the connections of the processes attaching the segment when closed
+} shm_pool_segment_t;
 
-static void *shmPool_heartbeatThread(void *data);
+struct shm_pool{
+    celix_thread_mutex_t mutex;// projects below
+    shm_pool_segment_t segments[SHM_POOL_MAX_SEGMENTS];
+    unsigned int nrOfSegments;
+    size_t size;//The total size of the segments
+    size_t maxSize;
+    bool hugePages;
+    size_t usedSize;
+    size_t peakUsedSize;
+    size_t failedAllocations;
+};
 
-celix_status_t shmPool_create(size_t size, shm_pool_t **pool) {
-    celix_status_t status = CELIX_SUCCESS;
-    size_t normalizedSharedInfoSize = (sizeof(struct shm_pool_shared_info) % sizeof(void *) == 0) ?
+static size_t shmPool_normalizedSharedInfoSize(void) {
+    return (sizeof(struct shm_pool_shared_info) % sizeof(void *) == 0) ?
             sizeof(struct shm_pool_shared_info) : (sizeof(struct shm_pool_shared_info)+sizeof(void *))/sizeof(void *) * sizeof(void *);
-    if (size <= tlsf_size() + normalizedSharedInfoSize || pool == NULL) {
-        celix_err_pushf("Shm pool: Shm size should be greater than %zu.\n", tlsf_size());
-        status = CELIX_ILLEGAL_ARGUMENT;
-        goto shm_size_invalid;
-    }
+}
 
-    shm_pool_t *shmPool = (shm_pool_t *)malloc(sizeof(*shmPool));
-    if (shmPool == NULL) {
-        status = CELIX_ENOMEM;
-        goto alloc_failed;
+static int shmPool_listenLiveness(int shmId, struct shm_pool_shared_info *sharedInfo) {
+    (void)snprintf(sharedInfo->livenessSocketName, sizeof(sharedInfo->livenessSocketName), "celix_shm_pool_%d_%d",
+            (int)getpid(), shmId);
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd == -1) {
+        int err = errno;
+        celix_err_pushf("Shm pool: Error creating liveness socket. %d.\n", err);
+        errno = err;
+        return -1;
     }
+    struct sockaddr_un addr;
+    socklen_t addrLen = shmPool_livenessSocketAddress(sharedInfo->livenessSocketName, &addr);
+    //Connections are never accepted, so the backlog limits the number of processes that can attach the segment.
+    if (bind(fd, (struct sockaddr *)&addr, addrLen) == -1 || listen(fd, SOMAXCONN) == -1) {
+        int err = errno;
+        celix_err_pushf("Shm pool: Error listening on liveness socket %s. %d.\n", sharedInfo->livenessSocketName, err);
+        (void)close(fd);
+        errno = err;
+        return -1;
+    }
+    return fd;
+}
 
-    status = celixThreadMutex_create(&shmPool->mutex, NULL);
-    if(status != CELIX_SUCCESS) {
-        goto shm_pool_mutex_err;
+static celix_status_t shmPool_addSegment(shm_pool_t *pool, size_t size) {
+    assert(pool->nrOfSegments < SHM_POOL_MAX_SEGMENTS);
+    int shmId = -1;
+    bool hugePages = false;
+#ifdef SHM_HUGETLB
+    if (pool->hugePages) {
+        size_t hugePagesSize = (size + SHM_POOL_HUGE_PAGE_SIZE - 1) / SHM_POOL_HUGE_PAGE_SIZE * SHM_POOL_HUGE_PAGE_SIZE;
+        shmId = shmget(IPC_PRIVATE, hugePagesSize, SHM_R | SHM_W | SHM_HUGETLB);
+        if (shmId != -1) {
+            size = hugePagesSize;
+            hugePages = true;
+        }
+        //else no huge pages are available, normal pages are used instead
     }
+#endif
     /* Specify the IPC_PRIVATE constant as the key value to the `shmget` when creating the
      * IPC object, which always results in the creation of a new IPC object that is guaranteed to have a unique key.
      * And other process can use 'shmat' to attach relevant shared memory.
      */
-    shmPool->shmId = shmget(IPC_PRIVATE, size, SHM_R | SHM_W);
-    if (shmPool->shmId  == -1) {
+    if (shmId == -1) {
+        shmId = shmget(IPC_PRIVATE, size, SHM_R | SHM_W);
+    }
+    if (shmId == -1) {
+        celix_status_t status = CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO,errno);
         celix_err_pushf("Shm pool: Error getting shm. %d.\n",errno);
-        status = CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO,errno);
-        goto err_getting_shm;
+        return status;
     }
-    shmPool->shmStartAddr = shmat(shmPool->shmId, NULL, 0);
-    if (shmPool->shmStartAddr == NULL) {
+    void *shmStartAddr = shmat(shmId, NULL, 0);
+    if (shmStartAddr == NULL || shmStartAddr == (void *)-1) {
+        celix_status_t status = CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO,errno);
         celix_err_pushf("Shm pool: Error attaching shm, %d.\n",errno);
-        status = CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO,errno);
-        goto err_attaching_shm;
+        (void)shmctl(shmId, IPC_RMID, NULL);
+        return status;
     }
 
-    shmPool->sharedInfo = (struct shm_pool_shared_info *)shmPool->shmStartAddr;
-    shmPool->sharedInfo->heartbeatCnt = 1;
-    shmPool->sharedInfo->size = sizeof(struct shm_pool_shared_info);
+    struct shm_pool_shared_info *sharedInfo = (struct shm_pool_shared_info *)shmStartAddr;
+    sharedInfo->size = sizeof(struct shm_pool_shared_info);
+    int livenessFd = shmPool_listenLiveness(shmId, sharedInfo);
+    if (livenessFd == -1) {
+        celix_status_t status = CELIX_ERROR_MAKE(CELIX_FACILITY_CERRNO,errno);
+        (void)shmdt(shmStartAddr);
+        (void)shmctl(shmId, IPC_RMID, NULL);
+        return status;
+    }
 
-    void *poolMem = shmPool->shmStartAddr + normalizedSharedInfoSize;
-    shmPool->allocator = tlsf_create_with_pool(poolMem, size - normalizedSharedInfoSize);
-    if (shmPool->allocator == NULL) {
+    size_t normalizedSharedInfoSize = shmPool_normalizedSharedInfoSize();
+    tlsf_t allocator = tlsf_create_with_pool(shmStartAddr + normalizedSharedInfoSize, size - normalizedSharedInfoSize);
+    if (allocator == NULL) {
         celix_err_pushf("Shm pool: Error creating shm pool allocator.\n");
-        status = CELIX_ILLEGAL_STATE;
-        goto allocator_err;
+        (void)close(livenessFd);
+        (void)shmdt(shmStartAddr);
+        (void)shmctl(shmId, IPC_RMID, NULL);
+        return CELIX_ILLEGAL_STATE;
     }
+    //The segment is removed when the last process detaches it
+    (void)shmctl(shmId, IPC_RMID, NULL);
 
-    status = celixThreadCondition_init(&shmPool->heartbeatThreadStoped, NULL);
-    if (status != CELIX_SUCCESS) {
-        celix_err_pushf("Shm pool: Error creating stoped condition for heartbeat thread. %d.\n", status);
-        goto stopped_cond_err;
+    shm_pool_segment_t *segment = &pool->segments[pool->nrOfSegments++];
+    segment->shmId = shmId;
+    segment->shmStartAddr = shmStartAddr;
+    segment->size = size;
+    segment->sharedInfo = sharedInfo;
+    segment->allocator = allocator;
+    segment->hugePages = hugePages;
+    segment->livenessFd = livenessFd;
+    pool->size += size;
+    return CELIX_SUCCESS;
+}
+
+static void shmPool_removeSegments(shm_pool_t *pool) {
+    for (unsigned int i = 0; i < pool->nrOfSegments; ++i) {
+        tlsf_destroy(pool->segments[i].allocator);
+        (void)close(pool->segments[i].livenessFd);
+        (void)shmdt(pool->segments[i].shmStartAddr);
+    }
+    pool->nrOfSegments = 0;
+    pool->size = 0;
+}
+
+celix_status_t shmPool_create(size_t size, shm_pool_t **pool) {
+    shm_pool_options_t options = {.size = size, .maxSize = size, .hugePages = false};
+    return shmPool_createWithOptions(&options, pool);
+}
+
+celix_status_t shmPool_createWithOptions(const shm_pool_options_t *options, shm_pool_t **pool) {
+    celix_status_t status = CELIX_SUCCESS;
+    if (options == NULL || options->size <= tlsf_size() + shmPool_normalizedSharedInfoSize() || pool == NULL) {
+        celix_err_pushf("Shm pool: Shm size should be greater than %zu.\n", tlsf_size());
+        status = CELIX_ILLEGAL_ARGUMENT;
+        goto shm_size_invalid;
+    }
+
+    shm_pool_t *shmPool = (shm_pool_t *)malloc(sizeof(*shmPool));
+    if (shmPool == NULL) {
+        status = CELIX_ENOMEM;
+        goto alloc_failed;
     }
-    shmPool->heartbeatThreadActive = true;
-    status = celixThread_create(&shmPool->shmHeartbeatThread, NULL,
-            shmPool_heartbeatThread, shmPool);
+    shmPool->nrOfSegments = 0;
+    shmPool->size = 0;
+    shmPool->usedSize = 0;
+    shmPool->peakUsedSize = 0;
+    shmPool->failedAllocations = 0;
+    shmPool->maxSize = options->maxSize > options->size ? options->maxSize : options->size;
+    shmPool->hugePages = options->hugePages;
+
+    status = celixThreadMutex_create(&shmPool->mutex, NULL);
+    if(status != CELIX_SUCCESS) {
+        goto shm_pool_mutex_err;
+    }
+
+    status = shmPool_addSegment(shmPool, options->size);
     if (status != CELIX_SUCCESS) {
-        celix_err_pushf("Shm pool: Error creating heartbeat thread. %d.\n", status);
-        goto heartbeat_thread_err;
+        goto segment_err;
     }
 
-    (void)shmctl(shmPool->shmId, IPC_RMID, NULL);
     *pool = shmPool;
 
     return CELIX_SUCCESS;
 
-heartbeat_thread_err:
-    (void)celixThreadCondition_destroy(&shmPool->heartbeatThreadStoped);
-stopped_cond_err:
-    tlsf_destroy(shmPool->allocator);
-allocator_err:
-    (void)shmdt(shmPool->shmStartAddr);
-err_attaching_shm:
-    (void)shmctl(shmPool->shmId, IPC_RMID, NULL);
-err_getting_shm:
+segment_err:
     (void)celixThreadMutex_destroy(&shmPool->mutex);
 shm_pool_mutex_err:
     free(shmPool);
@@ -129,32 +220,104 @@ shm_size_invalid:
 
 int shmPool_getShmId(shm_pool_t *pool) {
     if (pool != NULL) {
-        return pool->shmId;
+        return pool->segments[0].shmId;
     }
     return -1;
 }
 
 void shmPool_destroy(shm_pool_t *pool) {
     if (pool != NULL) {
-        celixThreadMutex_lock(&pool->mutex);
-        pool->heartbeatThreadActive = false;
-        celixThreadMutex_unlock(&pool->mutex);
-        celixThreadCondition_signal(&pool->heartbeatThreadStoped);
-        celixThread_join(pool->shmHeartbeatThread, NULL);
-        (void)celixThreadCondition_destroy(&pool->heartbeatThreadStoped);
-        tlsf_destroy(pool->allocator);
-        (void)shmdt(pool->shmStartAddr);
+        shmPool_removeSegments(pool);
         celixThreadMutex_destroy(&pool->mutex);
         free(pool);
     }
     return ;
 }
 
+static shm_pool_segment_t *shmPool_getSegment(shm_pool_t *pool, const void *ptr) {
+    for (unsigned int i = 0; i < pool->nrOfSegments; ++i) {
+        shm_pool_segment_t *segment = &pool->segments[i];
+        if (segment->shmStartAddr <= ptr && ptr < segment->shmStartAddr + segment->size) {
+            return segment;
+        }
+    }
+    return NULL;
+}
+
+static celix_status_t shmPool_grow(shm_pool_t *pool, size_t size) {
+    //Segments of huge pages are rounded up, so the pool size can exceed the maximum size
+    if (pool->nrOfSegments == SHM_POOL_MAX_SEGMENTS || pool->size >= pool->maxSize
+            || size >= pool->maxSize - pool->size) {
+        return CELIX_ENOMEM;
+    }
+    //The allocator rounds sizes up to the next size class, which adds less than size/16
+    size_t minSegmentSize = shmPool_normalizedSharedInfoSize() + tlsf_size() + tlsf_pool_overhead()
+            + tlsf_alloc_overhead() + tlsf_align_size() + size + size / 16;
+    //Double the pool size, to need few segments
+    size_t segmentSize = minSegmentSize > pool->size ? minSegmentSize : pool->size;
+    if (segmentSize > pool->maxSize - pool->size) {
+        segmentSize = pool->maxSize - pool->size;
+    }
+    if (segmentSize < minSegmentSize) {
+        return CELIX_ENOMEM;
+    }
+    return shmPool_addSegment(pool, segmentSize);
+}
+
+static void shmPool_updateStats(shm_pool_t *pool, void *addr) {
+    if (addr != NULL) {
+        pool->usedSize += tlsf_block_size(addr);
+        if (pool->usedSize > pool->peakUsedSize) {
+            pool->peakUsedSize = pool->usedSize;
+        }
+    } else {
+        pool->failedAllocations++;
+    }
+}
+
 void *shmPool_malloc(shm_pool_t *pool, size_t size) {
     if (pool != NULL) {
         void *addr = NULL;
         celixThreadMutex_lock(&pool->mutex);
-        addr = tlsf_malloc(pool->allocator, size);
+        for (unsigned int i = 0; i < pool->nrOfSegments && addr == NULL; ++i) {
+            addr = tlsf_malloc(pool->segments[i].allocator, size);
+        }
+        if (addr == NULL && shmPool_grow(pool, size) == CELIX_SUCCESS) {
+            addr = tlsf_malloc(pool->segments[pool->nrOfSegments - 1].allocator, size);
+        }
+        shmPool_updateStats(pool, addr);
+        celixThreadMutex_unlock(&pool->mutex);
+        return addr;
+    }
+    return NULL;
+}
+
+static void *shmPool_mallocPairInSegment(shm_pool_segment_t *segment, size_t size, size_t pairedSize, void **paired) {
+    void *addr = tlsf_malloc(segment->allocator, size);
+    if (addr != NULL && (*paired = tlsf_malloc(segment->allocator, pairedSize)) == NULL) {
+        tlsf_free(segment->allocator, addr);
+        addr = NULL;
+    }
+    return addr;
+}
+
+void *shmPool_mallocPair(shm_pool_t *pool, size_t size, size_t pairedSize, void **paired) {
+    if (pool != NULL && paired != NULL) {
+        void *addr = NULL;
+        *paired = NULL;
+        celixThreadMutex_lock(&pool->mutex);
+        for (unsigned int i = 0; i < pool->nrOfSegments && addr == NULL; ++i) {
+            addr = shmPool_mallocPairInSegment(&pool->segments[i], size, pairedSize, paired);
+        }
+        //A new segment must also hold the allocation overhead of the paired block
+        size_t totalSize = size + pairedSize + tlsf_alloc_overhead() + tlsf_align_size();
+        if (addr == NULL && totalSize > size && shmPool_grow(pool, totalSize) == CELIX_SUCCESS) {
+            addr = shmPool_mallocPairInSegment(&pool->segments[pool->nrOfSegments - 1], size, pairedSize, paired);
+        }
+        shmPool_updateStats(pool, addr);
+        if (addr != NULL) {
+            shmPool_updateStats(pool, *paired);
+        }
         celixThreadMutex_unlock(&pool->mutex);
         return addr;
     }
@@ -164,33 +327,56 @@ void *shmPool_malloc(shm_pool_t *pool, size_t size) {
 void shmPool_free(shm_pool_t *pool, void *ptr) {
     if (pool != NULL && ptr != NULL) {
         celixThreadMutex_lock(&pool->mutex);
-        tlsf_free(pool->allocator, ptr);
+        shm_pool_segment_t *segment = shmPool_getSegment(pool, ptr);
+        assert(segment != NULL);
+        pool->usedSize -= tlsf_block_size(ptr);
+        tlsf_free(segment->allocator, ptr);
         celixThreadMutex_unlock(&pool->mutex);
     }
     return ;
 }
 
 ssize_t shmPool_getMemoryOffset(shm_pool_t *pool, void *ptr) {
+    ssize_t offset = -1;
     if (pool != NULL && ptr != NULL) {
-        return ptr - pool->shmStartAddr;
+        celixThreadMutex_lock(&pool->mutex);
+        shm_pool_segment_t *segment = shmPool_getSegment(pool, ptr);
+        if (segment != NULL) {
+            offset = ptr - segment->shmStartAddr;
+        }
+        celixThreadMutex_unlock(&pool->mutex);
     }
-    return -1;
+    return offset;
 }
 
-static void *shmPool_heartbeatThread(void *data){
-    shm_pool_t *pool = (shm_pool_t *)data;
-    assert(pool != NULL);
-    bool active = true;
-    while (active) {
+int shmPool_getMemoryShmId(shm_pool_t *pool, void *ptr) {
+    int shmId = -1;
+    if (pool != NULL && ptr != NULL) {
         celixThreadMutex_lock(&pool->mutex);
-        int waitRet = 0;
-        while (pool->heartbeatThreadActive && waitRet != ETIMEDOUT) {
-            // pthread_cond_timedwait shall not return an error code of [EINTR], refer https://man7.org/linux/man-pages/man3/pthread_cond_timedwait.3p.html
-            waitRet = celixThreadCondition_timedwaitRelative(&pool->heartbeatThreadStoped, &pool->mutex, SHM_HEART_BEAT_UPDATE_INTERVAL_IN_S, 0);
+        shm_pool_segment_t *segment = shmPool_getSegment(pool, ptr);
+        if (segment != NULL) {
+            shmId = segment->shmId;
         }
-        pool->sharedInfo->heartbeatCnt++;
-        active = pool->heartbeatThreadActive ;
         celixThreadMutex_unlock(&pool->mutex);
     }
-    return NULL;
+    return shmId;
+}
+
+celix_status_t shmPool_getStats(shm_pool_t *pool, shm_pool_stats_t *stats) {
+    if (pool == NULL || stats == NULL) {
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    celixThreadMutex_lock(&pool->mutex);
+    stats->size = pool->size;
+    stats->maxSize = pool->maxSize;
+    stats->segments = pool->nrOfSegments;
+    stats->hugePageSegments = 0;
+    for (unsigned int i = 0; i < pool->nrOfSegments; ++i) {
+        stats->hugePageSegments += pool->segments[i].hugePages ? 1 : 0;
+    }
+    stats->usedSize = pool->usedSize;
+    stats->peakUsedSize = pool->peakUsedSize;
+    stats->failedAllocations = pool->failedAllocations;
+    celixThreadMutex_unlock(&pool->mutex);
+    return CELIX_SUCCESS;
 }
@@ -24,14 +24,35 @@ extern "C" {
 #endif
 #include <stdint.h>
 #include <stddef.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
 
-#define SHM_HEART_BEAT_UPDATE_INTERVAL_IN_S 1
+#define SHM_POOL_LIVENESS_SOCKET_NAME_SIZE 64
 
+/*
+ * The creator of a shared memory segment listens on an abstract unix domain socket, without ever accepting connections.
+ * Processes attaching the segment connect to it, and the kernel hangs up their connections as soon as the socket is
+ * closed, i.e. when the pool is destroyed or when its process dies. So the liveness of a pool is tracked without
+ * any periodic wakeup.
+ */
 struct shm_pool_shared_info {
     size_t size;//The size of ‘struct shm_pool_shared_info‘.It is used to extend 'struct shm_pool_shared_info' in the future.
-    uint64_t heartbeatCnt;//Keep alive for shared memory
+    char livenessSocketName[SHM_POOL_LIVENESS_SOCKET_NAME_SIZE];//The name of the abstract liveness socket of the segment
 };
 
+/**
+ * @brief Get the address of the abstract liveness socket with the given name.
+ * @return The length of the address
+ */
+static inline socklen_t shmPool_livenessSocketAddress(const char *name, struct sockaddr_un *addr) {
+    memset(addr, 0, sizeof(*addr));
+    addr->sun_family = AF_UNIX;
+    size_t nameLen = strnlen(name, SHM_POOL_LIVENESS_SOCKET_NAME_SIZE - 1);
+    memcpy(&addr->sun_path[1], name, nameLen);//sun_path[0] is '\0' for an abstract socket
+    return (socklen_t)(offsetof(struct sockaddr_un, sun_path) + 1 + nameLen);
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,200 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+extern "C" {
+#include "remote_interceptors_handler.h"
+}
+#include "celix_bundle_context.h"
+#include "celix_constants.h"
+#include "celix_framework.h"
+#include "celix_framework_factory.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+class RemoteInterceptorsHandlerUnitTestSuite : public ::testing::Test {
+public:
+    RemoteInterceptorsHandlerUnitTestSuite() {
+        auto* props = celix_properties_create();
+        celix_properties_set(props, CELIX_FRAMEWORK_CLEAN_CACHE_DIR_ON_CREATE, "true");
+        celix_properties_set(props, CELIX_FRAMEWORK_CACHE_DIR, ".rsa_interceptors_handler_test_cache");
+        fw = std::shared_ptr<celix_framework_t>{celix_frameworkFactory_createFramework(props), [](auto* f) {celix_frameworkFactory_destroyFramework(f);}};
+        ctx = celix_framework_getFrameworkContext(fw.get());
+
+        remote_interceptors_handler_t* handlerPtr = nullptr;
+        EXPECT_EQ(CELIX_SUCCESS, remoteInterceptorsHandler_create(ctx, &handlerPtr));
+        handler = std::shared_ptr<remote_interceptors_handler_t>{handlerPtr, [](auto* h) {remoteInterceptorsHandler_destroy(h);}};
+    }
+
+    ~RemoteInterceptorsHandlerUnitTestSuite() override {
+        handler.reset();
+        celix_bundleContext_waitForEvents(ctx);
+    }
+
+    long registerInterceptor(remote_interceptor_t* interceptor, celix_properties_t* props = nullptr) {
+        celix_service_registration_options_t opts{};
+        opts.serviceName = CELIX_RSA_REMOTE_INTERCEPTOR_SERVICE_NAME;
+        opts.serviceVersion = CELIX_RSA_REMOTE_INTERCEPTOR_SERVICE_VERSION;
+        opts.svc = interceptor;
+        opts.properties = props;
+        long svcId = celix_bundleContext_registerServiceWithOptions(ctx, &opts);
+        EXPECT_GE(svcId, 0);
+        celix_bundleContext_waitForEvents(ctx);
+        return svcId;
+    }
+
+    void unregisterInterceptor(long svcId) {
+        celix_bundleContext_unregisterService(ctx, svcId);
+        celix_bundleContext_waitForEvents(ctx);
+    }
+
+    std::shared_ptr<celix_framework_t> fw{};
+    celix_bundle_context_t* ctx{nullptr};
+    std::shared_ptr<remote_interceptors_handler_t> handler{};
+};
+
+namespace {
+    struct counting_interceptor {
+        remote_interceptor_t svc{};
+        std::atomic<long> calls{0};
+        std::atomic<long> callsWithMetadata{0};
+
+        counting_interceptor() {
+            svc.handle = this;
+            svc.preExportCall = [](void* handle, const celix_properties_t*, const char*, celix_properties_t* metadata) -> bool {
+                static_cast<counting_interceptor*>(handle)->count(metadata);
+                return true;
+            };
+            svc.postExportCall = [](void* handle, const celix_properties_t*, const char*, celix_properties_t* metadata) {
+                static_cast<counting_interceptor*>(handle)->count(metadata);
+            };
+            svc.preProxyCall = svc.preExportCall;
+            svc.postProxyCall = svc.postExportCall;
+        }
+
+        void count(const celix_properties_t* metadata) {
+            calls++;
+            if (metadata != nullptr) {
+                callsWithMetadata++;
+            }
+        }
+    };
+
+    void invokeProxyCall(remote_interceptors_handler_t* handler, celix_properties_t** metadata) {
+        EXPECT_TRUE(remoteInterceptorHandler_invokePreProxyCall(handler, nullptr, "test", metadata));
+        remoteInterceptorHandler_invokePostProxyCall(handler, nullptr, "test", *metadata);
+    }
+}
+
+TEST_F(RemoteInterceptorsHandlerUnitTestSuite, MetadataIsOnlyCreatedWhenUsedTest) {
+    counting_interceptor noMetadata{};
+    auto* props = celix_properties_create();
+    celix_properties_setBool(props, CELIX_RSA_REMOTE_INTERCEPTOR_USES_METADATA, false);
+    long noMetadataSvcId = registerInterceptor(&noMetadata.svc, props);
+
+    celix_properties_t* metadata = nullptr;
+    invokeProxyCall(handler.get(), &metadata);
+    EXPECT_EQ(nullptr, metadata);
+    EXPECT_EQ(2, noMetadata.calls);
+
+    //metadata of the caller is passed on
+    celix_autoptr(celix_properties_t) callerMetadata = celix_properties_create();
+    metadata = callerMetadata;
+    invokeProxyCall(handler.get(), &metadata);
+    EXPECT_EQ(callerMetadata, metadata);
+    EXPECT_EQ(2, noMetadata.callsWithMetadata);
+
+    //once an interceptor uses metadata, it is created
+    counting_interceptor withMetadata{};
+    long withMetadataSvcId = registerInterceptor(&withMetadata.svc);
+    metadata = nullptr;
+    EXPECT_TRUE(remoteInterceptorHandler_invokePreExportCall(handler.get(), nullptr, "test", &metadata));
+    remoteInterceptorHandler_invokePostExportCall(handler.get(), nullptr, "test", metadata);
+    EXPECT_NE(nullptr, metadata);
+    EXPECT_EQ(2, withMetadata.callsWithMetadata);
+    celix_properties_destroy(metadata);
+
+    unregisterInterceptor(withMetadataSvcId);
+    unregisterInterceptor(noMetadataSvcId);
+}
+
+TEST_F(RemoteInterceptorsHandlerUnitTestSuite, InterceptorsAreCalledInRankingOrderTest) {
+    static std::vector<int> order{};
+    remote_interceptor_t first{};
+    first.preProxyCall = [](void*, const celix_properties_t*, const char*, celix_properties_t*) -> bool {
+        order.push_back(1);
+        return true;
+    };
+    remote_interceptor_t second{};
+    second.preProxyCall = [](void*, const celix_properties_t*, const char*, celix_properties_t*) -> bool {
+        order.push_back(2);
+        return false;
+    };
+    remote_interceptor_t third{};
+    third.preProxyCall = [](void*, const celix_properties_t*, const char*, celix_properties_t*) -> bool {
+        order.push_back(3);
+        return true;
+    };
+
+    auto* props = celix_properties_create();
+    celix_properties_setLong(props, CELIX_FRAMEWORK_SERVICE_RANKING, 10);
+    long thirdSvcId = registerInterceptor(&third);
+    long firstSvcId = registerInterceptor(&first, props);
+    long secondSvcId = registerInterceptor(&second);
+
+    //the second interceptor stops the call
+    celix_properties_t* metadata = nullptr;
+    EXPECT_FALSE(remoteInterceptorHandler_invokePreProxyCall(handler.get(), nullptr, "test", &metadata));
+    EXPECT_EQ((std::vector<int>{1, 3, 2}), order);
+    celix_properties_destroy(metadata);
+
+    unregisterInterceptor(secondSvcId);
+    unregisterInterceptor(firstSvcId);
+    unregisterInterceptor(thirdSvcId);
+}
+
+TEST_F(RemoteInterceptorsHandlerUnitTestSuite, ConcurrentCallsAndInterceptorChangesTest) {
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> callers{};
+    for (int i = 0; i < 4; ++i) {
+        callers.emplace_back([this, &stop] {
+            while (!stop) {
+                celix_properties_t* metadata = nullptr;
+                invokeProxyCall(handler.get(), &metadata);
+                celix_properties_destroy(metadata);
+            }
+        });
+    }
+
+    for (int i = 0; i < 100; ++i) {
+        counting_interceptor interceptor{};
+        long svcId = registerInterceptor(&interceptor.svc);
+        unregisterInterceptor(svcId);
+        //a removed interceptor is not called anymore
+        long calls = interceptor.calls;
+        std::this_thread::yield();
+        EXPECT_EQ(calls, interceptor.calls);
+    }
+
+    stop = true;
+    for (auto& caller : callers) {
+        caller.join();
+    }
+}
@@ -17,6 +17,7 @@
  * under the License.
  */
 #include <stdlib.h>
+#include <unistd.h>
 
 #include "celix_bundle_context.h"
 #include "celix_constants.h"
@@ -30,16 +31,31 @@
 typedef struct entry {
     const celix_properties_t *properties;
     remote_interceptor_t *interceptor;
+    bool usesMetadata;
 } entry_t;
 
+/**
+ * An immutable, ranking ordered, copy of the registered interceptors.
+ * A new snapshot is published on every interceptor change, so that calls can use the interceptors without locking.
+ */
+typedef struct interceptors_snapshot {
+    bool usesMetadata; //whether any of the interceptors uses metadata
+    size_t size;
+    remote_interceptor_t *interceptors[];
+} interceptors_snapshot_t;
+
 struct remote_interceptors_handler {
-    celix_array_list_t *interceptors;
+    celix_array_list_t *interceptors; //entry_t*, protected by lock
+
+    interceptors_snapshot_t *snapshot; //published snapshot, NULL if there are no interceptors. Atomically updated.
+    unsigned int epoch; //0 or 1, flipped on every snapshot update. Atomically updated.
+    size_t callCount[2]; //nr of calls using a snapshot, per epoch. Atomically updated.
 
     long interceptorsTrackerId;
 
     celix_bundle_context_t *ctx;
 
-    celix_thread_mutex_t lock;
+    celix_thread_mutex_t lock; //protects interceptors and serializes snapshot updates
 };
 
 static int referenceCompare(celix_array_list_entry_t a, celix_array_list_entry_t b);
@@ -76,6 +92,7 @@ celix_status_t remoteInterceptorsHandler_create(celix_bundle_context_t *ctx, rem
 
 static void remoteInterceptorsHandler_destroyCallback(void* data) {
     remote_interceptors_handler_t *handler = data;
+    free(handler->snapshot);
     celix_arrayList_destroy(handler->interceptors);
     celixThreadMutex_destroy(&handler->lock);
     free(handler);
@@ -86,6 +103,80 @@ celix_status_t remoteInterceptorsHandler_destroy(remote_interceptors_handler_t *
     return CELIX_SUCCESS;
 }
 
+/**
+ * Acquires the published snapshot for the duration of a call. A call is counted in the epoch it started in, so that a
+ * snapshot update only has to wait for the calls that can still use the replaced snapshot.
+ */
+static interceptors_snapshot_t* remoteInterceptorsHandler_acquireSnapshot(remote_interceptors_handler_t *handler, unsigned int *epoch) {
+    while (true) {
+        unsigned int current = __atomic_load_n(&handler->epoch, __ATOMIC_SEQ_CST);
+        (void)__atomic_fetch_add(&handler->callCount[current], 1, __ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&handler->epoch, __ATOMIC_SEQ_CST) == current) {
+            *epoch = current;
+            return __atomic_load_n(&handler->snapshot, __ATOMIC_SEQ_CST);
+        }
+        //a snapshot update started in the meantime, retry in the new epoch
+        (void)__atomic_fetch_sub(&handler->callCount[current], 1, __ATOMIC_RELEASE);
+    }
+}
+
+static void remoteInterceptorsHandler_releaseSnapshot(remote_interceptors_handler_t *handler, unsigned int epoch) {
+    (void)__atomic_fetch_sub(&handler->callCount[epoch], 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * Publishes a snapshot and waits until the calls that can still use the replaced snapshot are done.
+ * Returns the replaced snapshot.
+ */
+static interceptors_snapshot_t* remoteInterceptorsHandler_publishSnapshot(remote_interceptors_handler_t *handler, interceptors_snapshot_t *snapshot) {
+    interceptors_snapshot_t *old = __atomic_exchange_n(&handler->snapshot, snapshot, __ATOMIC_SEQ_CST);
+    unsigned int epoch = __atomic_load_n(&handler->epoch, __ATOMIC_RELAXED);
+    __atomic_store_n(&handler->epoch, epoch ^ 1, __ATOMIC_SEQ_CST);
+    // busy wait till the calls of the previous epoch are done.
+    // Calls only use a snapshot while calling the interceptors and snapshots are only replaced on interceptor changes.
+    while (__atomic_load_n(&handler->callCount[epoch], __ATOMIC_ACQUIRE) > 0) {
+        usleep(10);
+    }
+    return old;
+}
+
+static void remoteInterceptorsHandler_fillSnapshot(remote_interceptors_handler_t *handler, interceptors_snapshot_t *snapshot) {
+    snapshot->usesMetadata = false;
+    snapshot->size = celix_arrayList_size(handler->interceptors);
+    for (size_t i = 0; i < snapshot->size; i++) {
+        entry_t *entry = celix_arrayList_get(handler->interceptors, (int)i);
+        snapshot->interceptors[i] = entry->interceptor;
+        snapshot->usesMetadata = snapshot->usesMetadata || entry->usesMetadata;
+    }
+}
+
+/**
+ * Updates the published snapshot after an interceptor change. Once this returns, a removed interceptor is no longer
+ * called. Called with the lock held.
+ */
+static void remoteInterceptorsHandler_updateSnapshot(remote_interceptors_handler_t *handler) {
+    interceptors_snapshot_t *snapshot = NULL;
+    size_t size = celix_arrayList_size(handler->interceptors);
+    if (size > 0) {
+        snapshot = malloc(sizeof(*snapshot) + size * sizeof(snapshot->interceptors[0]));
+        if (snapshot == NULL) {
+            // LCOV_EXCL_START
+            interceptors_snapshot_t *current = __atomic_load_n(&handler->snapshot, __ATOMIC_RELAXED);
+            if (current != NULL && current->size >= size) {
+                //a removed interceptor must not be called anymore, so the current snapshot is updated in place
+                current = remoteInterceptorsHandler_publishSnapshot(handler, NULL);
+                remoteInterceptorsHandler_fillSnapshot(handler, current);
+                (void)remoteInterceptorsHandler_publishSnapshot(handler, current);
+            }
+            //note an added interceptor is used after the next interceptor change
+            return;
+            // LCOV_EXCL_STOP
+        }
+        remoteInterceptorsHandler_fillSnapshot(handler, snapshot);
+    }
+    free(remoteInterceptorsHandler_publishSnapshot(handler, snapshot));
+}
+
 void remoteInterceptorsHandler_addInterceptor(void *handle, void *svc, const celix_properties_t *props) {
     remote_interceptors_handler_t *handler = handle;
 
@@ -102,9 +193,11 @@ void remoteInterceptorsHandler_addInterceptor(void *handle, void *svc, const cel
         entry_t *entry = calloc(1, sizeof(*entry));
         entry->properties = props;
         entry->interceptor = svc;
+        entry->usesMetadata = celix_properties_getAsBool(props, CELIX_RSA_REMOTE_INTERCEPTOR_USES_METADATA, true);
         celix_arrayList_add(handler->interceptors, entry);
 
         celix_arrayList_sortEntries(handler->interceptors, referenceCompare);
+        remoteInterceptorsHandler_updateSnapshot(handler);
     }
 
     celixThreadMutex_unlock(&handler->lock);
@@ -120,6 +213,7 @@ void remoteInterceptorsHandler_removeInterceptor(void *handle, void *svc, const
         if (entry->interceptor == svc) {
             celix_arrayList_removeAt(handler->interceptors, i);
             free(entry);
+            remoteInterceptorsHandler_updateSnapshot(handler);
             break;
         }
     }
@@ -130,71 +224,95 @@ void remoteInterceptorsHandler_removeInterceptor(void *handle, void *svc, const
 bool remoteInterceptorHandler_invokePreExportCall(remote_interceptors_handler_t *handler, const celix_properties_t *svcProperties, const char *functionName, celix_properties_t **metadata) {
     bool cont = true;
 
-    celixThreadMutex_lock(&handler->lock);
+    if (__atomic_load_n(&handler->snapshot, __ATOMIC_RELAXED) == NULL) {
+        return cont;
+    }
 
-    if (*metadata == NULL && celix_arrayList_size(handler->interceptors) > 0) {
+    unsigned int epoch;
+    interceptors_snapshot_t *snapshot = remoteInterceptorsHandler_acquireSnapshot(handler, &epoch);
+    size_t size = snapshot != NULL ? snapshot->size : 0;
+
+    if (*metadata == NULL && snapshot != NULL && snapshot->usesMetadata) {
         *metadata = celix_properties_create();
     }
 
-    for (uint32_t i = celix_arrayList_size(handler->interceptors); i > 0; i--) {
-        entry_t *entry = celix_arrayList_get(handler->interceptors, i - 1);
+    for (size_t i = size; i > 0; i--) {
+        remote_interceptor_t *interceptor = snapshot->interceptors[i - 1];
 
-        cont = entry->interceptor->preExportCall(entry->interceptor->handle, svcProperties, functionName, *metadata);
+        cont = interceptor->preExportCall(interceptor->handle, svcProperties, functionName, *metadata);
         if (!cont) {
             break;
         }
     }
 
-    celixThreadMutex_unlock(&handler->lock);
+    remoteInterceptorsHandler_releaseSnapshot(handler, epoch);
 
     return cont;
 }
 
 void remoteInterceptorHandler_invokePostExportCall(remote_interceptors_handler_t *handler, const celix_properties_t *svcProperties, const char *functionName, celix_properties_t *metadata) {
-    celixThreadMutex_lock(&handler->lock);
+    if (__atomic_load_n(&handler->snapshot, __ATOMIC_RELAXED) == NULL) {
+        return;
+    }
+
+    unsigned int epoch;
+    interceptors_snapshot_t *snapshot = remoteInterceptorsHandler_acquireSnapshot(handler, &epoch);
+    size_t size = snapshot != NULL ? snapshot->size : 0;
 
-    for (uint32_t i = celix_arrayList_size(handler->interceptors); i > 0; i--) {
-        entry_t *entry = celix_arrayList_get(handler->interceptors, i - 1);
+    for (size_t i = size; i > 0; i--) {
+        remote_interceptor_t *interceptor = snapshot->interceptors[i - 1];
 
-        entry->interceptor->postExportCall(entry->interceptor->handle, svcProperties, functionName, metadata);
+        interceptor->postExportCall(interceptor->handle, svcProperties, functionName, metadata);
     }
 
-    celixThreadMutex_unlock(&handler->lock);
+    remoteInterceptorsHandler_releaseSnapshot(handler, epoch);
 }
 
 bool remoteInterceptorHandler_invokePreProxyCall(remote_interceptors_handler_t *handler, const celix_properties_t *svcProperties, const char *functionName, celix_properties_t **metadata) {
     bool cont = true;
 
-    celixThreadMutex_lock(&handler->lock);
+    if (__atomic_load_n(&handler->snapshot, __ATOMIC_RELAXED) == NULL) {
+        return cont;
+    }
 
-    if (*metadata == NULL && celix_arrayList_size(handler->interceptors) > 0) {
+    unsigned int epoch;
+    interceptors_snapshot_t *snapshot = remoteInterceptorsHandler_acquireSnapshot(handler, &epoch);
+    size_t size = snapshot != NULL ? snapshot->size : 0;
+
+    if (*metadata == NULL && snapshot != NULL && snapshot->usesMetadata) {
         *metadata = celix_properties_create();
     }
 
-    for (uint32_t i = 0; i < celix_arrayList_size(handler->interceptors); i++) {
-        entry_t *entry = celix_arrayList_get(handler->interceptors, i);
+    for (size_t i = 0; i < size; i++) {
+        remote_interceptor_t *interceptor = snapshot->interceptors[i];
 
-        cont = entry->interceptor->preProxyCall(entry->interceptor->handle, svcProperties, functionName, *metadata);
+        cont = interceptor->preProxyCall(interceptor->handle, svcProperties, functionName, *metadata);
         if (!cont) {
             break;
         }
     }
 
-    celixThreadMutex_unlock(&handler->lock);
+    remoteInterceptorsHandler_releaseSnapshot(handler, epoch);
 
     return cont;
 }
 
 void remoteInterceptorHandler_invokePostProxyCall(remote_interceptors_handler_t *handler, const celix_properties_t *svcProperties, const char *functionName, celix_properties_t *metadata) {
-    celixThreadMutex_lock(&handler->lock);
+    if (__atomic_load_n(&handler->snapshot, __ATOMIC_RELAXED) == NULL) {
+        return;
+    }
 
-    for (uint32_t i = 0; i < celix_arrayList_size(handler->interceptors); i++) {
-        entry_t *entry = celix_arrayList_get(handler->interceptors, i);
+    unsigned int epoch;
+    interceptors_snapshot_t *snapshot = remoteInterceptorsHandler_acquireSnapshot(handler, &epoch);
+    size_t size = snapshot != NULL ? snapshot->size : 0;
 
-        entry->interceptor->postProxyCall(entry->interceptor->handle, svcProperties, functionName, metadata);
+    for (size_t i = 0; i < size; i++) {
+        remote_interceptor_t *interceptor = snapshot->interceptors[i];
+
+        interceptor->postProxyCall(interceptor->handle, svcProperties, functionName, metadata);
     }
 
-    celixThreadMutex_unlock(&handler->lock);
+    remoteInterceptorsHandler_releaseSnapshot(handler, epoch);
 }
 
 int referenceCompare(celix_array_list_entry_t a, celix_array_list_entry_t b) {
@@ -22,8 +22,10 @@
 #include <gtest/gtest.h>
 #include <memory>
 #include <string>
+#include <vector>
 #include "celix_constants.h"
 #include "celix_framework_factory.h"
+#include "rsa_dfi_utils_test_stubs.h" //generated by celix_target_dfi_stubs
 
 class DfiUtilsTestSuite : public ::testing::Test {
 public:
@@ -45,6 +47,7 @@ public:
 
     long descBundleId{-1};
     std::string curTestDescFile{};
+    std::vector<dyn_interface_type*> acquiredIntfs{};
     std::shared_ptr<celix_framework_t> fw{};
     std::shared_ptr<celix_bundle_context_t> ctx{};
     std::shared_ptr<celix_log_helper_t> logHelper{};
@@ -83,4 +86,97 @@ TEST_F(DfiUtilsTestSuite, DescriptorFileNoExist) {
     curTestDescFile = "nonexistent-file";
     bool found = celix_bundleContext_useBundle(ctx.get(), descBundleId, this, useBundleCallbackForPasreNonexistentFile);
     EXPECT_TRUE(found);
-}
\ No newline at end of file
+}
+static void acquireTestDescriptorCallback(void *handle, const celix_bundle_t *bundle) {
+    DfiUtilsTestSuite *testSuite = static_cast<DfiUtilsTestSuite *>(handle);
+    dyn_interface_type *intfOut{nullptr};
+    auto status = dfi_acquireInterfaceDescriptor(testSuite->logHelper.get(), testSuite->ctx.get(), bundle, testSuite->curTestDescFile.c_str(), &intfOut);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    EXPECT_TRUE(intfOut != nullptr);
+    testSuite->acquiredIntfs.push_back(intfOut);
+}
+
+TEST_F(DfiUtilsTestSuite, CachedDescriptorIsShared) {
+    curTestDescFile = "rsa_dfi_utils_test";
+    EXPECT_TRUE(celix_bundleContext_useBundle(ctx.get(), descBundleId, this, acquireTestDescriptorCallback));
+    EXPECT_TRUE(celix_bundleContext_useBundle(ctx.get(), descBundleId, this, acquireTestDescriptorCallback));
+    //the descriptor of another bundle is cached separately
+    EXPECT_TRUE(celix_bundleContext_useBundle(ctx.get(), 0, this, acquireTestDescriptorCallback));
+    ASSERT_EQ(3u, acquiredIntfs.size());
+    EXPECT_EQ(acquiredIntfs[0], acquiredIntfs[1]);
+    EXPECT_NE(acquiredIntfs[0], acquiredIntfs[2]);
+
+    for (auto* intf : acquiredIntfs) {
+        dfi_releaseInterfaceDescriptor(intf);
+    }
+    dfi_releaseInterfaceDescriptor(nullptr);
+
+    //a released descriptor is parsed again
+    acquiredIntfs.clear();
+    EXPECT_TRUE(celix_bundleContext_useBundle(ctx.get(), descBundleId, this, acquireTestDescriptorCallback));
+    ASSERT_EQ(1u, acquiredIntfs.size());
+    dfi_releaseInterfaceDescriptor(acquiredIntfs[0]);
+}
+
+static void testClosureBind(void*, void**, void*) {
+    //nop
+}
+
+static void otherTestClosureBind(void*, void**, void*) {
+    //nop
+}
+
+TEST_F(DfiUtilsTestSuite, CachedDescriptorClosureIsShared) {
+    celix_bundleContext_useBundle(ctx.get(), descBundleId, this, [](void *handle, const celix_bundle_t *bundle) {
+        auto* testSuite = static_cast<DfiUtilsTestSuite*>(handle);
+        celix_autoptr(dfi_cached_interface_type) intf = nullptr;
+        EXPECT_EQ(CELIX_SUCCESS, dfi_acquireInterfaceDescriptor(testSuite->logHelper.get(), testSuite->ctx.get(), bundle, "rsa_dfi_utils_test", &intf));
+        struct method_entry* method = TAILQ_FIRST(dynInterface_methods(intf));
+        ASSERT_TRUE(method != nullptr);
+        void (*fn1)(void) = nullptr;
+        void (*fn2)(void) = nullptr;
+        EXPECT_EQ(CELIX_SUCCESS, dfi_getMethodClosure(method, testClosureBind, &fn1));
+        EXPECT_EQ(CELIX_SUCCESS, dfi_getMethodClosure(method, testClosureBind, &fn2));
+        EXPECT_TRUE(fn1 != nullptr);
+        EXPECT_EQ(fn1, fn2);
+
+        //the shared closure cannot be bound to another function
+        void (*fn3)(void) = nullptr;
+        EXPECT_EQ(CELIX_ILLEGAL_STATE, dfi_getMethodClosure(method, otherTestClosureBind, &fn3));
+        EXPECT_TRUE(fn3 == nullptr);
+    });
+}
+
+TEST_F(DfiUtilsTestSuite, AcquireNonexistentDescriptor) {
+    celix_bundleContext_useBundle(ctx.get(), descBundleId, this, [](void *handle, const celix_bundle_t *bundle) {
+        auto* testSuite = static_cast<DfiUtilsTestSuite*>(handle);
+        dyn_interface_type* intf{nullptr};
+        EXPECT_EQ(CELIX_BUNDLE_EXCEPTION, dfi_acquireInterfaceDescriptor(testSuite->logHelper.get(), testSuite->ctx.get(), bundle, "nonexistent-file", &intf));
+        EXPECT_TRUE(intf == nullptr);
+        EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, dfi_acquireInterfaceDescriptor(testSuite->logHelper.get(), testSuite->ctx.get(), bundle, nullptr, &intf));
+    });
+}
+
+TEST_F(DfiUtilsTestSuite, AcquireDescriptorWithStubs) {
+    celix_autoptr(celix_properties_t) props = celix_properties_create();
+    celix_properties_set(props, DFI_INTERFACE_STUBS_NAME, "rsa_dfi_utils_test");
+    long svcId = celix_bundleContext_registerService(ctx.get(), (void*)&rsa_dfi_utils_test_stubs,
+                                                     DFI_INTERFACE_STUBS_SERVICE_NAME, celix_steal_ptr(props));
+    EXPECT_TRUE(svcId >= 0);
+
+    //only the stubs registered by the bundle providing the descriptor are used
+    auto acquireAndCheckProxyStub = [](void *handle, const celix_bundle_t *bundle) {
+        auto* testSuite = static_cast<DfiUtilsTestSuite*>(handle);
+        celix_autoptr(dfi_cached_interface_type) intf = nullptr;
+        EXPECT_EQ(CELIX_SUCCESS, dfi_acquireInterfaceDescriptor(testSuite->logHelper.get(), testSuite->ctx.get(), bundle, "rsa_dfi_utils_test", &intf));
+        struct method_entry* method = TAILQ_FIRST(dynInterface_methods(intf));
+        ASSERT_TRUE(method != nullptr);
+        void (*fn)(void) = nullptr;
+        bool hasStub = dynFunction_getProxyStub(method->dynFunc, &fn) == 0;
+        EXPECT_EQ(celix_bundle_getId(bundle) == 0, hasStub);
+    };
+    EXPECT_TRUE(celix_bundleContext_useBundle(ctx.get(), 0, this, acquireAndCheckProxyStub));
+    EXPECT_TRUE(celix_bundleContext_useBundle(ctx.get(), descBundleId, this, acquireAndCheckProxyStub));
+
+    celix_bundleContext_unregisterService(ctx.get(), svcId);
+}
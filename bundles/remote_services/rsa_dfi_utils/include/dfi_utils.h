@@ -29,8 +29,24 @@ extern "C" {
 #include <celix_bundle.h>
 #include <celix_bundle_context.h>
 #include <celix_errno.h>
+#include <celix_cleanup.h>
 #include <stdio.h>
 
+/**
+ * @brief The service name of generated dfi interface stubs (see dyn_stubs.h).
+ *
+ * A bundle providing an interface descriptor can register the stubs generated for it (using the
+ * celix_target_dfi_stubs CMake function) as a service, with a `const dyn_interface_stubs_t*` as service pointer and
+ * the DFI_INTERFACE_STUBS_NAME property set to the name of the descriptor. dfi_acquireInterfaceDescriptor then sets
+ * the stubs on the interfaces it parses for that bundle, so that calls and proxies no longer go through libffi.
+ */
+#define DFI_INTERFACE_STUBS_SERVICE_NAME "dfi_interface_stubs"
+
+/**
+ * @brief The service property with the descriptor name of a DFI_INTERFACE_STUBS_SERVICE_NAME service.
+ */
+#define DFI_INTERFACE_STUBS_NAME "dfi.stubs.name"
+
 
 celix_status_t dfi_findDescriptor(celix_bundle_context_t *context, const celix_bundle_t *bundle, const char *name, FILE **out);
 
@@ -38,6 +54,55 @@ celix_status_t dfi_findAndParseInterfaceDescriptor(celix_log_helper_t *logHelper
         celix_bundle_context_t *ctx, const celix_bundle_t *svcOwner, const char *name,
         dyn_interface_type **intfOut);
 
+/**
+ * @brief Acquire the parsed interface descriptor of a bundle from the descriptor cache.
+ *
+ * A descriptor is parsed once per bundle (id and version) and name, and shared by all users until the last user
+ * releases it. The returned interface is shared and must therefore not be modified or destroyed; use
+ * dfi_getMethodClosure to create closures for its methods.
+ * If the bundle registered generated stubs for the descriptor (see DFI_INTERFACE_STUBS_SERVICE_NAME), the stubs are
+ * set on the interface.
+ *
+ * @param[in] logHelper The log helper used to report errors.
+ * @param[in] ctx The bundle context.
+ * @param[in] svcOwner The bundle providing the descriptor.
+ * @param[in] name The name of the descriptor, without the .descriptor extension.
+ * @param[out] intfOut The shared interface. Release it with dfi_releaseInterfaceDescriptor.
+ * @return CELIX_SUCCESS if successful.
+ */
+celix_status_t dfi_acquireInterfaceDescriptor(celix_log_helper_t *logHelper,
+        celix_bundle_context_t *ctx, const celix_bundle_t *svcOwner, const char *name,
+        dyn_interface_type **intfOut);
+
+/**
+ * @brief Release an interface descriptor acquired with dfi_acquireInterfaceDescriptor.
+ *
+ * The interface is destroyed when its last user releases it. Releasing NULL is a no-op.
+ */
+void dfi_releaseInterfaceDescriptor(dyn_interface_type *intf);
+
+/**
+ * @brief An interface acquired with dfi_acquireInterfaceDescriptor, which can be released with celix_autoptr.
+ */
+typedef dyn_interface_type dfi_cached_interface_type;
+
+CELIX_DEFINE_AUTOPTR_CLEANUP_FUNC(dfi_cached_interface_type, dfi_releaseInterfaceDescriptor)
+
+/**
+ * @brief Get the closure of a method of a (shared) interface descriptor, creating it on first use.
+ *
+ * A closure is stored in the method's dyn_function, so all users of a shared interface share its closures. All users
+ * must therefore bind the closures to the same function, with the method entry as user data.
+ *
+ * @param[in] method The method entry of the interface.
+ * @param[in] bind The function called when the closure is invoked.
+ * @param[out] fnOut The closure function pointer.
+ * @return CELIX_SUCCESS if successful, CELIX_ILLEGAL_STATE if the closure is already bound to another function,
+ * CELIX_BUNDLE_EXCEPTION if the closure cannot be created.
+ */
+celix_status_t dfi_getMethodClosure(struct method_entry *method, void (*bind)(void *, void **, void *),
+        void (**fnOut)(void));
+
 #ifdef __cplusplus
 }
 #endif
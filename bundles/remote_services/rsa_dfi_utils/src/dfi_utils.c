@@ -21,6 +21,23 @@
 #include <stdlib.h>
 #include <unistd.h>
 #include "celix_bundle_context.h"
+#include "celix_constants.h"
+#include "celix_long_hash_map.h"
+#include "celix_stdlib_cleanup.h"
+#include "celix_string_hash_map.h"
+#include "celix_threads.h"
+#include "celix_utils.h"
+#include "celix_version.h"
+
+typedef struct dfi_interface_cache_entry {
+    char *key; //key of the entry in dfi_interfaceCache
+    dyn_interface_type *intf;
+    size_t useCount;
+} dfi_interface_cache_entry_t;
+
+static celix_thread_mutex_t dfi_cacheMutex = CELIX_THREAD_MUTEX_INITIALIZER; //protects the descriptor cache and closure creation
+static celix_string_hash_map_t *dfi_interfaceCache = NULL; //key: bundle id/bundle version/name, value: dfi_interface_cache_entry_t*
+static celix_long_hash_map_t *dfi_interfaceEntries = NULL; //key: dyn_interface_type*, value: dfi_interface_cache_entry_t*
 
 static celix_status_t dfi_findFileForFramework(celix_bundle_context_t *context, const char *fileName, FILE **out) {
     celix_status_t  status = CELIX_SUCCESS;
@@ -123,3 +140,159 @@ celix_status_t dfi_findAndParseInterfaceDescriptor(celix_log_helper_t *logHelper
     return CELIX_BUNDLE_EXCEPTION;
 }
 
+typedef struct dfi_set_stubs_data {
+    celix_log_helper_t *logHelper;
+    dyn_interface_type *intf;
+} dfi_set_stubs_data_t;
+
+static void dfi_setInterfaceStubsCallback(void *handle, void *svc) {
+    dfi_set_stubs_data_t *data = handle;
+    const dyn_interface_stubs_t *stubs = svc;
+    if (dynInterface_setStubs(data->intf, stubs) != 0) {
+        //stubs are optional, libffi is used instead
+        celix_logHelper_logTssErrors(data->logHelper, CELIX_LOG_LEVEL_WARNING);
+        celix_logHelper_warning(data->logHelper, "Ignoring stubs for '%s'", dynInterface_getName(data->intf));
+    }
+}
+
+static void dfi_setInterfaceStubs(celix_log_helper_t *logHelper, celix_bundle_context_t *ctx,
+        const celix_bundle_t *svcOwner, const char *name, dyn_interface_type *intf) {
+    //only stubs of the bundle providing the descriptor are used, so that the stubs outlive the interface
+    char filter[256];
+    int len = snprintf(filter, sizeof(filter), "(&(%s=%s)(%s=%li))", DFI_INTERFACE_STUBS_NAME, name,
+                       CELIX_FRAMEWORK_SERVICE_BUNDLE_ID, celix_bundle_getId(svcOwner));
+    if (len < 0 || len >= (int)sizeof(filter)) {
+        return;
+    }
+    dfi_set_stubs_data_t data = {logHelper, intf};
+    celix_service_use_options_t opts = CELIX_EMPTY_SERVICE_USE_OPTIONS;
+    opts.filter.serviceName = DFI_INTERFACE_STUBS_SERVICE_NAME;
+    opts.filter.filter = filter;
+    opts.callbackHandle = &data;
+    opts.use = dfi_setInterfaceStubsCallback;
+    (void)celix_bundleContext_useServiceWithOptions(ctx, &opts);
+}
+
+static char* dfi_createCacheKey(const celix_bundle_t *svcOwner, const char *name) {
+    const celix_version_t *bndVersion = celix_bundle_getVersion(svcOwner);
+    celix_autofree char *version = bndVersion != NULL ? celix_version_toString(bndVersion) : celix_utils_strdup("");
+    char *key = NULL;
+    if (version == NULL || asprintf(&key, "%ld/%s/%s", celix_bundle_getId(svcOwner), version, name) < 0) {
+        return NULL;
+    }
+    return key;
+}
+
+static celix_status_t dfi_createInterfaceCache(void) {
+    if (dfi_interfaceCache != NULL) {
+        return CELIX_SUCCESS;
+    }
+    celix_autoptr(celix_string_hash_map_t) cache = celix_stringHashMap_create();
+    celix_autoptr(celix_long_hash_map_t) entries = celix_longHashMap_create();
+    if (cache == NULL || entries == NULL) {
+        return CELIX_ENOMEM;
+    }
+    dfi_interfaceCache = celix_steal_ptr(cache);
+    dfi_interfaceEntries = celix_steal_ptr(entries);
+    return CELIX_SUCCESS;
+}
+
+static void dfi_destroyInterfaceCacheIfEmpty(void) {
+    if (dfi_interfaceCache != NULL && celix_stringHashMap_size(dfi_interfaceCache) == 0) {
+        celix_stringHashMap_destroy(dfi_interfaceCache);
+        celix_longHashMap_destroy(dfi_interfaceEntries);
+        dfi_interfaceCache = NULL;
+        dfi_interfaceEntries = NULL;
+    }
+}
+
+celix_status_t dfi_acquireInterfaceDescriptor(celix_log_helper_t *logHelper,
+        celix_bundle_context_t *ctx, const celix_bundle_t *svcOwner, const char *name,
+        dyn_interface_type **intfOut) {
+    if (logHelper == NULL || ctx == NULL || svcOwner == NULL || name == NULL || intfOut == NULL) {
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    celix_autofree char *key = dfi_createCacheKey(svcOwner, name);
+    if (key == NULL) {
+        celix_logHelper_error(logHelper, "Error creating descriptor cache key for '%s'", name);
+        return CELIX_ENOMEM;
+    }
+
+    celix_auto(celix_mutex_lock_guard_t) lock = celixMutexLockGuard_init(&dfi_cacheMutex);
+    dfi_interface_cache_entry_t *entry = dfi_interfaceCache != NULL ? celix_stringHashMap_get(dfi_interfaceCache, key) : NULL;
+    if (entry != NULL) {
+        entry->useCount += 1;
+        *intfOut = entry->intf;
+        return CELIX_SUCCESS;
+    }
+
+    if (dfi_createInterfaceCache() != CELIX_SUCCESS) {
+        celix_logHelper_error(logHelper, "Error creating descriptor cache");
+        return CELIX_ENOMEM;
+    }
+    celix_autoptr(dyn_interface_type) intf = NULL;
+    celix_status_t status = dfi_findAndParseInterfaceDescriptor(logHelper, ctx, svcOwner, name, &intf);
+    celix_autofree dfi_interface_cache_entry_t *newEntry = NULL;
+    if (status == CELIX_SUCCESS) {
+        newEntry = calloc(1, sizeof(*newEntry));
+        status = newEntry != NULL ? celix_stringHashMap_put(dfi_interfaceCache, key, newEntry) : CELIX_ENOMEM;
+        if (status == CELIX_SUCCESS) {
+            status = celix_longHashMap_put(dfi_interfaceEntries, (long)intf, newEntry);
+            if (status != CELIX_SUCCESS) {
+                celix_stringHashMap_remove(dfi_interfaceCache, key);
+            }
+        }
+        if (status != CELIX_SUCCESS) {
+            celix_logHelper_error(logHelper, "Error adding descriptor for '%s' to the descriptor cache", name);
+        }
+    }
+    if (status != CELIX_SUCCESS) {
+        dfi_destroyInterfaceCacheIfEmpty();
+        return status;
+    }
+    dfi_setInterfaceStubs(logHelper, ctx, svcOwner, name, intf);
+    newEntry->key = celix_steal_ptr(key);
+    newEntry->intf = intf;
+    newEntry->useCount = 1;
+    celix_steal_ptr(newEntry);
+    *intfOut = celix_steal_ptr(intf);
+    return CELIX_SUCCESS;
+}
+
+void dfi_releaseInterfaceDescriptor(dyn_interface_type *intf) {
+    if (intf == NULL) {
+        return;
+    }
+    celix_auto(celix_mutex_lock_guard_t) lock = celixMutexLockGuard_init(&dfi_cacheMutex);
+    dfi_interface_cache_entry_t *entry = dfi_interfaceEntries != NULL ? celix_longHashMap_get(dfi_interfaceEntries, (long)intf) : NULL;
+    if (entry == NULL) {
+        return;
+    }
+    entry->useCount -= 1;
+    if (entry->useCount == 0) {
+        celix_longHashMap_remove(dfi_interfaceEntries, (long)intf);
+        celix_stringHashMap_remove(dfi_interfaceCache, entry->key);
+        dynInterface_destroy(entry->intf);
+        free(entry->key);
+        free(entry);
+        dfi_destroyInterfaceCacheIfEmpty();
+    }
+}
+
+celix_status_t dfi_getMethodClosure(struct method_entry *method, void (*bind)(void *, void **, void *),
+        void (**fnOut)(void)) {
+    if (method == NULL || bind == NULL || fnOut == NULL) {
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    celix_auto(celix_mutex_lock_guard_t) lock = celixMutexLockGuard_init(&dfi_cacheMutex);
+    void (*closureBind)(void *, void **, void *) = NULL;
+    void *closureData = NULL;
+    if (dynFunction_getClosureBind(method->dynFunc, &closureBind, &closureData) == 0) {
+        if (closureBind != bind || closureData != method) {
+            //the shared closure would call the bind function of another user
+            return CELIX_ILLEGAL_STATE;
+        }
+        return dynFunction_getFnPointer(method->dynFunc, fnOut) == 0 ? CELIX_SUCCESS : CELIX_BUNDLE_EXCEPTION;
+    }
+    return dynFunction_createClosure(method->dynFunc, bind, method, fnOut) == 0 ? CELIX_SUCCESS : CELIX_BUNDLE_EXCEPTION;
+}
@@ -0,0 +1,258 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include "rsa_rpc.h"
+#include "rsa_rpc_endpoint_impl.h"
+#include "rsa_binary_rpc_serializer.h"
+#include "rsa_binary_rpc_constants.h"
+#include "RsaBinaryRpcTestService.h"
+#include "endpoint_description.h"
+#include "remote_constants.h"
+#include "celix_log_helper.h"
+#include "celix_properties.h"
+#include "celix_types.h"
+#include "celix_framework.h"
+#include "celix_bundle_context.h"
+#include "celix_framework_factory.h"
+#include "celix_constants.h"
+#include "celix_utils.h"
+#include "malloc_ei.h"
+#include "celix_threads_ei.h"
+#include "celix_bundle_context_ei.h"
+#include "celix_framework_version.h"
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+class RsaBinaryRpcUnitTestSuite : public ::testing::Test {
+public:
+    RsaBinaryRpcUnitTestSuite() {
+        auto* props = celix_properties_create();
+        celix_properties_set(props, CELIX_FRAMEWORK_CACHE_DIR, ".rsa_binary_rpc_impl_cache");
+        celix_properties_set(props, RSA_BINARY_RPC_LOG_CALLS_KEY, "true");
+        celix_properties_set(props, "CELIX_FRAMEWORK_EXTENDER_PATH", RESOURCES_DIR);
+        auto* fwPtr = celix_frameworkFactory_createFramework(props);
+        auto* ctxPtr = celix_framework_getFrameworkContext(fwPtr);
+        fw = std::shared_ptr<celix_framework_t>{fwPtr, [](auto* f) {celix_frameworkFactory_destroyFramework(f);}};
+        ctx = std::shared_ptr<celix_bundle_context_t>{ctxPtr, [](auto*){/*nop*/}};
+        auto* logHelperPtr = celix_logHelper_create(ctxPtr,"RsaBinaryRpc");
+        logHelper = std::shared_ptr<celix_log_helper_t>{logHelperPtr, [](auto*l){ celix_logHelper_destroy(l);}};
+
+        rsa_rpc_t *binaryRpcPtr = nullptr;
+        auto status  = rsaRpc_create(ctxPtr, logHelperPtr, &rsaBinaryRpc_serializer, &binaryRpcPtr);
+        EXPECT_EQ(CELIX_SUCCESS, status);
+        EXPECT_NE(nullptr, binaryRpcPtr);
+        binaryRpc = std::shared_ptr<rsa_rpc_t>{binaryRpcPtr, [](auto* r){rsaRpc_destroy(r);}};
+
+        static rsa_rpc_binary_test_service_t testSvc{};
+        testSvc.handle = this;
+        testSvc.add = [](void *handle, double a, double b, double *result) -> int {
+            auto self = static_cast<RsaBinaryRpcUnitTestSuite*>(handle);
+            *result = a + b;
+            return self->addStatus;
+        };
+        celix_service_registration_options_t opts{};
+        opts.serviceName = RSA_RPC_BINARY_TEST_SERVICE;
+        opts.serviceVersion = RSA_RPC_BINARY_TEST_SERVICE_VERSION;
+        opts.svc = &testSvc;
+        rpcTestSvcId = celix_bundleContext_registerServiceWithOptions(ctxPtr, &opts);
+        EXPECT_NE(-1, rpcTestSvcId);
+    }
+
+    ~RsaBinaryRpcUnitTestSuite() override {
+        celix_bundleContext_unregisterService(ctx.get(), rpcTestSvcId);
+        celix_ei_expect_calloc(nullptr, 0, nullptr);
+        celix_ei_expect_celixThreadRwlock_create(nullptr, 0, 0);
+        celix_ei_expect_celix_bundleContext_trackServicesWithOptions(nullptr, 0, 0);
+    }
+
+    endpoint_description_t *CreateEndpointDescription(long svcId = 100/*set a dummy service id*/) {
+        endpoint_description_t *endpointDesc = (endpoint_description_t *)calloc(1, sizeof(endpoint_description_t));
+        EXPECT_NE(endpointDesc, nullptr);
+        endpointDesc->properties = celix_properties_create();
+        EXPECT_TRUE(endpointDesc->properties != nullptr);
+        const char *uuid = celix_bundleContext_getProperty(ctx.get(), CELIX_FRAMEWORK_UUID, nullptr);
+        celix_properties_set(endpointDesc->properties, CELIX_RSA_ENDPOINT_FRAMEWORK_UUID, uuid);
+        celix_properties_set(endpointDesc->properties, CELIX_FRAMEWORK_SERVICE_NAME, RSA_RPC_BINARY_TEST_SERVICE);
+        celix_properties_set(endpointDesc->properties, CELIX_FRAMEWORK_SERVICE_VERSION, RSA_RPC_BINARY_TEST_SERVICE_VERSION);
+        celix_properties_set(endpointDesc->properties, CELIX_RSA_ENDPOINT_ID, "8cf05b2d-421e-4c46-b55e-c3f1900b7cba");
+        celix_properties_set(endpointDesc->properties, CELIX_RSA_SERVICE_IMPORTED, "true");
+        endpointDesc->frameworkUUID = (char*)celix_properties_get(endpointDesc->properties, CELIX_RSA_ENDPOINT_FRAMEWORK_UUID, nullptr);
+        endpointDesc->serviceId = svcId;
+        endpointDesc->id = (char*)celix_properties_get(endpointDesc->properties, CELIX_RSA_ENDPOINT_ID, nullptr);
+        endpointDesc->serviceName = strdup(RSA_RPC_BINARY_TEST_SERVICE);
+        return endpointDesc;
+    }
+
+    //Sends the requests of the proxy directly to the endpoint, as a remote service admin would do
+    static celix_status_t SendRequestToEndpoint(void *handle, const endpoint_description_t *endpointDescription,
+                                                celix_properties_t *metadata, const struct iovec *request, struct iovec *response) {
+        (void) endpointDescription;
+        auto self = static_cast<RsaBinaryRpcUnitTestSuite*>(handle);
+        self->lastRequestSize = request->iov_len;
+        return rsaRpc_handleRequest(self->binaryRpc.get(), self->endpointId, metadata, request, response);
+    }
+
+    void CreateEndpointAndProxy(const char* providerVersion = RSA_RPC_BINARY_TEST_SERVICE_VERSION) {
+        celix_autoptr(endpoint_description_t) endpoint = CreateEndpointDescription(rpcTestSvcId);
+        celix_properties_set(endpoint->properties, CELIX_FRAMEWORK_SERVICE_VERSION, providerVersion);
+        auto status = rsaRpc_createEndpoint(binaryRpc.get(), endpoint, &endpointId);
+        EXPECT_EQ(CELIX_SUCCESS, status);
+        status = rsaRpc_createProxy(binaryRpc.get(), endpoint, SendRequestToEndpoint, this, &proxyId);
+        EXPECT_EQ(CELIX_SUCCESS, status);
+        celix_bundleContext_waitForEvents(ctx.get());//wait for proxy service registration
+    }
+
+    void DestroyEndpointAndProxy() {
+        rsaRpc_destroyProxy(binaryRpc.get(), proxyId);
+        rsaRpc_destroyEndpoint(binaryRpc.get(), endpointId);
+        celix_bundleContext_waitForEvents(ctx.get());
+    }
+
+    unsigned int GenerateSerialProtoId() {//The same as rsaRpc_generateSerialProtoId
+        const char *bundleSymName = celix_bundle_getSymbolicName(celix_bundleContext_getBundle(ctx.get()));
+        return celix_utils_stringHash(bundleSymName) + CELIX_FRAMEWORK_VERSION_MAJOR;
+    }
+
+    std::shared_ptr<celix_framework_t> fw{};
+    std::shared_ptr<celix_bundle_context_t> ctx{};
+    std::shared_ptr<celix_log_helper_t> logHelper{};
+    std::shared_ptr<rsa_rpc_t> binaryRpc{};
+    long rpcTestSvcId{-1};
+    long endpointId{-1};
+    long proxyId{-1};
+    int addStatus{CELIX_SUCCESS};
+    size_t lastRequestSize{0};
+};
+
+TEST_F(RsaBinaryRpcUnitTestSuite, CreateRsaBinaryRpcWithInvalidParams) {
+    rsa_rpc_t *rpc = nullptr;
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, rsaRpc_create(nullptr, logHelper.get(), &rsaBinaryRpc_serializer, &rpc));
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, rsaRpc_create(ctx.get(), nullptr, &rsaBinaryRpc_serializer, &rpc));
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, rsaRpc_create(ctx.get(), logHelper.get(), &rsaBinaryRpc_serializer, nullptr));
+}
+
+TEST_F(RsaBinaryRpcUnitTestSuite, CreateRsaBinaryRpcWithENOMEM) {
+    rsa_rpc_t *rpc = nullptr;
+    celix_ei_expect_calloc((void*)&rsaRpc_create, 0, nullptr);
+    EXPECT_EQ(CELIX_ENOMEM, rsaRpc_create(ctx.get(), logHelper.get(), &rsaBinaryRpc_serializer, &rpc));
+}
+
+TEST_F(RsaBinaryRpcUnitTestSuite, CallProxyService) {
+    CreateEndpointAndProxy();
+
+    auto found = celix_bundleContext_useService(ctx.get(), RSA_RPC_BINARY_TEST_SERVICE, nullptr, [](void *, void *svc) {
+        auto proxySvc = static_cast<rsa_rpc_binary_test_service_t*>(svc);
+        double result = 0.0;
+        EXPECT_EQ(CELIX_SUCCESS, proxySvc->add(proxySvc->handle, 1.0, 2.0, &result));
+        EXPECT_EQ(3.0, result);
+    });
+    EXPECT_TRUE(found);
+    EXPECT_EQ(sizeof(uint32_t) + 2 * sizeof(double), lastRequestSize);//method index and the 2 arguments
+
+    DestroyEndpointAndProxy();
+}
+
+TEST_F(RsaBinaryRpcUnitTestSuite, RemoteServiceReturnsError) {
+    CreateEndpointAndProxy();
+    addStatus = CELIX_CUSTOMER_ERROR_MAKE(0, 1);
+
+    auto found = celix_bundleContext_useService(ctx.get(), RSA_RPC_BINARY_TEST_SERVICE, nullptr, [](void *, void *svc) {
+        auto proxySvc = static_cast<rsa_rpc_binary_test_service_t*>(svc);
+        double result = 0.0;
+        EXPECT_EQ(CELIX_CUSTOMER_ERROR_MAKE(0, 1), proxySvc->add(proxySvc->handle, 1.0, 2.0, &result));
+        EXPECT_EQ(0.0, result);
+    });
+    EXPECT_TRUE(found);
+
+    DestroyEndpointAndProxy();
+}
+
+TEST_F(RsaBinaryRpcUnitTestSuite, ServiceVersionMustBeEqual) {
+    //The json rpc accepts a compatible provider version, but the binary encoding requires an equal descriptor
+    CreateEndpointAndProxy("1.1.0");
+
+    auto found = celix_bundleContext_useService(ctx.get(), RSA_RPC_BINARY_TEST_SERVICE, nullptr, [](void*, void*) {});
+    EXPECT_FALSE(found);
+
+    DestroyEndpointAndProxy();
+}
+
+TEST_F(RsaBinaryRpcUnitTestSuite, FailedToCreateEndpointLock) {
+    celix_autoptr(endpoint_description_t) endpoint = CreateEndpointDescription(rpcTestSvcId);
+    celix_ei_expect_celixThreadRwlock_create((void*)&rsaRpcEndpoint_create, 0, CELIX_ENOMEM);
+    long epId = -1L;
+    EXPECT_EQ(CELIX_ENOMEM, rsaRpc_createEndpoint(binaryRpc.get(), endpoint, &epId));
+}
+
+TEST_F(RsaBinaryRpcUnitTestSuite, FailedToTrackEndpointService) {
+    celix_autoptr(endpoint_description_t) endpoint = CreateEndpointDescription(rpcTestSvcId);
+    celix_ei_expect_celix_bundleContext_trackServicesWithOptions((void*)&rsaRpcEndpoint_create, 0, -1);
+    long epId = -1L;
+    EXPECT_EQ(CELIX_ILLEGAL_STATE, rsaRpc_createEndpoint(binaryRpc.get(), endpoint, &epId));
+}
+
+TEST_F(RsaBinaryRpcUnitTestSuite, HandleRequestWithoutService) {
+    celix_autoptr(endpoint_description_t) endpoint = CreateEndpointDescription();//dummy service id, which is not registered
+    long epId = -1L;
+    EXPECT_EQ(CELIX_SUCCESS, rsaRpc_createEndpoint(binaryRpc.get(), endpoint, &epId));
+    celix_bundleContext_waitForEvents(ctx.get());//wait for async endpoint creation
+
+    celix_autoptr(celix_properties_t) metadata = celix_properties_create();
+    celix_properties_setLong(metadata, "SerialProtocolId", GenerateSerialProtoId());
+    std::string request{"\x00\x00\x00\x00", 4};
+    struct iovec iov{(void*)request.data(), request.size()};
+    struct iovec reply{nullptr, 0};
+    EXPECT_EQ(CELIX_ILLEGAL_STATE, rsaRpc_handleRequest(binaryRpc.get(), epId, metadata, &iov, &reply));
+    EXPECT_EQ(nullptr, reply.iov_base);
+
+    rsaRpc_destroyEndpoint(binaryRpc.get(), epId);
+}
+
+TEST_F(RsaBinaryRpcUnitTestSuite, HandleInvalidRequest) {
+    celix_autoptr(endpoint_description_t) endpoint = CreateEndpointDescription(rpcTestSvcId);
+    long epId = -1L;
+    EXPECT_EQ(CELIX_SUCCESS, rsaRpc_createEndpoint(binaryRpc.get(), endpoint, &epId));
+    celix_bundleContext_waitForEvents(ctx.get());//wait for async endpoint creation
+
+    celix_autoptr(celix_properties_t) metadata = celix_properties_create();
+    celix_properties_setLong(metadata, "SerialProtocolId", GenerateSerialProtoId());
+    struct iovec reply{nullptr, 0};
+
+    //invalid method index
+    std::string invalidIndex{"\x01\x00\x00\x00", 4};
+    struct iovec request{(void*)invalidIndex.data(), invalidIndex.size()};
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, rsaRpc_handleRequest(binaryRpc.get(), epId, metadata, &request, &reply));
+
+    //truncated method index
+    request.iov_len = 2;
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, rsaRpc_handleRequest(binaryRpc.get(), epId, metadata, &request, &reply));
+
+    //missing arguments
+    std::string missingArgs{"\x00\x00\x00\x00", 4};
+    request = {(void*)missingArgs.data(), missingArgs.size()};
+    EXPECT_EQ(CELIX_SERVICE_EXCEPTION, rsaRpc_handleRequest(binaryRpc.get(), epId, metadata, &request, &reply));
+    EXPECT_EQ(nullptr, reply.iov_base);
+
+    //serialization protocol mismatch
+    celix_properties_setLong(metadata, "SerialProtocolId", GenerateSerialProtoId() + 1);
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, rsaRpc_handleRequest(binaryRpc.get(), epId, metadata, &request, &reply));
+
+    rsaRpc_destroyEndpoint(binaryRpc.get(), epId);
+}
@@ -0,0 +1,28 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "rsa_binary_rpc_serializer.h"
+#include "rsa_rpc.h"
+#include "celix_bundle_activator.h"
+
+static celix_status_t rsaBinaryRpc_start(rsa_rpc_activator_t* activator, celix_bundle_context_t* ctx) {
+    return rsaRpcActivator_start(activator, ctx, &rsaBinaryRpc_serializer);
+}
+
+CELIX_GEN_BUNDLE_ACTIVATOR(rsa_rpc_activator_t, rsaBinaryRpc_start, rsaRpcActivator_stop)
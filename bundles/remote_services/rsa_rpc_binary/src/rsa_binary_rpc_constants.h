@@ -0,0 +1,42 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef _RSA_BINARY_RPC_CONSTANTS_H_
+#define _RSA_BINARY_RPC_CONSTANTS_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RSA_BINARY_RPC_LOG_CALLS_KEY               "RSA_BINARY_RPC_LOG_CALLS"
+#define RSA_BINARY_RPC_LOG_CALLS_FILE_KEY          "RSA_BINARY_RPC_LOG_CALLS_FILE"
+
+/**
+ * @brief The rpc type of the binary rpc factory service, see CELIX_RSA_RPC_TYPE_KEY.
+ *
+ * A remote service admin selects the binary rpc for an endpoint by this value, e.g. for RSA SHM by setting the
+ * `celix.remote.admin.shm.rpc_type` property of the exported service.
+ */
+#define RSA_BINARY_RPC_TYPE                         "celix.remote.admin.rpc_type.binary"
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RSA_BINARY_RPC_CONSTANTS_H_ */
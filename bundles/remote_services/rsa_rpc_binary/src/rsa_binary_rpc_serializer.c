@@ -0,0 +1,65 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "rsa_binary_rpc_serializer.h"
+#include "rsa_binary_rpc_constants.h"
+#include "binary_rpc.h"
+#include "celix_err.h"
+
+static int rsaBinaryRpc_prepareInvokeRequest(const dyn_function_type* func, const char* id, int index, void* args[],
+                                             void** request, size_t* requestSize) {
+    (void)id;
+    return binaryRpc_prepareInvokeRequest(func, index, args, request, requestSize);
+}
+
+static int rsaBinaryRpc_parseRequest(const struct iovec* request, void** parsedRequest, const char** method,
+                                     int* methodIndex) {
+    (void)parsedRequest;
+    int index = 0;
+    if (binaryRpc_getMethodIndex(request->iov_base, request->iov_len, &index) != 0) {
+        return 1;
+    }
+    *method = NULL;
+    *methodIndex = index;
+    return 0;
+}
+
+static int rsaBinaryRpc_call(const dyn_interface_type* intf, void* service, const struct iovec* request,
+                             void* parsedRequest, struct iovec* response) {
+    (void)parsedRequest;
+    return binaryRpc_call(intf, service, request->iov_base, request->iov_len, &response->iov_base,
+                          &response->iov_len);
+}
+
+const rsa_rpc_serializer_t rsaBinaryRpc_serializer = {
+    .name = "rsa_binary_rpc",
+    .rpcType = RSA_BINARY_RPC_TYPE,
+    .logCallsKey = RSA_BINARY_RPC_LOG_CALLS_KEY,
+    .logCallsFileKey = RSA_BINARY_RPC_LOG_CALLS_FILE_KEY,
+    .textPayload = false,
+    //The binary encoding is positional (method index, argument and member order), so unlike the json rpc a
+    //compatible version is not enough; consumer and provider must use the same interface descriptor.
+    .sameVersionRequired = true,
+    .methodIndexKey = NULL,
+    .prepareInvokeRequest = rsaBinaryRpc_prepareInvokeRequest,
+    .handleReply = binaryRpc_handleReply,
+    .parseRequest = rsaBinaryRpc_parseRequest,
+    .call = rsaBinaryRpc_call,
+    .freeRequest = NULL,
+};
@@ -16,22 +16,22 @@
  * specific language governing permissions and limitations
  * under the License.
  */
-//TODO: Move it to libs/error_injector and use conan to import thpool
-#include "thpool_ei.h"
 
+#ifndef _RSA_BINARY_RPC_SERIALIZER_H_
+#define _RSA_BINARY_RPC_SERIALIZER_H_
+
+#ifdef __cplusplus
 extern "C" {
-struct thpool_* __real_thpool_init(int num_threads);
-CELIX_EI_DEFINE(thpool_init, struct thpool_*)
-struct thpool_* __wrap_thpool_init(int num_threads) {
-    CELIX_EI_IMPL(thpool_init);
-    return __real_thpool_init(num_threads);
-}
+#endif
+#include "rsa_rpc_serializer.h"
+
+/**
+ * @brief The binary serialization of the remote calls, see binary_rpc.h.
+ */
+extern const rsa_rpc_serializer_t rsaBinaryRpc_serializer;
 
-int __real_thpool_add_work(struct thpool_* thpool_p, void (*function_p)(void*), void* arg_p);
-CELIX_EI_DEFINE(thpool_add_work, int)
-int __wrap_thpool_add_work(struct thpool_* thpool_p, void (*function_p)(void*), void* arg_p) {
-    CELIX_EI_IMPL(thpool_add_work);
-    return __real_thpool_add_work(thpool_p, function_p, arg_p);
+#ifdef __cplusplus
 }
+#endif
 
-}
\ No newline at end of file
+#endif /* _RSA_BINARY_RPC_SERIALIZER_H_ */
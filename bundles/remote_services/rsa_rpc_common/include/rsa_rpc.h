@@ -0,0 +1,91 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef _RSA_RPC_H_
+#define _RSA_RPC_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include "rsa_rpc_serializer.h"
+#include "endpoint_description.h"
+#include "celix_rsa_rpc_factory.h"
+#include "celix_cleanup.h"
+#include "celix_log_helper.h"
+#include "celix_types.h"
+#include "celix_errno.h"
+
+/**
+ * @brief The rpc of a rpc bundle, which creates the proxies and endpoints of a celix_rsa_rpc_factory_t service.
+ *
+ * The requests and replies are encoded by the serializer of the rpc bundle.
+ */
+typedef struct rsa_rpc rsa_rpc_t;
+
+celix_status_t rsaRpc_create(celix_bundle_context_t* ctx, celix_log_helper_t *logHelper,
+        const rsa_rpc_serializer_t* serializer, rsa_rpc_t **rpcOut);
+
+void rsaRpc_destroy(rsa_rpc_t *rpc);
+
+CELIX_DEFINE_AUTOPTR_CLEANUP_FUNC(rsa_rpc_t, rsaRpc_destroy)
+
+celix_status_t rsaRpc_createProxy(void* handle, const endpoint_description_t* endpointDesc,
+                                  celix_rsa_send_request_fp sendRequest, void* sendRequestHandle, long* proxyId);
+
+void rsaRpc_destroyProxy(void *handle, long proxyId);
+
+celix_status_t rsaRpc_createEndpoint(void *handle, const endpoint_description_t *endpointDesc,
+        long *endpointId);
+
+void rsaRpc_destroyEndpoint(void *handle, long endpointId);
+
+celix_status_t rsaRpc_handleRequest(void *handle, long endpointId, celix_properties_t *metadata, const struct iovec *request, struct iovec *response);
+
+/**
+ * @brief The bundle activator of a rpc bundle, see CELIX_GEN_BUNDLE_ACTIVATOR.
+ *
+ * A rpc bundle starts it with its serializer, e.g.
+ * @code
+ * static celix_status_t rsaJsonRpc_start(rsa_rpc_activator_t* activator, celix_bundle_context_t* ctx) {
+ *     return rsaRpcActivator_start(activator, ctx, &rsaJsonRpc_serializer);
+ * }
+ * CELIX_GEN_BUNDLE_ACTIVATOR(rsa_rpc_activator_t, rsaJsonRpc_start, rsaRpcActivator_stop)
+ * @endcode
+ */
+typedef struct rsa_rpc_activator {
+    celix_bundle_context_t *ctx;
+    rsa_rpc_t *rpc;
+    celix_rsa_rpc_factory_t rpcFac;
+    long rpcSvcId;
+    celix_log_helper_t *logHelper;
+} rsa_rpc_activator_t;
+
+/**
+ * @brief Create the rpc for the serializer and register it as celix_rsa_rpc_factory_t service.
+ */
+celix_status_t rsaRpcActivator_start(rsa_rpc_activator_t* activator, celix_bundle_context_t* ctx,
+        const rsa_rpc_serializer_t* serializer);
+
+celix_status_t rsaRpcActivator_stop(rsa_rpc_activator_t* activator, celix_bundle_context_t* ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RSA_RPC_H_ */
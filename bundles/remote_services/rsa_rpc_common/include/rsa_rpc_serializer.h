@@ -0,0 +1,135 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef _RSA_RPC_SERIALIZER_H_
+#define _RSA_RPC_SERIALIZER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include "dyn_interface.h"
+#include "dyn_function.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <sys/uio.h>
+
+/**
+ * @brief The serialization of remote calls used by a rpc bundle.
+ *
+ * The rpc factory service, the proxies and the endpoints are shared by the rpc bundles (see rsa_rpc.h); a rpc bundle
+ * only provides how requests and replies are encoded. In case of an error, the functions return a non-zero value and
+ * add an error message to celix_err.
+ */
+typedef struct rsa_rpc_serializer {
+    /**
+     * @brief The name of the rpc bundle, e.g. "rsa_json_rpc". It is used as name of the log helper.
+     */
+    const char* name;
+    /**
+     * @brief The rpc type of the rpc factory service, see CELIX_RSA_RPC_TYPE_KEY.
+     */
+    const char* rpcType;
+    /**
+     * @brief The config property which enables logging the remote calls. Logging is disabled by default.
+     */
+    const char* logCallsKey;
+    /**
+     * @brief The config property with the file the remote calls are logged to. Default is stdout.
+     */
+    const char* logCallsFileKey;
+    /**
+     * @brief Whether the requests and replies are '\0' terminated text, which can be written to the calls log.
+     * Otherwise only their sizes are logged.
+     */
+    bool textPayload;
+    /**
+     * @brief Whether the interface descriptors of consumer and provider must have the same version.
+     * Otherwise a proxy is also created for a compatible provider version.
+     */
+    bool sameVersionRequired;
+    /**
+     * @brief The endpoint property announcing that the provider accepts method indexes, or NULL if requests are
+     * always addressed by method index.
+     *
+     * A method index is only used if consumer and provider have the same interface descriptor version.
+     */
+    const char* methodIndexKey;
+
+    /**
+     * @brief Prepare the request of a proxy call.
+     *
+     * @param[in] func The function type of the called method.
+     * @param[in] id The id (signature) of the called method.
+     * @param[in] index The index of the called method, or -1 if the method must be addressed by its id.
+     * @param[in] args The arguments of the call.
+     * @param[out] request The request. The caller should release it using free.
+     * @param[out] requestSize The size of the request.
+     */
+    int (*prepareInvokeRequest)(const dyn_function_type* func, const char* id, int index, void* args[],
+                                void** request, size_t* requestSize);
+
+    /**
+     * @brief Handle the reply of a proxy call, which sets the output arguments of the call.
+     *
+     * @param[in] func The function type of the called method.
+     * @param[in] reply The reply.
+     * @param[in] replySize The size of the reply.
+     * @param[in] args The arguments of the call.
+     * @param[out] rsErrno The return status of the remote service function.
+     */
+    int (*handleReply)(const dyn_function_type* func, const void* reply, size_t replySize, void* args[], int* rsErrno);
+
+    /**
+     * @brief Parse a request of an endpoint.
+     *
+     * The request addresses the method either by its id or by its index. The interface of the exported service is not
+     * needed to parse it; the endpoint resolves a method index itself. In case of an error, nothing is returned in
+     * parsedRequest.
+     *
+     * @param[in] request The request.
+     * @param[out] parsedRequest The parsed request, which is passed to call and freeRequest. Can be NULL.
+     * @param[out] method The id (signature) of the requested method, which is owned by the parsed request, or NULL if
+     *                    the method is addressed by its index.
+     * @param[out] methodIndex The index of the requested method, or -1 if the method is addressed by its id.
+     */
+    int (*parseRequest)(const struct iovec* request, void** parsedRequest, const char** method, int* methodIndex);
+
+    /**
+     * @brief Call the exported service for a request of an endpoint.
+     *
+     * @param[in] intf The interface of the exported service.
+     * @param[in] service The exported service.
+     * @param[in] request The request.
+     * @param[in] parsedRequest The request parsed by parseRequest.
+     * @param[out] response The reply. The caller should release its iov_base using free.
+     */
+    int (*call)(const dyn_interface_type* intf, void* service, const struct iovec* request, void* parsedRequest,
+                struct iovec* response);
+
+    /**
+     * @brief Release a request parsed by parseRequest. Can be NULL if parseRequest does not allocate.
+     */
+    void (*freeRequest)(void* parsedRequest);
+} rsa_rpc_serializer_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RSA_RPC_SERIALIZER_H_ */
@@ -17,10 +17,9 @@
  * under the License.
  */
 
-#include "rsa_json_rpc_impl.h"
-#include "rsa_json_rpc_constants.h"
-#include "rsa_json_rpc_endpoint_impl.h"
-#include "rsa_json_rpc_proxy_impl.h"
+#include "rsa_rpc.h"
+#include "rsa_rpc_endpoint_impl.h"
+#include "rsa_rpc_proxy_impl.h"
 #include "remote_interceptors_handler.h"
 #include "endpoint_description.h"
 #include "celix_long_hash_map.h"
@@ -36,18 +35,19 @@
 #include <stddef.h>
 #include <string.h>
 
-struct rsa_json_rpc {
+struct rsa_rpc {
     celix_bundle_context_t *ctx;
     celix_log_helper_t *logHelper;
     celix_thread_mutex_t mutex; //It protects svcProxyFactories and svcEndpoints
-    celix_long_hash_map_t *svcProxyFactories;// Key: proxy factory service id, Value: rsa_json_rpc_proxy_factory_t
-    celix_long_hash_map_t *svcEndpoints;// Key:request handler service id, Value: rsa_json_rpc_endpoint_t
+    celix_long_hash_map_t *svcProxyFactories;// Key: proxy factory service id, Value: rsa_rpc_proxy_factory_t
+    celix_long_hash_map_t *svcEndpoints;// Key:request handler service id, Value: rsa_rpc_endpoint_t
     remote_interceptors_handler_t *interceptorsHandler;
     unsigned int serialProtoId; //Serialization protocol ID
     FILE *callsLogFile;
+    const rsa_rpc_serializer_t *serializer;
 };
 
-static unsigned int rsaJsonRpc_generateSerialProtoId(celix_bundle_t *bnd) {
+static unsigned int rsaRpc_generateSerialProtoId(celix_bundle_t *bnd) {
     const char *bundleSymName = celix_bundle_getSymbolicName(bnd);
     const celix_version_t* bundleVer = celix_bundle_getVersion(bnd);
     if (bundleSymName == NULL || bundleVer == NULL) {
@@ -57,21 +57,22 @@ static unsigned int rsaJsonRpc_generateSerialProtoId(celix_bundle_t *bnd) {
     return celix_utils_stringHash(bundleSymName) + major;
 }
 
-celix_status_t rsaJsonRpc_create(celix_bundle_context_t* ctx, celix_log_helper_t *logHelper,
-        rsa_json_rpc_t **jsonRpcOut) {
+celix_status_t rsaRpc_create(celix_bundle_context_t* ctx, celix_log_helper_t *logHelper,
+        const rsa_rpc_serializer_t* serializer, rsa_rpc_t **rpcOut) {
     celix_status_t status = CELIX_SUCCESS;
-    if (ctx == NULL || logHelper == NULL || jsonRpcOut == NULL) {
+    if (ctx == NULL || logHelper == NULL || serializer == NULL || rpcOut == NULL) {
         return CELIX_ILLEGAL_ARGUMENT;
     }
 
-    celix_autofree rsa_json_rpc_t *rpc = calloc(1, sizeof(rsa_json_rpc_t));
+    celix_autofree rsa_rpc_t *rpc = calloc(1, sizeof(rsa_rpc_t));
     if (rpc == NULL) {
-        celix_logHelper_error(logHelper, "Failed to allocate memory for rsa_json_rpc_t.");
+        celix_logHelper_error(logHelper, "Failed to allocate memory for rsa_rpc_t.");
         return CELIX_ENOMEM;
     }
     rpc->ctx = ctx;
     rpc->logHelper = logHelper;
-    rpc->serialProtoId = rsaJsonRpc_generateSerialProtoId(celix_bundleContext_getBundle(ctx));
+    rpc->serializer = serializer;
+    rpc->serialProtoId = rsaRpc_generateSerialProtoId(celix_bundleContext_getBundle(ctx));
     if (rpc->serialProtoId == 0) {
         celix_logHelper_error(logHelper, "Error generating serialization protocol id.");
         return CELIX_BUNDLE_EXCEPTION;
@@ -94,9 +95,9 @@ celix_status_t rsaJsonRpc_create(celix_bundle_context_t* ctx, celix_log_helper_t
     }
     celix_autoptr(remote_interceptors_handler_t) interceptorsHandler = rpc->interceptorsHandler;
 
-    bool logCalls = celix_bundleContext_getPropertyAsBool(ctx, RSA_JSON_RPC_LOG_CALLS_KEY, RSA_JSON_RPC_LOG_CALLS_DEFAULT);
+    bool logCalls = celix_bundleContext_getPropertyAsBool(ctx, serializer->logCallsKey, false);
     if (logCalls) {
-        const char *f = celix_bundleContext_getProperty(ctx, RSA_JSON_RPC_LOG_CALLS_FILE_KEY, RSA_JSON_RPC_LOG_CALLS_FILE_DEFAULT);
+        const char *f = celix_bundleContext_getProperty(ctx, serializer->logCallsFileKey, "stdout");
         if (strncmp(f, "stdout", strlen("stdout")) == 0) {
             rpc->callsLogFile = stdout;
         } else {
@@ -110,27 +111,27 @@ celix_status_t rsaJsonRpc_create(celix_bundle_context_t* ctx, celix_log_helper_t
     celix_steal_ptr(svcEndpoints);
     celix_steal_ptr(svcProxyFactories);
     celix_steal_ptr(mutex);
-    *jsonRpcOut = celix_steal_ptr(rpc);
+    *rpcOut = celix_steal_ptr(rpc);
     return CELIX_SUCCESS;
 }
 
-void rsaJsonRpc_destroy(rsa_json_rpc_t *jsonRpc) {
-    if (jsonRpc != NULL) {
-        if (jsonRpc->callsLogFile != NULL && jsonRpc->callsLogFile != stdout) {
-            fclose(jsonRpc->callsLogFile);
+void rsaRpc_destroy(rsa_rpc_t *rpc) {
+    if (rpc != NULL) {
+        if (rpc->callsLogFile != NULL && rpc->callsLogFile != stdout) {
+            fclose(rpc->callsLogFile);
         }
-        remoteInterceptorsHandler_destroy(jsonRpc->interceptorsHandler);
-        assert(celix_longHashMap_size(jsonRpc->svcEndpoints) == 0);
-        celix_longHashMap_destroy(jsonRpc->svcEndpoints);
-        assert(celix_longHashMap_size(jsonRpc->svcProxyFactories) == 0);
-        celix_longHashMap_destroy(jsonRpc->svcProxyFactories);
-        (void)celixThreadMutex_destroy(&jsonRpc->mutex);
-        free(jsonRpc);
+        remoteInterceptorsHandler_destroy(rpc->interceptorsHandler);
+        assert(celix_longHashMap_size(rpc->svcEndpoints) == 0);
+        celix_longHashMap_destroy(rpc->svcEndpoints);
+        assert(celix_longHashMap_size(rpc->svcProxyFactories) == 0);
+        celix_longHashMap_destroy(rpc->svcProxyFactories);
+        (void)celixThreadMutex_destroy(&rpc->mutex);
+        free(rpc);
     }
     return;
 }
 
-celix_status_t rsaJsonRpc_createProxy(void* handle, const endpoint_description_t* endpointDesc,
+celix_status_t rsaRpc_createProxy(void* handle, const endpoint_description_t* endpointDesc,
                                       celix_rsa_send_request_fp sendRequest, void* sendRequestHandle, long* proxyId) {
     celix_status_t status= CELIX_SUCCESS;
 
@@ -139,94 +140,94 @@ celix_status_t rsaJsonRpc_createProxy(void* handle, const endpoint_description_t
         return CELIX_ILLEGAL_ARGUMENT;
     }
 
-    rsa_json_rpc_t *jsonRpc = (rsa_json_rpc_t *)handle;
+    rsa_rpc_t *rpc = (rsa_rpc_t *)handle;
 
-    rsa_json_rpc_proxy_factory_t *proxyFactory = NULL;
-    status = rsaJsonRpcProxy_factoryCreate(jsonRpc->ctx, jsonRpc->logHelper,
-            jsonRpc->callsLogFile, jsonRpc->interceptorsHandler, endpointDesc,
-            sendRequest, sendRequestHandle, jsonRpc->serialProtoId, &proxyFactory);
+    rsa_rpc_proxy_factory_t *proxyFactory = NULL;
+    status = rsaRpcProxy_factoryCreate(rpc->ctx, rpc->logHelper,
+            rpc->callsLogFile, rpc->interceptorsHandler, endpointDesc,
+            sendRequest, sendRequestHandle, rpc->serialProtoId, rpc->serializer, &proxyFactory);
     if (status != CELIX_SUCCESS) {
-        celix_logHelper_error(jsonRpc->logHelper, "Error creating proxy factory for %s.", endpointDesc->serviceName);
+        celix_logHelper_error(rpc->logHelper, "Error creating proxy factory for %s.", endpointDesc->serviceName);
         return status;
     }
-    long factorySvcId = rsaJsonRpcProxy_factorySvcId(proxyFactory);
+    long factorySvcId = rsaRpcProxy_factorySvcId(proxyFactory);
 
-    celixThreadMutex_lock(&jsonRpc->mutex);
-    celix_longHashMap_put(jsonRpc->svcProxyFactories, factorySvcId, proxyFactory);
-    celixThreadMutex_unlock(&jsonRpc->mutex);
+    celixThreadMutex_lock(&rpc->mutex);
+    celix_longHashMap_put(rpc->svcProxyFactories, factorySvcId, proxyFactory);
+    celixThreadMutex_unlock(&rpc->mutex);
     *proxyId = factorySvcId;
 
     return CELIX_SUCCESS;
 }
 
-void rsaJsonRpc_destroyProxy(void *handle, long proxyId) {
+void rsaRpc_destroyProxy(void *handle, long proxyId) {
     if (handle == NULL) {
         return;
     }
-    rsa_json_rpc_t *jsonRpc = (rsa_json_rpc_t *)handle;
-    celixThreadMutex_lock(&jsonRpc->mutex);
-    rsa_json_rpc_proxy_factory_t *proxyFactory =
-            celix_longHashMap_get(jsonRpc->svcProxyFactories, proxyId);
+    rsa_rpc_t *rpc = (rsa_rpc_t *)handle;
+    celixThreadMutex_lock(&rpc->mutex);
+    rsa_rpc_proxy_factory_t *proxyFactory =
+            celix_longHashMap_get(rpc->svcProxyFactories, proxyId);
     if (proxyFactory != NULL) {
-        (void)celix_longHashMap_remove(jsonRpc->svcProxyFactories, proxyId);
-        rsaJsonRpcProxy_factoryDestroy(proxyFactory);
+        (void)celix_longHashMap_remove(rpc->svcProxyFactories, proxyId);
+        rsaRpcProxy_factoryDestroy(proxyFactory);
     }
-    celixThreadMutex_unlock(&jsonRpc->mutex);
+    celixThreadMutex_unlock(&rpc->mutex);
     return;
 }
 
-celix_status_t rsaJsonRpc_createEndpoint(void *handle, const endpoint_description_t *endpointDesc,
+celix_status_t rsaRpc_createEndpoint(void *handle, const endpoint_description_t *endpointDesc,
         long *endpointId) {
     celix_status_t status= CELIX_SUCCESS;
     if (handle == NULL || endpointDescription_isInvalid(endpointDesc) || endpointId == NULL) {
         return CELIX_ILLEGAL_ARGUMENT;
     }
 
-    rsa_json_rpc_t *jsonRpc = (rsa_json_rpc_t *)handle;
+    rsa_rpc_t *rpc = (rsa_rpc_t *)handle;
 
-    rsa_json_rpc_endpoint_t *endpoint = NULL;
-    status = rsaJsonRpcEndpoint_create(jsonRpc->ctx, jsonRpc->logHelper, jsonRpc->callsLogFile,
-            jsonRpc->interceptorsHandler, endpointDesc, jsonRpc->serialProtoId, &endpoint);
+    rsa_rpc_endpoint_t *endpoint = NULL;
+    status = rsaRpcEndpoint_create(rpc->ctx, rpc->logHelper, rpc->callsLogFile,
+            rpc->interceptorsHandler, endpointDesc, rpc->serialProtoId, rpc->serializer, &endpoint);
     if (status != CELIX_SUCCESS) {
         return status;
     }
-    long epId = rsaJsonRpcEndpoint_getId(endpoint);
+    long epId = rsaRpcEndpoint_getId(endpoint);
 
-    celixThreadMutex_lock(&jsonRpc->mutex);
-    celix_longHashMap_put(jsonRpc->svcEndpoints, epId, endpoint);
-    celixThreadMutex_unlock(&jsonRpc->mutex);
+    celixThreadMutex_lock(&rpc->mutex);
+    celix_longHashMap_put(rpc->svcEndpoints, epId, endpoint);
+    celixThreadMutex_unlock(&rpc->mutex);
     *endpointId = epId;
 
     return CELIX_SUCCESS;
 }
 
-void rsaJsonRpc_destroyEndpoint(void *handle, long endpointId) {
+void rsaRpc_destroyEndpoint(void *handle, long endpointId) {
     if (handle == NULL) {
         return;
     }
-    rsa_json_rpc_t *jsonRpc = (rsa_json_rpc_t *)handle;
-    celixThreadMutex_lock(&jsonRpc->mutex);
-    rsa_json_rpc_endpoint_t *endpoint = celix_longHashMap_get(jsonRpc->svcEndpoints, endpointId);
+    rsa_rpc_t *rpc = (rsa_rpc_t *)handle;
+    celixThreadMutex_lock(&rpc->mutex);
+    rsa_rpc_endpoint_t *endpoint = celix_longHashMap_get(rpc->svcEndpoints, endpointId);
     if (endpoint != NULL) {
-        (void)celix_longHashMap_remove(jsonRpc->svcEndpoints, endpointId);
-        rsaJsonRpcEndpoint_destroy(endpoint);
+        (void)celix_longHashMap_remove(rpc->svcEndpoints, endpointId);
+        rsaRpcEndpoint_destroy(endpoint);
     }
-    celixThreadMutex_unlock(&jsonRpc->mutex);
+    celixThreadMutex_unlock(&rpc->mutex);
     return;
 }
 
-celix_status_t celix_rsaJsonRpc_handleRequest(void *handle, long endpointId, celix_properties_t *metadata, const struct iovec *request, struct iovec *response) {
+celix_status_t rsaRpc_handleRequest(void *handle, long endpointId, celix_properties_t *metadata, const struct iovec *request, struct iovec *response) {
     if (handle == NULL) {
         return CELIX_ILLEGAL_ARGUMENT;
     }
-    rsa_json_rpc_t *jsonRpc = (rsa_json_rpc_t *)handle;
+    rsa_rpc_t *rpc = (rsa_rpc_t *)handle;
     /*The endpoint is not expected to be changed during the handling of a request, so we can release the mutex after getting the endpoint.*/
-    celixThreadMutex_lock(&jsonRpc->mutex);
-    rsa_json_rpc_endpoint_t *endpoint = celix_longHashMap_get(jsonRpc->svcEndpoints, endpointId);
-    celixThreadMutex_unlock(&jsonRpc->mutex);
+    celixThreadMutex_lock(&rpc->mutex);
+    rsa_rpc_endpoint_t *endpoint = celix_longHashMap_get(rpc->svcEndpoints, endpointId);
+    celixThreadMutex_unlock(&rpc->mutex);
     if (endpoint == NULL) {
-        celix_logHelper_error(jsonRpc->logHelper, "No endpoint found for id %ld.", endpointId);
+        celix_logHelper_error(rpc->logHelper, "No endpoint found for id %ld.", endpointId);
         return CELIX_ILLEGAL_STATE;
     }
-    return rsaJsonRpcEndpoint_handleRequest(endpoint, metadata, request, response);
+    return rsaRpcEndpoint_handleRequest(endpoint, metadata, request, response);
 }
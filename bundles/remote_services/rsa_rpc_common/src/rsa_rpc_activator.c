@@ -0,0 +1,82 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "rsa_rpc.h"
+#include "celix_log_helper.h"
+#include "celix_rsa_rpc_factory.h"
+#include "celix_bundle_context.h"
+#include <assert.h>
+
+celix_status_t rsaRpcActivator_start(rsa_rpc_activator_t* activator, celix_bundle_context_t* ctx,
+        const rsa_rpc_serializer_t* serializer) {
+    celix_status_t status = CELIX_SUCCESS;
+    assert(activator != NULL);
+    assert(ctx != NULL);
+    assert(serializer != NULL);
+
+    activator->ctx = ctx;
+    activator->rpcSvcId = -1;
+    celix_autoptr(celix_log_helper_t) logHelper = activator->logHelper = celix_logHelper_create(ctx, serializer->name);
+    if (activator->logHelper == NULL) {
+        return CELIX_BUNDLE_EXCEPTION;
+    }
+
+    status = rsaRpc_create(ctx, activator->logHelper, serializer, &activator->rpc);
+    if (status != CELIX_SUCCESS) {
+        celix_logHelper_error(activator->logHelper, "Error creating rpc. %d.", status);
+        return status;
+    }
+    celix_autoptr(rsa_rpc_t) rpc = activator->rpc;
+    celix_properties_t *props = celix_properties_create();
+    if (props == NULL) {
+        celix_logHelper_error(activator->logHelper, "Error creating properties for rpc.");
+        return CELIX_ENOMEM;
+    }
+    celix_properties_set(props, CELIX_RSA_RPC_TYPE_KEY, serializer->rpcType);
+    activator->rpcFac.handle = activator->rpc;
+    activator->rpcFac.createProxy = rsaRpc_createProxy;
+    activator->rpcFac.destroyProxy = rsaRpc_destroyProxy;
+    activator->rpcFac.createEndpoint = rsaRpc_createEndpoint;
+    activator->rpcFac.destroyEndpoint = rsaRpc_destroyEndpoint;
+    activator->rpcFac.handleRequest = rsaRpc_handleRequest;
+    celix_service_registration_options_t opts = CELIX_EMPTY_SERVICE_REGISTRATION_OPTIONS;
+    opts.serviceName = CELIX_RSA_RPC_FACTORY_NAME;
+    opts.serviceVersion = CELIX_RSA_RPC_FACTORY_VERSION;
+    opts.properties = props;
+    opts.svc = &activator->rpcFac;
+    activator->rpcSvcId = celix_bundleContext_registerServiceWithOptionsAsync(ctx, &opts);
+    if (activator->rpcSvcId < 0) {
+        celix_logHelper_error(activator->logHelper, "Error registering rpc service.");
+        return CELIX_BUNDLE_EXCEPTION;
+    }
+    celix_steal_ptr(rpc);
+    celix_steal_ptr(logHelper);
+    return CELIX_SUCCESS;
+}
+
+celix_status_t rsaRpcActivator_stop(rsa_rpc_activator_t *activator, celix_bundle_context_t* ctx) {
+    assert(activator != NULL);
+    assert(ctx != NULL);
+    celix_bundleContext_unregisterServiceAsync(ctx, activator->rpcSvcId, NULL, NULL);
+    celix_bundleContext_waitForEvents(ctx);//Ensure that no events use rpc
+    rsaRpc_destroy(activator->rpc);
+    celix_bundleContext_waitForEvents(ctx);//Ensure that no events use logHelper
+    celix_logHelper_destroy(activator->logHelper);
+    return CELIX_SUCCESS;
+}
@@ -17,20 +17,19 @@
  * under the License.
  */
 
-#include "rsa_json_rpc_endpoint_impl.h"
+#include "rsa_rpc_endpoint_impl.h"
 #include "remote_interceptors_handler.h"
 #include "endpoint_description.h"
 #include "dfi_utils.h"
-#include "json_rpc.h"
 #include "celix_stdlib_cleanup.h"
+#include "celix_utils.h"
 #include "celix_threads.h"
 #include "celix_constants.h"
 #include <sys/uio.h>
-#include <jansson.h>
 #include <assert.h>
 #include <string.h>
 
-struct rsa_json_rpc_endpoint {
+struct rsa_rpc_endpoint {
     celix_bundle_context_t* ctx;
     celix_log_helper_t *logHelper;
     FILE *callsLogFile;
@@ -41,25 +40,27 @@ struct rsa_json_rpc_endpoint {
     celix_thread_rwlock_t lock; //projects below
     void *service;
     dyn_interface_type *intfType;
+    const rsa_rpc_serializer_t *serializer;
 };
 
-static void rsaJsonRpcEndpoint_stopSvcTrackerDone(void *data);
-static void rsaJsonRpcEndpoint_addSvcWithOwner(void *handle, void *service,
+static void rsaRpcEndpoint_stopSvcTrackerDone(void *data);
+static void rsaRpcEndpoint_addSvcWithOwner(void *handle, void *service,
         const celix_properties_t *props, const celix_bundle_t *svcOwner);
-static void rsaJsonRpcEndpoint_removeSvcWithOwner(void *handle, void *service,
+static void rsaRpcEndpoint_removeSvcWithOwner(void *handle, void *service,
         const celix_properties_t *props, const celix_bundle_t *svcOwner);
 
-celix_status_t rsaJsonRpcEndpoint_create(celix_bundle_context_t* ctx, celix_log_helper_t *logHelper,
+celix_status_t rsaRpcEndpoint_create(celix_bundle_context_t* ctx, celix_log_helper_t *logHelper,
         FILE *logFile, remote_interceptors_handler_t *interceptorsHandler,
         const endpoint_description_t *endpointDesc, unsigned int serialProtoId,
-        rsa_json_rpc_endpoint_t **endpointOut) {
+        const rsa_rpc_serializer_t *serializer, rsa_rpc_endpoint_t **endpointOut) {
     assert(ctx != NULL);
     assert(logHelper != NULL);
     assert(interceptorsHandler != NULL);
     assert(endpointDesc != NULL);
+    assert(serializer != NULL);
     assert(endpointOut != NULL);
     celix_status_t status = CELIX_SUCCESS;
-    celix_autofree rsa_json_rpc_endpoint_t* endpoint = calloc(1, sizeof(*endpoint));
+    celix_autofree rsa_rpc_endpoint_t* endpoint = calloc(1, sizeof(*endpoint));
     if (endpoint == NULL) {
         return CELIX_ENOMEM;
     }
@@ -67,9 +68,10 @@ celix_status_t rsaJsonRpcEndpoint_create(celix_bundle_context_t* ctx, celix_log_
     endpoint->logHelper = logHelper;
     endpoint->callsLogFile = logFile;
     endpoint->serialProtoId = serialProtoId;
+    endpoint->serializer = serializer;
     celix_autoptr(endpoint_description_t) endpointDescCopy = endpoint->endpointDesc = endpointDescription_clone(endpointDesc);
     if (endpoint->endpointDesc == NULL) {
-        celix_logHelper_error(logHelper, "RSA json rpc endpoint: Error cloning endpoint description for %s.",
+        celix_logHelper_error(logHelper, "RSA rpc endpoint: Error cloning endpoint description for %s.",
                 endpointDesc->serviceName);
         return CELIX_ENOMEM;
     }
@@ -79,7 +81,7 @@ celix_status_t rsaJsonRpcEndpoint_create(celix_bundle_context_t* ctx, celix_log_
     endpoint->intfType = NULL;
     status = celixThreadRwlock_create(&endpoint->lock, NULL);
     if (status != CELIX_SUCCESS) {
-        celix_logHelper_error(logHelper, "RSA json rpc endpoint: Error initilizing lock for %s. %d.",
+        celix_logHelper_error(logHelper, "RSA rpc endpoint: Error initilizing lock for %s. %d.",
                 endpointDesc->serviceName, status);
         return status;
     }
@@ -90,11 +92,11 @@ celix_status_t rsaJsonRpcEndpoint_create(celix_bundle_context_t* ctx, celix_log_
     celix_service_tracking_options_t opts = CELIX_EMPTY_SERVICE_TRACKING_OPTIONS;
     opts.filter.filter = filter;
     opts.callbackHandle = endpoint;
-    opts.addWithOwner = rsaJsonRpcEndpoint_addSvcWithOwner;
-    opts.removeWithOwner = rsaJsonRpcEndpoint_removeSvcWithOwner;
+    opts.addWithOwner = rsaRpcEndpoint_addSvcWithOwner;
+    opts.removeWithOwner = rsaRpcEndpoint_removeSvcWithOwner;
     endpoint->svcTrackerId = celix_bundleContext_trackServicesWithOptions(endpoint->ctx, &opts);//sync call, as we need the service is tracked before returning
     if (endpoint->svcTrackerId < 0) {
-        celix_logHelper_error(logHelper, "RSA json rpc endpoint: Error Registering %s tracker.", endpointDesc->serviceName);
+        celix_logHelper_error(logHelper, "RSA rpc endpoint: Error Registering %s tracker.", endpointDesc->serviceName);
         return CELIX_ILLEGAL_STATE;
     }
 
@@ -104,40 +106,40 @@ celix_status_t rsaJsonRpcEndpoint_create(celix_bundle_context_t* ctx, celix_log_
     return CELIX_SUCCESS;
 }
 
-static void rsaJsonRpcEndpoint_stopSvcTrackerDone(void *data) {
+static void rsaRpcEndpoint_stopSvcTrackerDone(void *data) {
     assert(data != NULL);
-    rsa_json_rpc_endpoint_t *endpoint = (rsa_json_rpc_endpoint_t *)data;
+    rsa_rpc_endpoint_t *endpoint = (rsa_rpc_endpoint_t *)data;
     (void)celixThreadRwlock_destroy(&endpoint->lock);
     endpointDescription_destroy(endpoint->endpointDesc);
     free(endpoint);
     return;
 }
 
-void rsaJsonRpcEndpoint_destroy(rsa_json_rpc_endpoint_t *endpoint) {
+void rsaRpcEndpoint_destroy(rsa_rpc_endpoint_t *endpoint) {
     if (endpoint != NULL) {
-        celix_bundleContext_stopTrackerAsync(endpoint->ctx, endpoint->svcTrackerId, endpoint, rsaJsonRpcEndpoint_stopSvcTrackerDone);
+        celix_bundleContext_stopTrackerAsync(endpoint->ctx, endpoint->svcTrackerId, endpoint, rsaRpcEndpoint_stopSvcTrackerDone);
     }
     return;
 }
 
-long rsaJsonRpcEndpoint_getId(rsa_json_rpc_endpoint_t *endpoint) {
+long rsaRpcEndpoint_getId(rsa_rpc_endpoint_t *endpoint) {
     return endpoint->svcTrackerId;
 }
 
-static void rsaJsonRpcEndpoint_addSvcWithOwner(void *handle, void *service,
+static void rsaRpcEndpoint_addSvcWithOwner(void *handle, void *service,
         const celix_properties_t *props, const celix_bundle_t *svcOwner) {
     assert(handle != NULL);
     assert(service != NULL);
     assert(props != NULL);
     assert(svcOwner != NULL);
     celix_status_t status = CELIX_SUCCESS;
-    rsa_json_rpc_endpoint_t *endpoint = (rsa_json_rpc_endpoint_t *)handle;
-    celix_autoptr(dyn_interface_type) intfType = NULL;
+    rsa_rpc_endpoint_t *endpoint = (rsa_rpc_endpoint_t *)handle;
+    celix_autoptr(dfi_cached_interface_type) intfType = NULL;
     const char *serviceName = celix_properties_get(endpoint->endpointDesc->properties, CELIX_FRAMEWORK_SERVICE_NAME, "unknown-service");
 
     celix_auto(celix_rwlock_wlock_guard_t) lock = celixRwlockWlockGuard_init(&endpoint->lock);
 
-    status = dfi_findAndParseInterfaceDescriptor(endpoint->logHelper,endpoint->ctx,
+    status = dfi_acquireInterfaceDescriptor(endpoint->logHelper,endpoint->ctx,
             svcOwner, endpoint->endpointDesc->serviceName, &intfType);
     if (status != CELIX_SUCCESS) {
         celix_logHelper_error(endpoint->logHelper, "Endpoint: Error Parsing service descriptor for %s.", serviceName);
@@ -161,57 +163,58 @@ static void rsaJsonRpcEndpoint_addSvcWithOwner(void *handle, void *service,
     return;
 }
 
-static void rsaJsonRpcEndpoint_removeSvcWithOwner(void *handle, void *service,
+static void rsaRpcEndpoint_removeSvcWithOwner(void *handle, void *service,
         const celix_properties_t *props, const celix_bundle_t *svcOwner) {
     assert(handle != NULL);
     (void)props;
     (void)svcOwner;
-    rsa_json_rpc_endpoint_t *endpoint = (rsa_json_rpc_endpoint_t *)handle;
+    rsa_rpc_endpoint_t *endpoint = (rsa_rpc_endpoint_t *)handle;
     celix_auto(celix_rwlock_wlock_guard_t) lock = celixRwlockWlockGuard_init(&endpoint->lock);
     if (endpoint->service == service) {
         endpoint->service = NULL;
-        dynInterface_destroy(endpoint->intfType);
+        dfi_releaseInterfaceDescriptor(endpoint->intfType);
         endpoint->intfType = NULL;
     }
     return;
 }
 
-celix_status_t rsaJsonRpcEndpoint_handleRequest(rsa_json_rpc_endpoint_t *endpoint, celix_properties_t *metadata,
-        const struct iovec *request, struct iovec *responseOut) {
-    celix_status_t status = CELIX_SUCCESS;
-    if (endpoint == NULL || request == NULL || request->iov_base == NULL
-            || request->iov_len == 0 || responseOut == NULL || metadata == NULL) {
-        return CELIX_ILLEGAL_ARGUMENT;
+static celix_status_t rsaRpcEndpoint_copyMethodId(rsa_rpc_endpoint_t *endpoint, int methodIndex, char **idOut) {
+    celix_auto(celix_rwlock_rlock_guard_t) lock = celixRwlockRlockGuard_init(&endpoint->lock);
+    if (endpoint->intfType == NULL) {
+        celix_logHelper_error(endpoint->logHelper, "%s is null, please try again.", endpoint->endpointDesc->serviceName);
+        return CELIX_ILLEGAL_STATE;
     }
-    responseOut->iov_base = NULL;
-    responseOut->iov_len = 0;
-
-    long serialProtoId  = celix_properties_getAsLong(metadata, "SerialProtocolId", 0);
-    if (serialProtoId != endpoint->serialProtoId) {
-        celix_logHelper_error(endpoint->logHelper, "Serialization protocol ID mismatch. expect:%ld actual:%u.", serialProtoId, endpoint->serialProtoId);
+    const struct method_entry *entry = dynInterface_findMethodByIndex(endpoint->intfType, methodIndex);
+    if (entry == NULL) {
+        celix_logHelper_error(endpoint->logHelper, "Requested method %d of %s not found.", methodIndex,
+                              endpoint->endpointDesc->serviceName);
         return CELIX_ILLEGAL_ARGUMENT;
     }
+    *idOut = celix_utils_strdup(entry->id);
+    return *idOut != NULL ? CELIX_SUCCESS : CELIX_ENOMEM;
+}
 
-    json_error_t error;
-    json_auto_t* jsRequest = json_loads((char *)request->iov_base, 0, &error);
-    if (jsRequest == NULL) {
-        celix_logHelper_error(endpoint->logHelper, "Parse request json string failed for %s.", (char *)request->iov_base);
-        return CELIX_ILLEGAL_ARGUMENT;
-    }
-    const char *sig;
-    int rc = json_unpack(jsRequest, "{s:s}", "m", &sig);
-    if (rc != 0) {
-        celix_logHelper_error(endpoint->logHelper, "Error requesting method for %s.", (char *)request->iov_base);
-        return CELIX_ILLEGAL_ARGUMENT;
+static celix_status_t rsaRpcEndpoint_handleParsedRequest(rsa_rpc_endpoint_t *endpoint, celix_properties_t *metadata,
+        const struct iovec *request, void *parsedRequest, const char *method, int methodIndex, struct iovec *responseOut) {
+    celix_status_t status = CELIX_SUCCESS;
+    const rsa_rpc_serializer_t *serializer = endpoint->serializer;
+    //The id of a method addressed by its index is owned by the interface, so it is copied while holding the lock
+    celix_autofree char *methodId = NULL;
+    if (method == NULL) {
+        status = rsaRpcEndpoint_copyMethodId(endpoint, methodIndex, &methodId);
+        if (status != CELIX_SUCCESS) {
+            return status;
+        }
+        method = methodId;
     }
 
-    char *szResponse = NULL;
+    struct iovec response = {NULL, 0};
     bool cont = remoteInterceptorHandler_invokePreExportCall(endpoint->interceptorsHandler,
-            endpoint->endpointDesc->properties, sig, &metadata);
+            endpoint->endpointDesc->properties, method, &metadata);
     if (cont) {
         celixThreadRwlock_readLock(&endpoint->lock);
         if (endpoint->service != NULL) {
-            int rc1 = jsonRpc_call(endpoint->intfType, endpoint->service, (char *)request->iov_base, &szResponse);
+            int rc1 = serializer->call(endpoint->intfType, endpoint->service, request, parsedRequest, &response);
             status = (rc1 != 0) ? CELIX_SERVICE_EXCEPTION : CELIX_SUCCESS;
             if (rc1 != 0) {
                 celix_logHelper_logTssErrors(endpoint->logHelper, CELIX_LOG_LEVEL_ERROR);
@@ -224,22 +227,64 @@ celix_status_t rsaJsonRpcEndpoint_handleRequest(rsa_json_rpc_endpoint_t *endpoin
         celixThreadRwlock_unlock(&endpoint->lock);
 
         remoteInterceptorHandler_invokePostExportCall(endpoint->interceptorsHandler,
-                endpoint->endpointDesc->properties, sig, metadata);
+                endpoint->endpointDesc->properties, method, metadata);
     } else {
         celix_logHelper_error(endpoint->logHelper, "%s has been intercepted.", endpoint->endpointDesc->serviceName);
         status = CELIX_INTERCEPTOR_EXCEPTION;
     }
 
-    if (szResponse != NULL) {
-        responseOut->iov_base = szResponse;
-        responseOut->iov_len = strlen(szResponse) + 1;// make it include '\0'
+    if (response.iov_base != NULL) {
+        *responseOut = response;
     }
 
     if (endpoint->callsLogFile != NULL) {
-        fprintf(endpoint->callsLogFile, "ENDPOINT REMOTE CALL:\n\tservice=%s\n\tservice_id=%lu\n\trequest_payload=%s\n\trequest_response=%s\n\tstatus=%i\n",
-                endpoint->endpointDesc->serviceName, endpoint->endpointDesc->serviceId, (char *)request->iov_base, szResponse, status);
+        if (serializer->textPayload) {
+            fprintf(endpoint->callsLogFile, "ENDPOINT REMOTE CALL:\n\tservice=%s\n\tservice_id=%lu\n\trequest_payload=%s\n\trequest_response=%s\n\tstatus=%i\n",
+                    endpoint->endpointDesc->serviceName, endpoint->endpointDesc->serviceId, (char *)request->iov_base,
+                    (char *)response.iov_base, status);
+        } else {
+            fprintf(endpoint->callsLogFile, "ENDPOINT REMOTE CALL:\n\tservice=%s\n\tservice_id=%lu\n\tmethod=%s\n\trequest_size=%zu\n\tresponse_size=%zu\n\tstatus=%i\n",
+                    endpoint->endpointDesc->serviceName, endpoint->endpointDesc->serviceId, method, request->iov_len,
+                    response.iov_len, status);
+        }
         fflush(endpoint->callsLogFile);
     }
 
     return status;
-}
\ No newline at end of file
+}
+
+celix_status_t rsaRpcEndpoint_handleRequest(rsa_rpc_endpoint_t *endpoint, celix_properties_t *metadata,
+        const struct iovec *request, struct iovec *responseOut) {
+    if (endpoint == NULL || request == NULL || request->iov_base == NULL
+            || request->iov_len == 0 || responseOut == NULL || metadata == NULL) {
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    responseOut->iov_base = NULL;
+    responseOut->iov_len = 0;
+
+    long serialProtoId  = celix_properties_getAsLong(metadata, "SerialProtocolId", 0);
+    if (serialProtoId != endpoint->serialProtoId) {
+        celix_logHelper_error(endpoint->logHelper, "Serialization protocol ID mismatch. expect:%ld actual:%u.", serialProtoId, endpoint->serialProtoId);
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+
+    const rsa_rpc_serializer_t *serializer = endpoint->serializer;
+    void *parsedRequest = NULL;
+    const char *method = NULL;
+    int methodIndex = -1;
+    if (serializer->parseRequest(request, &parsedRequest, &method, &methodIndex) != 0) {
+        celix_logHelper_logTssErrors(endpoint->logHelper, CELIX_LOG_LEVEL_ERROR);
+        celix_logHelper_error(endpoint->logHelper, "Error requesting method for %s (request size %zu).",
+                              endpoint->endpointDesc->serviceName, request->iov_len);
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+
+    celix_status_t status = rsaRpcEndpoint_handleParsedRequest(endpoint, metadata, request, parsedRequest, method,
+                                                               methodIndex, responseOut);
+
+    if (parsedRequest != NULL && serializer->freeRequest != NULL) {
+        serializer->freeRequest(parsedRequest);
+    }
+
+    return status;
+}
@@ -17,12 +17,13 @@
  * under the License.
  */
 
-#ifndef _RSA_JSON_RPC_ENDPOINT_IMPL_H_
-#define _RSA_JSON_RPC_ENDPOINT_IMPL_H_
+#ifndef _RSA_RPC_ENDPOINT_IMPL_H_
+#define _RSA_RPC_ENDPOINT_IMPL_H_
 
 #ifdef __cplusplus
 extern "C" {
 #endif
+#include "rsa_rpc_serializer.h"
 #include "endpoint_description.h"
 #include "remote_interceptors_handler.h"
 #include "celix_log_helper.h"
@@ -31,22 +32,22 @@ extern "C" {
 #include <stdio.h>
 #include <sys/uio.h>
 
-typedef struct rsa_json_rpc_endpoint rsa_json_rpc_endpoint_t;
+typedef struct rsa_rpc_endpoint rsa_rpc_endpoint_t;
 
-celix_status_t rsaJsonRpcEndpoint_create(celix_bundle_context_t* ctx, celix_log_helper_t *logHelper,
+celix_status_t rsaRpcEndpoint_create(celix_bundle_context_t* ctx, celix_log_helper_t *logHelper,
         FILE *logFile, remote_interceptors_handler_t *interceptorsHandler,
         const endpoint_description_t *endpointDesc, unsigned int serialProtoId,
-        rsa_json_rpc_endpoint_t **endpointOut);
+        const rsa_rpc_serializer_t *serializer, rsa_rpc_endpoint_t **endpointOut);
 
-void rsaJsonRpcEndpoint_destroy(rsa_json_rpc_endpoint_t *endpoint);
+void rsaRpcEndpoint_destroy(rsa_rpc_endpoint_t *endpoint);
 
-long rsaJsonRpcEndpoint_getId(rsa_json_rpc_endpoint_t *endpoint);
+long rsaRpcEndpoint_getId(rsa_rpc_endpoint_t *endpoint);
 
-celix_status_t rsaJsonRpcEndpoint_handleRequest(rsa_json_rpc_endpoint_t *endpoint, celix_properties_t *metadata,
+celix_status_t rsaRpcEndpoint_handleRequest(rsa_rpc_endpoint_t *endpoint, celix_properties_t *metadata,
                                                 const struct iovec *request, struct iovec *responseOut);
 
 #ifdef __cplusplus
 }
 #endif
 
-#endif /* _RSA_JSON_RPC_ENDPOINT_IMPL_H_ */
+#endif /* _RSA_RPC_ENDPOINT_IMPL_H_ */
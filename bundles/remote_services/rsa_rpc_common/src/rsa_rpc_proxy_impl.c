@@ -17,12 +17,11 @@
  * under the License.
  */
 
-#include "rsa_json_rpc_proxy_impl.h"
+#include "rsa_rpc_proxy_impl.h"
 
 #include <assert.h>
 #include <stdbool.h>
 #include <sys/queue.h>
-#include <string.h>
 
 #include "celix_build_assert.h"
 #include "celix_constants.h"
@@ -33,10 +32,9 @@
 #include "celix_version.h"
 #include "dfi_utils.h"
 #include "endpoint_description.h"
-#include "json_rpc.h"
 #include "celix_threads.h"
 
-struct rsa_json_rpc_proxy_factory {
+struct rsa_rpc_proxy_factory {
     celix_bundle_context_t* ctx;
     celix_log_helper_t *logHelper;
     FILE *callsLogFile;
@@ -44,46 +42,51 @@ struct rsa_json_rpc_proxy_factory {
     celix_service_factory_t factory;
     long factorySvcId;
     endpoint_description_t *endpointDesc;
-    celix_long_hash_map_t *proxies;//Key:requestingBundle, Value: rsa_json_rpc_proxy_t *. Work on the celix_event thread , so locks are not required
+    celix_long_hash_map_t *proxies;//Key:requestingBundle, Value: rsa_rpc_proxy_t *. Work on the celix_event thread , so locks are not required
     remote_interceptors_handler_t *interceptorsHandler;
     celix_thread_rwlock_t sendRequestLock; //protects sendRequest
     celix_rsa_send_request_fp sendRequest;
     void* sendRequestHandle;
+    const rsa_rpc_serializer_t *serializer;
 };
 
-typedef struct rsa_json_rpc_proxy {
-    rsa_json_rpc_proxy_factory_t *proxyFactory;
+typedef struct rsa_rpc_proxy {
+    dyn_stub_proxy_handle_t stubHandle;//must be the first member, see dyn_stubs.h
+    rsa_rpc_proxy_factory_t *proxyFactory;
     dyn_interface_type *intfType;
     void *service;
     unsigned int useCnt;
-}rsa_json_rpc_proxy_t;
+    bool useMethodIndex;
+}rsa_rpc_proxy_t;
 
-static void* rsaJsonRpcProxy_getService(void *handle, const celix_bundle_t *requestingBundle,
+static void* rsaRpcProxy_getService(void *handle, const celix_bundle_t *requestingBundle,
         const celix_properties_t *svcProperties);
-static void rsaJsonRpcProxy_ungetService(void *handle, const celix_bundle_t *requestingBundle,
+static void rsaRpcProxy_ungetService(void *handle, const celix_bundle_t *requestingBundle,
         const celix_properties_t *svcProperties);
-static celix_status_t rsaJsonRpcProxy_create(rsa_json_rpc_proxy_factory_t *proxyFactory,
-        const celix_bundle_t *requestingBundle, rsa_json_rpc_proxy_t **proxyOut);
-static void rsaJsonRpcProxy_destroy(rsa_json_rpc_proxy_t *proxy);
-static void rsaJsonRpcProxy_unregisterFacSvcDone(void *data);
-
-celix_status_t rsaJsonRpcProxy_factoryCreate(celix_bundle_context_t* ctx,
-                                             celix_log_helper_t* logHelper,
-                                             FILE* logFile,
-                                             remote_interceptors_handler_t* interceptorsHandler,
-                                             const endpoint_description_t* endpointDesc,
-                                             celix_rsa_send_request_fp sendRequest,
-                                             void* sendRequestHandle,
-                                             unsigned int serialProtoId,
-                                             rsa_json_rpc_proxy_factory_t** proxyFactoryOut) {
+static celix_status_t rsaRpcProxy_create(rsa_rpc_proxy_factory_t *proxyFactory,
+        const celix_bundle_t *requestingBundle, rsa_rpc_proxy_t **proxyOut);
+static void rsaRpcProxy_destroy(rsa_rpc_proxy_t *proxy);
+static void rsaRpcProxy_unregisterFacSvcDone(void *data);
+
+celix_status_t rsaRpcProxy_factoryCreate(celix_bundle_context_t* ctx,
+                                         celix_log_helper_t* logHelper,
+                                         FILE* logFile,
+                                         remote_interceptors_handler_t* interceptorsHandler,
+                                         const endpoint_description_t* endpointDesc,
+                                         celix_rsa_send_request_fp sendRequest,
+                                         void* sendRequestHandle,
+                                         unsigned int serialProtoId,
+                                         const rsa_rpc_serializer_t* serializer,
+                                         rsa_rpc_proxy_factory_t** proxyFactoryOut) {
     assert(ctx != NULL);
     assert(logHelper != NULL);
     assert(interceptorsHandler != NULL);
     assert(endpointDesc != NULL);
     assert(sendRequest != NULL);
+    assert(serializer != NULL);
     assert(proxyFactoryOut != NULL);
-    celix_autofree rsa_json_rpc_proxy_factory_t* proxyFactory =
-        (rsa_json_rpc_proxy_factory_t*)calloc(1, sizeof(*proxyFactory));
+    celix_autofree rsa_rpc_proxy_factory_t* proxyFactory =
+        (rsa_rpc_proxy_factory_t*)calloc(1, sizeof(*proxyFactory));
     if (proxyFactory == NULL) {
         return CELIX_ENOMEM;
     }
@@ -94,6 +97,7 @@ celix_status_t rsaJsonRpcProxy_factoryCreate(celix_bundle_context_t* ctx,
     proxyFactory->sendRequest = sendRequest;
     proxyFactory->sendRequestHandle = sendRequestHandle;
     proxyFactory->serialProtoId = serialProtoId;
+    proxyFactory->serializer = serializer;
 
 
     celix_status_t status = celixThreadRwlock_create(&proxyFactory->sendRequestLock, NULL);
@@ -118,8 +122,8 @@ celix_status_t rsaJsonRpcProxy_factoryCreate(celix_bundle_context_t* ctx,
     }
 
     proxyFactory->factory.handle = proxyFactory;
-    proxyFactory->factory.getService = rsaJsonRpcProxy_getService;
-    proxyFactory->factory.ungetService = rsaJsonRpcProxy_ungetService;
+    proxyFactory->factory.getService = rsaRpcProxy_getService;
+    proxyFactory->factory.ungetService = rsaRpcProxy_ungetService;
     celix_properties_t* svcProperties = NULL;
     status = celix_rsaUtils_createServicePropertiesFromEndpointProperties(endpointDesc->properties, &svcProperties);
     if (status != CELIX_SUCCESS) {
@@ -140,23 +144,23 @@ celix_status_t rsaJsonRpcProxy_factoryCreate(celix_bundle_context_t* ctx,
     return CELIX_SUCCESS;
 }
 
-void rsaJsonRpcProxy_factoryDestroy(rsa_json_rpc_proxy_factory_t *proxyFactory) {
+void rsaRpcProxy_factoryDestroy(rsa_rpc_proxy_factory_t *proxyFactory) {
     assert(proxyFactory != NULL);
     {
         celix_auto(celix_rwlock_wlock_guard_t) wLockGuard = celixRwlockWlockGuard_init(&proxyFactory->sendRequestLock);
         proxyFactory->sendRequest = NULL;
     }
     celix_bundleContext_unregisterServiceAsync(proxyFactory->ctx, proxyFactory->factorySvcId,
-            proxyFactory, rsaJsonRpcProxy_unregisterFacSvcDone);
+            proxyFactory, rsaRpcProxy_unregisterFacSvcDone);
 }
 
-long rsaJsonRpcProxy_factorySvcId(rsa_json_rpc_proxy_factory_t *proxyFactory) {
+long rsaRpcProxy_factorySvcId(rsa_rpc_proxy_factory_t *proxyFactory) {
     return proxyFactory->factorySvcId;
 }
 
-static void rsaJsonRpcProxy_unregisterFacSvcDone(void *data) {
+static void rsaRpcProxy_unregisterFacSvcDone(void *data) {
     assert(data);
-    rsa_json_rpc_proxy_factory_t *proxyFactory = (rsa_json_rpc_proxy_factory_t *)data;
+    rsa_rpc_proxy_factory_t *proxyFactory = (rsa_rpc_proxy_factory_t *)data;
     endpointDescription_destroy(proxyFactory->endpointDesc);
     assert(celix_longHashMap_size(proxyFactory->proxies) == 0);
     celix_longHashMap_destroy(proxyFactory->proxies);
@@ -165,17 +169,17 @@ static void rsaJsonRpcProxy_unregisterFacSvcDone(void *data) {
     return;
 }
 
-static void* rsaJsonRpcProxy_getService(void *handle, const celix_bundle_t *requestingBundle,
+static void* rsaRpcProxy_getService(void *handle, const celix_bundle_t *requestingBundle,
         const celix_properties_t *svcProperties) {
     assert(handle != NULL);
     assert(requestingBundle != NULL);
     assert(svcProperties != NULL);
     celix_status_t status = CELIX_SUCCESS;
-    rsa_json_rpc_proxy_factory_t *proxyFactory = (rsa_json_rpc_proxy_factory_t *)handle;
+    rsa_rpc_proxy_factory_t *proxyFactory = (rsa_rpc_proxy_factory_t *)handle;
 
-    rsa_json_rpc_proxy_t *proxy = celix_longHashMap_get(proxyFactory->proxies, (long)requestingBundle);
+    rsa_rpc_proxy_t *proxy = celix_longHashMap_get(proxyFactory->proxies, (long)requestingBundle);
     if (proxy == NULL) {
-        status = rsaJsonRpcProxy_create(proxyFactory, requestingBundle, &proxy);
+        status = rsaRpcProxy_create(proxyFactory, requestingBundle, &proxy);
         if (status != CELIX_SUCCESS) {
             celix_logHelper_error(proxyFactory->logHelper,"Error Creating service proxy for %s. %d",
                     proxyFactory->endpointDesc->serviceName, status);
@@ -188,24 +192,24 @@ static void* rsaJsonRpcProxy_getService(void *handle, const celix_bundle_t *requ
     return proxy->service;
 }
 
-static void rsaJsonRpcProxy_ungetService(void *handle, const celix_bundle_t *requestingBundle,
+static void rsaRpcProxy_ungetService(void *handle, const celix_bundle_t *requestingBundle,
         const celix_properties_t *svcProperties) {
     assert(handle != NULL);
     assert(requestingBundle != NULL);
     assert(svcProperties != NULL);
-    rsa_json_rpc_proxy_factory_t *proxyFactory = (rsa_json_rpc_proxy_factory_t *)handle;
-    rsa_json_rpc_proxy_t *proxy = celix_longHashMap_get(proxyFactory->proxies, (long)requestingBundle);
+    rsa_rpc_proxy_factory_t *proxyFactory = (rsa_rpc_proxy_factory_t *)handle;
+    rsa_rpc_proxy_t *proxy = celix_longHashMap_get(proxyFactory->proxies, (long)requestingBundle);
     if (proxy != NULL) {
         proxy->useCnt -= 1;
         if (proxy->useCnt == 0) {
             (void)celix_longHashMap_remove(proxyFactory->proxies, (long)requestingBundle);
-            rsaJsonRpcProxy_destroy(proxy);
+            rsaRpcProxy_destroy(proxy);
         }
     }
     return;
 }
 
-static void rsaJsonRpcProxy_serviceFunc(void *userData, void *args[], void *returnVal) {
+static void rsaRpcProxy_serviceFunc(void *userData, void *args[], void *returnVal) {
     celix_status_t  status = CELIX_SUCCESS;
     if (returnVal == NULL) {
         return;
@@ -216,12 +220,15 @@ static void rsaJsonRpcProxy_serviceFunc(void *userData, void *args[], void *retu
     }
     assert(userData != NULL);
     struct method_entry *entry = userData;
-    rsa_json_rpc_proxy_t *proxy = *((void **)args[0]);
-    rsa_json_rpc_proxy_factory_t *proxyFactory = proxy->proxyFactory;
+    rsa_rpc_proxy_t *proxy = *((void **)args[0]);
+    rsa_rpc_proxy_factory_t *proxyFactory = proxy->proxyFactory;
     assert(proxyFactory != NULL);
 
-    char *invokeRequest = NULL;
-    int rc = jsonRpc_prepareInvokeRequest(entry->dynFunc, entry->id, args, &invokeRequest);
+    const rsa_rpc_serializer_t *serializer = proxyFactory->serializer;
+    void *invokeRequest = NULL;
+    size_t invokeRequestSize = 0;
+    int rc = serializer->prepareInvokeRequest(entry->dynFunc, entry->id, proxy->useMethodIndex ? entry->index : -1,
+                                              args, &invokeRequest, &invokeRequestSize);
     if (rc != 0) {
         celix_logHelper_logTssErrors(proxyFactory->logHelper, CELIX_LOG_LEVEL_ERROR);
         celix_logHelper_error(proxyFactory->logHelper, "Error preparing invoke request for %s",
@@ -243,7 +250,7 @@ static void rsaJsonRpcProxy_serviceFunc(void *userData, void *args[], void *retu
     bool cont = remoteInterceptorHandler_invokePreProxyCall(proxyFactory->interceptorsHandler,
             proxyFactory->endpointDesc->properties, dynFunction_getName(entry->dynFunc), &metadata);
     if (cont) {
-        struct iovec requestIovec = {invokeRequest,strlen(invokeRequest) + 1};
+        struct iovec requestIovec = {invokeRequest, invokeRequestSize};
         celixThreadRwlock_readLock(&proxyFactory->sendRequestLock);
         if (proxyFactory->sendRequest != NULL) {
             status = proxyFactory->sendRequest(proxyFactory->sendRequestHandle, proxyFactory->endpointDesc,
@@ -256,8 +263,8 @@ static void rsaJsonRpcProxy_serviceFunc(void *userData, void *args[], void *retu
         if (status == CELIX_SUCCESS && dynFunction_hasReturn(entry->dynFunc)) {
             if (replyIovec.iov_base != NULL) {
                 int rsErrno = CELIX_SUCCESS;
-                int retVal = jsonRpc_handleReply(entry->dynFunc,
-                        (const char *)replyIovec.iov_base , args, &rsErrno);
+                int retVal = serializer->handleReply(entry->dynFunc, replyIovec.iov_base, replyIovec.iov_len,
+                                                     args, &rsErrno);
                 if(retVal != 0) {
                     status = CELIX_SERVICE_EXCEPTION;
                     celix_logHelper_logTssErrors(proxyFactory->logHelper, CELIX_LOG_LEVEL_ERROR);
@@ -287,34 +294,45 @@ static void rsaJsonRpcProxy_serviceFunc(void *userData, void *args[], void *retu
     }
 
     if (proxyFactory->callsLogFile != NULL) {
-        fprintf(proxyFactory->callsLogFile, "PROXY REMOTE CALL:\n\tservice=%s\n\tservice_id=%lu\n\trequest_payload=%s\n\trequest_response=%s\n\tstatus=%i\n",
-                proxyFactory->endpointDesc->serviceName, proxyFactory->endpointDesc->serviceId, invokeRequest, (char *)replyIovec.iov_base, status);
+        if (serializer->textPayload) {
+            fprintf(proxyFactory->callsLogFile, "PROXY REMOTE CALL:\n\tservice=%s\n\tservice_id=%lu\n\trequest_payload=%s\n\trequest_response=%s\n\tstatus=%i\n",
+                    proxyFactory->endpointDesc->serviceName, proxyFactory->endpointDesc->serviceId,
+                    (char *)invokeRequest, (char *)replyIovec.iov_base, status);
+        } else {
+            fprintf(proxyFactory->callsLogFile, "PROXY REMOTE CALL:\n\tservice=%s\n\tservice_id=%lu\n\tmethod=%s\n\trequest_size=%zu\n\tresponse_size=%zu\n\tstatus=%i\n",
+                    proxyFactory->endpointDesc->serviceName, proxyFactory->endpointDesc->serviceId, entry->id,
+                    invokeRequestSize, replyIovec.iov_len, status);
+        }
         fflush(proxyFactory->callsLogFile);
     }
 
-
-    free(invokeRequest); //Allocated by json_dumps in jsonRpc_prepareInvokeRequest
-    if (replyIovec.iov_base) {
-        free(replyIovec.iov_base); //Allocated by json_dumps
-    }
+    free(invokeRequest);
+    free(replyIovec.iov_base);
 
     *(celix_status_t *) returnVal = status;
 
     return;
 }
 
-static celix_status_t rsaJsonRpcProxy_create(rsa_json_rpc_proxy_factory_t *proxyFactory,
-        const celix_bundle_t *requestingBundle, rsa_json_rpc_proxy_t **proxyOut) {
+static void rsaRpcProxy_invokeStub(dyn_stub_proxy_handle_t *handle, int methodIndex, void *args[], void *returnVal) {
+    rsa_rpc_proxy_t *proxy = (rsa_rpc_proxy_t *)handle;
+    const struct method_entry *entry = dynInterface_findMethodByIndex(proxy->intfType, methodIndex);
+    rsaRpcProxy_serviceFunc((void *)entry, args, returnVal);
+}
+
+static celix_status_t rsaRpcProxy_create(rsa_rpc_proxy_factory_t *proxyFactory,
+        const celix_bundle_t *requestingBundle, rsa_rpc_proxy_t **proxyOut) {
     celix_status_t status = CELIX_SUCCESS;
-    celix_autofree rsa_json_rpc_proxy_t *proxy = calloc(1, sizeof(*proxy));
+    celix_autofree rsa_rpc_proxy_t *proxy = calloc(1, sizeof(*proxy));
     if (proxy == NULL) {
         return CELIX_ENOMEM;
     }
     proxy->proxyFactory = proxyFactory;
     proxy->useCnt = 0;
+    proxy->stubHandle.invoke = rsaRpcProxy_invokeStub;
 
-    celix_autoptr(dyn_interface_type) intfType = NULL;
-    status = dfi_findAndParseInterfaceDescriptor(proxyFactory->logHelper,
+    celix_autoptr(dfi_cached_interface_type) intfType = NULL;
+    status = dfi_acquireInterfaceDescriptor(proxyFactory->logHelper,
             proxyFactory->ctx, requestingBundle, proxyFactory->endpointDesc->serviceName, &intfType);
     if (status != CELIX_SUCCESS) {
         return status;
@@ -334,14 +352,19 @@ static celix_status_t rsaJsonRpcProxy_create(rsa_json_rpc_proxy_factory_t *proxy
         return status;
     }
     const celix_version_t *consumerVersion = dynInterface_getVersion(intfType);
-    bool isCompatible = false;
-    isCompatible = celix_version_isCompatible(consumerVersion, providerVersion);
+    bool sameVersion = celix_version_compareTo(consumerVersion, providerVersion) == 0;
+    bool isCompatible = proxyFactory->serializer->sameVersionRequired ? sameVersion :
+            celix_version_isCompatible(consumerVersion, providerVersion);
     if(!isCompatible){
         celix_logHelper_error(proxyFactory->logHelper, "Proxy: Service version mismatch, consumer has %d.%d.%d, provider has %s.",
                               celix_version_getMajor(consumerVersion), celix_version_getMinor(consumerVersion),
                               celix_version_getMicro(consumerVersion) , providerVerStr);
         return CELIX_SERVICE_EXCEPTION;
     }
+    //The method index can only be used if the provider uses the same interface descriptor
+    const char *methodIndexKey = proxyFactory->serializer->methodIndexKey;
+    proxy->useMethodIndex = sameVersion &&
+            (methodIndexKey == NULL || celix_properties_getAsBool(proxyFactory->endpointDesc->properties, methodIndexKey, false));
 
     size_t intfMethodNb = dynInterface_nrOfMethods(intfType);
     proxy->service = calloc(1 + intfMethodNb, sizeof(void *));//The interface includes 'void *handle' and its methods
@@ -356,8 +379,10 @@ static celix_status_t rsaJsonRpcProxy_create(rsa_json_rpc_proxy_factory_t *proxy
     void (*fn)(void) = NULL;
     int index = 0;
     TAILQ_FOREACH(entry, list, entries) {
-        int rc = dynFunction_createClosure(entry->dynFunc, rsaJsonRpcProxy_serviceFunc, entry, &fn);
-        if (rc != 0) {
+        //generated proxy stubs bypass libffi, otherwise the closures are shared by all proxies of the cached interface
+        status = dynFunction_getProxyStub(entry->dynFunc, &fn) == 0 ? CELIX_SUCCESS :
+                dfi_getMethodClosure(entry, rsaRpcProxy_serviceFunc, &fn);
+        if (status != CELIX_SUCCESS) {
             celix_logHelper_error(proxyFactory->logHelper, "Proxy: Failed to create closure for service function %s.",
                                   dynFunction_getName(entry->dynFunc));
             return CELIX_SERVICE_EXCEPTION;
@@ -372,9 +397,9 @@ static celix_status_t rsaJsonRpcProxy_create(rsa_json_rpc_proxy_factory_t *proxy
     return CELIX_SUCCESS;
 }
 
-static void rsaJsonRpcProxy_destroy(rsa_json_rpc_proxy_t *proxy) {
+static void rsaRpcProxy_destroy(rsa_rpc_proxy_t *proxy) {
     free(proxy->service);
-    dynInterface_destroy(proxy->intfType);
+    dfi_releaseInterfaceDescriptor(proxy->intfType);
     free(proxy);
     return;
 }
@@ -17,12 +17,13 @@
  * under the License.
  */
 
-#ifndef _RSA_JSON_RPC_PROXY_IMPL_H_
-#define _RSA_JSON_RPC_PROXY_IMPL_H_
+#ifndef _RSA_RPC_PROXY_IMPL_H_
+#define _RSA_RPC_PROXY_IMPL_H_
 
 #ifdef __cplusplus
 extern "C" {
 #endif
+#include "rsa_rpc_serializer.h"
 #include "remote_interceptors_handler.h"
 #include "celix_rsa_rpc_factory.h"
 #include "endpoint_description.h"
@@ -31,20 +32,21 @@ extern "C" {
 #include "celix_errno.h"
 #include <stdio.h>
 
-typedef struct rsa_json_rpc_proxy_factory rsa_json_rpc_proxy_factory_t;
+typedef struct rsa_rpc_proxy_factory rsa_rpc_proxy_factory_t;
 
-celix_status_t rsaJsonRpcProxy_factoryCreate(celix_bundle_context_t* ctx, celix_log_helper_t* logHelper,
-                                             FILE* logFile, remote_interceptors_handler_t* interceptorsHandler,
-                                             const endpoint_description_t* endpointDesc,
-                                             celix_rsa_send_request_fp sendRequest, void* sendRequestHandle,
-                                             unsigned int serialProtoId, rsa_json_rpc_proxy_factory_t** proxyFactoryOut);
+celix_status_t rsaRpcProxy_factoryCreate(celix_bundle_context_t* ctx, celix_log_helper_t* logHelper,
+                                         FILE* logFile, remote_interceptors_handler_t* interceptorsHandler,
+                                         const endpoint_description_t* endpointDesc,
+                                         celix_rsa_send_request_fp sendRequest, void* sendRequestHandle,
+                                         unsigned int serialProtoId, const rsa_rpc_serializer_t* serializer,
+                                         rsa_rpc_proxy_factory_t** proxyFactoryOut);
 
-void rsaJsonRpcProxy_factoryDestroy(rsa_json_rpc_proxy_factory_t *proxyFactory);
+void rsaRpcProxy_factoryDestroy(rsa_rpc_proxy_factory_t *proxyFactory);
 
-long rsaJsonRpcProxy_factorySvcId(rsa_json_rpc_proxy_factory_t *proxyFactory);
+long rsaRpcProxy_factorySvcId(rsa_rpc_proxy_factory_t *proxyFactory);
 
 #ifdef __cplusplus
 }
 #endif
 
-#endif /* _RSA_JSON_RPC_PROXY_IMPL_H_ */
+#endif /* _RSA_RPC_PROXY_IMPL_H_ */
@@ -16,7 +16,7 @@
  * specific language governing permissions and limitations
  * under the License.
  */
-#include "rsa_json_rpc_impl.h"
+#include "rsa_rpc.h"
 #include "rsa_json_rpc_constants.h"
 #include "celix_bundle_activator.h"
 #include "celix_properties.h"
@@ -61,7 +61,7 @@ public:
 };
 
 TEST_F(RsaJsonRpcActivatorUnitTestSuite, Create) {
-    celix_ei_expect_celix_bundle_getManifestValue((void*)&rsaJsonRpc_create, 1, "1.0.0");
+    celix_ei_expect_celix_bundle_getManifestValue((void*)&rsaRpc_create, 1, "1.0.0");
     void *userData = nullptr;
     auto status = celix_bundleActivator_create(ctx.get(), &userData);
     EXPECT_EQ(CELIX_SUCCESS, status);
@@ -74,7 +74,7 @@ TEST_F(RsaJsonRpcActivatorUnitTestSuite, Create) {
 }
 
 TEST_F(RsaJsonRpcActivatorUnitTestSuite, FailedToCreateLogHelper) {
-    celix_ei_expect_celix_bundle_getManifestValue((void*)&rsaJsonRpc_create, 1, "1.0.0");
+    celix_ei_expect_celix_bundle_getManifestValue((void*)&rsaRpc_create, 1, "1.0.0");
     void *userData = nullptr;
     auto status = celix_bundleActivator_create(ctx.get(), &userData);
     EXPECT_EQ(CELIX_SUCCESS, status);
@@ -87,11 +87,11 @@ TEST_F(RsaJsonRpcActivatorUnitTestSuite, FailedToCreateLogHelper) {
 }
 
 TEST_F(RsaJsonRpcActivatorUnitTestSuite, FailedToCreateRsaJsonRpc) {
-    celix_ei_expect_celix_bundle_getManifestValue((void*)&rsaJsonRpc_create, 1, "1.0.0");
+    celix_ei_expect_celix_bundle_getManifestValue((void*)&rsaRpc_create, 1, "1.0.0");
     void *userData = nullptr;
     auto status = celix_bundleActivator_create(ctx.get(), &userData);
     EXPECT_EQ(CELIX_SUCCESS, status);
-    celix_ei_expect_calloc((void*)&rsaJsonRpc_create, 0, nullptr);
+    celix_ei_expect_calloc((void*)&rsaRpc_create, 0, nullptr);
     status = celix_bundleActivator_start(userData, ctx.get());
     EXPECT_EQ(CELIX_ENOMEM, status);
 
@@ -100,7 +100,7 @@ TEST_F(RsaJsonRpcActivatorUnitTestSuite, FailedToCreateRsaJsonRpc) {
 }
 
 TEST_F(RsaJsonRpcActivatorUnitTestSuite, FailedToCreateRpcFactoryServiceProperties) {
-    celix_ei_expect_celix_bundle_getManifestValue((void*)&rsaJsonRpc_create, 1, "1.0.0");
+    celix_ei_expect_celix_bundle_getManifestValue((void*)&rsaRpc_create, 1, "1.0.0");
     void *userData = nullptr;
     auto status = celix_bundleActivator_create(ctx.get(), &userData);
     EXPECT_EQ(CELIX_SUCCESS, status);
@@ -113,7 +113,7 @@ TEST_F(RsaJsonRpcActivatorUnitTestSuite, FailedToCreateRpcFactoryServiceProperti
 }
 
 TEST_F(RsaJsonRpcActivatorUnitTestSuite, FailedToRegisterRpcFactoryService) {
-    celix_ei_expect_celix_bundle_getManifestValue((void*)&rsaJsonRpc_create, 1, "1.0.0");
+    celix_ei_expect_celix_bundle_getManifestValue((void*)&rsaRpc_create, 1, "1.0.0");
     void *userData = nullptr;
     auto status = celix_bundleActivator_create(ctx.get(), &userData);
     EXPECT_EQ(CELIX_SUCCESS, status);
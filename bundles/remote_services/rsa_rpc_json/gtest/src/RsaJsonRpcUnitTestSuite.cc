@@ -17,10 +17,11 @@
  * under the License.
  */
 
-#include "rsa_json_rpc_impl.h"
+#include "rsa_rpc.h"
+#include "rsa_rpc_proxy_impl.h"
+#include "rsa_rpc_endpoint_impl.h"
+#include "rsa_json_rpc_serializer.h"
 #include "rsa_json_rpc_constants.h"
-#include "rsa_json_rpc_proxy_impl.h"
-#include "rsa_json_rpc_endpoint_impl.h"
 #include "RsaJsonRpcTestService.h"
 #include "remote_interceptor.h"
 #include "endpoint_description.h"
@@ -113,210 +114,213 @@ public:
 };
 
 TEST_F(RsaJsonRpcUnitTestSuite, CreateRsaJsonRpc) {
-    rsa_json_rpc_t *jsonRpc = nullptr;
-    auto status  = rsaJsonRpc_create(ctx.get(), logHelper.get(), &jsonRpc);
+    rsa_rpc_t *jsonRpc = nullptr;
+    auto status  = rsaRpc_create(ctx.get(), logHelper.get(), &rsaJsonRpc_serializer, &jsonRpc);
     EXPECT_EQ(CELIX_SUCCESS, status);
     EXPECT_NE(nullptr, jsonRpc);
 
-    rsaJsonRpc_destroy(jsonRpc);
+    rsaRpc_destroy(jsonRpc);
 }
 
 TEST_F(RsaJsonRpcUnitTestSuite, CreateRsaJsonRpcWithInvalidParams) {
-    rsa_json_rpc_t *jsonRpc = nullptr;
+    rsa_rpc_t *jsonRpc = nullptr;
 
-    auto status  = rsaJsonRpc_create(nullptr, logHelper.get(), &jsonRpc);
+    auto status  = rsaRpc_create(nullptr, logHelper.get(), &rsaJsonRpc_serializer, &jsonRpc);
     EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, status);
 
-    status  = rsaJsonRpc_create(ctx.get(), nullptr, &jsonRpc);
+    status  = rsaRpc_create(ctx.get(), nullptr, &rsaJsonRpc_serializer, &jsonRpc);
     EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, status);
 
-    status  = rsaJsonRpc_create(ctx.get(), logHelper.get(), nullptr);
+    status  = rsaRpc_create(ctx.get(), logHelper.get(), nullptr, &jsonRpc);
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, status);
+
+    status  = rsaRpc_create(ctx.get(), logHelper.get(), &rsaJsonRpc_serializer, nullptr);
     EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, status);
 }
 
 TEST_F(RsaJsonRpcUnitTestSuite, CreateRsaJsonRpcWithENOMEM) {
-    rsa_json_rpc_t *jsonRpc = nullptr;
-    celix_ei_expect_calloc((void*)&rsaJsonRpc_create, 0, nullptr);
-    auto status  = rsaJsonRpc_create(ctx.get(), logHelper.get(), &jsonRpc);
+    rsa_rpc_t *jsonRpc = nullptr;
+    celix_ei_expect_calloc((void*)&rsaRpc_create, 0, nullptr);
+    auto status  = rsaRpc_create(ctx.get(), logHelper.get(), &rsaJsonRpc_serializer, &jsonRpc);
     EXPECT_EQ(CELIX_ENOMEM, status);
 }
 
 TEST_F(RsaJsonRpcUnitTestSuite, CreateRsaJsonRpcWithInvalidVersion) {
-    rsa_json_rpc_t *jsonRpc = nullptr;
+    rsa_rpc_t *jsonRpc = nullptr;
 
-    celix_ei_expect_celix_bundle_getVersion((void*)&rsaJsonRpc_create, 1, nullptr);
-    auto status  = rsaJsonRpc_create(ctx.get(), logHelper.get(), &jsonRpc);
+    celix_ei_expect_celix_bundle_getVersion((void*)&rsaRpc_create, 1, nullptr);
+    auto status  = rsaRpc_create(ctx.get(), logHelper.get(), &rsaJsonRpc_serializer, &jsonRpc);
     EXPECT_EQ(CELIX_BUNDLE_EXCEPTION, status);
 }
 
 TEST_F(RsaJsonRpcUnitTestSuite, CreateRsaJsonRpcWithInvalidBundleSymbolicName) {
-    rsa_json_rpc_t *jsonRpc = nullptr;
+    rsa_rpc_t *jsonRpc = nullptr;
     celix_autoptr(celix_version_t) version = celix_version_createVersionFromString("1.0.0");
-    celix_ei_expect_celix_bundle_getVersion((void*)&rsaJsonRpc_create, 1, version);
+    celix_ei_expect_celix_bundle_getVersion((void*)&rsaRpc_create, 1, version);
 
-    celix_ei_expect_celix_bundle_getSymbolicName((void*)&rsaJsonRpc_create, 1, nullptr);
-    auto status  = rsaJsonRpc_create(ctx.get(), logHelper.get(), &jsonRpc);
+    celix_ei_expect_celix_bundle_getSymbolicName((void*)&rsaRpc_create, 1, nullptr);
+    auto status  = rsaRpc_create(ctx.get(), logHelper.get(), &rsaJsonRpc_serializer, &jsonRpc);
     EXPECT_EQ(CELIX_BUNDLE_EXCEPTION, status);
 }
 
 TEST_F(RsaJsonRpcUnitTestSuite, FailedToCreateThreadMutex) {
-    rsa_json_rpc_t *jsonRpc = nullptr;
+    rsa_rpc_t *jsonRpc = nullptr;
     celix_autoptr(celix_version_t) version = celix_version_createVersionFromString("1.0.0");
-    celix_ei_expect_celix_bundle_getVersion((void*)&rsaJsonRpc_create, 1, version);
+    celix_ei_expect_celix_bundle_getVersion((void*)&rsaRpc_create, 1, version);
 
-    celix_ei_expect_celixThreadMutex_create((void*)&rsaJsonRpc_create, 0, CELIX_ENOMEM);
-    auto status  = rsaJsonRpc_create(ctx.get(), logHelper.get(), &jsonRpc);
+    celix_ei_expect_celixThreadMutex_create((void*)&rsaRpc_create, 0, CELIX_ENOMEM);
+    auto status  = rsaRpc_create(ctx.get(), logHelper.get(), &rsaJsonRpc_serializer, &jsonRpc);
     EXPECT_EQ(CELIX_ENOMEM, status);
 }
 
 TEST_F(RsaJsonRpcUnitTestSuite, FailedToCreateRemoteInterceptorsHandler) {
-    rsa_json_rpc_t *jsonRpc = nullptr;
+    rsa_rpc_t *jsonRpc = nullptr;
     celix_ei_expect_calloc((void*)&remoteInterceptorsHandler_create, 0, nullptr);
-    auto status  = rsaJsonRpc_create(ctx.get(), logHelper.get(), &jsonRpc);
+    auto status  = rsaRpc_create(ctx.get(), logHelper.get(), &rsaJsonRpc_serializer, &jsonRpc);
     EXPECT_EQ(CELIX_ENOMEM, status);
 }
 
 TEST_F(RsaJsonRpcUnitTestSuite, CreateRpcProxy) {
-    rsa_json_rpc_t *jsonRpc = nullptr;
-    auto status  = rsaJsonRpc_create(ctx.get(), logHelper.get(), &jsonRpc);
+    rsa_rpc_t *jsonRpc = nullptr;
+    auto status  = rsaRpc_create(ctx.get(), logHelper.get(), &rsaJsonRpc_serializer, &jsonRpc);
     EXPECT_EQ(CELIX_SUCCESS, status);
 
     auto endpoint = CreateEndpointDescription();
     long proxyId = -1;
-    status = rsaJsonRpc_createProxy(jsonRpc, endpoint, SendRequest, nullptr, &proxyId);
+    status = rsaRpc_createProxy(jsonRpc, endpoint, SendRequest, nullptr, &proxyId);
     EXPECT_EQ(CELIX_SUCCESS, status);
     EXPECT_NE(-1, proxyId);
 
     endpointDescription_destroy(endpoint);
 
-    rsaJsonRpc_destroyProxy(jsonRpc, proxyId);
+    rsaRpc_destroyProxy(jsonRpc, proxyId);
 
-    rsaJsonRpc_destroy(jsonRpc);
+    rsaRpc_destroy(jsonRpc);
 }
 
 TEST_F(RsaJsonRpcUnitTestSuite, CreateRpcProxyWithInvalidParams) {
-    rsa_json_rpc_t *jsonRpc = nullptr;
-    auto status  = rsaJsonRpc_create(ctx.get(), logHelper.get(), &jsonRpc);
+    rsa_rpc_t *jsonRpc = nullptr;
+    auto status  = rsaRpc_create(ctx.get(), logHelper.get(), &rsaJsonRpc_serializer, &jsonRpc);
     EXPECT_EQ(CELIX_SUCCESS, status);
 
     auto endpoint = CreateEndpointDescription();
     long proxyId = -1;
-    status = rsaJsonRpc_createProxy(jsonRpc, nullptr, SendRequest, nullptr, &proxyId);
+    status = rsaRpc_createProxy(jsonRpc, nullptr, SendRequest, nullptr, &proxyId);
     EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, status);
 
-    status = rsaJsonRpc_createProxy(jsonRpc, endpoint, nullptr, nullptr, &proxyId);
+    status = rsaRpc_createProxy(jsonRpc, endpoint, nullptr, nullptr, &proxyId);
     EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, status);
 
-    status = rsaJsonRpc_createProxy(jsonRpc, endpoint, SendRequest, nullptr, nullptr);
+    status = rsaRpc_createProxy(jsonRpc, endpoint, SendRequest, nullptr, nullptr);
     EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, status);
 
     endpointDescription_destroy(endpoint);
 
-    rsaJsonRpc_destroy(jsonRpc);
+    rsaRpc_destroy(jsonRpc);
 }
 
 TEST_F(RsaJsonRpcUnitTestSuite, RpcProxyFailedToCreateProxyFactory) {
-    rsa_json_rpc_t *jsonRpc = nullptr;
-    auto status  = rsaJsonRpc_create(ctx.get(), logHelper.get(), &jsonRpc);
+    rsa_rpc_t *jsonRpc = nullptr;
+    auto status  = rsaRpc_create(ctx.get(), logHelper.get(), &rsaJsonRpc_serializer, &jsonRpc);
     EXPECT_EQ(CELIX_SUCCESS, status);
 
     auto endpoint = CreateEndpointDescription();
     long proxyId = -1;
-    celix_ei_expect_calloc((void*)&rsaJsonRpcProxy_factoryCreate, 0, nullptr);
-    status = rsaJsonRpc_createProxy(jsonRpc, endpoint, SendRequest, nullptr, &proxyId);
+    celix_ei_expect_calloc((void*)&rsaRpcProxy_factoryCreate, 0, nullptr);
+    status = rsaRpc_createProxy(jsonRpc, endpoint, SendRequest, nullptr, &proxyId);
     EXPECT_EQ(CELIX_ENOMEM, status);
 
     endpointDescription_destroy(endpoint);
 
-    rsaJsonRpc_destroy(jsonRpc);
+    rsaRpc_destroy(jsonRpc);
 }
 
 TEST_F(RsaJsonRpcUnitTestSuite, DestroyRpcProxyWithInvalidParams) {
-    rsaJsonRpc_destroyProxy(nullptr, 101);
+    rsaRpc_destroyProxy(nullptr, 101);
 }
 
 TEST_F(RsaJsonRpcUnitTestSuite, CreateEndpoint) {
-    rsa_json_rpc_t *jsonRpc = nullptr;
-    auto status  = rsaJsonRpc_create(ctx.get(), logHelper.get(), &jsonRpc);
+    rsa_rpc_t *jsonRpc = nullptr;
+    auto status  = rsaRpc_create(ctx.get(), logHelper.get(), &rsaJsonRpc_serializer, &jsonRpc);
     EXPECT_EQ(CELIX_SUCCESS, status);
 
     auto endpoint = CreateEndpointDescription();
     long requestHandlerSvcId = -1;
-    status = rsaJsonRpc_createEndpoint(jsonRpc, endpoint, &requestHandlerSvcId);
+    status = rsaRpc_createEndpoint(jsonRpc, endpoint, &requestHandlerSvcId);
     EXPECT_EQ(CELIX_SUCCESS, status);
     EXPECT_NE(-1, requestHandlerSvcId);
 
     endpointDescription_destroy(endpoint);
 
-    rsaJsonRpc_destroyEndpoint(jsonRpc, requestHandlerSvcId);
+    rsaRpc_destroyEndpoint(jsonRpc, requestHandlerSvcId);
 
-    rsaJsonRpc_destroy(jsonRpc);
+    rsaRpc_destroy(jsonRpc);
 }
 
 TEST_F(RsaJsonRpcUnitTestSuite, CreateRpcEndpointWithInvalidParams) {
-    rsa_json_rpc_t *jsonRpc = nullptr;
-    auto status  = rsaJsonRpc_create(ctx.get(), logHelper.get(), &jsonRpc);
+    rsa_rpc_t *jsonRpc = nullptr;
+    auto status  = rsaRpc_create(ctx.get(), logHelper.get(), &rsaJsonRpc_serializer, &jsonRpc);
     EXPECT_EQ(CELIX_SUCCESS, status);
 
     auto endpoint = CreateEndpointDescription();
     long requestHandlerSvcId = -1;
-    status = rsaJsonRpc_createEndpoint(jsonRpc, nullptr, &requestHandlerSvcId);
+    status = rsaRpc_createEndpoint(jsonRpc, nullptr, &requestHandlerSvcId);
     EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, status);
 
-    status = rsaJsonRpc_createEndpoint(jsonRpc, endpoint, nullptr);
+    status = rsaRpc_createEndpoint(jsonRpc, endpoint, nullptr);
     EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, status);
 
-    status = rsaJsonRpc_createEndpoint(nullptr, endpoint, &requestHandlerSvcId);
+    status = rsaRpc_createEndpoint(nullptr, endpoint, &requestHandlerSvcId);
     EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, status);
 
     endpointDescription_destroy(endpoint);
 
-    rsaJsonRpc_destroy(jsonRpc);
+    rsaRpc_destroy(jsonRpc);
 }
 
 TEST_F(RsaJsonRpcUnitTestSuite, RpcEndpointFailedToCreateEndpoint) {
-    rsa_json_rpc_t *jsonRpc = nullptr;
-    auto status  = rsaJsonRpc_create(ctx.get(), logHelper.get(), &jsonRpc);
+    rsa_rpc_t *jsonRpc = nullptr;
+    auto status  = rsaRpc_create(ctx.get(), logHelper.get(), &rsaJsonRpc_serializer, &jsonRpc);
     EXPECT_EQ(CELIX_SUCCESS, status);
 
     auto endpoint = CreateEndpointDescription();
     long requestHandlerSvcId = -1;
-    celix_ei_expect_calloc((void*)&rsaJsonRpcEndpoint_create, 0, nullptr);
-    status = rsaJsonRpc_createEndpoint(jsonRpc, endpoint, &requestHandlerSvcId);
+    celix_ei_expect_calloc((void*)&rsaRpcEndpoint_create, 0, nullptr);
+    status = rsaRpc_createEndpoint(jsonRpc, endpoint, &requestHandlerSvcId);
     EXPECT_EQ(CELIX_ENOMEM, status);
 
     endpointDescription_destroy(endpoint);
 
-    rsaJsonRpc_destroy(jsonRpc);
+    rsaRpc_destroy(jsonRpc);
 }
 
 TEST_F(RsaJsonRpcUnitTestSuite, DestroyRpcEndpointWithInvalidParams) {
-    rsaJsonRpc_destroyEndpoint(nullptr, 101);
+    rsaRpc_destroyEndpoint(nullptr, 101);
 }
 
 
 class RsaJsonRpcProxyUnitTestSuite : public RsaJsonRpcUnitTestSuite {
 public:
     RsaJsonRpcProxyUnitTestSuite() {
-        rsa_json_rpc_t *jsonRpcPtr = nullptr;
-        auto status  = rsaJsonRpc_create(ctx.get(), logHelper.get(), &jsonRpcPtr);
+        rsa_rpc_t *jsonRpcPtr = nullptr;
+        auto status  = rsaRpc_create(ctx.get(), logHelper.get(), &rsaJsonRpc_serializer, &jsonRpcPtr);
         EXPECT_EQ(CELIX_SUCCESS, status);
         EXPECT_NE(nullptr, jsonRpcPtr);
-        jsonRpc = std::shared_ptr<rsa_json_rpc_t>{jsonRpcPtr, [](auto* r){rsaJsonRpc_destroy(r);}};
+        jsonRpc = std::shared_ptr<rsa_rpc_t>{jsonRpcPtr, [](auto* r){rsaRpc_destroy(r);}};
     }
 
     ~RsaJsonRpcProxyUnitTestSuite() override {
 
     };
 
-    std::shared_ptr<rsa_json_rpc_t> jsonRpc{};
+    std::shared_ptr<rsa_rpc_t> jsonRpc{};
 };
 
 TEST_F(RsaJsonRpcProxyUnitTestSuite, FailedToGetServiceVersionFromEndpointDescription) {
     auto endpoint = CreateEndpointDescription();
     celix_properties_unset(endpoint->properties, CELIX_FRAMEWORK_SERVICE_VERSION);
     long proxyId = -1;
-    auto status = rsaJsonRpc_createProxy(jsonRpc.get(), endpoint, SendRequest, nullptr, &proxyId);
+    auto status = rsaRpc_createProxy(jsonRpc.get(), endpoint, SendRequest, nullptr, &proxyId);
     EXPECT_EQ(CELIX_SUCCESS, status);
     endpointDescription_destroy(endpoint);
 
@@ -325,14 +329,14 @@ TEST_F(RsaJsonRpcProxyUnitTestSuite, FailedToGetServiceVersionFromEndpointDescri
     auto found = celix_bundleContext_useService(ctx.get(), RSA_RPC_JSON_TEST_SERVICE, nullptr, [](void*, void*) {});
     EXPECT_FALSE(found);
 
-    rsaJsonRpc_destroyProxy(jsonRpc.get(), proxyId);
+    rsaRpc_destroyProxy(jsonRpc.get(), proxyId);
 }
 
 TEST_F(RsaJsonRpcProxyUnitTestSuite, ServiceVersionUncompatible) {
     auto endpoint = CreateEndpointDescription();
     celix_properties_set(endpoint->properties, CELIX_FRAMEWORK_SERVICE_VERSION, "2.0.0");//It is 1.0.0 in the descriptor file of consumer
     long proxyId = -1;
-    auto status = rsaJsonRpc_createProxy(jsonRpc.get(), endpoint, SendRequest, nullptr, &proxyId);
+    auto status = rsaRpc_createProxy(jsonRpc.get(), endpoint, SendRequest, nullptr, &proxyId);
     EXPECT_EQ(CELIX_SUCCESS, status);
     endpointDescription_destroy(endpoint);
 
@@ -341,21 +345,21 @@ TEST_F(RsaJsonRpcProxyUnitTestSuite, ServiceVersionUncompatible) {
     auto found = celix_bundleContext_useService(ctx.get(), RSA_RPC_JSON_TEST_SERVICE, nullptr, [](void*, void*) {});
     EXPECT_FALSE(found);
 
-    rsaJsonRpc_destroyProxy(jsonRpc.get(), proxyId);
+    rsaRpc_destroyProxy(jsonRpc.get(), proxyId);
 }
 
 class  RsaJsonRpcProxyUnitTestSuite2 : public RsaJsonRpcProxyUnitTestSuite {
 public:
     RsaJsonRpcProxyUnitTestSuite2() {
         auto endpoint = CreateEndpointDescription();
-        auto status = rsaJsonRpc_createProxy(jsonRpc.get(), endpoint, SendRequest, nullptr, &proxyId);
+        auto status = rsaRpc_createProxy(jsonRpc.get(), endpoint, SendRequest, nullptr, &proxyId);
         EXPECT_EQ(CELIX_SUCCESS, status);
         endpointDescription_destroy(endpoint);
 
         celix_bundleContext_waitForEvents(ctx.get());//wait for proxy service registration
     }
     ~RsaJsonRpcProxyUnitTestSuite2() override {
-        rsaJsonRpc_destroyProxy(jsonRpc.get(), proxyId);
+        rsaRpc_destroyProxy(jsonRpc.get(), proxyId);
     }
     long proxyId{-1};
 };
@@ -363,16 +367,16 @@ public:
 TEST_F(RsaJsonRpcProxyUnitTestSuite, FailedToCreateSendRequestMethodLock) {
     celix_autoptr(endpoint_description_t) endpoint = CreateEndpointDescription();
     long proxyId = -1L;
-    celix_ei_expect_celixThreadRwlock_create((void*)&rsaJsonRpcProxy_factoryCreate, 0, CELIX_ENOMEM);
-    auto status = rsaJsonRpc_createProxy(jsonRpc.get(), endpoint, SendRequest, nullptr, &proxyId);
+    celix_ei_expect_celixThreadRwlock_create((void*)&rsaRpcProxy_factoryCreate, 0, CELIX_ENOMEM);
+    auto status = rsaRpc_createProxy(jsonRpc.get(), endpoint, SendRequest, nullptr, &proxyId);
     EXPECT_EQ(CELIX_ENOMEM, status);
 }
 
 TEST_F(RsaJsonRpcProxyUnitTestSuite, FailedToCreateProxiesHashMap) {
     auto endpoint = CreateEndpointDescription();
     long proxyId = -1L;
-    celix_ei_expect_celix_longHashMap_create((void*)&rsaJsonRpc_createProxy, 1, nullptr);
-    auto status = rsaJsonRpc_createProxy(jsonRpc.get(), endpoint, SendRequest, nullptr, &proxyId);
+    celix_ei_expect_celix_longHashMap_create((void*)&rsaRpc_createProxy, 1, nullptr);
+    auto status = rsaRpc_createProxy(jsonRpc.get(), endpoint, SendRequest, nullptr, &proxyId);
     EXPECT_EQ(CELIX_ENOMEM, status);
 
     endpointDescription_destroy(endpoint);
@@ -382,7 +386,7 @@ TEST_F(RsaJsonRpcProxyUnitTestSuite, FailedToCloneEndpointDescription) {
     auto endpoint = CreateEndpointDescription();
     long proxyId = -1L;
     celix_ei_expect_calloc((void*)&endpointDescription_clone, 0, nullptr);
-    auto status = rsaJsonRpc_createProxy(jsonRpc.get(), endpoint, SendRequest, nullptr, &proxyId);
+    auto status = rsaRpc_createProxy(jsonRpc.get(), endpoint, SendRequest, nullptr, &proxyId);
     EXPECT_EQ(CELIX_ENOMEM, status);
 
     endpointDescription_destroy(endpoint);
@@ -391,16 +395,16 @@ TEST_F(RsaJsonRpcProxyUnitTestSuite, FailedToCloneEndpointDescription) {
 TEST_F(RsaJsonRpcProxyUnitTestSuite, FailedToCreateProxyServiceProperties) {
     celix_autoptr(endpoint_description_t)  endpoint = CreateEndpointDescription();
     long proxyId = -1L;
-    celix_ei_expect_celix_properties_copy((void*)&rsaJsonRpcProxy_factoryCreate, 1, nullptr, 2);//first:endpointDescription_clone, second:celix_rsaUtils_createServicePropertiesFromEndpointProperties
-    auto status = rsaJsonRpc_createProxy(jsonRpc.get(), endpoint, SendRequest, nullptr, &proxyId);
+    celix_ei_expect_celix_properties_copy((void*)&rsaRpcProxy_factoryCreate, 1, nullptr, 2);//first:endpointDescription_clone, second:celix_rsaUtils_createServicePropertiesFromEndpointProperties
+    auto status = rsaRpc_createProxy(jsonRpc.get(), endpoint, SendRequest, nullptr, &proxyId);
     EXPECT_EQ(CELIX_ENOMEM, status);
 }
 
 TEST_F(RsaJsonRpcProxyUnitTestSuite, FailedToRegisterProxyService) {
     auto endpoint = CreateEndpointDescription();
     long proxyId = -1L;
-    celix_ei_expect_celix_bundleContext_registerServiceFactoryAsync((void*)&rsaJsonRpcProxy_factoryCreate, 0, -1);
-    auto status = rsaJsonRpc_createProxy(jsonRpc.get(), endpoint, SendRequest, nullptr, &proxyId);
+    celix_ei_expect_celix_bundleContext_registerServiceFactoryAsync((void*)&rsaRpcProxy_factoryCreate, 0, -1);
+    auto status = rsaRpc_createProxy(jsonRpc.get(), endpoint, SendRequest, nullptr, &proxyId);
     EXPECT_EQ(CELIX_SERVICE_EXCEPTION, status);
 
     endpointDescription_destroy(endpoint);
@@ -460,7 +464,7 @@ TEST_F(RsaJsonRpcProxyUnitTestSuite2, InvokeProxyServiceWithInvalidParams) {
 TEST_F(RsaJsonRpcProxyUnitTestSuite2, InvokeProxyServiceWhenProxyIsDestroying) {
     auto found = celix_bundleContext_useService(ctx.get(), RSA_RPC_JSON_TEST_SERVICE, this, [](void *handle, void *svc) {
         auto self = static_cast<RsaJsonRpcProxyUnitTestSuite2*>(handle);
-        rsaJsonRpc_destroyProxy(self->jsonRpc.get(), self->proxyId);
+        rsaRpc_destroyProxy(self->jsonRpc.get(), self->proxyId);
         auto proxySvc = static_cast<rsa_rpc_json_test_service_t*>(svc);
         EXPECT_NE(nullptr, proxySvc);
         EXPECT_EQ(CELIX_ILLEGAL_STATE, proxySvc->test(proxySvc->handle));
@@ -493,7 +497,7 @@ TEST_F(RsaJsonRpcProxyUnitTestSuite2, FailedToCreateMetadata) {
 TEST_F(RsaJsonRpcProxyUnitTestSuite, FailedToSendRequest) {
     auto endpoint = CreateEndpointDescription();
     long proxyId{-1};
-    auto status = rsaJsonRpc_createProxy(jsonRpc.get(), endpoint, [](void*, const endpoint_description_t*, celix_properties_t*,
+    auto status = rsaRpc_createProxy(jsonRpc.get(), endpoint, [](void*, const endpoint_description_t*, celix_properties_t*,
             const struct iovec*, struct iovec*) { return CELIX_ILLEGAL_STATE;}, nullptr, &proxyId);
     EXPECT_EQ(CELIX_SUCCESS, status);
     endpointDescription_destroy(endpoint);
@@ -507,13 +511,66 @@ TEST_F(RsaJsonRpcProxyUnitTestSuite, FailedToSendRequest) {
     });
     EXPECT_TRUE(found);
 
-    rsaJsonRpc_destroyProxy(jsonRpc.get(), proxyId);
+    rsaRpc_destroyProxy(jsonRpc.get(), proxyId);
+}
+
+TEST_F(RsaJsonRpcProxyUnitTestSuite, CallProxyServiceUsingMethodIndex) {
+    auto endpoint = CreateEndpointDescription();
+    celix_properties_setBool(endpoint->properties, RSA_JSON_RPC_METHOD_INDEX_KEY, true);
+    long proxyId{-1};
+    auto status = rsaRpc_createProxy(jsonRpc.get(), endpoint, [](void*, const endpoint_description_t*, celix_properties_t*,
+            const struct iovec* request, struct iovec* response) {
+        EXPECT_STREQ(R"({"m":0,"a":[]})", (const char*)request->iov_base);
+        response->iov_base = strdup("{}");
+        response->iov_len = 2;
+        return CELIX_SUCCESS;
+    }, nullptr, &proxyId);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    endpointDescription_destroy(endpoint);
+    celix_bundleContext_waitForEvents(ctx.get());//wait for proxy service registration
+
+    auto found = celix_bundleContext_useService(ctx.get(), RSA_RPC_JSON_TEST_SERVICE, nullptr, [](void *handle, void *svc) {
+        (void)handle;//unused
+        auto proxySvc = static_cast<rsa_rpc_json_test_service_t*>(svc);
+        EXPECT_NE(nullptr, proxySvc);
+        EXPECT_EQ(CELIX_SUCCESS, proxySvc->test(proxySvc->handle));
+    });
+    EXPECT_TRUE(found);
+
+    rsaRpc_destroyProxy(jsonRpc.get(), proxyId);
+}
+
+TEST_F(RsaJsonRpcProxyUnitTestSuite, MethodIndexIsNotUsedForDifferentServiceVersion) {
+    auto endpoint = CreateEndpointDescription();
+    celix_properties_setBool(endpoint->properties, RSA_JSON_RPC_METHOD_INDEX_KEY, true);
+    celix_properties_set(endpoint->properties, CELIX_FRAMEWORK_SERVICE_VERSION, "1.1.0");//compatible, but a different descriptor
+    long proxyId{-1};
+    auto status = rsaRpc_createProxy(jsonRpc.get(), endpoint, [](void*, const endpoint_description_t*, celix_properties_t*,
+            const struct iovec* request, struct iovec* response) {
+        EXPECT_STREQ(R"({"m":"test","a":[]})", (const char*)request->iov_base);
+        response->iov_base = strdup("{}");
+        response->iov_len = 2;
+        return CELIX_SUCCESS;
+    }, nullptr, &proxyId);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+    endpointDescription_destroy(endpoint);
+    celix_bundleContext_waitForEvents(ctx.get());//wait for proxy service registration
+
+    auto found = celix_bundleContext_useService(ctx.get(), RSA_RPC_JSON_TEST_SERVICE, nullptr, [](void *handle, void *svc) {
+        (void)handle;//unused
+        auto proxySvc = static_cast<rsa_rpc_json_test_service_t*>(svc);
+        EXPECT_NE(nullptr, proxySvc);
+        EXPECT_EQ(CELIX_SUCCESS, proxySvc->test(proxySvc->handle));
+    });
+    EXPECT_TRUE(found);
+
+    rsaRpc_destroyProxy(jsonRpc.get(), proxyId);
 }
 
 TEST_F(RsaJsonRpcProxyUnitTestSuite, ResponseIsNull) {
     auto endpoint = CreateEndpointDescription();
     long proxyId{-1};
-    auto status = rsaJsonRpc_createProxy(jsonRpc.get(), endpoint, [](void*, const endpoint_description_t*, celix_properties_t*,
+    auto status = rsaRpc_createProxy(jsonRpc.get(), endpoint, [](void*, const endpoint_description_t*, celix_properties_t*,
                                                                      const struct iovec*, struct iovec* response) {
         response->iov_base = nullptr;//set to nullptr
         response->iov_len = 0;
@@ -530,13 +587,13 @@ TEST_F(RsaJsonRpcProxyUnitTestSuite, ResponseIsNull) {
         });
     EXPECT_TRUE(found);
 
-    rsaJsonRpc_destroyProxy(jsonRpc.get(), proxyId);
+    rsaRpc_destroyProxy(jsonRpc.get(), proxyId);
 }
 
 TEST_F(RsaJsonRpcProxyUnitTestSuite, ResponseIsInvalid) {
     auto endpoint = CreateEndpointDescription();
     long proxyId{-1};
-    auto status = rsaJsonRpc_createProxy(jsonRpc.get(), endpoint, [](void*, const endpoint_description_t*, celix_properties_t*,
+    auto status = rsaRpc_createProxy(jsonRpc.get(), endpoint, [](void*, const endpoint_description_t*, celix_properties_t*,
                                                                      const struct iovec*, struct iovec* response) {
         response->iov_base = strdup("invalid");//set to invalid
         response->iov_len = 0;
@@ -553,13 +610,13 @@ TEST_F(RsaJsonRpcProxyUnitTestSuite, ResponseIsInvalid) {
     });
     EXPECT_TRUE(found);
 
-    rsaJsonRpc_destroyProxy(jsonRpc.get(), proxyId);
+    rsaRpc_destroyProxy(jsonRpc.get(), proxyId);
 }
 
 TEST_F(RsaJsonRpcProxyUnitTestSuite, RemoteServiceReturnsError) {
     auto endpoint = CreateEndpointDescription();
     long proxyId{-1};
-    auto status = rsaJsonRpc_createProxy(jsonRpc.get(), endpoint, [](void*, const endpoint_description_t*, celix_properties_t*,
+    auto status = rsaRpc_createProxy(jsonRpc.get(), endpoint, [](void*, const endpoint_description_t*, celix_properties_t*,
                                                                      const struct iovec*, struct iovec* response) {
         response->iov_base = strdup("{\"e\":70003}");//set error code
         response->iov_len = strlen((const char*)response->iov_base);
@@ -576,7 +633,7 @@ TEST_F(RsaJsonRpcProxyUnitTestSuite, RemoteServiceReturnsError) {
     });
     EXPECT_TRUE(found);
 
-    rsaJsonRpc_destroyProxy(jsonRpc.get(), proxyId);
+    rsaRpc_destroyProxy(jsonRpc.get(), proxyId);
 }
 
 TEST_F(RsaJsonRpcProxyUnitTestSuite2, ServiceInvocationIsIntercepted) {
@@ -617,11 +674,11 @@ TEST_F(RsaJsonRpcProxyUnitTestSuite2, ServiceInvocationIsIntercepted) {
 class RsaJsonRpcEndPointUnitTestSuite : public RsaJsonRpcUnitTestSuite {
 public:
     RsaJsonRpcEndPointUnitTestSuite() {
-        rsa_json_rpc_t *jsonRpcPtr = nullptr;
-        auto status  = rsaJsonRpc_create(ctx.get(), logHelper.get(), &jsonRpcPtr);
+        rsa_rpc_t *jsonRpcPtr = nullptr;
+        auto status  = rsaRpc_create(ctx.get(), logHelper.get(), &rsaJsonRpc_serializer, &jsonRpcPtr);
         EXPECT_EQ(CELIX_SUCCESS, status);
         EXPECT_NE(nullptr, jsonRpcPtr);
-        jsonRpc = std::shared_ptr<rsa_json_rpc_t>{jsonRpcPtr, [](auto* r){rsaJsonRpc_destroy(r);}};
+        jsonRpc = std::shared_ptr<rsa_rpc_t>{jsonRpcPtr, [](auto* r){rsaRpc_destroy(r);}};
 
         static rsa_rpc_json_test_service_t testSvc{};
         testSvc.handle = nullptr;
@@ -642,21 +699,21 @@ public:
         celix_bundleContext_unregisterServiceAsync(ctx.get(), rpcTestSvcId, nullptr, nullptr);
     }
 
-    unsigned int GenerateSerialProtoId() {//The same as rsaJsonRpc_generateSerialProtoId
+    unsigned int GenerateSerialProtoId() {//The same as rsaRpc_generateSerialProtoId
         const char *bundleSymName = celix_bundle_getSymbolicName(celix_bundleContext_getBundle(ctx.get()));
         return celix_utils_stringHash(bundleSymName) + CELIX_FRAMEWORK_VERSION_MAJOR;
     }
 
-    std::shared_ptr<rsa_json_rpc_t> jsonRpc{};
+    std::shared_ptr<rsa_rpc_t> jsonRpc{};
     long rpcTestSvcId = -1;
 };
 
 TEST_F(RsaJsonRpcEndPointUnitTestSuite, FailedToCreateEndpointLock) {
     auto endpoint = CreateEndpointDescription(rpcTestSvcId);
 
-    celix_ei_expect_celixThreadRwlock_create((void*)&rsaJsonRpcEndpoint_create, 0, CELIX_ENOMEM);
+    celix_ei_expect_celixThreadRwlock_create((void*)&rsaRpcEndpoint_create, 0, CELIX_ENOMEM);
     long svcId = -1L;
-    auto status = rsaJsonRpc_createEndpoint(jsonRpc.get(), endpoint, &svcId);
+    auto status = rsaRpc_createEndpoint(jsonRpc.get(), endpoint, &svcId);
     EXPECT_EQ(CELIX_ENOMEM, status);
 
     endpointDescription_destroy(endpoint);
@@ -666,7 +723,7 @@ TEST_F(RsaJsonRpcEndPointUnitTestSuite, FailedToCloneEndpointDescription) {
     auto endpoint = CreateEndpointDescription(rpcTestSvcId);
     celix_ei_expect_calloc((void *)&endpointDescription_clone, 0, nullptr);
     long svcId = -1L;
-    auto status = rsaJsonRpc_createEndpoint(jsonRpc.get(), endpoint, &svcId);
+    auto status = rsaRpc_createEndpoint(jsonRpc.get(), endpoint, &svcId);
     EXPECT_EQ(CELIX_ENOMEM, status);
 
     endpointDescription_destroy(endpoint);
@@ -675,9 +732,9 @@ TEST_F(RsaJsonRpcEndPointUnitTestSuite, FailedToCloneEndpointDescription) {
 TEST_F(RsaJsonRpcEndPointUnitTestSuite, FailedToTrackEndpointService) {
     auto endpoint = CreateEndpointDescription(rpcTestSvcId);
 
-    celix_ei_expect_celix_bundleContext_trackServicesWithOptions((void*)&rsaJsonRpcEndpoint_create, 0, -1);
+    celix_ei_expect_celix_bundleContext_trackServicesWithOptions((void*)&rsaRpcEndpoint_create, 0, -1);
     long svcId = -1L;
-    auto status = rsaJsonRpc_createEndpoint(jsonRpc.get(), endpoint, &svcId);
+    auto status = rsaRpc_createEndpoint(jsonRpc.get(), endpoint, &svcId);
     EXPECT_EQ(CELIX_ILLEGAL_STATE, status);
 
     endpointDescription_destroy(endpoint);
@@ -686,7 +743,7 @@ TEST_F(RsaJsonRpcEndPointUnitTestSuite, FailedToTrackEndpointService) {
 TEST_F(RsaJsonRpcEndPointUnitTestSuite, HandleRequest) {
     auto endpoint = CreateEndpointDescription(rpcTestSvcId);
     long epId = -1L;
-    auto status = rsaJsonRpc_createEndpoint(jsonRpc.get(), endpoint, &epId);
+    auto status = rsaRpc_createEndpoint(jsonRpc.get(), endpoint, &epId);
     EXPECT_EQ(CELIX_SUCCESS, status);
 
     celix_bundleContext_waitForEvents(ctx.get());//wait for async endpoint creation
@@ -699,12 +756,42 @@ TEST_F(RsaJsonRpcEndPointUnitTestSuite, HandleRequest) {
     request.iov_base =  (char *)"{\n    \"m\": \"test\",\n    \"a\": []\n}";
     request.iov_len = strlen((char*)request.iov_base);
     struct iovec reply{nullptr,0};
-    EXPECT_EQ(CELIX_SUCCESS, celix_rsaJsonRpc_handleRequest(jsonRpc.get(), epId, metadata, &request, &reply));
+    EXPECT_EQ(CELIX_SUCCESS, rsaRpc_handleRequest(jsonRpc.get(), epId, metadata, &request, &reply));
     free(reply.iov_base);
 
     celix_properties_destroy(metadata);
 
-    rsaJsonRpc_destroyEndpoint(jsonRpc.get(), epId);
+    rsaRpc_destroyEndpoint(jsonRpc.get(), epId);
+    endpointDescription_destroy(endpoint);
+}
+
+TEST_F(RsaJsonRpcEndPointUnitTestSuite, HandleRequestWithMethodIndex) {
+    auto endpoint = CreateEndpointDescription(rpcTestSvcId);
+    long epId = -1L;
+    auto status = rsaRpc_createEndpoint(jsonRpc.get(), endpoint, &epId);
+    EXPECT_EQ(CELIX_SUCCESS, status);
+
+    celix_bundleContext_waitForEvents(ctx.get());//wait for async endpoint creation
+
+    unsigned int serialProtoId = GenerateSerialProtoId();
+    celix_properties_t *metadata = celix_properties_create();
+    celix_properties_setLong(metadata, "SerialProtocolId", serialProtoId);
+
+    struct iovec request{};
+    request.iov_base =  (char *)R"({"m":0,"a":[]})";
+    request.iov_len = strlen((char*)request.iov_base);
+    struct iovec reply{nullptr,0};
+    EXPECT_EQ(CELIX_SUCCESS, rsaRpc_handleRequest(jsonRpc.get(), epId, metadata, &request, &reply));
+    free(reply.iov_base);
+
+    //invalid method index
+    request.iov_base =  (char *)R"({"m":1,"a":[]})";
+    request.iov_len = strlen((char*)request.iov_base);
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, rsaRpc_handleRequest(jsonRpc.get(), epId, metadata, &request, &reply));
+
+    celix_properties_destroy(metadata);
+
+    rsaRpc_destroyEndpoint(jsonRpc.get(), epId);
     endpointDescription_destroy(endpoint);
 }
 
@@ -712,7 +799,7 @@ TEST_F(RsaJsonRpcEndPointUnitTestSuite, FailedToFindInterfaceDescriptor) {
     setenv("CELIX_FRAMEWORK_EXTENDER_PATH", RESOURCES_DIR"/non-exist", true);
     auto endpoint = CreateEndpointDescription(rpcTestSvcId);
     long epId = -1L;
-    auto status = rsaJsonRpc_createEndpoint(jsonRpc.get(), endpoint, &epId);
+    auto status = rsaRpc_createEndpoint(jsonRpc.get(), endpoint, &epId);
     EXPECT_EQ(CELIX_SUCCESS, status);
 
     celix_bundleContext_waitForEvents(ctx.get());//wait for async endpoint creation
@@ -725,12 +812,18 @@ TEST_F(RsaJsonRpcEndPointUnitTestSuite, FailedToFindInterfaceDescriptor) {
     request.iov_base =  (char *)"{\n    \"m\": \"test\",\n    \"a\": []\n}";
     request.iov_len = strlen((char*)request.iov_base);
     struct iovec reply{nullptr,0};
-    EXPECT_EQ(CELIX_ILLEGAL_STATE, celix_rsaJsonRpc_handleRequest(jsonRpc.get(), epId, metadata, &request, &reply));
+    EXPECT_EQ(CELIX_ILLEGAL_STATE, rsaRpc_handleRequest(jsonRpc.get(), epId, metadata, &request, &reply));
     free(reply.iov_base);
 
+    //a method index can not be resolved without the interface descriptor
+    request.iov_base =  (char *)R"({"m":0,"a":[]})";
+    request.iov_len = strlen((char*)request.iov_base);
+    EXPECT_EQ(CELIX_ILLEGAL_STATE, rsaRpc_handleRequest(jsonRpc.get(), epId, metadata, &request, &reply));
+    EXPECT_EQ(nullptr, reply.iov_base);
+
     celix_properties_destroy(metadata);
 
-    rsaJsonRpc_destroyEndpoint(jsonRpc.get(), epId);
+    rsaRpc_destroyEndpoint(jsonRpc.get(), epId);
     endpointDescription_destroy(endpoint);
     unsetenv("CELIX_FRAMEWORK_EXTENDER_PATH");
 }
@@ -739,7 +832,7 @@ TEST_F(RsaJsonRpcEndPointUnitTestSuite, ServiceVersionMismatched) {
     auto endpoint = CreateEndpointDescription(rpcTestSvcId);
     celix_properties_set(endpoint->properties, CELIX_FRAMEWORK_SERVICE_VERSION, "2.0.0");//Its 1.0.0 in the interface descriptor
     long epId = -1L;
-    auto status = rsaJsonRpc_createEndpoint(jsonRpc.get(), endpoint, &epId);
+    auto status = rsaRpc_createEndpoint(jsonRpc.get(), endpoint, &epId);
     EXPECT_EQ(CELIX_SUCCESS, status);
 
     celix_bundleContext_waitForEvents(ctx.get());//wait for async endpoint creation
@@ -752,12 +845,12 @@ TEST_F(RsaJsonRpcEndPointUnitTestSuite, ServiceVersionMismatched) {
     request.iov_base =  (char *)"{\n    \"m\": \"test\",\n    \"a\": []\n}";
     request.iov_len = strlen((char*)request.iov_base);
     struct iovec reply{nullptr,0};
-    EXPECT_EQ(CELIX_ILLEGAL_STATE, celix_rsaJsonRpc_handleRequest(jsonRpc.get(), epId, metadata, &request, &reply));
+    EXPECT_EQ(CELIX_ILLEGAL_STATE, rsaRpc_handleRequest(jsonRpc.get(), epId, metadata, &request, &reply));
     free(reply.iov_base);
 
     celix_properties_destroy(metadata);
 
-    rsaJsonRpc_destroyEndpoint(jsonRpc.get(), epId);
+    rsaRpc_destroyEndpoint(jsonRpc.get(), epId);
     endpointDescription_destroy(endpoint);
 }
 
@@ -765,7 +858,7 @@ TEST_F(RsaJsonRpcEndPointUnitTestSuite, EndpointLostServiceVersion) {
     auto endpoint = CreateEndpointDescription(rpcTestSvcId);
     celix_properties_unset(endpoint->properties, CELIX_FRAMEWORK_SERVICE_VERSION);
     long epId = -1L;
-    auto status = rsaJsonRpc_createEndpoint(jsonRpc.get(), endpoint, &epId);
+    auto status = rsaRpc_createEndpoint(jsonRpc.get(), endpoint, &epId);
     EXPECT_EQ(CELIX_SUCCESS, status);
 
     celix_bundleContext_waitForEvents(ctx.get());//wait for async endpoint creation
@@ -778,19 +871,19 @@ TEST_F(RsaJsonRpcEndPointUnitTestSuite, EndpointLostServiceVersion) {
     request.iov_base =  (char *)"{\n    \"m\": \"test\",\n    \"a\": []\n}";
     request.iov_len = strlen((char*)request.iov_base);
     struct iovec reply{nullptr,0};
-    EXPECT_EQ(CELIX_ILLEGAL_STATE, celix_rsaJsonRpc_handleRequest(jsonRpc.get(), epId, metadata, &request, &reply));
+    EXPECT_EQ(CELIX_ILLEGAL_STATE, rsaRpc_handleRequest(jsonRpc.get(), epId, metadata, &request, &reply));
     free(reply.iov_base);
 
     celix_properties_destroy(metadata);
 
-    rsaJsonRpc_destroyEndpoint(jsonRpc.get(), epId);
+    rsaRpc_destroyEndpoint(jsonRpc.get(), epId);
     endpointDescription_destroy(endpoint);
 }
 
 TEST_F(RsaJsonRpcEndPointUnitTestSuite, UseRequestHandlerWithInvalidParams) {
     auto endpoint = CreateEndpointDescription(rpcTestSvcId);
     long epId = -1L;
-    auto status = rsaJsonRpc_createEndpoint(jsonRpc.get(), endpoint, &epId);
+    auto status = rsaRpc_createEndpoint(jsonRpc.get(), endpoint, &epId);
     EXPECT_EQ(CELIX_SUCCESS, status);
 
     celix_bundleContext_waitForEvents(ctx.get());//wait for async endpoint creation
@@ -804,30 +897,30 @@ TEST_F(RsaJsonRpcEndPointUnitTestSuite, UseRequestHandlerWithInvalidParams) {
     request.iov_len = strlen((char*)request.iov_base);
     struct iovec reply{nullptr,0};
 
-    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, celix_rsaJsonRpc_handleRequest(nullptr, epId, metadata, &request, &reply));
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, rsaRpc_handleRequest(nullptr, epId, metadata, &request, &reply));
 
-    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, celix_rsaJsonRpc_handleRequest(jsonRpc.get(), epId, nullptr, &request, &reply));
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, rsaRpc_handleRequest(jsonRpc.get(), epId, nullptr, &request, &reply));
 
-    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, celix_rsaJsonRpc_handleRequest(jsonRpc.get(), epId, metadata, nullptr, &reply));
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, rsaRpc_handleRequest(jsonRpc.get(), epId, metadata, nullptr, &reply));
 
-    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, celix_rsaJsonRpc_handleRequest(jsonRpc.get(), epId, metadata, &request, nullptr));
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, rsaRpc_handleRequest(jsonRpc.get(), epId, metadata, &request, nullptr));
 
-    EXPECT_EQ(CELIX_ILLEGAL_STATE, celix_rsaJsonRpc_handleRequest(jsonRpc.get(), 10000/*non-existing epId*/, metadata, &request, &reply));
+    EXPECT_EQ(CELIX_ILLEGAL_STATE, rsaRpc_handleRequest(jsonRpc.get(), 10000/*non-existing epId*/, metadata, &request, &reply));
 
     request.iov_base =  (char *)"{\"a\": []}";// lost method node
     request.iov_len = strlen((char*)request.iov_base);
-    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, celix_rsaJsonRpc_handleRequest(jsonRpc.get(), epId, metadata, &request, &reply));
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, rsaRpc_handleRequest(jsonRpc.get(), epId, metadata, &request, &reply));
 
     request.iov_base =  (char *)"invalid";
     request.iov_len = strlen((char*)request.iov_base);
-    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, celix_rsaJsonRpc_handleRequest(jsonRpc.get(), epId, metadata, &request, &reply));
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, rsaRpc_handleRequest(jsonRpc.get(), epId, metadata, &request, &reply));
 
     celix_properties_setLong(metadata, "SerialProtocolId", 1);
-    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, celix_rsaJsonRpc_handleRequest(jsonRpc.get(), epId, metadata, &request, &reply));
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, rsaRpc_handleRequest(jsonRpc.get(), epId, metadata, &request, &reply));
 
     celix_properties_destroy(metadata);
 
-    rsaJsonRpc_destroyEndpoint(jsonRpc.get(), epId);
+    rsaRpc_destroyEndpoint(jsonRpc.get(), epId);
     endpointDescription_destroy(endpoint);
 }
 
@@ -835,7 +928,7 @@ TEST_F(RsaJsonRpcEndPointUnitTestSuite, ServiceInvocationIsIntercepted) {
     auto endpoint = CreateEndpointDescription(rpcTestSvcId);
     celix_properties_unset(endpoint->properties, CELIX_FRAMEWORK_SERVICE_VERSION);
     long epId = -1L;
-    auto status = rsaJsonRpc_createEndpoint(jsonRpc.get(), endpoint, &epId);
+    auto status = rsaRpc_createEndpoint(jsonRpc.get(), endpoint, &epId);
     EXPECT_EQ(CELIX_SUCCESS, status);
     celix_bundleContext_waitForEvents(ctx.get());//wait for async endpoint creation
 
@@ -869,7 +962,7 @@ TEST_F(RsaJsonRpcEndPointUnitTestSuite, ServiceInvocationIsIntercepted) {
     request.iov_base =  (char *)"{\n    \"m\": \"test\",\n    \"a\": []\n}";
     request.iov_len = strlen((char*)request.iov_base);
     struct iovec reply{nullptr,0};
-    EXPECT_EQ(CELIX_INTERCEPTOR_EXCEPTION, celix_rsaJsonRpc_handleRequest(jsonRpc.get(), epId, metadata, &request, &reply));
+    EXPECT_EQ(CELIX_INTERCEPTOR_EXCEPTION, rsaRpc_handleRequest(jsonRpc.get(), epId, metadata, &request, &reply));
     free(reply.iov_base);
 
     celix_properties_destroy(metadata);
@@ -877,14 +970,14 @@ TEST_F(RsaJsonRpcEndPointUnitTestSuite, ServiceInvocationIsIntercepted) {
 
     celix_bundleContext_unregisterServiceAsync(ctx.get(), interceptorSvcId, nullptr, nullptr);
 
-    rsaJsonRpc_destroyEndpoint(jsonRpc.get(), epId);
+    rsaRpc_destroyEndpoint(jsonRpc.get(), epId);
     endpointDescription_destroy(endpoint);
 }
 
 TEST_F(RsaJsonRpcEndPointUnitTestSuite, JsonRpcCallFailed) {
     auto endpoint = CreateEndpointDescription(rpcTestSvcId);
     long epId = -1L;
-    auto status = rsaJsonRpc_createEndpoint(jsonRpc.get(), endpoint, &epId);
+    auto status = rsaRpc_createEndpoint(jsonRpc.get(), endpoint, &epId);
     EXPECT_EQ(CELIX_SUCCESS, status);
 
     celix_bundleContext_waitForEvents(ctx.get());//wait for async endpoint creation
@@ -893,15 +986,15 @@ TEST_F(RsaJsonRpcEndPointUnitTestSuite, JsonRpcCallFailed) {
     celix_properties_t *metadata = celix_properties_create();
     celix_properties_setLong(metadata, "SerialProtocolId", serialProtoId);
 
-    celix_ei_expect_jsonRpc_call(CELIX_EI_UNKNOWN_CALLER, 0, -1);
+    celix_ei_expect_jsonRpc_callWithJson(CELIX_EI_UNKNOWN_CALLER, 0, -1);
     struct iovec request{};
     request.iov_base =  (char *)"{\n    \"m\": \"test\",\n    \"a\": []\n}";
     request.iov_len = strlen((char*)request.iov_base);
     struct iovec reply{nullptr,0};
-    EXPECT_EQ(CELIX_SERVICE_EXCEPTION, celix_rsaJsonRpc_handleRequest(jsonRpc.get(), epId, metadata, &request, &reply));
+    EXPECT_EQ(CELIX_SERVICE_EXCEPTION, rsaRpc_handleRequest(jsonRpc.get(), epId, metadata, &request, &reply));
 
     celix_properties_destroy(metadata);
 
-    rsaJsonRpc_destroyEndpoint(jsonRpc.get(), epId);
+    rsaRpc_destroyEndpoint(jsonRpc.get(), epId);
     endpointDescription_destroy(endpoint);
 }
@@ -25,9 +25,21 @@ extern "C" {
 #endif
 
 #define RSA_JSON_RPC_LOG_CALLS_KEY               "RSA_JSON_RPC_LOG_CALLS"
-#define RSA_JSON_RPC_LOG_CALLS_DEFAULT           false
 #define RSA_JSON_RPC_LOG_CALLS_FILE_KEY          "RSA_JSON_RPC_LOG_CALLS_FILE"
-#define RSA_JSON_RPC_LOG_CALLS_FILE_DEFAULT      "stdout"
+
+/**
+ * @brief The rpc type of the json rpc factory service, see CELIX_RSA_RPC_TYPE_KEY.
+ */
+#define RSA_JSON_RPC_TYPE                        "celix.remote.admin.rpc_type.json"
+
+/**
+ * @brief Endpoint property to announce that the endpoint accepts requests which identify the method by its index in
+ * the interface descriptor, instead of by its signature.
+ *
+ * The property is set as exported service property by the service provider. A proxy only uses the method index
+ * if the property is true and its interface descriptor has the same version as the exported service.
+ */
+#define RSA_JSON_RPC_METHOD_INDEX_KEY            "celix.remote.admin.json_rpc.method_index"
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,104 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "rsa_json_rpc_serializer.h"
+#include "rsa_json_rpc_constants.h"
+#include "json_rpc.h"
+#include "celix_cleanup.h"
+#include "celix_err.h"
+#include <jansson.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int rsaJsonRpc_prepareInvokeRequest(const dyn_function_type* func, const char* id, int index, void* args[],
+                                           void** request, size_t* requestSize) {
+    char* invokeRequest = NULL;
+    int rc = index >= 0 ?
+             jsonRpc_prepareInvokeRequestWithIndex(func, index, args, &invokeRequest) :
+             jsonRpc_prepareInvokeRequest(func, id, args, &invokeRequest);
+    if (rc != 0) {
+        return rc;
+    }
+    *request = invokeRequest;
+    *requestSize = strlen(invokeRequest) + 1;// make it include '\0'
+    return 0;
+}
+
+static int rsaJsonRpc_handleReply(const dyn_function_type* func, const void* reply, size_t replySize, void* args[],
+                                  int* rsErrno) {
+    (void)replySize;
+    return jsonRpc_handleReply(func, (const char*)reply, args, rsErrno);
+}
+
+static int rsaJsonRpc_parseRequest(const struct iovec* request, void** parsedRequest, const char** method,
+                                   int* methodIndex) {
+    json_error_t error;
+    json_auto_t* jsRequest = json_loads((char*)request->iov_base, 0, &error);
+    if (jsRequest == NULL) {
+        celix_err_pushf("Parse request json string failed. %s", error.text);
+        return 1;
+    }
+    json_t* jsMethod = json_object_get(jsRequest, "m");
+    const char* sig = json_string_value(jsMethod);
+    int index = -1;
+    if (json_is_integer(jsMethod)) {
+        json_int_t value = json_integer_value(jsMethod);
+        index = (value >= 0 && value <= INT_MAX) ? (int)value : -1;
+    }
+    if (sig == NULL && index < 0) {
+        celix_err_push("Requested method not found.");
+        return 1;
+    }
+    *method = sig;
+    *methodIndex = index;
+    *parsedRequest = celix_steal_ptr(jsRequest);
+    return 0;
+}
+
+static int rsaJsonRpc_call(const dyn_interface_type* intf, void* service, const struct iovec* request,
+                           void* parsedRequest, struct iovec* response) {
+    (void)request;
+    char* szResponse = NULL;
+    int rc = jsonRpc_callWithJson(intf, service, (const json_t*)parsedRequest, &szResponse);
+    if (szResponse != NULL) {
+        response->iov_base = szResponse;
+        response->iov_len = strlen(szResponse) + 1;// make it include '\0'
+    }
+    return rc;
+}
+
+static void rsaJsonRpc_freeRequest(void* parsedRequest) {
+    json_decref((json_t*)parsedRequest);
+}
+
+const rsa_rpc_serializer_t rsaJsonRpc_serializer = {
+    .name = "rsa_json_rpc",
+    .rpcType = RSA_JSON_RPC_TYPE,
+    .logCallsKey = RSA_JSON_RPC_LOG_CALLS_KEY,
+    .logCallsFileKey = RSA_JSON_RPC_LOG_CALLS_FILE_KEY,
+    .textPayload = true,
+    .sameVersionRequired = false,
+    .methodIndexKey = RSA_JSON_RPC_METHOD_INDEX_KEY,
+    .prepareInvokeRequest = rsaJsonRpc_prepareInvokeRequest,
+    .handleReply = rsaJsonRpc_handleReply,
+    .parseRequest = rsaJsonRpc_parseRequest,
+    .call = rsaJsonRpc_call,
+    .freeRequest = rsaJsonRpc_freeRequest,
+};
@@ -17,20 +17,21 @@
  * under the License.
  */
 
-#ifndef CELIX_THPOOL_EI_H
-#define CELIX_THPOOL_EI_H
+#ifndef _RSA_JSON_RPC_SERIALIZER_H_
+#define _RSA_JSON_RPC_SERIALIZER_H_
+
 #ifdef __cplusplus
 extern "C" {
 #endif
-#include "celix_error_injector.h"
-#include "thpool.h"
-
-CELIX_EI_DECLARE(thpool_init, struct thpool_*);
+#include "rsa_rpc_serializer.h"
 
-CELIX_EI_DECLARE(thpool_add_work, int);
+/**
+ * @brief The JSON-RPC serialization of the remote calls, see json_rpc.h.
+ */
+extern const rsa_rpc_serializer_t rsaJsonRpc_serializer;
 
 #ifdef __cplusplus
 }
 #endif
 
-#endif //CELIX_THPOOL_EI_H
+#endif /* _RSA_JSON_RPC_SERIALIZER_H_ */
@@ -25,6 +25,15 @@
 #define CELIX_RSA_REMOTE_INTERCEPTOR_SERVICE_NAME "remote.interceptor"
 #define CELIX_RSA_REMOTE_INTERCEPTOR_SERVICE_VERSION "1.0.0"
 
+/**
+ * @brief Optional boolean service property of a remote interceptor, declaring whether the interceptor uses the
+ * metadata of a call. Defaults to true.
+ *
+ * If none of the registered interceptors uses metadata, no metadata is created for a call and interceptors
+ * may be called with a NULL metadata argument.
+ */
+#define CELIX_RSA_REMOTE_INTERCEPTOR_USES_METADATA "remote.interceptor.uses.metadata"
+
 typedef struct remote_interceptor {
     void *handle;
 
@@ -163,6 +163,57 @@ function(celix_target_hide_symbols)
     endif ()
 endfunction()
 
+#[[
+Generate C stubs for DFI interface descriptors and add them to the sources of a target.
+
+```CMake
+celix_target_dfi_stubs(<cmake_target>
+    DESCRIPTORS descriptor1 descriptor2 ...
+)
+```
+
+For every descriptor `<name>.descriptor` the celix_dfi_stub_generator generates a `<name>_stubs.h` and
+`<name>_stubs.c` in the binary dir of the target. The header declares a `<interface_name>_stubs` variable (with
+non-alphanumeric characters replaced by `_`), which can be set on a parsed interface using `dynInterface_setStubs`
+so that calls and proxies of that interface no longer go through libffi.
+
+The target must link against Celix::dfi.
+
+Example:
+```CMake
+celix_target_dfi_stubs(my_bundle DESCRIPTORS ${CMAKE_CURRENT_SOURCE_DIR}/descriptors/calculator.descriptor)
+```
+]]
+function(celix_target_dfi_stubs)
+    list(GET ARGN 0 TARGET_NAME)
+    list(REMOVE_AT ARGN 0)
+
+    set(OPTIONS )
+    set(ONE_VAL_ARGS )
+    set(MULTI_VAL_ARGS DESCRIPTORS)
+    cmake_parse_arguments(DFI_STUBS "${OPTIONS}" "${ONE_VAL_ARGS}" "${MULTI_VAL_ARGS}" ${ARGN})
+
+    if (NOT DFI_STUBS_DESCRIPTORS)
+        message(FATAL_ERROR "Missing required DESCRIPTORS argument")
+    endif ()
+
+    set(STUBS_DIR "${CMAKE_CURRENT_BINARY_DIR}/${TARGET_NAME}_dfi_stubs")
+    foreach(DESCRIPTOR IN LISTS DFI_STUBS_DESCRIPTORS)
+        get_filename_component(DESCRIPTOR_PATH ${DESCRIPTOR} ABSOLUTE)
+        get_filename_component(DESCRIPTOR_NAME ${DESCRIPTOR} NAME_WE)
+        set(STUBS_HEADER "${STUBS_DIR}/${DESCRIPTOR_NAME}_stubs.h")
+        set(STUBS_SOURCE "${STUBS_DIR}/${DESCRIPTOR_NAME}_stubs.c")
+        add_custom_command(OUTPUT ${STUBS_HEADER} ${STUBS_SOURCE}
+                COMMAND ${CMAKE_COMMAND} -E make_directory ${STUBS_DIR}
+                COMMAND Celix::dfi_stub_generator ${DESCRIPTOR_PATH} ${STUBS_HEADER} ${STUBS_SOURCE}
+                DEPENDS ${DESCRIPTOR_PATH} Celix::dfi_stub_generator
+                COMMENT "Generating DFI stubs for ${DESCRIPTOR_NAME}"
+        )
+        target_sources(${TARGET_NAME} PRIVATE ${STUBS_SOURCE})
+    endforeach()
+    target_include_directories(${TARGET_NAME} PRIVATE ${STUBS_DIR})
+endfunction()
+
 #[[
 Internal function that converts a property string to a JSON field entry.
 The result is stored in the OUTPUT_VAR_NAME variable.
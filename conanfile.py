@@ -65,6 +65,7 @@ class CelixConan(ConanFile):
         "build_rsa_discovery_etcd": False,
         "build_rsa_remote_service_admin_shm_v2": False,
         "build_rsa_json_rpc": False,
+        "build_rsa_binary_rpc": False,
         "build_rsa_discovery_zeroconf": False,
         "build_shell": False,
         "build_shell_api": False,
@@ -288,7 +289,7 @@ class CelixConan(ConanFile):
 
         if options["build_rsa_discovery_common"] or options["build_rsa_discovery_zeroconf"] \
                 or options["build_rsa_remote_service_admin_dfi"] or options["build_rsa_json_rpc"] \
-                or options["build_rsa_remote_service_admin_shm_v2"]:
+                or options["build_rsa_binary_rpc"] or options["build_rsa_remote_service_admin_shm_v2"]:
             options["build_remote_service_admin"] = True
 
         if options["build_remote_service_admin"]:
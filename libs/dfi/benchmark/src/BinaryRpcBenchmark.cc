@@ -0,0 +1,261 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "binary_rpc.h"
+#include "dyn_interface.h"
+#include "json_rpc.h"
+
+/**
+ * Compares the JSON-RPC encoding with the binary RPC encoding for typical interfaces.
+ * Every iteration is a complete remote call without transport: the proxy prepares the request, the endpoint calls
+ * the service and the proxy handles the reply.
+ */
+class BinaryRpcBenchmark {
+public:
+    struct point {
+        double x;
+        double y;
+        double z;
+    };
+
+    struct double_seq {
+        uint32_t cap;
+        uint32_t len;
+        double* buf;
+    };
+
+    struct point_seq {
+        uint32_t cap;
+        uint32_t len;
+        point* buf;
+    };
+
+    struct calculator_service {
+        void* handle;
+        int (*add)(void* handle, double a, double b, double* out);
+        int (*sum)(void* handle, struct double_seq input, double* out);
+        int (*centroid)(void* handle, struct point_seq input, struct point** out);
+    };
+
+    explicit BinaryRpcBenchmark(benchmark::State& state) {
+        static const char descriptor[] = ":header\n"
+                                         "type=interface\n"
+                                         "name=calculator\n"
+                                         "version=1.0.0\n"
+                                         ":annotations\n"
+                                         ":types\n"
+                                         "Point={DDD x y z}\n"
+                                         ":methods\n"
+                                         "add(DD)D=add(#am=handle;PDD#am=pre;*D)N\n"
+                                         "sum([D)D=sum(#am=handle;P[D#am=pre;*D)N\n"
+                                         "centroid=centroid(#am=handle;P[{DDD x y z}#am=out;*LPoint;)N\n";
+        FILE* stream = fmemopen((void*)descriptor, sizeof(descriptor) - 1, "r");
+        if (stream == nullptr || dynInterface_parse(stream, &intf) != 0) {
+            std::cerr << "ERROR: cannot parse interface descriptor" << std::endl;
+        }
+        if (stream != nullptr) {
+            fclose(stream);
+        }
+
+        auto len = (uint32_t)state.range(0);
+        doubles.cap = doubles.len = len;
+        doubles.buf = new double[len];
+        points.cap = points.len = len;
+        points.buf = new point[len];
+        for (uint32_t i = 0; i < len; ++i) {
+            doubles.buf[i] = (double)i + 0.5;
+            points.buf[i] = {(double)i + 0.25, (double)i + 0.5, (double)i + 0.75};
+        }
+    }
+
+    ~BinaryRpcBenchmark() {
+        delete[] doubles.buf;
+        delete[] points.buf;
+        dynInterface_destroy(intf);
+    }
+
+    BinaryRpcBenchmark(const BinaryRpcBenchmark&) = delete;
+    BinaryRpcBenchmark& operator=(const BinaryRpcBenchmark&) = delete;
+
+    static int add(void* /*handle*/, double a, double b, double* out) {
+        *out = a + b;
+        return 0;
+    }
+
+    static int sum(void* /*handle*/, struct double_seq input, double* out) {
+        double total = 0.0;
+        for (uint32_t i = 0; i < input.len; ++i) {
+            total += input.buf[i];
+        }
+        *out = total;
+        return 0;
+    }
+
+    static int centroid(void* /*handle*/, struct point_seq input, struct point** out) {
+        point total{0.0, 0.0, 0.0};
+        for (uint32_t i = 0; i < input.len; ++i) {
+            total.x += input.buf[i].x;
+            total.y += input.buf[i].y;
+            total.z += input.buf[i].z;
+        }
+        double n = input.len > 0 ? (double)input.len : 1.0;
+        *out = (point*)malloc(sizeof(point));
+        if (*out == nullptr) {
+            return 1;
+        }
+        **out = {total.x / n, total.y / n, total.z / n};
+        return 0;
+    }
+
+    /**
+     * A JSON-RPC call using the method index, which is the best case for JSON-RPC.
+     */
+    size_t jsonCall(const char* sig, void* args[]) {
+        const struct method_entry* method = dynInterface_findMethod(intf, sig);
+        char* request = nullptr;
+        char* reply = nullptr;
+        int rsErrno = 0;
+        int rc = jsonRpc_prepareInvokeRequestWithIndex(method->dynFunc, method->index, args, &request);
+        rc = rc == 0 ? jsonRpc_call(intf, &svc, request, &reply) : rc;
+        rc = rc == 0 ? jsonRpc_handleReply(method->dynFunc, reply, args, &rsErrno) : rc;
+        if (rc != 0 || rsErrno != 0) {
+            std::cerr << "ERROR: json rpc call of " << sig << " failed" << std::endl;
+        }
+        size_t bytes = (request != nullptr ? strlen(request) : 0) + (reply != nullptr ? strlen(reply) : 0);
+        free(request);
+        free(reply);
+        return bytes;
+    }
+
+    size_t binaryCall(const char* sig, void* args[]) {
+        const struct method_entry* method = dynInterface_findMethod(intf, sig);
+        void* request = nullptr;
+        size_t requestSize = 0;
+        void* reply = nullptr;
+        size_t replySize = 0;
+        int rsErrno = 0;
+        int rc = binaryRpc_prepareInvokeRequest(method->dynFunc, method->index, args, &request, &requestSize);
+        rc = rc == 0 ? binaryRpc_call(intf, &svc, request, requestSize, &reply, &replySize) : rc;
+        rc = rc == 0 ? binaryRpc_handleReply(method->dynFunc, reply, replySize, args, &rsErrno) : rc;
+        if (rc != 0 || rsErrno != 0) {
+            std::cerr << "ERROR: binary rpc call of " << sig << " failed" << std::endl;
+        }
+        free(request);
+        free(reply);
+        return requestSize + replySize;
+    }
+
+    dyn_interface_type* intf{nullptr};
+    calculator_service svc{nullptr, add, sum, centroid};
+    double_seq doubles{0, 0, nullptr};
+    point_seq points{0, 0, nullptr};
+};
+
+static void BinaryRpcBenchmark_add(benchmark::State& state, bool binary) {
+    BinaryRpcBenchmark benchmark{state};
+    double a = 1.5;
+    double b = 2.5;
+    double result = 0.0;
+    double* out = &result;
+    void* args[] = {nullptr, &a, &b, &out};
+    size_t bytes = 0;
+    for (auto _ : state) {
+        // This code gets timed
+        bytes += binary ? benchmark.binaryCall("add(DD)D", args) : benchmark.jsonCall("add(DD)D", args);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed((int64_t)bytes);
+}
+
+static void BinaryRpcBenchmark_sum(benchmark::State& state, bool binary) {
+    BinaryRpcBenchmark benchmark{state};
+    double result = 0.0;
+    double* out = &result;
+    void* args[] = {nullptr, &benchmark.doubles, &out};
+    size_t bytes = 0;
+    for (auto _ : state) {
+        // This code gets timed
+        bytes += binary ? benchmark.binaryCall("sum([D)D", args) : benchmark.jsonCall("sum([D)D", args);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed((int64_t)bytes);
+}
+
+static void BinaryRpcBenchmark_centroid(benchmark::State& state, bool binary) {
+    BinaryRpcBenchmark benchmark{state};
+    BinaryRpcBenchmark::point* result = nullptr;
+    void* out = &result;
+    void* args[] = {nullptr, &benchmark.points, &out};
+    const char* sig = "centroid";
+    size_t bytes = 0;
+    for (auto _ : state) {
+        // This code gets timed
+        bytes += binary ? benchmark.binaryCall(sig, args) : benchmark.jsonCall(sig, args);
+        benchmark::DoNotOptimize(result);
+        free(result);
+        result = nullptr;
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed((int64_t)bytes);
+}
+
+static void BinaryRpcBenchmark_jsonAdd(benchmark::State& state) {
+    BinaryRpcBenchmark_add(state, false);
+}
+
+static void BinaryRpcBenchmark_binaryAdd(benchmark::State& state) {
+    BinaryRpcBenchmark_add(state, true);
+}
+
+static void BinaryRpcBenchmark_jsonSum(benchmark::State& state) {
+    BinaryRpcBenchmark_sum(state, false);
+}
+
+static void BinaryRpcBenchmark_binarySum(benchmark::State& state) {
+    BinaryRpcBenchmark_sum(state, true);
+}
+
+static void BinaryRpcBenchmark_jsonCentroid(benchmark::State& state) {
+    BinaryRpcBenchmark_centroid(state, false);
+}
+
+static void BinaryRpcBenchmark_binaryCentroid(benchmark::State& state) {
+    BinaryRpcBenchmark_centroid(state, true);
+}
+
+#define CELIX_BENCHMARK(name) \
+    BENCHMARK(name)->MeasureProcessCPUTime()->UseRealTime()->Unit(benchmark::kNanosecond) \
+        ->Arg(1)->Arg(16)->Arg(1024)
+
+//The add benchmarks do not use the sequence length argument
+BENCHMARK(BinaryRpcBenchmark_jsonAdd)->MeasureProcessCPUTime()->UseRealTime()->Unit(benchmark::kNanosecond)->Arg(0);
+BENCHMARK(BinaryRpcBenchmark_binaryAdd)->MeasureProcessCPUTime()->UseRealTime()->Unit(benchmark::kNanosecond)->Arg(0);
+CELIX_BENCHMARK(BinaryRpcBenchmark_jsonSum);
+CELIX_BENCHMARK(BinaryRpcBenchmark_binarySum);
+CELIX_BENCHMARK(BinaryRpcBenchmark_jsonCentroid);
+CELIX_BENCHMARK(BinaryRpcBenchmark_binaryCentroid);
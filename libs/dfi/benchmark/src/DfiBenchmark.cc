@@ -0,0 +1,390 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <ffi.h>
+#include <string>
+
+#include "dyn_interface.h"
+#include "dyn_type.h"
+#include "json_rpc.h"
+#include "json_serializer.h"
+
+/**
+ * The dfi benchmark suite: serialize, deserialize, prepare request, call and handle reply, as well as the plain libffi
+ * call and closure, for the typical payloads of a remote service call:
+ *  - Scalar: two doubles in, a double out.
+ *  - Nested: a struct with nested structs in and out.
+ *  - Sequence: a sequence of state.range(0) doubles in, a double out.
+ *  - String: a string of state.range(0) characters in, a copy out.
+ *
+ * The (de)serialize benchmarks use the type of the first input argument of the method.
+ */
+class DfiBenchmark {
+public:
+    enum class Payload { Scalar, Nested, Sequence, String };
+
+    struct point {
+        double x;
+        double y;
+        double z;
+    };
+
+    struct sample {
+        int64_t timestamp;
+        point position;
+        point velocity;
+        int32_t quality;
+    };
+
+    struct double_seq {
+        uint32_t cap;
+        uint32_t len;
+        double* buf;
+    };
+
+    struct benchmark_service {
+        void* handle;
+        int (*add)(void* handle, double a, double b, double* out);
+        int (*move)(void* handle, sample input, sample* out);
+        int (*sum)(void* handle, double_seq input, double* out);
+        int (*echo)(void* handle, const char* input, char** out);
+    };
+
+    DfiBenchmark(benchmark::State& state, Payload payload) : payload{payload} {
+        static const char descriptor[] = ":header\n"
+                                         "type=interface\n"
+                                         "name=dfi_benchmark\n"
+                                         "version=1.0.0\n"
+                                         ":annotations\n"
+                                         ":types\n"
+                                         "Point={DDD x y z}\n"
+                                         "Sample={JlPoint;lPoint;I timestamp position velocity quality}\n"
+                                         ":methods\n"
+                                         "add=add(#am=handle;PDD#am=pre;*D)N\n"
+                                         "move=move(#am=handle;PlSample;#am=pre;LSample;)N\n"
+                                         "sum=sum(#am=handle;P[D#am=pre;*D)N\n"
+                                         "echo=echo(#am=handle;P#const=true;t#am=out;*t)N\n";
+        FILE* stream = fmemopen((void*)descriptor, sizeof(descriptor) - 1, "r");
+        if (stream == nullptr || dynInterface_parse(stream, &intf) != 0) {
+            state.SkipWithError("Cannot parse interface descriptor");
+        }
+        if (stream != nullptr) {
+            fclose(stream);
+        }
+        if (intf == nullptr) {
+            return;
+        }
+
+        auto len = (uint32_t)state.range(0);
+        switch (payload) {
+            case Payload::Scalar:
+                method = dynInterface_findMethod(intf, "add");
+                args[1] = &a;
+                args[2] = &b;
+                args[3] = &scalarOutPtr;
+                break;
+            case Payload::Nested:
+                method = dynInterface_findMethod(intf, "move");
+                args[1] = &nested;
+                args[2] = &nestedOutPtr;
+                break;
+            case Payload::Sequence:
+                method = dynInterface_findMethod(intf, "sum");
+                doubles.cap = doubles.len = len;
+                doubles.buf = new double[len];
+                for (uint32_t i = 0; i < len; ++i) {
+                    doubles.buf[i] = (double)i + 0.5;
+                }
+                args[1] = &doubles;
+                args[2] = &scalarOutPtr;
+                break;
+            case Payload::String:
+                method = dynInterface_findMethod(intf, "echo");
+                text = std::string(len, 'x');
+                textPtr = text.c_str();
+                args[1] = &textPtr;
+                args[2] = &textOutPtr;
+                break;
+        }
+        inputType = dynFunction_argumentTypeForIndex(method->dynFunc, 1);
+
+        char* str = nullptr;
+        if (jsonSerializer_serialize(inputType, args[1], &str) != 0) {
+            state.SkipWithError("Cannot serialize input");
+        } else {
+            serialized = str;
+            free(str);
+        }
+        if (jsonRpc_prepareInvokeRequest(method->dynFunc, dynFunction_getName(method->dynFunc), args, &str) != 0) {
+            state.SkipWithError("Cannot prepare request");
+        } else {
+            request = str;
+            free(str);
+        }
+        if (jsonRpc_call(intf, &svc, request.c_str(), &str) != 0) {
+            state.SkipWithError("Cannot call service");
+        } else {
+            reply = str;
+            free(str);
+        }
+    }
+
+    ~DfiBenchmark() {
+        delete[] doubles.buf;
+        dynInterface_destroy(intf);
+    }
+
+    DfiBenchmark(const DfiBenchmark&) = delete;
+    DfiBenchmark& operator=(const DfiBenchmark&) = delete;
+
+    static int add(void* /*handle*/, double a, double b, double* out) {
+        *out = a + b;
+        return 0;
+    }
+
+    static int move(void* /*handle*/, sample input, sample* out) {
+        *out = input;
+        out->timestamp += 1;
+        out->position.x += input.velocity.x;
+        out->position.y += input.velocity.y;
+        out->position.z += input.velocity.z;
+        return 0;
+    }
+
+    static int sum(void* /*handle*/, double_seq input, double* out) {
+        double total = 0.0;
+        for (uint32_t i = 0; i < input.len; ++i) {
+            total += input.buf[i];
+        }
+        *out = total;
+        return 0;
+    }
+
+    static int echo(void* /*handle*/, const char* input, char** out) {
+        *out = strdup(input);
+        return *out != nullptr ? 0 : 1;
+    }
+
+    static void bind(void* /*userData*/, void* /*args*/[], void* returnValue) {
+        *(ffi_arg*)returnValue = 0;
+    }
+
+    /**
+     * Calls the service function of the payload method through dynFunction_call.
+     */
+    int call() {
+        void (*fn)(void) = nullptr;
+        switch (payload) {
+            case Payload::Scalar:
+                fn = (void (*)(void))add;
+                break;
+            case Payload::Nested:
+                fn = (void (*)(void))move;
+                break;
+            case Payload::Sequence:
+                fn = (void (*)(void))sum;
+                break;
+            case Payload::String:
+                fn = (void (*)(void))echo;
+                break;
+        }
+        ffi_sarg rc = 1;
+        dynFunction_call(method->dynFunc, fn, &rc, args);
+        releaseOutput();
+        return (int)rc;
+    }
+
+    /**
+     * Calls the payload method through a closure bound to a no-op, i.e. the proxy side overhead of libffi.
+     */
+    int callClosure(void (*fn)(void)) {
+        int rc = 1;
+        switch (payload) {
+            case Payload::Scalar:
+                rc = ((int (*)(void*, double, double, double*))fn)(nullptr, a, b, scalarOutPtr);
+                break;
+            case Payload::Nested:
+                rc = ((int (*)(void*, sample, sample*))fn)(nullptr, nested, nestedOutPtr);
+                break;
+            case Payload::Sequence:
+                rc = ((int (*)(void*, double_seq, double*))fn)(nullptr, doubles, scalarOutPtr);
+                break;
+            case Payload::String:
+                rc = ((int (*)(void*, const char*, char**))fn)(nullptr, textPtr, textOutPtr);
+                break;
+        }
+        return rc;
+    }
+
+    /**
+     * Releases the output allocated by a call or handle reply, only the string payload has allocated output.
+     */
+    void releaseOutput() {
+        free(textOut);
+        textOut = nullptr;
+    }
+
+    Payload payload;
+    dyn_interface_type* intf{nullptr};
+    const struct method_entry* method{nullptr};
+    const dyn_type* inputType{nullptr};
+    benchmark_service svc{nullptr, add, move, sum, echo};
+
+    void* handle{nullptr};
+    void* args[4]{&handle, nullptr, nullptr, nullptr};
+    double a{1.5};
+    double b{2.5};
+    double scalarOut{0.0};
+    double* scalarOutPtr{&scalarOut};
+    sample nested{1234567890, {1.0, 2.0, 3.0}, {0.1, 0.2, 0.3}, 42};
+    sample nestedOut{};
+    sample* nestedOutPtr{&nestedOut};
+    double_seq doubles{0, 0, nullptr};
+    std::string text{};
+    const char* textPtr{nullptr};
+    char* textOut{nullptr};
+    char** textOutPtr{&textOut};
+
+    std::string serialized{};
+    std::string request{};
+    std::string reply{};
+};
+
+static void DfiBenchmark_serialize(benchmark::State& state, DfiBenchmark::Payload payload) {
+    DfiBenchmark benchmark{state, payload};
+    for (auto _ : state) {
+        // This code gets timed
+        char* result = nullptr;
+        int rc = jsonSerializer_serialize(benchmark.inputType, benchmark.args[1], &result);
+        benchmark::DoNotOptimize(rc);
+        free(result);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * (int64_t)benchmark.serialized.size());
+}
+
+static void DfiBenchmark_deserialize(benchmark::State& state, DfiBenchmark::Payload payload) {
+    DfiBenchmark benchmark{state, payload};
+    for (auto _ : state) {
+        // This code gets timed
+        void* result = nullptr;
+        int rc = jsonSerializer_deserialize(benchmark.inputType, benchmark.serialized.c_str(),
+                                            benchmark.serialized.size(), &result);
+        benchmark::DoNotOptimize(rc);
+        dynType_free(benchmark.inputType, result);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * (int64_t)benchmark.serialized.size());
+}
+
+static void DfiBenchmark_prepareRequest(benchmark::State& state, DfiBenchmark::Payload payload) {
+    DfiBenchmark benchmark{state, payload};
+    const char* id = dynFunction_getName(benchmark.method->dynFunc);
+    for (auto _ : state) {
+        // This code gets timed
+        char* request = nullptr;
+        int rc = jsonRpc_prepareInvokeRequest(benchmark.method->dynFunc, id, benchmark.args, &request);
+        benchmark::DoNotOptimize(rc);
+        free(request);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * (int64_t)benchmark.request.size());
+}
+
+static void DfiBenchmark_call(benchmark::State& state, DfiBenchmark::Payload payload) {
+    DfiBenchmark benchmark{state, payload};
+    for (auto _ : state) {
+        // This code gets timed
+        char* reply = nullptr;
+        int rc = jsonRpc_call(benchmark.intf, &benchmark.svc, benchmark.request.c_str(), &reply);
+        benchmark::DoNotOptimize(rc);
+        free(reply);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * (int64_t)benchmark.request.size());
+}
+
+static void DfiBenchmark_handleReply(benchmark::State& state, DfiBenchmark::Payload payload) {
+    DfiBenchmark benchmark{state, payload};
+    for (auto _ : state) {
+        // This code gets timed
+        int rsErrno = 0;
+        int rc = jsonRpc_handleReply(benchmark.method->dynFunc, benchmark.reply.c_str(), benchmark.args, &rsErrno);
+        benchmark::DoNotOptimize(rc);
+        benchmark.releaseOutput();
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * (int64_t)benchmark.reply.size());
+}
+
+static void DfiBenchmark_ffiCall(benchmark::State& state, DfiBenchmark::Payload payload) {
+    DfiBenchmark benchmark{state, payload};
+    for (auto _ : state) {
+        // This code gets timed
+        benchmark::DoNotOptimize(benchmark.call());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void DfiBenchmark_ffiClosure(benchmark::State& state, DfiBenchmark::Payload payload) {
+    DfiBenchmark benchmark{state, payload};
+    void (*fn)(void) = nullptr;
+    if (dynFunction_createClosure(benchmark.method->dynFunc, DfiBenchmark::bind, nullptr, &fn) != 0) {
+        state.SkipWithError("Cannot create closure");
+        return;
+    }
+    for (auto _ : state) {
+        // This code gets timed
+        benchmark::DoNotOptimize(benchmark.callClosure(fn));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+#define CELIX_DFI_BENCHMARK(operation, payload) \
+    static void DfiBenchmark_##operation##payload(benchmark::State& state) { \
+        DfiBenchmark_##operation(state, DfiBenchmark::Payload::payload); \
+    }
+
+#define CELIX_DFI_BENCHMARKS(operation) \
+    CELIX_DFI_BENCHMARK(operation, Scalar) \
+    CELIX_DFI_BENCHMARK(operation, Nested) \
+    CELIX_DFI_BENCHMARK(operation, Sequence) \
+    CELIX_DFI_BENCHMARK(operation, String) \
+    BENCHMARK(DfiBenchmark_##operation##Scalar)->MeasureProcessCPUTime()->UseRealTime() \
+        ->Unit(benchmark::kNanosecond)->Arg(1); \
+    BENCHMARK(DfiBenchmark_##operation##Nested)->MeasureProcessCPUTime()->UseRealTime() \
+        ->Unit(benchmark::kNanosecond)->Arg(1); \
+    BENCHMARK(DfiBenchmark_##operation##Sequence)->MeasureProcessCPUTime()->UseRealTime() \
+        ->Unit(benchmark::kNanosecond)->Arg(1)->Arg(16)->Arg(1024)->Arg(100000); \
+    BENCHMARK(DfiBenchmark_##operation##String)->MeasureProcessCPUTime()->UseRealTime() \
+        ->Unit(benchmark::kNanosecond)->Arg(1)->Arg(16)->Arg(1024)->Arg(100000)
+
+//The scalar and nested payloads do not use the size argument
+CELIX_DFI_BENCHMARKS(serialize);
+CELIX_DFI_BENCHMARKS(deserialize);
+CELIX_DFI_BENCHMARKS(prepareRequest);
+CELIX_DFI_BENCHMARKS(call);
+CELIX_DFI_BENCHMARKS(handleReply);
+CELIX_DFI_BENCHMARKS(ffiCall);
+CELIX_DFI_BENCHMARKS(ffiClosure);
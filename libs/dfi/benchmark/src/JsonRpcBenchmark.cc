@@ -0,0 +1,192 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include <jansson.h>
+
+#include "dyn_interface.h"
+#include "json_rpc.h"
+
+/**
+ * Benchmarks the export (service provider) side of a JSON-RPC call, as done by the remote service admins.
+ * The "DoubleParse" variant is the request handling before jsonRpc_callWithJson was available: the request is parsed
+ * to retrieve the method signature (for the interceptors) and then parsed again by jsonRpc_call.
+ * The prepare and handleReply benchmarks cover the import (proxy) side of the same call.
+ */
+class JsonRpcBenchmark {
+public:
+    struct double_seq {
+        uint32_t cap;
+        uint32_t len;
+        double* buf;
+    };
+
+    struct calculator_service {
+        void* handle;
+        int (*sum)(void* handle, struct double_seq input, double* out);
+    };
+
+    explicit JsonRpcBenchmark(benchmark::State& state) {
+        static const char descriptor[] = ":header\n"
+                                         "type=interface\n"
+                                         "name=calculator\n"
+                                         "version=1.0.0\n"
+                                         ":annotations\n"
+                                         ":types\n"
+                                         ":methods\n"
+                                         "sum([D)D=sum(#am=handle;P[D#am=pre;*D)N\n";
+        FILE* stream = fmemopen((void*)descriptor, sizeof(descriptor) - 1, "r");
+        if (stream == nullptr || dynInterface_parse(stream, &intf) != 0) {
+            std::cerr << "ERROR: cannot parse interface descriptor" << std::endl;
+        }
+        if (stream != nullptr) {
+            fclose(stream);
+        }
+
+        request = R"({"m":"sum([D)D","a":[[)";
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            request += (i == 0 ? "" : ",") + std::to_string((double)i + 0.5);
+        }
+        request += "]]}";
+
+        input.cap = input.len = (uint32_t)state.range(0);
+        input.buf = new double[input.len];
+        for (uint32_t i = 0; i < input.len; ++i) {
+            input.buf[i] = (double)i + 0.5;
+        }
+        const struct method_entry* method = dynInterface_findMethod(intf, "sum([D)D");
+        func = method != nullptr ? method->dynFunc : nullptr;
+    }
+
+    ~JsonRpcBenchmark() {
+        delete[] input.buf;
+        dynInterface_destroy(intf);
+    }
+
+    JsonRpcBenchmark(const JsonRpcBenchmark&) = delete;
+    JsonRpcBenchmark& operator=(const JsonRpcBenchmark&) = delete;
+
+    static int sum(void* /*handle*/, struct double_seq input, double* out) {
+        double total = 0.0;
+        for (uint32_t i = 0; i < input.len; ++i) {
+            total += input.buf[i];
+        }
+        *out = total;
+        return 0;
+    }
+
+    /**
+     * Parse the request and retrieve the method signature, as the remote service admins do before calling jsonRpc.
+     */
+    static json_t* parseRequest(const char* request, const char** sig) {
+        json_t* jsRequest = json_loads(request, 0, nullptr);
+        if (jsRequest == nullptr || json_unpack(jsRequest, "{s:s}", "m", sig) != 0) {
+            std::cerr << "ERROR: cannot parse request" << std::endl;
+        }
+        return jsRequest;
+    }
+
+    dyn_interface_type* intf{nullptr};
+    calculator_service svc{nullptr, sum};
+    std::string request{};
+    double_seq input{0, 0, nullptr};
+    const dyn_function_type* func{nullptr};
+};
+
+static void JsonRpcBenchmark_callDoubleParse(benchmark::State& state) {
+    JsonRpcBenchmark benchmark{state};
+    for (auto _ : state) {
+        // This code gets timed
+        const char* sig;
+        json_t* jsRequest = JsonRpcBenchmark::parseRequest(benchmark.request.c_str(), &sig);
+        benchmark::DoNotOptimize(sig);
+        char* reply = nullptr;
+        int rc = jsonRpc_call(benchmark.intf, &benchmark.svc, benchmark.request.c_str(), &reply);
+        benchmark::DoNotOptimize(rc);
+        free(reply);
+        json_decref(jsRequest);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * (int64_t)benchmark.request.size());
+}
+
+static void JsonRpcBenchmark_callSingleParse(benchmark::State& state) {
+    JsonRpcBenchmark benchmark{state};
+    for (auto _ : state) {
+        // This code gets timed
+        const char* sig;
+        json_t* jsRequest = JsonRpcBenchmark::parseRequest(benchmark.request.c_str(), &sig);
+        benchmark::DoNotOptimize(sig);
+        char* reply = nullptr;
+        int rc = jsonRpc_callWithJson(benchmark.intf, &benchmark.svc, jsRequest, &reply);
+        benchmark::DoNotOptimize(rc);
+        free(reply);
+        json_decref(jsRequest);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * (int64_t)benchmark.request.size());
+}
+
+static void JsonRpcBenchmark_prepareRequest(benchmark::State& state) {
+    JsonRpcBenchmark benchmark{state};
+    void* handle = nullptr;
+    void* args[] = {&handle, &benchmark.input, nullptr};
+    size_t bytes = 0;
+    for (auto _ : state) {
+        // This code gets timed
+        char* request = nullptr;
+        int rc = jsonRpc_prepareInvokeRequest(benchmark.func, "sum([D)D", args, &request);
+        benchmark::DoNotOptimize(rc);
+        bytes += rc == 0 ? strlen(request) : 0;
+        free(request);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed((int64_t)bytes);
+}
+
+static void JsonRpcBenchmark_handleReply(benchmark::State& state) {
+    JsonRpcBenchmark benchmark{state};
+    const char* reply = R"({"r":1234.5})";
+    double result = 0.0;
+    double* out = &result;
+    void* args[] = {nullptr, nullptr, &out};
+    for (auto _ : state) {
+        // This code gets timed
+        int rsErrno = 0;
+        int rc = jsonRpc_handleReply(benchmark.func, reply, args, &rsErrno);
+        benchmark::DoNotOptimize(rc);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+#define CELIX_BENCHMARK(name) \
+    BENCHMARK(name)->MeasureProcessCPUTime()->UseRealTime()->Unit(benchmark::kNanosecond) \
+        ->Arg(1)->Arg(16)->Arg(1024)
+
+CELIX_BENCHMARK(JsonRpcBenchmark_callDoubleParse);
+CELIX_BENCHMARK(JsonRpcBenchmark_callSingleParse);
+CELIX_BENCHMARK(JsonRpcBenchmark_prepareRequest);
+CELIX_BENCHMARK(JsonRpcBenchmark_handleReply);
@@ -0,0 +1,120 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <jansson.h>
+
+#include "dyn_type.h"
+#include "json_serializer.h"
+
+/**
+ * Benchmarks the (de)serialization of a nested struct with a sequence of nested structs, the state.range(0) argument
+ * is the number of sequence items.
+ */
+class JsonSerializerBenchmark {
+public:
+    struct point {
+        double x;
+        double y;
+        double z;
+    };
+
+    struct sample {
+        int64_t timestamp;
+        struct point position;
+        struct point velocity;
+        int32_t quality;
+    };
+
+    struct track {
+        int32_t id;
+        struct {
+            uint32_t cap;
+            uint32_t len;
+            struct sample* buf;
+        } samples;
+    };
+
+    explicit JsonSerializerBenchmark(benchmark::State& state) : samples((size_t)state.range(0)) {
+        const char* descriptor = "Tpoint={DDD x y z};Tsample={Jlpoint;lpoint;I timestamp position velocity quality};"
+                                 "{I[lsample; id samples}";
+        if (dynType_parseWithStr(descriptor, nullptr, nullptr, &type) != 0) {
+            std::cerr << "ERROR: cannot parse type descriptor" << std::endl;
+        }
+        for (size_t i = 0; i < samples.size(); ++i) {
+            samples[i] = sample{(int64_t)i, {1.0, 2.0, 3.0}, {0.1, 0.2, 0.3}, 42};
+        }
+        input.id = 1;
+        input.samples.cap = (uint32_t)samples.size();
+        input.samples.len = (uint32_t)samples.size();
+        input.samples.buf = samples.data();
+        if (jsonSerializer_serializeJson(type, &input, &json) != 0) {
+            std::cerr << "ERROR: cannot serialize input" << std::endl;
+        }
+    }
+
+    ~JsonSerializerBenchmark() {
+        json_decref(json);
+        dynType_destroy(type);
+    }
+
+    JsonSerializerBenchmark(const JsonSerializerBenchmark&) = delete;
+    JsonSerializerBenchmark& operator=(const JsonSerializerBenchmark&) = delete;
+
+    dyn_type* type{nullptr};
+    std::vector<sample> samples;
+    track input{};
+    json_t* json{nullptr};
+};
+
+static void JsonSerializerBenchmark_serialize(benchmark::State& state) {
+    JsonSerializerBenchmark benchmark{state};
+    for (auto _ : state) {
+        // This code gets timed
+        json_t* result = nullptr;
+        int rc = jsonSerializer_serializeJson(benchmark.type, &benchmark.input, &result);
+        benchmark::DoNotOptimize(rc);
+        json_decref(result);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void JsonSerializerBenchmark_deserialize(benchmark::State& state) {
+    JsonSerializerBenchmark benchmark{state};
+    for (auto _ : state) {
+        // This code gets timed
+        void* result = nullptr;
+        int rc = jsonSerializer_deserializeJson(benchmark.type, benchmark.json, &result);
+        benchmark::DoNotOptimize(rc);
+        dynType_free(benchmark.type, result);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+#define CELIX_BENCHMARK(name) \
+    BENCHMARK(name)->MeasureProcessCPUTime()->UseRealTime()->Unit(benchmark::kNanosecond) \
+        ->Arg(1)->Arg(16)->Arg(1024)
+
+CELIX_BENCHMARK(JsonSerializerBenchmark_serialize);
+CELIX_BENCHMARK(JsonSerializerBenchmark_deserialize);
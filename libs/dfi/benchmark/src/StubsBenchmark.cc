@@ -0,0 +1,229 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <cstdint>
+#include <ffi.h>
+#include <iostream>
+
+#include "dyn_interface.h"
+#include "stubs_benchmark_stubs.h" //generated by celix_target_dfi_stubs
+
+/**
+ * Compares libffi calls and closures with the generated stubs of the same interface descriptor.
+ */
+class StubsBenchmark {
+public:
+    struct double_seq {
+        uint32_t cap;
+        uint32_t len;
+        double* buf;
+    };
+
+    struct proxy {
+        dyn_stub_proxy_handle_t stubHandle;
+        StubsBenchmark* benchmark;
+    };
+
+    StubsBenchmark(benchmark::State& state, bool useStubs) {
+        FILE* stream = fopen(STUBS_BENCHMARK_DESCRIPTOR, "r");
+        if (stream == nullptr || dynInterface_parse(stream, &intf) != 0) {
+            state.SkipWithError("Cannot parse interface descriptor");
+        }
+        if (stream != nullptr) {
+            fclose(stream);
+        }
+        if (intf != nullptr && useStubs && dynInterface_setStubs(intf, &stubs_benchmark_stubs) != 0) {
+            state.SkipWithError("Cannot set stubs");
+        }
+
+        auto len = (uint32_t)state.range(0);
+        doubles.cap = doubles.len = len;
+        doubles.buf = new double[len];
+        for (uint32_t i = 0; i < len; ++i) {
+            doubles.buf[i] = (double)i + 0.5;
+        }
+    }
+
+    ~StubsBenchmark() {
+        delete[] doubles.buf;
+        dynInterface_destroy(intf);
+    }
+
+    StubsBenchmark(const StubsBenchmark&) = delete;
+    StubsBenchmark& operator=(const StubsBenchmark&) = delete;
+
+    static int add(void* /*handle*/, double a, double b, double* out) {
+        *out = a + b;
+        return 0;
+    }
+
+    static int sum(void* /*handle*/, struct double_seq input, double* out) {
+        double total = 0.0;
+        for (uint32_t i = 0; i < input.len; ++i) {
+            total += input.buf[i];
+        }
+        *out = total;
+        return 0;
+    }
+
+    /**
+     * The proxy side of a remote call without the remote part: calls the local service with the proxied arguments.
+     */
+    void invoke(const struct method_entry* method, void* args[], void* returnValue) {
+        void (*fn)(void) = method->index == 0 ? (void (*)(void))add : (void (*)(void))sum;
+        dynFunction_call(method->dynFunc, fn, returnValue, args);
+    }
+
+    static void bind(void* userData, void* args[], void* returnValue) {
+        auto method = static_cast<const struct method_entry*>(userData);
+        auto benchmark = *static_cast<StubsBenchmark**>(args[0]);
+        benchmark->invoke(method, args, returnValue);
+    }
+
+    static void invokeStub(dyn_stub_proxy_handle_t* handle, int methodIndex, void* args[], void* returnValue) {
+        auto benchmark = reinterpret_cast<proxy*>(handle)->benchmark;
+        benchmark->invoke(dynInterface_findMethodByIndex(benchmark->intf, methodIndex), args, returnValue);
+    }
+
+    /**
+     * Returns a proxy function for the method; a closure bound to this benchmark or a proxy stub bound to prx.
+     */
+    void (*proxyFunction(const struct method_entry* method, void** handle))(void) {
+        void (*fn)(void) = nullptr;
+        if (dynFunction_getProxyStub(method->dynFunc, &fn) == 0) {
+            *handle = &prx;
+        } else {
+            dynFunction_createClosure(method->dynFunc, bind, (void*)method, &fn);
+            *handle = this;
+        }
+        return fn;
+    }
+
+    proxy prx{{invokeStub}, this};
+    dyn_interface_type* intf{nullptr};
+    double_seq doubles{0, 0, nullptr};
+};
+
+static void StubsBenchmark_callAdd(benchmark::State& state, bool useStubs) {
+    StubsBenchmark benchmark{state, useStubs};
+    const struct method_entry* method = dynInterface_findMethodByIndex(benchmark.intf, 0);
+    double a = 1.5;
+    double b = 2.5;
+    double result = 0.0;
+    double* out = &result;
+    void* handle = nullptr;
+    void* args[] = {&handle, &a, &b, &out};
+    ffi_sarg rc = 0;
+    for (auto _ : state) {
+        // This code gets timed
+        dynFunction_call(method->dynFunc, (void (*)(void))StubsBenchmark::add, &rc, args);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void StubsBenchmark_callSum(benchmark::State& state, bool useStubs) {
+    StubsBenchmark benchmark{state, useStubs};
+    const struct method_entry* method = dynInterface_findMethodByIndex(benchmark.intf, 1);
+    double result = 0.0;
+    double* out = &result;
+    void* handle = nullptr;
+    void* args[] = {&handle, &benchmark.doubles, &out};
+    ffi_sarg rc = 0;
+    for (auto _ : state) {
+        // This code gets timed
+        dynFunction_call(method->dynFunc, (void (*)(void))StubsBenchmark::sum, &rc, args);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void StubsBenchmark_proxyAdd(benchmark::State& state, bool useStubs) {
+    StubsBenchmark benchmark{state, useStubs};
+    void* handle = nullptr;
+    auto add = (int (*)(void*, double, double, double*))benchmark.proxyFunction(
+            dynInterface_findMethodByIndex(benchmark.intf, 0), &handle);
+    double result = 0.0;
+    for (auto _ : state) {
+        // This code gets timed
+        benchmark::DoNotOptimize(add(handle, 1.5, 2.5, &result));
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void StubsBenchmark_proxySum(benchmark::State& state, bool useStubs) {
+    StubsBenchmark benchmark{state, useStubs};
+    void* handle = nullptr;
+    auto sum = (int (*)(void*, StubsBenchmark::double_seq, double*))benchmark.proxyFunction(
+            dynInterface_findMethodByIndex(benchmark.intf, 1), &handle);
+    double result = 0.0;
+    for (auto _ : state) {
+        // This code gets timed
+        benchmark::DoNotOptimize(sum(handle, benchmark.doubles, &result));
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void StubsBenchmark_ffiCallAdd(benchmark::State& state) {
+    StubsBenchmark_callAdd(state, false);
+}
+
+static void StubsBenchmark_stubCallAdd(benchmark::State& state) {
+    StubsBenchmark_callAdd(state, true);
+}
+
+static void StubsBenchmark_ffiCallSum(benchmark::State& state) {
+    StubsBenchmark_callSum(state, false);
+}
+
+static void StubsBenchmark_stubCallSum(benchmark::State& state) {
+    StubsBenchmark_callSum(state, true);
+}
+
+static void StubsBenchmark_closureAdd(benchmark::State& state) {
+    StubsBenchmark_proxyAdd(state, false);
+}
+
+static void StubsBenchmark_proxyStubAdd(benchmark::State& state) {
+    StubsBenchmark_proxyAdd(state, true);
+}
+
+static void StubsBenchmark_closureSum(benchmark::State& state) {
+    StubsBenchmark_proxySum(state, false);
+}
+
+static void StubsBenchmark_proxyStubSum(benchmark::State& state) {
+    StubsBenchmark_proxySum(state, true);
+}
+
+#define CELIX_BENCHMARK(name) \
+    BENCHMARK(name)->MeasureProcessCPUTime()->UseRealTime()->Unit(benchmark::kNanosecond)->Arg(16)
+
+CELIX_BENCHMARK(StubsBenchmark_ffiCallAdd);
+CELIX_BENCHMARK(StubsBenchmark_stubCallAdd);
+CELIX_BENCHMARK(StubsBenchmark_ffiCallSum);
+CELIX_BENCHMARK(StubsBenchmark_stubCallSum);
+CELIX_BENCHMARK(StubsBenchmark_closureAdd);
+CELIX_BENCHMARK(StubsBenchmark_proxyStubAdd);
+CELIX_BENCHMARK(StubsBenchmark_closureSum);
+CELIX_BENCHMARK(StubsBenchmark_proxyStubSum);
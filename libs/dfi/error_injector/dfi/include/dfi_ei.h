@@ -30,6 +30,8 @@ CELIX_EI_DECLARE(jsonRpc_prepareInvokeRequest, int);
 
 CELIX_EI_DECLARE(jsonRpc_call, int);
 
+CELIX_EI_DECLARE(jsonRpc_callWithJson, int);
+
 #ifdef __cplusplus
 }
 #endif
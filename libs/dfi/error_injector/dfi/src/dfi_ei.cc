@@ -19,6 +19,7 @@
 #include "dfi_ei.h"
 #include "dyn_function.h"
 #include "dyn_interface.h"
+#include <jansson.h>
 
 extern "C" {
 int __real_dynFunction_createClosure(dyn_function_type *dynFunction, void (*bind)(void *, void **, void*), void *userData, void(**fn)(void));
@@ -42,4 +43,11 @@ int __wrap_jsonRpc_call(const dyn_interface_type* intf, void* service, const cha
     return __real_jsonRpc_call(intf, service, request, out);
 }
 
+int __real_jsonRpc_callWithJson(const dyn_interface_type* intf, void* service, const json_t* request, char** out);
+CELIX_EI_DEFINE(jsonRpc_callWithJson, int)
+int __wrap_jsonRpc_callWithJson(const dyn_interface_type* intf, void* service, const json_t* request, char** out) {
+    CELIX_EI_IMPL(jsonRpc_callWithJson);
+    return __real_jsonRpc_callWithJson(intf, service, request, out);
+}
+
 }
\ No newline at end of file
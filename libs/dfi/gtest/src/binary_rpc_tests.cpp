@@ -0,0 +1,350 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "binary_rpc.h"
+#include "dyn_interface.h"
+#include "celix_err.h"
+#include "json_rpc_test.h"
+
+namespace {
+    struct calculator_service {
+        void* handle;
+        int (*add)(void*, double, double, double*);
+        int (*sub)(void*, double, double, double*);
+        int (*sqrt)(void*, double, double*);
+        int (*stats)(void*, struct tst_seq, struct tst_StatsResult**);
+    };
+
+    struct buffers_service {
+        void* handle;
+        int (*sum)(void*, struct tst_seq, double*);
+        int (*sumCopy)(void*, struct tst_seq, double*);
+        int (*scaledSum)(void*, int32_t, struct tst_seq, double*);
+    };
+
+    const void* sumItems = nullptr;
+
+    int sumSeq(void*, struct tst_seq seq, double* result) {
+        sumItems = seq.buf;
+        *result = 0.0;
+        for (uint32_t i = 0; i < seq.len; ++i) {
+            *result += seq.buf[i];
+        }
+        return 0;
+    }
+
+    int scaledSumSeq(void* handle, int32_t scale, struct tst_seq seq, double* result) {
+        (void)sumSeq(handle, seq, result);
+        *result *= scale;
+        return 0;
+    }
+
+    struct name_service {
+        void* handle;
+        int (*getName)(void*, char** name);
+        int (*setName)(void*, char* name);
+        int (*setConstName)(void*, const char* name);
+    };
+}
+
+class BinaryRpcTests : public ::testing::Test {
+public:
+    BinaryRpcTests() = default;
+    ~BinaryRpcTests() override {
+        dynInterface_destroy(intf);
+        celix_err_resetErrors();
+    }
+
+    void parse(const char* descriptor) {
+        FILE* desc = fopen(descriptor, "r");
+        ASSERT_TRUE(desc != nullptr);
+        ASSERT_EQ(0, dynInterface_parse(desc, &intf));
+        fclose(desc);
+    }
+
+    std::string call(void* service, const std::string& request) {
+        void* out = nullptr;
+        size_t outSize = 0;
+        EXPECT_EQ(0, binaryRpc_call(intf, service, request.data(), request.size(), &out, &outSize));
+        std::string reply{static_cast<char*>(out), outSize};
+        free(out);
+        return reply;
+    }
+
+    std::string prepare(const struct method_entry* method, void* args[]) {
+        void* out = nullptr;
+        size_t outSize = 0;
+        EXPECT_EQ(0, binaryRpc_prepareInvokeRequest(method->dynFunc, method->index, args, &out, &outSize));
+        std::string request{static_cast<char*>(out), outSize};
+        free(out);
+        return request;
+    }
+
+    dyn_interface_type* intf{nullptr};
+};
+
+TEST_F(BinaryRpcTests, PreAllocatedOutputTest) {
+    parse("descriptors/example1.descriptor");
+    const struct method_entry* method = dynInterface_findMethod(intf, "add(DD)D");
+    ASSERT_NE(nullptr, method);
+
+    double a = 1.0;
+    double b = 2.0;
+    double result = 0.0;
+    double* resultPtr = &result;
+    void* args[4] = {nullptr, &a, &b, &resultPtr};
+    std::string request = prepare(method, args);
+    EXPECT_EQ(4u + 2 * sizeof(double), request.size());
+
+    int index = -1;
+    EXPECT_EQ(0, binaryRpc_getMethodIndex(request.data(), request.size(), &index));
+    EXPECT_EQ(method->index, index);
+
+    calculator_service serv{nullptr, add, nullptr, nullptr, nullptr};
+    std::string reply = call(&serv, request);
+
+    int rsErrno = -1;
+    EXPECT_EQ(0, binaryRpc_handleReply(method->dynFunc, reply.data(), reply.size(), args, &rsErrno));
+    EXPECT_EQ(0, rsErrno);
+    EXPECT_EQ(3.0, result);
+}
+
+TEST_F(BinaryRpcTests, OutputTest) {
+    parse("descriptors/example1.descriptor");
+    const struct method_entry* method = dynInterface_findMethod(intf, "stats([D)LStatsResult;");
+    ASSERT_NE(nullptr, method);
+
+    double values[] = {1.0, 2.0, 3.0};
+    tst_seq input{3, 3, values};
+    tst_StatsResult* result = nullptr;
+    void* out = &result;
+    void* args[3] = {nullptr, &input, &out};
+    std::string request = prepare(method, args);
+
+    calculator_service serv{nullptr, nullptr, nullptr, nullptr, stats};
+    std::string reply = call(&serv, request);
+
+    int rsErrno = -1;
+    EXPECT_EQ(0, binaryRpc_handleReply(method->dynFunc, reply.data(), reply.size(), args, &rsErrno));
+    EXPECT_EQ(0, rsErrno);
+    ASSERT_NE(nullptr, result);
+    EXPECT_EQ(2.0, result->average);
+    EXPECT_EQ(1.0, result->min);
+    EXPECT_EQ(3.0, result->max);
+    ASSERT_EQ(3u, result->input.len);
+    EXPECT_EQ(0, memcmp(values, result->input.buf, sizeof(values)));
+    free(result->input.buf);
+    free(result);
+}
+
+TEST_F(BinaryRpcTests, ConstSequenceViewTest) {
+    parse("descriptors/example10.descriptor");
+    buffers_service serv{nullptr, sumSeq, sumSeq, scaledSumSeq};
+    double values[] = {1.0, 2.0, 3.0, 4.0};
+    tst_seq input{4, 4, values};
+    double result = 0.0;
+    double* resultPtr = &result;
+    alignas(double) char request[128];
+    auto callFromRequest = [&](const struct method_entry* method, void* args[], size_t requestOffset) {
+        std::string encoded = prepare(method, args);
+        ASSERT_LE(requestOffset + encoded.size(), sizeof(request));
+        memcpy(request + requestOffset, encoded.data(), encoded.size());
+        void* out = nullptr;
+        size_t outSize = 0;
+        sumItems = nullptr;
+        ASSERT_EQ(0, binaryRpc_call(intf, &serv, request + requestOffset, encoded.size(), &out, &outSize));
+        int rsErrno = -1;
+        EXPECT_EQ(0, binaryRpc_handleReply(method->dynFunc, out, outSize, args, &rsErrno));
+        EXPECT_EQ(0, rsErrno);
+        free(out);
+    };
+
+    //the aligned items of a const sequence are passed as a view into the request, after the index and the length
+    const struct method_entry* sum = dynInterface_findMethod(intf, "sum([D)D");
+    ASSERT_NE(nullptr, sum);
+    void* args[3] = {nullptr, &input, &resultPtr};
+    callFromRequest(sum, args, 0);
+    EXPECT_EQ(10.0, result);
+    EXPECT_EQ(request + 2 * sizeof(uint32_t), sumItems);
+
+    //unaligned items are copied
+    result = 0.0;
+    callFromRequest(sum, args, 1);
+    EXPECT_EQ(10.0, result);
+    EXPECT_NE(nullptr, sumItems);
+    EXPECT_NE(request + 1 + 2 * sizeof(uint32_t), sumItems);
+
+    //the items of a non-const sequence are copied
+    const struct method_entry* sumCopy = dynInterface_findMethod(intf, "sumCopy([D)D");
+    ASSERT_NE(nullptr, sumCopy);
+    result = 0.0;
+    callFromRequest(sumCopy, args, 0);
+    EXPECT_EQ(10.0, result);
+    EXPECT_NE(nullptr, sumItems);
+    EXPECT_NE(request + 2 * sizeof(uint32_t), sumItems);
+
+    //the items following an int are not aligned in the request
+    const struct method_entry* scaledSum = dynInterface_findMethod(intf, "scaledSum(I[D)D");
+    ASSERT_NE(nullptr, scaledSum);
+    int32_t scale = 2;
+    void* scaledArgs[4] = {nullptr, &scale, &input, &resultPtr};
+    result = 0.0;
+    callFromRequest(scaledSum, scaledArgs, 0);
+    EXPECT_EQ(20.0, result);
+    EXPECT_NE(request + 3 * sizeof(uint32_t), sumItems);
+
+    //an empty const sequence is passed as an empty sequence
+    tst_seq empty{0, 0, nullptr};
+    void* emptyArgs[3] = {nullptr, &empty, &resultPtr};
+    result = 1.0;
+    callFromRequest(sum, emptyArgs, 0);
+    EXPECT_EQ(0.0, result);
+    EXPECT_EQ(nullptr, sumItems);
+
+    //a request with trailing data releases the views
+    std::string trailing = prepare(sum, args) + "x";
+    memcpy(request, trailing.data(), trailing.size());
+    void* out = nullptr;
+    size_t outSize = 0;
+    EXPECT_NE(0, binaryRpc_call(intf, &serv, request, trailing.size(), &out, &outSize));
+    EXPECT_STREQ("Unexpected trailing data in binary request for sum([D)D", celix_err_popLastError());
+}
+
+TEST_F(BinaryRpcTests, TextTest) {
+    parse("descriptors/example4.descriptor");
+    const struct method_entry* setName = dynInterface_findMethod(intf, "setName");
+    const struct method_entry* getName = dynInterface_findMethod(intf, "getName(V)t");
+    ASSERT_NE(nullptr, setName);
+    ASSERT_NE(nullptr, getName);
+
+    //a non-const text argument is owned, and released, by prepare
+    char* name = strdup("hello");
+    void* setArgs[2] = {nullptr, &name};
+    std::string request = prepare(setName, setArgs);
+
+    static std::string received;
+    name_service serv{nullptr,
+                      [](void*, char** result) -> int {
+                          *result = strdup("allocatedInFunction");
+                          return 0;
+                      },
+                      [](void*, char* value) -> int {
+                          received = value;
+                          free(value);
+                          return 0;
+                      },
+                      nullptr};
+    std::string reply = call(&serv, request);
+    EXPECT_EQ("hello", received);
+    EXPECT_EQ(std::string(1, '\0'), reply);
+
+    int rsErrno = -1;
+    EXPECT_EQ(0, binaryRpc_handleReply(setName->dynFunc, reply.data(), reply.size(), setArgs, &rsErrno));
+    EXPECT_EQ(0, rsErrno);
+
+    char* result = nullptr;
+    void* out = &result;
+    void* getArgs[2] = {nullptr, &out};
+    request = prepare(getName, getArgs);
+    reply = call(&serv, request);
+    EXPECT_EQ(0, binaryRpc_handleReply(getName->dynFunc, reply.data(), reply.size(), getArgs, &rsErrno));
+    EXPECT_STREQ("allocatedInFunction", result);
+    free(result);
+
+    //a caller provided nullptr is not assigned
+    out = nullptr;
+    EXPECT_EQ(0, binaryRpc_handleReply(getName->dynFunc, reply.data(), reply.size(), getArgs, &rsErrno));
+}
+
+TEST_F(BinaryRpcTests, ErrorReplyTest) {
+    parse("descriptors/example1.descriptor");
+    const struct method_entry* method = dynInterface_findMethod(intf, "add(DD)D");
+    double a = 1.0;
+    double b = 2.0;
+    double result = 0.0;
+    double* resultPtr = &result;
+    void* args[4] = {nullptr, &a, &b, &resultPtr};
+    std::string request = prepare(method, args);
+
+    calculator_service serv{nullptr, [](void*, double, double, double*) -> int { return 42; }, nullptr, nullptr, nullptr};
+    std::string reply = call(&serv, request);
+
+    int rsErrno = 0;
+    EXPECT_EQ(0, binaryRpc_handleReply(method->dynFunc, reply.data(), reply.size(), args, &rsErrno));
+    EXPECT_EQ(42, rsErrno);
+    EXPECT_EQ(0.0, result);
+}
+
+TEST_F(BinaryRpcTests, InvalidRequestTest) {
+    parse("descriptors/example1.descriptor");
+    calculator_service serv{nullptr, add, nullptr, nullptr, stats};
+    void* out = nullptr;
+    size_t outSize = 0;
+
+    EXPECT_NE(0, binaryRpc_call(intf, &serv, "\x01\x00", 2, &out, &outSize));
+    EXPECT_STREQ("Error reading method index of binary request", celix_err_popLastError());
+
+    EXPECT_NE(0, binaryRpc_call(intf, &serv, "\x10\x00\x00\x00", 4, &out, &outSize));
+    EXPECT_STREQ("Cannot find method with index 16", celix_err_popLastError());
+
+    const struct method_entry* method = dynInterface_findMethod(intf, "add(DD)D");
+    double a = 1.0;
+    double b = 2.0;
+    double* resultPtr = nullptr;
+    void* args[4] = {nullptr, &a, &b, &resultPtr};
+    std::string request = prepare(method, args);
+    std::string truncated = request.substr(0, request.size() - 1);
+    EXPECT_NE(0, binaryRpc_call(intf, &serv, truncated.data(), truncated.size(), &out, &outSize));
+    EXPECT_STREQ("Error deserializing argument 2 for add(DD)D", celix_err_popLastError());
+
+    std::string trailing = request + "x";
+    EXPECT_NE(0, binaryRpc_call(intf, &serv, trailing.data(), trailing.size(), &out, &outSize));
+    EXPECT_STREQ("Unexpected trailing data in binary request for add(DD)D", celix_err_popLastError());
+}
+
+TEST_F(BinaryRpcTests, InvalidReplyTest) {
+    parse("descriptors/example1.descriptor");
+    const struct method_entry* method = dynInterface_findMethod(intf, "add(DD)D");
+    double result = 1.0;
+    double* resultPtr = &result;
+    void* args[4] = {nullptr, nullptr, nullptr, &resultPtr};
+    int rsErrno = 0;
+
+    EXPECT_NE(0, binaryRpc_handleReply(method->dynFunc, "", 0, args, &rsErrno));
+    EXPECT_STREQ("Error reading binary reply", celix_err_popLastError());
+
+    EXPECT_NE(0, binaryRpc_handleReply(method->dynFunc, "\x02", 1, args, &rsErrno));
+    EXPECT_STREQ("Invalid binary reply kind 2", celix_err_popLastError());
+
+    EXPECT_NE(0, binaryRpc_handleReply(method->dynFunc, "\x00", 1, args, &rsErrno));
+    EXPECT_STREQ("Expected result in binary reply for add", celix_err_popLastError());
+
+    //the pre-allocated output is left untouched on error
+    std::string reply(1 + sizeof(double) + 1, '\0');
+    EXPECT_NE(0, binaryRpc_handleReply(method->dynFunc, reply.data(), reply.size(), args, &rsErrno));
+    EXPECT_STREQ("Unexpected trailing data in binary reply for add", celix_err_popLastError());
+    EXPECT_EQ(1.0, result);
+}
@@ -0,0 +1,228 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "binary_serializer.h"
+#include "dyn_type.h"
+#include "celix_array_list.h"
+#include "celix_err.h"
+#include "celix_properties.h"
+
+class BinarySerializerTests : public ::testing::Test {
+public:
+    BinarySerializerTests() = default;
+    ~BinarySerializerTests() override {
+        dynType_destroy(type);
+        celix_err_resetErrors();
+    }
+
+    void parse(const char* descriptor) {
+        ASSERT_EQ(0, dynType_parseWithStr(descriptor, nullptr, nullptr, &type));
+    }
+
+    std::string serialize(const void* input) {
+        void* out = nullptr;
+        size_t outSize = 0;
+        EXPECT_EQ(0, binarySerializer_serialize(type, input, &out, &outSize));
+        std::string result{static_cast<char*>(out), outSize};
+        free(out);
+        return result;
+    }
+
+    dyn_type* type{nullptr};
+};
+
+TEST_F(BinarySerializerTests, NumbersAreLittleEndianTest) {
+    struct numbers {
+        int32_t a;
+        int16_t b;
+        bool c;
+        int d;
+    };
+    parse("{ISZN a b c d}");
+    numbers input{0x01020304, 0x0506, true, -2};
+    std::string encoded = serialize(&input);
+    ASSERT_EQ(4u + 2u + 1u + 4u, encoded.size()); //no padding on the wire
+    EXPECT_EQ(std::string("\x04\x03\x02\x01\x06\x05\x01\xfe\xff\xff\xff", 11), encoded);
+
+    void* result = nullptr;
+    ASSERT_EQ(0, binarySerializer_deserialize(type, encoded.data(), encoded.size(), &result));
+    auto output = static_cast<numbers*>(result);
+    EXPECT_EQ(0x01020304, output->a);
+    EXPECT_EQ(0x0506, output->b);
+    EXPECT_TRUE(output->c);
+    EXPECT_EQ(-2, output->d);
+    dynType_free(type, result);
+}
+
+TEST_F(BinarySerializerTests, PackedSequenceTest) {
+    struct point {
+        double x;
+        double y;
+        double z;
+    };
+    struct point_seq {
+        uint32_t cap;
+        uint32_t len;
+        point* buf;
+    };
+    parse("[{DDD x y z}");
+    point points[3] = {{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}, {7.0, 8.0, 9.0}};
+    point_seq input{3, 3, points};
+    std::string encoded = serialize(&input);
+    ASSERT_EQ(4u + sizeof(points), encoded.size());
+    EXPECT_EQ(0, memcmp(encoded.data() + 4, points, sizeof(points)));
+
+    void* result = nullptr;
+    ASSERT_EQ(0, binarySerializer_deserialize(type, encoded.data(), encoded.size(), &result));
+    auto output = static_cast<point_seq*>(result);
+    ASSERT_EQ(3u, output->len);
+    EXPECT_EQ(0, memcmp(points, output->buf, sizeof(points)));
+    dynType_free(type, result);
+
+    //an empty sequence
+    input.len = 0;
+    encoded = serialize(&input);
+    EXPECT_EQ(std::string(4, '\0'), encoded);
+    ASSERT_EQ(0, binarySerializer_deserialize(type, encoded.data(), encoded.size(), &result));
+    EXPECT_EQ(0u, static_cast<point_seq*>(result)->len);
+    dynType_free(type, result);
+}
+
+TEST_F(BinarySerializerTests, ComplexTypesTest) {
+    struct item {
+        int32_t a;
+        int32_t b;
+    };
+    struct text_seq {
+        uint32_t cap;
+        uint32_t len;
+        char** buf;
+    };
+    struct example {
+        char* name;
+        text_seq tags;
+        item* ref;
+        item* nullRef;
+        char* nullName;
+        int32_t kind;
+    };
+    parse("{t[t*{II a b}*{II a b}t#v1=1;#v2=2;E name tags ref nullRef nullName kind}");
+    item ref{1, 2};
+    char* tags[] = {(char*)"x", (char*)"yz"};
+    example input{(char*)"name", {2, 2, tags}, &ref, nullptr, nullptr, 2};
+    std::string encoded = serialize(&input);
+
+    void* result = nullptr;
+    ASSERT_EQ(0, binarySerializer_deserialize(type, encoded.data(), encoded.size(), &result));
+    auto output = static_cast<example*>(result);
+    EXPECT_STREQ("name", output->name);
+    ASSERT_EQ(2u, output->tags.len);
+    EXPECT_STREQ("x", output->tags.buf[0]);
+    EXPECT_STREQ("yz", output->tags.buf[1]);
+    ASSERT_NE(nullptr, output->ref);
+    EXPECT_EQ(1, output->ref->a);
+    EXPECT_EQ(2, output->ref->b);
+    EXPECT_EQ(nullptr, output->nullRef);
+    EXPECT_EQ(nullptr, output->nullName);
+    EXPECT_EQ(2, output->kind);
+    dynType_free(type, result);
+}
+
+TEST_F(BinarySerializerTests, BuiltInObjectsTest) {
+    struct example {
+        celix_properties_t* props;
+        celix_array_list_t* list;
+        celix_properties_t* nullProps;
+    };
+    parse("{pap props list nullProps}");
+    celix_autoptr(celix_properties_t) props = celix_properties_create();
+    celix_properties_set(props, "key", "value");
+    celix_properties_setLong(props, "long", 42);
+    celix_autoptr(celix_array_list_t) list = celix_arrayList_createLongArray();
+    celix_arrayList_addLong(list, 1);
+    celix_arrayList_addLong(list, 2);
+    example input{props, list, nullptr};
+    std::string encoded = serialize(&input);
+
+    void* result = nullptr;
+    ASSERT_EQ(0, binarySerializer_deserialize(type, encoded.data(), encoded.size(), &result));
+    auto output = static_cast<example*>(result);
+    EXPECT_TRUE(celix_properties_equals(props, output->props));
+    EXPECT_TRUE(celix_arrayList_equals(list, output->list));
+    EXPECT_EQ(nullptr, output->nullProps);
+    dynType_free(type, result);
+}
+
+TEST_F(BinarySerializerTests, InvalidInputTest) {
+    struct text_seq {
+        uint32_t cap;
+        uint32_t len;
+        char** buf;
+    };
+    parse("{[t*{II a b} tags ref}");
+    char* tags[] = {(char*)"abc", (char*)"def"};
+    int32_t ref[2] = {1, 2};
+    struct {
+        text_seq tags;
+        int32_t* ref;
+    } input{{2, 2, tags}, ref};
+    std::string encoded = serialize(&input);
+
+    //every truncated encoding is rejected, without leaking the partially deserialized value
+    void* result = nullptr;
+    for (size_t size = 0; size < encoded.size(); ++size) {
+        EXPECT_NE(0, binarySerializer_deserialize(type, encoded.data(), size, &result)) << size;
+        EXPECT_NE(nullptr, celix_err_popLastError());
+        celix_err_resetErrors();
+    }
+
+    //trailing data
+    std::string trailing = encoded + "x";
+    EXPECT_NE(0, binarySerializer_deserialize(type, trailing.data(), trailing.size(), &result));
+    EXPECT_STREQ("Unexpected trailing data (1 bytes) in binary input", celix_err_popLastError());
+
+    //invalid pointer marker
+    std::string invalidMarker = encoded;
+    invalidMarker[encoded.size() - 9] = 2;
+    EXPECT_NE(0, binarySerializer_deserialize(type, invalidMarker.data(), invalidMarker.size(), &result));
+    EXPECT_STREQ("Invalid pointer marker 2 in binary input", celix_err_popLastError());
+
+    //a sequence length larger than the input
+    std::string invalidLength = encoded;
+    invalidLength[3] = '\x7f';
+    EXPECT_NE(0, binarySerializer_deserialize(type, invalidLength.data(), invalidLength.size(), &result));
+    EXPECT_STREQ("Invalid sequence length 2130706434 for the remaining binary input", celix_err_popLastError());
+}
+
+TEST_F(BinarySerializerTests, UnsupportedTypeTest) {
+    parse("{**D a}");
+    double value = 1.0;
+    double* ptr = &value;
+    double** ptrToPtr = &ptr;
+    void* out = nullptr;
+    size_t outSize = 0;
+    EXPECT_NE(0, binarySerializer_serialize(type, &ptrToPtr, &out, &outSize));
+    EXPECT_STREQ("Error cannot serialize pointer to pointer", celix_err_popLastError());
+}
@@ -104,13 +104,21 @@ static void tests() {
         double (*func)(int32_t a, struct example2_arg2 b, int32_t c) = NULL;
         double (*func2)(int32_t a, struct example2_arg2 b, int32_t c) = NULL;
         dynFunction = NULL;
+        void (*bind)(void*, void**, void*) = NULL;
+        void* userData = NULL;
         rc = dynFunction_parseWithStr(EXAMPLE2_DESCRIPTOR, NULL, &dynFunction);
         ASSERT_EQ(0, rc);
-        rc = dynFunction_createClosure(dynFunction, example2_binding, NULL, (void(**)(void))&func);
+        rc = dynFunction_getClosureBind(dynFunction, &bind, &userData);
+        ASSERT_NE(0, rc);
+        rc = dynFunction_createClosure(dynFunction, example2_binding, &g_count, (void(**)(void))&func);
         ASSERT_EQ(0, rc);
         rc = dynFunction_getFnPointer(dynFunction, (void(**)(void))&func2);
         ASSERT_EQ(0, rc);
         ASSERT_TRUE(func == func2);
+        rc = dynFunction_getClosureBind(dynFunction, &bind, &userData);
+        ASSERT_EQ(0, rc);
+        ASSERT_TRUE(bind == example2_binding);
+        ASSERT_EQ(&g_count, userData);
         struct example2_arg2 b;
         b.val1 = 1.0;
         b.val2 = 1.5;
@@ -406,3 +406,26 @@ TEST_F(DynFunctionTests, DynFuncWithArrayListArgTest) {
     dynFunction_destroy(dynFunc);
     EXPECT_EQ(2, celix_arrayList_getLong(result, 0));
 }
+
+TEST_F(DynFunctionTests, LargeStructArgumentValuesAreKeptTest) {
+    //a struct larger than 16 bytes is passed in memory, for which libffi can replace the argument value
+    struct large_struct {
+        int64_t a;
+        double b;
+        double c;
+        int32_t d;
+    };
+    dyn_function_type *dynFunc = nullptr;
+    int (*fp)(large_struct) = [](large_struct s) { return (int)(s.a + s.d); };
+    int rc = dynFunction_parseWithStr("example({JDDI a b c d})N", nullptr, &dynFunc);
+    ASSERT_EQ(0, rc);
+
+    large_struct arg{1, 2.0, 3.0, 4};
+    void* args[1] = {&arg};
+    ffi_sarg rVal = 0;
+    rc = dynFunction_call(dynFunc, (void (*)(void))fp, &rVal, args);
+    dynFunction_destroy(dynFunc);
+    EXPECT_EQ(0, rc);
+    EXPECT_EQ(5, rVal);
+    EXPECT_EQ(&arg, args[0]);
+}
@@ -74,6 +74,13 @@ TEST_F(DynInterfaceErrorInjectionTestSuite, ParseError) {
     ASSERT_NE(0, status);
     ASSERT_STREQ("Error allocating memory for method entry", celix_err_popLastError());
 
+    rewind(desc);
+    // not enough memory for method index
+    celix_ei_expect_calloc((void*) dynInterface_parse, 1, nullptr);
+    status = dynInterface_parse(desc, &dynIntf);
+    ASSERT_NE(0, status);
+    ASSERT_STREQ("Error allocating memory for method index", celix_err_popLastError());
+
     rewind(desc);
     // not enough memory for open_memstream
     celix_ei_expect_open_memstream((void*) dynCommon_parseNameAlsoAccept, 0, nullptr);
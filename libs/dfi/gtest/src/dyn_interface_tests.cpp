@@ -384,4 +384,29 @@ TEST_F(DynInterfaceTests, testFindMethod) {
     ASSERT_TRUE(mInfo == NULL);
 
     dynInterface_destroy(dynIntf);
-}
\ No newline at end of file
+}
+TEST_F(DynInterfaceTests, testFindMethodByIndex) {
+    int status = 0;
+    dyn_interface_type *dynIntf = NULL;
+    FILE *desc = fopen("descriptors/example1.descriptor", "r");
+    assert(desc != NULL);
+    status = dynInterface_parse(desc, &dynIntf);
+    ASSERT_EQ(0, status);
+    fclose(desc);
+
+    const struct methods_head* list = dynInterface_methods(dynIntf);
+    const struct method_entry* entry = NULL;
+    TAILQ_FOREACH(entry, list, entries) {
+        ASSERT_EQ(entry, dynInterface_findMethodByIndex(dynIntf, entry->index));
+        ASSERT_EQ(entry, dynInterface_findMethod(dynIntf, entry->id));
+    }
+
+    const struct method_entry* mInfo = dynInterface_findMethodByIndex(dynIntf, 3);
+    ASSERT_TRUE(mInfo != NULL);
+    ASSERT_STREQ("stats([D)LStatsResult;", mInfo->id);
+
+    ASSERT_TRUE(dynInterface_findMethodByIndex(dynIntf, -1) == NULL);
+    ASSERT_TRUE(dynInterface_findMethodByIndex(dynIntf, dynInterface_nrOfMethods(dynIntf)) == NULL);
+
+    dynInterface_destroy(dynIntf);
+}
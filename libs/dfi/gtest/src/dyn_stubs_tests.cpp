@@ -0,0 +1,151 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <ffi.h>
+
+#include "dyn_interface.h"
+#include "celix_err.h"
+#include "json_rpc_test.h"
+#include "example1_stubs.h" //generated by celix_target_dfi_stubs
+#include "example4_stubs.h" //generated by celix_target_dfi_stubs
+
+namespace {
+    struct calculator_proxy {
+        dyn_stub_proxy_handle_t stubHandle; //must be the first member
+        int methodIndex;
+        double a;
+        double b;
+    };
+
+    void calculatorProxy_invoke(dyn_stub_proxy_handle_t* handle, int methodIndex, void* args[], void* returnValue) {
+        auto proxy = reinterpret_cast<calculator_proxy*>(handle);
+        proxy->methodIndex = methodIndex;
+        proxy->a = *static_cast<double*>(args[1]);
+        proxy->b = *static_cast<double*>(args[2]);
+        double** result = static_cast<double**>(args[3]);
+        **result = proxy->a + proxy->b;
+        *static_cast<ffi_sarg*>(returnValue) = -1;
+    }
+
+    int negativeAdd(void*, double, double, double* result) {
+        *result = 0.0;
+        return -2;
+    }
+}
+
+class DynStubsTests : public ::testing::Test {
+public:
+    DynStubsTests() = default;
+    ~DynStubsTests() override {
+        dynInterface_destroy(intf);
+        celix_err_resetErrors();
+    }
+
+    void parse(const char* descriptor) {
+        FILE* desc = fopen(descriptor, "r");
+        ASSERT_TRUE(desc != nullptr);
+        ASSERT_EQ(0, dynInterface_parse(desc, &intf));
+        fclose(desc);
+    }
+
+    dyn_interface_type* intf{nullptr};
+};
+
+TEST_F(DynStubsTests, CallStubTest) {
+    parse("descriptors/example1.descriptor");
+    ASSERT_EQ(0, dynInterface_setStubs(intf, &calculator_stubs));
+    const struct method_entry* method = dynInterface_findMethod(intf, "add(DD)D");
+    ASSERT_NE(nullptr, method);
+
+    double a = 1.0;
+    double b = 2.0;
+    double result = 0.0;
+    double* resultPtr = &result;
+    void* handle = nullptr;
+    void* args[4] = {&handle, &a, &b, &resultPtr};
+    ffi_sarg rc = 1;
+    EXPECT_EQ(0, dynFunction_call(method->dynFunc, (void (*)(void))add, &rc, args));
+    EXPECT_EQ(0, rc);
+    EXPECT_EQ(3.0, result);
+
+    //like ffi_call, the return value is widened to ffi_sarg
+    rc = 0;
+    EXPECT_EQ(0, dynFunction_call(method->dynFunc, (void (*)(void))negativeAdd, &rc, args));
+    EXPECT_EQ(-2, rc);
+
+    //aggregate arguments are passed by value
+    method = dynInterface_findMethod(intf, "stats([D)LStatsResult;");
+    double values[] = {1.0, 2.0, 3.0};
+    tst_seq input{3, 3, values};
+    tst_StatsResult* stats = nullptr;
+    tst_StatsResult** statsPtr = &stats;
+    void* statsArgs[3] = {&handle, &input, &statsPtr};
+    EXPECT_EQ(0, dynFunction_call(method->dynFunc, (void (*)(void))::stats, &rc, statsArgs));
+    EXPECT_EQ(0, rc);
+    ASSERT_NE(nullptr, stats);
+    EXPECT_EQ(2.0, stats->average);
+    free(stats->input.buf);
+    free(stats);
+}
+
+TEST_F(DynStubsTests, ProxyStubTest) {
+    parse("descriptors/example1.descriptor");
+    const struct method_entry* method = dynInterface_findMethod(intf, "sub(DD)D");
+    void (*fn)(void) = nullptr;
+    EXPECT_NE(0, dynFunction_getProxyStub(method->dynFunc, &fn));
+
+    ASSERT_EQ(0, dynInterface_setStubs(intf, &calculator_stubs));
+    ASSERT_EQ(0, dynFunction_getProxyStub(method->dynFunc, &fn));
+    calculator_proxy proxy{{calculatorProxy_invoke}, -1, 0.0, 0.0};
+    double result = 0.0;
+    auto sub = reinterpret_cast<int (*)(void*, double, double, double*)>(fn);
+    EXPECT_EQ(-1, sub(&proxy, 4.0, 2.0, &result));
+    EXPECT_EQ(method->index, proxy.methodIndex);
+    EXPECT_EQ(4.0, proxy.a);
+    EXPECT_EQ(2.0, proxy.b);
+    EXPECT_EQ(6.0, result);
+}
+
+TEST_F(DynStubsTests, MismatchingStubsTest) {
+    parse("descriptors/example4.descriptor");
+    EXPECT_NE(0, dynInterface_setStubs(intf, &calculator_stubs));
+    EXPECT_STREQ("Stubs for calculator 1.0.0 do not match interface example4 1.0.0", celix_err_popLastError());
+
+    dyn_stub_method_t methods[3];
+    dyn_interface_stubs_t stubs = example4_stubs;
+    stubs.nrOfMethods = 2;
+    EXPECT_NE(0, dynInterface_setStubs(intf, &stubs));
+    EXPECT_STREQ("Stubs for example4 have 2 methods, expected 3", celix_err_popLastError());
+
+    for (size_t i = 0; i < 3; ++i) {
+        methods[i] = example4_stubs.methods[i];
+    }
+    methods[1].id = "unknown";
+    stubs.nrOfMethods = 3;
+    stubs.methods = methods;
+    EXPECT_NE(0, dynInterface_setStubs(intf, &stubs));
+    EXPECT_STREQ("Stub for method 1 of example4 is unknown, expected setName", celix_err_popLastError());
+
+    //nothing is set on error
+    void (*fn)(void) = nullptr;
+    EXPECT_NE(0, dynFunction_getProxyStub(dynInterface_findMethodByIndex(intf, 0)->dynFunc, &fn));
+}
@@ -20,11 +20,12 @@
 #include "json_rpc.h"
 #include "json_rpc_test.h"
 #include "json_serializer.h"
+#include "json_serializer_common.h"
 #include "dyn_type.h"
 #include "dyn_function.h"
 #include "celix_err.h"
-#include "jansson_ei.h"
 #include "malloc_ei.h"
+#include "celix_json_stream_ei.h"
 
 #include <gtest/gtest.h>
 
@@ -34,14 +35,10 @@ public:
 
     }
     ~JsonRpcErrorInjectionTestSuite() override {
-        celix_ei_expect_json_dumps(nullptr, 0, nullptr);
-        celix_ei_expect_json_object(nullptr, 0, nullptr);
-        celix_ei_expect_json_real(nullptr, 0, nullptr);
         celix_ei_expect_calloc(nullptr, 0, nullptr);
-        celix_ei_expect_json_dumps(nullptr, 0, nullptr);
-        celix_ei_expect_json_array_append_new(nullptr, 0, -1);
-        celix_ei_expect_json_string(nullptr, 0, nullptr);
-        celix_ei_expect_json_array(nullptr, 0, nullptr);
+        celix_ei_expect_celix_jsonWriter_writeRaw(nullptr, 0, CELIX_SUCCESS);
+        celix_ei_expect_celix_jsonWriter_writeChar(nullptr, 0, CELIX_SUCCESS);
+        celix_ei_expect_celix_jsonWriter_steal(nullptr, 0, nullptr);
         celix_err_resetErrors();
     }
 };
@@ -62,24 +59,12 @@ TEST_F(JsonRpcErrorInjectionTestSuite, prepareErrorTest) {
     args[1] = &arg1;
     args[2] = &arg2;
 
-    celix_ei_expect_json_array((void*)jsonRpc_prepareInvokeRequest, 0, nullptr);
-    rc = jsonRpc_prepareInvokeRequest(dynFunc, "add", args, &result);
-    ASSERT_NE(0, rc);
-    EXPECT_STREQ("Error adding arguments array for 'add'", celix_err_popLastError());
-
-    celix_ei_expect_json_string((void*)jsonRpc_prepareInvokeRequest, 0, nullptr);
-    rc = jsonRpc_prepareInvokeRequest(dynFunc, "add", args, &result);
-    ASSERT_NE(0, rc);
-    EXPECT_STREQ("Error setting method name 'add'", celix_err_popLastError());
-
-    celix_ei_expect_json_array_append_new((void*)jsonRpc_prepareInvokeRequest, 0, -1);
-    rc = jsonRpc_prepareInvokeRequest(dynFunc, "add", args, &result);
-    ASSERT_NE(0, rc);
-    EXPECT_STREQ("Error adding argument (1) for 'add'", celix_err_popLastError());
-
-    celix_ei_expect_json_dumps((void*)jsonRpc_prepareInvokeRequest, 0, nullptr);
+    celix_ei_expect_calloc((void*)jsonRpc_prepareInvokeRequest, 4, nullptr);
     rc = jsonRpc_prepareInvokeRequest(dynFunc, "add", args, &result);
     ASSERT_NE(0, rc);
+    EXPECT_EQ(nullptr, result);
+    EXPECT_STREQ("Failed to serialize args for function 'add'\n", celix_err_popLastError());
+    EXPECT_STREQ("Error allocating memory for serializer plan of type 'D'", celix_err_popLastError());
 
     dynFunction_destroy(dynFunc);
 }
@@ -123,7 +108,7 @@ TEST_F(JsonRpcErrorInjectionTestSuite, preOutParamterSerializationFailureTest) {
     char *result = nullptr;
     tst_serv serv {nullptr, add, nullptr, nullptr, nullptr};
 
-    celix_ei_expect_json_real((void*)jsonSerializer_serializeJson, 2, nullptr);
+    celix_ei_expect_calloc((void*)jsonSerializer_serializeToWriter, 2, nullptr);
     rc = jsonRpc_call(intf, &serv, R"({"m":"add(DD)D", "a": [1.0,2.0]})", &result);
     ASSERT_NE(0, rc);
     EXPECT_EQ(nullptr, result);
@@ -142,7 +127,7 @@ TEST_F(JsonRpcErrorInjectionTestSuite, outParamterSerializationFailureTest) {
     char *result = nullptr;
     tst_serv serv {nullptr, nullptr, nullptr, nullptr, stats};
 
-    celix_ei_expect_json_object((void*)jsonSerializer_serializeJson, 3, nullptr);
+    celix_ei_expect_calloc((void*)jsonSerializer_serializeToWriter, 2, nullptr);
     rc = jsonRpc_call(intf, &serv, R"({"m":"stats([D)LStatsResult;", "a": [[1.0,2.0]]})", &result);
     ASSERT_NE(0, rc);
     EXPECT_STREQ("Error serializing result for stats([D)LStatsResult;", celix_err_popLastError());
@@ -162,7 +147,13 @@ TEST_F(JsonRpcErrorInjectionTestSuite, responsePayloadGenerationErrorTest) {
     char *result = nullptr;
     tst_serv serv {nullptr, add, nullptr, nullptr, nullptr};
 
-    celix_ei_expect_json_object((void*)jsonRpc_call, 0, nullptr);
+    celix_ei_expect_celix_jsonWriter_writeRaw((void*)jsonRpc_callWithJson, 0, ENOMEM);
+    rc = jsonRpc_call(intf, &serv, R"({"m":"add(DD)D", "a": [1.0,2.0]})", &result);
+    ASSERT_NE(0, rc);
+    EXPECT_EQ(nullptr, result);
+    EXPECT_STREQ("Error generating response payload for add(DD)D", celix_err_popLastError());
+
+    celix_ei_expect_celix_jsonWriter_writeChar((void*)jsonRpc_callWithJson, 0, ENOMEM);
     rc = jsonRpc_call(intf, &serv, R"({"m":"add(DD)D", "a": [1.0,2.0]})", &result);
     ASSERT_NE(0, rc);
     EXPECT_EQ(nullptr, result);
@@ -181,9 +172,10 @@ TEST_F(JsonRpcErrorInjectionTestSuite, responseRenderingErrorTest) {
     char *result = nullptr;
     tst_serv serv {nullptr, add, nullptr, nullptr, nullptr};
 
-    celix_ei_expect_json_dumps((void*)jsonRpc_call, 0, nullptr);
+    celix_ei_expect_celix_jsonWriter_steal((void*)jsonRpc_callWithJson, 0, nullptr);
     rc = jsonRpc_call(intf, &serv, R"({"m":"add(DD)D", "a": [1.0,2.0]})", &result);
     ASSERT_NE(0, rc);
     EXPECT_EQ(nullptr, result);
+    EXPECT_STREQ("Error generating response payload for add(DD)D", celix_err_popLastError());
     dynInterface_destroy(intf);
-}
\ No newline at end of file
+}
@@ -20,6 +20,7 @@
 #include "gtest/gtest.h"
 
 #include <float.h>
+#include <math.h>
 #include <assert.h>
 
 extern "C" {
@@ -1018,6 +1019,87 @@ TEST_F(JsonRpcTests, callOutReference) {
     dynInterface_destroy(intf);
 }
 
+TEST_F(JsonRpcTests, callWithParsedJsonRequest) {
+    dyn_interface_type *intf = nullptr;
+    FILE *desc = fopen("descriptors/example1.descriptor", "r");
+    ASSERT_TRUE(desc != nullptr);
+    int rc = dynInterface_parse(desc, &intf);
+    ASSERT_EQ(0, rc);
+    fclose(desc);
+
+    char *result = nullptr;
+    tst_serv serv {nullptr, add, nullptr, nullptr, stats};
+
+    json_auto_t* request = json_loads(R"({"m":"stats([D)LStatsResult;", "a": [[1.0,2.0]]})", 0, nullptr);
+    ASSERT_NE(nullptr, request);
+    rc = jsonRpc_callWithJson(intf, &serv, request, &result);
+    ASSERT_EQ(0, rc);
+    ASSERT_TRUE(strstr(result, "1.5") != nullptr);
+    free(result);
+
+    //the parsed request is not modified, so it can be used again
+    rc = jsonRpc_callWithJson(intf, &serv, request, &result);
+    ASSERT_EQ(0, rc);
+    ASSERT_TRUE(strstr(result, "1.5") != nullptr);
+    free(result);
+
+    json_auto_t* invalidRequest = json_loads(R"({"a": [1.0,2.0]})", 0, nullptr);
+    ASSERT_NE(nullptr, invalidRequest);
+    rc = jsonRpc_callWithJson(intf, &serv, invalidRequest, &result);
+    ASSERT_EQ(1, rc);
+    EXPECT_STREQ("Error getting method signature", celix_err_popLastError());
+    celix_err_resetErrors();
+
+    dynInterface_destroy(intf);
+}
+
+TEST_F(JsonRpcTests, callWithMethodIndex) {
+    dyn_interface_type *intf = nullptr;
+    FILE *desc = fopen("descriptors/example1.descriptor", "r");
+    ASSERT_TRUE(desc != nullptr);
+    int rc = dynInterface_parse(desc, &intf);
+    ASSERT_EQ(0, rc);
+    fclose(desc);
+
+    char *result = nullptr;
+    tst_serv serv {nullptr, add, nullptr, nullptr, stats};
+
+    //add(DD)D is the first method of example1
+    rc = jsonRpc_call(intf, &serv, R"({"m":0, "a": [1.0,2.0]})", &result);
+    ASSERT_EQ(0, rc);
+    ASSERT_TRUE(strstr(result, "3.0") != nullptr);
+    free(result);
+
+    rc = jsonRpc_call(intf, &serv, R"({"m":4, "a": [1.0,2.0]})", &result);
+    ASSERT_EQ(1, rc);
+    EXPECT_STREQ("Cannot find method with index 4", celix_err_popLastError());
+    celix_err_resetErrors();
+
+    rc = jsonRpc_call(intf, &serv, R"({"m":-1, "a": [1.0,2.0]})", &result);
+    ASSERT_EQ(1, rc);
+    EXPECT_STREQ("Cannot find method with index -1", celix_err_popLastError());
+    celix_err_resetErrors();
+
+    //a method index request is prepared using jsonRpc_prepareInvokeRequestWithIndex
+    const struct method_entry* method = dynInterface_findMethod(intf, "add(DD)D");
+    ASSERT_NE(nullptr, method);
+    void *handle = nullptr;
+    double arg1 = 1.0;
+    double arg2 = 2.0;
+    void *args[4] = {&handle, &arg1, &arg2, nullptr};
+    char *request = nullptr;
+    rc = jsonRpc_prepareInvokeRequestWithIndex(method->dynFunc, method->index, args, &request);
+    ASSERT_EQ(0, rc);
+    ASSERT_STREQ(R"({"m":0,"a":[1.0,2.0]})", request);
+    rc = jsonRpc_call(intf, &serv, request, &result);
+    ASSERT_EQ(0, rc);
+    ASSERT_TRUE(strstr(result, "3.0") != nullptr);
+    free(result);
+    free(request);
+
+    dynInterface_destroy(intf);
+}
+
 TEST_F(JsonRpcTests, callTestInvalidRequest) {
     callTestInvalidRequest();
 }
@@ -1465,4 +1547,116 @@ TEST_F(JsonRpcTests, callEmptyArrayListOutTest) {
     ASSERT_NE(0, rc);
 
     dynInterface_destroy(intf);
-}
\ No newline at end of file
+}
+
+TEST_F(JsonRpcTests, prepareInvalidRequestTest) {
+    dyn_function_type *dynFunc = nullptr;
+    int rc = dynFunction_parseWithStr("add(#am=handle;PDD#am=pre;*D)N", nullptr, &dynFunc);
+    ASSERT_EQ(0, rc);
+
+    void *handle = nullptr;
+    double arg1 = 1.0;
+    double arg2 = 2.0;
+    void *args[4] = {&handle, &arg1, &arg2, nullptr};
+    char *result = nullptr;
+
+    //method id is not valid UTF-8
+    rc = jsonRpc_prepareInvokeRequest(dynFunc, "add\xff", args, &result);
+    EXPECT_NE(0, rc);
+    EXPECT_EQ(nullptr, result);
+    EXPECT_STREQ("Error setting method name 'add\xff'", celix_err_popLastError());
+
+    //NaN cannot be represented in JSON
+    arg2 = NAN;
+    rc = jsonRpc_prepareInvokeRequest(dynFunc, "add", args, &result);
+    EXPECT_NE(0, rc);
+    EXPECT_EQ(nullptr, result);
+    EXPECT_STREQ("Failed to serialize args for function 'add'\n", celix_err_popLastError());
+    EXPECT_STREQ("Cannot serialize non-finite real value", celix_err_popLastError());
+
+    dynFunction_destroy(dynFunc);
+}
+
+TEST_F(JsonRpcTests, callWithNonFiniteResultTest) {
+    dyn_interface_type *intf = nullptr;
+    FILE *desc = fopen("descriptors/example1.descriptor", "r");
+    ASSERT_TRUE(desc != nullptr);
+    int rc = dynInterface_parse(desc, &intf);
+    ASSERT_EQ(0, rc);
+    fclose(desc);
+
+    char *result = nullptr;
+    tst_serv serv {nullptr, [](void*, double, double, double* out) -> int {
+        *out = INFINITY;
+        return 0;
+    }, nullptr, nullptr, nullptr};
+
+    rc = jsonRpc_call(intf, &serv, R"({"m":"add(DD)D", "a": [1.0,2.0]})", &result);
+    EXPECT_NE(0, rc);
+    EXPECT_EQ(nullptr, result);
+    EXPECT_STREQ("Error serializing result for add(DD)D", celix_err_popLastError());
+
+    dynInterface_destroy(intf);
+}
+
+TEST_F(JsonRpcTests, handleReplyVariantsTest) {
+    dyn_function_type *dynFunc = nullptr;
+    int rc = dynFunction_parseWithStr("add(#am=handle;PDD#am=pre;*D)N", nullptr, &dynFunc);
+    ASSERT_EQ(0, rc);
+
+    double result = -1.0;
+    double *out = &result;
+    void *args[4];
+    args[3] = &out;
+    int rsErrno = 0;
+
+    //whitespace and key order do not matter
+    rc = jsonRpc_handleReply(dynFunc, " { \"r\" : 1.5e1 } \n", args, &rsErrno);
+    ASSERT_EQ(0, rc);
+    EXPECT_EQ(0, rsErrno);
+    EXPECT_DOUBLE_EQ(15.0, result);
+
+    //duplicate keys are handled as before (by the json_t based path)
+    result = -1.0;
+    rc = jsonRpc_handleReply(dynFunc, R"({"r":2.0,"r":3.0})", args, &rsErrno);
+    ASSERT_EQ(0, rc);
+    EXPECT_DOUBLE_EQ(3.0, result);
+
+    //an error reply
+    rc = jsonRpc_handleReply(dynFunc, R"({"e":5})", args, &rsErrno);
+    ASSERT_EQ(0, rc);
+    EXPECT_EQ(5, rsErrno);
+
+    //trailing data is rejected
+    rsErrno = 0;
+    rc = jsonRpc_handleReply(dynFunc, R"({"r":2.0} x)", args, &rsErrno);
+    EXPECT_NE(0, rc);
+    celix_err_resetErrors();
+
+    dynFunction_destroy(dynFunc);
+}
+
+TEST_F(JsonRpcTests, handleTextReplyTest) {
+    dyn_function_type *dynFunc = nullptr;
+    int rc = dynFunction_parseWithStr("getName(#am=handle;P#am=out;*t)N", nullptr, &dynFunc);
+    ASSERT_EQ(0, rc);
+
+    char *name = nullptr;
+    char **out = &name;
+    void *args[2];
+    args[1] = &out;
+    int rsErrno = 0;
+
+    rc = jsonRpc_handleReply(dynFunc, R"({"r":"esc\"aped é"})", args, &rsErrno);
+    ASSERT_EQ(0, rc);
+    EXPECT_EQ(0, rsErrno);
+    EXPECT_STREQ("esc\"aped \xc3\xa9", name);
+    free(name);
+
+    name = nullptr;
+    rc = jsonRpc_handleReply(dynFunc, R"({"r":null})", args, &rsErrno);
+    ASSERT_EQ(0, rc);
+    EXPECT_EQ(nullptr, name);
+
+    dynFunction_destroy(dynFunc);
+}
@@ -260,4 +260,30 @@ TEST_F(JsonSerializerErrorInjectionTestSuite, SerializationArrayListErrorTest) {
     ASSERT_NE(0, rc);
 
     dynType_destroy(type);
-}
\ No newline at end of file
+}
+
+TEST_F(JsonSerializerErrorInjectionTestSuite, SerializationPlanAllocationErrorTest) {
+    dyn_type *type;
+    auto rc = dynType_parseWithStr("{DD a b}", nullptr, nullptr, &type);
+    ASSERT_EQ(0, rc);
+
+    test_struct ex {1.0, 2.0};
+    json_auto_t* result = nullptr;
+    celix_ei_expect_calloc((void*)jsonSerializer_serializeJson, 2, nullptr);
+    rc = jsonSerializer_serializeJson(type, &ex, &result);
+    ASSERT_NE(0, rc);
+    EXPECT_STREQ("Error allocating memory for serializer plan of type '{'", celix_err_popLastError());
+
+    void* inst = nullptr;
+    json_auto_t* input = json_loads(R"({"a":1.0, "b":2.0})", 0, nullptr);
+    celix_ei_expect_calloc((void*)jsonSerializer_deserializeJson, 3, nullptr);
+    rc = jsonSerializer_deserializeJson(type, input, &inst);
+    ASSERT_NE(0, rc);
+    EXPECT_STREQ("Error allocating memory for serializer plan of type '{'", celix_err_popLastError());
+
+    //the plan is created (and cached) once it can be allocated
+    rc = jsonSerializer_serializeJson(type, &ex, &result);
+    ASSERT_EQ(0, rc);
+
+    dynType_destroy(type);
+}
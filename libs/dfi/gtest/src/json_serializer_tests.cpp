@@ -19,6 +19,9 @@
 
 #include "gtest/gtest.h"
 
+#include <thread>
+#include <vector>
+
 extern "C" {
 #include <stdio.h>
 #include <stdint.h>
@@ -29,6 +32,7 @@ extern "C" {
 #include <ffi.h>
 
 #include "dyn_type_common.h"
+#include "dyn_serializer_plan.h"
 #include "dyn_common.h"
 #include "dyn_type.h"
 #include "json_serializer.h"
@@ -1145,4 +1149,102 @@ TEST_F(JsonSerializerTests, DeserilizationArrayListWithInvalidElementTest) {
     rc = jsonSerializer_deserializeJson(type, root, &inst);
     ASSERT_NE(0, rc);
     dynType_destroy(type);
-}
\ No newline at end of file
+}
+
+struct nested_item {
+    double a;
+    double b;
+};
+
+struct nested_example {
+    double a;
+    struct {
+        int32_t x;
+        int32_t y;
+    } b;
+    struct {
+        uint32_t cap;
+        uint32_t len;
+        nested_item* buf;
+    } c;
+    char* d;
+};
+
+TEST_F(JsonSerializerTests, SerializationPlanIsCachedOnTypeTest) {
+    dyn_type *type;
+    auto rc = dynType_parseWithStr("{D{II x y}[{DD a b}t a b c d}", nullptr, nullptr, &type);
+    ASSERT_EQ(0, rc);
+    EXPECT_EQ(nullptr, type->cache);
+
+    nested_item items[2] = {{1.0, 2.0}, {3.0, 4.0}};
+    nested_example ex{};
+    ex.a = 0.5;
+    ex.b.x = 1;
+    ex.b.y = 2;
+    ex.c.cap = 2;
+    ex.c.len = 2;
+    ex.c.buf = items;
+    ex.d = (char*)"hello";
+
+    json_auto_t* result = nullptr;
+    rc = jsonSerializer_serializeJson(type, &ex, &result);
+    ASSERT_EQ(0, rc);
+    json_auto_t* expected = json_loads(R"({"a":0.5,"b":{"x":1,"y":2},"c":[{"a":1.0,"b":2.0},{"a":3.0,"b":4.0}],"d":"hello"})", 0, nullptr);
+    EXPECT_TRUE(json_equal(expected, result));
+
+    //nested struct members are flattened in the plan of the root type
+    auto plan = reinterpret_cast<const dyn_serializer_plan*>(type->cache);
+    ASSERT_NE(nullptr, plan);
+    EXPECT_EQ(7, plan->nrOfOps);
+    EXPECT_EQ(offsetof(nested_example, b.y), plan->ops[4].offset);
+    EXPECT_EQ(offsetof(nested_example, d), plan->ops[6].offset);
+
+    void* inst = nullptr;
+    rc = jsonSerializer_deserializeJson(type, result, &inst);
+    ASSERT_EQ(0, rc);
+    auto parsed = static_cast<nested_example*>(inst);
+    EXPECT_EQ(2, parsed->b.y);
+    ASSERT_EQ(2, parsed->c.len);
+    EXPECT_EQ(4.0, parsed->c.buf[1].b);
+    EXPECT_STREQ("hello", parsed->d);
+
+    json_auto_t* result2 = nullptr;
+    rc = jsonSerializer_serializeJson(type, inst, &result2);
+    ASSERT_EQ(0, rc);
+    EXPECT_TRUE(json_equal(expected, result2));
+    EXPECT_EQ(&plan->cache, type->cache);
+
+    dynType_free(type, inst);
+    dynType_destroy(type);
+}
+
+TEST_F(JsonSerializerTests, ConcurrentSerializationTest) {
+    dyn_type *type;
+    auto rc = dynType_parseWithStr("{D{II x y}[{DD a b}t a b c d}", nullptr, nullptr, &type);
+    ASSERT_EQ(0, rc);
+
+    nested_item items[1] = {{1.0, 2.0}};
+    nested_example ex{};
+    ex.c.cap = 1;
+    ex.c.len = 1;
+    ex.c.buf = items;
+
+    std::vector<std::thread> threads{};
+    std::vector<int> results(8, -1);
+    for (size_t i = 0; i < results.size(); ++i) {
+        threads.emplace_back([&, i] {
+            char* out = nullptr;
+            results[i] = jsonSerializer_serialize(type, &ex, &out);
+            free(out);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (auto result : results) {
+        EXPECT_EQ(0, result);
+    }
+    EXPECT_NE(nullptr, type->cache);
+
+    dynType_destroy(type);
+}
@@ -0,0 +1,118 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef __BINARY_RPC_H_
+#define __BINARY_RPC_H_
+
+#include <stddef.h>
+#include "dyn_type.h"
+#include "dyn_function.h"
+#include "dyn_interface.h"
+#include "celix_dfi_export.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file binary_rpc.h
+ * @brief Remote procedure calls using the binary encoding of binary_serializer.h.
+ *
+ * A request consists of the uint32 method index (see dynInterface_findMethodByIndex) followed by the binary encoding
+ * of the standard arguments. A reply consists of a byte 0 followed by the binary encoding of the output argument
+ * (if any), or a byte 1 followed by the int32 return status of the remote service function.
+ *
+ * Both sides must use an identical interface descriptor.
+ *
+ * The callee of a const sequence argument (e.g. `#const=true;[D`) must not modify or keep its items. If the items are
+ * copied as a whole (see binary_serializer.h) and are suitably aligned in the request, binaryRpc_call passes such a
+ * sequence as a view into the request instead of as a copy. So a request in shared memory is not copied at all.
+ */
+
+/**
+ * @brief Call a service using a binary RPC request.
+ *
+ * Caller is the owner of the out parameter and should release it using free.
+ *
+ * In case of an error, an error message is added to celix_err.
+ *
+ * @param[in] intf The interface type of the service to call.
+ * @param[in] service The service to call.
+ * @param[in] request The binary RPC request.
+ * @param[in] requestSize The size of the binary RPC request.
+ * @param[out] out The binary RPC reply.
+ * @param[out] outSize The size of the binary RPC reply.
+ * @return 0 if successful, otherwise 1.
+ *
+ */
+CELIX_DFI_EXPORT int binaryRpc_call(const dyn_interface_type* intf, void* service, const void* request,
+                                    size_t requestSize, void** out, size_t* outSize);
+
+/**
+ * @brief Get the method index of a binary RPC request.
+ *
+ * In case of an error, an error message is added to celix_err.
+ *
+ * @param[in] request The binary RPC request.
+ * @param[in] requestSize The size of the binary RPC request.
+ * @param[out] index The method index.
+ * @return 0 if successful, otherwise 1.
+ *
+ */
+CELIX_DFI_EXPORT int binaryRpc_getMethodIndex(const void* request, size_t requestSize, int* index);
+
+/**
+ * @brief Prepare a binary RPC request for a given function.
+ *
+ * Caller is the owner of the out parameter and should release it using free.
+ *
+ * In case of an error, an error message is added to celix_err.
+ *
+ * @param[in] func The function type to prepare the request for.
+ * @param[in] index The method index of the function.
+ * @param[in] args The arguments to use for the function.
+ * @param[out] out The binary RPC request.
+ * @param[out] outSize The size of the binary RPC request.
+ * @return 0 if successful, otherwise 1.
+ *
+ */
+CELIX_DFI_EXPORT int binaryRpc_prepareInvokeRequest(const dyn_function_type* func, int index, void* args[],
+                                                    void** out, size_t* outSize);
+
+/**
+ * @brief Handle a binary RPC reply for a given function.
+ *
+ * In case of an error, an error message is added to celix_err.
+ *
+ * @param[in] func The function type to handle the reply for.
+ * @param[in] reply The binary RPC reply.
+ * @param[in] replySize The size of the binary RPC reply.
+ * @param[out] args The arguments to use for the function.
+ * @param[out] rsErrno The return status of the function.
+ * @return 0 if successful, otherwise 1.
+ *
+ */
+CELIX_DFI_EXPORT int binaryRpc_handleReply(const dyn_function_type* func, const void* reply, size_t replySize,
+                                           void* args[], int* rsErrno);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,85 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef __BINARY_SERIALIZER_H_
+#define __BINARY_SERIALIZER_H_
+
+#include <stddef.h>
+#include "dyn_type.h"
+#include "celix_dfi_export.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file binary_serializer.h
+ * @brief Compact binary (de)serialization of dyn type values.
+ *
+ * The binary encoding is positional: both sides must use the same type descriptor.
+ * All numbers are encoded little-endian, independent of the host byte order:
+ *  - Numbers (B, S, I, J, b, s, i, j, F, D) use their own size, bools (Z) 1 byte, native ints (N) and enums (E) 4 bytes.
+ *  - Texts (t) are encoded as a uint32 length followed by the (not '\0' terminated) characters. A NULL text has
+ *    length UINT32_MAX. Properties (p) and array lists (a) are encoded as text containing their strict JSON encoding.
+ *  - Sequences ([) are encoded as a uint32 length followed by the items.
+ *  - Typed pointers (*) are encoded as a byte 0 (NULL) or 1 followed by the pointed to value.
+ *  - Complex types ({) are encoded as the concatenation of their members.
+ *
+ * Values only consisting of numbers without padding (e.g. a sequence of doubles or of a struct of ints)
+ * are copied as a whole on little-endian hosts.
+ */
+
+/**
+ * @brief Serialize a given type to its binary encoding.
+ *
+ * Caller is the owner of the out parameter and should release it using free.
+ *
+ * In case of an error, an error message is added to celix_err.
+ *
+ * @param[in] type The type to serialize.
+ * @param[in] input The input to serialize.
+ * @param[out] output The serialized result.
+ * @param[out] outputSize The size of the serialized result.
+ * @return 0 if successful, otherwise 1.
+ *
+ */
+CELIX_DFI_EXPORT int binarySerializer_serialize(const dyn_type* type, const void* input, void** output, size_t* outputSize);
+
+/**
+ * @brief Deserialize a binary encoding to a given type.
+ *
+ * The input must contain exactly one encoded value.
+ * Caller is the owner of the out parameter and should release it using dynType_free.
+ *
+ * In case of an error, an error message is added to celix_err.
+ *
+ * @param[in] type The type to deserialize to.
+ * @param[in] input The binary encoding to deserialize.
+ * @param[in] inputSize The size of the binary encoding.
+ * @param[out] result The deserialized result.
+ * @return 0 if successful, otherwise 1.
+ *
+ */
+CELIX_DFI_EXPORT int binarySerializer_deserialize(const dyn_type* type, const void* input, size_t inputSize, void** result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -141,6 +141,8 @@ CELIX_DEFINE_AUTOPTR_CLEANUP_FUNC(dyn_function_type, dynFunction_destroy);
 
 /**
  * @brief Calls the given dynamic type function.
+ *
+ * If a generated call stub is set for the function (see dynInterface_setStubs), the stub is used instead of libffi.
  * @param[in] dynFunc The dynamic type instance for function.
  * @param[in] fn The function pointer to call.
  * @param[in] returnValue The return value pointer.
@@ -169,6 +171,27 @@ CELIX_DFI_EXPORT int dynFunction_createClosure(dyn_function_type* func, void (*b
  */
 CELIX_DFI_EXPORT int dynFunction_getFnPointer(const dyn_function_type* func, void (**fn)(void));
 
+/**
+ * @brief Returns the bind function and user data of the closure of the given dynamic function type instance.
+ * @param[in] func The dynamic type instance for function.
+ * @param[out] bind The bind function used to create the closure.
+ * @param[out] userData The user data used to create the closure.
+ * @return 0 If successful, 2 if no closure is created for the dynamic function type instance.
+ */
+CELIX_DFI_EXPORT int dynFunction_getClosureBind(const dyn_function_type* func,
+                                                void (**bind)(void*, void**, void*),
+                                                void** userData);
+
+/**
+ * @brief Returns the generated proxy stub of the given dynamic function type instance.
+ *
+ * The proxy stub is set using dynInterface_setStubs and can be used instead of a closure, see dyn_stubs.h.
+ * @param[in] func The dynamic type instance for function.
+ * @param[out] fn The proxy stub.
+ * @return 0 If successful, non-zero if the dynamic function type instance has no proxy stub.
+ */
+CELIX_DFI_EXPORT int dynFunction_getProxyStub(const dyn_function_type* func, void (**fn)(void));
+
 /**
  * Returns whether the function has a return type.
  * Will return false if return is void.
@@ -22,6 +22,7 @@
 
 #include "dyn_type.h"
 #include "dyn_function.h"
+#include "dyn_stubs.h"
 #include "celix_cleanup.h"
 #include "celix_version.h"
 #include "celix_dfi_export.h"
@@ -146,6 +147,30 @@ CELIX_DFI_EXPORT int dynInterface_nrOfMethods(const dyn_interface_type* intf);
  */
 CELIX_DFI_EXPORT const struct method_entry* dynInterface_findMethod(const dyn_interface_type* intf, const char* id);
 
+/**
+ * @brief Finds and returns the method_entry structure for a given method index in the dynamic interface type instance.
+ * The dynamic interface type instance is the owner of the returned method_entry structure and it should not be freed.
+ *
+ * @param[in] intf The dynamic interface type instance.
+ * @param[in] index The index of the method to find, which is the position of the method in the methods section.
+ * @return The method_entry structure for the given method index, or NULL if the index is out of range.
+ */
+CELIX_DFI_EXPORT const struct method_entry* dynInterface_findMethodByIndex(const dyn_interface_type* intf, int index);
+
+/**
+ * @brief Sets the generated stubs of the methods of the given dynamic interface type instance.
+ *
+ * The stubs must match the interface: same name, version, number of methods and method ids (in index order).
+ * Stubs should be set before the dynamic interface type instance is shared between threads, and the stubs must
+ * outlive the dynamic interface type instance. See dyn_stubs.h.
+ * In case of an error, an error message is added to celix_err.
+ *
+ * @param[in] intf The dynamic interface type instance.
+ * @param[in] stubs The generated stubs of the interface.
+ * @return 0 if successful, 1 if the stubs do not match the interface.
+ */
+CELIX_DFI_EXPORT int dynInterface_setStubs(dyn_interface_type* intf, const dyn_interface_stubs_t* stubs);
+
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,85 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef __DYN_STUBS_H_
+#define __DYN_STUBS_H_
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file dyn_stubs.h
+ * @brief Build-time generated stubs for the methods of an interface descriptor.
+ *
+ * The stubs are generated by celix_dfi_stub_generator (see the celix_target_dfi_stubs CMake function) and are
+ * plain C functions with the exact signature of the described methods. Once set on a dyn_interface_type using
+ * dynInterface_setStubs, they replace the libffi call and closure machinery:
+ *  - dynFunction_call uses the call stub of a method instead of ffi_call.
+ *  - dynFunction_getProxyStub returns a proxy function that can be used instead of a closure.
+ *
+ * A proxy stub packs its arguments the way a closure does and forwards them to the invoke function of the
+ * dyn_stub_proxy_handle_t, which must therefore be the first member of the handle of a proxy service.
+ */
+
+/**
+ * @brief A generated call stub: calls fn with the arguments in args and stores the result in returnValue.
+ *
+ * In contrast to ffi_call, integral return values are not widened; dynFunction_call takes care of that.
+ */
+typedef void (*dyn_stub_call_fp)(void (*fn)(void), void* args[], void* returnValue);
+
+/**
+ * @brief The handle of a proxy service using generated proxy stubs.
+ */
+typedef struct dyn_stub_proxy_handle {
+    /**
+     * @brief Called by a proxy stub, with the same args and returnValue a closure bind function gets.
+     * @param[in] handle The proxy handle, i.e. the first argument of the proxied call.
+     * @param[in] methodIndex The index of the called method.
+     */
+    void (*invoke)(struct dyn_stub_proxy_handle* handle, int methodIndex, void* args[], void* returnValue);
+} dyn_stub_proxy_handle_t;
+
+/**
+ * @brief The generated stubs of a single method.
+ */
+typedef struct dyn_stub_method {
+    const char* id; ///< The method id, as in the interface descriptor.
+    dyn_stub_call_fp call; ///< The call stub.
+    void (*proxy)(void); ///< The proxy stub, NULL if the method has no handle argument.
+} dyn_stub_method_t;
+
+/**
+ * @brief The generated stubs of an interface descriptor.
+ */
+typedef struct dyn_interface_stubs {
+    const char* name; ///< The interface name, as in the interface descriptor.
+    const char* version; ///< The interface version, as in the interface descriptor.
+    size_t nrOfMethods; ///< The number of methods.
+    const dyn_stub_method_t* methods; ///< The method stubs, ordered on method index.
+} dyn_interface_stubs_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -46,6 +46,25 @@ extern "C" {
  */
 CELIX_DFI_EXPORT int jsonRpc_call(const dyn_interface_type* intf, void* service, const char* request, char** out);
 
+/**
+ * @brief Call a remote service using an already parsed JSON-RPC request.
+ *
+ * Same as jsonRpc_call, but avoids parsing the request again if the caller already needed the parsed request
+ * (e.g. to retrieve the method signature).
+ * The method ("m") of the request can be a method id or a method index (see jsonRpc_prepareInvokeRequestWithIndex).
+ * Caller is the owner of the out parameter and should release it using free.
+ *
+ * In case of an error, an error message is added to celix_err.
+ *
+ * @param[in] intf The interface type of the service to call.
+ * @param[in] service The service to call.
+ * @param[in] request The parsed JSON-RPC request. The request is not modified.
+ * @param[out] out The JSON-RPC reply.
+ * @return 0 if successful, otherwise 1.
+ *
+ */
+CELIX_DFI_EXPORT int jsonRpc_callWithJson(const dyn_interface_type* intf, void* service, const json_t* request, char** out);
+
 /**
  * @brief Prepare a JSON-RPC request for a given function.
  *
@@ -62,6 +81,26 @@ CELIX_DFI_EXPORT int jsonRpc_call(const dyn_interface_type* intf, void* service,
  */
 CELIX_DFI_EXPORT int jsonRpc_prepareInvokeRequest(const dyn_function_type* func, const char* id, void* args[], char** out);
 
+/**
+ * @brief Prepare a JSON-RPC request for a given function, using the method index instead of the method id.
+ *
+ * The method index is the position of the method in the interface descriptor (see dynInterface_findMethodByIndex).
+ * This results in a smaller request, which can be handled without a signature lookup, but it should only be used if
+ * the remote side uses an identical interface descriptor.
+ *
+ * Caller is the owner of the out parameter and should release it using free.
+ *
+ * In case of an error, an error message is added to celix_err.
+ *
+ * @param[in] func The function type to prepare the request for.
+ * @param[in] index The method index.
+ * @param[in] args The arguments to use for the function.
+ * @param[out] out The JSON-RPC request.
+ * @return 0 if successful, otherwise 1.
+ *
+ */
+CELIX_DFI_EXPORT int jsonRpc_prepareInvokeRequestWithIndex(const dyn_function_type* func, int index, void* args[], char** out);
+
 /**
  * @brief Handle a JSON-RPC reply for a given function.
  *
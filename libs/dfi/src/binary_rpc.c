@@ -0,0 +1,289 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "binary_rpc.h"
+#include "binary_serializer_common.h"
+#include "rpc_common.h"
+#include "dyn_type.h"
+#include "dyn_type_common.h"
+#include "dyn_interface.h"
+#include "celix_err.h"
+#include "celix_stdlib_cleanup.h"
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <ffi.h>
+
+#define BINARY_RPC_REPLY_RESULT     0
+#define BINARY_RPC_REPLY_ERROR      1
+
+static int OK = 0;
+static int ERROR = 1;
+
+/**
+ * The sequence arguments of a call that are views into the request, see binarySerializer_readView.
+ */
+typedef struct binary_rpc_views {
+    void** args;
+    uint32_t mask; //bit i is set if args[i] is a view
+} binary_rpc_views_t;
+
+static void binaryRpc_resetViews(binary_rpc_views_t* views) {
+    for (int i = 0; i < CELIX_RPC_MAX_ARGS; ++i) {
+        if ((views->mask & (1u << i)) != 0) {
+            //the items are not owned, so the sequence is released as an empty sequence
+            memset(views->args[i], 0, sizeof(struct generic_sequence));
+        }
+    }
+    views->mask = 0;
+}
+
+CELIX_DEFINE_AUTO_CLEANUP_CLEAR_FUNC(binary_rpc_views_t, binaryRpc_resetViews)
+
+static bool binaryRpc_isConstArg(const dyn_function_argument_type* entry) {
+    const char* isConst = dynType_getMetaInfo(entry->type, "const");
+    return isConst != NULL && strcmp("true", isConst) == 0;
+}
+
+int binaryRpc_getMethodIndex(const void* request, size_t requestSize, int* index) {
+    binary_reader_t reader = {request, (const char*)request + requestSize};
+    uint32_t value = 0;
+    if (binaryReader_readUint32(&reader, &value) != OK || value > INT_MAX) {
+        celix_err_push("Error reading method index of binary request");
+        return ERROR;
+    }
+    *index = (int)value;
+    return OK;
+}
+
+int binaryRpc_call(const dyn_interface_type* intf, void* service, const void* request, size_t requestSize,
+                   void** out, size_t* outSize) {
+    int status = OK;
+    int index = 0;
+    if (binaryRpc_getMethodIndex(request, requestSize, &index) != OK) {
+        return ERROR;
+    }
+    const struct method_entry* method = dynInterface_findMethodByIndex(intf, index);
+    if (method == NULL) {
+        celix_err_pushf("Cannot find method with index %d", index);
+        return ERROR;
+    }
+    const char* sig = method->id;
+    binary_reader_t reader = {(const char*)request + sizeof(uint32_t), (const char*)request + requestSize};
+
+    struct generic_service_layout* serv = service;
+    const struct dyn_function_arguments_head* dynArgs = dynFunction_arguments(method->dynFunc);
+    const dyn_function_argument_type* last = TAILQ_LAST(dynArgs, dyn_function_arguments_head);
+    int nrOfArgs = dynFunction_nrOfArguments(method->dynFunc);
+    if (nrOfArgs > CELIX_RPC_MAX_ARGS) {
+        celix_err_pushf("Too many arguments for %s: %d > %d", sig, nrOfArgs, CELIX_RPC_MAX_ARGS);
+        return ERROR;
+    }
+    void* ptr = NULL;
+    void* ptrToPtr = &ptr;
+    celix_auto(celix_rpc_args_t) rpcArgs = { dynArgs, {0} };
+    //declared after rpcArgs, so that the views are reset before the arguments are released
+    celix_auto(binary_rpc_views_t) views = { rpcArgs.args, 0 };
+
+    rpcArgs.args[0] = &serv->handle;
+    if (last->argumentMeta == DYN_FUNCTION_ARGUMENT_META__PRE_ALLOCATED_OUTPUT) {
+        const dyn_type* subType = dynType_typedPointer_getTypedType(dynType_realType(last->type));
+        rpcArgs.args[last->index] = &ptr;
+        if (dynType_alloc(subType, &ptr) != OK) {
+            celix_err_pushf("Error allocating memory for pre-allocated output argument of %s", sig);
+            return ERROR;
+        }
+    } else if (last->argumentMeta == DYN_FUNCTION_ARGUMENT_META__OUTPUT) {
+        rpcArgs.args[last->index] = &ptrToPtr;
+    }
+
+    //deserialize input
+    dyn_function_argument_type* entry = NULL;
+    TAILQ_FOREACH(entry, dynArgs, entries) {
+        if (entry->argumentMeta != DYN_FUNCTION_ARGUMENT_META__STD) {
+            continue;
+        }
+        void** arg = &rpcArgs.args[entry->index];
+        bool isView = false;
+        if (dynType_alloc(entry->type, arg) != OK) {
+            celix_err_pushf("Error deserializing argument %d for %s", entry->index, sig);
+            return ERROR;
+        }
+        //the callee does not modify or keep a const sequence, so it can use the items in the request
+        int rc = binaryRpc_isConstArg(entry) ? binarySerializer_readView(entry->type, &reader, *arg, &isView)
+                                             : binarySerializer_read(entry->type, &reader, *arg);
+        if (rc != OK) {
+            dynType_free(entry->type, *arg);
+            *arg = NULL;
+            celix_err_pushf("Error deserializing argument %d for %s", entry->index, sig);
+            return ERROR;
+        }
+        if (isView) {
+            views.mask |= 1u << entry->index;
+        }
+    }
+    if (reader.pos != reader.end) {
+        celix_err_pushf("Unexpected trailing data in binary request for %s", sig);
+        return ERROR;
+    }
+
+    ffi_sarg returnVal = 1;
+    (void)dynFunction_call(method->dynFunc, serv->methods[method->index], (void*)&returnVal, rpcArgs.args);
+
+    int funcCallStatus = (int)returnVal;
+    binary_writer_t writer;
+    binaryWriter_init(&writer);
+    if (funcCallStatus == 0) {
+        status = binaryWriter_writeUint8(&writer, BINARY_RPC_REPLY_RESULT);
+        const dyn_type* argType = dynType_realType(last->type);
+        if (status == OK && last->argumentMeta == DYN_FUNCTION_ARGUMENT_META__PRE_ALLOCATED_OUTPUT) {
+            status = binarySerializer_write(dynType_typedPointer_getTypedType(argType), ptr, &writer);
+        } else if (status == OK && last->argumentMeta == DYN_FUNCTION_ARGUMENT_META__OUTPUT) {
+            status = binarySerializer_write(dynType_typedPointer_getTypedType(argType), &ptr, &writer);
+        }
+        if (status != OK) {
+            celix_err_pushf("Error serializing result for %s", sig);
+            binaryWriter_deinit(&writer);
+            return ERROR;
+        }
+    } else {
+        status = binaryWriter_writeUint8(&writer, BINARY_RPC_REPLY_ERROR);
+        status = status == OK ? binaryWriter_writeInt32(&writer, funcCallStatus) : status;
+        if (status != OK) {
+            celix_err_pushf("Error generating response payload for %s", sig);
+            binaryWriter_deinit(&writer);
+            return ERROR;
+        }
+    }
+    *out = writer.data;
+    *outSize = writer.size;
+    return OK;
+}
+
+int binaryRpc_prepareInvokeRequest(const dyn_function_type* func, int index, void* args[], void** out, size_t* outSize) {
+    const char* name = dynFunction_getName(func);
+    binary_writer_t writer;
+    binaryWriter_init(&writer);
+    if (index < 0 || binaryWriter_writeUint32(&writer, (uint32_t)index) != OK) {
+        celix_err_pushf("Error setting method index %d for '%s'", index, name);
+        binaryWriter_deinit(&writer);
+        return ERROR;
+    }
+
+    const struct dyn_function_arguments_head* dynArgs = dynFunction_arguments(func);
+    dyn_function_argument_type* entry = NULL;
+    TAILQ_FOREACH(entry, dynArgs, entries) {
+        if (entry->argumentMeta != DYN_FUNCTION_ARGUMENT_META__STD) {
+            continue;
+        }
+        const dyn_type* type = dynType_realType(entry->type);
+        if (binarySerializer_write(type, args[entry->index], &writer) != OK) {
+            celix_err_pushf("Failed to serialize args for function '%s'", name);
+            binaryWriter_deinit(&writer);
+            return ERROR;
+        }
+        if (celix_argType_isStringOrBuiltInObject(type)) {
+            // we need to get meta info from the original type, which could be a reference, rather than the real type
+            const char* metaArgument = dynType_getMetaInfo(entry->type, "const");
+            if (metaArgument == NULL || strcmp("true", metaArgument) != 0) {
+                //char* or celix_properties_t* or celix_array_list_t* as input -> got ownership -> free it.
+                dynType_cleanup(type, args[entry->index]);
+            }
+        }
+    }
+    *out = writer.data;
+    *outSize = writer.size;
+    return OK;
+}
+
+static int binaryRpc_checkEndOfReply(const dyn_function_type* func, const binary_reader_t* reader) {
+    if (reader->pos != reader->end) {
+        celix_err_pushf("Unexpected trailing data in binary reply for %s", dynFunction_getName(func));
+        return ERROR;
+    }
+    return OK;
+}
+
+int binaryRpc_handleReply(const dyn_function_type* func, const void* reply, size_t replySize, void* args[],
+                          int* rsErrno) {
+    binary_reader_t reader = {reply, (const char*)reply + replySize};
+    uint8_t kind = 0;
+    if (binaryReader_readUint8(&reader, &kind) != OK) {
+        celix_err_push("Error reading binary reply");
+        return ERROR;
+    }
+    *rsErrno = 0;
+    if (kind == BINARY_RPC_REPLY_ERROR) {
+        //get the invocation error of remote service function
+        int32_t error = 0;
+        if (binaryReader_readInt32(&reader, &error) != OK) {
+            celix_err_push("Error reading return status of binary reply");
+            return ERROR;
+        }
+        *rsErrno = error;
+        return OK;
+    } else if (kind != BINARY_RPC_REPLY_RESULT) {
+        celix_err_pushf("Invalid binary reply kind %u", kind);
+        return ERROR;
+    }
+
+    const struct dyn_function_arguments_head* arguments = dynFunction_arguments(func);
+    dyn_function_argument_type* last = TAILQ_LAST(arguments, dyn_function_arguments_head);
+    enum dyn_function_argument_meta meta = last->argumentMeta;
+    if (meta != DYN_FUNCTION_ARGUMENT_META__PRE_ALLOCATED_OUTPUT && meta != DYN_FUNCTION_ARGUMENT_META__OUTPUT) {
+        return OK;
+    }
+    if (reader.pos == reader.end) {
+        celix_err_pushf("Expected result in binary reply for %s", dynFunction_getName(func));
+        return ERROR;
+    }
+    void** lastArg = (void**)args[last->index];
+    if (*lastArg == NULL) {
+        // caller provides nullptr, no need to deserialize
+        return OK;
+    }
+
+    int status = OK;
+    const dyn_type* subType = dynType_typedPointer_getTypedType(dynType_realType(last->type));
+    if (meta == DYN_FUNCTION_ARGUMENT_META__PRE_ALLOCATED_OUTPUT) {
+        //read into a temporary value, so that the pre-allocated output is only changed on success
+        celix_autofree void* tmp = NULL;
+        status = dynType_alloc(subType, &tmp);
+        status = status == OK ? binarySerializer_read(subType, &reader, tmp) : status;
+        status = status == OK ? binaryRpc_checkEndOfReply(func, &reader) : status;
+        if (status == OK) {
+            memcpy(*lastArg, tmp, dynType_size(subType));
+        } else {
+            dynType_cleanup(subType, tmp);
+        }
+    } else {
+        //subType is a text, a built-in object or a typed pointer; the caller provides the location of the pointer
+        void* value = NULL;
+        status = binarySerializer_read(subType, &reader, &value);
+        status = status == OK ? binaryRpc_checkEndOfReply(func, &reader) : status;
+        if (status == OK) {
+            *(void**)*lastArg = value;
+        } else {
+            dynType_cleanup(subType, &value);
+        }
+    }
+    return status;
+}
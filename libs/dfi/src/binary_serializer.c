@@ -0,0 +1,550 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "binary_serializer.h"
+#include "binary_serializer_common.h"
+#include "dyn_serializer_plan.h"
+#include "dyn_type_common.h"
+#include "celix_properties.h"
+#include "celix_array_list.h"
+#include "celix_array_list_encoding.h"
+#include "celix_err.h"
+#include "celix_stdlib_cleanup.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define BINARY_SERIALIZER_LITTLE_ENDIAN_HOST false
+#else
+#define BINARY_SERIALIZER_LITTLE_ENDIAN_HOST true
+#endif
+
+#define BINARY_SERIALIZER_NULL_LENGTH UINT32_MAX
+#define BINARY_SERIALIZER_INITIAL_CAPACITY 256
+
+static int OK = 0;
+static int ERROR = 1;
+
+static int binarySerializer_writePlan(const struct dyn_serializer_plan* plan, const char* base, binary_writer_t* writer);
+static int binarySerializer_readPlan(const struct dyn_serializer_plan* plan, binary_reader_t* reader, char* base);
+
+void binaryWriter_init(binary_writer_t* writer) {
+    writer->data = NULL;
+    writer->size = 0;
+    writer->capacity = 0;
+}
+
+void binaryWriter_deinit(binary_writer_t* writer) {
+    free(writer->data);
+    binaryWriter_init(writer);
+}
+
+static int binaryWriter_reserve(binary_writer_t* writer, size_t size, char** dst) {
+    if (size > writer->capacity - writer->size) {
+        size_t capacity = writer->capacity == 0 ? BINARY_SERIALIZER_INITIAL_CAPACITY : writer->capacity;
+        while (size > capacity - writer->size) {
+            if (capacity > SIZE_MAX / 2) {
+                celix_err_push("Binary encoding too large");
+                return ERROR;
+            }
+            capacity *= 2;
+        }
+        char* data = realloc(writer->data, capacity);
+        if (data == NULL) {
+            celix_err_push("Error allocating memory for binary encoding");
+            return ERROR;
+        }
+        writer->data = data;
+        writer->capacity = capacity;
+    }
+    *dst = writer->data + writer->size;
+    writer->size += size;
+    return OK;
+}
+
+int binaryWriter_write(binary_writer_t* writer, const void* data, size_t size) {
+    char* dst = NULL;
+    if (binaryWriter_reserve(writer, size, &dst) != OK) {
+        return ERROR;
+    }
+    memcpy(dst, data, size);
+    return OK;
+}
+
+/**
+ * Writes a number of the provided size (1, 2, 4 or 8 bytes) in little-endian byte order.
+ */
+static int binaryWriter_writeNumber(binary_writer_t* writer, const void* value, size_t size) {
+    char* dst = NULL;
+    if (binaryWriter_reserve(writer, size, &dst) != OK) {
+        return ERROR;
+    }
+    if (BINARY_SERIALIZER_LITTLE_ENDIAN_HOST) {
+        memcpy(dst, value, size);
+    } else {
+        for (size_t i = 0; i < size; ++i) {
+            dst[i] = ((const char*)value)[size - 1 - i];
+        }
+    }
+    return OK;
+}
+
+int binaryWriter_writeUint8(binary_writer_t* writer, uint8_t value) {
+    return binaryWriter_write(writer, &value, sizeof(value));
+}
+
+int binaryWriter_writeInt32(binary_writer_t* writer, int32_t value) {
+    return binaryWriter_writeNumber(writer, &value, sizeof(value));
+}
+
+int binaryWriter_writeUint32(binary_writer_t* writer, uint32_t value) {
+    return binaryWriter_writeNumber(writer, &value, sizeof(value));
+}
+
+int binaryReader_read(binary_reader_t* reader, void* data, size_t size) {
+    if (size > (size_t)(reader->end - reader->pos)) {
+        celix_err_push("Unexpected end of binary input");
+        return ERROR;
+    }
+    memcpy(data, reader->pos, size);
+    reader->pos += size;
+    return OK;
+}
+
+static int binaryReader_readNumber(binary_reader_t* reader, void* value, size_t size) {
+    if (size > (size_t)(reader->end - reader->pos)) {
+        celix_err_push("Unexpected end of binary input");
+        return ERROR;
+    }
+    if (BINARY_SERIALIZER_LITTLE_ENDIAN_HOST) {
+        memcpy(value, reader->pos, size);
+    } else {
+        for (size_t i = 0; i < size; ++i) {
+            ((char*)value)[i] = reader->pos[size - 1 - i];
+        }
+    }
+    reader->pos += size;
+    return OK;
+}
+
+int binaryReader_readUint8(binary_reader_t* reader, uint8_t* value) {
+    return binaryReader_read(reader, value, sizeof(*value));
+}
+
+int binaryReader_readInt32(binary_reader_t* reader, int32_t* value) {
+    return binaryReader_readNumber(reader, value, sizeof(*value));
+}
+
+int binaryReader_readUint32(binary_reader_t* reader, uint32_t* value) {
+    return binaryReader_readNumber(reader, value, sizeof(*value));
+}
+
+static int binarySerializer_writeText(binary_writer_t* writer, const char* text) {
+    if (text == NULL) {
+        return binaryWriter_writeUint32(writer, BINARY_SERIALIZER_NULL_LENGTH);
+    }
+    size_t len = strlen(text);
+    if (len >= BINARY_SERIALIZER_NULL_LENGTH) {
+        celix_err_push("Text too long for binary encoding");
+        return ERROR;
+    }
+    if (binaryWriter_writeUint32(writer, (uint32_t)len) != OK) {
+        return ERROR;
+    }
+    return binaryWriter_write(writer, text, len);
+}
+
+static int binarySerializer_readText(binary_reader_t* reader, char** text) {
+    uint32_t len = 0;
+    if (binaryReader_readUint32(reader, &len) != OK) {
+        return ERROR;
+    }
+    if (len == BINARY_SERIALIZER_NULL_LENGTH) {
+        *text = NULL;
+        return OK;
+    }
+    if (len > (size_t)(reader->end - reader->pos)) {
+        celix_err_push("Unexpected end of binary input");
+        return ERROR;
+    }
+    char* str = malloc((size_t)len + 1);
+    if (str == NULL) {
+        celix_err_push("Error allocating memory for text");
+        return ERROR;
+    }
+    memcpy(str, reader->pos, len);
+    str[len] = '\0';
+    reader->pos += len;
+    *text = str;
+    return OK;
+}
+
+static int binarySerializer_writeProperties(binary_writer_t* writer, const celix_properties_t* props) {
+    if (props == NULL) {
+        return binarySerializer_writeText(writer, NULL);
+    }
+    celix_autofree char* str = NULL;
+    if (celix_properties_saveToString(props, CELIX_PROPERTIES_ENCODE_STRICT, &str) != CELIX_SUCCESS) {
+        celix_err_push("Failed to convert properties to string.");
+        return ERROR;
+    }
+    return binarySerializer_writeText(writer, str);
+}
+
+static int binarySerializer_readProperties(binary_reader_t* reader, celix_properties_t** props) {
+    celix_autofree char* str = NULL;
+    if (binarySerializer_readText(reader, &str) != OK) {
+        return ERROR;
+    }
+    if (str == NULL) {
+        *props = NULL;
+        return OK;
+    }
+    if (celix_properties_loadFromString(str, CELIX_PROPERTIES_DECODE_STRICT, props) != CELIX_SUCCESS) {
+        celix_err_push("Error converting binary input to properties");
+        return ERROR;
+    }
+    return OK;
+}
+
+static int binarySerializer_writeArrayList(binary_writer_t* writer, const celix_array_list_t* list) {
+    if (list == NULL) {
+        return binarySerializer_writeText(writer, NULL);
+    }
+    celix_autofree char* str = NULL;
+    if (celix_arrayList_saveToString(list, CELIX_ARRAY_LIST_ENCODE_STRICT, &str) != CELIX_SUCCESS) {
+        celix_err_push("Failed to convert array list to string.");
+        return ERROR;
+    }
+    return binarySerializer_writeText(writer, str);
+}
+
+static int binarySerializer_readArrayList(binary_reader_t* reader, celix_array_list_t** list) {
+    celix_autofree char* str = NULL;
+    if (binarySerializer_readText(reader, &str) != OK) {
+        return ERROR;
+    }
+    if (str == NULL) {
+        *list = NULL;
+        return OK;
+    }
+    if (celix_arrayList_loadFromString(str, CELIX_ARRAY_LIST_DECODE_STRICT, list) != CELIX_SUCCESS) {
+        celix_err_push("Error converting binary input to array list");
+        return ERROR;
+    }
+    return OK;
+}
+
+static int binarySerializer_writeSequence(const struct dyn_serializer_op* op, const void* input, binary_writer_t* writer) {
+    const struct generic_sequence* seq = input;
+    if (seq->len > seq->cap) {
+        celix_err_pushf("Sequence length (%u) is greater than capacity (%u)", seq->len, seq->cap);
+        celix_err_push("Cannot serialize invalid sequence");
+        return ERROR;
+    }
+    if (binaryWriter_writeUint32(writer, seq->len) != OK) {
+        return ERROR;
+    }
+    if (seq->len == 0) {
+        return OK;
+    }
+    const struct dyn_serializer_plan* itemPlan = dynSerializer_getPlan(op->subType);
+    if (itemPlan == NULL) {
+        return ERROR;
+    }
+    if (BINARY_SERIALIZER_LITTLE_ENDIAN_HOST && itemPlan->packedSize > 0) {
+        return binaryWriter_write(writer, seq->buf, (size_t)seq->len * op->subTypeSize);
+    }
+    const char* item = seq->buf;
+    for (uint32_t i = 0; i < seq->len; ++i, item += op->subTypeSize) {
+        if (binarySerializer_writePlan(itemPlan, item, writer) != OK) {
+            return ERROR;
+        }
+    }
+    return OK;
+}
+
+static int binarySerializer_readSequence(const struct dyn_serializer_op* op, binary_reader_t* reader, void* loc) {
+    struct generic_sequence* seq = loc;
+    uint32_t len = 0;
+    if (binaryReader_readUint32(reader, &len) != OK) {
+        return ERROR;
+    }
+    if (len == 0) {
+        return OK;
+    }
+    const struct dyn_serializer_plan* itemPlan = dynSerializer_getPlan(op->subType);
+    if (itemPlan == NULL) {
+        return ERROR;
+    }
+    bool bulk = BINARY_SERIALIZER_LITTLE_ENDIAN_HOST && itemPlan->packedSize > 0;
+    // an encoded item takes at least a byte, so a corrupt length cannot trigger a huge allocation
+    size_t remaining = (size_t)(reader->end - reader->pos);
+    if (bulk ? (size_t)len * op->subTypeSize > remaining : len > remaining) {
+        celix_err_pushf("Invalid sequence length %u for the remaining binary input", len);
+        return ERROR;
+    }
+    if (dynType_sequence_alloc(op->type, seq, len) != OK) {
+        return ERROR;
+    }
+    if (bulk) {
+        (void)binaryReader_read(reader, seq->buf, (size_t)len * op->subTypeSize);
+        seq->len = len;
+        return OK;
+    }
+    char* item = seq->buf;
+    for (uint32_t i = 0; i < len; ++i, item += op->subTypeSize) {
+        seq->len = i + 1; // so that a partially read item is released on error
+        if (binarySerializer_readPlan(itemPlan, reader, item) != OK) {
+            return ERROR;
+        }
+    }
+    return OK;
+}
+
+static int binarySerializer_writeOp(const struct dyn_serializer_op* op, const void* input, binary_writer_t* writer) {
+    switch (op->kind) {
+        case DYN_SERIALIZER_OP_BOOL :
+            return binaryWriter_writeUint8(writer, *(const bool*)input ? 1 : 0);
+        case DYN_SERIALIZER_OP_NATIVE_INT :
+            return binaryWriter_writeInt32(writer, (int32_t)*(const int*)input);
+        case DYN_SERIALIZER_OP_ENUM :
+            return binaryWriter_writeInt32(writer, *(const int32_t*)input);
+        case DYN_SERIALIZER_OP_FLOAT :
+        case DYN_SERIALIZER_OP_DOUBLE :
+        case DYN_SERIALIZER_OP_INT8 :
+        case DYN_SERIALIZER_OP_INT16 :
+        case DYN_SERIALIZER_OP_INT32 :
+        case DYN_SERIALIZER_OP_INT64 :
+        case DYN_SERIALIZER_OP_UINT8 :
+        case DYN_SERIALIZER_OP_UINT16 :
+        case DYN_SERIALIZER_OP_UINT32 :
+        case DYN_SERIALIZER_OP_UINT64 :
+            return binaryWriter_writeNumber(writer, input, dynType_size(op->type));
+        case DYN_SERIALIZER_OP_TEXT :
+            return binarySerializer_writeText(writer, *(const char**)input);
+        case DYN_SERIALIZER_OP_PROPERTIES :
+            return binarySerializer_writeProperties(writer, *(const celix_properties_t**)input);
+        case DYN_SERIALIZER_OP_ARRAY_LIST :
+            return binarySerializer_writeArrayList(writer, *(const celix_array_list_t**)input);
+        case DYN_SERIALIZER_OP_SEQUENCE :
+            return binarySerializer_writeSequence(op, input, writer);
+        case DYN_SERIALIZER_OP_TYPED_POINTER : {
+            const void* value = *(const void**)input;
+            if (value == NULL) {
+                return binaryWriter_writeUint8(writer, 0);
+            }
+            const struct dyn_serializer_plan* subPlan = dynSerializer_getPlan(op->subType);
+            if (subPlan == NULL || binaryWriter_writeUint8(writer, 1) != OK) {
+                return ERROR;
+            }
+            return binarySerializer_writePlan(subPlan, value, writer);
+        }
+        case DYN_SERIALIZER_OP_POINTER_TO_POINTER :
+            celix_err_push("Error cannot serialize pointer to pointer");
+            return ERROR;
+        default :
+            celix_err_pushf("Unsupported descriptor '%c'", dynType_descriptorType(op->type));
+            return ERROR;
+    }
+}
+
+static int binarySerializer_readOp(const struct dyn_serializer_op* op, binary_reader_t* reader, void* loc) {
+    switch (op->kind) {
+        case DYN_SERIALIZER_OP_BOOL : {
+            uint8_t value = 0;
+            if (binaryReader_readUint8(reader, &value) != OK) {
+                return ERROR;
+            }
+            *(bool*)loc = value != 0;
+            return OK;
+        }
+        case DYN_SERIALIZER_OP_NATIVE_INT : {
+            int32_t value = 0;
+            if (binaryReader_readInt32(reader, &value) != OK) {
+                return ERROR;
+            }
+            *(int*)loc = (int)value;
+            return OK;
+        }
+        case DYN_SERIALIZER_OP_ENUM :
+            return binaryReader_readInt32(reader, (int32_t*)loc);
+        case DYN_SERIALIZER_OP_FLOAT :
+        case DYN_SERIALIZER_OP_DOUBLE :
+        case DYN_SERIALIZER_OP_INT8 :
+        case DYN_SERIALIZER_OP_INT16 :
+        case DYN_SERIALIZER_OP_INT32 :
+        case DYN_SERIALIZER_OP_INT64 :
+        case DYN_SERIALIZER_OP_UINT8 :
+        case DYN_SERIALIZER_OP_UINT16 :
+        case DYN_SERIALIZER_OP_UINT32 :
+        case DYN_SERIALIZER_OP_UINT64 :
+            return binaryReader_readNumber(reader, loc, dynType_size(op->type));
+        case DYN_SERIALIZER_OP_TEXT :
+            return binarySerializer_readText(reader, (char**)loc);
+        case DYN_SERIALIZER_OP_PROPERTIES :
+            return binarySerializer_readProperties(reader, (celix_properties_t**)loc);
+        case DYN_SERIALIZER_OP_ARRAY_LIST :
+            return binarySerializer_readArrayList(reader, (celix_array_list_t**)loc);
+        case DYN_SERIALIZER_OP_SEQUENCE :
+            return binarySerializer_readSequence(op, reader, loc);
+        case DYN_SERIALIZER_OP_TYPED_POINTER : {
+            uint8_t present = 0;
+            if (binaryReader_readUint8(reader, &present) != OK) {
+                return ERROR;
+            }
+            if (present == 0) {
+                *(void**)loc = NULL;
+                return OK;
+            }
+            if (present != 1) {
+                celix_err_pushf("Invalid pointer marker %u in binary input", present);
+                return ERROR;
+            }
+            const struct dyn_serializer_plan* subPlan = dynSerializer_getPlan(op->subType);
+            if (subPlan == NULL || dynType_alloc(op->subType, (void**)loc) != OK) {
+                return ERROR;
+            }
+            return binarySerializer_readPlan(subPlan, reader, *(char**)loc);
+        }
+        case DYN_SERIALIZER_OP_POINTER_TO_POINTER :
+            celix_err_push("Error cannot deserialize pointer to pointer");
+            return ERROR;
+        default :
+            celix_err_pushf("Unsupported descriptor '%c'", dynType_descriptorType(op->type));
+            return ERROR;
+    }
+}
+
+static int binarySerializer_writePlan(const struct dyn_serializer_plan* plan, const char* base, binary_writer_t* writer) {
+    if (BINARY_SERIALIZER_LITTLE_ENDIAN_HOST && plan->packedSize > 0) {
+        return binaryWriter_write(writer, base, plan->packedSize);
+    }
+    for (size_t i = 0; i < plan->nrOfOps; ++i) {
+        const struct dyn_serializer_op* op = &plan->ops[i];
+        // an object is encoded as its members, which directly follow the object op
+        if (op->kind != DYN_SERIALIZER_OP_OBJECT && binarySerializer_writeOp(op, base + op->offset, writer) != OK) {
+            return ERROR;
+        }
+    }
+    return OK;
+}
+
+static int binarySerializer_readPlan(const struct dyn_serializer_plan* plan, binary_reader_t* reader, char* base) {
+    if (BINARY_SERIALIZER_LITTLE_ENDIAN_HOST && plan->packedSize > 0) {
+        return binaryReader_read(reader, base, plan->packedSize);
+    }
+    for (size_t i = 0; i < plan->nrOfOps; ++i) {
+        const struct dyn_serializer_op* op = &plan->ops[i];
+        if (op->kind != DYN_SERIALIZER_OP_OBJECT && binarySerializer_readOp(op, reader, base + op->offset) != OK) {
+            return ERROR;
+        }
+    }
+    return OK;
+}
+
+int binarySerializer_write(const dyn_type* type, const void* input, binary_writer_t* writer) {
+    const struct dyn_serializer_plan* plan = dynSerializer_getPlan(dynType_realType(type));
+    if (plan == NULL) {
+        return ERROR;
+    }
+    return binarySerializer_writePlan(plan, input, writer);
+}
+
+int binarySerializer_read(const dyn_type* type, binary_reader_t* reader, void* loc) {
+    const struct dyn_serializer_plan* plan = dynSerializer_getPlan(dynType_realType(type));
+    if (plan == NULL) {
+        return ERROR;
+    }
+    return binarySerializer_readPlan(plan, reader, loc);
+}
+
+int binarySerializer_readView(const dyn_type* type, binary_reader_t* reader, void* loc, bool* isView) {
+    *isView = false;
+    const struct dyn_serializer_plan* plan = dynSerializer_getPlan(dynType_realType(type));
+    if (plan == NULL) {
+        return ERROR;
+    }
+    const struct dyn_serializer_op* op = &plan->ops[0];
+    if (op->kind != DYN_SERIALIZER_OP_SEQUENCE || !BINARY_SERIALIZER_LITTLE_ENDIAN_HOST) {
+        return binarySerializer_readPlan(plan, reader, loc);
+    }
+    const struct dyn_serializer_plan* itemPlan = dynSerializer_getPlan(op->subType);
+    if (itemPlan == NULL) {
+        return ERROR;
+    }
+    binary_reader_t items = *reader;
+    uint32_t len = 0;
+    size_t alignment = dynType_ffiType(op->subType)->alignment;
+    if (itemPlan->packedSize == 0 || (size_t)(items.end - items.pos) < sizeof(len)
+            || binaryReader_readUint32(&items, &len) != OK || len == 0
+            || (size_t)len * op->subTypeSize > (size_t)(items.end - items.pos)
+            || (alignment > 1 && (uintptr_t)items.pos % alignment != 0)) {
+        return binarySerializer_readPlan(plan, reader, loc);
+    }
+    struct generic_sequence* seq = loc;
+    seq->cap = len;
+    seq->len = len;
+    seq->buf = (void*)items.pos;
+    reader->pos = items.pos + (size_t)len * op->subTypeSize;
+    *isView = true;
+    return OK;
+}
+
+int binarySerializer_serialize(const dyn_type* type, const void* input, void** output, size_t* outputSize) {
+    binary_writer_t writer;
+    binaryWriter_init(&writer);
+    if (binarySerializer_write(type, input, &writer) != OK) {
+        binaryWriter_deinit(&writer);
+        return ERROR;
+    }
+    if (writer.data == NULL) {
+        // empty encoding (e.g. a complex type without members), still return a buffer that can be freed
+        writer.data = malloc(1);
+        if (writer.data == NULL) {
+            celix_err_push("Error allocating memory for binary encoding");
+            return ERROR;
+        }
+    }
+    *output = writer.data;
+    *outputSize = writer.size;
+    return OK;
+}
+
+int binarySerializer_deserialize(const dyn_type* type, const void* input, size_t inputSize, void** result) {
+    celix_autofree void* inst = NULL;
+    if (dynType_alloc(type, &inst) != OK) {
+        return ERROR;
+    }
+    binary_reader_t reader = {input, (const char*)input + inputSize};
+    if (binarySerializer_read(type, &reader, inst) != OK) {
+        dynType_cleanup(type, inst);
+        return ERROR;
+    }
+    if (reader.pos != reader.end) {
+        celix_err_pushf("Unexpected trailing data (%zu bytes) in binary input", (size_t)(reader.end - reader.pos));
+        dynType_cleanup(type, inst);
+        return ERROR;
+    }
+    *result = celix_steal_ptr(inst);
+    return OK;
+}
@@ -0,0 +1,99 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef _BINARY_SERIALIZER_COMMON_H_
+#define _BINARY_SERIALIZER_COMMON_H_
+
+#include "dyn_type.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Growable output buffer for binary encodings. The data is malloc'ed and owned by the writer until stolen.
+ */
+typedef struct binary_writer {
+    char* data;
+    size_t size;
+    size_t capacity;
+} binary_writer_t;
+
+/**
+ * Input cursor for binary encodings.
+ */
+typedef struct binary_reader {
+    const char* pos;
+    const char* end;
+} binary_reader_t;
+
+void binaryWriter_init(binary_writer_t* writer);
+
+void binaryWriter_deinit(binary_writer_t* writer);
+
+/**
+ * Writes raw bytes.
+ */
+int binaryWriter_write(binary_writer_t* writer, const void* data, size_t size);
+
+int binaryWriter_writeUint8(binary_writer_t* writer, uint8_t value);
+
+int binaryWriter_writeInt32(binary_writer_t* writer, int32_t value);
+
+int binaryWriter_writeUint32(binary_writer_t* writer, uint32_t value);
+
+/**
+ * Reads raw bytes.
+ */
+int binaryReader_read(binary_reader_t* reader, void* data, size_t size);
+
+int binaryReader_readUint8(binary_reader_t* reader, uint8_t* value);
+
+int binaryReader_readInt32(binary_reader_t* reader, int32_t* value);
+
+int binaryReader_readUint32(binary_reader_t* reader, uint32_t* value);
+
+/**
+ * Writes the binary encoding of the value of the provided type.
+ */
+int binarySerializer_write(const dyn_type* type, const void* input, binary_writer_t* writer);
+
+/**
+ * Reads a binary encoded value of the provided type into loc, which must point to zeroed memory of the type size.
+ * On error, the partially read value can be released using dynType_cleanup.
+ */
+int binarySerializer_read(const dyn_type* type, binary_reader_t* reader, void* loc);
+
+/**
+ * Reads a binary encoded value of the provided type like binarySerializer_read, but if the value is a sequence whose
+ * items are copied as a whole and are suitably aligned in the input, the buf of the sequence points into the input
+ * instead of to a copy and isView is set to true.
+ * A view must not be released using dynType_cleanup and is only valid as long as the input.
+ */
+int binarySerializer_readView(const dyn_type* type, binary_reader_t* reader, void* loc, bool* isView);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
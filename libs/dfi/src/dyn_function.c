@@ -25,6 +25,7 @@
 
 #include <strings.h>
 #include <stdlib.h>
+#include <string.h>
 #include <ffi.h>
 #include "dyn_type_common.h"
 
@@ -234,8 +235,61 @@ void dynFunction_destroy(dyn_function_type* dynFunc) {
     }
 }
 
+static void dynFunction_callStub(const dyn_function_type* dynFunc, void(*fn)(void), void* returnValue, void** argValues) {
+    //like ffi_call, widen integral return values smaller than ffi_arg
+    union {
+        int8_t b;
+        uint8_t ub;
+        int16_t s;
+        uint16_t us;
+        int32_t i;
+        uint32_t ui;
+    } value;
+    switch (dynFunc->funcReturn->descriptor) {
+        case 'B':
+            dynFunc->callStub(fn, argValues, &value);
+            *(ffi_sarg*)returnValue = value.b;
+            break;
+        case 'b':
+        case 'Z':
+            dynFunc->callStub(fn, argValues, &value);
+            *(ffi_arg*)returnValue = value.ub;
+            break;
+        case 'S':
+            dynFunc->callStub(fn, argValues, &value);
+            *(ffi_sarg*)returnValue = value.s;
+            break;
+        case 's':
+            dynFunc->callStub(fn, argValues, &value);
+            *(ffi_arg*)returnValue = value.us;
+            break;
+        case 'I':
+        case 'N':
+        case 'E':
+            dynFunc->callStub(fn, argValues, &value);
+            *(ffi_sarg*)returnValue = value.i;
+            break;
+        case 'i':
+            dynFunc->callStub(fn, argValues, &value);
+            *(ffi_arg*)returnValue = value.ui;
+            break;
+        default:
+            dynFunc->callStub(fn, argValues, returnValue);
+            break;
+    }
+}
+
 int dynFunction_call(const dyn_function_type* dynFunc, void(*fn)(void), void* returnValue, void** argValues) {
-    ffi_call((ffi_cif*)&dynFunc->cif, fn, returnValue, argValues);
+    if (dynFunc->callStub != NULL) {
+        dynFunction_callStub(dynFunc, fn, returnValue, argValues);
+        return 0;
+    }
+    //ffi_call can replace the values of struct arguments passed in memory with pointers to its own (stack) copies,
+    //so it gets a copy of the argument values to keep those of the caller intact
+    unsigned int nargs = dynFunc->cif.nargs;
+    void* values[nargs > 0 ? nargs : 1];
+    memcpy(values, argValues, nargs * sizeof(void*));
+    ffi_call((ffi_cif*)&dynFunc->cif, fn, returnValue, values);
     return 0;
 }
 
@@ -274,6 +328,25 @@ int dynFunction_getFnPointer(const dyn_function_type* dynFunc, void (**fn)(void)
     return OK;
 }
 
+int dynFunction_getClosureBind(const dyn_function_type* dynFunc,
+                               void (**bind)(void*, void**, void*),
+                               void** userData) {
+    if (dynFunc == NULL || dynFunc->fn == NULL) {
+        return ERROR;
+    }
+    (*bind) = dynFunc->bind;
+    (*userData) = dynFunc->userData;
+    return OK;
+}
+
+int dynFunction_getProxyStub(const dyn_function_type* dynFunc, void (**fn)(void)) {
+    if (dynFunc == NULL || dynFunc->proxyStub == NULL) {
+        return ERROR;
+    }
+    (*fn) = dynFunc->proxyStub;
+    return OK;
+}
+
 int dynFunction_nrOfArguments(const dyn_function_type* dynFunc) {
     dyn_function_argument_type* last = TAILQ_LAST(&dynFunc->arguments, dyn_function_arguments_head);
     return last == NULL ? 0 : (last->index+1);
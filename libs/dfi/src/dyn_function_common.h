@@ -21,6 +21,7 @@
 #define _DYN_FUNCTION_COMMON_H_
 
 #include "dyn_function.h"
+#include "dyn_stubs.h"
 
 #include <strings.h>
 #include <stdlib.h>
@@ -45,6 +46,10 @@ struct _dyn_function_type {
     void (*fn)(void);
     void *userData;
     void (*bind)(void* userData, void* args[], void* ret);
+
+    //generated stubs, see dyn_stubs.h
+    dyn_stub_call_fp callStub;
+    void (*proxyStub)(void);
 };
 
 #ifdef __cplusplus
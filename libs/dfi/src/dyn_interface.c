@@ -21,6 +21,7 @@
 #include "dyn_common.h"
 #include "dyn_type.h"
 #include "dyn_interface_common.h"
+#include "dyn_function_common.h"
 #include "celix_err.h"
 #include "celix_stdlib_cleanup.h"
 
@@ -36,6 +37,7 @@ static const int ERROR = 1;
 static int dynInterface_checkInterface(dyn_interface_type* intf);
 static int dynInterface_parseSection(celix_descriptor_t* desc, const char* secName, FILE* stream);
 static int dynInterface_parseMethods(dyn_interface_type* intf, FILE* stream);
+static int dynInterface_indexMethods(dyn_interface_type* intf);
 
 int dynInterface_parse(FILE* descriptor, dyn_interface_type** out) {
     int status = OK;
@@ -59,6 +61,10 @@ int dynInterface_parse(FILE* descriptor, dyn_interface_type** out) {
         return status;
     }
 
+    if ((status = dynInterface_indexMethods(intf)) != OK) {
+        return status;
+    }
+
     *out = celix_steal_ptr(intf);
     return OK;
 }
@@ -102,6 +108,34 @@ static int dynInterface_checkInterface(dyn_interface_type* intf) {
     return OK;
 }
 
+static int dynInterface_indexMethods(dyn_interface_type* intf) {
+    struct method_entry* last = TAILQ_LAST(&intf->methods, methods_head);
+    int nrOfMethods = last == NULL ? 0 : (last->index + 1);
+
+    celix_string_hash_map_create_options_t opts = CELIX_EMPTY_STRING_HASH_MAP_CREATE_OPTIONS;
+    opts.storeKeysWeakly = true; // keys are owned by the method entries
+    opts.initialCapacity = (unsigned int)nrOfMethods;
+    intf->methodsById = celix_stringHashMap_createWithOptions(&opts);
+    intf->methodsByIndex = calloc(nrOfMethods > 0 ? nrOfMethods : 1, sizeof(*intf->methodsByIndex));
+    if (intf->methodsById == NULL || intf->methodsByIndex == NULL) {
+        celix_err_push("Error allocating memory for method index");
+        return ERROR;
+    }
+    intf->nrOfMethods = nrOfMethods;
+
+    struct method_entry* mEntry = NULL;
+    TAILQ_FOREACH(mEntry, &intf->methods, entries) {
+        intf->methodsByIndex[mEntry->index] = mEntry;
+        // for duplicate ids, the first method entry is used.
+        if (!celix_stringHashMap_hasKey(intf->methodsById, mEntry->id) &&
+            celix_stringHashMap_put(intf->methodsById, mEntry->id, mEntry) != CELIX_SUCCESS) {
+            celix_err_push("Error adding method to method index");
+            return ERROR;
+        }
+    }
+    return OK;
+}
+
 static int dynInterface_parseSection(celix_descriptor_t* desc, const char* secName, FILE* stream) {
     dyn_interface_type* intf = (dyn_interface_type*)desc;
     if (strcmp("methods", secName) != 0) {
@@ -173,6 +207,8 @@ void dynInterface_destroy(dyn_interface_type* intf) {
             }
             free(mTmp);
         }
+        celix_stringHashMap_destroy(intf->methodsById);
+        free(intf->methodsByIndex);
         celix_dynDescriptor_destroy((celix_descriptor_t*)intf);
     }
 }
@@ -209,16 +245,42 @@ const struct methods_head* dynInterface_methods(const dyn_interface_type* intf)
 }
 
 int dynInterface_nrOfMethods(const dyn_interface_type* intf) {
-    struct method_entry* last = TAILQ_LAST(&intf->methods, methods_head);
-    return last == NULL ? 0 : (last->index+1);
+    return intf->nrOfMethods;
 }
 
 const struct method_entry* dynInterface_findMethod(const dyn_interface_type* intf, const char* id) {
-    const struct method_entry* entry = NULL;
-    TAILQ_FOREACH(entry, &intf->methods, entries) {
-        if (strcmp(entry->id, id) == 0) {
-            break;
+    return celix_stringHashMap_get(intf->methodsById, id);
+}
+
+const struct method_entry* dynInterface_findMethodByIndex(const dyn_interface_type* intf, int index) {
+    if (index < 0 || index >= intf->nrOfMethods) {
+        return NULL;
+    }
+    return intf->methodsByIndex[index];
+}
+
+int dynInterface_setStubs(dyn_interface_type* intf, const dyn_interface_stubs_t* stubs) {
+    const char* name = dynInterface_getName(intf);
+    const char* version = dynInterface_getVersionString(intf);
+    if (strcmp(name, stubs->name) != 0 || strcmp(version, stubs->version) != 0) {
+        celix_err_pushf("Stubs for %s %s do not match interface %s %s", stubs->name, stubs->version, name, version);
+        return ERROR;
+    }
+    if (stubs->nrOfMethods != (size_t)intf->nrOfMethods) {
+        celix_err_pushf("Stubs for %s have %zu methods, expected %d", stubs->name, stubs->nrOfMethods, intf->nrOfMethods);
+        return ERROR;
+    }
+    for (int i = 0; i < intf->nrOfMethods; ++i) {
+        if (strcmp(intf->methodsByIndex[i]->id, stubs->methods[i].id) != 0) {
+            celix_err_pushf("Stub for method %d of %s is %s, expected %s", i, stubs->name, stubs->methods[i].id,
+                            intf->methodsByIndex[i]->id);
+            return ERROR;
         }
     }
-    return entry;
-}
\ No newline at end of file
+    for (int i = 0; i < intf->nrOfMethods; ++i) {
+        dyn_function_type* func = intf->methodsByIndex[i]->dynFunc;
+        func->callStub = stubs->methods[i].call;
+        func->proxyStub = stubs->methods[i].proxy;
+    }
+    return OK;
+}
@@ -28,6 +28,7 @@
 #include <ffi.h>
 
 #include "dyn_common.h"
+#include "celix_string_hash_map.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -36,6 +37,9 @@ extern "C" {
 struct _dyn_interface_type {
     CELIX_DESCRIPTOR_FIELDS
     struct methods_head methods;
+    celix_string_hash_map_t* methodsById; ///< Key: method id, value: struct method_entry*. Does not own the entries.
+    struct method_entry** methodsByIndex; ///< Array of nrOfMethods method entries, ordered on method index.
+    int nrOfMethods;
 };
 
 #ifdef __cplusplus
@@ -0,0 +1,196 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "dyn_serializer_plan.h"
+#include "celix_err.h"
+#include "celix_stdlib_cleanup.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+static void dynSerializer_destroyPlan(struct dyn_type_cache* cache);
+
+static const int OK = 0;
+static const int ERROR = 1;
+
+static enum dyn_serializer_op_kind dynSerializer_opKindFor(const dyn_type* type) {
+    switch (dynType_descriptorType(type)) {
+        case 'Z' :
+            return DYN_SERIALIZER_OP_BOOL;
+        case 'F' :
+            return DYN_SERIALIZER_OP_FLOAT;
+        case 'D' :
+            return DYN_SERIALIZER_OP_DOUBLE;
+        case 'N' :
+            return DYN_SERIALIZER_OP_NATIVE_INT;
+        case 'B' :
+            return DYN_SERIALIZER_OP_INT8;
+        case 'S' :
+            return DYN_SERIALIZER_OP_INT16;
+        case 'I' :
+            return DYN_SERIALIZER_OP_INT32;
+        case 'J' :
+            return DYN_SERIALIZER_OP_INT64;
+        case 'b' :
+            return DYN_SERIALIZER_OP_UINT8;
+        case 's' :
+            return DYN_SERIALIZER_OP_UINT16;
+        case 'i' :
+            return DYN_SERIALIZER_OP_UINT32;
+        case 'j' :
+            return DYN_SERIALIZER_OP_UINT64;
+        case 'E' :
+            return DYN_SERIALIZER_OP_ENUM;
+        case 't' :
+            return DYN_SERIALIZER_OP_TEXT;
+        case 'p' :
+            return DYN_SERIALIZER_OP_PROPERTIES;
+        case 'a' :
+            return DYN_SERIALIZER_OP_ARRAY_LIST;
+        case '[' :
+            return DYN_SERIALIZER_OP_SEQUENCE;
+        case '{' :
+            return DYN_SERIALIZER_OP_OBJECT;
+        case '*' :
+            return dynType_ffiType(dynType_typedPointer_getTypedType(type)) != &ffi_type_pointer ?
+                   DYN_SERIALIZER_OP_TYPED_POINTER : DYN_SERIALIZER_OP_POINTER_TO_POINTER;
+        default :
+            return DYN_SERIALIZER_OP_UNSUPPORTED;
+    }
+}
+
+static size_t dynSerializer_countOps(const dyn_type* type) {
+    size_t count = 1;
+    if (dynType_type(type) == DYN_TYPE_COMPLEX) {
+        size_t nrOfEntries = dynType_complex_nrOfEntries(type);
+        for (size_t i = 0; i < nrOfEntries; ++i) {
+            count += dynSerializer_countOps(dynType_complex_dynTypeAt(type, (int)i));
+        }
+    }
+    return count;
+}
+
+static int dynSerializer_fillOps(const dyn_type* type, const char* name, size_t offset, struct dyn_serializer_op* ops, size_t* index) {
+    struct dyn_serializer_op* op = &ops[(*index)++];
+    op->kind = dynSerializer_opKindFor(type);
+    op->name = name;
+    op->offset = offset;
+    op->type = type;
+    if (op->kind == DYN_SERIALIZER_OP_SEQUENCE) {
+        op->subType = dynType_sequence_itemType(type);
+        op->subTypeSize = dynType_size(op->subType);
+    } else if (op->kind == DYN_SERIALIZER_OP_TYPED_POINTER) {
+        op->subType = dynType_typedPointer_getTypedType(type);
+    } else if (op->kind == DYN_SERIALIZER_OP_OBJECT) {
+        struct complex_type_entry* entry = NULL;
+        int entryIndex = 0;
+        TAILQ_FOREACH(entry, dynType_complex_entries(type), entries) {
+            if (entry->name == NULL) {
+                celix_err_push("Unamed field unsupported");
+                return ERROR;
+            }
+            int status = dynSerializer_fillOps(dynType_complex_dynTypeAt(type, entryIndex), entry->name,
+                                                offset + dynType_getOffset(type, entryIndex), ops, index);
+            if (status != OK) {
+                return status;
+            }
+            entryIndex++;
+        }
+    }
+    op->span = (size_t)(&ops[*index] - op);
+    return OK;
+}
+
+static size_t dynSerializer_packedSize(const struct dyn_serializer_plan* plan, size_t typeSize) {
+    size_t size = 0;
+    for (size_t i = 0; i < plan->nrOfOps; ++i) {
+        const struct dyn_serializer_op* op = &plan->ops[i];
+        switch (op->kind) {
+            case DYN_SERIALIZER_OP_OBJECT :
+                continue;
+            case DYN_SERIALIZER_OP_NATIVE_INT :
+                if (sizeof(int) != sizeof(int32_t)) {
+                    return 0; //native ints are encoded as int32
+                }
+                break;
+            case DYN_SERIALIZER_OP_FLOAT :
+            case DYN_SERIALIZER_OP_DOUBLE :
+            case DYN_SERIALIZER_OP_INT8 :
+            case DYN_SERIALIZER_OP_INT16 :
+            case DYN_SERIALIZER_OP_INT32 :
+            case DYN_SERIALIZER_OP_INT64 :
+            case DYN_SERIALIZER_OP_UINT8 :
+            case DYN_SERIALIZER_OP_UINT16 :
+            case DYN_SERIALIZER_OP_UINT32 :
+            case DYN_SERIALIZER_OP_UINT64 :
+            case DYN_SERIALIZER_OP_ENUM :
+                break;
+            default :
+                return 0;
+        }
+        if (op->offset != size) {
+            return 0; //padding
+        }
+        size += dynType_size(op->type);
+    }
+    return size == typeSize ? size : 0;
+}
+
+static struct dyn_serializer_plan* dynSerializer_createPlan(const dyn_type* type) {
+    size_t nrOfOps = dynSerializer_countOps(type);
+    celix_autofree struct dyn_serializer_plan* plan = calloc(1, sizeof(*plan) + nrOfOps * sizeof(plan->ops[0]));
+    if (plan == NULL) {
+        celix_err_pushf("Error allocating memory for serializer plan of type '%c'", dynType_descriptorType(type));
+        return NULL;
+    }
+    plan->cache.destroy = dynSerializer_destroyPlan;
+    plan->nrOfOps = nrOfOps;
+    size_t index = 0;
+    if (dynSerializer_fillOps(type, NULL, 0, plan->ops, &index) != OK) {
+        return NULL;
+    }
+    assert(index == nrOfOps);
+    plan->packedSize = dynSerializer_packedSize(plan, dynType_size(type));
+    return celix_steal_ptr(plan);
+}
+
+/**
+ * If multiple threads create a plan concurrently, the first one is kept.
+ */
+const struct dyn_serializer_plan* dynSerializer_getPlan(const dyn_type* type) {
+    dyn_type* cacheOwner = (dyn_type*)type; // the plan is a cache, it does not change the (logical) type
+    struct dyn_type_cache* cache = __atomic_load_n(&cacheOwner->cache, __ATOMIC_ACQUIRE);
+    if (cache != NULL) {
+        return (struct dyn_serializer_plan*)cache;
+    }
+    struct dyn_serializer_plan* plan = dynSerializer_createPlan(type);
+    if (plan == NULL) {
+        return NULL;
+    }
+    if (!__atomic_compare_exchange_n(&cacheOwner->cache, &cache, &plan->cache, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        dynSerializer_destroyPlan(&plan->cache);
+        return (struct dyn_serializer_plan*)cache;
+    }
+    return plan;
+}
+
+static void dynSerializer_destroyPlan(struct dyn_type_cache* cache) {
+    free(cache);
+}
@@ -0,0 +1,97 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef _DYN_SERIALIZER_PLAN_H_
+#define _DYN_SERIALIZER_PLAN_H_
+
+#include "dyn_type.h"
+#include "dyn_type_common.h"
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum dyn_serializer_op_kind {
+    DYN_SERIALIZER_OP_UNSUPPORTED,
+    DYN_SERIALIZER_OP_BOOL,
+    DYN_SERIALIZER_OP_FLOAT,
+    DYN_SERIALIZER_OP_DOUBLE,
+    DYN_SERIALIZER_OP_NATIVE_INT,
+    DYN_SERIALIZER_OP_INT8,
+    DYN_SERIALIZER_OP_INT16,
+    DYN_SERIALIZER_OP_INT32,
+    DYN_SERIALIZER_OP_INT64,
+    DYN_SERIALIZER_OP_UINT8,
+    DYN_SERIALIZER_OP_UINT16,
+    DYN_SERIALIZER_OP_UINT32,
+    DYN_SERIALIZER_OP_UINT64,
+    DYN_SERIALIZER_OP_ENUM,
+    DYN_SERIALIZER_OP_TEXT,
+    DYN_SERIALIZER_OP_PROPERTIES,
+    DYN_SERIALIZER_OP_ARRAY_LIST,
+    DYN_SERIALIZER_OP_SEQUENCE,
+    DYN_SERIALIZER_OP_TYPED_POINTER,
+    DYN_SERIALIZER_OP_POINTER_TO_POINTER,
+    DYN_SERIALIZER_OP_OBJECT
+};
+
+/**
+ * A single (de)serialization step of a serializer plan.
+ * The members of an object op directly follow the object op; span is the number of ops of a value including
+ * its (nested) members, so the next sibling of an op is at op + op->span.
+ */
+struct dyn_serializer_op {
+    enum dyn_serializer_op_kind kind;
+    const char* name; ///< Member name, NULL for the root op. Not owned.
+    size_t offset; ///< Offset of the value relative to the start of the root instance.
+    size_t span;
+    const dyn_type* type; ///< The real type of the value.
+    const dyn_type* subType; ///< The real item type for sequences and the real typed type for typed pointers.
+    size_t subTypeSize; ///< The size of the sequence item type.
+};
+
+/**
+ * A serializer plan is the flattened (by-value) layout of a dyn type, built on first use and cached on the
+ * dyn type. Typed pointers and sequence items refer to the (cached) plan of their sub type.
+ * The plan does not depend on the serialization format and is shared by the json and binary serializers.
+ */
+struct dyn_serializer_plan {
+    struct dyn_type_cache cache; ///< Must be the first member, the plan is cached on the dyn type.
+    size_t nrOfOps;
+    /**
+     * The size of the value if it only consists of fixed size numbers (no bools, texts, pointers or sequences)
+     * without padding, so that the value can be copied as a whole. 0 otherwise.
+     */
+    size_t packedSize;
+    struct dyn_serializer_op ops[];
+};
+
+/**
+ * Returns the plan of the provided real type, creating and caching it on the type on first use.
+ * Returns NULL (and adds an error message to celix_err) if a plan cannot be created.
+ */
+const struct dyn_serializer_plan* dynSerializer_getPlan(const dyn_type* type);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -55,8 +55,6 @@ static int dynType_parseSimple(int c, dyn_type* type);
 static int dynType_parseTypedPointer(FILE* stream, dyn_type* type);
 static int dynType_parseProperties(FILE* stream, dyn_type* type);
 static int dynType_parseArrayList(FILE* stream, dyn_type* type);
-static unsigned short dynType_getOffset(const dyn_type* type, int index);
-
 static void dynType_printAny(const char* name, const dyn_type* type, int depth, FILE* stream);
 static void dynType_printComplex(const char* name, const dyn_type* type, int depth, FILE* stream);
 static void dynType_printSequence(const char* name, const dyn_type* type, int depth, FILE* stream);
@@ -80,12 +78,6 @@ static void dynType_freeBuiltInObject(const dyn_type* type, void* loc);
 
 static int dynType_parseMetaInfo(FILE* stream, dyn_type* type);
 
-struct generic_sequence {
-    uint32_t cap;
-    uint32_t len;
-    void* buf;
-};
-
 int dynType_parse(FILE* descriptorStream, const char* name, const struct types_head* refTypes, dyn_type** type) {
     return dynType_parseWithStream(descriptorStream, name, NULL, refTypes, type);
 }
@@ -485,6 +477,10 @@ static void dynType_clear(dyn_type* type) {
             break;
     } 
 
+    if (type->cache != NULL) {
+        type->cache->destroy(type->cache);
+    }
+
     if (type->name != NULL) {
         free(type->name);
     }
@@ -851,7 +847,7 @@ static ffi_type* dynType_ffiTypeFor(int c) {
     return type;
 }
 
-static unsigned short dynType_getOffset(const dyn_type* type, int index) {
+unsigned short dynType_getOffset(const dyn_type* type, int index) {
     assert(type->type == DYN_TYPE_COMPLEX);
     unsigned short offset = 0;
 
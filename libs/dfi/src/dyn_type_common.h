@@ -31,6 +31,14 @@
 extern "C" {
 #endif
 
+/**
+ * Data derived from a dyn type (e.g. a serializer plan), lazily created and attached to the type by its user.
+ * Embedded as first member of the derived data; destroyed together with the type.
+ */
+struct dyn_type_cache {
+    void (*destroy)(struct dyn_type_cache* cache);
+};
+
 struct _dyn_type {
     char* name;
     char descriptor;
@@ -41,6 +49,7 @@ struct _dyn_type {
     const struct types_head* referenceTypes; //NOTE: not owned
     struct types_head nestedTypesHead;
     struct meta_properties_head metaProperties;
+    struct dyn_type_cache* cache; //lazily created by a serializer, access atomically
     union {
         struct {
             struct complex_type_entries_head entriesHead;
@@ -60,8 +69,15 @@ struct _dyn_type {
     };
 };
 
+struct generic_sequence {
+    uint32_t cap;
+    uint32_t len;
+    void* buf;
+};
+
 dyn_type* dynType_findType(dyn_type* type, char* name);
 ffi_type* dynType_ffiType(const dyn_type* type);
+unsigned short dynType_getOffset(const dyn_type* type, int index);
 
 #ifdef __cplusplus
 }
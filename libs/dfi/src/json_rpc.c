@@ -22,98 +22,62 @@
 #include "dyn_type.h"
 #include "dyn_interface.h"
 #include "dyn_type_common.h"
+#include "json_serializer_common.h"
+#include "rpc_common.h"
 #include "celix_cleanup.h"
 #include "celix_err.h"
+#include "celix_json_stream_internal.h"
 
 #include <jansson.h>
+#include <limits.h>
 #include <stdint.h>
 #include <string.h>
 #include <ffi.h>
 
-#define CELIX_JSON_RPC_MAX_ARGS     16
-
 static int OK = 0;
 static int ERROR = 1;
 
-typedef void (*gen_func_type)(void);
-
-struct generic_service_layout {
-    void* handle;
-    gen_func_type methods[];
-};
-
-typedef struct celix_rpc_args {
-    const struct dyn_function_arguments_head* dynArgs;
-    void* args[CELIX_JSON_RPC_MAX_ARGS];
-}celix_rpc_args_t;
-
-static bool celix_argType_isStringOrBuiltInObject(const dyn_type* type) {
-    int t = dynType_type(type);
-    return t == DYN_TYPE_TEXT || t == DYN_TYPE_BUILTIN_OBJECT;
-}
-
-static void celix_rpcArgs_cleanup(celix_rpc_args_t* args) {
-    const struct dyn_function_arguments_head* dynArgs = args->dynArgs;
-    if (dynArgs == NULL) {
-        return;
-    }
-    dyn_function_argument_type* entry = NULL;
-    TAILQ_FOREACH(entry, dynArgs, entries) {
-        const dyn_type* argType = dynType_realType(entry->type);
-        enum dyn_function_argument_meta meta = entry->argumentMeta;
-        if (meta == DYN_FUNCTION_ARGUMENT_META__STD) {
-            if (celix_argType_isStringOrBuiltInObject(argType)) {
-                const char* isConst = dynType_getMetaInfo(entry->type, "const");
-                if (isConst != NULL && strncmp("true", isConst, 5) == 0) {
-                    dynType_free(argType, args->args[entry->index]);
-                } else {
-                    //char* -> callee is now owner, no free for char seq needed
-                    //will free the actual pointer
-                    free(args->args[entry->index]);
-                }
-            } else {
-                dynType_free(argType, args->args[entry->index]);
-            }
-        } else if (meta == DYN_FUNCTION_ARGUMENT_META__PRE_ALLOCATED_OUTPUT) {
-            const dyn_type* subType = dynType_typedPointer_getTypedType(argType);
-            dynType_free(subType, *(void**)(args->args[entry->index]));
-        } else if (meta == DYN_FUNCTION_ARGUMENT_META__OUTPUT) {
-            const dyn_type* typedType = dynType_typedPointer_getTypedType(argType);
-            if (celix_argType_isStringOrBuiltInObject(typedType)) {
-                dynType_cleanup(typedType, *(void**)(args->args[entry->index]));//args->args[entry->index] is void***, its value is &ptrToPtr(the local variable in jsonRpc_call)
-            } else {
-                const dyn_type* typedTypedType = dynType_typedPointer_getTypedType(typedType);
-                dynType_free(typedTypedType, **(void***)args->args[entry->index]);
-            }
-        }
-    }
-    args->dynArgs = NULL;
-}
-
-CELIX_DEFINE_AUTO_CLEANUP_CLEAR_FUNC(celix_rpc_args_t, celix_rpcArgs_cleanup)
-
 int jsonRpc_call(const dyn_interface_type* intf, void* service, const char* request, char** out) {
-    int status = OK;
-
     json_error_t error;
     json_auto_t* js_request = json_loads(request, 0, &error);
     if (js_request == NULL) {
         celix_err_pushf("Got json error: %s", error.text);
         return ERROR;
     }
+    return jsonRpc_callWithJson(intf, service, js_request, out);
+}
+
+int jsonRpc_callWithJson(const dyn_interface_type* intf, void* service, const json_t* request, char** out) {
+    int status = OK;
+
     json_t* arguments = NULL;
-    const char* sig;
-    if (json_unpack(js_request, "{s:s}", "m", &sig) != 0) {
-        celix_err_push("Error getting method signature");
-        return ERROR;
+    const struct method_entry* method = NULL;
+    const char* sig = NULL;
+    json_t* jsMethod = json_object_get(request, "m");
+    if (json_is_integer(jsMethod)) {
+        json_int_t index = json_integer_value(jsMethod);
+        method = (index >= 0 && index <= INT_MAX) ? dynInterface_findMethodByIndex(intf, (int)index) : NULL;
+        if (method == NULL) {
+            celix_err_pushf("Cannot find method with index %" JSON_INTEGER_FORMAT, index);
+            return ERROR;
+        }
+        sig = method->id;
+    } else {
+        sig = json_string_value(jsMethod);
+        if (sig == NULL) {
+            celix_err_push("Error getting method signature");
+            return ERROR;
+        }
     }
-    arguments = json_object_get(js_request, "a");
+    arguments = json_object_get(request, "a");
     if (arguments == NULL || !json_is_array(arguments)) {
         celix_err_pushf("Error getting arguments array for %s", sig);
         return ERROR;
     }
 
-    const struct method_entry* method = dynInterface_findMethod(intf, sig);
+    if (method == NULL) {
+        method = dynInterface_findMethod(intf, sig);
+    }
     if (method == NULL) {
         celix_err_pushf("Cannot find method with sig '%s'", sig);
         return ERROR;
@@ -123,8 +87,8 @@ int jsonRpc_call(const dyn_interface_type* intf, void* service, const char* requ
     const struct dyn_function_arguments_head* dynArgs = dynFunction_arguments(method->dynFunc);
     const dyn_function_argument_type* last = TAILQ_LAST(dynArgs, dyn_function_arguments_head);
     int nrOfArgs = dynFunction_nrOfArguments(method->dynFunc);
-    if (nrOfArgs > CELIX_JSON_RPC_MAX_ARGS) {
-        celix_err_pushf("Too many arguments for %s: %d > %d", sig, nrOfArgs, CELIX_JSON_RPC_MAX_ARGS);
+    if (nrOfArgs > CELIX_RPC_MAX_ARGS) {
+        celix_err_pushf("Too many arguments for %s: %d > %d", sig, nrOfArgs, CELIX_RPC_MAX_ARGS);
         return ERROR;
     }
     void* ptr = NULL;
@@ -166,66 +130,85 @@ int jsonRpc_call(const dyn_interface_type* intf, void* service, const char* requ
     (void)dynFunction_call(method->dynFunc, serv->methods[method->index], (void *) &returnVal, rpcArgs.args);
 
     int funcCallStatus = (int)returnVal;
-    //serialize output
-    json_auto_t* jsonResult = NULL;
+    //serialize output, directly as JSON text to avoid creating a json_t reply payload
+    char buf[512];
+    celix_json_writer_t writer;
+    celix_jsonWriter_init(&writer, buf, sizeof(buf));
+    celix_status_t writeStatus;
     if (funcCallStatus == 0) {
         const dyn_type* argType = dynType_realType(last->type);
         if (last->argumentMeta == DYN_FUNCTION_ARGUMENT_META__PRE_ALLOCATED_OUTPUT) {
-            status = jsonSerializer_serializeJson(argType, rpcArgs.args[last->index], &jsonResult);
+            writeStatus = celix_jsonWriter_writeRaw(&writer, "{\"r\":", 5);
+            if (writeStatus == CELIX_SUCCESS) {
+                status = jsonSerializer_serializeToWriter(argType, rpcArgs.args[last->index], &writer);
+            }
         } else if (last->argumentMeta == DYN_FUNCTION_ARGUMENT_META__OUTPUT) {
-            status = jsonSerializer_serializeJson(dynType_typedPointer_getTypedType(argType), (void*) &ptr, &jsonResult);
+            writeStatus = celix_jsonWriter_writeRaw(&writer, "{\"r\":", 5);
+            if (writeStatus == CELIX_SUCCESS) {
+                status = jsonSerializer_serializeToWriter(dynType_typedPointer_getTypedType(argType), (void*) &ptr, &writer);
+            }
+        } else {
+            writeStatus = celix_jsonWriter_writeChar(&writer, '{');
         }
         if (status != OK) {
             celix_err_pushf("Error serializing result for %s", sig);
+            celix_jsonWriter_deinit(&writer);
             return status;
         }
+    } else {
+        writeStatus = celix_jsonWriter_writeRaw(&writer, "{\"e\":", 5);
+        writeStatus = CELIX_DO_IF(writeStatus, celix_jsonWriter_writeInteger(&writer, funcCallStatus));
     }
     celix_rpcArgs_cleanup(&rpcArgs);
 
-    json_auto_t* payload = json_object();
-    if (funcCallStatus == 0) {
-        if (jsonResult != NULL) {
-            status = json_object_set_new_nocheck(payload, "r", celix_steal_ptr(jsonResult));
-        }
-    } else {
-        status = json_object_set_new_nocheck(payload, "e", json_integer(funcCallStatus));
-    }
-    if (status != 0)  {
+    writeStatus = CELIX_DO_IF(writeStatus, celix_jsonWriter_writeChar(&writer, '}'));
+    *out = writeStatus == CELIX_SUCCESS ? celix_jsonWriter_steal(&writer, NULL) : NULL;
+    if (*out == NULL) {
         celix_err_pushf("Error generating response payload for %s", sig);
+        celix_jsonWriter_deinit(&writer);
         return ERROR;
     }
-    //use JSON_COMPACT to reduce the size of the JSON string.
-    *out = json_dumps(payload, JSON_COMPACT | JSON_ENCODE_ANY);
-    return (*out != NULL) ? OK : ERROR;
+    return OK;
 }
 
-int jsonRpc_prepareInvokeRequest(const dyn_function_type* func, const char* id, void* args[], char** out) {
-    json_auto_t* invoke = json_object();
-    // each method must have a non-null id
-    if (json_object_set_new_nocheck(invoke, "m", json_string(id)) != 0) {
-        celix_err_pushf("Error setting method name '%s'", id);
-        return ERROR;
-    }
+/**
+ * Writes the request for the method identified by its index, or by its id if index is -1.
+ */
+static int jsonRpc_writeInvokeRequest(const dyn_function_type* func, const char* id, int index, void* args[],
+                                      char** out) {
+    *out = NULL;
+    celix_json_writer_t writer;
+    celix_jsonWriter_init(&writer, NULL, 0);
 
-    json_auto_t* arguments = json_array();
-    if (json_object_set_nocheck(invoke, "a", arguments) != 0) {
-        celix_err_pushf("Error adding arguments array for '%s'", id);
+    celix_status_t status = celix_jsonWriter_writeRaw(&writer, "{\"m\":", 5);
+    if (index >= 0) {
+        status = CELIX_DO_IF(status, celix_jsonWriter_writeInteger(&writer, index));
+    } else {
+        // each method must have a non-null id
+        status = CELIX_DO_IF(status, celix_jsonWriter_writeString(&writer, id));
+    }
+    status = CELIX_DO_IF(status, celix_jsonWriter_writeRaw(&writer, ",\"a\":[", 6));
+    if (status != CELIX_SUCCESS) {
+        celix_err_pushf("Error setting method name '%s'", id);
+        celix_jsonWriter_deinit(&writer);
         return ERROR;
     }
 
     const struct dyn_function_arguments_head* dynArgs = dynFunction_arguments(func);
     dyn_function_argument_type* entry = NULL;
+    bool firstArg = true;
     TAILQ_FOREACH(entry, dynArgs, entries) {
         const dyn_type* type = dynType_realType(entry->type);
         enum dyn_function_argument_meta meta = entry->argumentMeta;
         if (meta == DYN_FUNCTION_ARGUMENT_META__STD) {
-            json_t* val = NULL;
-
-            int rc = jsonSerializer_serializeJson(type, args[entry->index], &val);
-            if (rc != 0) {
+            int rc = firstArg ? OK : (celix_jsonWriter_writeChar(&writer, ',') == CELIX_SUCCESS ? OK : ERROR);
+            rc = rc == OK ? jsonSerializer_serializeToWriter(type, args[entry->index], &writer) : rc;
+            if (rc != OK) {
                 celix_err_pushf("Failed to serialize args for function '%s'\n", id);
+                celix_jsonWriter_deinit(&writer);
                 return ERROR;
             }
+            firstArg = false;
             if (celix_argType_isStringOrBuiltInObject(type)) {
                 // we need to get meta info from the original type, which could be a reference, rather than the real type
                 const char* metaArgument = dynType_getMetaInfo(entry->type, "const");
@@ -236,22 +219,232 @@ int jsonRpc_prepareInvokeRequest(const dyn_function_type* func, const char* id,
                     dynType_cleanup(type, args[entry->index]);//args[entry->index] is char** or celix_properties_t** or celix_array_list_t**
                 }
             }
-            if (json_array_append_new(arguments, val) != 0) {
-                celix_err_pushf("Error adding argument (%d) for '%s'", entry->index, id);
-                return ERROR;
-            }
         }
     }
 
-    //use JSON_COMPACT to reduce the size of the JSON string.
-    char* invokeStr = json_dumps(invoke, JSON_COMPACT | JSON_ENCODE_ANY);
-    *out = invokeStr;
-    return *out != NULL ? OK : ERROR;
+    if (celix_jsonWriter_writeRaw(&writer, "]}", 2) != CELIX_SUCCESS) {
+        celix_err_pushf("Error writing request for '%s'", id);
+        celix_jsonWriter_deinit(&writer);
+        return ERROR;
+    }
+    *out = celix_jsonWriter_steal(&writer, NULL);
+    if (*out == NULL) {
+        celix_err_pushf("Error generating request for '%s'", id);
+        return ERROR;
+    }
+    return OK;
+}
+
+int jsonRpc_prepareInvokeRequest(const dyn_function_type* func, const char* id, void* args[], char** out) {
+    return jsonRpc_writeInvokeRequest(func, id, -1, args, out);
+}
+
+int jsonRpc_prepareInvokeRequestWithIndex(const dyn_function_type* func, int index, void* args[], char** out) {
+    return jsonRpc_writeInvokeRequest(func, dynFunction_getName(func), index, args, out);
+}
+
+static bool jsonRpc_isSimpleResultType(const dyn_type* type) {
+    return dynType_type(type) == DYN_TYPE_SIMPLE && dynType_descriptorType(type) != 'E';
+}
+
+/**
+ * Reads a simple (non enum) value for the provided type from the reader into loc.
+ * Returns false if the JSON value does not exactly match the type (e.g. an integer for a double).
+ */
+static bool jsonRpc_readSimpleValue(const dyn_type* type, celix_json_reader_t* reader, void* loc) {
+    char c = dynType_descriptorType(type);
+    if (c == 'Z') {
+        bool value;
+        if (celix_jsonReader_readBool(reader, &value) != CELIX_SUCCESS) {
+            return false;
+        }
+        *(bool*)loc = value;
+        return true;
+    }
+    bool isInteger;
+    long long intValue;
+    double realValue;
+    if (celix_jsonReader_readNumber(reader, &isInteger, &intValue, &realValue) != CELIX_SUCCESS) {
+        return false;
+    }
+    if ((c == 'F' || c == 'D') == isInteger) {
+        return false;
+    }
+    switch (c) {
+        case 'F' :
+            *(float*)loc = (float) realValue;
+            break;
+        case 'D' :
+            *(double*)loc = realValue;
+            break;
+        case 'N' :
+            *(int*)loc = (int) intValue;
+            break;
+        case 'B' :
+            *(char*)loc = (char) intValue;
+            break;
+        case 'S' :
+            *(int16_t*)loc = (int16_t) intValue;
+            break;
+        case 'I' :
+            *(int32_t*)loc = (int32_t) intValue;
+            break;
+        case 'J' :
+            *(int64_t*)loc = (int64_t) intValue;
+            break;
+        case 'b' :
+            *(uint8_t*)loc = (uint8_t) intValue;
+            break;
+        case 's' :
+            *(uint16_t*)loc = (uint16_t) intValue;
+            break;
+        case 'i' :
+            *(uint32_t*)loc = (uint32_t) intValue;
+            break;
+        case 'j' :
+            *(uint64_t*)loc = (uint64_t) intValue;
+            break;
+        default :
+            return false;
+    }
+    return true;
+}
+
+/**
+ * Handles a reply of a function without result or with a simple or text result directly from the JSON text, without
+ * creating a json_t tree.
+ * Returns false if the reply cannot be handled this way (e.g. a complex result type or unexpected or invalid input).
+ * In that case nothing is changed and the reply should be handled using jansson, so that errors are reported in a
+ * single place.
+ */
+static bool jsonRpc_handleSimpleReply(const dyn_function_type* func, const char* reply, void* args[], int* rsErrno) {
+    const struct dyn_function_arguments_head* arguments = dynFunction_arguments(func);
+    dyn_function_argument_type* last = TAILQ_LAST(arguments, dyn_function_arguments_head);
+    const dyn_type* argType = dynType_realType(last->type);
+    enum dyn_function_argument_meta meta = last->argumentMeta;
+    const dyn_type* resultType = NULL;
+    bool resultIsText = false;
+    if (meta == DYN_FUNCTION_ARGUMENT_META__PRE_ALLOCATED_OUTPUT) {
+        resultType = dynType_typedPointer_getTypedType(argType);
+    } else if (meta == DYN_FUNCTION_ARGUMENT_META__OUTPUT) {
+        const dyn_type* subType = dynType_typedPointer_getTypedType(argType);
+        resultIsText = dynType_type(subType) == DYN_TYPE_TEXT;
+        resultType = resultIsText ? subType : (dynType_type(subType) == DYN_TYPE_TYPED_POINTER ?
+                                               dynType_typedPointer_getTypedType(subType) : NULL);
+        if (resultType == NULL) {
+            return false;
+        }
+    }
+    if (resultType != NULL && !resultIsText && !jsonRpc_isSimpleResultType(resultType)) {
+        return false;
+    }
+
+    celix_json_reader_t reader;
+    celix_jsonReader_init(&reader, reply, strlen(reply));
+    if (!celix_jsonReader_consume(&reader, '{')) {
+        return false;
+    }
+    bool hasError = false;
+    long long rsError = 0;
+    bool hasResult = false;
+    celix_json_reader_t resultReader;
+    char keyBuf[32];
+    celix_json_writer_t key;
+    celix_jsonWriter_init(&key, keyBuf, sizeof(keyBuf));
+    bool valid = celix_jsonReader_consume(&reader, '}');
+    bool atEnd = valid;
+    while (!atEnd) {
+        celix_jsonWriter_truncate(&key, 0);
+        valid = celix_jsonReader_readString(&reader, &key) == CELIX_SUCCESS && celix_jsonReader_consume(&reader, ':');
+        if (valid && strcmp(key.data, "e") == 0 && !hasError) {
+            double realValue;
+            bool isInteger = false;
+            hasError = true;
+            valid = celix_jsonReader_readNumber(&reader, &isInteger, &rsError, &realValue) == CELIX_SUCCESS && isInteger;
+        } else if (valid && strcmp(key.data, "r") == 0 && !hasResult) {
+            hasResult = true;
+            (void)celix_jsonReader_peek(&reader); //skip whitespace
+            resultReader = reader;
+            valid = celix_jsonReader_skipValue(&reader, 64) == CELIX_SUCCESS;
+        } else if (valid && strcmp(key.data, "e") != 0 && strcmp(key.data, "r") != 0) {
+            valid = celix_jsonReader_skipValue(&reader, 64) == CELIX_SUCCESS;
+        } else {
+            valid = false; //duplicate key
+        }
+        atEnd = valid && celix_jsonReader_consume(&reader, '}');
+        if (!valid || (!atEnd && !celix_jsonReader_consume(&reader, ','))) {
+            celix_jsonWriter_deinit(&key);
+            return false;
+        }
+    }
+    celix_jsonWriter_deinit(&key);
+    if (!celix_jsonReader_isAtEnd(&reader)) {
+        return false;
+    }
+
+    if (hasError) {
+        //get the invocation error of remote service function
+        *rsErrno = (int)rsError;
+        return true;
+    }
+    if (resultType == NULL) {
+        *rsErrno = 0;
+        return true;
+    }
+    if (!hasResult) {
+        return false;
+    }
+    void** lastArg = (void**)args[last->index];
+    if (*lastArg == NULL) {
+        // caller provides nullptr, no need to deserialize
+        *rsErrno = 0;
+        return true;
+    }
+
+    if (meta == DYN_FUNCTION_ARGUMENT_META__PRE_ALLOCATED_OUTPUT) {
+        if (!jsonRpc_readSimpleValue(resultType, &resultReader, *lastArg)) {
+            return false;
+        }
+    } else if (celix_jsonReader_peek(&resultReader) == 'n') {
+        if (celix_jsonReader_readNull(&resultReader) != CELIX_SUCCESS) {
+            return false;
+        }
+        **(void***)lastArg = NULL;
+    } else if (resultIsText) {
+        char buf[128];
+        celix_json_writer_t text;
+        celix_jsonWriter_init(&text, buf, sizeof(buf));
+        if (celix_jsonReader_readString(&resultReader, &text) != CELIX_SUCCESS) {
+            celix_jsonWriter_deinit(&text);
+            return false;
+        }
+        char* str = celix_jsonWriter_steal(&text, NULL);
+        if (str == NULL) {
+            return false;
+        }
+        **(char***)lastArg = str;
+    } else {
+        void* value = NULL;
+        if (dynType_alloc(resultType, &value) != OK) {
+            return false;
+        }
+        if (!jsonRpc_readSimpleValue(resultType, &resultReader, value)) {
+            dynType_free(resultType, value);
+            return false;
+        }
+        **(void***)lastArg = value;
+    }
+    *rsErrno = 0;
+    return true;
 }
 
 int jsonRpc_handleReply(const dyn_function_type* func, const char* reply, void* args[], int* rsErrno) {
     int status = OK;
 
+    if (jsonRpc_handleSimpleReply(func, reply, args, rsErrno)) {
+        return OK;
+    }
+
     json_error_t error;
     json_auto_t* replyJson = json_loads(reply, JSON_DECODE_ANY, &error);
     if (replyJson == NULL) {
@@ -20,6 +20,8 @@
 #include "json_serializer.h"
 #include "dyn_type.h"
 #include "dyn_type_common.h"
+#include "json_serializer_common.h"
+#include "dyn_serializer_plan.h"
 #include "celix_properties.h"
 #include "celix_array_list.h"
 #include "celix_array_list_encoding.h"
@@ -28,24 +30,30 @@
 
 #include <jansson.h>
 #include <assert.h>
+#include <math.h>
 #include <stdint.h>
 #include <string.h>
 
 static int jsonSerializer_createType(const dyn_type* type, json_t* object, void** result);
-static int jsonSerializer_parseObject(const dyn_type* type, json_t* object, void* inst);
-static int jsonSerializer_parseSequence(const dyn_type* seq, json_t* array, void* seqLoc);
-static int jsonSerializer_parseAny(const dyn_type* type, void* input, json_t* val);
+static int jsonSerializer_parseObject(const struct dyn_serializer_op* op, json_t* object, char* base);
+static int jsonSerializer_parseSequence(const struct dyn_serializer_op* op, json_t* array, void* seqLoc);
+static int jsonSerializer_parseAny(const struct dyn_serializer_op* op, char* base, json_t* val);
 static int jsonSerializer_parseEnum(const dyn_type* type, const char* enum_name, int32_t* out);
 static int jsonSerializer_parseProperties(const dyn_type* type, json_t* object, void *inst);
 static int jsonSerializer_parseArrayList(const dyn_type* type, json_t* array, void *inst);
 
-static int jsonSerializer_writeAny(const dyn_type* type, const void* input, json_t** val);
-static int jsonSerializer_writeComplex(const dyn_type* type, const void* input, json_t** val);
-static int jsonSerializer_writeSequence(const dyn_type* type, const void* input, json_t** out);
+static int jsonSerializer_writeAny(const struct dyn_serializer_op* op, const char* base, json_t** val);
+static int jsonSerializer_writeComplex(const struct dyn_serializer_op* op, const char* base, json_t** val);
+static int jsonSerializer_writeSequence(const struct dyn_serializer_op* op, const void* input, json_t** out);
 static int jsonSerializer_writeEnum(const dyn_type* type, int32_t enum_value, json_t** out);
 static int jsonSerializer_writeProperties(const dyn_type* type, const void* input, json_t** out);
 static int jsonSerializer_writeArrayList(const dyn_type* type, const void* input, json_t** out);
 
+static int jsonSerializer_emitAny(const struct dyn_serializer_op* op, const char* base, celix_json_writer_t* writer);
+static int jsonSerializer_emitComplex(const struct dyn_serializer_op* op, const char* base, celix_json_writer_t* writer);
+static int jsonSerializer_emitSequence(const struct dyn_serializer_op* op, const void* input, celix_json_writer_t* writer);
+static int jsonSerializer_emitEnum(const dyn_type* type, int32_t enumValue, celix_json_writer_t* writer);
+static int jsonSerializer_emitJson(const struct dyn_serializer_op* op, const char* base, celix_json_writer_t* writer);
 
 static int OK = 0;
 static int ERROR = 1;
@@ -76,11 +84,16 @@ static int jsonSerializer_createType(const dyn_type* type, json_t* val, void** r
     int status = OK;
     void* inst = NULL;
 
+    const struct dyn_serializer_plan* plan = dynSerializer_getPlan(type);
+    if (plan == NULL) {
+        return ERROR;
+    }
+
     if ((status = dynType_alloc(type, &inst)) != OK) {
         return status;
     }
 
-    if ((status = jsonSerializer_parseAny(type, inst, val)) != OK) {
+    if ((status = jsonSerializer_parseAny(&plan->ops[0], inst, val)) != OK) {
         dynType_free(type, inst);
         *result = NULL;
         return status;
@@ -90,158 +103,141 @@ static int jsonSerializer_createType(const dyn_type* type, json_t* val, void** r
     return OK;
 }
 
-static int jsonSerializer_parseObject(const dyn_type* type, json_t* object, void* inst) {
+static int jsonSerializer_parseObject(const struct dyn_serializer_op* op, json_t* object, char* base) {
     assert(object != NULL);
     int status = OK;
-    json_t* value;
-    const struct complex_type_entries_head* entries = dynType_complex_entries(type);
-    struct complex_type_entry* entry = NULL;
-    int index = 0;
-    void* valp = NULL;
-    const dyn_type* valType = NULL;
-    TAILQ_FOREACH(entry, entries, entries) {
-        if (entry->name == NULL) {
-            celix_err_push("Unamed field unsupported");
-            return ERROR;
-        }
-        value = json_object_get(object, entry->name);
+    const struct dyn_serializer_op* end = op + op->span;
+    for (const struct dyn_serializer_op* member = op + 1; member < end; member += member->span) {
+        json_t* value = json_object_get(object, member->name);
         if (value == NULL) {
-            celix_err_pushf("Missing object member %s", entry->name);
+            celix_err_pushf("Missing object member %s", member->name);
             return ERROR;
         }
-        valp = dynType_complex_valLocAt(type, index, inst);
-        valType = dynType_complex_dynTypeAt(type, index);
-        status = jsonSerializer_parseAny(valType, valp, value);
+        status = jsonSerializer_parseAny(member, base, value);
         if (status != OK) {
             break;
         }
-        index++;
     }
 
     return status;
 }
 
-static int jsonSerializer_parseAny(const dyn_type* type, void* loc, json_t* val) {
+static int jsonSerializer_parseAny(const struct dyn_serializer_op* op, char* base, json_t* val) {
     int status = OK;
+    void* loc = base + op->offset;
 
-    const dyn_type* subType = NULL;
-    char c = dynType_descriptorType(type);
-
-    switch (c) {
-        case 'Z' :
+    switch (op->kind) {
+        case DYN_SERIALIZER_OP_BOOL :
             *(bool*)loc = (bool) json_is_true(val);
             break;
-        case 'F' :
+        case DYN_SERIALIZER_OP_FLOAT :
             *(float*)loc = (float) json_real_value(val);
             break;
-        case 'D' :
+        case DYN_SERIALIZER_OP_DOUBLE :
             *(double*)loc = json_real_value(val);
             break;
-        case 'N' :
+        case DYN_SERIALIZER_OP_NATIVE_INT :
             *(int*)loc = (int) json_integer_value(val);
             break;
-        case 'B' :
+        case DYN_SERIALIZER_OP_INT8 :
             *(char*)loc = (char) json_integer_value(val);
             break;
-        case 'S' :
+        case DYN_SERIALIZER_OP_INT16 :
             *(int16_t*)loc = (int16_t) json_integer_value(val);
             break;
-        case 'I' :
+        case DYN_SERIALIZER_OP_INT32 :
             *(int32_t*)loc = (int32_t) json_integer_value(val);
             break;
-        case 'J' :
+        case DYN_SERIALIZER_OP_INT64 :
             *(int64_t*)loc = (int64_t) json_integer_value(val);
             break;
-        case 'b' :
+        case DYN_SERIALIZER_OP_UINT8 :
             *(uint8_t*)loc = (uint8_t) json_integer_value(val);
             break;
-        case 's' :
+        case DYN_SERIALIZER_OP_UINT16 :
             *(uint16_t*)loc = (uint16_t) json_integer_value(val);
             break;
-        case 'i' :
+        case DYN_SERIALIZER_OP_UINT32 :
             *(uint32_t*)loc = (uint32_t) json_integer_value(val);
             break;
-        case 'j' :
+        case DYN_SERIALIZER_OP_UINT64 :
             *(uint64_t*)loc = (uint64_t) json_integer_value(val);
             break;
-        case 'E' :
+        case DYN_SERIALIZER_OP_ENUM :
             if (json_is_string(val)){
-                status = jsonSerializer_parseEnum(type, json_string_value(val), loc);
+                status = jsonSerializer_parseEnum(op->type, json_string_value(val), loc);
             } else {
                 status = ERROR;
                 celix_err_pushf("Expected json string for enum type but got %i", json_typeof(val));
             }
             break;
-        case 't' :
+        case DYN_SERIALIZER_OP_TEXT :
             if (json_is_null(val)) {
                 // NULL string is allowed
             } else if (json_is_string(val)) {
-                status = dynType_text_allocAndInit(type, loc, json_string_value(val));
+                status = dynType_text_allocAndInit(op->type, loc, json_string_value(val));
             } else {
                 status = ERROR;
                 celix_err_pushf("Expected json string type got %i", json_typeof(val));
             }
             break;
-        case 'p':
+        case DYN_SERIALIZER_OP_PROPERTIES :
             if (json_is_null(val)) {
                 // NULL celix_properties_t* is allowed
             } else if (json_is_object(val)) {
-                status = jsonSerializer_parseProperties(type, val, loc);
+                status = jsonSerializer_parseProperties(op->type, val, loc);
             } else {
                 status = ERROR;
                 celix_err_pushf("Expected json object for celix_properties_t* type but got %i", json_typeof(val));
             }
             break;
-        case 'a':
+        case DYN_SERIALIZER_OP_ARRAY_LIST :
             if (json_is_null(val)) {
                 // NULL celix_array_list_t* is allowed
             } else if (json_is_array(val)) {
-                status = jsonSerializer_parseArrayList(type, val, loc);
+                status = jsonSerializer_parseArrayList(op->type, val, loc);
             } else {
                 status = ERROR;
                 celix_err_pushf("Expected json array for celix_array_list_t* type but got %i", json_typeof(val));
             }
             break;
-        case '[' :
+        case DYN_SERIALIZER_OP_SEQUENCE :
             if (json_is_array(val)) {
-                status = jsonSerializer_parseSequence(type, val, loc);
+                status = jsonSerializer_parseSequence(op, val, loc);
             } else {
                 status = ERROR;
                 celix_err_pushf("Expected json array type got '%i'", json_typeof(val));
             }
             break;
-        case '{' :
+        case DYN_SERIALIZER_OP_OBJECT :
             if (json_is_object(val)) {
-                status = jsonSerializer_parseObject(type, val, loc);
+                status = jsonSerializer_parseObject(op, val, base);
             } else {
                 status = ERROR;
                 celix_err_pushf("Expected json object type got '%i'", json_typeof(val));
             }
             break;
-        case '*' :
-            subType = dynType_typedPointer_getTypedType(type);
-            if (dynType_ffiType(subType) != &ffi_type_pointer) {
-                // NULL pointer is allowed
-                if (!json_is_null(val)) {
-                    status = jsonSerializer_createType(subType, val, (void **) loc);
-                }
-            } else {
-                status = ERROR;
-                celix_err_pushf("Error cannot deserialize pointer to pointer");
+        case DYN_SERIALIZER_OP_TYPED_POINTER :
+            // NULL pointer is allowed
+            if (!json_is_null(val)) {
+                status = jsonSerializer_createType(op->subType, val, (void **) loc);
             }
             break;
-        //case 'P' :
+        case DYN_SERIALIZER_OP_POINTER_TO_POINTER :
+            status = ERROR;
+            celix_err_pushf("Error cannot deserialize pointer to pointer");
+            break;
         default :
             status = ERROR;
-            celix_err_pushf("Error provided type '%c' not supported for JSON\n", c);
+            celix_err_pushf("Error provided type '%c' not supported for JSON\n", dynType_descriptorType(op->type));
             break;
     }
 
     return status;
 }
 
-static int jsonSerializer_parseSequence(const dyn_type* seq, json_t* array, void* seqLoc) {
-    assert(dynType_type(seq) == DYN_TYPE_SEQUENCE);
+static int jsonSerializer_parseSequence(const struct dyn_serializer_op* op, json_t* array, void* seqLoc) {
+    assert(dynType_type(op->type) == DYN_TYPE_SEQUENCE);
     int status = OK;
 
     size_t size = json_array_size(array);
@@ -249,17 +245,24 @@ static int jsonSerializer_parseSequence(const dyn_type* seq, json_t* array, void
         celix_err_pushf("Error array size(%zu) too large", size);
         return ERROR;
     }
-    if ((status = dynType_sequence_alloc(seq, seqLoc, (uint32_t) size)) != OK) {
+    if ((status = dynType_sequence_alloc(op->type, seqLoc, (uint32_t) size)) != OK) {
         return status;
     }
+    if (size == 0) {
+        return OK;
+    }
 
-    const dyn_type* itemType = dynType_sequence_itemType(seq);
+    const struct dyn_serializer_plan* itemPlan = dynSerializer_getPlan(op->subType);
+    if (itemPlan == NULL) {
+        return ERROR;
+    }
+    struct generic_sequence* seq = seqLoc;
     size_t index;
     json_t* val;
     json_array_foreach(array, index, val) {
-        void* valLoc = NULL;
-        (void)dynType_sequence_increaseLengthAndReturnLastLoc(seq, seqLoc, &valLoc);
-        status = jsonSerializer_parseAny(itemType, valLoc, val);
+        char* valLoc = (char*)seq->buf + index * op->subTypeSize;
+        seq->len += 1;
+        status = jsonSerializer_parseAny(&itemPlan->ops[0], valLoc, val);
         if (status != OK) {
             break;
         }
@@ -321,89 +324,92 @@ static int jsonSerializer_parseEnum(const dyn_type* type, const char* enum_name,
 }
 
 int jsonSerializer_serializeJson(const dyn_type* type, const void* input, json_t** out) {
-    return jsonSerializer_writeAny(dynType_realType(type), input, out);
+    const struct dyn_serializer_plan* plan = dynSerializer_getPlan(dynType_realType(type));
+    if (plan == NULL) {
+        return ERROR;
+    }
+    return jsonSerializer_writeAny(&plan->ops[0], input, out);
 }
 
-static int jsonSerializer_writeAny(const dyn_type* type, const void* input, json_t** out) {
+static int jsonSerializer_writeAny(const struct dyn_serializer_op* op, const char* base, json_t** out) {
     int status = OK;
 
-    int descriptor = dynType_descriptorType(type);
+    const void* input = base + op->offset;
     json_auto_t* val = NULL;
-    const dyn_type* subType = NULL;
 
-    switch (descriptor) {
-        case 'Z' :
+    switch (op->kind) {
+        case DYN_SERIALIZER_OP_BOOL :
             val = json_boolean(*(const bool*)input);
             break;
-        case 'B' :
+        case DYN_SERIALIZER_OP_INT8 :
             val = json_integer((json_int_t)*(const char*)input);
             break;
-        case 'S' :
+        case DYN_SERIALIZER_OP_INT16 :
             val = json_integer((json_int_t)*(const int16_t*)input);
             break;
-        case 'I' :
+        case DYN_SERIALIZER_OP_INT32 :
             val = json_integer((json_int_t)*(const int32_t*)input);
             break;
-        case 'J' :
+        case DYN_SERIALIZER_OP_INT64 :
             val = json_integer((json_int_t)*(const int64_t*)input);
             break;
-        case 'b' :
+        case DYN_SERIALIZER_OP_UINT8 :
             val = json_integer((json_int_t)*(const uint8_t*)input);
             break;
-        case 's' :
+        case DYN_SERIALIZER_OP_UINT16 :
             val = json_integer((json_int_t)*(const uint16_t*)input);
             break;
-        case 'i' :
+        case DYN_SERIALIZER_OP_UINT32 :
             val = json_integer((json_int_t)*(const uint32_t *)input);
             break;
-        case 'j' :
+        case DYN_SERIALIZER_OP_UINT64 :
             val = json_integer((json_int_t)*(const uint64_t*)input);
             break;
-        case 'N' :
+        case DYN_SERIALIZER_OP_NATIVE_INT :
             val = json_integer((json_int_t)*(const int*)input);
             break;
-        case 'F' :
+        case DYN_SERIALIZER_OP_FLOAT :
             val = json_real((double) *(const float*)input);
             break;
-        case 'D' :
+        case DYN_SERIALIZER_OP_DOUBLE :
             val = json_real(*(const double*)input);
             break;
-        case 't' : {
+        case DYN_SERIALIZER_OP_TEXT : {
             const char *strValue = *(const char **) input;
             val = (strValue != NULL) ? json_string(strValue) : json_null();
             break;
         }
-        case 'E':
-            status = jsonSerializer_writeEnum(type, *(const int32_t*)input, &val);
-            break;
-        case 'p' :
-            status = jsonSerializer_writeProperties(type, input, &val);
-            break;
-        case 'a' :
-            status = jsonSerializer_writeArrayList(type, input, &val);
-            break;
-        case '*' :
-            subType = dynType_typedPointer_getTypedType(type);
-            if (dynType_ffiType(subType) != &ffi_type_pointer) {
-                const void* inputValue = *(const void**)input;
-                if (inputValue) {
-                    status = jsonSerializer_writeAny(subType, inputValue, &val);
-                } else {
-                    val = json_null();
-                }
+        case DYN_SERIALIZER_OP_ENUM :
+            status = jsonSerializer_writeEnum(op->type, *(const int32_t*)input, &val);
+            break;
+        case DYN_SERIALIZER_OP_PROPERTIES :
+            status = jsonSerializer_writeProperties(op->type, input, &val);
+            break;
+        case DYN_SERIALIZER_OP_ARRAY_LIST :
+            status = jsonSerializer_writeArrayList(op->type, input, &val);
+            break;
+        case DYN_SERIALIZER_OP_TYPED_POINTER : {
+            const void* inputValue = *(const void**)input;
+            if (inputValue) {
+                const struct dyn_serializer_plan* subPlan = dynSerializer_getPlan(op->subType);
+                status = subPlan != NULL ? jsonSerializer_writeAny(&subPlan->ops[0], inputValue, &val) : ERROR;
             } else {
-                status = ERROR;
-                celix_err_pushf("Error cannot serialize pointer to pointer");
+                val = json_null();
             }
             break;
-        case '{' :
-            status = jsonSerializer_writeComplex(type, input, &val);
+        }
+        case DYN_SERIALIZER_OP_POINTER_TO_POINTER :
+            status = ERROR;
+            celix_err_pushf("Error cannot serialize pointer to pointer");
+            break;
+        case DYN_SERIALIZER_OP_OBJECT :
+            status = jsonSerializer_writeComplex(op, base, &val);
             break;
-        case '[' :
-            status = jsonSerializer_writeSequence(type, input, &val);
+        case DYN_SERIALIZER_OP_SEQUENCE :
+            status = jsonSerializer_writeSequence(op, input, &val);
             break;
         default :
-            celix_err_pushf("Unsupported descriptor '%c'", descriptor);
+            celix_err_pushf("Unsupported descriptor '%c'", dynType_descriptorType(op->type));
             status = ERROR;
             break;
     }
@@ -414,25 +420,29 @@ static int jsonSerializer_writeAny(const dyn_type* type, const void* input, json
     return *out != NULL ? OK : ERROR;
 }
 
-static int jsonSerializer_writeSequence(const dyn_type* type, const void* input, json_t** out) {
-    assert(dynType_type(type) == DYN_TYPE_SEQUENCE);
+static int jsonSerializer_writeSequence(const struct dyn_serializer_op* op, const void* input, json_t** out) {
+    assert(dynType_type(op->type) == DYN_TYPE_SEQUENCE);
 
     json_auto_t* array = json_array();
     if (array == NULL) {
         return ERROR;
     }
-    const dyn_type* itemType = dynType_sequence_itemType(type);
-    uint32_t len = dynType_sequence_length(input);
+    const struct generic_sequence* seq = input;
+    if (seq->len > seq->cap) {
+        celix_err_pushf("Sequence length (%u) is greater than capacity (%u)", seq->len, seq->cap);
+        celix_err_push("Cannot serialize invalid sequence");
+        return ERROR;
+    }
+    const struct dyn_serializer_plan* itemPlan = NULL;
+    if (seq->len > 0 && (itemPlan = dynSerializer_getPlan(op->subType)) == NULL) {
+        return ERROR;
+    }
 
-    for (uint32_t i = 0; i < len; i += 1) {
+    for (uint32_t i = 0; i < seq->len; i += 1) {
         int status = OK;
-        void* itemLoc = NULL;
+        const char* itemLoc = (const char*)seq->buf + i * op->subTypeSize;
         json_t* item = NULL;
-        if ((status = dynType_sequence_locForIndex(type, input, i, &itemLoc)) != OK) {
-            celix_err_push("Cannot serialize invalid sequence");
-            return status;
-        }
-        if ((status = jsonSerializer_writeAny(itemType, itemLoc, &item)) != OK) {
+        if ((status = jsonSerializer_writeAny(&itemPlan->ops[0], itemLoc, &item)) != OK) {
             return status;
         }
         if ((json_array_append_new(array, item)) != 0) {
@@ -444,41 +454,199 @@ static int jsonSerializer_writeSequence(const dyn_type* type, const void* input,
     return OK;
 }
 
-static int jsonSerializer_writeComplex(const dyn_type* type, const void* input, json_t** out) {
-    assert(dynType_type(type) == DYN_TYPE_COMPLEX);
+static int jsonSerializer_writeComplex(const struct dyn_serializer_op* op, const char* base, json_t** out) {
+    assert(dynType_type(op->type) == DYN_TYPE_COMPLEX);
 
     json_auto_t* val = json_object();
     if (val == NULL) {
         return ERROR;
     }
-    struct complex_type_entry* entry = NULL;
-    const struct complex_type_entries_head* entries = dynType_complex_entries(type);
-    int index = 0;
 
-    TAILQ_FOREACH(entry, entries, entries) {
+    const struct dyn_serializer_op* end = op + op->span;
+    for (const struct dyn_serializer_op* member = op + 1; member < end; member += member->span) {
         int status;
-        void* subLoc = NULL;
         json_t* subVal = NULL;
-        const dyn_type* subType = NULL;
-        if (entry->name == NULL) {
-            celix_err_push("Unamed field unsupported");
-            return ERROR;
-        }
-        subLoc = dynType_complex_valLocAt(type, index, (void*)input);
-        subType = dynType_complex_dynTypeAt(type, index);
-        if ((status = jsonSerializer_writeAny(subType, subLoc, &subVal)) != OK) {
+        if ((status = jsonSerializer_writeAny(member, base, &subVal)) != OK) {
             return status;
         }
-        if (json_object_set_new(val, entry->name, subVal) != 0) {
+        if (json_object_set_new(val, member->name, subVal) != 0) {
             return ERROR;
         }
-        index++;
     }
 
     *out = celix_steal_ptr(val);
     return OK;
 }
 
+int jsonSerializer_serializeToWriter(const dyn_type* type, const void* input, celix_json_writer_t* writer) {
+    const struct dyn_serializer_plan* plan = dynSerializer_getPlan(dynType_realType(type));
+    if (plan == NULL) {
+        return ERROR;
+    }
+    return jsonSerializer_emitAny(&plan->ops[0], input, writer);
+}
+
+static int jsonSerializer_emitReal(double value, celix_json_writer_t* writer) {
+    if (!isfinite(value)) {
+        //JSON has no representation for NaN or infinity (json_real also rejects these)
+        celix_err_push("Cannot serialize non-finite real value");
+        return ERROR;
+    }
+    return celix_jsonWriter_writeReal(writer, value) == CELIX_SUCCESS ? OK : ERROR;
+}
+
+static int jsonSerializer_emitAny(const struct dyn_serializer_op* op, const char* base, celix_json_writer_t* writer) {
+    celix_status_t status = CELIX_SUCCESS;
+    const void* input = base + op->offset;
+
+    switch (op->kind) {
+        case DYN_SERIALIZER_OP_BOOL :
+            status = celix_jsonWriter_writeBool(writer, *(const bool*)input);
+            break;
+        case DYN_SERIALIZER_OP_INT8 :
+            status = celix_jsonWriter_writeInteger(writer, (long long)*(const char*)input);
+            break;
+        case DYN_SERIALIZER_OP_INT16 :
+            status = celix_jsonWriter_writeInteger(writer, (long long)*(const int16_t*)input);
+            break;
+        case DYN_SERIALIZER_OP_INT32 :
+            status = celix_jsonWriter_writeInteger(writer, (long long)*(const int32_t*)input);
+            break;
+        case DYN_SERIALIZER_OP_INT64 :
+            status = celix_jsonWriter_writeInteger(writer, (long long)*(const int64_t*)input);
+            break;
+        case DYN_SERIALIZER_OP_UINT8 :
+            status = celix_jsonWriter_writeInteger(writer, (long long)*(const uint8_t*)input);
+            break;
+        case DYN_SERIALIZER_OP_UINT16 :
+            status = celix_jsonWriter_writeInteger(writer, (long long)*(const uint16_t*)input);
+            break;
+        case DYN_SERIALIZER_OP_UINT32 :
+            status = celix_jsonWriter_writeInteger(writer, (long long)*(const uint32_t*)input);
+            break;
+        case DYN_SERIALIZER_OP_UINT64 :
+            status = celix_jsonWriter_writeInteger(writer, (long long)*(const uint64_t*)input);
+            break;
+        case DYN_SERIALIZER_OP_NATIVE_INT :
+            status = celix_jsonWriter_writeInteger(writer, (long long)*(const int*)input);
+            break;
+        case DYN_SERIALIZER_OP_FLOAT :
+            return jsonSerializer_emitReal((double)*(const float*)input, writer);
+        case DYN_SERIALIZER_OP_DOUBLE :
+            return jsonSerializer_emitReal(*(const double*)input, writer);
+        case DYN_SERIALIZER_OP_TEXT : {
+            const char* strValue = *(const char**)input;
+            status = strValue != NULL ? celix_jsonWriter_writeString(writer, strValue)
+                                      : celix_jsonWriter_writeRaw(writer, "null", 4);
+            break;
+        }
+        case DYN_SERIALIZER_OP_ENUM :
+            return jsonSerializer_emitEnum(op->type, *(const int32_t*)input, writer);
+        case DYN_SERIALIZER_OP_PROPERTIES :
+        case DYN_SERIALIZER_OP_ARRAY_LIST :
+            return jsonSerializer_emitJson(op, base, writer);
+        case DYN_SERIALIZER_OP_TYPED_POINTER : {
+            const void* inputValue = *(const void**)input;
+            if (inputValue == NULL) {
+                status = celix_jsonWriter_writeRaw(writer, "null", 4);
+                break;
+            }
+            const struct dyn_serializer_plan* subPlan = dynSerializer_getPlan(op->subType);
+            return subPlan != NULL ? jsonSerializer_emitAny(&subPlan->ops[0], inputValue, writer) : ERROR;
+        }
+        case DYN_SERIALIZER_OP_POINTER_TO_POINTER :
+            celix_err_pushf("Error cannot serialize pointer to pointer");
+            return ERROR;
+        case DYN_SERIALIZER_OP_OBJECT :
+            return jsonSerializer_emitComplex(op, base, writer);
+        case DYN_SERIALIZER_OP_SEQUENCE :
+            return jsonSerializer_emitSequence(op, input, writer);
+        default :
+            celix_err_pushf("Unsupported descriptor '%c'", dynType_descriptorType(op->type));
+            return ERROR;
+    }
+    return status == CELIX_SUCCESS ? OK : ERROR;
+}
+
+static int jsonSerializer_emitSequence(const struct dyn_serializer_op* op, const void* input, celix_json_writer_t* writer) {
+    const struct generic_sequence* seq = input;
+    if (seq->len > seq->cap) {
+        celix_err_pushf("Sequence length (%u) is greater than capacity (%u)", seq->len, seq->cap);
+        celix_err_push("Cannot serialize invalid sequence");
+        return ERROR;
+    }
+    const struct dyn_serializer_plan* itemPlan = NULL;
+    if (seq->len > 0 && (itemPlan = dynSerializer_getPlan(op->subType)) == NULL) {
+        return ERROR;
+    }
+
+    if (celix_jsonWriter_writeChar(writer, '[') != CELIX_SUCCESS) {
+        return ERROR;
+    }
+    for (uint32_t i = 0; i < seq->len; i += 1) {
+        if (i > 0 && celix_jsonWriter_writeChar(writer, ',') != CELIX_SUCCESS) {
+            return ERROR;
+        }
+        const char* itemLoc = (const char*)seq->buf + i * op->subTypeSize;
+        int status = jsonSerializer_emitAny(&itemPlan->ops[0], itemLoc, writer);
+        if (status != OK) {
+            return status;
+        }
+    }
+    return celix_jsonWriter_writeChar(writer, ']') == CELIX_SUCCESS ? OK : ERROR;
+}
+
+static int jsonSerializer_emitComplex(const struct dyn_serializer_op* op, const char* base, celix_json_writer_t* writer) {
+    if (celix_jsonWriter_writeChar(writer, '{') != CELIX_SUCCESS) {
+        return ERROR;
+    }
+    const struct dyn_serializer_op* end = op + op->span;
+    for (const struct dyn_serializer_op* member = op + 1; member < end; member += member->span) {
+        celix_status_t status = member != op + 1 ? celix_jsonWriter_writeChar(writer, ',') : CELIX_SUCCESS;
+        status = CELIX_DO_IF(status, celix_jsonWriter_writeString(writer, member->name));
+        status = CELIX_DO_IF(status, celix_jsonWriter_writeChar(writer, ':'));
+        if (status != CELIX_SUCCESS) {
+            return ERROR;
+        }
+        int rc = jsonSerializer_emitAny(member, base, writer);
+        if (rc != OK) {
+            return rc;
+        }
+    }
+    return celix_jsonWriter_writeChar(writer, '}') == CELIX_SUCCESS ? OK : ERROR;
+}
+
+static int jsonSerializer_emitEnum(const dyn_type* type, int32_t enumValue, celix_json_writer_t* writer) {
+    char enumValueStr[32];
+    snprintf(enumValueStr, sizeof(enumValueStr), "%d", enumValue);
+
+    struct meta_entry* entry;
+    TAILQ_FOREACH(entry, &type->metaProperties, entries) {
+        if (0 == strcmp(enumValueStr, entry->value)) {
+            return celix_jsonWriter_writeString(writer, entry->name) == CELIX_SUCCESS ? OK : ERROR;
+        }
+    }
+
+    celix_err_pushf("Could not find Enum value %s in enum type", enumValueStr);
+    return ERROR;
+}
+
+/**
+ * Built-in objects (celix_properties_t* and celix_array_list_t*) are still converted using a jansson json_t.
+ */
+static int jsonSerializer_emitJson(const struct dyn_serializer_op* op, const char* base, celix_json_writer_t* writer) {
+    json_auto_t* val = NULL;
+    int status = jsonSerializer_writeAny(op, base, &val);
+    if (status != OK) {
+        return status;
+    }
+    celix_autofree char* str = json_dumps(val, JSON_COMPACT | JSON_ENCODE_ANY);
+    if (str == NULL) {
+        return ERROR;
+    }
+    return celix_jsonWriter_writeRaw(writer, str, strlen(str)) == CELIX_SUCCESS ? OK : ERROR;
+}
+
 static int jsonSerializer_writeEnum(const dyn_type* type, int32_t enum_value, json_t **out) {
     struct meta_entry * entry;
 
@@ -555,4 +723,3 @@ static int jsonSerializer_writeArrayList(const dyn_type* type, const void* input
     }
     return OK;
 }
-
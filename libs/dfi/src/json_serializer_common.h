@@ -0,0 +1,42 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef _JSON_SERIALIZER_COMMON_H_
+#define _JSON_SERIALIZER_COMMON_H_
+
+#include "dyn_type.h"
+#include "celix_json_stream_internal.h"
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Serializes the provided input as compact JSON text directly into the writer, without creating a jansson json_t
+ * tree. The written text is identical to json_dumps(JSON_COMPACT | JSON_ENCODE_ANY) of jsonSerializer_serializeJson.
+ */
+int jsonSerializer_serializeToWriter(const dyn_type* type, const void* input, celix_json_writer_t* writer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
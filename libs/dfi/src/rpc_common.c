@@ -0,0 +1,66 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "rpc_common.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+bool celix_argType_isStringOrBuiltInObject(const dyn_type* type) {
+    int t = dynType_type(type);
+    return t == DYN_TYPE_TEXT || t == DYN_TYPE_BUILTIN_OBJECT;
+}
+
+void celix_rpcArgs_cleanup(celix_rpc_args_t* args) {
+    const struct dyn_function_arguments_head* dynArgs = args->dynArgs;
+    if (dynArgs == NULL) {
+        return;
+    }
+    dyn_function_argument_type* entry = NULL;
+    TAILQ_FOREACH(entry, dynArgs, entries) {
+        const dyn_type* argType = dynType_realType(entry->type);
+        enum dyn_function_argument_meta meta = entry->argumentMeta;
+        if (meta == DYN_FUNCTION_ARGUMENT_META__STD) {
+            if (celix_argType_isStringOrBuiltInObject(argType)) {
+                const char* isConst = dynType_getMetaInfo(entry->type, "const");
+                if (isConst != NULL && strncmp("true", isConst, 5) == 0) {
+                    dynType_free(argType, args->args[entry->index]);
+                } else {
+                    //char* -> callee is now owner, no free for char seq needed
+                    //will free the actual pointer
+                    free(args->args[entry->index]);
+                }
+            } else {
+                dynType_free(argType, args->args[entry->index]);
+            }
+        } else if (meta == DYN_FUNCTION_ARGUMENT_META__PRE_ALLOCATED_OUTPUT) {
+            const dyn_type* subType = dynType_typedPointer_getTypedType(argType);
+            dynType_free(subType, *(void**)(args->args[entry->index]));
+        } else if (meta == DYN_FUNCTION_ARGUMENT_META__OUTPUT) {
+            const dyn_type* typedType = dynType_typedPointer_getTypedType(argType);
+            if (celix_argType_isStringOrBuiltInObject(typedType)) {
+                dynType_cleanup(typedType, *(void**)(args->args[entry->index]));//args->args[entry->index] is void***, its value is &ptrToPtr(the local variable of the rpc call)
+            } else {
+                const dyn_type* typedTypedType = dynType_typedPointer_getTypedType(typedType);
+                dynType_free(typedTypedType, **(void***)args->args[entry->index]);
+            }
+        }
+    }
+    args->dynArgs = NULL;
+}
@@ -0,0 +1,66 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef _RPC_COMMON_H_
+#define _RPC_COMMON_H_
+
+#include "dyn_function.h"
+#include "dyn_type.h"
+#include "celix_cleanup.h"
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CELIX_RPC_MAX_ARGS     16
+
+typedef void (*gen_func_type)(void);
+
+/**
+ * The memory layout of a (dfi described) service: a handle followed by the method pointers.
+ */
+struct generic_service_layout {
+    void* handle;
+    gen_func_type methods[];
+};
+
+/**
+ * The arguments of a remote call on the service provider side, used by the json and binary rpc.
+ */
+typedef struct celix_rpc_args {
+    const struct dyn_function_arguments_head* dynArgs;
+    void* args[CELIX_RPC_MAX_ARGS];
+}celix_rpc_args_t;
+
+bool celix_argType_isStringOrBuiltInObject(const dyn_type* type);
+
+/**
+ * Releases the (deserialized) arguments and the results of a remote call.
+ */
+void celix_rpcArgs_cleanup(celix_rpc_args_t* args);
+
+CELIX_DEFINE_AUTO_CLEANUP_CLEAR_FUNC(celix_rpc_args_t, celix_rpcArgs_cleanup)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,350 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/**
+ * Generates C call and proxy stubs (see dyn_stubs.h) for an interface descriptor.
+ *
+ * Usage: celix_dfi_stub_generator <descriptor file> <output header> <output source>
+ *
+ * The generated source defines `const dyn_interface_stubs_t <name>_stubs`, where <name> is the interface name with
+ * all non alphanumeric characters replaced by '_'.
+ */
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "celix_err.h"
+#include "celix_stdio_cleanup.h"
+#include "celix_stdlib_cleanup.h"
+#include "celix_utils.h"
+#include "dyn_interface.h"
+#include "dyn_type.h"
+
+static int dfiStubGenerator_writeType(FILE* out, const dyn_type* type);
+
+static int dfiStubGenerator_writeSimpleType(FILE* out, char descriptor) {
+    const char* cType = NULL;
+    switch (descriptor) {
+        case 'B': cType = "int8_t"; break;
+        case 'D': cType = "double"; break;
+        case 'F': cType = "float"; break;
+        case 'I': cType = "int32_t"; break;
+        case 'J': cType = "int64_t"; break;
+        case 'S': cType = "int16_t"; break;
+        case 'V': cType = "void"; break;
+        case 'Z': cType = "bool"; break;
+        case 'b': cType = "uint8_t"; break;
+        case 'i': cType = "uint32_t"; break;
+        case 'j': cType = "uint64_t"; break;
+        case 's': cType = "uint16_t"; break;
+        case 'P': cType = "void*"; break;
+        case 'N': cType = "int"; break;
+        case 'E': cType = "int32_t"; break;
+        default:
+            fprintf(stderr, "Unsupported simple type '%c'\n", descriptor);
+            return 1;
+    }
+    fputs(cType, out);
+    return 0;
+}
+
+static int dfiStubGenerator_writeType(FILE* out, const dyn_type* type) {
+    type = dynType_realType(type);
+    switch (dynType_type(type)) {
+        case DYN_TYPE_SIMPLE:
+            return dfiStubGenerator_writeSimpleType(out, dynType_descriptorType(type));
+        case DYN_TYPE_TEXT:
+            fputs("char*", out);
+            return 0;
+        case DYN_TYPE_TYPED_POINTER:
+        case DYN_TYPE_BUILTIN_OBJECT:
+            fputs("void*", out);
+            return 0;
+        case DYN_TYPE_SEQUENCE:
+            fputs("struct { uint32_t cap; uint32_t len; void* buf; }", out);
+            return 0;
+        case DYN_TYPE_COMPLEX: {
+            fputs("struct { ", out);
+            const struct complex_type_entries_head* entries = dynType_complex_entries(type);
+            struct complex_type_entry* entry = NULL;
+            int index = 0;
+            TAILQ_FOREACH(entry, entries, entries) {
+                if (dfiStubGenerator_writeType(out, entry->type) != 0) {
+                    return 1;
+                }
+                fprintf(out, " m%d; ", index++);
+            }
+            fputs("}", out);
+            return 0;
+        }
+        default:
+            fprintf(stderr, "Unsupported type '%c'\n", dynType_descriptorType(type));
+            return 1;
+    }
+}
+
+static bool dfiStubGenerator_isAggregate(const dyn_type* type) {
+    int kind = dynType_type(dynType_realType(type));
+    return kind == DYN_TYPE_COMPLEX || kind == DYN_TYPE_SEQUENCE;
+}
+
+/**
+ * Writes the C type of an argument or return value. Aggregates passed by value get a typedef, because two anonymous
+ * struct types are never compatible in C.
+ */
+static void dfiStubGenerator_writeParamType(FILE* out, const char* prefix, int methodIndex, int argIndex,
+                                            const dyn_type* type) {
+    if (dfiStubGenerator_isAggregate(type)) {
+        fprintf(out, "%s_m%d_%s%d_t", prefix, methodIndex, argIndex < 0 ? "r" : "a", argIndex < 0 ? 0 : argIndex);
+    } else {
+        (void)dfiStubGenerator_writeType(out, type);
+    }
+}
+
+static int dfiStubGenerator_writeTypedef(FILE* out, const char* prefix, int methodIndex, const char* suffix,
+                                         const dyn_type* type) {
+    celix_autofree char* cType = NULL;
+    size_t size = 0;
+    celix_autoptr(FILE) stream = open_memstream(&cType, &size);
+    if (stream == NULL) {
+        fprintf(stderr, "Cannot create memory stream\n");
+        return 1;
+    }
+    int rc = dfiStubGenerator_writeType(stream, type);
+    fclose(celix_steal_ptr(stream));
+    if (rc == 0 && dfiStubGenerator_isAggregate(type)) {
+        fprintf(out, "typedef %s %s_m%d_%s_t;\n", cType, prefix, methodIndex, suffix);
+    }
+    return rc;
+}
+
+static int dfiStubGenerator_writeTypedefs(FILE* out, const char* prefix, const struct method_entry* method) {
+    const struct dyn_function_arguments_head* args = dynFunction_arguments(method->dynFunc);
+    dyn_function_argument_type* arg = NULL;
+    char suffix[32];
+    TAILQ_FOREACH(arg, args, entries) {
+        snprintf(suffix, sizeof(suffix), "a%d", arg->index);
+        if (dfiStubGenerator_writeTypedef(out, prefix, method->index, suffix, arg->type) != 0) {
+            return 1;
+        }
+    }
+    return dfiStubGenerator_writeTypedef(out, prefix, method->index, "r0", dynFunction_returnType(method->dynFunc));
+}
+
+static void dfiStubGenerator_writeFunctionPointerType(FILE* out, const char* prefix, const struct method_entry* method) {
+    const dyn_type* returnType = dynFunction_returnType(method->dynFunc);
+    fputs("(", out);
+    dfiStubGenerator_writeParamType(out, prefix, method->index, -1, returnType);
+    fputs(" (*)(", out);
+    const struct dyn_function_arguments_head* args = dynFunction_arguments(method->dynFunc);
+    dyn_function_argument_type* arg = NULL;
+    TAILQ_FOREACH(arg, args, entries) {
+        fputs(arg->index == 0 ? "" : ", ", out);
+        dfiStubGenerator_writeParamType(out, prefix, method->index, arg->index, arg->type);
+    }
+    fputs(TAILQ_EMPTY(args) ? "void))" : "))", out);
+}
+
+static void dfiStubGenerator_writeCallStub(FILE* out, const char* prefix, const struct method_entry* method) {
+    const dyn_type* returnType = dynFunction_returnType(method->dynFunc);
+    bool hasReturn = dynFunction_hasReturn(method->dynFunc);
+    const struct dyn_function_arguments_head* args = dynFunction_arguments(method->dynFunc);
+    fprintf(out, "static void %s_call%d(void (*fn)(void), void* args[], void* returnValue) {\n", prefix, method->index);
+    if (TAILQ_EMPTY(args)) {
+        fputs("    (void)args;\n", out);
+    }
+    if (!hasReturn) {
+        fputs("    (void)returnValue;\n    ", out);
+    } else {
+        fputs("    *(", out);
+        dfiStubGenerator_writeParamType(out, prefix, method->index, -1, returnType);
+        fputs("*)returnValue = ", out);
+    }
+    fputs("(", out);
+    dfiStubGenerator_writeFunctionPointerType(out, prefix, method);
+    fputs("fn)(", out);
+    dyn_function_argument_type* arg = NULL;
+    TAILQ_FOREACH(arg, args, entries) {
+        fputs(arg->index == 0 ? "*(" : ", *(", out);
+        dfiStubGenerator_writeParamType(out, prefix, method->index, arg->index, arg->type);
+        fprintf(out, "*)args[%d]", arg->index);
+    }
+    fputs(");\n}\n\n", out);
+}
+
+static bool dfiStubGenerator_hasHandle(const struct method_entry* method) {
+    const struct dyn_function_arguments_head* args = dynFunction_arguments(method->dynFunc);
+    const dyn_function_argument_type* first = TAILQ_FIRST(args);
+    return first != NULL && first->argumentMeta == DYN_FUNCTION_ARGUMENT_META__HANDLE;
+}
+
+static void dfiStubGenerator_writeProxyStub(FILE* out, const char* prefix, const struct method_entry* method) {
+    const dyn_type* returnType = dynFunction_returnType(method->dynFunc);
+    bool hasReturn = dynFunction_hasReturn(method->dynFunc);
+    bool isAggregateReturn = dfiStubGenerator_isAggregate(returnType);
+    fputs("static ", out);
+    dfiStubGenerator_writeParamType(out, prefix, method->index, -1, returnType);
+    fprintf(out, " %s_proxy%d(", prefix, method->index);
+    const struct dyn_function_arguments_head* args = dynFunction_arguments(method->dynFunc);
+    dyn_function_argument_type* arg = NULL;
+    TAILQ_FOREACH(arg, args, entries) {
+        fputs(arg->index == 0 ? "" : ", ", out);
+        dfiStubGenerator_writeParamType(out, prefix, method->index, arg->index, arg->type);
+        fprintf(out, " arg%d", arg->index);
+    }
+    fputs(") {\n    void* args[] = {", out);
+    TAILQ_FOREACH(arg, args, entries) {
+        fprintf(out, "%s&arg%d", arg->index == 0 ? "" : ", ", arg->index);
+    }
+    fputs("};\n", out);
+    const char* returnValue = "NULL";
+    if (hasReturn && isAggregateReturn) {
+        fputs("    ", out);
+        dfiStubGenerator_writeParamType(out, prefix, method->index, -1, returnType);
+        fputs(" returnValue = {0};\n", out);
+        returnValue = "&returnValue";
+    } else if (hasReturn) {
+        //a bind function may widen integral return values to the size of a register, as libffi does
+        fputs("    union { ", out);
+        dfiStubGenerator_writeParamType(out, prefix, method->index, -1, returnType);
+        fputs(" value; uint64_t widened; } returnValue = {0};\n", out);
+        returnValue = "&returnValue";
+    }
+    fputs("    dyn_stub_proxy_handle_t* handle = arg0;\n", out);
+    fprintf(out, "    handle->invoke(handle, %d, args, %s);\n", method->index, returnValue);
+    if (hasReturn) {
+        fprintf(out, "    return returnValue%s;\n", isAggregateReturn ? "" : ".value");
+    }
+    fputs("}\n\n", out);
+}
+
+static void dfiStubGenerator_writeString(FILE* out, const char* str) {
+    fputc('"', out);
+    for (const char* c = str; *c != '\0'; ++c) {
+        if (*c == '"' || *c == '\\') {
+            fputc('\\', out);
+        }
+        fputc(*c, out);
+    }
+    fputc('"', out);
+}
+
+static int dfiStubGenerator_writeSource(FILE* out, const char* header, const char* prefix, const dyn_interface_type* intf) {
+    const char* headerName = strrchr(header, '/');
+    headerName = headerName == NULL ? header : headerName + 1;
+    fputs("/* Generated by celix_dfi_stub_generator. Do not edit. */\n\n", out);
+    fprintf(out, "#include \"%s\"\n\n#include <stdbool.h>\n#include <stddef.h>\n#include <stdint.h>\n\n", headerName);
+
+    const struct methods_head* methods = dynInterface_methods(intf);
+    struct method_entry* method = NULL;
+    TAILQ_FOREACH(method, methods, entries) {
+        if (dfiStubGenerator_writeTypedefs(out, prefix, method) != 0) {
+            fprintf(stderr, "Cannot generate stubs for method %s\n", method->id);
+            return 1;
+        }
+    }
+    fputs("\n", out);
+    TAILQ_FOREACH(method, methods, entries) {
+        dfiStubGenerator_writeCallStub(out, prefix, method);
+        if (dfiStubGenerator_hasHandle(method)) {
+            dfiStubGenerator_writeProxyStub(out, prefix, method);
+        }
+    }
+
+    int nrOfMethods = dynInterface_nrOfMethods(intf);
+    if (nrOfMethods > 0) {
+        fprintf(out, "static const dyn_stub_method_t %s_methods[] = {\n", prefix);
+        for (int i = 0; i < nrOfMethods; ++i) {
+            method = (struct method_entry*)dynInterface_findMethodByIndex(intf, i);
+            fputs("    {", out);
+            dfiStubGenerator_writeString(out, method->id);
+            fprintf(out, ", %s_call%d, ", prefix, i);
+            if (dfiStubGenerator_hasHandle(method)) {
+                fprintf(out, "(void (*)(void))%s_proxy%d},\n", prefix, i);
+            } else {
+                fputs("NULL},\n", out);
+            }
+        }
+        fputs("};\n\n", out);
+    }
+    fprintf(out, "const dyn_interface_stubs_t %s_stubs = {\n    ", prefix);
+    dfiStubGenerator_writeString(out, dynInterface_getName(intf));
+    fputs(",\n    ", out);
+    dfiStubGenerator_writeString(out, dynInterface_getVersionString(intf));
+    fprintf(out, ",\n    %d,\n    ", nrOfMethods);
+    if (nrOfMethods > 0) {
+        fprintf(out, "%s_methods\n};\n", prefix);
+    } else {
+        fputs("NULL\n};\n", out);
+    }
+    return 0;
+}
+
+static void dfiStubGenerator_writeHeader(FILE* out, const char* prefix) {
+    celix_autofree char* guard = celix_utils_strdup(prefix);
+    for (char* c = guard; *c != '\0'; ++c) {
+        *c = (char)toupper((unsigned char)*c);
+    }
+    fputs("/* Generated by celix_dfi_stub_generator. Do not edit. */\n\n", out);
+    fprintf(out, "#ifndef %s_STUBS_H\n#define %s_STUBS_H\n\n", guard, guard);
+    fputs("#include \"dyn_stubs.h\"\n\n#ifdef __cplusplus\nextern \"C\" {\n#endif\n\n", out);
+    fprintf(out, "extern const dyn_interface_stubs_t %s_stubs;\n\n", prefix);
+    fputs("#ifdef __cplusplus\n}\n#endif\n\n#endif\n", out);
+}
+
+int main(int argc, char** argv) {
+    if (argc != 4) {
+        fprintf(stderr, "Usage: %s <descriptor file> <output header> <output source>\n", argv[0]);
+        return 1;
+    }
+
+    celix_autoptr(FILE) descriptor = fopen(argv[1], "r");
+    if (descriptor == NULL) {
+        fprintf(stderr, "Cannot open descriptor %s\n", argv[1]);
+        return 1;
+    }
+    celix_autoptr(dyn_interface_type) intf = NULL;
+    if (dynInterface_parse(descriptor, &intf) != 0) {
+        celix_err_printErrors(stderr, "Error: ", "\n");
+        fprintf(stderr, "Cannot parse descriptor %s\n", argv[1]);
+        return 1;
+    }
+
+    celix_autofree char* prefix = celix_utils_strdup(dynInterface_getName(intf));
+    for (char* c = prefix; *c != '\0'; ++c) {
+        if (!isalnum((unsigned char)*c)) {
+            *c = '_';
+        }
+    }
+
+    celix_autoptr(FILE) header = fopen(argv[2], "w");
+    celix_autoptr(FILE) source = fopen(argv[3], "w");
+    if (header == NULL || source == NULL) {
+        fprintf(stderr, "Cannot open output files %s and %s\n", argv[2], argv[3]);
+        return 1;
+    }
+    dfiStubGenerator_writeHeader(header, prefix);
+    if (dfiStubGenerator_writeSource(source, argv[2], prefix, intf) != 0) {
+        fprintf(stderr, "Cannot generate stubs for %s\n", argv[1]);
+        return 1;
+    }
+    return 0;
+}
@@ -18,20 +18,25 @@
  */
 #include "sys_shm_ei.h"
 #include "celix_error_injector.h"
+#include <errno.h>
 #include <sys/shm.h>
 
 extern "C" {
 int __real_shmget(key_t __key, size_t __size, int __shmflg);
 CELIX_EI_DEFINE(shmget, int)
 int __wrap_shmget(key_t __key, size_t __size, int __shmflg) {
+    errno = EACCES;
     CELIX_EI_IMPL(shmget);
+    errno = 0;
     return __real_shmget(__key, __size, __shmflg);
 }
 
 void *__real_shmat(int __shmid, const void *__shmaddr, int __shmflg);
 CELIX_EI_DEFINE(shmat, void *)
 void *__wrap_shmat(int __shmid, const void *__shmaddr, int __shmflg) {
+    errno = ENOMEM;
     CELIX_EI_IMPL(shmat);
+    errno = 0;
     return __real_shmat(__shmid, __shmaddr, __shmflg);
 }
 
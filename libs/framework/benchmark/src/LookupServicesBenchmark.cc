@@ -43,6 +43,7 @@ public:
         for (int i = 0; i < nrOfServiceRegistrations; ++i) {
             auto reg = ctx->registerService<IService>(std::make_shared<ServiceImpl>(), IService::NAME)
                     .addProperty("key", std::string{"value"} + std::to_string(i))
+                    .addProperty(celix::SERVICE_RANKING, static_cast<long>(i % 10))
                     .build();
             registrations.emplace_back(std::move(reg));
         }
@@ -114,6 +115,32 @@ static void findSingleService(benchmark::State& state, bool cTest, bool useFilte
     state.SetItemsProcessed(state.iterations());
 }
 
+static void findAllServices(benchmark::State& state, bool cTest) {
+    LookupServicesBenchmark benchmark{state.range(0)};
+    auto ctx = benchmark.fw->getFrameworkBundleContext();
+    auto* cCtx = ctx->getCBundleContext();
+
+    if (cTest) {
+        for (auto _ : state) {
+            // This code gets timed
+            celix_array_list_t* svcIds = celix_bundleContext_findServices(cCtx, IService::NAME);
+            if (celix_arrayList_size(svcIds) != benchmark.nrOfServiceRegistrations) {
+                state.SkipWithError("invalid nr of svc ids");
+            }
+            celix_arrayList_destroy(svcIds);
+        }
+    } else {
+        for (auto _ : state) {
+            // This code gets timed
+            auto svcIds = ctx->findServicesWithName(IService::NAME);
+            if (static_cast<int64_t>(svcIds.size()) != benchmark.nrOfServiceRegistrations) {
+                state.SkipWithError("invalid nr of svc ids");
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * benchmark.nrOfServiceRegistrations);
+}
+
 static void createDestroyServiceTracker(benchmark::State& state, bool cTest) {
     LookupServicesBenchmark benchmark{state.range(0)};
     auto ctx = benchmark.fw->getFrameworkBundleContext();
@@ -155,6 +182,14 @@ static void LookupServicesBenchmark_cxxFindServiceWithFilter(benchmark::State& s
     findSingleService(state, false, true);
 }
 
+static void LookupServicesBenchmark_cFindAllServices(benchmark::State& state) {
+    findAllServices(state, true);
+}
+
+static void LookupServicesBenchmark_cxxFindAllServices(benchmark::State& state) {
+    findAllServices(state, false);
+}
+
 static void LookupServicesBenchmark_cCreateDestroyTracker(benchmark::State& state) {
     createDestroyServiceTracker(state, true);
 }
@@ -172,5 +207,8 @@ CELIX_BENCHMARK(LookupServicesBenchmark_cxxFindSingleService)->RangeMultiplier(1
 CELIX_BENCHMARK(LookupServicesBenchmark_cFindServiceWithFilter)->RangeMultiplier(10)->Range(1, 10000);
 CELIX_BENCHMARK(LookupServicesBenchmark_cxxFindServiceWithFilter)->RangeMultiplier(10)->Range(1, 10000);
 
+CELIX_BENCHMARK(LookupServicesBenchmark_cFindAllServices)->RangeMultiplier(10)->Range(1, 10000);
+CELIX_BENCHMARK(LookupServicesBenchmark_cxxFindAllServices)->RangeMultiplier(10)->Range(1, 10000);
+
 CELIX_BENCHMARK(LookupServicesBenchmark_cCreateDestroyTracker)->RangeMultiplier(10)->Range(1, 1000);
 CELIX_BENCHMARK(LookupServicesBenchmark_cxxCreateDestroyTracker)->RangeMultiplier(10)->Range(1, 1000);
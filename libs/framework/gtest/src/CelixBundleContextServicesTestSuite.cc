@@ -1279,6 +1279,36 @@ TEST_F(CelixBundleContextServicesTestSuite, FindServicesTest) {
     celix_bundleContext_unregisterService(ctx, svcId2);
 }
 
+TEST_F(CelixBundleContextServicesTestSuite, FindServicesSortedOnRankingTest) {
+    //Given services registered with a long ranking, a string ranking and no ranking
+    celix_properties_t* props1 = celix_properties_create();
+    celix_properties_setLong(props1, CELIX_FRAMEWORK_SERVICE_RANKING, 5);
+    long svcId1 = celix_bundleContext_registerService(ctx, (void*)0x100, "example", props1);
+    long svcId2 = celix_bundleContext_registerService(ctx, (void*)0x100, "example", nullptr);
+    celix_properties_t* props3 = celix_properties_create();
+    celix_properties_set(props3, CELIX_FRAMEWORK_SERVICE_RANKING, "10");
+    long svcId3 = celix_bundleContext_registerService(ctx, (void*)0x100, "example", props3);
+    celix_properties_t* props4 = celix_properties_create();
+    celix_properties_setLong(props4, CELIX_FRAMEWORK_SERVICE_RANKING, 5);
+    long svcId4 = celix_bundleContext_registerService(ctx, (void*)0x100, "example", props4);
+
+    //When finding the services
+    celix_array_list_t* list = celix_bundleContext_findServices(ctx, "example");
+
+    //Then the services are sorted on highest ranking and, for equal ranking, on lowest service id
+    ASSERT_EQ(4, celix_arrayList_size(list));
+    EXPECT_EQ(svcId3, celix_arrayList_getLong(list, 0));
+    EXPECT_EQ(svcId1, celix_arrayList_getLong(list, 1));
+    EXPECT_EQ(svcId4, celix_arrayList_getLong(list, 2));
+    EXPECT_EQ(svcId2, celix_arrayList_getLong(list, 3));
+    celix_arrayList_destroy(list);
+
+    celix_bundleContext_unregisterService(ctx, svcId1);
+    celix_bundleContext_unregisterService(ctx, svcId2);
+    celix_bundleContext_unregisterService(ctx, svcId3);
+    celix_bundleContext_unregisterService(ctx, svcId4);
+}
+
 TEST_F(CelixBundleContextServicesTestSuite, TrackServiceTrackerTest) {
 
     int count = 0;
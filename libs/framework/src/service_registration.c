@@ -120,6 +120,7 @@ static celix_status_t serviceRegistration_initializeProperties(service_registrat
 
     if (status == CELIX_SUCCESS) {
         registration->properties = props;
+        registration->serviceRanking = celix_properties_getAsLong(props, CELIX_FRAMEWORK_SERVICE_RANKING, 0);
     } else {
         celix_err_push("Cannot initialize service registration properties");
         celix_properties_destroy(props);
@@ -261,6 +262,9 @@ long serviceRegistration_getServiceId(service_registration_t *registration) {
     return svcId;
 }
 
+long serviceRegistration_getServiceRanking(service_registration_t* registration) {
+    return registration->serviceRanking;
+}
 
 service_registration_t* celix_serviceRegistration_createServiceFactory(
         registry_callback_t callback,
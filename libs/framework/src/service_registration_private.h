@@ -41,6 +41,7 @@ struct serviceRegistration {
     bundle_pt bundle;         // read-only
      celix_properties_t* properties; // read-only
     long serviceId;           // read-only
+    long serviceRanking;      // read-only, cached from the service.ranking property
 
     bool isUnregistering;
 
@@ -67,6 +68,7 @@ celix_status_t serviceRegistration_getService(service_registration_pt registrati
 celix_status_t serviceRegistration_ungetService(service_registration_pt registration, bundle_pt bundle, const void **service);
 
 celix_status_t serviceRegistration_getBundle(service_registration_pt registration, bundle_pt *bundle);
+long serviceRegistration_getServiceRanking(service_registration_t* registration);
 celix_status_t serviceRegistration_getServiceName(service_registration_pt registration, const char **serviceName);
 
 
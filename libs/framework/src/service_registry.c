@@ -844,19 +844,15 @@ char* celix_serviceRegistry_createFilterFor(celix_service_registry_t* registry,
 }
 
 static int celix_serviceRegistry_compareRegistrations(celix_array_list_entry_t a, celix_array_list_entry_t b) {
-    const service_registration_t* regA = a.voidPtrVal;
-    const service_registration_t* regB = b.voidPtrVal;
+    service_registration_t* regA = a.voidPtrVal;
+    service_registration_t* regB = b.voidPtrVal;
 
-    celix_properties_t* propsA = NULL;
-    celix_properties_t* propsB = NULL;
-    serviceRegistration_getProperties((service_registration_t*)regA, &propsA);
-    serviceRegistration_getProperties((service_registration_t*)regB, &propsB);
+    // note: service id and ranking are cached on the registration, so no property lookups are needed while sorting
+    long servIdA = serviceRegistration_getServiceId(regA);
+    long servIdB = serviceRegistration_getServiceId(regB);
 
-    long servIdA = celix_properties_getAsLong(propsA, CELIX_FRAMEWORK_SERVICE_ID, 0);
-    long servIdB = celix_properties_getAsLong(propsB, CELIX_FRAMEWORK_SERVICE_ID, 0);
-
-    long servRankingA = celix_properties_getAsLong(propsA, CELIX_FRAMEWORK_SERVICE_RANKING, 0);
-    long servRankingB = celix_properties_getAsLong(propsB, CELIX_FRAMEWORK_SERVICE_RANKING, 0);
+    long servRankingA = serviceRegistration_getServiceRanking(regA);
+    long servRankingB = serviceRegistration_getServiceRanking(regB);
 
     return celix_utils_compareServiceIdsAndRanking(servIdA, servRankingA, servIdB, servRankingB);
 }
@@ -0,0 +1,194 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "celix_array_list.h"
+#include "celix_filter.h"
+#include "celix_properties.h"
+
+/**
+ * Benchmarks the typed array list operations. The "Callback" variants use an array list with custom (but equivalent)
+ * equals and compare callbacks, which forces the generic callback based implementation and serves as reference.
+ */
+class ArrayListBenchmark {
+public:
+    explicit ArrayListBenchmark(int64_t nrOfEntries) {
+        std::uniform_int_distribution<long> distribution{0, nrOfEntries * 10};
+        for (int64_t i = 0; i < nrOfEntries; ++i) {
+            values.push_back(distribution(generator));
+        }
+    }
+
+    celix_array_list_t* createLongList(bool useCallbacks) const {
+        celix_array_list_create_options_t opts{};
+        opts.elementType = CELIX_ARRAY_LIST_ELEMENT_TYPE_LONG;
+        if (useCallbacks) {
+            opts.equalsCallback = [](celix_array_list_entry_t a, celix_array_list_entry_t b) {
+                return a.longVal == b.longVal;
+            };
+            opts.compareCallback = [](celix_array_list_entry_t a, celix_array_list_entry_t b) {
+                return a.longVal < b.longVal ? -1 : (a.longVal > b.longVal ? 1 : 0);
+            };
+        }
+        auto* list = celix_arrayList_createWithOptions(&opts);
+        for (auto val : values) {
+            celix_arrayList_addLong(list, val);
+        }
+        return list;
+    }
+
+    celix_array_list_t* createDoubleList(bool useCallbacks) const {
+        celix_array_list_create_options_t opts{};
+        opts.elementType = CELIX_ARRAY_LIST_ELEMENT_TYPE_DOUBLE;
+        if (useCallbacks) {
+            opts.equalsCallback = [](celix_array_list_entry_t a, celix_array_list_entry_t b) {
+                return a.doubleVal == b.doubleVal;
+            };
+            opts.compareCallback = [](celix_array_list_entry_t a, celix_array_list_entry_t b) {
+                return a.doubleVal < b.doubleVal ? -1 : (a.doubleVal > b.doubleVal ? 1 : 0);
+            };
+        }
+        auto* list = celix_arrayList_createWithOptions(&opts);
+        for (auto val : values) {
+            celix_arrayList_addDouble(list, (double)val);
+        }
+        return list;
+    }
+
+    celix_array_list_t* createStringList(bool useCallbacks) const {
+        celix_array_list_create_options_t opts{};
+        opts.elementType = CELIX_ARRAY_LIST_ELEMENT_TYPE_STRING;
+        if (useCallbacks) {
+            opts.compareCallback = [](celix_array_list_entry_t a, celix_array_list_entry_t b) {
+                return strcmp(a.stringVal, b.stringVal);
+            };
+        }
+        auto* list = celix_arrayList_createWithOptions(&opts);
+        for (auto val : values) {
+            celix_arrayList_addString(list, std::to_string(val).c_str());
+        }
+        return list;
+    }
+
+    std::vector<long> values{};
+    std::default_random_engine generator{};
+};
+
+static void ArrayListBenchmark_indexOf(benchmark::State& state, bool isDouble, bool useCallbacks) {
+    ArrayListBenchmark benchmark{state.range(0)};
+    celix_array_list_t* list =
+        isDouble ? benchmark.createDoubleList(useCallbacks) : benchmark.createLongList(useCallbacks);
+    celix_array_list_entry_t notFound{};
+    if (isDouble) {
+        notFound.doubleVal = -1.0;
+    } else {
+        notFound.longVal = -1L;
+    }
+    for (auto _ : state) {
+        // This code gets timed
+        int index = celix_arrayList_indexOf(list, notFound);
+        if (index != -1) {
+            std::cerr << "ERROR: unexpected index" << std::endl;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    celix_arrayList_destroy(list);
+}
+
+static void ArrayListBenchmark_equals(benchmark::State& state, bool isDouble, bool useCallbacks) {
+    ArrayListBenchmark benchmark{state.range(0)};
+    celix_array_list_t* list1 =
+        isDouble ? benchmark.createDoubleList(useCallbacks) : benchmark.createLongList(useCallbacks);
+    celix_array_list_t* list2 = celix_arrayList_copy(list1);
+    for (auto _ : state) {
+        // This code gets timed
+        if (!celix_arrayList_equals(list1, list2)) {
+            std::cerr << "ERROR: unexpected equals result" << std::endl;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    celix_arrayList_destroy(list1);
+    celix_arrayList_destroy(list2);
+}
+
+static void ArrayListBenchmark_sort(benchmark::State& state,
+                                    celix_array_list_t* (ArrayListBenchmark::*createList)(bool) const,
+                                    bool useCallbacks) {
+    ArrayListBenchmark benchmark{state.range(0)};
+    celix_array_list_t* unsortedList = (benchmark.*createList)(useCallbacks);
+    for (auto _ : state) {
+        state.PauseTiming();
+        celix_array_list_t* list = celix_arrayList_copy(unsortedList);
+        state.ResumeTiming();
+        // This code gets timed
+        celix_arrayList_sort(list);
+        state.PauseTiming();
+        celix_arrayList_destroy(list);
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    celix_arrayList_destroy(unsortedList);
+}
+
+static void ArrayListBenchmark_filterMatch(benchmark::State& state, bool isDouble) {
+    ArrayListBenchmark benchmark{state.range(0)};
+    celix_properties_t* props = celix_properties_create();
+    celix_properties_assignArrayList(props, "values", isDouble ? benchmark.createDoubleList(false)
+                                                               : benchmark.createLongList(false));
+    celix_filter_t* filter = celix_filter_create("(values<0)");
+    for (auto _ : state) {
+        // This code gets timed
+        if (celix_filter_match(filter, props)) {
+            std::cerr << "ERROR: unexpected match result" << std::endl;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    celix_filter_destroy(filter);
+    celix_properties_destroy(props);
+}
+
+#define CELIX_BENCHMARK_CAPTURE(func, name, ...) \
+    BENCHMARK_CAPTURE(func, name, __VA_ARGS__)->MeasureProcessCPUTime()->UseRealTime() \
+        ->Unit(benchmark::kNanosecond)->RangeMultiplier(10)->Range(10, 100000)
+
+CELIX_BENCHMARK_CAPTURE(ArrayListBenchmark_indexOf, Long, false, false);
+CELIX_BENCHMARK_CAPTURE(ArrayListBenchmark_indexOf, LongCallback, false, true); //reference
+CELIX_BENCHMARK_CAPTURE(ArrayListBenchmark_indexOf, Double, true, false);
+CELIX_BENCHMARK_CAPTURE(ArrayListBenchmark_indexOf, DoubleCallback, true, true); //reference
+
+CELIX_BENCHMARK_CAPTURE(ArrayListBenchmark_equals, Long, false, false);
+CELIX_BENCHMARK_CAPTURE(ArrayListBenchmark_equals, LongCallback, false, true); //reference
+CELIX_BENCHMARK_CAPTURE(ArrayListBenchmark_equals, Double, true, false);
+CELIX_BENCHMARK_CAPTURE(ArrayListBenchmark_equals, DoubleCallback, true, true); //reference
+
+CELIX_BENCHMARK_CAPTURE(ArrayListBenchmark_sort, Long, &ArrayListBenchmark::createLongList, false);
+CELIX_BENCHMARK_CAPTURE(ArrayListBenchmark_sort, LongCallback, &ArrayListBenchmark::createLongList, true); //reference
+CELIX_BENCHMARK_CAPTURE(ArrayListBenchmark_sort, Double, &ArrayListBenchmark::createDoubleList, false);
+CELIX_BENCHMARK_CAPTURE(ArrayListBenchmark_sort, DoubleCallback, &ArrayListBenchmark::createDoubleList, true); //reference
+CELIX_BENCHMARK_CAPTURE(ArrayListBenchmark_sort, String, &ArrayListBenchmark::createStringList, false);
+CELIX_BENCHMARK_CAPTURE(ArrayListBenchmark_sort, StringCallback, &ArrayListBenchmark::createStringList, true); //reference
+
+CELIX_BENCHMARK_CAPTURE(ArrayListBenchmark_filterMatch, Long, false);
+CELIX_BENCHMARK_CAPTURE(ArrayListBenchmark_filterMatch, Double, true);
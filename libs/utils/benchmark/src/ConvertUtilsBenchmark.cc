@@ -0,0 +1,113 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <iostream>
+
+#include "celix_convert_utils.h"
+#include "celix_version.h"
+
+/**
+ * Typical property values, e.g. service ids, service rankings, timeouts, ratios and versions.
+ */
+static const char* const LONG_VALUES[] = {"0", "42", "-1", "1000", "2147483647", " 12 "};
+static const char* const DOUBLE_VALUES[] = {"0.5", "3.14", "-1.25", "100", "1e-3", "2.718281828459045"};
+static const char* const VERSION_VALUES[] = {"1.0.0", "1.2.3", "2.0", "10.20.30.qualifier"};
+
+#define NR_OF(values) (sizeof(values) / sizeof(values[0]))
+
+static void ConvertUtilsBenchmark_convertStringToLong(benchmark::State& state) {
+    size_t i = 0;
+    for (auto _ : state) {
+        // This code gets timed
+        bool converted;
+        long value = celix_utils_convertStringToLong(LONG_VALUES[i++ % NR_OF(LONG_VALUES)], 0, &converted);
+        benchmark::DoNotOptimize(value);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void ConvertUtilsBenchmark_strtol(benchmark::State& state) {
+    size_t i = 0;
+    for (auto _ : state) {
+        // This code gets timed
+        char* endptr;
+        long value = strtol(LONG_VALUES[i++ % NR_OF(LONG_VALUES)], &endptr, 10);
+        benchmark::DoNotOptimize(value);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void ConvertUtilsBenchmark_convertStringToDouble(benchmark::State& state) {
+    size_t i = 0;
+    for (auto _ : state) {
+        // This code gets timed
+        bool converted;
+        double value = celix_utils_convertStringToDouble(DOUBLE_VALUES[i++ % NR_OF(DOUBLE_VALUES)], 0.0, &converted);
+        benchmark::DoNotOptimize(value);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void ConvertUtilsBenchmark_strtod(benchmark::State& state) {
+    size_t i = 0;
+    for (auto _ : state) {
+        // This code gets timed
+        char* endptr;
+        double value = strtod(DOUBLE_VALUES[i++ % NR_OF(DOUBLE_VALUES)], &endptr);
+        benchmark::DoNotOptimize(value);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void ConvertUtilsBenchmark_convertStringToVersion(benchmark::State& state) {
+    size_t i = 0;
+    for (auto _ : state) {
+        // This code gets timed
+        celix_version_t* version;
+        celix_status_t status =
+            celix_utils_convertStringToVersion(VERSION_VALUES[i++ % NR_OF(VERSION_VALUES)], nullptr, &version);
+        if (status != CELIX_SUCCESS) {
+            std::cerr << "ERROR: unexpected convert status" << std::endl;
+        }
+        celix_version_destroy(version);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void ConvertUtilsBenchmark_convertInvalidStringToVersion(benchmark::State& state) {
+    for (auto _ : state) {
+        // This code gets timed, e.g. a filter attribute value which is not a version
+        celix_version_t* version;
+        celix_status_t status = celix_utils_convertStringToVersion("org.apache.celix.Service", nullptr, &version);
+        benchmark::DoNotOptimize(status);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+#define CELIX_BENCHMARK(name) \
+    BENCHMARK(name)->MeasureProcessCPUTime()->UseRealTime()->Unit(benchmark::kNanosecond)
+
+CELIX_BENCHMARK(ConvertUtilsBenchmark_convertStringToLong);
+CELIX_BENCHMARK(ConvertUtilsBenchmark_strtol); //reference
+CELIX_BENCHMARK(ConvertUtilsBenchmark_convertStringToDouble);
+CELIX_BENCHMARK(ConvertUtilsBenchmark_strtod); //reference
+CELIX_BENCHMARK(ConvertUtilsBenchmark_convertStringToVersion);
+CELIX_BENCHMARK(ConvertUtilsBenchmark_convertInvalidStringToVersion);
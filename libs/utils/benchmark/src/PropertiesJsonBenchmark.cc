@@ -0,0 +1,177 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include <jansson.h>
+
+#include "celix_properties.h"
+#include "celix_stdlib_cleanup.h"
+
+/**
+ * Benchmarks the properties JSON encoding and decoding against a jansson DOM based baseline, which builds (or
+ * iterates) a complete json_t tree for every encode (decode) call.
+ */
+class PropertiesJsonBenchmark {
+public:
+    explicit PropertiesJsonBenchmark(benchmark::State& state) : props{celix_properties_create()} {
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            std::string key = "key" + std::to_string(i);
+            switch (i % 4) {
+            case 0:
+                celix_properties_set(props, key.c_str(), "a string value");
+                break;
+            case 1:
+                celix_properties_setLong(props, key.c_str(), i);
+                break;
+            case 2:
+                celix_properties_setDouble(props, key.c_str(), (double)i + 0.5);
+                break;
+            default:
+                celix_properties_setBool(props, key.c_str(), i % 2 == 0);
+                break;
+            }
+        }
+        celix_status_t status = celix_properties_saveToString(props, 0, &json);
+        if (status != CELIX_SUCCESS) {
+            std::cerr << "ERROR: cannot encode properties" << std::endl;
+        }
+    }
+
+    ~PropertiesJsonBenchmark() {
+        free(json);
+        celix_properties_destroy(props);
+    }
+
+    static json_t* toJanssonObject(const celix_properties_t* props) {
+        json_t* root = json_object();
+        CELIX_PROPERTIES_ITERATE(props, iter) {
+            json_t* value;
+            switch (iter.entry.valueType) {
+            case CELIX_PROPERTIES_VALUE_TYPE_LONG:
+                value = json_integer(iter.entry.typed.longValue);
+                break;
+            case CELIX_PROPERTIES_VALUE_TYPE_DOUBLE:
+                value = json_real(iter.entry.typed.doubleValue);
+                break;
+            case CELIX_PROPERTIES_VALUE_TYPE_BOOL:
+                value = json_boolean(iter.entry.typed.boolValue);
+                break;
+            default:
+                value = json_string(iter.entry.value);
+                break;
+            }
+            json_object_set_new(root, iter.key, value);
+        }
+        return root;
+    }
+
+    static celix_properties_t* fromJanssonObject(const json_t* root) {
+        celix_properties_t* props = celix_properties_create();
+        const char* key;
+        json_t* value;
+        json_object_foreach((json_t*)root, key, value) {
+            switch (json_typeof(value)) {
+            case JSON_INTEGER:
+                celix_properties_setLong(props, key, (long)json_integer_value(value));
+                break;
+            case JSON_REAL:
+                celix_properties_setDouble(props, key, json_real_value(value));
+                break;
+            case JSON_TRUE:
+            case JSON_FALSE:
+                celix_properties_setBool(props, key, json_boolean_value(value));
+                break;
+            default:
+                celix_properties_set(props, key, json_string_value(value));
+                break;
+            }
+        }
+        return props;
+    }
+
+    celix_properties_t* props;
+    char* json{nullptr};
+};
+
+static void PropertiesJsonBenchmark_encode(benchmark::State& state) {
+    PropertiesJsonBenchmark benchmark{state};
+    for (auto _ : state) {
+        // This code gets timed
+        char* out;
+        celix_properties_saveToString(benchmark.props, 0, &out);
+        benchmark::DoNotOptimize(out);
+        free(out);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * (int64_t)strlen(benchmark.json));
+}
+
+static void PropertiesJsonBenchmark_encodeUsingJanssonDom(benchmark::State& state) {
+    PropertiesJsonBenchmark benchmark{state};
+    for (auto _ : state) {
+        // This code gets timed
+        json_t* root = PropertiesJsonBenchmark::toJanssonObject(benchmark.props);
+        char* out = json_dumps(root, JSON_COMPACT);
+        benchmark::DoNotOptimize(out);
+        free(out);
+        json_decref(root);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * (int64_t)strlen(benchmark.json));
+}
+
+static void PropertiesJsonBenchmark_decode(benchmark::State& state) {
+    PropertiesJsonBenchmark benchmark{state};
+    for (auto _ : state) {
+        // This code gets timed
+        celix_properties_t* props;
+        celix_properties_loadFromString(benchmark.json, 0, &props);
+        benchmark::DoNotOptimize(props);
+        celix_properties_destroy(props);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * (int64_t)strlen(benchmark.json));
+}
+
+static void PropertiesJsonBenchmark_decodeUsingJanssonDom(benchmark::State& state) {
+    PropertiesJsonBenchmark benchmark{state};
+    for (auto _ : state) {
+        // This code gets timed
+        json_t* root = json_loads(benchmark.json, 0, nullptr);
+        celix_properties_t* props = PropertiesJsonBenchmark::fromJanssonObject(root);
+        benchmark::DoNotOptimize(props);
+        celix_properties_destroy(props);
+        json_decref(root);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * (int64_t)strlen(benchmark.json));
+}
+
+#define CELIX_BENCHMARK(name) \
+    BENCHMARK(name)->MeasureProcessCPUTime()->UseRealTime()->Unit(benchmark::kNanosecond) \
+        ->RangeMultiplier(10)->Range(10, 1000)
+
+CELIX_BENCHMARK(PropertiesJsonBenchmark_encode);
+CELIX_BENCHMARK(PropertiesJsonBenchmark_encodeUsingJanssonDom);
+CELIX_BENCHMARK(PropertiesJsonBenchmark_decode);
+CELIX_BENCHMARK(PropertiesJsonBenchmark_decodeUsingJanssonDom);
@@ -0,0 +1,50 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "celix_json_stream_ei.h"
+
+extern "C" {
+char* __real_celix_jsonWriter_steal(celix_json_writer_t* writer, size_t* size);
+CELIX_EI_DEFINE(celix_jsonWriter_steal, char*)
+char* __wrap_celix_jsonWriter_steal(celix_json_writer_t* writer, size_t* size) {
+    CELIX_EI_IMPL(celix_jsonWriter_steal);
+    return __real_celix_jsonWriter_steal(writer, size);
+}
+
+celix_status_t __real_celix_jsonWriter_writeRaw(celix_json_writer_t* writer, const char* data, size_t len);
+CELIX_EI_DEFINE(celix_jsonWriter_writeRaw, celix_status_t)
+celix_status_t __wrap_celix_jsonWriter_writeRaw(celix_json_writer_t* writer, const char* data, size_t len) {
+    CELIX_EI_IMPL(celix_jsonWriter_writeRaw);
+    return __real_celix_jsonWriter_writeRaw(writer, data, len);
+}
+
+celix_status_t __real_celix_jsonWriter_writeChar(celix_json_writer_t* writer, char c);
+CELIX_EI_DEFINE(celix_jsonWriter_writeChar, celix_status_t)
+celix_status_t __wrap_celix_jsonWriter_writeChar(celix_json_writer_t* writer, char c) {
+    CELIX_EI_IMPL(celix_jsonWriter_writeChar);
+    return __real_celix_jsonWriter_writeChar(writer, c);
+}
+
+celix_status_t __real_celix_jsonWriter_writeInteger(celix_json_writer_t* writer, long long value);
+CELIX_EI_DEFINE(celix_jsonWriter_writeInteger, celix_status_t)
+celix_status_t __wrap_celix_jsonWriter_writeInteger(celix_json_writer_t* writer, long long value) {
+    CELIX_EI_IMPL(celix_jsonWriter_writeInteger);
+    return __real_celix_jsonWriter_writeInteger(writer, value);
+}
+}
@@ -19,6 +19,11 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
 #include "celix_array_list.h"
 #include "celix_version.h"
 #include "celix_stdlib_cleanup.h"
@@ -519,3 +524,100 @@ TEST_F(ArrayListTestSuite, InitialCapacityOptionTest) {
     // Second add requires realloc
     EXPECT_EQ(CELIX_SUCCESS, celix_arrayList_addString(list, "v2"));
 }
+
+TEST_F(ArrayListTestSuite, SortLargeTypedArrayListsTest) {
+    // Given a long, double, string and bool list with more entries than the insertion sort threshold
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<long> distribution{-100, 100};
+    std::vector<long> longs{};
+    std::vector<std::string> strings{};
+    celix_autoptr(celix_array_list_t) longList = celix_arrayList_createLongArray();
+    celix_autoptr(celix_array_list_t) doubleList = celix_arrayList_createDoubleArray();
+    celix_autoptr(celix_array_list_t) stringList = celix_arrayList_createStringArray();
+    celix_autoptr(celix_array_list_t) boolList = celix_arrayList_createBoolArray();
+    for (int i = 0; i < 1000; ++i) {
+        long val = distribution(generator);
+        longs.push_back(val);
+        strings.push_back(std::to_string(val));
+        celix_arrayList_addLong(longList, val);
+        celix_arrayList_addDouble(doubleList, (double)val / 2.0);
+        celix_arrayList_addString(stringList, strings.back().c_str());
+        celix_arrayList_addBool(boolList, val % 2 == 0);
+    }
+
+    // And a long list with many equal entries and an already sorted long list
+    celix_autoptr(celix_array_list_t) equalList = celix_arrayList_createLongArray();
+    celix_autoptr(celix_array_list_t) sortedList = celix_arrayList_createLongArray();
+    for (int i = 0; i < 1000; ++i) {
+        celix_arrayList_addLong(equalList, i % 3 == 0 ? 1L : 2L);
+        celix_arrayList_addLong(sortedList, i);
+    }
+
+    // When sorting the lists
+    celix_arrayList_sort(longList);
+    celix_arrayList_sort(doubleList);
+    celix_arrayList_sort(stringList);
+    celix_arrayList_sort(boolList);
+    celix_arrayList_sort(equalList);
+    celix_arrayList_sort(sortedList);
+
+    // Then the lists are sorted
+    std::sort(longs.begin(), longs.end());
+    std::sort(strings.begin(), strings.end());
+    auto nrOfFalse = std::count_if(longs.begin(), longs.end(), [](long v) { return v % 2 != 0; });
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(longs[i], celix_arrayList_getLong(longList, i));
+        EXPECT_DOUBLE_EQ((double)longs[i] / 2.0, celix_arrayList_getDouble(doubleList, i));
+        EXPECT_STREQ(strings[i].c_str(), celix_arrayList_getString(stringList, i));
+        EXPECT_EQ(i >= nrOfFalse, celix_arrayList_getBool(boolList, i));
+        EXPECT_EQ(i < 334 ? 1L : 2L, celix_arrayList_getLong(equalList, i));
+        EXPECT_EQ(i, celix_arrayList_getLong(sortedList, i));
+    }
+}
+
+TEST_F(ArrayListTestSuite, IndexOfAndEqualsForLargeTypedArrayListsTest) {
+    // Given a long and double list with more entries than a kernel block
+    celix_autoptr(celix_array_list_t) longList = celix_arrayList_createLongArray();
+    celix_autoptr(celix_array_list_t) doubleList = celix_arrayList_createDoubleArray();
+    for (int i = 0; i < 21; ++i) {
+        celix_arrayList_addLong(longList, i * 10L);
+        celix_arrayList_addDouble(doubleList, i * 10.0);
+    }
+
+    // Then the index of entries in a block and in the remainder can be found
+    celix_array_list_entry_t entry{};
+    for (int i = 0; i < 21; ++i) {
+        entry.longVal = i * 10L;
+        EXPECT_EQ(i, celix_arrayList_indexOf(longList, entry));
+        entry.doubleVal = i * 10.0;
+        EXPECT_EQ(i, celix_arrayList_indexOf(doubleList, entry));
+    }
+    entry.longVal = 5L;
+    EXPECT_EQ(-1, celix_arrayList_indexOf(longList, entry));
+    entry.doubleVal = 5.0;
+    EXPECT_EQ(-1, celix_arrayList_indexOf(doubleList, entry));
+
+    // And removing an entry from the remainder works
+    celix_arrayList_removeLong(longList, 200L);
+    celix_arrayList_removeDouble(doubleList, 200.0);
+    EXPECT_EQ(20, celix_arrayList_size(longList));
+    EXPECT_EQ(20, celix_arrayList_size(doubleList));
+
+    // When copying the lists
+    celix_autoptr(celix_array_list_t) longCopy = celix_arrayList_copy(longList);
+    celix_autoptr(celix_array_list_t) doubleCopy = celix_arrayList_copy(doubleList);
+
+    // Then the copies are equal
+    EXPECT_TRUE(celix_arrayList_equals(longList, longCopy));
+    EXPECT_TRUE(celix_arrayList_equals(doubleList, doubleCopy));
+
+    // When changing an entry in a block and an entry in the remainder
+    celix_arrayList_removeLong(longCopy, 30L);
+    celix_arrayList_addLong(longCopy, 30L);
+    celix_arrayList_removeDouble(doubleCopy, 190.0);
+    celix_arrayList_addDouble(doubleCopy, 191.0);
+
+    // Then the lists are no longer equal
+    EXPECT_FALSE(celix_arrayList_equals(longList, longCopy));
+    EXPECT_FALSE(celix_arrayList_equals(doubleList, doubleCopy));
+}
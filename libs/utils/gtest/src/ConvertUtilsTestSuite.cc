@@ -21,8 +21,12 @@
 
 #include "celix_convert_utils.h"
 
-#include <string>
+#include <climits>
 #include <cmath>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
 
 #include "celix_err.h"
 
@@ -169,6 +173,56 @@ TEST_F(ConvertUtilsTestSuite, ConvertToDoubleTest) {
     EXPECT_TRUE(converted);
 }
 
+TEST_F(ConvertUtilsTestSuite, ConvertToLongAndDoubleSameAsStrtolAndStrtodTest) {
+    // Given a selection of edge case strings and randomly generated number strings
+    std::vector<std::string> inputs = {"0", "-0", "+0", "00012", "9223372036854775807", "9223372036854775808",
+                                       "-9223372036854775808", "-9223372036854775809", "99999999999999999999999",
+                                       "-", "+", "", " ", "1.", ".5", ".", "-.5e1", "1e", "1e+", "1e-5", "1E22",
+                                       "1e23", "9007199254740993", "9007199254740992", "0.1", "123456789012345678",
+                                       "1234567890123456789012", "4.9e-324", "1e-400", "1e400", "0e999999", "0x10",
+                                       "0x1p3", "inf", "-infinity", "nan", " \t\n12.5\v\f\r", "12.5x", "1,5",
+                                       "2.2250738585072014e-308", "179769313486231570000000000000000000000"};
+    std::mt19937 generator{42};
+    const char chars[] = "0123456789.-+eE ";
+    std::uniform_int_distribution<int> lenDistribution{1, 25};
+    std::uniform_int_distribution<int> charDistribution{0, (int)sizeof(chars) - 2};
+    for (int i = 0; i < 10000; ++i) {
+        std::string input{};
+        int len = lenDistribution(generator);
+        for (int j = 0; j < len; ++j) {
+            input += chars[charDistribution(generator)];
+        }
+        inputs.push_back(input);
+    }
+
+    for (const auto& input : inputs) {
+        // When converting the string to a long and double
+        bool longConverted;
+        long l = celix_utils_convertStringToLong(input.c_str(), -1, &longConverted);
+        bool doubleConverted;
+        double d = celix_utils_convertStringToDouble(input.c_str(), -1.0, &doubleConverted);
+
+        // Then the result is the same as the result of strtol and strtod
+        char* endptr;
+        long expectedLong = strtol(input.c_str(), &endptr, 10);
+        bool expectedLongConverted = endptr != input.c_str() && strspn(endptr, " \t\n\v\f\r") == strlen(endptr);
+        EXPECT_EQ(expectedLongConverted, longConverted) << input;
+        EXPECT_EQ(expectedLongConverted ? expectedLong : -1, l) << input;
+
+        double expectedDouble = strtod(input.c_str(), &endptr);
+        bool expectedDoubleConverted = endptr != input.c_str() && strspn(endptr, " \t\n\v\f\r") == strlen(endptr);
+        EXPECT_EQ(expectedDoubleConverted, doubleConverted) << input;
+        if (!expectedDoubleConverted) {
+            expectedDouble = -1.0;
+        }
+        if (std::isnan(expectedDouble)) {
+            EXPECT_TRUE(std::isnan(d)) << input;
+        } else {
+            EXPECT_EQ(0, memcmp(&expectedDouble, &d, sizeof(d))) << input; // bitwise equal, including -0.0
+        }
+    }
+}
+
 TEST_F(ConvertUtilsTestSuite, ConvertToBoolTest) {
     bool converted;
     //test for a valid string
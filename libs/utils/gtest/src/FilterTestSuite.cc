@@ -705,6 +705,41 @@ TEST_F(FilterTestSuite, MatchArrayTypesTest) {
     EXPECT_FALSE(celix_filter_match(filter10, props));
 }
 
+TEST_F(FilterTestSuite, MatchLargeArrayTypesTest) {
+    //Given a long and double array list with more entries than a kernel block
+    celix_autoptr(celix_array_list_t) longList = celix_arrayList_createLongArray();
+    celix_autoptr(celix_array_list_t) doubleList = celix_arrayList_createDoubleArray();
+    for (int i = 0; i < 20; ++i) {
+        celix_arrayList_addLong(longList, 10 + i);
+        celix_arrayList_addDouble(doubleList, 10.0 + i);
+    }
+
+    //And a properties with these array lists
+    celix_autoptr(celix_properties_t) props = celix_properties_create();
+    celix_properties_setArrayList(props, "longs", longList);
+    celix_properties_setArrayList(props, "doubles", doubleList);
+
+    // Then the filters match if any of the array elements, in a block or in the remainder, match
+    const char* matchingFilters[] = {"(longs=12)", "(longs=29)", "(longs>28)", "(longs>=29)", "(longs<11)",
+                                     "(longs<=10)", "(doubles=12.0)", "(doubles=29.0)", "(doubles>28.5)",
+                                     "(doubles>=29.0)", "(doubles<10.5)", "(doubles<=10.0)"};
+    for (const auto* filterStr : matchingFilters) {
+        celix_autoptr(celix_filter_t) filter = celix_filter_create(filterStr);
+        ASSERT_TRUE(filter != nullptr);
+        EXPECT_TRUE(celix_filter_match(filter, props)) << filterStr;
+    }
+
+    // And the filters do not match if none of the array elements match
+    const char* nonMatchingFilters[] = {"(longs=30)", "(longs>29)", "(longs>=30)", "(longs<10)", "(longs<=9)",
+                                        "(doubles=12.5)", "(doubles>29.0)", "(doubles>=29.5)", "(doubles<10.0)",
+                                        "(doubles<=9.5)"};
+    for (const auto* filterStr : nonMatchingFilters) {
+        celix_autoptr(celix_filter_t) filter = celix_filter_create(filterStr);
+        ASSERT_TRUE(filter != nullptr);
+        EXPECT_FALSE(celix_filter_match(filter, props)) << filterStr;
+    }
+}
+
 TEST_F(FilterTestSuite, ApproxWithArrayAttributesTest) {
     celix_array_list_t* stringList = celix_arrayList_createStringArray();
     celix_arrayList_addString(stringList, "abcdef");
@@ -0,0 +1,246 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <climits>
+#include <cmath>
+#include <cstring>
+
+#include "celix_array_list_encoding.h"
+#include "celix_err.h"
+#include "celix_properties.h"
+#include "celix_stdlib_cleanup.h"
+
+class PropertiesBinaryEncodingTestSuite : public ::testing::Test {
+  public:
+    PropertiesBinaryEncodingTestSuite() { celix_err_resetErrors(); }
+
+    static celix_properties_t* createTypedProperties() {
+        celix_properties_t* props = celix_properties_create();
+        celix_properties_set(props, "strKey", "value");
+        celix_properties_set(props, "", "emptyKey");
+        celix_properties_setLong(props, "longKey", -42);
+        celix_properties_setLong(props, "maxLongKey", LONG_MAX);
+        celix_properties_setLong(props, "minLongKey", LONG_MIN);
+        celix_properties_setDouble(props, "doubleKey", 3.14);
+        celix_properties_setDouble(props, "nanKey", NAN);
+        celix_properties_setBool(props, "boolKey", true);
+        celix_properties_assignVersion(props, "versionKey", celix_version_create(1, 2, 3, "qualifier"));
+
+        celix_autoptr(celix_array_list_t) longs = celix_arrayList_createLongArray();
+        celix_arrayList_addLong(longs, 1);
+        celix_arrayList_addLong(longs, -2);
+        celix_properties_setArrayList(props, "longArrayKey", longs);
+
+        celix_autoptr(celix_array_list_t) strings = celix_arrayList_createStringArray();
+        celix_arrayList_addString(strings, "a");
+        celix_arrayList_addString(strings, "b");
+        celix_properties_setArrayList(props, "stringArrayKey", strings);
+
+        celix_autoptr(celix_array_list_t) versions = celix_arrayList_createVersionArray();
+        celix_arrayList_assignVersion(versions, celix_version_create(1, 0, 0, ""));
+        celix_properties_setArrayList(props, "versionArrayKey", versions);
+
+        celix_autoptr(celix_array_list_t) emptyDoubles = celix_arrayList_createDoubleArray();
+        celix_properties_setArrayList(props, "emptyDoubleArrayKey", emptyDoubles);
+        return props;
+    }
+};
+
+TEST_F(PropertiesBinaryEncodingTestSuite, EncodeAndDecodeEmptyPropertiesTest) {
+    celix_autoptr(celix_properties_t) props = celix_properties_create();
+
+    celix_autofree void* buf = nullptr;
+    size_t bufSize = 0;
+    ASSERT_EQ(CELIX_SUCCESS, celix_properties_encodeToBinary(props, &buf, &bufSize));
+    EXPECT_EQ(5, bufSize); // header + entry count
+
+    celix_autoptr(celix_properties_t) decoded = nullptr;
+    ASSERT_EQ(CELIX_SUCCESS, celix_properties_decodeFromBinary(buf, bufSize, 0, &decoded));
+    EXPECT_EQ(0, celix_properties_size(decoded));
+}
+
+TEST_F(PropertiesBinaryEncodingTestSuite, EncodeAndDecodeTypedPropertiesTest) {
+    // Given a properties object with all supported value types
+    celix_autoptr(celix_properties_t) props = createTypedProperties();
+
+    // When encoding and decoding the properties using the binary encoding
+    celix_autofree void* buf = nullptr;
+    size_t bufSize = 0;
+    ASSERT_EQ(CELIX_SUCCESS, celix_properties_encodeToBinary(props, &buf, &bufSize));
+    celix_autoptr(celix_properties_t) decoded = nullptr;
+    ASSERT_EQ(CELIX_SUCCESS, celix_properties_decodeFromBinary(buf, bufSize, 0, &decoded));
+
+    // Then the value types are preserved
+    ASSERT_EQ(celix_properties_size(props), celix_properties_size(decoded));
+    CELIX_PROPERTIES_ITERATE(props, iter) {
+        EXPECT_EQ(iter.entry.valueType, celix_properties_getType(decoded, iter.key)) << "Key: " << iter.key;
+    }
+    EXPECT_STREQ("value", celix_properties_getString(decoded, "strKey"));
+    EXPECT_STREQ("emptyKey", celix_properties_getString(decoded, ""));
+    EXPECT_EQ(-42, celix_properties_getLong(decoded, "longKey", 0));
+    EXPECT_EQ(LONG_MAX, celix_properties_getLong(decoded, "maxLongKey", 0));
+    EXPECT_EQ(LONG_MIN, celix_properties_getLong(decoded, "minLongKey", 0));
+    EXPECT_DOUBLE_EQ(3.14, celix_properties_getDouble(decoded, "doubleKey", 0.0));
+    EXPECT_TRUE(std::isnan(celix_properties_getDouble(decoded, "nanKey", 0.0)));
+    EXPECT_TRUE(celix_properties_getBool(decoded, "boolKey", false));
+    EXPECT_EQ(0, celix_version_compareTo(celix_properties_getVersion(props, "versionKey"),
+                                         celix_properties_getVersion(decoded, "versionKey")));
+    EXPECT_TRUE(celix_arrayList_equals(celix_properties_getArrayList(props, "longArrayKey"),
+                                       celix_properties_getArrayList(decoded, "longArrayKey")));
+    EXPECT_TRUE(celix_arrayList_equals(celix_properties_getArrayList(props, "stringArrayKey"),
+                                       celix_properties_getArrayList(decoded, "stringArrayKey")));
+    EXPECT_TRUE(celix_arrayList_equals(celix_properties_getArrayList(props, "versionArrayKey"),
+                                       celix_properties_getArrayList(decoded, "versionArrayKey")));
+    const auto* emptyDoubles = celix_properties_getDoubleArrayList(decoded, "emptyDoubleArrayKey");
+    ASSERT_NE(nullptr, emptyDoubles);
+    EXPECT_EQ(0, celix_arrayList_size(emptyDoubles));
+}
+
+TEST_F(PropertiesBinaryEncodingTestSuite, DecodeWithoutCopyTest) {
+    // Given a binary encoded properties object with string entries
+    celix_autoptr(celix_properties_t) props = celix_properties_create();
+    celix_properties_set(props, "key1", "value1");
+    celix_properties_set(props, "key2", "a value which is too long for the properties short string optimization buffer, "
+                                        "so that it normally needs to be allocated");
+    celix_properties_setLong(props, "key3", 3);
+    celix_autofree void* buf = nullptr;
+    size_t bufSize = 0;
+    ASSERT_EQ(CELIX_SUCCESS, celix_properties_encodeToBinary(props, &buf, &bufSize));
+
+    // When decoding the properties without copying
+    celix_autoptr(celix_properties_t) decoded = nullptr;
+    ASSERT_EQ(CELIX_SUCCESS, celix_properties_decodeFromBinary(buf, bufSize, CELIX_PROPERTIES_DECODE_NO_COPY, &decoded));
+
+    // Then the keys and string values point into the input buffer
+    const char* begin = static_cast<const char*>(buf);
+    const char* end = begin + bufSize;
+    CELIX_PROPERTIES_ITERATE(decoded, iter) {
+        EXPECT_TRUE(iter.key >= begin && iter.key < end) << "Key: " << iter.key;
+        if (iter.entry.valueType == CELIX_PROPERTIES_VALUE_TYPE_STRING) {
+            EXPECT_TRUE(iter.entry.value >= begin && iter.entry.value < end) << "Key: " << iter.key;
+        }
+    }
+    EXPECT_TRUE(celix_properties_equals(props, decoded));
+
+    // And a copy of the decoded properties does not refer to the input buffer
+    celix_autoptr(celix_properties_t) copy = celix_properties_copy(decoded);
+    const char* value = celix_properties_getString(copy, "key2");
+    ASSERT_NE(nullptr, value);
+    EXPECT_FALSE(value >= begin && value < end);
+
+    // And overriding an entry of the decoded properties works as expected
+    celix_properties_set(decoded, "key2", "new value");
+    EXPECT_STREQ("new value", celix_properties_getString(decoded, "key2"));
+}
+
+TEST_F(PropertiesBinaryEncodingTestSuite, DecodeInvalidInputTest) {
+    celix_autoptr(celix_properties_t) props = createTypedProperties();
+    celix_autofree void* buf = nullptr;
+    size_t bufSize = 0;
+    ASSERT_EQ(CELIX_SUCCESS, celix_properties_encodeToBinary(props, &buf, &bufSize));
+
+    // Truncated input fails for every possible length
+    for (size_t len = 0; len < bufSize; ++len) {
+        celix_properties_t* decoded = nullptr;
+        EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, celix_properties_decodeFromBinary(buf, len, 0, &decoded)) << "Len: " << len;
+        EXPECT_EQ(nullptr, decoded);
+        celix_err_resetErrors();
+    }
+
+    // Input with trailing data fails
+    celix_autofree char* extended = (char*)malloc(bufSize + 1);
+    memcpy(extended, buf, bufSize);
+    extended[bufSize] = 'x';
+    celix_properties_t* decoded = nullptr;
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, celix_properties_decodeFromBinary(extended, bufSize + 1, 0, &decoded));
+
+    // Input with an invalid magic or unsupported version fails
+    memcpy(extended, buf, bufSize);
+    extended[0] = 'X';
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, celix_properties_decodeFromBinary(extended, bufSize, 0, &decoded));
+    memcpy(extended, buf, bufSize);
+    extended[3] = 2;
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, celix_properties_decodeFromBinary(extended, bufSize, 0, &decoded));
+
+    // Array list binary input is not accepted as properties binary input
+    celix_autoptr(celix_array_list_t) list = celix_arrayList_createLongArray();
+    celix_autofree void* listBuf = nullptr;
+    size_t listBufSize = 0;
+    ASSERT_EQ(CELIX_SUCCESS, celix_arrayList_encodeToBinary(list, &listBuf, &listBufSize));
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, celix_properties_decodeFromBinary(listBuf, listBufSize, 0, &decoded));
+
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, celix_properties_decodeFromBinary(nullptr, 0, 0, &decoded));
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, celix_properties_encodeToBinary(nullptr, &listBuf, &listBufSize));
+    EXPECT_GT(celix_err_getErrorCount(), 0);
+}
+
+TEST_F(PropertiesBinaryEncodingTestSuite, DecodeWithFlagsTest) {
+    celix_autoptr(celix_properties_t) props = createTypedProperties();
+    celix_autofree void* buf = nullptr;
+    size_t bufSize = 0;
+    ASSERT_EQ(CELIX_SUCCESS, celix_properties_encodeToBinary(props, &buf, &bufSize));
+
+    celix_properties_t* decoded = nullptr;
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT,
+              celix_properties_decodeFromBinary(buf, bufSize, CELIX_PROPERTIES_DECODE_ERROR_ON_EMPTY_KEYS, &decoded));
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT,
+              celix_properties_decodeFromBinary(buf, bufSize, CELIX_PROPERTIES_DECODE_ERROR_ON_EMPTY_ARRAYS, &decoded));
+    EXPECT_EQ(nullptr, decoded);
+}
+
+TEST_F(PropertiesBinaryEncodingTestSuite, EncodeAndDecodeArrayListTest) {
+    celix_autoptr(celix_array_list_t) list = celix_arrayList_createDoubleArray();
+    celix_arrayList_addDouble(list, 1.5);
+    celix_arrayList_addDouble(list, INFINITY);
+    celix_arrayList_addDouble(list, -0.25);
+
+    celix_autofree void* buf = nullptr;
+    size_t bufSize = 0;
+    ASSERT_EQ(CELIX_SUCCESS, celix_arrayList_encodeToBinary(list, &buf, &bufSize));
+
+    celix_autoptr(celix_array_list_t) decoded = nullptr;
+    ASSERT_EQ(CELIX_SUCCESS, celix_arrayList_decodeFromBinary(buf, bufSize, 0, &decoded));
+    EXPECT_EQ(CELIX_ARRAY_LIST_ELEMENT_TYPE_DOUBLE, celix_arrayList_getElementType(decoded));
+    EXPECT_TRUE(celix_arrayList_equals(list, decoded));
+
+    celix_autoptr(celix_array_list_t) boolList = celix_arrayList_createBoolArray();
+    celix_arrayList_addBool(boolList, true);
+    celix_arrayList_addBool(boolList, false);
+    celix_autofree void* boolBuf = nullptr;
+    ASSERT_EQ(CELIX_SUCCESS, celix_arrayList_encodeToBinary(boolList, &boolBuf, &bufSize));
+    celix_autoptr(celix_array_list_t) decodedBoolList = nullptr;
+    ASSERT_EQ(CELIX_SUCCESS, celix_arrayList_decodeFromBinary(boolBuf, bufSize, 0, &decodedBoolList));
+    EXPECT_TRUE(celix_arrayList_equals(boolList, decodedBoolList));
+}
+
+TEST_F(PropertiesBinaryEncodingTestSuite, EncodeUnsupportedArrayListTest) {
+    celix_autoptr(celix_array_list_t) list = celix_arrayList_createPointerArray();
+    celix_autofree void* buf = nullptr;
+    size_t bufSize = 0;
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, celix_arrayList_encodeToBinary(list, &buf, &bufSize));
+    EXPECT_EQ(nullptr, buf);
+
+    celix_autoptr(celix_array_list_t) emptyList = celix_arrayList_createLongArray();
+    ASSERT_EQ(CELIX_SUCCESS, celix_arrayList_encodeToBinary(emptyList, &buf, &bufSize));
+    celix_array_list_t* decoded = nullptr;
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT,
+              celix_arrayList_decodeFromBinary(buf, bufSize, CELIX_ARRAY_LIST_DECODE_ERROR_ON_EMPTY_ARRAYS, &decoded));
+    EXPECT_EQ(nullptr, decoded);
+}
@@ -24,6 +24,8 @@
 
 #include "celix_err.h"
 #include "celix_array_list_ei.h"
+#include "celix_json_stream_ei.h"
+#include "celix_string_hash_map_ei.h"
 #include "celix_utils_ei.h"
 #include "celix_version_ei.h"
 #include "jansson_ei.h"
@@ -44,23 +46,28 @@ class PropertiesEncodingErrorInjectionTestSuite : public ::testing::Test {
         celix_ei_expect_malloc(nullptr, 0, nullptr);
         celix_ei_expect_celix_arrayList_createWithOptions(nullptr, 0, nullptr);
         celix_ei_expect_celix_arrayList_addString(nullptr, 0, CELIX_SUCCESS);
+        celix_ei_expect_celix_arrayList_createStringArray(nullptr, 0, nullptr);
+        celix_ei_expect_celix_jsonWriter_writeChar(nullptr, 0, CELIX_SUCCESS);
+        celix_ei_expect_celix_version_tryParse(nullptr, 0, CELIX_SUCCESS);
+        celix_ei_expect_celix_stringHashMap_create(nullptr, 0, nullptr);
+        celix_ei_expect_fread(nullptr, 0, 0);
         celix_err_resetErrors();
     }
 };
 
 TEST_F(PropertiesEncodingErrorInjectionTestSuite, SaveErrorTest) {
-    //Given a dummy properties object
+    //Given a dummy properties object with a nested key (nested keys are encoded using jansson, whitebox-knowledge)
     celix_autoptr(celix_properties_t) props = celix_properties_create();
-    celix_properties_set(props, "key", "value");
+    celix_properties_set(props, "key.nested", "value");
 
     //When an error injected is prepared for json_object() from saveToStream
-    celix_ei_expect_json_object((void*)celix_properties_saveToStream, 0, nullptr);
+    celix_ei_expect_json_object((void*)celix_properties_saveToStream, 1, nullptr);
 
     //And a dummy stream is created
     FILE* stream = fopen("/dev/null", "w");
 
-    //When I call celix_properties_saveToStream
-    celix_status_t status = celix_properties_saveToStream(props, stream, 0);
+    //When I call celix_properties_saveToStream using NESTED encoding
+    celix_status_t status = celix_properties_saveToStream(props, stream, CELIX_PROPERTIES_ENCODE_NESTED_STYLE);
 
     //Then I expect an error
     EXPECT_EQ(CELIX_ENOMEM, status);
@@ -69,9 +76,9 @@ TEST_F(PropertiesEncodingErrorInjectionTestSuite, SaveErrorTest) {
     //When an error injected is prepared for open_memstream()n from save
     celix_ei_expect_open_memstream((void*)celix_properties_saveToString, 0, nullptr);
 
-    //When I call celix_properties_saveToString
+    //When I call celix_properties_saveToString using NESTED encoding
     char* out;
-    status = celix_properties_saveToString(props, 0, &out);
+    status = celix_properties_saveToString(props, CELIX_PROPERTIES_ENCODE_NESTED_STYLE, &out);
 
     //Then I expect an error
     EXPECT_EQ(ENOMEM, status);
@@ -107,7 +114,7 @@ TEST_F(PropertiesEncodingErrorInjectionTestSuite, EncodeErrorTest) {
     celix_properties_set(props, "key-with-out-slash", "value");
 
     // When an error injected is prepared for celix_utils_writeOrCreateString() from celix_properties_saveToString
-    celix_ei_expect_celix_utils_writeOrCreateString((void*)celix_properties_saveToString, 2, nullptr);
+    celix_ei_expect_celix_utils_writeOrCreateString((void*)celix_properties_saveToString, 3, nullptr);
 
     // And I call celix_properties_saveToString using NESTED encoding (whitebox-knowledge)
     char* out;
@@ -117,7 +124,7 @@ TEST_F(PropertiesEncodingErrorInjectionTestSuite, EncodeErrorTest) {
     EXPECT_EQ(ENOMEM, status);
 
     // When an error injected is prepared for json_object() from celix_properties_saveToString
-    celix_ei_expect_json_object((void*)celix_properties_saveToString, 2, nullptr);
+    celix_ei_expect_json_object((void*)celix_properties_saveToString, 3, nullptr);
 
     // And I call celix_properties_saveToString using NESTED encoding (whitebox-knowledge)
     status = celix_properties_saveToString(props, CELIX_PROPERTIES_ENCODE_NESTED_STYLE, &out);
@@ -126,7 +133,7 @@ TEST_F(PropertiesEncodingErrorInjectionTestSuite, EncodeErrorTest) {
     EXPECT_EQ(ENOMEM, status);
 
     // When an error injected is prepared for json_object_set_new() from celix_properties_saveToString
-    celix_ei_expect_json_object_set_new((void*)celix_properties_saveToString, 2, -1);
+    celix_ei_expect_json_object_set_new((void*)celix_properties_saveToString, 3, -1);
 
     // And I call celix_properties_saveToString using NESTED encoding (whitebox-knowledge)
     status = celix_properties_saveToString(props, CELIX_PROPERTIES_ENCODE_NESTED_STYLE, &out);
@@ -135,7 +142,7 @@ TEST_F(PropertiesEncodingErrorInjectionTestSuite, EncodeErrorTest) {
     EXPECT_EQ(ENOMEM, status);
 
     // When an error injected is prepared for json_string() from celix_properties_saveToString
-    celix_ei_expect_json_string((void*)celix_properties_saveToString, 3, nullptr);
+    celix_ei_expect_json_string((void*)celix_properties_saveToString, 4, nullptr);
 
     // And I call celix_properties_saveToString using NESTED encoding (whitebox-knowledge)
     status = celix_properties_saveToString(props, CELIX_PROPERTIES_ENCODE_NESTED_STYLE, &out);
@@ -144,10 +151,10 @@ TEST_F(PropertiesEncodingErrorInjectionTestSuite, EncodeErrorTest) {
     EXPECT_EQ(ENOMEM, status);
 
     // When an error injected is prepared for json_object_set_new() from celix_properties_saveToString
-    celix_ei_expect_json_object_set_new((void*)celix_properties_saveToString, 3, -1);
+    celix_ei_expect_json_object_set_new((void*)celix_properties_saveToString, 4, -1);
 
-    // And I call celix_properties_saveToString using FLAT encoding (whitebox-knowledge)
-    status = celix_properties_saveToString(props, CELIX_PROPERTIES_ENCODE_FLAT_STYLE, &out);
+    // And I call celix_properties_saveToString using NESTED encoding (whitebox-knowledge)
+    status = celix_properties_saveToString(props, CELIX_PROPERTIES_ENCODE_NESTED_STYLE, &out);
 
     // Then I expect an error
     EXPECT_EQ(ENOMEM, status);
@@ -164,13 +171,14 @@ TEST_F(PropertiesEncodingErrorInjectionTestSuite, EncodeArrayErrorTest) {
     celix_arrayList_addString(arr, "value1");
     celix_arrayList_addString(arr, "value2");
     celix_properties_assignArrayList(props, "key", arr);
+    celix_properties_set(props, "nested.key", "value");
 
     // When an error injected is prepared for json_array() from celix_properties_saveToString
-    celix_ei_expect_json_array((void*)celix_properties_saveToString, 5, nullptr);
+    celix_ei_expect_json_array((void*)celix_properties_saveToString, 6, nullptr);
 
-    // And I call celix_properties_saveToString
+    // And I call celix_properties_saveToString using NESTED encoding (whitebox-knowledge)
     char* out;
-    auto status = celix_properties_saveToString(props, 0, &out);
+    auto status = celix_properties_saveToString(props, CELIX_PROPERTIES_ENCODE_NESTED_STYLE, &out);
 
     // Then I expect an error
     EXPECT_EQ(ENOMEM, status);
@@ -185,22 +193,23 @@ TEST_F(PropertiesEncodingErrorInjectionTestSuite, EncodeVersionErrorTest) {
     celix_autoptr(celix_properties_t) props = celix_properties_create();
     auto* version = celix_version_create(1, 2, 3, "qualifier");
     celix_properties_assignVersion(props, "key", version);
+    celix_properties_set(props, "nested.key", "value");
 
     // When an error injected is prepared for json_sprintf() from celix_properties_saveToString
-    celix_ei_expect_json_sprintf((void*)celix_properties_saveToString, 4, nullptr);
+    celix_ei_expect_json_sprintf((void*)celix_properties_saveToString, 5, nullptr);
 
-    // And I call celix_properties_saveToString
+    // And I call celix_properties_saveToString using NESTED encoding (whitebox-knowledge)
     char* out;
-    auto status = celix_properties_saveToString(props, 0, &out);
+    auto status = celix_properties_saveToString(props, CELIX_PROPERTIES_ENCODE_NESTED_STYLE, &out);
 
     // Then I expect an error
     EXPECT_EQ(ENOMEM, status);
 
     // When an error injected is prepared for celix_version_toString() from celix_properties_saveToString
-    celix_ei_expect_celix_version_toString((void*)celix_properties_saveToString, 4, nullptr);
+    celix_ei_expect_celix_version_toString((void*)celix_properties_saveToString, 5, nullptr);
 
-    // And I call celix_properties_saveToString
-    status = celix_properties_saveToString(props, 0, &out);
+    // And I call celix_properties_saveToString using NESTED encoding (whitebox-knowledge)
+    status = celix_properties_saveToString(props, CELIX_PROPERTIES_ENCODE_NESTED_STYLE, &out);
 
     // Then I expect an error
     EXPECT_EQ(ENOMEM, status);
@@ -213,14 +222,14 @@ TEST_F(PropertiesEncodingErrorInjectionTestSuite, EncodeVersionErrorTest) {
 TEST_F(PropertiesEncodingErrorInjectionTestSuite, EncodeDumpfErrorTest) {
     // Given a dummy properties object
     celix_autoptr(celix_properties_t) props = celix_properties_create();
-    celix_properties_set(props, "key", "value");
+    celix_properties_set(props, "key.nested", "value");
 
     // When an error injected is prepared for json_dumpf() from celix_properties_saveToString
-    celix_ei_expect_json_dumpf((void*)celix_properties_saveToStream, 0, -1);
+    celix_ei_expect_json_dumpf((void*)celix_properties_saveToStream, 1, -1);
 
-    // And I call celix_properties_saveToString
+    // And I call celix_properties_saveToString using NESTED encoding (whitebox-knowledge)
     char* out;
-    auto status = celix_properties_saveToString(props, 0, &out);
+    auto status = celix_properties_saveToString(props, CELIX_PROPERTIES_ENCODE_NESTED_STYLE, &out);
 
     // Then I expect an error
     EXPECT_EQ(ENOMEM, status);
@@ -234,15 +243,17 @@ TEST_F(PropertiesEncodingErrorInjectionTestSuite, LoadErrorTest) {
     //Given a dummy json string
     const char* json = R"({"key":"value"})";
 
-    //When an error injected is prepared for fmemopen() from loadFromString2
-    celix_ei_expect_fmemopen((void*)celix_properties_loadFromString, 0, nullptr);
+    //When an error injected is prepared for fread() from loadFromStream
+    celix_ei_expect_fread((void*)celix_properties_loadFromStream, 6, 0);
 
-    //When I call celix_properties_loadFromString
+    //When I call celix_properties_loadFromStream
+    FILE* stream = fmemopen((void*)json, strlen(json), "r");
     celix_properties_t* props;
-    auto status = celix_properties_loadFromString(json, 0, &props);
+    auto status = celix_properties_loadFromStream(stream, 0, &props);
+    fclose(stream);
 
-    //Then I expect an error
-    EXPECT_EQ(ENOMEM, status);
+    //Then I expect an error, because the input is incomplete
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, status);
 
     //And I expect 1 error message in celix_err
     EXPECT_EQ(1, celix_err_getErrorCount());
@@ -253,8 +264,8 @@ TEST_F(PropertiesEncodingErrorInjectionTestSuite, DecodeErrorTest) {
     //Given a dummy json string
     const char* json = R"({"key":"value", "object": {"key":"value"}})";
 
-    //When an error injected is prepared for celix_properties_create()->malloc() from celix_properties_loadFromString2
-    celix_ei_expect_malloc((void*)celix_properties_loadFromString, 3, nullptr);
+    //When an error injected is prepared for celix_properties_create()->malloc() from celix_properties_loadFromString
+    celix_ei_expect_malloc((void*)celix_properties_loadFromString, 2, nullptr);
 
     //When I call celix_properties_loadFromString
     celix_properties_t* props;
@@ -263,8 +274,8 @@ TEST_F(PropertiesEncodingErrorInjectionTestSuite, DecodeErrorTest) {
     //Then I expect an error
     EXPECT_EQ(ENOMEM, status);
 
-    //When an error injected is prepared for celix_utils_writeOrCreateString() from celix_properties_loadFromString2
-    celix_ei_expect_celix_utils_writeOrCreateString((void*)celix_properties_loadFromString, 3, nullptr);
+    //When an error injected is prepared for celix_jsonWriter_writeChar() (sub key) from celix_properties_loadFromString
+    celix_ei_expect_celix_jsonWriter_writeChar((void*)celix_properties_loadFromString, 4, ENOMEM);
 
     //When I call celix_properties_loadFromString
     status = celix_properties_loadFromString(json, 0, &props);
@@ -281,8 +292,8 @@ TEST_F(PropertiesEncodingErrorInjectionTestSuite, DecodeArrayErrorTest) {
     //Given a dummy json string
     const char* json = R"({"key":["value1", "value2"]})";
 
-    // When an error injected is prepared for celix_arrayList_createWithOptions() from celix_properties_loadFromString
-    celix_ei_expect_celix_arrayList_createWithOptions((void*)celix_properties_loadFromString, 5, nullptr);
+    // When an error injected is prepared for celix_arrayList_createStringArray() from celix_properties_loadFromString
+    celix_ei_expect_celix_arrayList_createStringArray((void*)celix_properties_loadFromString, 5, nullptr);
 
     //When I call celix_properties_loadFromString
     celix_properties_t* props;
@@ -300,8 +311,8 @@ TEST_F(PropertiesEncodingErrorInjectionTestSuite, DecodeVersionErrorTest) {
     // Given a dummy json version string
     const char* json = R"({"key":"version<1.2.3.qualifier>"})";
 
-    // When an error injected is prepared for celix_utils_writeOrCreateString() from celix_properties_loadFromString2
-    celix_ei_expect_celix_utils_writeOrCreateString((void*)celix_properties_loadFromString, 4, nullptr);
+    // When an error injected is prepared for celix_version_tryParse() from celix_properties_loadFromString
+    celix_ei_expect_celix_version_tryParse((void*)celix_properties_loadFromString, 4, ENOMEM);
 
     // And I call celix_properties_loadFromString
     celix_properties_t* props;
@@ -315,19 +326,91 @@ TEST_F(PropertiesEncodingErrorInjectionTestSuite, DecodeVersionErrorTest) {
     celix_err_printErrors(stderr, "Test Error: ", "\n");
 }
 
+TEST_F(PropertiesEncodingErrorInjectionTestSuite, StreamingEncodeErrorTest) {
+    // Given a dummy properties object
+    celix_autoptr(celix_properties_t) props = celix_properties_create();
+    celix_properties_set(props, "key", "value");
+
+    // When an error injected is prepared for malloc() from celix_properties_saveToString (json writer, whitebox-knowledge)
+    celix_ei_expect_malloc((void*)celix_properties_saveToString, 4, nullptr);
+
+    // And I call celix_properties_saveToString
+    char* out;
+    auto status = celix_properties_saveToString(props, 0, &out);
+
+    // Then I expect an error
+    EXPECT_EQ(ENOMEM, status);
+
+    // When an error injected is prepared for fwrite() from celix_properties_saveToStream
+    celix_ei_expect_fwrite((void*)celix_properties_saveToStream, 0, 0);
+
+    // And I call celix_properties_saveToStream
+    FILE* stream = fopen("/dev/null", "w");
+    status = celix_properties_saveToStream(props, stream, 0);
+    fclose(stream);
+
+    // Then I expect an error
+    EXPECT_EQ(CELIX_FILE_IO_EXCEPTION, status);
+
+    // And I expect 2 error messages in celix_err
+    EXPECT_EQ(2, celix_err_getErrorCount());
+    celix_err_printErrors(stderr, "Test Error: ", "\n");
+}
+
+TEST_F(PropertiesEncodingErrorInjectionTestSuite, StreamingDecodeErrorTest) {
+    // Given a dummy json string with a key longer than the initial key buffer of the decoder
+    std::string json = R"({")" + std::string(200, 'k') + R"(":"value", "object": {"key":"value"}})";
+
+    // When an error injected is prepared for malloc() from celix_properties_loadFromString (growing the key buffer)
+    celix_ei_expect_malloc((void*)celix_properties_loadFromString, 5, nullptr);
+
+    // And I call celix_properties_loadFromString
+    celix_properties_t* props;
+    auto status = celix_properties_loadFromString(json.c_str(), 0, &props);
+
+    // Then I expect an error
+    EXPECT_EQ(ENOMEM, status);
+
+    // When an error injected is prepared for celix_stringHashMap_create() from celix_properties_loadFromString
+    // (tracking the member names to detect duplicates)
+    celix_ei_expect_celix_stringHashMap_create((void*)celix_properties_loadFromString, 2, nullptr);
+
+    // And I call celix_properties_loadFromString with a flag to detect duplicates
+    status = celix_properties_loadFromString(json.c_str(), CELIX_PROPERTIES_DECODE_ERROR_ON_DUPLICATES, &props);
+
+    // Then I expect an error
+    EXPECT_EQ(ENOMEM, status);
+
+    // When an error injected is prepared for the second fread() call (refilling the stream buffer)
+    celix_ei_expect_fread(CELIX_EI_UNKNOWN_CALLER, 0, 0, 2);
+
+    // And I call celix_properties_loadFromStream with an input larger than the stream buffer
+    std::string largeJson = R"({"key":")" + std::string(2048, 'v') + R"("})";
+    FILE* stream = fmemopen((void*)largeJson.c_str(), largeJson.size(), "r");
+    status = celix_properties_loadFromStream(stream, 0, &props);
+    fclose(stream);
+
+    // Then I expect an error, because the input is incomplete
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, status);
+
+    // And I expect 3 error messages in celix_err
+    EXPECT_EQ(3, celix_err_getErrorCount());
+    celix_err_printErrors(stderr, "Test Error: ", "\n");
+}
+
 TEST_F(PropertiesEncodingErrorInjectionTestSuite, SaveCxxPropertiesErrorTest) {
     //Given a dummy Properties object
     celix::Properties props{};
-    props.set("key", "value");
+    props.set("key.nested", "value");
 
     //When an error injected is prepared for json_object() from saveToStream
-    celix_ei_expect_json_object((void*)celix_properties_saveToStream, 0, nullptr);
+    celix_ei_expect_json_object((void*)celix_properties_saveToStream, 1, nullptr);
 
-    //Then saving to file throws a bad alloc exception
-    EXPECT_THROW(props.save("somefile.json"), std::bad_alloc);
+    //Then saving to file using NESTED encoding throws a bad alloc exception
+    EXPECT_THROW(props.save("somefile.json", celix::Properties::EncodingFlags::NestedStyle), std::bad_alloc);
 
-    //When an error injected is prepared for json_object() from saveToStream
-    celix_ei_expect_json_object((void*)celix_properties_saveToStream, 0, nullptr);
+    //When an error injected is prepared for malloc() from saveToString
+    celix_ei_expect_malloc((void*)celix_properties_saveToString, 4, nullptr);
 
     //Then saving to string throws a bad alloc exception
     EXPECT_THROW(props.saveToString(), std::bad_alloc);
@@ -1135,3 +1135,103 @@ TEST_F(PropertiesSerializationTestSuite, KeyCollision) {
     std::cout << output << std::endl;
     EXPECT_EQ(CELIX_SUCCESS, status);
 }
+
+TEST_F(PropertiesSerializationTestSuite, SaveEscapedStringsAndRealsTest) {
+    // Given a properties object with strings which need escaping and with reals
+    celix_autoptr(celix_properties_t) props = celix_properties_create();
+    celix_properties_set(props, "key\"1", "a\\b/c\n\t\x01 é");
+    celix_properties_setDouble(props, "key2", 1e20);
+    celix_properties_setDouble(props, "key3", -0.0);
+    celix_properties_setDouble(props, "key4", 1e-5);
+
+    // When saving the properties to a string
+    celix_autofree char* output = nullptr;
+    auto status = celix_properties_saveToString(props, 0, &output);
+    ASSERT_EQ(CELIX_SUCCESS, status);
+
+    // Then the strings are escaped and the reals are formatted as done by jansson
+    EXPECT_NE(nullptr, strstr(output, R"("key\"1":"a\\b/c\n\t\u0001 é")")) << output;
+    EXPECT_NE(nullptr, strstr(output, R"("key2":1e20)")) << output;
+    EXPECT_NE(nullptr, strstr(output, R"("key3":-0.0)")) << output;
+    EXPECT_NE(nullptr, strstr(output, R"("key4":1.0000000000000001e-5)")) << output;
+
+    // When saving properties with an invalid UTF-8 string
+    celix_properties_set(props, "key5", "\xff");
+    celix_autofree char* output2 = nullptr;
+    status = celix_properties_saveToString(props, 0, &output2);
+
+    // Then the encoding fails
+    EXPECT_EQ(ENOMEM, status);
+    EXPECT_EQ(nullptr, output2);
+    celix_err_printErrors(stderr, "Test Error: ", "\n");
+}
+
+TEST_F(PropertiesSerializationTestSuite, LoadPropertiesWithEscapedStringsTest) {
+    // Given a JSON object with escaped strings, a mixed integer/real array and a duplicate key
+    auto json = R"({"keyé":"😀\"\\\/\b\f\n\r\t", "arr":[1, 2.5], "dup":1, "dup":2})";
+
+    // When loading the properties from the JSON object
+    celix_autoptr(celix_properties_t) props = nullptr;
+    auto status = celix_properties_loadFromString(json, 0, &props);
+    ASSERT_EQ(CELIX_SUCCESS, status);
+
+    // Then the strings are unescaped
+    EXPECT_STREQ("\xf0\x9f\x98\x80\"\\/\b\f\n\r\t", celix_properties_getString(props, "key\xc3\xa9"));
+
+    // And the mixed array is a double array
+    const auto* arr = celix_properties_getDoubleArrayList(props, "arr");
+    ASSERT_NE(nullptr, arr);
+    EXPECT_EQ(2, celix_arrayList_size(arr));
+    EXPECT_DOUBLE_EQ(1.0, celix_arrayList_getDouble(arr, 0));
+
+    // And the last value of a duplicate key is used
+    EXPECT_EQ(2, celix_properties_getLong(props, "dup", 0));
+
+    // When loading a JSON object with a lone surrogate or an escaped '\0'
+    celix_properties_t* props2 = nullptr;
+    status = celix_properties_loadFromString(R"({"key":"\ud83d"})", 0, &props2);
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, status);
+    status = celix_properties_loadFromString(R"({"key":"\u0000"})", 0, &props2);
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, status);
+
+    // Then the decoding fails and an error is logged for each input
+    EXPECT_EQ(2, celix_err_getErrorCount());
+    celix_err_printErrors(stderr, "Test Error: ", "\n");
+}
+
+TEST_F(PropertiesSerializationTestSuite, LoadLargePropertiesFromStreamTest) {
+    // Given a properties object which is encoded to a JSON text larger than the stream read buffer, with escaped and
+    // multibyte strings, numbers and versions crossing the buffer boundaries
+    celix_autoptr(celix_properties_t) props = celix_properties_create();
+    for (int i = 0; i < 200; ++i) {
+        std::string key = "key" + std::to_string(i);
+        std::string value = std::string(i % 7, 'x') + "\"é😀\\\n" + std::to_string(i);
+        celix_properties_set(props, (key + "/str").c_str(), value.c_str());
+        celix_properties_setLong(props, (key + "/long").c_str(), 1000000L * i);
+        celix_properties_setDouble(props, (key + "/double").c_str(), 0.5 + i);
+        celix_properties_assignVersion(props, (key + "/version").c_str(), celix_version_create(1, 2, i, "q"));
+    }
+    celix_autofree char* json = nullptr;
+    ASSERT_EQ(CELIX_SUCCESS, celix_properties_saveToString(props, CELIX_PROPERTIES_ENCODE_PRETTY, &json));
+
+    // When loading the properties from a stream
+    FILE* stream = fmemopen(json, strlen(json), "r");
+    celix_autoptr(celix_properties_t) loadedProps = nullptr;
+    auto status = celix_properties_loadFromStream(stream, CELIX_PROPERTIES_DECODE_STRICT, &loadedProps);
+    fclose(stream);
+
+    // Then loading succeeds and the loaded properties are equal to the original properties
+    ASSERT_EQ(CELIX_SUCCESS, status);
+    EXPECT_TRUE(celix_properties_equals(props, loadedProps));
+
+    // When loading a truncated JSON text from a stream
+    stream = fmemopen(json, strlen(json) - 2, "r");
+    celix_properties_t* props2 = nullptr;
+    status = celix_properties_loadFromStream(stream, 0, &props2);
+    fclose(stream);
+
+    // Then loading fails and an error is logged
+    EXPECT_EQ(CELIX_ILLEGAL_ARGUMENT, status);
+    EXPECT_EQ(1, celix_err_getErrorCount());
+    celix_err_printErrors(stderr, "Test Error: ", "\n");
+}
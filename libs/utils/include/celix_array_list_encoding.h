@@ -219,6 +219,55 @@ celix_status_t celix_arrayList_load(const char* filename, int decodeFlags, celix
 CELIX_UTILS_EXPORT
 celix_status_t celix_arrayList_loadFromString(const char* input, int decodeFlags, celix_array_list_t** out);
 
+/**
+ * @brief Encode the given celix_array_list_t to a compact, versioned binary representation.
+ *
+ * In contrast to the JSON encoding, the binary encoding preserves the element type of the array list (including
+ * empty arrays) and can encode NaN and Inf double values.
+ *
+ * Array list elements are encoded as follows:
+ * - CELIX_ARRAY_LIST_ELEMENT_TYPE_STRING: Encoded as a length prefixed and '\0' terminated string.
+ * - CELIX_ARRAY_LIST_ELEMENT_TYPE_LONG: Encoded as a zigzag varint.
+ * - CELIX_ARRAY_LIST_ELEMENT_TYPE_DOUBLE: Encoded as a 8 byte little endian IEEE 754 value.
+ * - CELIX_ARRAY_LIST_ELEMENT_TYPE_BOOL: Encoded as a single byte.
+ * - CELIX_ARRAY_LIST_ELEMENT_TYPE_VERSION: Encoded as major, minor and micro varints followed by the qualifier string.
+ * - CELIX_ARRAY_LIST_ELEMENT_TYPE_UNDEFINED and CELIX_ARRAY_LIST_ELEMENT_TYPE_POINTER: Not supported and will result
+ * in an error.
+ *
+ * If the return status is an error, an error message is logged to celix_err.
+ *
+ * @param list The celix_array_list_t to encode.
+ * @param out The resulting binary representation. The caller is responsible for freeing the returned buffer using free.
+ * @param outSize The size of the resulting binary representation.
+ * @return CELIX_SUCCESS if the encoding was successful.
+ *         CELIX_ILLEGAL_ARGUMENT if the `list`, `out` or `outSize` is NULL, or the list element type is not supported.
+ *         ENOMEM if there was not enough memory.
+ */
+CELIX_UTILS_EXPORT
+celix_status_t celix_arrayList_encodeToBinary(const celix_array_list_t* list, void** out, size_t* outSize);
+
+/**
+ * @brief Decode a celix_array_list_t from a binary representation created with celix_arrayList_encodeToBinary.
+ *
+ * Empty binary arrays are decoded to an empty celix_array_list_t of the encoded element type, unless the
+ * CELIX_ARRAY_LIST_DECODE_ERROR_ON_EMPTY_ARRAYS flag is set.
+ *
+ * If the return status is an error, an error message is logged to celix_err.
+ *
+ * @param input The binary representation to decode.
+ * @param inputSize The size of the binary representation.
+ * @param decodeFlags The decoding flags to use.
+ * @param out The decoded celix_array_list_t. The caller is responsible for destroying the returned celix_array_list_t
+ * using celix_arrayList_destroy.
+ * @return CELIX_SUCCESS if the decoding was successful.
+ *        CELIX_ILLEGAL_ARGUMENT if the `input` or `out` is NULL, or the input is not a valid binary array list
+ *        representation of a supported encoding version.
+ *        ENOMEM if there was not enough memory.
+ */
+CELIX_UTILS_EXPORT
+celix_status_t
+celix_arrayList_decodeFromBinary(const void* input, size_t inputSize, int decodeFlags, celix_array_list_t** out);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1137,6 +1137,17 @@ CELIX_UTILS_EXPORT celix_status_t celix_properties_saveToString(const celix_prop
  */
 #define CELIX_PROPERTIES_DECODE_ERROR_ON_EMPTY_KEYS 0x20
 
+/**
+ * @brief Flag to indicate that string data should not be copied out of the input during decoding.
+ *
+ * This flag is only supported by celix_properties_decodeFromBinary. If set, the decoded properties keys and string
+ * values point directly into the binary input buffer. As result the input buffer must outlive the decoded properties
+ * object and must not be modified while the properties object is in use.
+ *
+ * Note that string array elements and version values are always copied.
+ */
+#define CELIX_PROPERTIES_DECODE_NO_COPY 0x40
+
 /**
  * @brief Flag to indicate that the decoding should fail if the input contains any of the decode error flags.
  *
@@ -1237,6 +1248,56 @@ CELIX_UTILS_EXPORT celix_status_t celix_properties_loadFromString(const char* in
                                                                    int decodeFlags,
                                                                    celix_properties_t** out);
 
+/**
+ * @brief Encode properties to a compact, versioned binary representation.
+ *
+ * The binary encoding is intended for IPC and persistence, where the JSON encoding and decoding time dominates.
+ * In contrast to the JSON encoding, the binary encoding preserves all properties value types - including the
+ * element type of (empty) array entries - and can encode NaN and Inf double values.
+ *
+ * The binary representation starts with a 4 byte header (magic "CPB" and a format version byte), followed by the
+ * number of entries and the entries. Each entry is encoded as a key string, a value type tag and the value.
+ * Integers are encoded as zigzag varints, doubles as 8 byte little endian IEEE 754 values and strings as length
+ * prefixed and '\0' terminated strings.
+ *
+ * If the return status is an error, an error message is logged to celix_err.
+ *
+ * @param[in] properties The properties object to encode.
+ * @param[out] out The binary representation of the properties object. The caller is responsible for freeing the
+ * returned buffer using free.
+ * @param[out] outSize The size of the binary representation.
+ * @return CELIX_SUCCESS if the operation was successful, CELIX_ILLEGAL_ARGUMENT if an argument is NULL and ENOMEM if
+ * there was not enough memory.
+ */
+CELIX_UTILS_EXPORT celix_status_t celix_properties_encodeToBinary(const celix_properties_t* properties,
+                                                                  void** out,
+                                                                  size_t* outSize);
+
+/**
+ * @brief Decode properties from a binary representation created with celix_properties_encodeToBinary.
+ *
+ * The following decode flags are supported: CELIX_PROPERTIES_DECODE_ERROR_ON_DUPLICATES,
+ * CELIX_PROPERTIES_DECODE_ERROR_ON_EMPTY_ARRAYS, CELIX_PROPERTIES_DECODE_ERROR_ON_EMPTY_KEYS and
+ * CELIX_PROPERTIES_DECODE_NO_COPY. Other decode flags are ignored.
+ *
+ * If the CELIX_PROPERTIES_DECODE_NO_COPY flag is set, keys and string values are not copied out of the input buffer.
+ * The input buffer must then outlive the returned properties object.
+ *
+ * If an error occurs, the error status is returned and a message is logged to celix_err.
+ *
+ * @param[in] input The binary representation to decode.
+ * @param[in] inputSize The size of the binary representation.
+ * @param[in] decodeFlags The flags to use when decoding the input.
+ * @param[out] out The properties object that will be created from the input. The caller is responsible for
+ * freeing the returned properties object using celix_properties_destroy.
+ * @return CELIX_SUCCESS if the operation was successful, CELIX_ILLEGAL_ARGUMENT if the provided input is not a valid
+ * binary properties representation of a supported encoding version and ENOMEM if there was not enough memory.
+ */
+CELIX_UTILS_EXPORT celix_status_t celix_properties_decodeFromBinary(const void* input,
+                                                                    size_t inputSize,
+                                                                    int decodeFlags,
+                                                                    celix_properties_t** out);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,214 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef CELIX_CELIX_JSON_STREAM_INTERNAL_H
+#define CELIX_CELIX_JSON_STREAM_INTERNAL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include "celix_errno.h"
+#include "celix_utils_export.h"
+#include "celix_version.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file celix_json_stream_internal.h
+ * @brief Primitives to write and read JSON text directly, without building a jansson json_t tree.
+ * The internal API is only meant to be used inside the Apache Celix project, so this is not part of the public API.
+ *
+ * The writer produces the same output as jansson's json_dump* functions (without JSON_ENSURE_ASCII,
+ * JSON_ESCAPE_SLASH and JSON_REAL_PRECISION flags) and the reader accepts the same JSON syntax as jansson's
+ * json_load* functions (without JSON_ALLOW_NUL).
+ *
+ * The functions in this file do not log errors to celix_err, error reporting is left to the caller.
+ */
+
+/**
+ * @brief Growable, always '\0' terminated, character buffer used to write JSON text.
+ *
+ * The writer can start with a caller provided (e.g. stack) buffer and only allocates when that buffer is too small.
+ * The writer keeps the first error status, so that multiple write calls can be chained and only the final status
+ * needs to be checked.
+ */
+typedef struct celix_json_writer {
+    char* data;
+    size_t size;
+    size_t capacity;
+    char* callerBuffer;
+    celix_status_t status;
+} celix_json_writer_t;
+
+/**
+ * @brief Input view used for reading JSON text. The reader does not own the data.
+ *
+ * A reader either reads from an in-memory input or incrementally from a stream. For a stream, data is a window on the
+ * stream input which is refilled using the caller provided buffer.
+ */
+typedef struct celix_json_reader {
+    const char* data;
+    size_t size;
+    size_t offset;
+    FILE* stream;       // stream to refill the buffer from, NULL for in-memory input or when the stream is exhausted
+    char* buffer;
+    size_t capacity;
+    size_t consumed;    // number of stream bytes which are no longer in the buffer
+    bool streamError;   // whether reading from the stream failed
+} celix_json_reader_t;
+
+/**
+ * @brief Initialize a JSON writer.
+ * @param[in] writer The writer to initialize.
+ * @param[in] buffer Optional caller provided initial buffer. Can be NULL.
+ * @param[in] bufferSize The size of the caller provided buffer.
+ */
+CELIX_UTILS_EXPORT void celix_jsonWriter_init(celix_json_writer_t* writer, char* buffer, size_t bufferSize);
+
+/**
+ * @brief Release the heap memory of the writer, if any.
+ */
+CELIX_UTILS_EXPORT void celix_jsonWriter_deinit(celix_json_writer_t* writer);
+
+/**
+ * @brief Set the size of the written data to the provided (smaller) size.
+ */
+CELIX_UTILS_EXPORT void celix_jsonWriter_truncate(celix_json_writer_t* writer, size_t size);
+
+/**
+ * @brief Steal the written data as a '\0' terminated heap string.
+ *
+ * If the data is still in the caller provided buffer, a copy is returned.
+ * @return The written data or NULL if the writer is in an error state or memory allocation failed.
+ */
+CELIX_UTILS_EXPORT char* celix_jsonWriter_steal(celix_json_writer_t* writer, size_t* size);
+
+CELIX_UTILS_EXPORT celix_status_t celix_jsonWriter_writeRaw(celix_json_writer_t* writer, const char* data, size_t len);
+
+CELIX_UTILS_EXPORT celix_status_t celix_jsonWriter_writeChar(celix_json_writer_t* writer, char c);
+
+/**
+ * @brief Write a jansson compatible indent: a newline followed by indent * depth spaces.
+ */
+CELIX_UTILS_EXPORT celix_status_t celix_jsonWriter_writeIndent(celix_json_writer_t* writer, int indent, int depth);
+
+/**
+ * @brief Write a quoted and escaped JSON string.
+ * @return CELIX_SUCCESS, CELIX_ILLEGAL_ARGUMENT if the string is not valid UTF-8 or ENOMEM.
+ */
+CELIX_UTILS_EXPORT celix_status_t celix_jsonWriter_writeString(celix_json_writer_t* writer, const char* str);
+
+CELIX_UTILS_EXPORT celix_status_t celix_jsonWriter_writeInteger(celix_json_writer_t* writer, long long value);
+
+/**
+ * @brief Write a JSON real, formatted as jansson does. NaN and Inf are not supported.
+ */
+CELIX_UTILS_EXPORT celix_status_t celix_jsonWriter_writeReal(celix_json_writer_t* writer, double value);
+
+CELIX_UTILS_EXPORT celix_status_t celix_jsonWriter_writeBool(celix_json_writer_t* writer, bool value);
+
+/**
+ * @brief Write a version as "version<major.minor.micro[.qualifier]>" JSON string.
+ */
+CELIX_UTILS_EXPORT celix_status_t celix_jsonWriter_writeVersion(celix_json_writer_t* writer,
+                                                               const celix_version_t* version);
+
+/**
+ * @brief Initialize a JSON reader for the provided input.
+ */
+CELIX_UTILS_EXPORT void celix_jsonReader_init(celix_json_reader_t* reader, const char* data, size_t size);
+
+/**
+ * @brief Initialize a JSON reader which incrementally reads the input from the provided stream.
+ *
+ * Reading stops at the end of the stream or when reading from the stream fails, in which case streamError is set.
+ * @param[in] reader The reader to initialize.
+ * @param[in] stream The stream to read from.
+ * @param[in] buffer Caller provided buffer used for the stream data, must be at least 8 bytes.
+ * @param[in] bufferSize The size of the caller provided buffer.
+ */
+CELIX_UTILS_EXPORT void
+celix_jsonReader_initStream(celix_json_reader_t* reader, FILE* stream, char* buffer, size_t bufferSize);
+
+/**
+ * @brief Return the position of the reader in the input, e.g. to report where the input is invalid.
+ */
+CELIX_UTILS_EXPORT size_t celix_jsonReader_getPosition(const celix_json_reader_t* reader);
+
+/**
+ * @brief Skip whitespace and return the next character, without consuming it.
+ * @return The next character or -1 if the end of the input is reached.
+ */
+CELIX_UTILS_EXPORT int celix_jsonReader_peek(celix_json_reader_t* reader);
+
+/**
+ * @brief Skip whitespace and consume the next character if it is equal to c.
+ * @return true if the character is consumed.
+ */
+CELIX_UTILS_EXPORT bool celix_jsonReader_consume(celix_json_reader_t* reader, char c);
+
+/**
+ * @brief Skip whitespace and check whether the end of the input is reached.
+ */
+CELIX_UTILS_EXPORT bool celix_jsonReader_isAtEnd(celix_json_reader_t* reader);
+
+/**
+ * @brief Read a JSON string and append the unescaped string to the provided writer.
+ *
+ * Strings containing invalid UTF-8, unescaped control characters or an escaped '\0' are rejected.
+ * @return CELIX_SUCCESS, CELIX_ILLEGAL_ARGUMENT for invalid input or ENOMEM.
+ */
+CELIX_UTILS_EXPORT celix_status_t celix_jsonReader_readString(celix_json_reader_t* reader, celix_json_writer_t* out);
+
+/**
+ * @brief Read a JSON number.
+ *
+ * Numbers without fraction and exponent are integers, other numbers are reals.
+ * Integers which do not fit in a long long and reals which overflow a double are rejected.
+ * @param[out] isInteger Whether the number is an integer.
+ * @param[out] intValue The integer value, if the number is an integer.
+ * @param[out] realValue The real value, if the number is a real.
+ * @return CELIX_SUCCESS or CELIX_ILLEGAL_ARGUMENT for invalid input.
+ */
+CELIX_UTILS_EXPORT celix_status_t
+celix_jsonReader_readNumber(celix_json_reader_t* reader, bool* isInteger, long long* intValue, double* realValue);
+
+/**
+ * @brief Read a JSON true or false literal.
+ */
+CELIX_UTILS_EXPORT celix_status_t celix_jsonReader_readBool(celix_json_reader_t* reader, bool* value);
+
+/**
+ * @brief Read a JSON null literal.
+ */
+CELIX_UTILS_EXPORT celix_status_t celix_jsonReader_readNull(celix_json_reader_t* reader);
+
+/**
+ * @brief Read and discard a JSON value, nested values up to maxDepth levels are supported.
+ */
+CELIX_UTILS_EXPORT celix_status_t celix_jsonReader_skipValue(celix_json_reader_t* reader, int maxDepth);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CELIX_CELIX_JSON_STREAM_INTERNAL_H
@@ -23,6 +23,7 @@
 #include <string.h>
 
 #include "celix_array_list.h"
+#include "celix_array_list_private.h"
 #include "celix_err.h"
 #include "celix_stdlib_cleanup.h"
 #include "celix_utils.h"
@@ -36,6 +37,11 @@
 #define STRING_VALUE_BOOL_EL_TYPE "Bool"
 #define STRING_VALUE_VERSION_EL_TYPE "Version"
 
+/**
+ * Below this number of entries, the typed sort functions use insertion sort.
+ */
+#define CELIX_ARRAY_LIST_INSERTION_SORT_THRESHOLD 16
+
 struct celix_array_list {
     celix_array_list_element_type_t elementType;
     celix_array_list_entry_t* elementData;
@@ -429,7 +435,54 @@ celix_status_t celix_arrayList_assignVersion(celix_array_list_t* list, celix_ver
     return celix_arrayList_addEntry(list, entry);
 }
 
+static int celix_arrayList_indexOfLong(const celix_array_list_t* list, long value) {
+    const celix_array_list_entry_t* entries = list->elementData;
+    size_t i = 0;
+    for (; i + CELIX_ARRAY_LIST_KERNEL_BLOCK_SIZE <= list->size; i += CELIX_ARRAY_LIST_KERNEL_BLOCK_SIZE) {
+        bool found = false;
+        for (size_t j = 0; j < CELIX_ARRAY_LIST_KERNEL_BLOCK_SIZE; ++j) {
+            found |= entries[i + j].longVal == value;
+        }
+        if (found) {
+            break;
+        }
+    }
+    for (; i < list->size; ++i) {
+        if (entries[i].longVal == value) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+static int celix_arrayList_indexOfDouble(const celix_array_list_t* list, double value) {
+    // note: same equality as celix_arrayList_doubleEquals, i.e. neither less nor greater
+    const celix_array_list_entry_t* entries = list->elementData;
+    size_t i = 0;
+    for (; i + CELIX_ARRAY_LIST_KERNEL_BLOCK_SIZE <= list->size; i += CELIX_ARRAY_LIST_KERNEL_BLOCK_SIZE) {
+        bool found = false;
+        for (size_t j = 0; j < CELIX_ARRAY_LIST_KERNEL_BLOCK_SIZE; ++j) {
+            found |= !(entries[i + j].doubleVal < value) & !(entries[i + j].doubleVal > value);
+        }
+        if (found) {
+            break;
+        }
+    }
+    for (; i < list->size; ++i) {
+        if (!(entries[i].doubleVal < value) && !(entries[i].doubleVal > value)) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
 int celix_arrayList_indexOf(celix_array_list_t* list, celix_array_list_entry_t entry) {
+    if (list->equalsCallback == celix_arrayList_longEquals) {
+        return celix_arrayList_indexOfLong(list, entry.longVal);
+    } else if (list->equalsCallback == celix_arrayList_doubleEquals) {
+        return celix_arrayList_indexOfDouble(list, entry.doubleVal);
+    }
+
     size_t size = celix_arrayList_size(list);
     int i;
     int index = -1;
@@ -529,12 +582,181 @@ static int celix_arrayList_compareEntries(const void* voidA, const void* voidB,
     return compare(*a, *b);
 }
 
+static void celix_arrayList_qsortEntries(celix_array_list_entry_t* entries,
+                                         size_t size,
+                                         celix_array_list_compare_entries_fp compare) {
+#if defined(__APPLE__)
+    qsort_r(entries, size, sizeof(celix_array_list_entry_t), compare, celix_arrayList_compareEntries);
+#else
+    qsort_r(entries, size, sizeof(celix_array_list_entry_t), celix_arrayList_compareEntries, compare);
+#endif
+}
+
+/**
+ * @brief Defines a typed sort function for array list entries, which does not use a compare callback per comparison.
+ *
+ * The sort is a quicksort with a median-of-three pivot, insertion sort for small partitions and - if the recursion
+ * depth limit is reached - a fallback to qsort using the provided compare callback.
+ * The partition loops only compare against the pivot value and therefore stay in bounds, also for values that are
+ * unordered (NaN).
+ */
+#define CELIX_ARRAY_LIST_DEFINE_TYPED_SORT(name, field, lessThan, compare)                                            \
+    static void name(celix_array_list_entry_t* entries, size_t size, int depthLimit) {                                 \
+        while (size > CELIX_ARRAY_LIST_INSERTION_SORT_THRESHOLD) {                                                     \
+            if (depthLimit-- == 0) {                                                                                   \
+                celix_arrayList_qsortEntries(entries, size, compare);                                                  \
+                return;                                                                                                \
+            }                                                                                                          \
+            size_t mid = size / 2;                                                                                     \
+            celix_array_list_entry_t tmp;                                                                              \
+            if (lessThan(entries[mid].field, entries[0].field)) {                                                      \
+                tmp = entries[mid], entries[mid] = entries[0], entries[0] = tmp;                                       \
+            }                                                                                                          \
+            if (lessThan(entries[size - 1].field, entries[mid].field)) {                                               \
+                tmp = entries[mid], entries[mid] = entries[size - 1], entries[size - 1] = tmp;                         \
+                if (lessThan(entries[mid].field, entries[0].field)) {                                                  \
+                    tmp = entries[mid], entries[mid] = entries[0], entries[0] = tmp;                                   \
+                }                                                                                                      \
+            }                                                                                                          \
+            celix_array_list_entry_t pivot = entries[mid];                                                             \
+            size_t i = 0;                                                                                              \
+            size_t j = size - 1;                                                                                       \
+            for (;;) {                                                                                                 \
+                while (lessThan(entries[i].field, pivot.field)) {                                                      \
+                    ++i;                                                                                               \
+                }                                                                                                      \
+                while (lessThan(pivot.field, entries[j].field)) {                                                      \
+                    --j;                                                                                               \
+                }                                                                                                      \
+                if (i >= j) {                                                                                          \
+                    break;                                                                                             \
+                }                                                                                                      \
+                tmp = entries[i], entries[i] = entries[j], entries[j] = tmp;                                           \
+                ++i;                                                                                                   \
+                --j;                                                                                                   \
+            }                                                                                                          \
+            /* entries [0, j] are not greater than the pivot, entries (j, size) are not less than the pivot */         \
+            size_t leftSize = j + 1;                                                                                   \
+            if (leftSize < size - leftSize) {                                                                          \
+                name(entries, leftSize, depthLimit);                                                                   \
+                entries += leftSize;                                                                                   \
+                size -= leftSize;                                                                                      \
+            } else {                                                                                                   \
+                name(entries + leftSize, size - leftSize, depthLimit);                                                 \
+                size = leftSize;                                                                                       \
+            }                                                                                                          \
+        }                                                                                                              \
+        for (size_t i = 1; i < size; ++i) {                                                                            \
+            celix_array_list_entry_t current = entries[i];                                                             \
+            size_t j = i;                                                                                              \
+            while (j > 0 && lessThan(current.field, entries[j - 1].field)) {                                           \
+                entries[j] = entries[j - 1];                                                                           \
+                --j;                                                                                                   \
+            }                                                                                                          \
+            entries[j] = current;                                                                                      \
+        }                                                                                                              \
+    }
+
+#define CELIX_ARRAY_LIST_LESS_THAN(a, b) ((a) < (b))
+#define CELIX_ARRAY_LIST_STRING_LESS_THAN(a, b) (strcmp((a), (b)) < 0)
+
+CELIX_ARRAY_LIST_DEFINE_TYPED_SORT(celix_arrayList_sortLongEntries,
+                                   longVal,
+                                   CELIX_ARRAY_LIST_LESS_THAN,
+                                   celix_arrayList_compareLongEntries)
+CELIX_ARRAY_LIST_DEFINE_TYPED_SORT(celix_arrayList_sortDoubleEntries,
+                                   doubleVal,
+                                   CELIX_ARRAY_LIST_LESS_THAN,
+                                   celix_arrayList_compareDoubleEntries)
+CELIX_ARRAY_LIST_DEFINE_TYPED_SORT(celix_arrayList_sortPtrEntries,
+                                   voidPtrVal,
+                                   CELIX_ARRAY_LIST_LESS_THAN,
+                                   celix_arrayList_comparePtrEntries)
+CELIX_ARRAY_LIST_DEFINE_TYPED_SORT(celix_arrayList_sortStringEntries,
+                                   stringVal,
+                                   CELIX_ARRAY_LIST_STRING_LESS_THAN,
+                                   celix_arrayList_compareStringEntries)
+
+static void celix_arrayList_sortBoolEntries(celix_array_list_entry_t* entries, size_t size) {
+    size_t nrOfFalse = 0;
+    for (size_t i = 0; i < size; ++i) {
+        nrOfFalse += !entries[i].boolVal;
+    }
+    for (size_t i = 0; i < size; ++i) {
+        memset(&entries[i], 0, sizeof(celix_array_list_entry_t));
+        entries[i].boolVal = i >= nrOfFalse;
+    }
+}
+
+static int celix_arrayList_sortDepthLimit(size_t size) {
+    int limit = 0;
+    while (size > 1) {
+        size >>= 1;
+        limit += 2;
+    }
+    return limit;
+}
+
 void celix_arrayList_sort(celix_array_list_t* list) {
-    if (list->compareCallback) {
+    int depthLimit = celix_arrayList_sortDepthLimit(list->size);
+    if (list->compareCallback == celix_arrayList_compareLongEntries) {
+        celix_arrayList_sortLongEntries(list->elementData, list->size, depthLimit);
+    } else if (list->compareCallback == celix_arrayList_compareDoubleEntries) {
+        celix_arrayList_sortDoubleEntries(list->elementData, list->size, depthLimit);
+    } else if (list->compareCallback == celix_arrayList_comparePtrEntries) {
+        celix_arrayList_sortPtrEntries(list->elementData, list->size, depthLimit);
+    } else if (list->compareCallback == celix_arrayList_compareStringEntries) {
+        celix_arrayList_sortStringEntries(list->elementData, list->size, depthLimit);
+    } else if (list->compareCallback == celix_arrayList_compareBoolEntries) {
+        celix_arrayList_sortBoolEntries(list->elementData, list->size);
+    } else if (list->compareCallback) {
         celix_arrayList_sortEntries(list, list->compareCallback);
     }
 }
 
+static bool celix_arrayList_longArraysEquals(const celix_array_list_entry_t* a,
+                                             const celix_array_list_entry_t* b,
+                                             size_t size) {
+    size_t i = 0;
+    for (; i + CELIX_ARRAY_LIST_KERNEL_BLOCK_SIZE <= size; i += CELIX_ARRAY_LIST_KERNEL_BLOCK_SIZE) {
+        bool differs = false;
+        for (size_t j = 0; j < CELIX_ARRAY_LIST_KERNEL_BLOCK_SIZE; ++j) {
+            differs |= a[i + j].longVal != b[i + j].longVal;
+        }
+        if (differs) {
+            return false;
+        }
+    }
+    for (; i < size; ++i) {
+        if (a[i].longVal != b[i].longVal) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool celix_arrayList_doubleArraysEquals(const celix_array_list_entry_t* a,
+                                               const celix_array_list_entry_t* b,
+                                               size_t size) {
+    // note: same equality as celix_arrayList_doubleEquals, i.e. neither less nor greater
+    size_t i = 0;
+    for (; i + CELIX_ARRAY_LIST_KERNEL_BLOCK_SIZE <= size; i += CELIX_ARRAY_LIST_KERNEL_BLOCK_SIZE) {
+        bool differs = false;
+        for (size_t j = 0; j < CELIX_ARRAY_LIST_KERNEL_BLOCK_SIZE; ++j) {
+            differs |= (a[i + j].doubleVal < b[i + j].doubleVal) | (a[i + j].doubleVal > b[i + j].doubleVal);
+        }
+        if (differs) {
+            return false;
+        }
+    }
+    for (; i < size; ++i) {
+        if (a[i].doubleVal < b[i].doubleVal || a[i].doubleVal > b[i].doubleVal) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool celix_arrayList_equals(const celix_array_list_t* listA, const celix_array_list_t* listB) {
     if (listA == listB) {
         return true;
@@ -551,6 +773,11 @@ bool celix_arrayList_equals(const celix_array_list_t* listA, const celix_array_l
     if (listA->equalsCallback != listB->equalsCallback) {
         return false;
     }
+    if (listA->equalsCallback == celix_arrayList_longEquals) {
+        return celix_arrayList_longArraysEquals(listA->elementData, listB->elementData, listA->size);
+    } else if (listA->equalsCallback == celix_arrayList_doubleEquals) {
+        return celix_arrayList_doubleArraysEquals(listA->elementData, listB->elementData, listA->size);
+    }
     for (int i = 0; i < listA->size; ++i) {
         if (!listA->equalsCallback(listA->elementData[i], listB->elementData[i])) {
             return false;
@@ -603,11 +830,11 @@ celix_array_list_t* celix_arrayList_copy(const celix_array_list_t* list) {
 }
 
 void celix_arrayList_sortEntries(celix_array_list_t* list, celix_array_list_compare_entries_fp compare) {
-#if defined(__APPLE__)
-    qsort_r(list->elementData, list->size, sizeof(celix_array_list_entry_t), compare, celix_arrayList_compareEntries);
-#else
-    qsort_r(list->elementData, list->size, sizeof(celix_array_list_entry_t), celix_arrayList_compareEntries, compare);
-#endif
+    celix_arrayList_qsortEntries(list->elementData, list->size, compare);
+}
+
+const celix_array_list_entry_t* celix_arrayList_getEntries(const celix_array_list_t* list) {
+    return list->elementData;
 }
 
 const char* celix_arrayList_elementTypeToString(celix_array_list_element_type_t type) {
@@ -354,4 +354,190 @@ celix_status_t celix_arrayList_saveToString(const celix_array_list_t* list,  int
     }
     *out = celix_steal_ptr(buffer);
     return CELIX_SUCCESS;
-}
\ No newline at end of file
+}
+
+static celix_status_t celix_arrayList_elementTypeToBinaryTag(celix_array_list_element_type_t elType, uint8_t* tag) {
+    switch (elType) {
+    case CELIX_ARRAY_LIST_ELEMENT_TYPE_STRING:
+        *tag = CELIX_BINARY_ENCODING_TAG_STRING;
+        break;
+    case CELIX_ARRAY_LIST_ELEMENT_TYPE_LONG:
+        *tag = CELIX_BINARY_ENCODING_TAG_LONG;
+        break;
+    case CELIX_ARRAY_LIST_ELEMENT_TYPE_DOUBLE:
+        *tag = CELIX_BINARY_ENCODING_TAG_DOUBLE;
+        break;
+    case CELIX_ARRAY_LIST_ELEMENT_TYPE_BOOL:
+        *tag = CELIX_BINARY_ENCODING_TAG_BOOL;
+        break;
+    case CELIX_ARRAY_LIST_ELEMENT_TYPE_VERSION:
+        *tag = CELIX_BINARY_ENCODING_TAG_VERSION;
+        break;
+    default:
+        celix_err_pushf("Invalid array list element type %s for binary encoding.",
+                        celix_arrayList_elementTypeToString(elType));
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    return CELIX_SUCCESS;
+}
+
+static celix_status_t celix_arrayList_binaryTagToElementType(uint8_t tag, celix_array_list_element_type_t* elType) {
+    switch (tag) {
+    case CELIX_BINARY_ENCODING_TAG_STRING:
+        *elType = CELIX_ARRAY_LIST_ELEMENT_TYPE_STRING;
+        break;
+    case CELIX_BINARY_ENCODING_TAG_LONG:
+        *elType = CELIX_ARRAY_LIST_ELEMENT_TYPE_LONG;
+        break;
+    case CELIX_BINARY_ENCODING_TAG_DOUBLE:
+        *elType = CELIX_ARRAY_LIST_ELEMENT_TYPE_DOUBLE;
+        break;
+    case CELIX_BINARY_ENCODING_TAG_BOOL:
+        *elType = CELIX_ARRAY_LIST_ELEMENT_TYPE_BOOL;
+        break;
+    case CELIX_BINARY_ENCODING_TAG_VERSION:
+        *elType = CELIX_ARRAY_LIST_ELEMENT_TYPE_VERSION;
+        break;
+    default:
+        celix_err_pushf("Invalid array element type tag %i in binary input.", (int)tag);
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    return CELIX_SUCCESS;
+}
+
+celix_status_t celix_arrayList_writeBinary(const celix_array_list_t* list, celix_binary_writer_t* writer) {
+    assert(list != NULL);
+    assert(writer != NULL);
+    celix_array_list_element_type_t elType = celix_arrayList_getElementType(list);
+    uint8_t tag;
+    celix_status_t status = celix_arrayList_elementTypeToBinaryTag(elType, &tag);
+    status = CELIX_DO_IF(status, celix_binaryWriter_writeByte(writer, tag));
+    size_t size = (size_t)celix_arrayList_size(list);
+    status = CELIX_DO_IF(status, celix_binaryWriter_writeVarUInt(writer, size));
+    for (size_t i = 0; status == CELIX_SUCCESS && i < size; ++i) {
+        celix_array_list_entry_t entry = celix_arrayList_getEntry(list, (int)i);
+        switch (elType) {
+        case CELIX_ARRAY_LIST_ELEMENT_TYPE_STRING:
+            status = celix_binaryWriter_writeString(writer, entry.stringVal);
+            break;
+        case CELIX_ARRAY_LIST_ELEMENT_TYPE_LONG:
+            status = celix_binaryWriter_writeVarInt(writer, entry.longVal);
+            break;
+        case CELIX_ARRAY_LIST_ELEMENT_TYPE_DOUBLE:
+            status = celix_binaryWriter_writeDouble(writer, entry.doubleVal);
+            break;
+        case CELIX_ARRAY_LIST_ELEMENT_TYPE_BOOL:
+            status = celix_binaryWriter_writeByte(writer, entry.boolVal ? 1 : 0);
+            break;
+        default: // CELIX_ARRAY_LIST_ELEMENT_TYPE_VERSION
+            status = celix_binaryWriter_writeVersion(writer, entry.versionVal);
+            break;
+        }
+    }
+    return status;
+}
+
+celix_status_t celix_arrayList_readBinary(celix_binary_reader_t* reader, int decodeFlags, celix_array_list_t** out) {
+    assert(reader != NULL);
+    assert(out != NULL);
+    *out = NULL;
+    uint8_t tag;
+    celix_array_list_element_type_t elType;
+    size_t size;
+    celix_status_t status = celix_binaryReader_readByte(reader, &tag);
+    status = CELIX_DO_IF(status, celix_arrayList_binaryTagToElementType(tag, &elType));
+    status = CELIX_DO_IF(status, celix_binaryReader_readCount(reader, 1, &size));
+    if (status != CELIX_SUCCESS) {
+        return status;
+    }
+    if (size == 0 && (decodeFlags & CELIX_ARRAY_LIST_DECODE_ERROR_ON_EMPTY_ARRAYS)) {
+        celix_err_push("Expected a non-empty binary array.");
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+
+    celix_array_list_create_options_t opts = CELIX_EMPTY_ARRAY_LIST_CREATE_OPTIONS;
+    opts.elementType = elType;
+    opts.initialCapacity = size;
+    celix_autoptr(celix_array_list_t) array = celix_arrayList_createWithOptions(&opts);
+    if (!array) {
+        return ENOMEM;
+    }
+
+    for (size_t i = 0; i < size; ++i) {
+        switch (elType) {
+        case CELIX_ARRAY_LIST_ELEMENT_TYPE_STRING: {
+            const char* str;
+            status = celix_binaryReader_readString(reader, &str);
+            status = CELIX_DO_IF(status, celix_arrayList_addString(array, str));
+            break;
+        }
+        case CELIX_ARRAY_LIST_ELEMENT_TYPE_LONG: {
+            long val;
+            status = celix_binaryReader_readLong(reader, &val);
+            status = CELIX_DO_IF(status, celix_arrayList_addLong(array, val));
+            break;
+        }
+        case CELIX_ARRAY_LIST_ELEMENT_TYPE_DOUBLE: {
+            double val;
+            status = celix_binaryReader_readDouble(reader, &val);
+            status = CELIX_DO_IF(status, celix_arrayList_addDouble(array, val));
+            break;
+        }
+        case CELIX_ARRAY_LIST_ELEMENT_TYPE_BOOL: {
+            uint8_t val;
+            status = celix_binaryReader_readByte(reader, &val);
+            status = CELIX_DO_IF(status, celix_arrayList_addBool(array, val != 0));
+            break;
+        }
+        default: { // CELIX_ARRAY_LIST_ELEMENT_TYPE_VERSION
+            celix_version_t* version;
+            status = celix_binaryReader_readVersion(reader, &version);
+            status = CELIX_DO_IF(status, celix_arrayList_assignVersion(array, version));
+            break;
+        }
+        }
+        if (status != CELIX_SUCCESS) {
+            return status;
+        }
+    }
+    *out = celix_steal_ptr(array);
+    return CELIX_SUCCESS;
+}
+
+celix_status_t celix_arrayList_encodeToBinary(const celix_array_list_t* list, void** out, size_t* outSize) {
+    if (!list || !out || !outSize) {
+        celix_err_push("Invalid arguments.");
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    celix_binary_writer_t writer;
+    celix_binaryWriter_init(&writer);
+    celix_status_t status = celix_binaryWriter_writeHeader(&writer, CELIX_BINARY_ENCODING_ARRAY_LIST_MAGIC);
+    status = CELIX_DO_IF(status, celix_arrayList_writeBinary(list, &writer));
+    if (status != CELIX_SUCCESS) {
+        celix_binaryWriter_deinit(&writer);
+        return status;
+    }
+    *out = celix_binaryWriter_steal(&writer, outSize);
+    return CELIX_SUCCESS;
+}
+
+celix_status_t
+celix_arrayList_decodeFromBinary(const void* input, size_t inputSize, int decodeFlags, celix_array_list_t** out) {
+    if (!input || !out) {
+        celix_err_push("Invalid arguments.");
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    celix_binary_reader_t reader;
+    celix_binaryReader_init(&reader, input, inputSize);
+    celix_autoptr(celix_array_list_t) array = NULL;
+    celix_status_t status = celix_binaryReader_readHeader(&reader, CELIX_BINARY_ENCODING_ARRAY_LIST_MAGIC);
+    status = CELIX_DO_IF(status, celix_arrayList_readBinary(&reader, decodeFlags, &array));
+    if (status == CELIX_SUCCESS && !celix_binaryReader_isAtEnd(&reader)) {
+        celix_err_push("Unexpected trailing data in binary input.");
+        status = CELIX_ILLEGAL_ARGUMENT;
+    }
+    if (status == CELIX_SUCCESS) {
+        *out = celix_steal_ptr(array);
+    }
+    return status;
+}
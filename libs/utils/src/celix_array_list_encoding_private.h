@@ -22,6 +22,7 @@
 
 #include "celix_array_list.h"
 #include "celix_array_list_encoding.h"//import encodeFlags and decodeFlags
+#include "celix_binary_encoding_private.h"
 #include "celix_errno.h"
 
 #include <jansson.h>
@@ -58,6 +59,35 @@ celix_status_t celix_arrayList_encodeToJson(const celix_array_list_t* list, int
  */
 celix_status_t celix_arrayList_decodeFromJson(const json_t* jsonArray, int decodeFlags, celix_array_list_t** out);
 
+/**
+ * @brief Write the provided array list, without binary header, to the binary writer.
+ *
+ * The array is written as an element type tag, followed by the number of elements and the elements.
+ *
+ * If the return status is an error, an error message is logged to celix_err.
+ *
+ * @param list The list to encode. Must be not NULL.
+ * @param writer The binary writer to write to. Must be not NULL.
+ * @return CELIX_SUCCESS if encoding was successful.
+ *      CELIX_ILLEGAL_ARGUMENT if the list element type is not supported.
+ *      ENOMEM if an memory allocation failed.
+ */
+celix_status_t celix_arrayList_writeBinary(const celix_array_list_t* list, celix_binary_writer_t* writer);
+
+/**
+ * @brief Read an array list, written with celix_arrayList_writeBinary, from the binary reader.
+ *
+ * If the return status is an error, an error message is logged to celix_err.
+ *
+ * @param reader The binary reader to read from. Must be not NULL.
+ * @param decodeFlags The flags to use for decoding. See celix_array_list_encoding.h
+ * @param out The resulting array list. Caller is owner. Must be not NULL.
+ * @return CELIX_SUCCESS if decoding was successful.
+ *      CELIX_ILLEGAL_ARGUMENT if the binary input is invalid.
+ *      ENOMEM if an memory allocation failed.
+ */
+celix_status_t celix_arrayList_readBinary(celix_binary_reader_t* reader, int decodeFlags, celix_array_list_t** out);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,47 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef CELIX_CELIX_ARRAY_LIST_PRIVATE_H
+#define CELIX_CELIX_ARRAY_LIST_PRIVATE_H
+
+#include "celix_array_list.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief The number of entries handled per block by the typed array list kernels.
+ *
+ * Inside a block the entries are compared without branching, so that the compiler can vectorize the comparison.
+ */
+#define CELIX_ARRAY_LIST_KERNEL_BLOCK_SIZE 8
+
+/**
+ * @brief Returns the entries of the array list as a contiguous array of celix_arrayList_size(list) entries.
+ *
+ * The returned pointer is invalidated when the array list is modified.
+ */
+const celix_array_list_entry_t* celix_arrayList_getEntries(const celix_array_list_t* list);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CELIX_CELIX_ARRAY_LIST_PRIVATE_H
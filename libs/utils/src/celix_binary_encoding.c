@@ -0,0 +1,295 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "celix_binary_encoding_private.h"
+
+#include <assert.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "celix_err.h"
+#include "celix_utils_private_constants.h"
+
+#define CELIX_BINARY_WRITER_INITIAL_CAPACITY 256
+#define CELIX_BINARY_VARINT_MAX_SIZE 10
+
+void celix_binaryWriter_init(celix_binary_writer_t* writer) {
+    memset(writer, 0, sizeof(*writer));
+    writer->status = CELIX_SUCCESS;
+}
+
+void celix_binaryWriter_deinit(celix_binary_writer_t* writer) {
+    free(writer->data);
+    celix_binaryWriter_init(writer);
+}
+
+uint8_t* celix_binaryWriter_steal(celix_binary_writer_t* writer, size_t* sizeOut) {
+    uint8_t* data = writer->data;
+    *sizeOut = writer->size;
+    celix_binaryWriter_init(writer);
+    return data;
+}
+
+static celix_status_t celix_binaryWriter_reserve(celix_binary_writer_t* writer, size_t extra) {
+    if (writer->status != CELIX_SUCCESS) {
+        return writer->status;
+    }
+    if (writer->size + extra <= writer->capacity) {
+        return CELIX_SUCCESS;
+    }
+    size_t newCapacity = writer->capacity == 0 ? CELIX_BINARY_WRITER_INITIAL_CAPACITY : writer->capacity * 2;
+    while (newCapacity < writer->size + extra) {
+        newCapacity *= 2;
+    }
+    uint8_t* newData = realloc(writer->data, newCapacity);
+    if (!newData) {
+        celix_err_push("Failed to allocate memory for binary encoding buffer.");
+        writer->status = ENOMEM;
+        return ENOMEM;
+    }
+    writer->data = newData;
+    writer->capacity = newCapacity;
+    return CELIX_SUCCESS;
+}
+
+celix_status_t celix_binaryWriter_writeHeader(celix_binary_writer_t* writer, const char* magic) {
+    assert(strlen(magic) == CELIX_BINARY_ENCODING_HEADER_SIZE - 1);
+    celix_status_t status = celix_binaryWriter_reserve(writer, CELIX_BINARY_ENCODING_HEADER_SIZE);
+    if (status == CELIX_SUCCESS) {
+        memcpy(writer->data + writer->size, magic, CELIX_BINARY_ENCODING_HEADER_SIZE - 1);
+        writer->data[writer->size + CELIX_BINARY_ENCODING_HEADER_SIZE - 1] = CELIX_BINARY_ENCODING_VERSION;
+        writer->size += CELIX_BINARY_ENCODING_HEADER_SIZE;
+    }
+    return status;
+}
+
+celix_status_t celix_binaryWriter_writeByte(celix_binary_writer_t* writer, uint8_t value) {
+    celix_status_t status = celix_binaryWriter_reserve(writer, 1);
+    if (status == CELIX_SUCCESS) {
+        writer->data[writer->size++] = value;
+    }
+    return status;
+}
+
+celix_status_t celix_binaryWriter_writeVarUInt(celix_binary_writer_t* writer, uint64_t value) {
+    celix_status_t status = celix_binaryWriter_reserve(writer, CELIX_BINARY_VARINT_MAX_SIZE);
+    if (status == CELIX_SUCCESS) {
+        while (value >= 0x80) {
+            writer->data[writer->size++] = (uint8_t)(value | 0x80);
+            value >>= 7;
+        }
+        writer->data[writer->size++] = (uint8_t)value;
+    }
+    return status;
+}
+
+celix_status_t celix_binaryWriter_writeVarInt(celix_binary_writer_t* writer, int64_t value) {
+    uint64_t zigzag = ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+    return celix_binaryWriter_writeVarUInt(writer, zigzag);
+}
+
+celix_status_t celix_binaryWriter_writeDouble(celix_binary_writer_t* writer, double value) {
+    celix_status_t status = celix_binaryWriter_reserve(writer, sizeof(uint64_t));
+    if (status == CELIX_SUCCESS) {
+        uint64_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        for (size_t i = 0; i < sizeof(bits); ++i) {
+            writer->data[writer->size++] = (uint8_t)(bits >> (i * 8));
+        }
+    }
+    return status;
+}
+
+celix_status_t celix_binaryWriter_writeString(celix_binary_writer_t* writer, const char* str) {
+    size_t len = strnlen(str, CELIX_UTILS_MAX_STRLEN);
+    celix_status_t status = celix_binaryWriter_writeVarUInt(writer, len);
+    status = CELIX_DO_IF(status, celix_binaryWriter_reserve(writer, len + 1));
+    if (status == CELIX_SUCCESS) {
+        memcpy(writer->data + writer->size, str, len);
+        writer->data[writer->size + len] = '\0';
+        writer->size += len + 1;
+    }
+    return status;
+}
+
+celix_status_t celix_binaryWriter_writeVersion(celix_binary_writer_t* writer, const celix_version_t* version) {
+    celix_status_t status = celix_binaryWriter_writeVarInt(writer, celix_version_getMajor(version));
+    status = CELIX_DO_IF(status, celix_binaryWriter_writeVarInt(writer, celix_version_getMinor(version)));
+    status = CELIX_DO_IF(status, celix_binaryWriter_writeVarInt(writer, celix_version_getMicro(version)));
+    status = CELIX_DO_IF(status, celix_binaryWriter_writeString(writer, celix_version_getQualifier(version)));
+    return status;
+}
+
+void celix_binaryReader_init(celix_binary_reader_t* reader, const void* data, size_t size) {
+    reader->data = data;
+    reader->size = size;
+    reader->offset = 0;
+}
+
+static celix_status_t celix_binaryReader_unexpectedEnd(void) {
+    celix_err_push("Unexpected end of binary input.");
+    return CELIX_ILLEGAL_ARGUMENT;
+}
+
+celix_status_t celix_binaryReader_readHeader(celix_binary_reader_t* reader, const char* magic) {
+    if (reader->size - reader->offset < CELIX_BINARY_ENCODING_HEADER_SIZE) {
+        return celix_binaryReader_unexpectedEnd();
+    }
+    const uint8_t* header = reader->data + reader->offset;
+    if (memcmp(header, magic, CELIX_BINARY_ENCODING_HEADER_SIZE - 1) != 0) {
+        celix_err_pushf("Invalid binary input, expected magic '%s'.", magic);
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    if (header[CELIX_BINARY_ENCODING_HEADER_SIZE - 1] != CELIX_BINARY_ENCODING_VERSION) {
+        celix_err_pushf("Unsupported binary encoding version %i, expected version %i.",
+                        (int)header[CELIX_BINARY_ENCODING_HEADER_SIZE - 1],
+                        CELIX_BINARY_ENCODING_VERSION);
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    reader->offset += CELIX_BINARY_ENCODING_HEADER_SIZE;
+    return CELIX_SUCCESS;
+}
+
+celix_status_t celix_binaryReader_readByte(celix_binary_reader_t* reader, uint8_t* out) {
+    if (reader->offset >= reader->size) {
+        return celix_binaryReader_unexpectedEnd();
+    }
+    *out = reader->data[reader->offset++];
+    return CELIX_SUCCESS;
+}
+
+celix_status_t celix_binaryReader_readVarUInt(celix_binary_reader_t* reader, uint64_t* out) {
+    uint64_t result = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (reader->offset >= reader->size) {
+            return celix_binaryReader_unexpectedEnd();
+        }
+        uint8_t byte = reader->data[reader->offset++];
+        result |= (uint64_t)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            *out = result;
+            return CELIX_SUCCESS;
+        }
+    }
+    celix_err_push("Invalid varint in binary input.");
+    return CELIX_ILLEGAL_ARGUMENT;
+}
+
+celix_status_t celix_binaryReader_readVarInt(celix_binary_reader_t* reader, int64_t* out) {
+    uint64_t zigzag;
+    celix_status_t status = celix_binaryReader_readVarUInt(reader, &zigzag);
+    if (status == CELIX_SUCCESS) {
+        *out = (int64_t)(zigzag >> 1) ^ -(int64_t)(zigzag & 1);
+    }
+    return status;
+}
+
+celix_status_t celix_binaryReader_readLong(celix_binary_reader_t* reader, long* out) {
+    int64_t value;
+    celix_status_t status = celix_binaryReader_readVarInt(reader, &value);
+    if (status == CELIX_SUCCESS && (value < LONG_MIN || value > LONG_MAX)) {
+        celix_err_push("Integer in binary input out of range for long.");
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    if (status == CELIX_SUCCESS) {
+        *out = (long)value;
+    }
+    return status;
+}
+
+celix_status_t celix_binaryReader_readInt(celix_binary_reader_t* reader, int* out) {
+    int64_t value;
+    celix_status_t status = celix_binaryReader_readVarInt(reader, &value);
+    if (status == CELIX_SUCCESS && (value < INT_MIN || value > INT_MAX)) {
+        celix_err_push("Integer in binary input out of range for int.");
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    if (status == CELIX_SUCCESS) {
+        *out = (int)value;
+    }
+    return status;
+}
+
+celix_status_t celix_binaryReader_readDouble(celix_binary_reader_t* reader, double* out) {
+    if (reader->size - reader->offset < sizeof(uint64_t)) {
+        return celix_binaryReader_unexpectedEnd();
+    }
+    uint64_t bits = 0;
+    for (size_t i = 0; i < sizeof(bits); ++i) {
+        bits |= (uint64_t)reader->data[reader->offset++] << (i * 8);
+    }
+    memcpy(out, &bits, sizeof(*out));
+    return CELIX_SUCCESS;
+}
+
+celix_status_t celix_binaryReader_readString(celix_binary_reader_t* reader, const char** out) {
+    uint64_t len;
+    celix_status_t status = celix_binaryReader_readVarUInt(reader, &len);
+    if (status != CELIX_SUCCESS) {
+        return status;
+    }
+    if (len >= reader->size - reader->offset) {
+        return celix_binaryReader_unexpectedEnd();
+    }
+    const char* str = (const char*)reader->data + reader->offset;
+    if (str[len] != '\0' || memchr(str, '\0', len) != NULL) {
+        celix_err_push("Invalid string in binary input, expected a single terminating '\\0'.");
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    reader->offset += len + 1;
+    *out = str;
+    return CELIX_SUCCESS;
+}
+
+celix_status_t celix_binaryReader_readVersion(celix_binary_reader_t* reader, celix_version_t** out) {
+    int major, minor, micro;
+    const char* qualifier;
+    celix_status_t status = celix_binaryReader_readInt(reader, &major);
+    status = CELIX_DO_IF(status, celix_binaryReader_readInt(reader, &minor));
+    status = CELIX_DO_IF(status, celix_binaryReader_readInt(reader, &micro));
+    status = CELIX_DO_IF(status, celix_binaryReader_readString(reader, &qualifier));
+    if (status != CELIX_SUCCESS) {
+        return status;
+    }
+    *out = celix_version_create(major, minor, micro, qualifier);
+    if (!*out) {
+        celix_err_push("Invalid version in binary input.");
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    return CELIX_SUCCESS;
+}
+
+celix_status_t celix_binaryReader_readCount(celix_binary_reader_t* reader, size_t minItemSize, size_t* out) {
+    uint64_t count;
+    celix_status_t status = celix_binaryReader_readVarUInt(reader, &count);
+    if (status != CELIX_SUCCESS) {
+        return status;
+    }
+    if (minItemSize > 0 && count > (reader->size - reader->offset) / minItemSize) {
+        celix_err_pushf("Invalid item count %lu in binary input.", (unsigned long)count);
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    *out = (size_t)count;
+    return CELIX_SUCCESS;
+}
+
+bool celix_binaryReader_isAtEnd(const celix_binary_reader_t* reader) {
+    return reader->offset == reader->size;
+}
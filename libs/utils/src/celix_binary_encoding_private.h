@@ -0,0 +1,141 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef CELIX_CELIX_BINARY_ENCODING_PRIVATE_H
+#define CELIX_CELIX_BINARY_ENCODING_PRIVATE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "celix_errno.h"
+#include "celix_version.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file celix_binary_encoding_private.h
+ * @brief Primitives for the compact binary encoding of celix properties and array lists.
+ *
+ * The binary format is little endian and starts with a 4 byte header: a 3 byte magic followed by a format version
+ * byte. Integers are encoded as (zigzag) LEB128 varints, doubles as 8 byte IEEE 754 values, bools as a single 0 or 1
+ * byte and strings as a varint length, followed by the string bytes and a terminating '\0'. The terminating '\0'
+ * ensures that decoded strings can be used in place, without copying them out of the input buffer.
+ */
+
+#define CELIX_BINARY_ENCODING_VERSION 1
+
+#define CELIX_BINARY_ENCODING_PROPERTIES_MAGIC "CPB"
+#define CELIX_BINARY_ENCODING_ARRAY_LIST_MAGIC "CAL"
+#define CELIX_BINARY_ENCODING_HEADER_SIZE 4
+
+/**
+ * @brief Value type tags used in the binary encoding.
+ */
+#define CELIX_BINARY_ENCODING_TAG_STRING 0x01
+#define CELIX_BINARY_ENCODING_TAG_LONG 0x02
+#define CELIX_BINARY_ENCODING_TAG_DOUBLE 0x03
+#define CELIX_BINARY_ENCODING_TAG_BOOL 0x04
+#define CELIX_BINARY_ENCODING_TAG_VERSION 0x05
+#define CELIX_BINARY_ENCODING_TAG_ARRAY 0x06
+
+/**
+ * @brief Growable output buffer for the binary encoding.
+ *
+ * The writer keeps the first error status, so that multiple write calls can be chained and only the final status
+ * needs to be checked.
+ */
+typedef struct celix_binary_writer {
+    uint8_t* data;
+    size_t size;
+    size_t capacity;
+    celix_status_t status;
+} celix_binary_writer_t;
+
+/**
+ * @brief Input view used for decoding the binary encoding. The reader does not own the data.
+ */
+typedef struct celix_binary_reader {
+    const uint8_t* data;
+    size_t size;
+    size_t offset;
+} celix_binary_reader_t;
+
+void celix_binaryWriter_init(celix_binary_writer_t* writer);
+
+/**
+ * @brief Release the writer buffer, unless it is stolen with celix_binaryWriter_steal.
+ */
+void celix_binaryWriter_deinit(celix_binary_writer_t* writer);
+
+/**
+ * @brief Take ownership of the writer buffer. The writer is reset.
+ */
+uint8_t* celix_binaryWriter_steal(celix_binary_writer_t* writer, size_t* sizeOut);
+
+celix_status_t celix_binaryWriter_writeHeader(celix_binary_writer_t* writer, const char* magic);
+celix_status_t celix_binaryWriter_writeByte(celix_binary_writer_t* writer, uint8_t value);
+celix_status_t celix_binaryWriter_writeVarUInt(celix_binary_writer_t* writer, uint64_t value);
+celix_status_t celix_binaryWriter_writeVarInt(celix_binary_writer_t* writer, int64_t value);
+celix_status_t celix_binaryWriter_writeDouble(celix_binary_writer_t* writer, double value);
+celix_status_t celix_binaryWriter_writeString(celix_binary_writer_t* writer, const char* str);
+
+/**
+ * @brief Write a version as major, minor and micro varints, followed by the qualifier string.
+ */
+celix_status_t celix_binaryWriter_writeVersion(celix_binary_writer_t* writer, const celix_version_t* version);
+
+void celix_binaryReader_init(celix_binary_reader_t* reader, const void* data, size_t size);
+
+/**
+ * @brief Read and verify the header. Returns CELIX_ILLEGAL_ARGUMENT if the magic or the format version do not match.
+ */
+celix_status_t celix_binaryReader_readHeader(celix_binary_reader_t* reader, const char* magic);
+celix_status_t celix_binaryReader_readByte(celix_binary_reader_t* reader, uint8_t* out);
+celix_status_t celix_binaryReader_readVarUInt(celix_binary_reader_t* reader, uint64_t* out);
+celix_status_t celix_binaryReader_readVarInt(celix_binary_reader_t* reader, int64_t* out);
+celix_status_t celix_binaryReader_readLong(celix_binary_reader_t* reader, long* out);
+celix_status_t celix_binaryReader_readInt(celix_binary_reader_t* reader, int* out);
+celix_status_t celix_binaryReader_readDouble(celix_binary_reader_t* reader, double* out);
+
+/**
+ * @brief Read a string. The returned string points into the reader input and is '\0' terminated.
+ */
+celix_status_t celix_binaryReader_readString(celix_binary_reader_t* reader, const char** out);
+
+/**
+ * @brief Read a version. The caller is owner of the returned version.
+ */
+celix_status_t celix_binaryReader_readVersion(celix_binary_reader_t* reader, celix_version_t** out);
+
+/**
+ * @brief Read a count (e.g. number of entries or elements), which is sanity checked against the remaining input
+ * using the minimal encoded size of a single item.
+ */
+celix_status_t celix_binaryReader_readCount(celix_binary_reader_t* reader, size_t minItemSize, size_t* out);
+
+bool celix_binaryReader_isAtEnd(const celix_binary_reader_t* reader);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CELIX_CELIX_BINARY_ENCODING_PRIVATE_H
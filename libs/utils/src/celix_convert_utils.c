@@ -22,6 +22,9 @@
 
 #include <assert.h>
 #include <ctype.h>
+#include <float.h>
+#include <limits.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -35,11 +38,41 @@
 #define ESCAPE_CHAR '\\'
 #define SEPARATOR_CHAR ','
 
+/**
+ * The maximum number of significant decimal digits which fit in a uint64_t without overflow.
+ */
+#define CELIX_CONVERT_MAX_FAST_DIGITS 19
+
+/**
+ * The largest power of 10 which is exactly representable as a double.
+ */
+#define CELIX_CONVERT_MAX_EXACT_POW10 22
+
+/**
+ * The largest mantissa, 2^53, which is exactly representable as a double.
+ */
+#define CELIX_CONVERT_MAX_EXACT_MANTISSA (UINT64_C(1) << 53)
+
+static const double CELIX_CONVERT_EXACT_POW10[CELIX_CONVERT_MAX_EXACT_POW10 + 1] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+/**
+ * @brief Whether the character is a whitespace in the C locale.
+ */
+static inline bool celix_utils_isSpace(char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+static inline bool celix_utils_isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
 bool celix_utils_isEndptrEndOfStringOrOnlyContainsWhitespaces(const char* endptr) {
     bool result = false;
     if (endptr != NULL) {
         while (*endptr != '\0') {
-            if (!isspace(*endptr)) {
+            if (!celix_utils_isSpace(*endptr)) {
                 break;
             }
             endptr++;
@@ -49,6 +82,134 @@ bool celix_utils_isEndptrEndOfStringOrOnlyContainsWhitespaces(const char* endptr
     return result;
 }
 
+const char* celix_utils_parseLong(const char* str, long* value, bool* outOfRange) {
+    const char* p = str;
+    while (celix_utils_isSpace(*p)) {
+        p++;
+    }
+    bool negative = *p == '-';
+    if (*p == '-' || *p == '+') {
+        p++;
+    }
+    if (!celix_utils_isDigit(*p)) {
+        *value = 0;
+        *outOfRange = false;
+        return str;
+    }
+
+    // accumulate as unsigned, so that LONG_MIN can be represented
+    unsigned long limit = negative ? (unsigned long)LONG_MAX + 1UL : (unsigned long)LONG_MAX;
+    unsigned long result = 0;
+    bool overflow = false;
+    for (; celix_utils_isDigit(*p); ++p) {
+        unsigned long digit = (unsigned long)(*p - '0');
+        if (result > (limit - digit) / 10) {
+            overflow = true;
+        } else {
+            result = result * 10 + digit;
+        }
+    }
+
+    *outOfRange = overflow;
+    if (overflow) {
+        *value = negative ? LONG_MIN : LONG_MAX;
+    } else if (negative) {
+        *value = result == (unsigned long)LONG_MAX + 1UL ? LONG_MIN : -(long)result;
+    } else {
+        *value = (long)result;
+    }
+    return p;
+}
+
+/**
+ * @brief Try to convert a simple decimal string (e.g. "-1.25", "42" or "1.5e3") to a double without using strtod.
+ *
+ * Only strings for which the result is exactly the same as the strtod result are converted: strings with at most 19
+ * significant digits, a mantissa of at most 2^53 and a decimal exponent of at most 22 (Clinger's fast path).
+ * Leading and trailing whitespaces are allowed.
+ *
+ * @return true if the string was converted, false if strtod should be used instead.
+ */
+static bool celix_utils_tryFastConvertStringToDouble(const char* val, double* out) {
+#if FLT_EVAL_METHOD == 0
+    const char* p = val;
+    while (celix_utils_isSpace(*p)) {
+        p++;
+    }
+    bool negative = *p == '-';
+    if (*p == '-' || *p == '+') {
+        p++;
+    }
+
+    uint64_t mantissa = 0;
+    int nrOfSignificantDigits = 0;
+    int nrOfDigits = 0;
+    int exp10 = 0;
+    for (; celix_utils_isDigit(*p); ++p, ++nrOfDigits) {
+        if (mantissa != 0 || *p != '0') {
+            if (++nrOfSignificantDigits > CELIX_CONVERT_MAX_FAST_DIGITS) {
+                return false;
+            }
+            mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+        }
+    }
+    if (*p == '.') {
+        for (++p; celix_utils_isDigit(*p); ++p, ++nrOfDigits) {
+            if (mantissa != 0 || *p != '0') {
+                if (++nrOfSignificantDigits > CELIX_CONVERT_MAX_FAST_DIGITS) {
+                    return false;
+                }
+                mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+            }
+            exp10--;
+        }
+    }
+    if (nrOfDigits == 0) {
+        return false; // no digits, e.g. "inf", "nan" or ""
+    }
+    if (*p == 'e' || *p == 'E') {
+        p++;
+        bool negativeExp = *p == '-';
+        if (*p == '-' || *p == '+') {
+            p++;
+        }
+        if (!celix_utils_isDigit(*p)) {
+            return false;
+        }
+        int exp = 0;
+        for (; celix_utils_isDigit(*p); ++p) {
+            if (exp > CELIX_CONVERT_MAX_EXACT_POW10 * 100) {
+                return false;
+            }
+            exp = exp * 10 + (*p - '0');
+        }
+        exp10 += negativeExp ? -exp : exp;
+    }
+    if (!celix_utils_isEndptrEndOfStringOrOnlyContainsWhitespaces(p)) {
+        return false;
+    }
+
+    double result;
+    if (mantissa == 0) {
+        result = 0.0;
+    } else if (mantissa > CELIX_CONVERT_MAX_EXACT_MANTISSA || exp10 < -CELIX_CONVERT_MAX_EXACT_POW10 ||
+               exp10 > CELIX_CONVERT_MAX_EXACT_POW10) {
+        return false;
+    } else if (exp10 < 0) {
+        result = (double)mantissa / CELIX_CONVERT_EXACT_POW10[-exp10];
+    } else {
+        result = (double)mantissa * CELIX_CONVERT_EXACT_POW10[exp10];
+    }
+    *out = negative ? -result : result;
+    return true;
+#else
+    // extended precision floating point evaluation can cause double rounding, always use strtod
+    (void)val;
+    (void)out;
+    return false;
+#endif
+}
+
 bool celix_utils_convertStringToBool(const char* val, bool defaultValue, bool* converted) {
     bool result;
     if (converted != NULL) {
@@ -58,7 +219,7 @@ bool celix_utils_convertStringToBool(const char* val, bool defaultValue, bool* c
         return defaultValue;
     }
     const char* p = val;
-    while (isspace(*p)) {
+    while (celix_utils_isSpace(*p)) {
         p++;
     }
     if (strncasecmp("true", p, 4) == 0) {
@@ -84,7 +245,11 @@ double celix_utils_convertStringToDouble(const char* val, double defaultValue, b
     if (converted != NULL) {
         *converted = false;
     }
-    if (val != NULL) {
+    if (val != NULL && celix_utils_tryFastConvertStringToDouble(val, &result)) {
+        if (converted) {
+            *converted = true;
+        }
+    } else if (val != NULL) {
         char* endptr;
         double d = strtod(val, &endptr);
         if (endptr != val && celix_utils_isEndptrEndOfStringOrOnlyContainsWhitespaces(endptr)) {
@@ -103,8 +268,9 @@ long celix_utils_convertStringToLong(const char* val, long defaultValue, bool* c
         *converted = false;
     }
     if (val != NULL) {
-        char* endptr;
-        long l = strtol(val, &endptr, 10);
+        long l;
+        bool outOfRange;
+        const char* endptr = celix_utils_parseLong(val, &l, &outOfRange);
         if (endptr != val && celix_utils_isEndptrEndOfStringOrOnlyContainsWhitespaces(endptr)) {
             result = l;
             if (converted) {
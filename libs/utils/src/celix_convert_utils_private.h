@@ -19,12 +19,29 @@
 
 #ifndef CELIX_CELIX_CONVERT_UTILS_PRIVATE_H
 #define CELIX_CELIX_CONVERT_UTILS_PRIVATE_H
+
+#include <stdbool.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 bool celix_utils_isEndptrEndOfStringOrOnlyContainsWhitespaces(const char* endptr);
 
+/**
+ * @brief Parse a base 10 long from the provided string, with the same semantics as strtol(str, &endptr, 10) in the C
+ * locale, but without using errno or the locale.
+ *
+ * Leading whitespaces and an optional sign are skipped. If the value is out of range, the value is clamped to
+ * LONG_MIN or LONG_MAX and outOfRange is set to true.
+ *
+ * @param[in] str The string to parse. Must be not NULL.
+ * @param[out] value The parsed value.
+ * @param[out] outOfRange Whether the value was out of range.
+ * @return A pointer to the first character after the parsed number or str if no digits were found.
+ */
+const char* celix_utils_parseLong(const char* str, long* value, bool* outOfRange);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,718 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "celix_json_stream_internal.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <locale.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "celix_utils.h"
+
+#define CELIX_JSON_WRITER_INITIAL_CAPACITY 256
+#define CELIX_JSON_MAX_NUMBER_LENGTH 64
+#define CELIX_JSON_MIN_STREAM_BUFFER_SIZE 8
+
+void celix_jsonWriter_init(celix_json_writer_t* writer, char* buffer, size_t bufferSize) {
+    memset(writer, 0, sizeof(*writer));
+    writer->status = CELIX_SUCCESS;
+    if (buffer && bufferSize > 0) {
+        writer->callerBuffer = buffer;
+        writer->data = buffer;
+        writer->capacity = bufferSize;
+        writer->data[0] = '\0';
+    }
+}
+
+void celix_jsonWriter_deinit(celix_json_writer_t* writer) {
+    if (writer->data != writer->callerBuffer) {
+        free(writer->data);
+    }
+    celix_jsonWriter_init(writer, NULL, 0);
+}
+
+void celix_jsonWriter_truncate(celix_json_writer_t* writer, size_t size) {
+    assert(size <= writer->size);
+    writer->size = size;
+    if (writer->data) {
+        writer->data[size] = '\0';
+    }
+}
+
+char* celix_jsonWriter_steal(celix_json_writer_t* writer, size_t* size) {
+    char* result = NULL;
+    if (writer->status == CELIX_SUCCESS && writer->data == writer->callerBuffer) {
+        result = malloc(writer->size + 1);
+        if (result) {
+            memcpy(result, writer->data ? writer->data : "", writer->size);
+            result[writer->size] = '\0';
+        }
+    } else if (writer->status == CELIX_SUCCESS) {
+        result = writer->data;
+        writer->data = NULL;
+    }
+    if (size) {
+        *size = result ? writer->size : 0;
+    }
+    celix_jsonWriter_deinit(writer);
+    return result;
+}
+
+/**
+ * @brief Ensure there is room for extra bytes and a terminating '\0'.
+ */
+static celix_status_t celix_jsonWriter_reserve(celix_json_writer_t* writer, size_t extra) {
+    if (writer->status != CELIX_SUCCESS) {
+        return writer->status;
+    }
+    size_t required = writer->size + extra + 1;
+    if (required <= writer->capacity) {
+        return CELIX_SUCCESS;
+    }
+    size_t newCapacity = writer->capacity < CELIX_JSON_WRITER_INITIAL_CAPACITY ? CELIX_JSON_WRITER_INITIAL_CAPACITY
+                                                                               : writer->capacity * 2;
+    while (newCapacity < required) {
+        newCapacity *= 2;
+    }
+    char* newData;
+    if (writer->data == writer->callerBuffer) {
+        newData = malloc(newCapacity);
+        if (newData && writer->size > 0) {
+            memcpy(newData, writer->data, writer->size);
+        }
+    } else {
+        newData = realloc(writer->data, newCapacity);
+    }
+    if (!newData) {
+        writer->status = ENOMEM;
+        return ENOMEM;
+    }
+    writer->data = newData;
+    writer->capacity = newCapacity;
+    return CELIX_SUCCESS;
+}
+
+celix_status_t celix_jsonWriter_writeRaw(celix_json_writer_t* writer, const char* data, size_t len) {
+    celix_status_t status = celix_jsonWriter_reserve(writer, len);
+    if (status == CELIX_SUCCESS) {
+        memcpy(writer->data + writer->size, data, len);
+        writer->size += len;
+        writer->data[writer->size] = '\0';
+    }
+    return status;
+}
+
+celix_status_t celix_jsonWriter_writeChar(celix_json_writer_t* writer, char c) {
+    celix_status_t status = celix_jsonWriter_reserve(writer, 1);
+    if (status == CELIX_SUCCESS) {
+        writer->data[writer->size++] = c;
+        writer->data[writer->size] = '\0';
+    }
+    return status;
+}
+
+celix_status_t celix_jsonWriter_writeIndent(celix_json_writer_t* writer, int indent, int depth) {
+    size_t spaces = (size_t)indent * (size_t)depth;
+    celix_status_t status = celix_jsonWriter_reserve(writer, spaces + 1);
+    if (status == CELIX_SUCCESS) {
+        writer->data[writer->size++] = '\n';
+        memset(writer->data + writer->size, ' ', spaces);
+        writer->size += spaces;
+        writer->data[writer->size] = '\0';
+    }
+    return status;
+}
+
+/**
+ * @brief Decode a single UTF-8 encoded code point, using the same rules as jansson.
+ * @return The length of the encoded code point or 0 if the input is not valid UTF-8.
+ */
+static size_t celix_json_utf8Decode(const unsigned char* str, size_t len, int32_t* codepoint) {
+    unsigned char first = str[0];
+    size_t count;
+    int32_t value;
+    if (first < 0x80) {
+        *codepoint = first;
+        return 1;
+    } else if (first < 0xC2) {
+        return 0; // continuation byte or overlong 2 byte sequence
+    } else if (first < 0xE0) {
+        count = 2;
+        value = first & 0x1F;
+    } else if (first < 0xF0) {
+        count = 3;
+        value = first & 0x0F;
+    } else if (first < 0xF5) {
+        count = 4;
+        value = first & 0x07;
+    } else {
+        return 0;
+    }
+    if (count > len) {
+        return 0;
+    }
+    for (size_t i = 1; i < count; ++i) {
+        if ((str[i] & 0xC0) != 0x80) {
+            return 0;
+        }
+        value = (value << 6) | (str[i] & 0x3F);
+    }
+    if (value > 0x10FFFF || (value >= 0xD800 && value <= 0xDFFF) || (count == 3 && value < 0x800) ||
+        (count == 4 && value < 0x10000)) {
+        return 0;
+    }
+    *codepoint = value;
+    return count;
+}
+
+celix_status_t celix_jsonWriter_writeString(celix_json_writer_t* writer, const char* str) {
+    celix_status_t status = celix_jsonWriter_writeChar(writer, '"');
+    const unsigned char* pos = (const unsigned char*)str;
+    const unsigned char* run = pos;
+    size_t remaining = strlen(str);
+    while (status == CELIX_SUCCESS && remaining > 0) {
+        int32_t codepoint;
+        size_t len = celix_json_utf8Decode(pos, remaining, &codepoint);
+        if (len == 0) {
+            writer->status = CELIX_ILLEGAL_ARGUMENT;
+            return CELIX_ILLEGAL_ARGUMENT;
+        }
+        if (codepoint == '\\' || codepoint == '"' || codepoint < 0x20) {
+            status = celix_jsonWriter_writeRaw(writer, (const char*)run, pos - run);
+            char seq[8];
+            const char* escaped = seq;
+            switch (codepoint) {
+            case '\\':
+                escaped = "\\\\";
+                break;
+            case '"':
+                escaped = "\\\"";
+                break;
+            case '\b':
+                escaped = "\\b";
+                break;
+            case '\f':
+                escaped = "\\f";
+                break;
+            case '\n':
+                escaped = "\\n";
+                break;
+            case '\r':
+                escaped = "\\r";
+                break;
+            case '\t':
+                escaped = "\\t";
+                break;
+            default:
+                snprintf(seq, sizeof(seq), "\\u%04X", (unsigned int)codepoint);
+                break;
+            }
+            status = CELIX_DO_IF(status, celix_jsonWriter_writeRaw(writer, escaped, strlen(escaped)));
+            run = pos + len;
+        }
+        pos += len;
+        remaining -= len;
+    }
+    status = CELIX_DO_IF(status, celix_jsonWriter_writeRaw(writer, (const char*)run, pos - run));
+    status = CELIX_DO_IF(status, celix_jsonWriter_writeChar(writer, '"'));
+    return status;
+}
+
+celix_status_t celix_jsonWriter_writeInteger(celix_json_writer_t* writer, long long value) {
+    char buf[32];
+    int len = snprintf(buf, sizeof(buf), "%lld", value);
+    return celix_jsonWriter_writeRaw(writer, buf, (size_t)len);
+}
+
+celix_status_t celix_jsonWriter_writeReal(celix_json_writer_t* writer, double value) {
+    assert(!isnan(value) && !isinf(value));
+    char buf[CELIX_JSON_MAX_NUMBER_LENGTH];
+    int rc = snprintf(buf, sizeof(buf), "%.17g", value);
+    if (rc < 0 || (size_t)rc >= sizeof(buf) - 3) {
+        // LCOV_EXCL_START
+        writer->status = CELIX_ILLEGAL_ARGUMENT;
+        return CELIX_ILLEGAL_ARGUMENT;
+        // LCOV_EXCL_STOP
+    }
+    size_t len = (size_t)rc;
+
+    // use '.' as decimal point, regardless of the locale
+    const char* point = localeconv()->decimal_point;
+    if (*point != '.') {
+        char* pos = strchr(buf, *point);
+        if (pos) {
+            *pos = '.';
+        }
+    }
+
+    // ensure the value is read back as real and not as integer
+    if (!strchr(buf, '.') && !strchr(buf, 'e')) {
+        buf[len++] = '.';
+        buf[len++] = '0';
+        buf[len] = '\0';
+    }
+
+    // remove a leading '+' and leading zeros from the exponent
+    char* start = strchr(buf, 'e');
+    if (start) {
+        start++;
+        char* end = start + 1;
+        if (*start == '-') {
+            start++;
+        }
+        while (*end == '0') {
+            end++;
+        }
+        if (end != start) {
+            memmove(start, end, len - (size_t)(end - buf) + 1);
+            len -= (size_t)(end - start);
+        }
+    }
+    return celix_jsonWriter_writeRaw(writer, buf, len);
+}
+
+celix_status_t celix_jsonWriter_writeBool(celix_json_writer_t* writer, bool value) {
+    return value ? celix_jsonWriter_writeRaw(writer, "true", 4) : celix_jsonWriter_writeRaw(writer, "false", 5);
+}
+
+celix_status_t celix_jsonWriter_writeVersion(celix_json_writer_t* writer, const celix_version_t* version) {
+    char buf[64];
+    const char* qualifier = celix_version_getQualifier(version);
+    char* str = celix_utils_writeOrCreateString(buf,
+                                                sizeof(buf),
+                                                "version<%d.%d.%d%s%s>",
+                                                celix_version_getMajor(version),
+                                                celix_version_getMinor(version),
+                                                celix_version_getMicro(version),
+                                                qualifier[0] != '\0' ? "." : "",
+                                                qualifier);
+    celix_auto(celix_utils_string_guard_t) strGuard = celix_utils_stringGuard_init(buf, str);
+    if (!str) {
+        writer->status = ENOMEM;
+        return ENOMEM;
+    }
+    return celix_jsonWriter_writeString(writer, str);
+}
+
+void celix_jsonReader_init(celix_json_reader_t* reader, const char* data, size_t size) {
+    memset(reader, 0, sizeof(*reader));
+    reader->data = data;
+    reader->size = size;
+}
+
+void celix_jsonReader_initStream(celix_json_reader_t* reader, FILE* stream, char* buffer, size_t bufferSize) {
+    assert(bufferSize >= CELIX_JSON_MIN_STREAM_BUFFER_SIZE);
+    memset(reader, 0, sizeof(*reader));
+    reader->data = buffer;
+    reader->stream = stream;
+    reader->buffer = buffer;
+    reader->capacity = bufferSize;
+}
+
+size_t celix_jsonReader_getPosition(const celix_json_reader_t* reader) {
+    return reader->consumed + reader->offset;
+}
+
+/**
+ * @brief Ensure at least len unread bytes are available, refilling the buffer from the stream if needed.
+ *
+ * Refilling moves the unread bytes to the start of the buffer, so pointers into the data are invalidated.
+ * @return true if len bytes are available.
+ */
+static bool celix_jsonReader_ensure(celix_json_reader_t* reader, size_t len) {
+    if (reader->size - reader->offset >= len) {
+        return true;
+    } else if (!reader->stream) {
+        return false;
+    }
+    assert(len <= reader->capacity);
+    size_t remaining = reader->size - reader->offset;
+    memmove(reader->buffer, reader->data + reader->offset, remaining);
+    reader->consumed += reader->offset;
+    reader->offset = 0;
+    reader->size = remaining;
+    while (reader->size < len) {
+        size_t read = fread(reader->buffer + reader->size, 1, reader->capacity - reader->size, reader->stream);
+        if (read == 0) {
+            reader->streamError = !feof(reader->stream);
+            reader->stream = NULL;
+            return false;
+        }
+        reader->size += read;
+    }
+    return true;
+}
+
+/**
+ * @brief Return the next character, without skipping whitespace and without consuming it.
+ * @return The next character or -1 if the end of the input is reached.
+ */
+static int celix_jsonReader_current(celix_json_reader_t* reader) {
+    return celix_jsonReader_ensure(reader, 1) ? (unsigned char)reader->data[reader->offset] : -1;
+}
+
+static void celix_jsonReader_skipWhitespace(celix_json_reader_t* reader) {
+    for (;;) {
+        int c = celix_jsonReader_current(reader);
+        if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+            break;
+        }
+        reader->offset++;
+    }
+}
+
+int celix_jsonReader_peek(celix_json_reader_t* reader) {
+    celix_jsonReader_skipWhitespace(reader);
+    return celix_jsonReader_current(reader);
+}
+
+bool celix_jsonReader_consume(celix_json_reader_t* reader, char c) {
+    if (celix_jsonReader_peek(reader) == (unsigned char)c) {
+        reader->offset++;
+        return true;
+    }
+    return false;
+}
+
+bool celix_jsonReader_isAtEnd(celix_json_reader_t* reader) {
+    return celix_jsonReader_peek(reader) == -1;
+}
+
+static int celix_jsonReader_readHex4(celix_json_reader_t* reader, int32_t* value) {
+    if (!celix_jsonReader_ensure(reader, 4)) {
+        return -1;
+    }
+    int32_t result = 0;
+    for (int i = 0; i < 4; ++i) {
+        char c = reader->data[reader->offset + i];
+        result <<= 4;
+        if (c >= '0' && c <= '9') {
+            result |= c - '0';
+        } else if (c >= 'a' && c <= 'f') {
+            result |= c - 'a' + 10;
+        } else if (c >= 'A' && c <= 'F') {
+            result |= c - 'A' + 10;
+        } else {
+            return -1;
+        }
+    }
+    reader->offset += 4;
+    *value = result;
+    return 0;
+}
+
+static celix_status_t celix_jsonReader_readEscapedCodepoint(celix_json_reader_t* reader, celix_json_writer_t* out) {
+    int32_t codepoint;
+    if (celix_jsonReader_readHex4(reader, &codepoint) != 0) {
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    if (codepoint >= 0xD800 && codepoint <= 0xDBFF) {
+        int32_t low;
+        if (!celix_jsonReader_ensure(reader, 2) || reader->data[reader->offset] != '\\' ||
+            reader->data[reader->offset + 1] != 'u') {
+            return CELIX_ILLEGAL_ARGUMENT;
+        }
+        reader->offset += 2;
+        if (celix_jsonReader_readHex4(reader, &low) != 0 || low < 0xDC00 || low > 0xDFFF) {
+            return CELIX_ILLEGAL_ARGUMENT;
+        }
+        codepoint = (((codepoint & 0x3FF) << 10) | (low & 0x3FF)) + 0x10000;
+    } else if ((codepoint >= 0xDC00 && codepoint <= 0xDFFF) || codepoint == 0) {
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+
+    char buf[4];
+    size_t len;
+    if (codepoint < 0x80) {
+        buf[0] = (char)codepoint;
+        len = 1;
+    } else if (codepoint < 0x800) {
+        buf[0] = (char)(0xC0 | (codepoint >> 6));
+        buf[1] = (char)(0x80 | (codepoint & 0x3F));
+        len = 2;
+    } else if (codepoint < 0x10000) {
+        buf[0] = (char)(0xE0 | (codepoint >> 12));
+        buf[1] = (char)(0x80 | ((codepoint >> 6) & 0x3F));
+        buf[2] = (char)(0x80 | (codepoint & 0x3F));
+        len = 3;
+    } else {
+        buf[0] = (char)(0xF0 | (codepoint >> 18));
+        buf[1] = (char)(0x80 | ((codepoint >> 12) & 0x3F));
+        buf[2] = (char)(0x80 | ((codepoint >> 6) & 0x3F));
+        buf[3] = (char)(0x80 | (codepoint & 0x3F));
+        len = 4;
+    }
+    return celix_jsonWriter_writeRaw(out, buf, len);
+}
+
+celix_status_t celix_jsonReader_readString(celix_json_reader_t* reader, celix_json_writer_t* out) {
+    if (!celix_jsonReader_consume(reader, '"')) {
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    // unescaped runs are written at once, the pending run is written before the buffer is refilled
+    size_t runStart = reader->offset;
+    celix_status_t status;
+    for (;;) {
+        if (reader->offset >= reader->size) {
+            status = celix_jsonWriter_writeRaw(out, reader->data + runStart, reader->offset - runStart);
+            if (status != CELIX_SUCCESS) {
+                return status;
+            } else if (!celix_jsonReader_ensure(reader, 1)) {
+                return CELIX_ILLEGAL_ARGUMENT; // unterminated string
+            }
+            runStart = reader->offset;
+        }
+        unsigned char c = (unsigned char)reader->data[reader->offset];
+        if (c == '"' || c == '\\') {
+            status = celix_jsonWriter_writeRaw(out, reader->data + runStart, reader->offset - runStart);
+            reader->offset++;
+            if (status != CELIX_SUCCESS || c == '"') {
+                return status;
+            }
+            if (!celix_jsonReader_ensure(reader, 1)) {
+                return CELIX_ILLEGAL_ARGUMENT;
+            }
+            char escaped = reader->data[reader->offset++];
+            switch (escaped) {
+            case '"':
+            case '\\':
+            case '/':
+                status = celix_jsonWriter_writeChar(out, escaped);
+                break;
+            case 'b':
+                status = celix_jsonWriter_writeChar(out, '\b');
+                break;
+            case 'f':
+                status = celix_jsonWriter_writeChar(out, '\f');
+                break;
+            case 'n':
+                status = celix_jsonWriter_writeChar(out, '\n');
+                break;
+            case 'r':
+                status = celix_jsonWriter_writeChar(out, '\r');
+                break;
+            case 't':
+                status = celix_jsonWriter_writeChar(out, '\t');
+                break;
+            case 'u':
+                status = celix_jsonReader_readEscapedCodepoint(reader, out);
+                break;
+            default:
+                return CELIX_ILLEGAL_ARGUMENT;
+            }
+            if (status != CELIX_SUCCESS) {
+                return status;
+            }
+            runStart = reader->offset;
+        } else if (c < 0x20) {
+            return CELIX_ILLEGAL_ARGUMENT;
+        } else if (c < 0x80) {
+            reader->offset++;
+        } else {
+            if (reader->stream && reader->size - reader->offset < 4) {
+                // make sure a multibyte sequence is not split by the end of the buffer
+                status = celix_jsonWriter_writeRaw(out, reader->data + runStart, reader->offset - runStart);
+                if (status != CELIX_SUCCESS) {
+                    return status;
+                }
+                (void)celix_jsonReader_ensure(reader, 4);
+                runStart = reader->offset;
+            }
+            int32_t codepoint;
+            size_t len = celix_json_utf8Decode(
+                (const unsigned char*)reader->data + reader->offset, reader->size - reader->offset, &codepoint);
+            if (len == 0) {
+                return CELIX_ILLEGAL_ARGUMENT;
+            }
+            reader->offset += len;
+        }
+    }
+}
+
+static bool celix_jsonReader_isDigit(celix_json_reader_t* reader) {
+    int c = celix_jsonReader_current(reader);
+    return c >= '0' && c <= '9';
+}
+
+/**
+ * @brief Move the next character of a number to the provided number buffer.
+ * @return false if the number is too long.
+ */
+static bool celix_jsonReader_takeNumberChar(celix_json_reader_t* reader, char* buf, size_t* len) {
+    if (*len + 1 >= CELIX_JSON_MAX_NUMBER_LENGTH) {
+        return false;
+    }
+    buf[(*len)++] = reader->data[reader->offset++];
+    return true;
+}
+
+static bool celix_jsonReader_takeDigits(celix_json_reader_t* reader, char* buf, size_t* len) {
+    while (celix_jsonReader_isDigit(reader)) {
+        if (!celix_jsonReader_takeNumberChar(reader, buf, len)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+celix_status_t
+celix_jsonReader_readNumber(celix_json_reader_t* reader, bool* isInteger, long long* intValue, double* realValue) {
+    char buf[CELIX_JSON_MAX_NUMBER_LENGTH];
+    size_t len = 0;
+    celix_jsonReader_skipWhitespace(reader);
+    if (celix_jsonReader_current(reader) == '-') {
+        (void)celix_jsonReader_takeNumberChar(reader, buf, &len);
+    }
+    if (!celix_jsonReader_isDigit(reader)) {
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    if (celix_jsonReader_current(reader) == '0') {
+        (void)celix_jsonReader_takeNumberChar(reader, buf, &len);
+        if (celix_jsonReader_isDigit(reader)) {
+            return CELIX_ILLEGAL_ARGUMENT; // leading zeros are not allowed
+        }
+    } else if (!celix_jsonReader_takeDigits(reader, buf, &len)) {
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+
+    bool integer = true;
+    if (celix_jsonReader_current(reader) == '.') {
+        integer = false;
+        if (!celix_jsonReader_takeNumberChar(reader, buf, &len) || !celix_jsonReader_isDigit(reader) ||
+            !celix_jsonReader_takeDigits(reader, buf, &len)) {
+            return CELIX_ILLEGAL_ARGUMENT;
+        }
+    }
+    int c = celix_jsonReader_current(reader);
+    if (c == 'e' || c == 'E') {
+        integer = false;
+        if (!celix_jsonReader_takeNumberChar(reader, buf, &len)) {
+            return CELIX_ILLEGAL_ARGUMENT;
+        }
+        c = celix_jsonReader_current(reader);
+        if ((c == '+' || c == '-') && !celix_jsonReader_takeNumberChar(reader, buf, &len)) {
+            return CELIX_ILLEGAL_ARGUMENT;
+        }
+        if (!celix_jsonReader_isDigit(reader) || !celix_jsonReader_takeDigits(reader, buf, &len)) {
+            return CELIX_ILLEGAL_ARGUMENT;
+        }
+    }
+    buf[len] = '\0';
+
+    char* end;
+    errno = 0;
+    *isInteger = integer;
+    if (integer) {
+        *intValue = strtoll(buf, &end, 10);
+        if (errno == ERANGE) {
+            return CELIX_ILLEGAL_ARGUMENT;
+        }
+    } else {
+        *realValue = strtod(buf, &end);
+        if (errno == ERANGE && (*realValue == HUGE_VAL || *realValue == -HUGE_VAL)) {
+            return CELIX_ILLEGAL_ARGUMENT;
+        }
+    }
+    // a mismatch is possible if the decimal point of the locale is not '.'
+    return end == buf + len ? CELIX_SUCCESS : CELIX_ILLEGAL_ARGUMENT;
+}
+
+static celix_status_t celix_jsonReader_readLiteral(celix_json_reader_t* reader, const char* literal, size_t len) {
+    celix_jsonReader_skipWhitespace(reader);
+    if (!celix_jsonReader_ensure(reader, len) || memcmp(reader->data + reader->offset, literal, len) != 0) {
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    reader->offset += len;
+    return CELIX_SUCCESS;
+}
+
+celix_status_t celix_jsonReader_readBool(celix_json_reader_t* reader, bool* value) {
+    if (celix_jsonReader_peek(reader) == 't') {
+        *value = true;
+        return celix_jsonReader_readLiteral(reader, "true", 4);
+    }
+    *value = false;
+    return celix_jsonReader_readLiteral(reader, "false", 5);
+}
+
+celix_status_t celix_jsonReader_readNull(celix_json_reader_t* reader) {
+    return celix_jsonReader_readLiteral(reader, "null", 4);
+}
+
+celix_status_t celix_jsonReader_skipValue(celix_json_reader_t* reader, int maxDepth) {
+    int c = celix_jsonReader_peek(reader);
+    if ((c == '{' || c == '[') && maxDepth <= 0) {
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    celix_status_t status = CELIX_SUCCESS;
+    if (c == '{') {
+        reader->offset++;
+        if (celix_jsonReader_consume(reader, '}')) {
+            return CELIX_SUCCESS;
+        }
+        char buf[128];
+        celix_json_writer_t scratch;
+        celix_jsonWriter_init(&scratch, buf, sizeof(buf));
+        do {
+            celix_jsonWriter_truncate(&scratch, 0);
+            status = celix_jsonReader_readString(reader, &scratch);
+            if (status == CELIX_SUCCESS && !celix_jsonReader_consume(reader, ':')) {
+                status = CELIX_ILLEGAL_ARGUMENT;
+            }
+            status = CELIX_DO_IF(status, celix_jsonReader_skipValue(reader, maxDepth - 1));
+        } while (status == CELIX_SUCCESS && celix_jsonReader_consume(reader, ','));
+        celix_jsonWriter_deinit(&scratch);
+        if (status == CELIX_SUCCESS && !celix_jsonReader_consume(reader, '}')) {
+            status = CELIX_ILLEGAL_ARGUMENT;
+        }
+    } else if (c == '[') {
+        reader->offset++;
+        if (celix_jsonReader_consume(reader, ']')) {
+            return CELIX_SUCCESS;
+        }
+        do {
+            status = celix_jsonReader_skipValue(reader, maxDepth - 1);
+        } while (status == CELIX_SUCCESS && celix_jsonReader_consume(reader, ','));
+        if (status == CELIX_SUCCESS && !celix_jsonReader_consume(reader, ']')) {
+            status = CELIX_ILLEGAL_ARGUMENT;
+        }
+    } else if (c == '"') {
+        char buf[128];
+        celix_json_writer_t scratch;
+        celix_jsonWriter_init(&scratch, buf, sizeof(buf));
+        status = celix_jsonReader_readString(reader, &scratch);
+        celix_jsonWriter_deinit(&scratch);
+    } else if (c == 't' || c == 'f') {
+        bool value;
+        status = celix_jsonReader_readBool(reader, &value);
+    } else if (c == 'n') {
+        status = celix_jsonReader_readNull(reader);
+    } else {
+        bool isInteger;
+        long long intValue;
+        double realValue;
+        status = celix_jsonReader_readNumber(reader, &isInteger, &intValue, &realValue);
+    }
+    return status;
+}
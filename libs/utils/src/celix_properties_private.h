@@ -43,6 +43,14 @@ celix_properties_entry_t* celix_properties_allocEntry(celix_properties_t* proper
  */
 char* celix_properties_createString(celix_properties_t* properties, const char* str);
 
+/**
+ * @brief Configure a read-only buffer from which strings are used as-is, instead of being copied.
+ *
+ * Keys and string values that are set and are located in the provided buffer are not copied and not freed by the
+ * properties. The buffer must outlive the properties and must not be modified.
+ */
+void celix_properties_setBorrowedStringBuffer(celix_properties_t* properties, const void* buffer, size_t bufferSize);
+
 #ifdef __cplusplus
 }
 #endif
@@ -24,6 +24,7 @@
 #include <string.h>
 #include <celix_utils.h>
 
+#include "celix_array_list_private.h"
 #include "celix_convert_utils.h"
 #include "celix_err.h"
 #include "celix_errno.h"
@@ -618,26 +619,90 @@ static bool celix_utils_convertCompareToBool(enum celix_filter_operand_enum op,
     }
 }
 
+/**
+ * Defines a function which returns whether any array list entry matches the provided match expression, using `x` as
+ * the entry value and `value` as the attribute value.
+ * The entries are matched per block without branching, so that the compiler can vectorize the match expression.
+ */
+#define CELIX_FILTER_DEFINE_ANY_ENTRY_MATCH(name, type, field, matchExpr)                                              \
+    static bool name(const celix_array_list_entry_t* entries, size_t size, type value) {                               \
+        size_t i = 0;                                                                                                  \
+        for (; i + CELIX_ARRAY_LIST_KERNEL_BLOCK_SIZE <= size; i += CELIX_ARRAY_LIST_KERNEL_BLOCK_SIZE) {              \
+            bool match = false;                                                                                        \
+            for (size_t j = 0; j < CELIX_ARRAY_LIST_KERNEL_BLOCK_SIZE; ++j) {                                          \
+                type x = entries[i + j].field;                                                                         \
+                match |= (matchExpr);                                                                                  \
+            }                                                                                                          \
+            if (match) {                                                                                               \
+                return true;                                                                                           \
+            }                                                                                                          \
+        }                                                                                                              \
+        for (; i < size; ++i) {                                                                                        \
+            type x = entries[i].field;                                                                                 \
+            if (matchExpr) {                                                                                           \
+                return true;                                                                                           \
+            }                                                                                                          \
+        }                                                                                                              \
+        return false;                                                                                                  \
+    }
+
+CELIX_FILTER_DEFINE_ANY_ENTRY_MATCH(celix_filter_anyLongEqual, long, longVal, x == value)
+CELIX_FILTER_DEFINE_ANY_ENTRY_MATCH(celix_filter_anyLongGreater, long, longVal, x > value)
+CELIX_FILTER_DEFINE_ANY_ENTRY_MATCH(celix_filter_anyLongGreaterEqual, long, longVal, x >= value)
+CELIX_FILTER_DEFINE_ANY_ENTRY_MATCH(celix_filter_anyLongLess, long, longVal, x < value)
+CELIX_FILTER_DEFINE_ANY_ENTRY_MATCH(celix_filter_anyLongLessEqual, long, longVal, x <= value)
+
+// note: the double match expressions are based on celix_filter_cmpDouble, which returns 0 for unordered values (NaN)
+CELIX_FILTER_DEFINE_ANY_ENTRY_MATCH(celix_filter_anyDoubleEqual, double, doubleVal, !(x < value) & !(x > value))
+CELIX_FILTER_DEFINE_ANY_ENTRY_MATCH(celix_filter_anyDoubleGreater, double, doubleVal, x > value)
+CELIX_FILTER_DEFINE_ANY_ENTRY_MATCH(celix_filter_anyDoubleGreaterEqual, double, doubleVal, !(x < value))
+CELIX_FILTER_DEFINE_ANY_ENTRY_MATCH(celix_filter_anyDoubleLess, double, doubleVal, x < value)
+CELIX_FILTER_DEFINE_ANY_ENTRY_MATCH(celix_filter_anyDoubleLessEqual, double, doubleVal, !(x > value))
+
 static bool celix_utils_matchLongArrays(enum celix_filter_operand_enum op, const celix_array_list_t* list, long attributeValue) {
     assert(list != NULL);
-    for (int i = 0 ; i < celix_arrayList_size(list); ++i) {
-        int cmp = celix_filter_cmpLong(celix_arrayList_getLong(list, i), attributeValue);
-        if (celix_utils_convertCompareToBool(op, cmp)) {
-            return true;
-        }
+    const celix_array_list_entry_t* entries = celix_arrayList_getEntries(list);
+    size_t size = (size_t)celix_arrayList_size(list);
+    switch (op) {
+    case CELIX_FILTER_OPERAND_EQUAL:
+        return celix_filter_anyLongEqual(entries, size, attributeValue);
+    case CELIX_FILTER_OPERAND_GREATER:
+        return celix_filter_anyLongGreater(entries, size, attributeValue);
+    case CELIX_FILTER_OPERAND_GREATEREQUAL:
+        return celix_filter_anyLongGreaterEqual(entries, size, attributeValue);
+    case CELIX_FILTER_OPERAND_LESS:
+        return celix_filter_anyLongLess(entries, size, attributeValue);
+    case CELIX_FILTER_OPERAND_LESSEQUAL:
+        return celix_filter_anyLongLessEqual(entries, size, attributeValue);
+    //LCOV_EXCL_START
+    default:
+        assert(false);
+        return false;
+    //LCOV_EXCL_STOP
     }
-    return false;
 }
 
 static bool celix_utils_matchDoubleArrays(enum celix_filter_operand_enum op, const celix_array_list_t* list, double attributeValue) {
     assert(list != NULL);
-    for (int i = 0 ; i < celix_arrayList_size(list); ++i) {
-        int cmp = celix_filter_cmpDouble(celix_arrayList_getDouble(list, i), attributeValue);
-        if (celix_utils_convertCompareToBool(op, cmp)) {
-            return true;
-        }
+    const celix_array_list_entry_t* entries = celix_arrayList_getEntries(list);
+    size_t size = (size_t)celix_arrayList_size(list);
+    switch (op) {
+    case CELIX_FILTER_OPERAND_EQUAL:
+        return celix_filter_anyDoubleEqual(entries, size, attributeValue);
+    case CELIX_FILTER_OPERAND_GREATER:
+        return celix_filter_anyDoubleGreater(entries, size, attributeValue);
+    case CELIX_FILTER_OPERAND_GREATEREQUAL:
+        return celix_filter_anyDoubleGreaterEqual(entries, size, attributeValue);
+    case CELIX_FILTER_OPERAND_LESS:
+        return celix_filter_anyDoubleLess(entries, size, attributeValue);
+    case CELIX_FILTER_OPERAND_LESSEQUAL:
+        return celix_filter_anyDoubleLessEqual(entries, size, attributeValue);
+    //LCOV_EXCL_START
+    default:
+        assert(false);
+        return false;
+    //LCOV_EXCL_STOP
     }
-    return false;
 }
 
 
@@ -72,8 +72,27 @@ struct celix_properties {
      * The current string buffer index.
      */
     int currentEntriesBufferIndex;
+
+    /**
+     * Optional read-only buffer from which strings are used without copying them, e.g. a binary encoded properties
+     * input buffer. See celix_properties_setBorrowedStringBuffer.
+     */
+    const char* borrowedStringBuffer;
+
+    /**
+     * The size of the borrowed string buffer.
+     */
+    size_t borrowedStringBufferSize;
 };
 
+/**
+ * Returns whether the provided str is located in the borrowed string buffer of the properties.
+ */
+static bool celix_properties_isBorrowedString(const celix_properties_t* properties, const char* str) {
+    return properties->borrowedStringBuffer != NULL && str >= properties->borrowedStringBuffer &&
+           str < (properties->borrowedStringBuffer + properties->borrowedStringBufferSize);
+}
+
 /**
  * Create a new string from the provided str by either using strdup or storing the string the short properties
  * optimization string buffer.
@@ -82,6 +101,9 @@ char* celix_properties_createString(celix_properties_t* properties, const char*
     if (str == NULL) {
         return (char*)CELIX_PROPERTIES_EMPTY_STRVAL;
     }
+    if (celix_properties_isBorrowedString(properties, str)) {
+        return (char*)str;
+    }
     size_t len = strnlen(str, CELIX_UTILS_MAX_STRLEN) + 1;
     size_t left = CELIX_PROPERTIES_OPTIMIZATION_STRING_BUFFER_SIZE - properties->currentStringBufferIndex;
     char* result;
@@ -105,6 +127,8 @@ static void celix_properties_freeString(celix_properties_t* properties, char* st
     } else if (str >= properties->stringBuffer &&
                str < (properties->stringBuffer + CELIX_PROPERTIES_OPTIMIZATION_STRING_BUFFER_SIZE)) {
         // str is part of the properties string buffer -> nop
+    } else if (celix_properties_isBorrowedString(properties, str)) {
+        // str is part of the borrowed string buffer -> nop
     } else {
         free(str);
     }
@@ -309,6 +333,8 @@ celix_properties_t* celix_properties_create() {
         props->map = celix_stringHashMap_createWithOptions(&opts);
         props->currentStringBufferIndex = 0;
         props->currentEntriesBufferIndex = 0;
+        props->borrowedStringBuffer = NULL;
+        props->borrowedStringBufferSize = 0;
         if (props->map == NULL) {
             free(props);
             props = NULL;
@@ -319,6 +345,11 @@ celix_properties_t* celix_properties_create() {
     return props;
 }
 
+void celix_properties_setBorrowedStringBuffer(celix_properties_t* properties, const void* buffer, size_t bufferSize) {
+    properties->borrowedStringBuffer = buffer;
+    properties->borrowedStringBufferSize = bufferSize;
+}
+
 void celix_properties_destroy(celix_properties_t* props) {
     if (props != NULL) {
         celix_stringHashMap_destroy(props->map);
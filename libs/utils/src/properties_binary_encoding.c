@@ -0,0 +1,204 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "celix_properties.h"
+#include "celix_properties_private.h"
+
+#include "celix_array_list_encoding_private.h"
+#include "celix_binary_encoding_private.h"
+#include "celix_err.h"
+#include "celix_stdlib_cleanup.h"
+
+#include <assert.h>
+
+/**
+ * Minimal encoded size of a properties entry: empty key (length + '\0') and a type tag followed by a 1 byte value.
+ */
+#define CELIX_PROPERTIES_BINARY_MIN_ENTRY_SIZE 4
+
+static celix_status_t celix_properties_writeBinaryEntry(celix_binary_writer_t* writer,
+                                                        const char* key,
+                                                        const celix_properties_entry_t* entry) {
+    celix_status_t status = celix_binaryWriter_writeString(writer, key);
+    switch (entry->valueType) {
+    case CELIX_PROPERTIES_VALUE_TYPE_STRING:
+        status = CELIX_DO_IF(status, celix_binaryWriter_writeByte(writer, CELIX_BINARY_ENCODING_TAG_STRING));
+        status = CELIX_DO_IF(status, celix_binaryWriter_writeString(writer, entry->typed.strValue));
+        break;
+    case CELIX_PROPERTIES_VALUE_TYPE_LONG:
+        status = CELIX_DO_IF(status, celix_binaryWriter_writeByte(writer, CELIX_BINARY_ENCODING_TAG_LONG));
+        status = CELIX_DO_IF(status, celix_binaryWriter_writeVarInt(writer, entry->typed.longValue));
+        break;
+    case CELIX_PROPERTIES_VALUE_TYPE_DOUBLE:
+        status = CELIX_DO_IF(status, celix_binaryWriter_writeByte(writer, CELIX_BINARY_ENCODING_TAG_DOUBLE));
+        status = CELIX_DO_IF(status, celix_binaryWriter_writeDouble(writer, entry->typed.doubleValue));
+        break;
+    case CELIX_PROPERTIES_VALUE_TYPE_BOOL:
+        status = CELIX_DO_IF(status, celix_binaryWriter_writeByte(writer, CELIX_BINARY_ENCODING_TAG_BOOL));
+        status = CELIX_DO_IF(status, celix_binaryWriter_writeByte(writer, entry->typed.boolValue ? 1 : 0));
+        break;
+    case CELIX_PROPERTIES_VALUE_TYPE_VERSION:
+        status = CELIX_DO_IF(status, celix_binaryWriter_writeByte(writer, CELIX_BINARY_ENCODING_TAG_VERSION));
+        status = CELIX_DO_IF(status, celix_binaryWriter_writeVersion(writer, entry->typed.versionValue));
+        break;
+    case CELIX_PROPERTIES_VALUE_TYPE_ARRAY_LIST:
+        status = CELIX_DO_IF(status, celix_binaryWriter_writeByte(writer, CELIX_BINARY_ENCODING_TAG_ARRAY));
+        status = CELIX_DO_IF(status, celix_arrayList_writeBinary(entry->typed.arrayValue, writer));
+        break;
+    default:
+        // LCOV_EXCL_START
+        celix_err_pushf("Unexpected properties entry type %d.", entry->valueType);
+        return CELIX_ILLEGAL_ARGUMENT;
+        // LCOV_EXCL_STOP
+    }
+    if (status != CELIX_SUCCESS) {
+        celix_err_pushf("Failed to encode properties entry with key '%s'.", key);
+    }
+    return status;
+}
+
+celix_status_t celix_properties_encodeToBinary(const celix_properties_t* properties, void** out, size_t* outSize) {
+    if (!properties || !out || !outSize) {
+        celix_err_push("Invalid arguments.");
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    celix_binary_writer_t writer;
+    celix_binaryWriter_init(&writer);
+    celix_status_t status = celix_binaryWriter_writeHeader(&writer, CELIX_BINARY_ENCODING_PROPERTIES_MAGIC);
+    status = CELIX_DO_IF(status, celix_binaryWriter_writeVarUInt(&writer, celix_properties_size(properties)));
+    CELIX_PROPERTIES_ITERATE(properties, iter) {
+        status = CELIX_DO_IF(status, celix_properties_writeBinaryEntry(&writer, iter.key, &iter.entry));
+    }
+    if (status != CELIX_SUCCESS) {
+        celix_binaryWriter_deinit(&writer);
+        return status;
+    }
+    *out = celix_binaryWriter_steal(&writer, outSize);
+    return CELIX_SUCCESS;
+}
+
+static celix_status_t
+celix_properties_readBinaryEntry(celix_binary_reader_t* reader, celix_properties_t* props, int decodeFlags) {
+    const char* key;
+    uint8_t tag;
+    celix_status_t status = celix_binaryReader_readString(reader, &key);
+    status = CELIX_DO_IF(status, celix_binaryReader_readByte(reader, &tag));
+    if (status != CELIX_SUCCESS) {
+        return status;
+    }
+
+    if (key[0] == '\0' && (decodeFlags & CELIX_PROPERTIES_DECODE_ERROR_ON_EMPTY_KEYS)) {
+        celix_err_push("Key cannot be empty.");
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    if ((decodeFlags & CELIX_PROPERTIES_DECODE_ERROR_ON_DUPLICATES) && celix_properties_hasKey(props, key)) {
+        celix_err_pushf("Invalid duplicate key '%s'.", key);
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+
+    switch (tag) {
+    case CELIX_BINARY_ENCODING_TAG_STRING: {
+        const char* value;
+        status = celix_binaryReader_readString(reader, &value);
+        status = CELIX_DO_IF(status, celix_properties_setString(props, key, value));
+        break;
+    }
+    case CELIX_BINARY_ENCODING_TAG_LONG: {
+        long value;
+        status = celix_binaryReader_readLong(reader, &value);
+        status = CELIX_DO_IF(status, celix_properties_setLong(props, key, value));
+        break;
+    }
+    case CELIX_BINARY_ENCODING_TAG_DOUBLE: {
+        double value;
+        status = celix_binaryReader_readDouble(reader, &value);
+        status = CELIX_DO_IF(status, celix_properties_setDouble(props, key, value));
+        break;
+    }
+    case CELIX_BINARY_ENCODING_TAG_BOOL: {
+        uint8_t value;
+        status = celix_binaryReader_readByte(reader, &value);
+        status = CELIX_DO_IF(status, celix_properties_setBool(props, key, value != 0));
+        break;
+    }
+    case CELIX_BINARY_ENCODING_TAG_VERSION: {
+        celix_version_t* version;
+        status = celix_binaryReader_readVersion(reader, &version);
+        status = CELIX_DO_IF(status, celix_properties_assignVersion(props, key, version));
+        break;
+    }
+    case CELIX_BINARY_ENCODING_TAG_ARRAY: {
+        int decodeArrayFlags = 0;
+        if (decodeFlags & CELIX_PROPERTIES_DECODE_ERROR_ON_EMPTY_ARRAYS) {
+            decodeArrayFlags |= CELIX_ARRAY_LIST_DECODE_ERROR_ON_EMPTY_ARRAYS;
+        }
+        celix_array_list_t* array;
+        status = celix_arrayList_readBinary(reader, decodeArrayFlags, &array);
+        status = CELIX_DO_IF(status, celix_properties_assignArrayList(props, key, array));
+        break;
+    }
+    default:
+        celix_err_pushf("Invalid value type tag %i in binary input.", (int)tag);
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    if (status != CELIX_SUCCESS) {
+        celix_err_pushf("Failed to decode properties entry with key '%s'.", key);
+    }
+    return status;
+}
+
+celix_status_t
+celix_properties_decodeFromBinary(const void* input, size_t inputSize, int decodeFlags, celix_properties_t** out) {
+    if (!input || !out) {
+        celix_err_push("Invalid arguments.");
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+    *out = NULL;
+
+    celix_binary_reader_t reader;
+    celix_binaryReader_init(&reader, input, inputSize);
+    size_t count;
+    celix_status_t status = celix_binaryReader_readHeader(&reader, CELIX_BINARY_ENCODING_PROPERTIES_MAGIC);
+    status = CELIX_DO_IF(status, celix_binaryReader_readCount(&reader, CELIX_PROPERTIES_BINARY_MIN_ENTRY_SIZE, &count));
+    if (status != CELIX_SUCCESS) {
+        return status;
+    }
+
+    celix_autoptr(celix_properties_t) props = celix_properties_create();
+    if (!props) {
+        return ENOMEM;
+    }
+    if (decodeFlags & CELIX_PROPERTIES_DECODE_NO_COPY) {
+        celix_properties_setBorrowedStringBuffer(props, input, inputSize);
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        status = celix_properties_readBinaryEntry(&reader, props, decodeFlags);
+        if (status != CELIX_SUCCESS) {
+            return status;
+        }
+    }
+    if (!celix_binaryReader_isAtEnd(&reader)) {
+        celix_err_push("Unexpected trailing data in binary input.");
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+
+    *out = celix_steal_ptr(props);
+    return CELIX_SUCCESS;
+}
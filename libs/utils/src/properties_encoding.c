@@ -24,7 +24,9 @@
 #include "celix_stdlib_cleanup.h"
 #include "celix_utils.h"
 #include "celix_array_list_encoding_private.h"
+#include "celix_json_stream_internal.h"
 #include "celix_json_utils_private.h"
+#include "celix_string_hash_map.h"
 
 #include <assert.h>
 #include <jansson.h>
@@ -32,9 +34,9 @@
 #include <string.h>
 
 #define CELIX_PROPERTIES_JSONPATH_SEPARATOR '.'
-
-static celix_status_t
-celix_properties_decodeValue(celix_properties_t* props, const char* key, json_t* jsonValue, int flags);
+#define CELIX_PROPERTIES_JSON_INDENT 2
+#define CELIX_PROPERTIES_JSON_MAX_DEPTH 64
+#define CELIX_PROPERTIES_JSON_BUFFER_SIZE 512
 
 static celix_status_t celix_properties_arrayEntryValueToJson(const char* key,
                                                              const celix_properties_entry_t* entry,
@@ -186,7 +188,153 @@ static celix_status_t celix_properties_addPropertiesEntryToJson(const celix_prop
     return celix_properties_addJsonValueToJson(value, fieldName, jsonObj, flags);
 }
 
-celix_status_t celix_properties_saveToStream(const celix_properties_t* properties, FILE* stream, int encodeFlags) {
+/**
+ * @brief Determine whether an entry is left out of the JSON output (NaN/Inf doubles and effectively empty arrays).
+ * @return CELIX_SUCCESS or CELIX_ILLEGAL_ARGUMENT if the entry cannot be encoded with the current encode flags.
+ */
+static celix_status_t
+celix_properties_isJsonEntrySkipped(const celix_properties_entry_t* entry, int flags, bool* skipped) {
+    *skipped = false;
+    if (entry->valueType == CELIX_PROPERTIES_VALUE_TYPE_DOUBLE) {
+        if (isnan(entry->typed.doubleValue) || isinf(entry->typed.doubleValue)) {
+            *skipped = true;
+            return (flags & CELIX_PROPERTIES_ENCODE_ERROR_ON_NAN_INF) ? CELIX_ILLEGAL_ARGUMENT : CELIX_SUCCESS;
+        }
+    } else if (entry->valueType == CELIX_PROPERTIES_VALUE_TYPE_ARRAY_LIST) {
+        const celix_array_list_t* list = entry->typed.arrayValue;
+        int size = celix_arrayList_size(list);
+        int nrOfValues = size;
+        if (celix_arrayList_getElementType(list) == CELIX_ARRAY_LIST_ELEMENT_TYPE_DOUBLE) {
+            for (int i = 0; i < size; ++i) {
+                double value = celix_arrayList_getDouble(list, i);
+                if (isnan(value) || isinf(value)) {
+                    if (flags & CELIX_PROPERTIES_ENCODE_ERROR_ON_NAN_INF) {
+                        return CELIX_ILLEGAL_ARGUMENT;
+                    }
+                    nrOfValues--;
+                }
+            }
+        }
+        if (nrOfValues == 0) {
+            *skipped = true;
+            return (flags & CELIX_PROPERTIES_ENCODE_ERROR_ON_EMPTY_ARRAYS) ? CELIX_ILLEGAL_ARGUMENT : CELIX_SUCCESS;
+        }
+    }
+    return CELIX_SUCCESS;
+}
+
+static celix_status_t
+celix_properties_writeJsonArray(celix_json_writer_t* writer, const celix_array_list_t* list, int indent) {
+    celix_array_list_element_type_t elType = celix_arrayList_getElementType(list);
+    int size = celix_arrayList_size(list);
+    bool first = true;
+    celix_status_t status = celix_jsonWriter_writeChar(writer, '[');
+    for (int i = 0; i < size && status == CELIX_SUCCESS; ++i) {
+        celix_array_list_entry_t entry = celix_arrayList_getEntry(list, i);
+        if (elType == CELIX_ARRAY_LIST_ELEMENT_TYPE_DOUBLE && (isnan(entry.doubleVal) || isinf(entry.doubleVal))) {
+            continue; // ignore NaN and Inf
+        }
+        if (!first) {
+            status = celix_jsonWriter_writeChar(writer, ',');
+        }
+        if (indent > 0) {
+            status = CELIX_DO_IF(status, celix_jsonWriter_writeIndent(writer, indent, 2));
+        }
+        first = false;
+        switch (elType) {
+        case CELIX_ARRAY_LIST_ELEMENT_TYPE_STRING:
+            status = CELIX_DO_IF(status, celix_jsonWriter_writeString(writer, entry.stringVal));
+            break;
+        case CELIX_ARRAY_LIST_ELEMENT_TYPE_LONG:
+            status = CELIX_DO_IF(status, celix_jsonWriter_writeInteger(writer, entry.longVal));
+            break;
+        case CELIX_ARRAY_LIST_ELEMENT_TYPE_DOUBLE:
+            status = CELIX_DO_IF(status, celix_jsonWriter_writeReal(writer, entry.doubleVal));
+            break;
+        case CELIX_ARRAY_LIST_ELEMENT_TYPE_BOOL:
+            status = CELIX_DO_IF(status, celix_jsonWriter_writeBool(writer, entry.boolVal));
+            break;
+        case CELIX_ARRAY_LIST_ELEMENT_TYPE_VERSION:
+            status = CELIX_DO_IF(status, celix_jsonWriter_writeVersion(writer, entry.versionVal));
+            break;
+        default:
+            return CELIX_ILLEGAL_ARGUMENT; // LCOV_EXCL_LINE
+        }
+    }
+    if (indent > 0) {
+        status = CELIX_DO_IF(status, celix_jsonWriter_writeIndent(writer, indent, 1));
+    }
+    return CELIX_DO_IF(status, celix_jsonWriter_writeChar(writer, ']'));
+}
+
+static celix_status_t
+celix_properties_writeJsonValue(celix_json_writer_t* writer, const celix_properties_entry_t* entry, int indent) {
+    switch (entry->valueType) {
+    case CELIX_PROPERTIES_VALUE_TYPE_STRING:
+        return celix_jsonWriter_writeString(writer, entry->value);
+    case CELIX_PROPERTIES_VALUE_TYPE_LONG:
+        return celix_jsonWriter_writeInteger(writer, entry->typed.longValue);
+    case CELIX_PROPERTIES_VALUE_TYPE_DOUBLE:
+        return celix_jsonWriter_writeReal(writer, entry->typed.doubleValue);
+    case CELIX_PROPERTIES_VALUE_TYPE_BOOL:
+        return celix_jsonWriter_writeBool(writer, entry->typed.boolValue);
+    case CELIX_PROPERTIES_VALUE_TYPE_VERSION:
+        return celix_jsonWriter_writeVersion(writer, entry->typed.versionValue);
+    case CELIX_PROPERTIES_VALUE_TYPE_ARRAY_LIST:
+        return celix_properties_writeJsonArray(writer, entry->typed.arrayValue, indent);
+    default:
+        return CELIX_ILLEGAL_ARGUMENT; // LCOV_EXCL_LINE
+    }
+}
+
+/**
+ * @brief Write the properties as JSON text, without creating a jansson json_t tree.
+ *
+ * The output is identical to the output of the jansson based encoder. Only the flat style is supported; the nested
+ * style is supported if no key contains a path separator, because then the flat and nested output are the same.
+ * No errors are logged. If CELIX_ILLEGAL_ARGUMENT is returned, the jansson based encoder should be used to encode
+ * the properties and report the error.
+ */
+static celix_status_t
+celix_properties_writeJson(const celix_properties_t* properties, int encodeFlags, celix_json_writer_t* writer) {
+    if (!(encodeFlags & CELIX_PROPERTIES_ENCODE_FLAT_STYLE) && (encodeFlags & CELIX_PROPERTIES_ENCODE_NESTED_STYLE)) {
+        CELIX_PROPERTIES_ITERATE(properties, iter) {
+            if (strchr(iter.key, CELIX_PROPERTIES_JSONPATH_SEPARATOR)) {
+                return CELIX_ILLEGAL_ARGUMENT;
+            }
+        }
+    }
+
+    int indent = (encodeFlags & CELIX_PROPERTIES_ENCODE_PRETTY) ? CELIX_PROPERTIES_JSON_INDENT : 0;
+    bool first = true;
+    celix_status_t status = celix_jsonWriter_writeChar(writer, '{');
+    CELIX_PROPERTIES_ITERATE(properties, iter) {
+        bool skipped;
+        status = CELIX_DO_IF(status, celix_properties_isJsonEntrySkipped(&iter.entry, encodeFlags, &skipped));
+        if (status != CELIX_SUCCESS) {
+            return status;
+        } else if (skipped) {
+            continue;
+        }
+        if (!first) {
+            status = celix_jsonWriter_writeChar(writer, ',');
+        }
+        if (indent > 0) {
+            status = CELIX_DO_IF(status, celix_jsonWriter_writeIndent(writer, indent, 1));
+        }
+        first = false;
+        status = CELIX_DO_IF(status, celix_jsonWriter_writeString(writer, iter.key));
+        status = CELIX_DO_IF(status, celix_jsonWriter_writeRaw(writer, indent > 0 ? ": " : ":", indent > 0 ? 2 : 1));
+        status = CELIX_DO_IF(status, celix_properties_writeJsonValue(writer, &iter.entry, indent));
+    }
+    if (!first && indent > 0) {
+        status = CELIX_DO_IF(status, celix_jsonWriter_writeIndent(writer, indent, 0));
+    }
+    return CELIX_DO_IF(status, celix_jsonWriter_writeChar(writer, '}'));
+}
+
+static celix_status_t
+celix_properties_saveToStreamUsingJansson(const celix_properties_t* properties, FILE* stream, int encodeFlags) {
     json_auto_t* root = json_object();
     if (!root) {
         celix_err_push("Failed to create json object");
@@ -224,6 +372,29 @@ celix_status_t celix_properties_saveToStream(const celix_properties_t* propertie
     return CELIX_SUCCESS;
 }
 
+celix_status_t celix_properties_saveToStream(const celix_properties_t* properties, FILE* stream, int encodeFlags) {
+    char buf[CELIX_PROPERTIES_JSON_BUFFER_SIZE];
+    celix_json_writer_t writer;
+    celix_jsonWriter_init(&writer, buf, sizeof(buf));
+    celix_status_t status = celix_properties_writeJson(properties, encodeFlags, &writer);
+    if (status == CELIX_ILLEGAL_ARGUMENT) {
+        celix_jsonWriter_deinit(&writer);
+        return celix_properties_saveToStreamUsingJansson(properties, stream, encodeFlags);
+    } else if (status != CELIX_SUCCESS) {
+        celix_jsonWriter_deinit(&writer);
+        celix_err_push("Failed to encode properties to json.");
+        return status;
+    }
+    size_t written = fwrite(writer.data, 1, writer.size, stream);
+    bool complete = written == writer.size;
+    celix_jsonWriter_deinit(&writer);
+    if (!complete) {
+        celix_err_push("Failed to dump json object to stream.");
+        return CELIX_FILE_IO_EXCEPTION;
+    }
+    return CELIX_SUCCESS;
+}
+
 celix_status_t celix_properties_save(const celix_properties_t* properties, const char* filename, int encodeFlags) {
     FILE* stream = fopen(filename, "w");
     if (!stream) {
@@ -241,6 +412,19 @@ celix_status_t celix_properties_save(const celix_properties_t* properties, const
 
 celix_status_t celix_properties_saveToString(const celix_properties_t* properties, int encodeFlags, char** out) {
     *out = NULL;
+    celix_json_writer_t writer;
+    celix_jsonWriter_init(&writer, NULL, 0);
+    celix_status_t status = celix_properties_writeJson(properties, encodeFlags, &writer);
+    if (status == CELIX_SUCCESS) {
+        *out = celix_jsonWriter_steal(&writer, NULL);
+        return CELIX_SUCCESS;
+    }
+    celix_jsonWriter_deinit(&writer);
+    if (status != CELIX_ILLEGAL_ARGUMENT) {
+        celix_err_push("Failed to encode properties to json.");
+        return status;
+    }
+
     celix_autofree char* buffer = NULL;
     size_t size = 0;
     FILE* stream = open_memstream(&buffer, &size);
@@ -249,7 +433,7 @@ celix_status_t celix_properties_saveToString(const celix_properties_t* propertie
         return ENOMEM;
     }
 
-    celix_status_t status = celix_properties_saveToStream(properties, stream, encodeFlags);
+    status = celix_properties_saveToStream(properties, stream, encodeFlags);
     (void)fclose(stream);
     if (!buffer || status != CELIX_SUCCESS) {
         if (!buffer || status == CELIX_FILE_IO_EXCEPTION) {
@@ -261,132 +445,334 @@ celix_status_t celix_properties_saveToString(const celix_properties_t* propertie
     return CELIX_SUCCESS;
 }
 
-static celix_status_t
-celix_properties_decodeArray(celix_properties_t* props, const char* key, const json_t* jsonArray, int flags) {
-    int decodeArrayFlags = 0;
-    if (flags & CELIX_PROPERTIES_DECODE_ERROR_ON_EMPTY_ARRAYS) {
-        decodeArrayFlags |= CELIX_ARRAY_LIST_DECODE_ERROR_ON_EMPTY_ARRAYS;
-    }
-    if (flags & CELIX_PROPERTIES_DECODE_ERROR_ON_UNSUPPORTED_ARRAYS) {
-        decodeArrayFlags |= CELIX_ARRAY_LIST_DECODE_ERROR_ON_UNSUPPORTED_ARRAYS;
-    }
-    celix_autoptr(celix_array_list_t) array = NULL;
-    celix_status_t status = celix_arrayList_decodeFromJson(jsonArray, decodeArrayFlags, &array);
-    if (status != CELIX_SUCCESS) {
-        celix_err_pushf("Failed to decode array list for key '%s'.", key);
-        return status;
-    }
-    if (array == NULL) {
-        // ignore empty arrays or mixed type arrays
-        return CELIX_SUCCESS;
+/**
+ * @brief State of the streaming JSON decoder.
+ *
+ * Values are added to the properties in document order while parsing, so for duplicate and colliding keys the last
+ * value wins. The member names of the JSON objects are only tracked if duplicates or collisions must be detected.
+ */
+typedef struct celix_properties_json_decoder {
+    celix_json_reader_t* reader;
+    celix_properties_t* props;
+    int flags;
+    celix_json_writer_t key;   // full (nested) key of the current value
+    celix_json_writer_t value; // buffer for the current string value
+} celix_properties_json_decoder_t;
+
+static celix_status_t celix_properties_readJsonValue(celix_properties_json_decoder_t* decoder, int depth, bool duplicate);
+
+static bool celix_properties_isJsonVersionString(const celix_json_writer_t* str) {
+    return str->size > 8 && strncmp(str->data, "version<", 8) == 0 && str->data[str->size - 1] == '>';
+}
+
+static celix_status_t celix_properties_parseJsonVersionString(celix_properties_json_decoder_t* decoder,
+                                                              celix_version_t** out) {
+    celix_json_writer_t* str = &decoder->value;
+    str->data[str->size - 1] = '\0'; // strip the trailing '>'
+    celix_status_t status = celix_version_tryParse(str->data + 8, out);
+    str->data[str->size - 1] = '>';
+    if (status == CELIX_ILLEGAL_ARGUMENT) {
+        celix_err_pushf("Invalid version '%s' for key '%s'.", str->data, decoder->key.data);
     }
-    return celix_properties_assignArrayList(props, key, celix_steal_ptr(array));
+    return status;
 }
 
-static celix_status_t
-celix_properties_decodeValue(celix_properties_t* props, const char* key, json_t* jsonValue, int flags) {
-    if (strncmp(key, "", 1) == 0) {
-        if (flags & CELIX_PROPERTIES_DECODE_ERROR_ON_EMPTY_KEYS) {
-            celix_err_push("Key cannot be empty.");
-            return CELIX_ILLEGAL_ARGUMENT;
+static celix_status_t celix_properties_convertToDoubleArrayList(celix_array_list_t** list) {
+    celix_autoptr(celix_array_list_t) doubles = celix_arrayList_createDoubleArray();
+    if (!doubles) {
+        return ENOMEM;
+    }
+    int size = celix_arrayList_size(*list);
+    for (int i = 0; i < size; ++i) {
+        celix_status_t status = celix_arrayList_addDouble(doubles, (double)celix_arrayList_getLong(*list, i));
+        if (status != CELIX_SUCCESS) {
+            return status;
         }
     }
+    celix_arrayList_destroy(*list);
+    *list = celix_steal_ptr(doubles);
+    return CELIX_SUCCESS;
+}
 
-    if (!json_is_object(jsonValue) && celix_properties_hasKey(props, key) &&
-        (flags & CELIX_PROPERTIES_DECODE_ERROR_ON_COLLISIONS)) {
-        celix_err_pushf("Invalid key collision. Key '%s' already exists.", key);
-        return CELIX_ILLEGAL_ARGUMENT;
+/**
+ * @brief Read a JSON array element and add it to the list, using the same element type rules as
+ * celix_arrayList_decodeFromJson. If the element type does not match the list, supported is set to false.
+ */
+static celix_status_t celix_properties_readJsonArrayElement(celix_properties_json_decoder_t* decoder,
+                                                            celix_array_list_t** list,
+                                                            bool* supported) {
+    celix_array_list_element_type_t elType =
+        *list ? celix_arrayList_getElementType(*list) : CELIX_ARRAY_LIST_ELEMENT_TYPE_UNDEFINED;
+    celix_status_t status;
+    int c = celix_jsonReader_peek(decoder->reader);
+    if (c == '"') {
+        celix_jsonWriter_truncate(&decoder->value, 0);
+        status = celix_jsonReader_readString(decoder->reader, &decoder->value);
+        if (status != CELIX_SUCCESS) {
+            return status;
+        }
+        bool isVersion = celix_properties_isJsonVersionString(&decoder->value);
+        if (elType == CELIX_ARRAY_LIST_ELEMENT_TYPE_UNDEFINED) {
+            *list = isVersion ? celix_arrayList_createVersionArray() : celix_arrayList_createStringArray();
+            elType = isVersion ? CELIX_ARRAY_LIST_ELEMENT_TYPE_VERSION : CELIX_ARRAY_LIST_ELEMENT_TYPE_STRING;
+        }
+        if (!*list) {
+            return ENOMEM;
+        } else if (elType == CELIX_ARRAY_LIST_ELEMENT_TYPE_STRING) {
+            return celix_arrayList_addString(*list, decoder->value.data);
+        } else if (elType == CELIX_ARRAY_LIST_ELEMENT_TYPE_VERSION && isVersion) {
+            celix_version_t* version;
+            status = celix_properties_parseJsonVersionString(decoder, &version);
+            return CELIX_DO_IF(status, celix_arrayList_assignVersion(*list, version));
+        }
+    } else if (c == 't' || c == 'f') {
+        bool value;
+        status = celix_jsonReader_readBool(decoder->reader, &value);
+        if (status != CELIX_SUCCESS) {
+            return status;
+        }
+        if (elType == CELIX_ARRAY_LIST_ELEMENT_TYPE_UNDEFINED) {
+            *list = celix_arrayList_createBoolArray();
+            elType = CELIX_ARRAY_LIST_ELEMENT_TYPE_BOOL;
+        }
+        if (!*list) {
+            return ENOMEM;
+        } else if (elType == CELIX_ARRAY_LIST_ELEMENT_TYPE_BOOL) {
+            return celix_arrayList_addBool(*list, value);
+        }
+    } else if (c == '-' || (c >= '0' && c <= '9')) {
+        bool isInteger;
+        long long intValue;
+        double realValue;
+        status = celix_jsonReader_readNumber(decoder->reader, &isInteger, &intValue, &realValue);
+        if (status != CELIX_SUCCESS) {
+            return status;
+        }
+        if (elType == CELIX_ARRAY_LIST_ELEMENT_TYPE_UNDEFINED) {
+            *list = isInteger ? celix_arrayList_createLongArray() : celix_arrayList_createDoubleArray();
+            elType = isInteger ? CELIX_ARRAY_LIST_ELEMENT_TYPE_LONG : CELIX_ARRAY_LIST_ELEMENT_TYPE_DOUBLE;
+        } else if (elType == CELIX_ARRAY_LIST_ELEMENT_TYPE_LONG && !isInteger) {
+            // mixed integer and real, promote to real
+            status = celix_properties_convertToDoubleArrayList(list);
+            if (status != CELIX_SUCCESS) {
+                return status;
+            }
+            elType = CELIX_ARRAY_LIST_ELEMENT_TYPE_DOUBLE;
+        }
+        if (!*list) {
+            return ENOMEM;
+        } else if (elType == CELIX_ARRAY_LIST_ELEMENT_TYPE_LONG) {
+            return celix_arrayList_addLong(*list, (long)intValue);
+        } else if (elType == CELIX_ARRAY_LIST_ELEMENT_TYPE_DOUBLE) {
+            return celix_arrayList_addDouble(*list, isInteger ? (double)intValue : realValue);
+        }
+    } else {
+        // null, object or nested array
+        status = celix_jsonReader_skipValue(decoder->reader, CELIX_PROPERTIES_JSON_MAX_DEPTH);
+        if (status != CELIX_SUCCESS) {
+            return status;
+        }
     }
+    *supported = false;
+    return CELIX_SUCCESS;
+}
 
+static celix_status_t celix_properties_readJsonArray(celix_properties_json_decoder_t* decoder) {
+    celix_autoptr(celix_array_list_t) list = NULL;
+    bool supported = true;
     celix_status_t status = CELIX_SUCCESS;
-    if (celix_utils_isVersionJsonString(jsonValue)) {
-        celix_version_t* version;
-        status = celix_utils_jsonToVersion(jsonValue, &version);
-        status = CELIX_DO_IF(status, celix_properties_assignVersion(props, key, version));
-    } else if (json_is_string(jsonValue)) {
-        status = celix_properties_setString(props, key, json_string_value(jsonValue));
-    } else if (json_is_integer(jsonValue)) {
-        status = celix_properties_setLong(props, key, json_integer_value(jsonValue));
-    } else if (json_is_real(jsonValue)) {
-        status = celix_properties_setDouble(props, key, json_real_value(jsonValue));
-    } else if (json_is_boolean(jsonValue)) {
-        status = celix_properties_setBool(props, key, json_boolean_value(jsonValue));
-    } else if (json_is_object(jsonValue)) {
-        const char* fieldName;
-        json_t* fieldValue;
-        json_object_foreach(jsonValue, fieldName, fieldValue) {
-            char buf[64];
-            char* combinedKey = celix_utils_writeOrCreateString(buf, sizeof(buf), "%s%c%s", key, CELIX_PROPERTIES_JSONPATH_SEPARATOR, fieldName);
-            celix_auto(celix_utils_string_guard_t) strGuard = celix_utils_stringGuard_init(buf, combinedKey);
-            if (!combinedKey) {
-                celix_err_push("Failed to create sub key.");
-                return ENOMEM;
-            }
-            status = celix_properties_decodeValue(props, combinedKey, fieldValue, flags);
-            if (status != CELIX_SUCCESS) {
-                return status;
+    if (!celix_jsonReader_consume(decoder->reader, ']')) {
+        do {
+            if (supported) {
+                status = celix_properties_readJsonArrayElement(decoder, &list, &supported);
+            } else {
+                status = celix_jsonReader_skipValue(decoder->reader, CELIX_PROPERTIES_JSON_MAX_DEPTH);
             }
+        } while (status == CELIX_SUCCESS && celix_jsonReader_consume(decoder->reader, ','));
+        if (status == CELIX_SUCCESS && !celix_jsonReader_consume(decoder->reader, ']')) {
+            status = CELIX_ILLEGAL_ARGUMENT;
         }
-        return CELIX_SUCCESS;
-    } else if (json_is_array(jsonValue)) {
-        status = celix_properties_decodeArray(props, key, jsonValue, flags);
-    } else if (json_is_null(jsonValue)) {
-        if (flags & CELIX_PROPERTIES_DECODE_ERROR_ON_NULL_VALUES) {
-            celix_err_pushf("Invalid null value for key '%s'.", key);
+        if (status != CELIX_SUCCESS) {
+            return status;
+        }
+    }
+
+    if (!supported) {
+        if (decoder->flags & CELIX_PROPERTIES_DECODE_ERROR_ON_UNSUPPORTED_ARRAYS) {
+            celix_err_pushf("Invalid mixed, null, object or multidimensional array for key '%s'.", decoder->key.data);
             return CELIX_ILLEGAL_ARGUMENT;
         }
-        // ignore null values
+        return CELIX_SUCCESS; // ignore unsupported arrays
+    } else if (!list) {
+        if (decoder->flags & CELIX_PROPERTIES_DECODE_ERROR_ON_EMPTY_ARRAYS) {
+            celix_err_pushf("Invalid empty array for key '%s'.", decoder->key.data);
+            return CELIX_ILLEGAL_ARGUMENT;
+        }
+        return CELIX_SUCCESS; // ignore empty arrays
+    }
+    return celix_properties_assignArrayList(decoder->props, decoder->key.data, celix_steal_ptr(list));
+}
+
+/**
+ * @brief Read the members of a JSON object, the opening '{' is already consumed.
+ * @param[in] duplicate Whether the object is the value of a duplicate JSON key, in which case its members replace
+ * the members of the earlier object and are therefore no collisions.
+ */
+static celix_status_t
+celix_properties_readJsonObject(celix_properties_json_decoder_t* decoder, int depth, bool duplicate) {
+    if (celix_jsonReader_consume(decoder->reader, '}')) {
         return CELIX_SUCCESS;
-    } else {
-        // LCOV_EXCL_START
-        celix_err_pushf("Unexpected json value type for key '%s'.", key);
-        return CELIX_ILLEGAL_ARGUMENT;
-        // LCOV_EXCL_STOP
     }
+    celix_autoptr(celix_string_hash_map_t) names = NULL;
+    if (decoder->flags & (CELIX_PROPERTIES_DECODE_ERROR_ON_DUPLICATES | CELIX_PROPERTIES_DECODE_ERROR_ON_COLLISIONS)) {
+        names = celix_stringHashMap_create();
+        if (!names) {
+            return ENOMEM;
+        }
+    }
+    size_t prefixLen = decoder->key.size;
+    size_t nameOffset = depth > 0 ? prefixLen + 1 : prefixLen;
+    celix_status_t status;
+    do {
+        celix_jsonWriter_truncate(&decoder->key, prefixLen);
+        status = depth > 0 ? celix_jsonWriter_writeChar(&decoder->key, CELIX_PROPERTIES_JSONPATH_SEPARATOR)
+                           : CELIX_SUCCESS;
+        status = CELIX_DO_IF(status, celix_jsonReader_readString(decoder->reader, &decoder->key));
+        if (status == CELIX_SUCCESS && !celix_jsonReader_consume(decoder->reader, ':')) {
+            status = CELIX_ILLEGAL_ARGUMENT;
+        }
+        bool duplicateMember = false;
+        if (status == CELIX_SUCCESS && names) {
+            const char* name = decoder->key.data + nameOffset;
+            duplicateMember = celix_stringHashMap_hasKey(names, name);
+            if (duplicateMember && (decoder->flags & CELIX_PROPERTIES_DECODE_ERROR_ON_DUPLICATES)) {
+                celix_err_pushf("Invalid duplicate key '%s'.", decoder->key.data);
+                status = CELIX_ILLEGAL_ARGUMENT;
+            } else if (!duplicateMember) {
+                status = celix_stringHashMap_put(names, name, NULL);
+            }
+        }
+        status = CELIX_DO_IF(status, celix_properties_readJsonValue(decoder, depth, duplicate || duplicateMember));
+    } while (status == CELIX_SUCCESS && celix_jsonReader_consume(decoder->reader, ','));
+    if (status == CELIX_SUCCESS && !celix_jsonReader_consume(decoder->reader, '}')) {
+        status = CELIX_ILLEGAL_ARGUMENT;
+    }
+    celix_jsonWriter_truncate(&decoder->key, prefixLen);
     return status;
 }
 
-static celix_status_t celix_properties_decodeFromJson(json_t* obj, int flags, celix_properties_t** out) {
-    *out = NULL;
-    if (!json_is_object(obj)) {
-        celix_err_push("Expected json object.");
+static celix_status_t
+celix_properties_readJsonValue(celix_properties_json_decoder_t* decoder, int depth, bool duplicate) {
+    const char* key = decoder->key.data;
+    if (key[0] == '\0' && (decoder->flags & CELIX_PROPERTIES_DECODE_ERROR_ON_EMPTY_KEYS)) {
+        celix_err_push("Key cannot be empty.");
         return CELIX_ILLEGAL_ARGUMENT;
     }
 
+    int c = celix_jsonReader_peek(decoder->reader);
+    if (c != '{' && !duplicate && (decoder->flags & CELIX_PROPERTIES_DECODE_ERROR_ON_COLLISIONS) &&
+        celix_properties_hasKey(decoder->props, key)) {
+        celix_err_pushf("Invalid key collision. Key '%s' already exists.", key);
+        return CELIX_ILLEGAL_ARGUMENT;
+    }
+
+    celix_status_t status;
+    if (c == '{') {
+        if (depth + 1 >= CELIX_PROPERTIES_JSON_MAX_DEPTH) {
+            celix_err_pushf("Invalid json object for key '%s', maximum nesting depth reached.", key);
+            return CELIX_ILLEGAL_ARGUMENT;
+        }
+        decoder->reader->offset++;
+        return celix_properties_readJsonObject(decoder, depth + 1, duplicate);
+    } else if (c == '[') {
+        decoder->reader->offset++;
+        return celix_properties_readJsonArray(decoder);
+    } else if (c == '"') {
+        celix_jsonWriter_truncate(&decoder->value, 0);
+        status = celix_jsonReader_readString(decoder->reader, &decoder->value);
+        if (status == CELIX_SUCCESS && celix_properties_isJsonVersionString(&decoder->value)) {
+            celix_version_t* version;
+            status = celix_properties_parseJsonVersionString(decoder, &version);
+            return CELIX_DO_IF(status, celix_properties_assignVersion(decoder->props, key, version));
+        }
+        return CELIX_DO_IF(status, celix_properties_setString(decoder->props, key, decoder->value.data));
+    } else if (c == 't' || c == 'f') {
+        bool value;
+        status = celix_jsonReader_readBool(decoder->reader, &value);
+        return CELIX_DO_IF(status, celix_properties_setBool(decoder->props, key, value));
+    } else if (c == 'n') {
+        status = celix_jsonReader_readNull(decoder->reader);
+        if (status == CELIX_SUCCESS && (decoder->flags & CELIX_PROPERTIES_DECODE_ERROR_ON_NULL_VALUES)) {
+            celix_err_pushf("Invalid null value for key '%s'.", key);
+            return CELIX_ILLEGAL_ARGUMENT;
+        }
+        return status; // ignore null values
+    }
+    bool isInteger;
+    long long intValue;
+    double realValue;
+    status = celix_jsonReader_readNumber(decoder->reader, &isInteger, &intValue, &realValue);
+    if (status == CELIX_SUCCESS && isInteger) {
+        return celix_properties_setLong(decoder->props, key, (long)intValue);
+    }
+    return CELIX_DO_IF(status, celix_properties_setDouble(decoder->props, key, realValue));
+}
+
+/**
+ * @brief Decode JSON text to properties, without creating a jansson json_t tree.
+ *
+ * Errors are logged to celix_err. If the decoder did not log a more specific error, a generic error for the invalid
+ * input or the failed decoding is logged. A stream which cannot be read is handled as incomplete input.
+ */
+static celix_status_t
+celix_properties_readJson(celix_json_reader_t* reader, int decodeFlags, celix_properties_t** out) {
+    int errorCount = celix_err_getErrorCount();
     celix_autoptr(celix_properties_t) props = celix_properties_create();
     if (!props) {
         return ENOMEM;
     }
 
-    const char* key;
-    json_t* value;
-    json_object_foreach(obj, key, value) {
-        celix_status_t status = celix_properties_decodeValue(props, key, value, flags);
-        if (status != CELIX_SUCCESS) {
-            return status;
-        }
+    char keyBuf[128];
+    char valueBuf[256];
+    celix_properties_json_decoder_t decoder;
+    decoder.reader = reader;
+    decoder.props = props;
+    decoder.flags = decodeFlags;
+    celix_jsonWriter_init(&decoder.key, keyBuf, sizeof(keyBuf));
+    celix_jsonWriter_init(&decoder.value, valueBuf, sizeof(valueBuf));
+
+    celix_status_t status = CELIX_ILLEGAL_ARGUMENT;
+    if (celix_jsonReader_consume(reader, '{')) {
+        status = celix_properties_readJsonObject(&decoder, 0, false);
+    } else if (!reader->streamError) {
+        celix_err_push("Failed to parse json, expected a json object.");
+    }
+    if (status == CELIX_SUCCESS && !celix_jsonReader_isAtEnd(reader)) {
+        status = CELIX_ILLEGAL_ARGUMENT;
     }
+    celix_jsonWriter_deinit(&decoder.key);
+    celix_jsonWriter_deinit(&decoder.value);
 
-    *out = celix_steal_ptr(props);
-    return CELIX_SUCCESS;
+    if (reader->streamError) {
+        // the input read so far is incomplete, so this is handled as invalid input
+        celix_err_push("Failed to read json from stream.");
+        return CELIX_ILLEGAL_ARGUMENT;
+    } else if (status == CELIX_ILLEGAL_ARGUMENT && celix_err_getErrorCount() == errorCount) {
+        celix_err_pushf("Failed to parse json at position %zu.", celix_jsonReader_getPosition(reader));
+    } else if (status != CELIX_SUCCESS && celix_err_getErrorCount() == errorCount) {
+        celix_err_push("Failed to decode properties from json.");
+    }
+    if (status == CELIX_SUCCESS) {
+        *out = celix_steal_ptr(props);
+    }
+    return status;
 }
 
 celix_status_t celix_properties_loadFromStream(FILE* stream, int decodeFlags, celix_properties_t** out) {
-    json_error_t jsonError;
-    size_t jsonFlags = 0;
-    if (decodeFlags & CELIX_PROPERTIES_DECODE_ERROR_ON_DUPLICATES) {
-        jsonFlags = JSON_REJECT_DUPLICATES;
-    }
-    json_auto_t* root = json_loadf(stream, jsonFlags, &jsonError);
-    if (!root) {
-        celix_err_pushf("Failed to parse json from %s:%i:%i: %s.",
-                        jsonError.source,
-                        jsonError.line,
-                        jsonError.column,
-                        jsonError.text);
-        return celix_utils_jsonErrorToStatus(json_error_code(&jsonError));
-    }
-    return celix_properties_decodeFromJson(root, decodeFlags, out);
+    char buf[CELIX_PROPERTIES_JSON_BUFFER_SIZE];
+    celix_json_reader_t reader;
+    celix_jsonReader_initStream(&reader, stream, buf, sizeof(buf));
+    return celix_properties_readJson(&reader, decodeFlags, out);
 }
 
 celix_status_t celix_properties_load(const char* filename, int decodeFlags, celix_properties_t** out) {
@@ -401,12 +787,7 @@ celix_status_t celix_properties_load(const char* filename, int decodeFlags, celi
 }
 
 celix_status_t celix_properties_loadFromString(const char* input, int decodeFlags, celix_properties_t** out) {
-    FILE* stream = fmemopen((void*)input, strlen(input), "r");
-    if (!stream) {
-        celix_err_push("Failed to open memstream.");
-        return ENOMEM;
-    }
-    celix_status_t status = celix_properties_loadFromStream(stream, decodeFlags, out);
-    fclose(stream);
-    return status;
+    celix_json_reader_t reader;
+    celix_jsonReader_init(&reader, input, strlen(input));
+    return celix_properties_readJson(&reader, decodeFlags, out);
 }
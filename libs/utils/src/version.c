@@ -125,10 +125,10 @@ celix_version_parseInternal(const char* versionStr, bool logParseError, celix_ve
 
     const char* qualifier = NULL;
     while (token != NULL && count < 3) {
-        char* endPtr = NULL;
-        errno = 0;
-        long l = strtol(token, &endPtr, 10);
-        if (errno != 0 || token == endPtr || l < 0 || l >= INT_MAX) {
+        long l;
+        bool outOfRange;
+        const char* endPtr = celix_utils_parseLong(token, &l, &outOfRange);
+        if (outOfRange || token == endPtr || l < 0 || l >= INT_MAX) {
             if (logParseError) {
                 celix_err_pushf("Invalid version part %d. Input str: %s", count, versionStr);
             }
@@ -149,6 +149,7 @@ celix_version_parseInternal(const char* versionStr, bool logParseError, celix_ve
     if (token != NULL) {
         qualifier = token;
     }
+    errno = 0;
     *version = celix_version_create(versionsParts[0], versionsParts[1], versionsParts[2], qualifier);
     return *version ? CELIX_SUCCESS : (errno == EINVAL ? CELIX_ILLEGAL_ARGUMENT : CELIX_ENOMEM);
 }